@@ -79,6 +79,7 @@ set(
 set(
 	NORMSOURCES_CT_CATH_REFINE_ALIGN_CATH_CATH_REFINE_ALIGN_OPTIONS
 		ct_cath_refine_align/cath/cath_refine_align/options/cath_refine_align_options.cpp
+		ct_cath_refine_align/cath/cath_refine_align/options/refine_band_options_block.cpp
 )
 
 set(
@@ -100,12 +101,14 @@ set(
 set(
 	NORMSOURCES_CT_CATH_SCORE_ALIGN_CATH_CATH_SCORE_ALIGN_OPTIONS
 		ct_cath_score_align/cath/cath_score_align/options/cath_score_align_options.cpp
+		ct_cath_score_align/cath/cath_score_align/options/score_align_batch_options_block.cpp
 )
 
 set(
 	NORMSOURCES_CT_CATH_SCORE_ALIGN_CATH_CATH_SCORE_ALIGN
 		ct_cath_score_align/cath/cath_score_align/cath_align_scorer.cpp
 		${NORMSOURCES_CT_CATH_SCORE_ALIGN_CATH_CATH_SCORE_ALIGN_OPTIONS}
+		ct_cath_score_align/cath/cath_score_align/score_align_batch.cpp
 )
 
 set(
@@ -345,6 +348,7 @@ set(
 
 set(
 	NORMSOURCES_CT_COMMON_CATH_COMMON_FILE
+		ct_common/cath/common/file/buffered_ostream_sink.cpp
 		ct_common/cath/common/file/find_file.cpp
 		ct_common/cath/common/file/ofstream_list.cpp
 		ct_common/cath/common/file/open_fstream.cpp
@@ -352,6 +356,11 @@ set(
 		ct_common/cath/common/file/temp_file.cpp
 )
 
+set(
+	NORMSOURCES_CT_COMMON_CATH_COMMON_STRING
+		ct_common/cath/common/string/string_intern_pool.cpp
+)
+
 set(
 	NORMSOURCES_CT_COMMON_CATH_COMMON
 		${NORMSOURCES_CT_COMMON_CATH_COMMON_ALGORITHM}
@@ -363,6 +372,7 @@ set(
 		${NORMSOURCES_CT_COMMON_CATH_COMMON_FILE}
 		ct_common/cath/common/logger.cpp
 		ct_common/cath/common/program_exception_wrapper.cpp
+		${NORMSOURCES_CT_COMMON_CATH_COMMON_STRING}
 		ct_common/cath/common/test_or_exe_run_mode.cpp
 )
 
@@ -461,6 +471,7 @@ set(
 set(
 	NORMSOURCES_CT_RESOLVE_HITS_CATH_RESOLVE_HITS_ALGO
 		ct_resolve_hits/cath/resolve_hits/algo/discont_hits_index_by_start.cpp
+		ct_resolve_hits/cath/resolve_hits/algo/masked_bests_cache.cpp
 		ct_resolve_hits/cath/resolve_hits/algo/masked_bests_cacher.cpp
 		ct_resolve_hits/cath/resolve_hits/algo/scored_arch_proxy.cpp
 )
@@ -470,6 +481,7 @@ set(
 		ct_resolve_hits/cath/resolve_hits/file/alnd_rgn.cpp
 		ct_resolve_hits/cath/resolve_hits/file/cath_id_score_category.cpp
 		ct_resolve_hits/cath/resolve_hits/file/hits_input_format_tag.cpp
+		ct_resolve_hits/cath/resolve_hits/file/parse_binary_hits.cpp
 		ct_resolve_hits/cath/resolve_hits/file/parse_domain_hits_table.cpp
 		ct_resolve_hits/cath/resolve_hits/file/parse_hmmer_out.cpp
 )
@@ -516,6 +528,7 @@ set(
 		ct_resolve_hits/cath/resolve_hits/read_and_process_hits/hits_processor/gather_hits_processor.cpp
 		ct_resolve_hits/cath/resolve_hits/read_and_process_hits/hits_processor/hits_processor_list.cpp
 		ct_resolve_hits/cath/resolve_hits/read_and_process_hits/hits_processor/summarise_hits_processor.cpp
+		ct_resolve_hits/cath/resolve_hits/read_and_process_hits/hits_processor/write_binary_hits_processor.cpp
 		ct_resolve_hits/cath/resolve_hits/read_and_process_hits/hits_processor/write_html_hits_processor.cpp
 		ct_resolve_hits/cath/resolve_hits/read_and_process_hits/hits_processor/write_json_hits_processor.cpp
 		ct_resolve_hits/cath/resolve_hits/read_and_process_hits/hits_processor/write_results_hits_processor.cpp
@@ -523,12 +536,14 @@ set(
 
 set(
 	NORMSOURCES_CT_RESOLVE_HITS_CATH_RESOLVE_HITS_READ_AND_PROCESS_HITS
+		ct_resolve_hits/cath/resolve_hits/read_and_process_hits/hit_spill_store.cpp
 		${NORMSOURCES_CT_RESOLVE_HITS_CATH_RESOLVE_HITS_READ_AND_PROCESS_HITS_HITS_PROCESSOR}
 		ct_resolve_hits/cath/resolve_hits/read_and_process_hits/read_and_process_mgr.cpp
 )
 
 set(
 	NORMSOURCES_CT_RESOLVE_HITS_CATH_RESOLVE_HITS_RESOLVE
+		ct_resolve_hits/cath/resolve_hits/resolve/hit_resolve_stats.cpp
 		ct_resolve_hits/cath/resolve_hits/resolve/hit_resolver.cpp
 		ct_resolve_hits/cath/resolve_hits/resolve/naive_greedy_hit_resolver.cpp
 )
@@ -692,10 +707,12 @@ set(
 		ct_uni/cath/alignment/dyn_prog_align/detail/string_aligner/benchmark_dyn_prog_string_aligner.cpp
 		ct_uni/cath/alignment/dyn_prog_align/detail/string_aligner/gen_dyn_prog_string_aligner.cpp
 		ct_uni/cath/alignment/dyn_prog_align/detail/string_aligner/string_aligner.cpp
+		ct_uni/cath/alignment/dyn_prog_align/detail/string_aligner/striped_string_aligner.cpp
 )
 
 set(
 	NORMSOURCES_CT_UNI_CATH_ALIGNMENT_DYN_PROG_ALIGN_DETAIL
+		ct_uni/cath/alignment/dyn_prog_align/detail/banded_score_matrix.cpp
 		${NORMSOURCES_CT_UNI_CATH_ALIGNMENT_DYN_PROG_ALIGN_DETAIL_MATRIX_PLOTTER}
 		ct_uni/cath/alignment/dyn_prog_align/detail/path_step.cpp
 		ct_uni/cath/alignment/dyn_prog_align/detail/return_path_matrix.cpp
@@ -705,6 +722,7 @@ set(
 
 set(
 	NORMSOURCES_CT_UNI_CATH_ALIGNMENT_DYN_PROG_ALIGN_DYN_PROG_SCORE_SOURCE
+		ct_uni/cath/alignment/dyn_prog_align/dyn_prog_score_source/banded_matrix_dyn_prog_score_source.cpp
 		ct_uni/cath/alignment/dyn_prog_align/dyn_prog_score_source/dyn_prog_score_source.cpp
 		ct_uni/cath/alignment/dyn_prog_align/dyn_prog_score_source/entry_querier_dyn_prog_score_source.cpp
 		ct_uni/cath/alignment/dyn_prog_align/dyn_prog_score_source/mask_dyn_prog_score_source.cpp
@@ -719,7 +737,9 @@ set(
 		ct_uni/cath/alignment/dyn_prog_align/dyn_prog_aligner.cpp
 		${NORMSOURCES_CT_UNI_CATH_ALIGNMENT_DYN_PROG_ALIGN_DYN_PROG_SCORE_SOURCE}
 		ct_uni/cath/alignment/dyn_prog_align/ssap_code_dyn_prog_aligner.cpp
+		ct_uni/cath/alignment/dyn_prog_align/ssap_code_dyn_prog_workspace.cpp
 		ct_uni/cath/alignment/dyn_prog_align/std_dyn_prog_aligner.cpp
+		ct_uni/cath/alignment/dyn_prog_align/striped_sequence_aligner.cpp
 )
 
 set(
@@ -1049,7 +1069,10 @@ set(
 
 set(
 	NORMSOURCES_CT_UNI_CATH_SCORE_ALIGNED_PAIR_SCORE_DETAIL
+		ct_uni/cath/score/aligned_pair_score/detail/lddt_pair_counts.cpp
+		ct_uni/cath/score/aligned_pair_score/detail/score_common_coord_cache.cpp
 		ct_uni/cath/score/aligned_pair_score/detail/score_common_coord_handler.cpp
+		ct_uni/cath/score/aligned_pair_score/detail/tm_score_search.cpp
 )
 
 set(
@@ -1239,6 +1262,7 @@ set(
 		${NORMSOURCES_CT_UNI_CATH_STRUCTURE_GEOMETRY_DETAIL}
 		ct_uni/cath/structure/geometry/orient.cpp
 		ct_uni/cath/structure/geometry/pca.cpp
+		ct_uni/cath/structure/geometry/qcp_superpose.cpp
 		ct_uni/cath/structure/geometry/restrict_to_single_linkage_extension.cpp
 		ct_uni/cath/structure/geometry/rotation.cpp
 		ct_uni/cath/structure/geometry/superpose_fit.cpp
@@ -1533,6 +1557,21 @@ set(
 		${TESTSOURCES_CT_CATH_REFINE_ALIGN_CATH}
 )
 
+set(
+	TESTSOURCES_CT_CATH_SCORE_ALIGN_CATH_CATH_SCORE_ALIGN
+		ct_cath_score_align/cath/cath_score_align/score_align_batch_test.cpp
+)
+
+set(
+	TESTSOURCES_CT_CATH_SCORE_ALIGN_CATH
+		${TESTSOURCES_CT_CATH_SCORE_ALIGN_CATH_CATH_SCORE_ALIGN}
+)
+
+set(
+	TESTSOURCES_CT_CATH_SCORE_ALIGN
+		${TESTSOURCES_CT_CATH_SCORE_ALIGN_CATH}
+)
+
 set(
 	TESTSOURCES_CT_CATH_SUPERPOSE_CATH_CATH_SUPERPOSE
 		ct_cath_superpose/cath/cath_superpose/cath_superposer_test.cpp
@@ -1744,6 +1783,7 @@ set(
 
 set(
 	TESTSOURCES_CT_COMMON_CATH_COMMON_FILE
+		ct_common/cath/common/file/buffered_ostream_sink_test.cpp
 		ct_common/cath/common/file/ofstream_list_test.cpp
 		ct_common/cath/common/file/open_fstream_test.cpp
 		ct_common/cath/common/file/simple_file_read_write_test.cpp
@@ -1783,6 +1823,7 @@ set(
 	TESTSOURCES_CT_COMMON_CATH_COMMON_STRING
 		ct_common/cath/common/string/booled_to_string_test.cpp
 		ct_common/cath/common/string/cath_to_string_test.cpp
+		ct_common/cath/common/string/string_intern_pool_test.cpp
 		ct_common/cath/common/string/string_parse_tools_test.cpp
 )
 
@@ -1803,6 +1844,12 @@ set(
 		ct_common/cath/common/type_traits/is_tuple_test.cpp
 )
 
+set(
+	TESTSOURCES_CT_COMMON_CATH_COMMON_THREAD
+		ct_common/cath/common/thread/ordered_task_pool_test.cpp
+		ct_common/cath/common/thread/parallel_for_each_index_test.cpp
+)
+
 set(
 	TESTSOURCES_CT_COMMON_CATH_COMMON
 		${TESTSOURCES_CT_COMMON_CATH_COMMON_ALGORITHM}
@@ -1823,6 +1870,7 @@ set(
 		${TESTSOURCES_CT_COMMON_CATH_COMMON_RAPIDJSON_ADDENDA}
 		${TESTSOURCES_CT_COMMON_CATH_COMMON_STRING}
 		ct_common/cath/common/temp_check_offset_1_test.cpp
+		${TESTSOURCES_CT_COMMON_CATH_COMMON_THREAD}
 		${TESTSOURCES_CT_COMMON_CATH_COMMON_TUPLE}
 		ct_common/cath/common/type_to_string_test.cpp
 		${TESTSOURCES_CT_COMMON_CATH_COMMON_TYPE_TRAITS}
@@ -1887,7 +1935,9 @@ set(
 
 set(
 	TESTSOURCES_CT_RESOLVE_HITS_CATH_RESOLVE_HITS_ALGO
+		ct_resolve_hits/cath/resolve_hits/algo/mask_segment_index_test.cpp
 		ct_resolve_hits/cath/resolve_hits/algo/masked_bests_cache_test.cpp
+		ct_resolve_hits/cath/resolve_hits/algo/scored_arch_proxy_test.cpp
 )
 
 set(
@@ -1899,6 +1949,8 @@ set(
 	TESTSOURCES_CT_RESOLVE_HITS_CATH_RESOLVE_HITS_FILE
 		ct_resolve_hits/cath/resolve_hits/file/cath_id_score_category_test.cpp
 		${TESTSOURCES_CT_RESOLVE_HITS_CATH_RESOLVE_HITS_FILE_DETAIL}
+		ct_resolve_hits/cath/resolve_hits/file/parse_binary_hits_test.cpp
+		ct_resolve_hits/cath/resolve_hits/file/parse_domain_hits_table_test.cpp
 )
 
 set(
@@ -1909,6 +1961,7 @@ set(
 set(
 	TESTSOURCES_CT_RESOLVE_HITS_CATH_RESOLVE_HITS_OPTIONS_SPEC
 		ct_resolve_hits/cath/resolve_hits/options/spec/crh_filter_spec_test.cpp
+		ct_resolve_hits/cath/resolve_hits/options/spec/crh_input_spec_test.cpp
 		ct_resolve_hits/cath/resolve_hits/options/spec/crh_single_output_spec_test.cpp
 )
 
@@ -1925,6 +1978,7 @@ set(
 
 set(
 	TESTSOURCES_CT_RESOLVE_HITS_CATH_RESOLVE_HITS_READ_AND_PROCESS_HITS
+		ct_resolve_hits/cath/resolve_hits/read_and_process_hits/hit_spill_store_test.cpp
 		${TESTSOURCES_CT_RESOLVE_HITS_CATH_RESOLVE_HITS_READ_AND_PROCESS_HITS_HITS_PROCESSOR}
 )
 
@@ -2041,6 +2095,7 @@ set(
 
 set(
 	TESTSOURCES_CT_UNI_CATH_ALIGNMENT_DYN_PROG_ALIGN_DETAIL
+		ct_uni/cath/alignment/dyn_prog_align/detail/banded_score_matrix_test.cpp
 		ct_uni/cath/alignment/dyn_prog_align/detail/return_path_matrix_test.cpp
 		${TESTSOURCES_CT_UNI_CATH_ALIGNMENT_DYN_PROG_ALIGN_DETAIL_STRING_ALIGNER}
 )
@@ -2059,6 +2114,9 @@ set(
 	TESTSOURCES_CT_UNI_CATH_ALIGNMENT_DYN_PROG_ALIGN
 		${TESTSOURCES_CT_UNI_CATH_ALIGNMENT_DYN_PROG_ALIGN_DETAIL}
 		${TESTSOURCES_CT_UNI_CATH_ALIGNMENT_DYN_PROG_ALIGN_DYN_PROG_SCORE_SOURCE}
+		ct_uni/cath/alignment/dyn_prog_align/ssap_code_dyn_prog_aligner_test.cpp
+		ct_uni/cath/alignment/dyn_prog_align/std_dyn_prog_aligner_test.cpp
+		ct_uni/cath/alignment/dyn_prog_align/striped_sequence_aligner_test.cpp
 		${TESTSOURCES_CT_UNI_CATH_ALIGNMENT_DYN_PROG_ALIGN_TEST}
 )
 
@@ -2086,6 +2144,7 @@ set(
 
 set(
 	TESTSOURCES_CT_UNI_CATH_ALIGNMENT_REFINER
+		ct_uni/cath/alignment/refiner/alignment_refiner_test.cpp
 		${TESTSOURCES_CT_UNI_CATH_ALIGNMENT_REFINER_DETAIL}
 )
 
@@ -2282,7 +2341,9 @@ set(
 
 set(
 	TESTSOURCES_CT_UNI_CATH_SCORE_ALIGNED_PAIR_SCORE_DETAIL
+		ct_uni/cath/score/aligned_pair_score/detail/lddt_pair_counts_test.cpp
 		ct_uni/cath/score/aligned_pair_score/detail/score_common_coord_handler_test.cpp
+		ct_uni/cath/score/aligned_pair_score/detail/tm_score_search_test.cpp
 )
 
 set(
@@ -2383,6 +2444,7 @@ set(
 		ct_uni/cath/structure/geometry/orient_test.cpp
 		ct_uni/cath/structure/geometry/orientation_covering_test.cpp
 		ct_uni/cath/structure/geometry/pca_test.cpp
+		ct_uni/cath/structure/geometry/qcp_superpose_test.cpp
 		ct_uni/cath/structure/geometry/quat_rot_test.cpp
 		ct_uni/cath/structure/geometry/restrict_to_single_linkage_extension_test.cpp
 		ct_uni/cath/structure/geometry/rotation_test.cpp
@@ -2470,6 +2532,7 @@ set(
 		${TESTSOURCES_CT_UNI_CATH_STRUCTURE_VIEW_CACHE_DETAIL}
 		${TESTSOURCES_CT_UNI_CATH_STRUCTURE_VIEW_CACHE_FILTER}
 		${TESTSOURCES_CT_UNI_CATH_STRUCTURE_VIEW_CACHE_INDEX}
+		ct_uni/cath/structure/view_cache/view_cache_test.cpp
 )
 
 set(
@@ -2529,6 +2592,7 @@ set(
 		${TESTSOURCES_CT_BIOCORE}
 		${TESTSOURCES_CT_CATH_CLUSTER}
 		${TESTSOURCES_CT_CATH_REFINE_ALIGN}
+		${TESTSOURCES_CT_CATH_SCORE_ALIGN}
 		${TESTSOURCES_CT_CATH_SUPERPOSE}
 		${TESTSOURCES_CT_CHOPPING}
 		${TESTSOURCES_CT_CLUSTAGGLOM}
@@ -105,7 +105,10 @@ void cath_align_refiner::refine(const cath_refine_align_options &prm_cath_refine
 //
 //	return;
 
-	const alignment refined_alignment        = alignment_refiner().iterate( the_alignment, proteins, gap_penalty( 50, 0 ) );
+	const alignment refined_alignment        = alignment_refiner{
+		alignment_refiner::DEFAULT_NUM_THREADS,
+		prm_cath_refine_align_options.get_refine_band_width()
+	}.iterate( the_alignment, proteins, gap_penalty( 50, 0 ) );
 	const alignment scored_refined_alignment = score_alignment_copy( residue_scorer(), refined_alignment, proteins );
 
 //	const protein &protein_a = proteins[0];
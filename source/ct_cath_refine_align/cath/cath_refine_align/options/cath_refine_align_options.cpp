@@ -170,6 +170,7 @@ cath_refine_align_options::cath_refine_align_options() {
 	super::add_options_block( the_ids_ob                             );
 	super::add_options_block( the_pdb_input_options_block            );
 	super::add_options_block( the_align_regions_ob                   );
+	super::add_options_block( the_refine_band_ob                     );
 
 	super::add_string       ( "\033[1mOutput\033[0m"      );
 	super::add_options_block( the_alignment_output_options_block     );
@@ -222,6 +223,12 @@ const domain_vec & cath_refine_align_options::get_domains() const {
 	return the_align_regions_ob.get_align_domains();
 }
 
+/// \brief Get the optional number of cells either side of the existing alignment within which to refine
+///        (or nullopt to refine over the full matrices)
+const size_opt & cath_refine_align_options::get_refine_band_width() const {
+	return the_refine_band_ob.get_band_width();
+}
+
 /// \brief Get the single alignment_acquirer implied by the specified cath_refine_align_options
 ///        (or throw an invalid_argument_exception if fewer/more are implied)
 ///
@@ -29,6 +29,7 @@
 #include "cath/acquirer/alignment_acquirer/align_refining.hpp"
 #include "cath/alignment/options_block/alignment_input_options_block.hpp"
 #include "cath/alignment/options_block/alignment_input_spec.hpp"
+#include "cath/cath_refine_align/options/refine_band_options_block.hpp"
 #include "cath/chopping/chopping_type_aliases.hpp"
 #include "cath/common/type_aliases.hpp"
 #include "cath/display/options/display_options_block.hpp"
@@ -70,6 +71,9 @@ namespace cath::opts {
 		/// \brief The align_regions_options_block for align regions options
 		align_regions_options_block        the_align_regions_ob;
 
+		/// \brief The options_block for banding the refinement around the existing alignment
+		refine_band_options_block          the_refine_band_ob;
+
 		/// \brief TODOCUMENT
 		alignment_output_options_block     the_alignment_output_options_block;
 
@@ -101,6 +105,7 @@ namespace cath::opts {
 		[[nodiscard]] superposition_outputter_list get_superposition_outputters( const default_supn_outputter & ) const;
 
 		[[nodiscard]] const chop::domain_vec &get_domains() const;
+		[[nodiscard]] const size_opt &        get_refine_band_width() const;
 
 		/// \brief The name of the program that uses this executable_options
 		static constexpr ::std::string_view PROGRAM_NAME{ "cath-refine-align" };
@@ -0,0 +1,86 @@
+/// \file
+/// \brief The refine_band_options_block class definitions
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "refine_band_options_block.hpp"
+
+#include <string>
+
+#include "cath/common/clone/make_uptr_clone.hpp"
+
+using namespace ::cath;
+using namespace ::cath::common;
+using namespace ::cath::opts;
+
+using ::boost::program_options::options_description;
+using ::boost::program_options::value;
+using ::boost::program_options::variables_map;
+using ::std::nullopt;
+using ::std::string;
+using ::std::unique_ptr;
+
+/// \brief A standard do_clone method
+unique_ptr<options_block> refine_band_options_block::do_clone() const {
+	return { make_uptr_clone( *this ) };
+}
+
+/// \brief Define this block's name (used as a header for the block in the usage)
+string refine_band_options_block::do_get_block_name() const {
+	return "Refinement";
+}
+
+/// \brief Add this block's options to the provided options_description
+void refine_band_options_block::do_add_visible_options_to_description(options_description &prm_desc,           ///< The options_description to which the options are added
+                                                                      const size_t        &/*prm_line_length*/ ///< The line length to be used when outputting the description (not very clearly documented in Boost)
+                                                                      ) {
+	const string cells_varname{ "<cells>" };
+
+	const auto band_width_notifier = [&] (const size_t &x) { band_width = x; };
+
+	prm_desc.add_options()
+		(
+			string( PO_REFINE_BAND_WIDTH ).c_str(),
+			value<size_t>()
+				->value_name( cells_varname       )
+				->notifier  ( band_width_notifier ),
+			(   "Only refine within " + cells_varname + " cells either side of the existing alignment"
+			  + "\n(the band is doubled whenever the refined alignment reaches its edge; default: refine over the full matrices)" ).c_str()
+		);
+}
+
+/// \brief Return a string describing any problems with the current configuration of the block
+///
+/// At present, this always accepts all options
+str_opt refine_band_options_block::do_invalid_string(const variables_map &/*prm_variables_map*/ ///< The variables map, which options_blocks can use to determine which options were specified, defaulted etc
+                                                     ) const {
+	return nullopt;
+}
+
+/// \brief Return all options names for this block
+str_view_vec refine_band_options_block::do_get_all_options_names() const {
+	return {
+		PO_REFINE_BAND_WIDTH,
+	};
+}
+
+/// \brief Getter for the optional number of cells either side of the alignment within which to refine
+///        (or nullopt to refine over the full matrices)
+const size_opt & refine_band_options_block::get_band_width() const {
+	return band_width;
+}
@@ -0,0 +1,56 @@
+/// \file
+/// \brief The refine_band_options_block class header
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef CATH_TOOLS_SOURCE_CT_CATH_REFINE_ALIGN_CATH_CATH_REFINE_ALIGN_OPTIONS_REFINE_BAND_OPTIONS_BLOCK_HPP
+#define CATH_TOOLS_SOURCE_CT_CATH_REFINE_ALIGN_CATH_CATH_REFINE_ALIGN_OPTIONS_REFINE_BAND_OPTIONS_BLOCK_HPP
+
+#include <string_view>
+
+#include "cath/common/type_aliases.hpp"
+#include "cath/options/options_block/options_block.hpp"
+
+namespace cath::opts {
+
+	/// \brief Handle the options for banding the refinement around the existing alignment
+	class refine_band_options_block final : public options_block {
+	private:
+		using super = options_block;
+
+		/// \brief The optional number of cells either side of the alignment within which to refine
+		///        (or nullopt to refine over the full matrices)
+		size_opt band_width;
+
+		[[nodiscard]] std::unique_ptr<options_block> do_clone() const final;
+		[[nodiscard]] std::string                    do_get_block_name() const final;
+		void do_add_visible_options_to_description(boost::program_options::options_description &,
+		                                           const size_t &) final;
+		[[nodiscard]] str_opt do_invalid_string( const boost::program_options::variables_map & ) const final;
+		[[nodiscard]] str_view_vec do_get_all_options_names() const final;
+
+	  public:
+		[[nodiscard]] const size_opt & get_band_width() const;
+
+		/// \brief The option name for the number of cells either side of the alignment within which to refine
+		static constexpr ::std::string_view PO_REFINE_BAND_WIDTH{ "refine-band-width" };
+	};
+
+} // namespace cath::opts
+
+#endif // CATH_TOOLS_SOURCE_CT_CATH_REFINE_ALIGN_CATH_CATH_REFINE_ALIGN_OPTIONS_REFINE_BAND_OPTIONS_BLOCK_HPP
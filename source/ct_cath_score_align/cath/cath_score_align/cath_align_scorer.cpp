@@ -24,6 +24,7 @@
 #include "cath/acquirer/pdbs_acquirer/pdbs_acquirer.hpp"
 #include "cath/alignment/alignment.hpp"
 #include "cath/cath_score_align/options/cath_score_align_options.hpp"
+#include "cath/cath_score_align/score_align_batch.hpp"
 #include "cath/common/exception/not_implemented_exception.hpp"
 #include "cath/file/name_set/name_set_list.hpp"
 #include "cath/file/pdb/pdb.hpp"
@@ -63,6 +64,20 @@ void cath_align_scorer::score(const cath_score_align_options &prm_cath_score_ali
 		return;
 	}
 
+	// If a batch manifest has been specified, score all of its alignments and report the throughput
+	const score_align_batch_options_block &batch_options = prm_cath_score_align_options.get_score_align_batch_options_block();
+	if ( batch_options.get_manifest_file() ) {
+		const score_align_batch_stats stats = score_align_batch(
+			read_score_align_batch_manifest_file( *batch_options.get_manifest_file() ),
+			batch_options.get_pdb_dir(),
+			batch_options.get_num_threads(),
+			prm_stdout,
+			prm_stderr
+		);
+		prm_stderr << to_string( stats ) << endl;
+		return;
+	}
+
 	// Grab the PDBs and their IDs
 	const strucs_context context  = get_pdbs_and_names( prm_cath_score_align_options, prm_istream, false );
 	const protein_list   proteins = build_protein_list( context );
@@ -86,6 +86,14 @@ str_opt cath_score_align_options::do_get_error_or_help_string() const {
 	const auto num_aln_acquirers = get_num_acquirers( the_alignment_input_options_block );
 	const auto num_pdb_acquirers = get_num_acquirers( the_pdb_input_options_block       );
 
+	// A batch manifest provides its own alignments and structures, so it can't be combined with other sources of either
+	if ( the_score_align_batch_options_block.get_manifest_file() ) {
+		if ( ( num_aln_acquirers != 0 ) || ( num_pdb_acquirers != 0 ) ) {
+			return "Cannot specify a batch manifest with any other source of alignments or PDBs"s;
+		}
+		return nullopt;
+	}
+
 	// If there are no objects then no options were specified so just output the standard usage error string
 	if ( ( num_aln_acquirers == 0 ) && ( num_pdb_acquirers == 0 ) ) {
 		return ""s;
@@ -117,10 +125,13 @@ string cath_score_align_options::do_get_help_prefix_string() const {
 
 Please specify:
  * at most one alignment (default: --{})
- * one method of reading proteins (number of proteins currently restricted to 2)",
+ * one method of reading proteins (number of proteins currently restricted to 2)
+or:
+ * a batch manifest of alignments to score (with --{}))",
 	  PROGRAM_NAME,
 	  get_overview_string(),
-	  alignment_input_options_block::PO_DO_THE_SSAPS );
+	  alignment_input_options_block::PO_DO_THE_SSAPS,
+	  score_align_batch_options_block::PO_BATCH_MANIFEST );
 }
 
 /// \brief Get a string to append to the standard help (just empty here)
@@ -144,8 +155,9 @@ void cath_score_align_options::check_ok_to_use() const {
 
 /// \brief TODOCUMENT
 cath_score_align_options::cath_score_align_options() {
-	super::add_options_block( the_alignment_input_options_block );
-	super::add_options_block( the_pdb_input_options_block       );
+	super::add_options_block( the_alignment_input_options_block   );
+	super::add_options_block( the_pdb_input_options_block         );
+	super::add_options_block( the_score_align_batch_options_block );
 }
 
 /// \brief Getter for the pdb_input_spec
@@ -158,6 +170,11 @@ const alignment_input_spec & cath_score_align_options::get_alignment_input_spec(
 	return the_alignment_input_options_block.get_alignment_input_spec();
 }
 
+/// \brief Getter for the score_align_batch_options_block
+const score_align_batch_options_block & cath_score_align_options::get_score_align_batch_options_block() const {
+	return the_score_align_batch_options_block;
+}
+
 /// \brief Get the single alignment_acquirer implied by the specified cath_score_align_options
 ///        (or throw an invalid_argument_exception if fewer/more are implied)
 ///
@@ -29,6 +29,7 @@
 #include "cath/acquirer/alignment_acquirer/align_refining.hpp"
 #include "cath/alignment/options_block/alignment_input_options_block.hpp"
 #include "cath/alignment/options_block/alignment_input_spec.hpp"
+#include "cath/cath_score_align/options/score_align_batch_options_block.hpp"
 #include "cath/common/type_aliases.hpp"
 #include "cath/options/executable/executable_options.hpp"
 #include "cath/options/options_block/pdb_input_options_block.hpp"
@@ -53,6 +54,9 @@ namespace cath::opts {
 		/// \brief TODOCUMENT
 		pdb_input_options_block       the_pdb_input_options_block;
 
+		/// \brief The options for scoring a batch of alignments listed in a manifest
+		score_align_batch_options_block the_score_align_batch_options_block;
+
 		[[nodiscard]] std::string_view do_get_program_name() const final;
 		[[nodiscard]] str_opt          do_get_error_or_help_string() const final;
 
@@ -67,6 +71,7 @@ namespace cath::opts {
 
 		[[nodiscard]] const pdb_input_spec &      get_pdb_input_spec() const;
 		[[nodiscard]] const alignment_input_spec &get_alignment_input_spec() const;
+		[[nodiscard]] const score_align_batch_options_block &get_score_align_batch_options_block() const;
 
 		/// \brief The name of the program that uses this executable_options
 		static constexpr ::std::string_view PROGRAM_NAME{ "cath-score-align" };
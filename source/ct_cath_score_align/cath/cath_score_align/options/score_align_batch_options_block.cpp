@@ -0,0 +1,121 @@
+/// \file
+/// \brief The score_align_batch_options_block class definitions
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "score_align_batch_options_block.hpp"
+
+#include <string>
+
+#include "cath/common/clone/make_uptr_clone.hpp"
+
+using namespace ::cath;
+using namespace ::cath::common;
+using namespace ::cath::opts;
+
+using ::boost::program_options::options_description;
+using ::boost::program_options::value;
+using ::boost::program_options::variables_map;
+using ::std::filesystem::path;
+using ::std::literals::string_literals::operator""s;
+using ::std::nullopt;
+using ::std::string;
+using ::std::unique_ptr;
+
+/// \brief A standard do_clone method
+unique_ptr<options_block> score_align_batch_options_block::do_clone() const {
+	return { make_uptr_clone( *this ) };
+}
+
+/// \brief Define this block's name (used as a header for the block in the usage)
+string score_align_batch_options_block::do_get_block_name() const {
+	return "Batch scoring";
+}
+
+/// \brief Add this block's options to the provided options_description
+void score_align_batch_options_block::do_add_visible_options_to_description(options_description &prm_desc,           ///< The options_description to which the options are added
+                                                                            const size_t        &/*prm_line_length*/ ///< The line length to be used when outputting the description (not very clearly documented in Boost)
+                                                                            ) {
+	const string file_varname    { "<file>"    };
+	const string dir_varname     { "<dir>"     };
+	const string threads_varname { "<threads>" };
+
+	const auto manifest_notifier = [&] (const path   &x) { manifest_file = x; };
+	const auto pdb_dir_notifier  = [&] (const path   &x) { pdb_dir       = x; };
+	const auto threads_notifier  = [&] (const size_t &x) { num_threads   = x; };
+
+	prm_desc.add_options()
+		(
+			string( PO_BATCH_MANIFEST ).c_str(),
+			value<path>()
+				->value_name   ( file_varname        )
+				->notifier     ( manifest_notifier   ),
+			(   "Score each of the alignments listed in manifest file "
+			  + file_varname
+			  + ", one per line as: <fasta_alignment_file> <id_1> <id_2>"
+			  + "\n(writes one line of JSON scores per alignment, in the manifest's order)" ).c_str()
+		)
+		(
+			string( PO_BATCH_PDB_DIR ).c_str(),
+			value<path>()
+				->value_name   ( dir_varname         )
+				->notifier     ( pdb_dir_notifier    ),
+			( "Read the structures named in the manifest from directory " + dir_varname + " (default: the current directory)" ).c_str()
+		)
+		(
+			string( PO_BATCH_THREADS ).c_str(),
+			value<size_t>()
+				->value_name   ( threads_varname     )
+				->notifier     ( threads_notifier    )
+				->default_value( DEFAULT_NUM_THREADS ),
+			( "Score the batch using " + threads_varname + " threads (or 0 to use the hardware concurrency)" ).c_str()
+		);
+}
+
+/// \brief Return a string describing any problems with the current configuration of the block
+str_opt score_align_batch_options_block::do_invalid_string(const variables_map &prm_variables_map ///< The variables map, which options_blocks can use to determine which options were specified, defaulted etc
+                                                           ) const {
+	if ( ! manifest_file && specifies_option( prm_variables_map, string( PO_BATCH_PDB_DIR ) ) ) {
+		return "Cannot specify a batch PDB directory without a batch manifest"s;
+	}
+	return nullopt;
+}
+
+/// \brief Return all options names for this block
+str_view_vec score_align_batch_options_block::do_get_all_options_names() const {
+	return {
+		PO_BATCH_MANIFEST,
+		PO_BATCH_PDB_DIR,
+		PO_BATCH_THREADS,
+	};
+}
+
+/// \brief Getter for the optional manifest of alignments to score
+const path_opt & score_align_batch_options_block::get_manifest_file() const {
+	return manifest_file;
+}
+
+/// \brief Getter for the directory from which the structures named in the manifest should be read
+const path & score_align_batch_options_block::get_pdb_dir() const {
+	return pdb_dir;
+}
+
+/// \brief Getter for the number of threads to use to score the batch (or 0 to use the hardware concurrency)
+const size_t & score_align_batch_options_block::get_num_threads() const {
+	return num_threads;
+}
@@ -0,0 +1,73 @@
+/// \file
+/// \brief The score_align_batch_options_block class header
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef CATH_TOOLS_SOURCE_CT_CATH_SCORE_ALIGN_CATH_CATH_SCORE_ALIGN_OPTIONS_SCORE_ALIGN_BATCH_OPTIONS_BLOCK_HPP
+#define CATH_TOOLS_SOURCE_CT_CATH_SCORE_ALIGN_CATH_CATH_SCORE_ALIGN_OPTIONS_SCORE_ALIGN_BATCH_OPTIONS_BLOCK_HPP
+
+#include <filesystem>
+#include <string_view>
+
+#include "cath/common/path_type_aliases.hpp"
+#include "cath/options/options_block/options_block.hpp"
+
+namespace cath::opts {
+
+	/// \brief Handle options for scoring a batch of alignments listed in a manifest file
+	class score_align_batch_options_block final : public options_block {
+	private:
+		using super = options_block;
+
+		/// \brief The optional manifest of alignments to score
+		path_opt manifest_file;
+
+		/// \brief The directory from which the structures named in the manifest should be read
+		::std::filesystem::path pdb_dir;
+
+		/// \brief The number of threads to use to score the batch (or 0 to use the hardware concurrency)
+		size_t num_threads = DEFAULT_NUM_THREADS;
+
+		[[nodiscard]] std::unique_ptr<options_block> do_clone() const final;
+		[[nodiscard]] std::string                    do_get_block_name() const final;
+		void do_add_visible_options_to_description(boost::program_options::options_description &,
+		                                           const size_t &) final;
+		[[nodiscard]] str_opt do_invalid_string( const boost::program_options::variables_map & ) const final;
+		[[nodiscard]] str_view_vec do_get_all_options_names() const final;
+
+	  public:
+		[[nodiscard]] const path_opt &               get_manifest_file() const;
+		[[nodiscard]] const ::std::filesystem::path &get_pdb_dir() const;
+		[[nodiscard]] const size_t &                 get_num_threads() const;
+
+		/// \brief The option name for the manifest of alignments to score
+		static constexpr ::std::string_view PO_BATCH_MANIFEST{ "batch-manifest" };
+
+		/// \brief The option name for the directory from which to read the structures named in the manifest
+		static constexpr ::std::string_view PO_BATCH_PDB_DIR{ "batch-pdb-dir" };
+
+		/// \brief The option name for the number of threads to use to score the batch
+		static constexpr ::std::string_view PO_BATCH_THREADS{ "batch-threads" };
+
+		/// \brief The default number of threads (0, meaning use the hardware concurrency)
+		static constexpr size_t DEFAULT_NUM_THREADS = 0;
+	};
+
+} // namespace cath::opts
+
+#endif // CATH_TOOLS_SOURCE_CT_CATH_SCORE_ALIGN_CATH_CATH_SCORE_ALIGN_OPTIONS_SCORE_ALIGN_BATCH_OPTIONS_BLOCK_HPP
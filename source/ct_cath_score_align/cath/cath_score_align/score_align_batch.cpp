@@ -0,0 +1,268 @@
+/// \file
+/// \brief The score_align_batch definitions
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "score_align_batch.hpp"
+
+#include <boost/algorithm/string/classification.hpp>
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/algorithm/string/trim.hpp>
+
+#include <fmt/core.h>
+
+#include "cath/alignment/alignment.hpp"
+#include "cath/alignment/io/alignment_io.hpp"
+#include "cath/alignment/residue_score/residue_scorer.hpp"
+#include "cath/common/boost_addenda/string_algorithm/split_build.hpp"
+#include "cath/common/chrono/duration_to_seconds_string.hpp"
+#include "cath/common/exception/runtime_error_exception.hpp"
+#include "cath/common/file/open_fstream.hpp"
+#include "cath/common/json_style.hpp"
+#include "cath/common/thread/parallel_for_each_index.hpp"
+#include "cath/common/type_aliases.hpp"
+#include "cath/file/name_set/name_set.hpp"
+#include "cath/file/pdb/backbone_complete_indices.hpp"
+#include "cath/file/pdb/pdb.hpp"
+#include "cath/score/aligned_pair_score_list/aligned_pair_score_list.hpp"
+#include "cath/score/aligned_pair_score_list/aligned_pair_score_list_factory.hpp"
+#include "cath/score/aligned_pair_score_list/aligned_pair_score_value_list.hpp"
+#include "cath/score/aligned_pair_score_list/score_value_list_outputter/score_value_list_json_outputter.hpp"
+#include "cath/structure/protein/protein.hpp"
+#include "cath/structure/protein/protein_list.hpp"
+#include "cath/structure/protein/residue.hpp"
+#include "cath/structure/protein/sec_struc.hpp"
+#include "cath/structure/protein/sec_struc_planar_angles.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+using namespace ::cath;
+using namespace ::cath::align;
+using namespace ::cath::common;
+using namespace ::cath::file;
+using namespace ::cath::score;
+
+using ::boost::algorithm::starts_with;
+using ::boost::algorithm::trim_copy;
+using ::boost::is_space;
+using ::boost::token_compress_on;
+using ::std::filesystem::path;
+using ::std::ifstream;
+using ::std::istream;
+using ::std::map;
+using ::std::ostream;
+using ::std::ostringstream;
+using ::std::string;
+
+namespace {
+
+	/// \brief The number of alignments to score per thread between each write of results to the output
+	///
+	/// The results are written in manifest order after each chunk of this many alignments per thread,
+	/// which keeps the memory use bounded however large the manifest is.
+	constexpr size_t CHUNK_SIZE_PER_THREAD = 64;
+
+	/// \brief A structure loaded once for all the alignments in a batch that use it
+	struct batch_structure final {
+		/// \brief The protein built from the PDB
+		protein the_protein;
+
+		/// \brief The amino acids of the PDB, against which FASTA sequences are matched
+		amino_acid_vec amino_acids;
+
+		/// \brief The indices of the PDB's backbone-complete residues
+		backbone_complete_indices bb_complete_indices;
+	};
+
+	/// \brief The structures required by a batch, each loaded once, and the index of each by its ID
+	struct batch_structure_cache final {
+		/// \brief The loaded structures
+		std::vector<batch_structure> structures;
+
+		/// \brief The index of each structure in structures, by its ID
+		map<string, size_t> index_of_id;
+	};
+
+	/// \brief Load each of the distinct structures used in the specified entries once, using up to the specified number of threads
+	batch_structure_cache load_batch_structures(const score_align_batch_entry_vec &prm_entries,    ///< The manifest entries that will be scored
+	                                            const path                        &prm_pdb_dir,    ///< The directory from which to read the structures
+	                                            const size_t                      &prm_num_threads ///< The number of threads to use
+	                                            ) {
+		batch_structure_cache the_cache;
+		str_vec ids;
+		for (const score_align_batch_entry &the_entry : prm_entries) {
+			for (const string &id : { the_entry.id_a, the_entry.id_b } ) {
+				if ( the_cache.index_of_id.emplace( id, ids.size() ).second ) {
+					ids.push_back( id );
+				}
+			}
+		}
+
+		the_cache.structures.resize( ids.size() );
+		parallel_for_each_index( ids.size(), prm_num_threads, [&] (const size_t &prm_index) {
+			const path pdb_file    = prm_pdb_dir / ids[ prm_index ];
+			const pdb  the_pdb     = read_pdb_file( pdb_file );
+			batch_structure &the_structure = the_cache.structures[ prm_index ];
+			the_structure.the_protein         = build_protein_of_pdb_and_name( the_pdb, name_set{ pdb_file, ids[ prm_index ] } );
+			the_structure.amino_acids         = get_amino_acid_list          ( the_pdb );
+			the_structure.bb_complete_indices = get_backbone_complete_indices( the_pdb );
+		} );
+		return the_cache;
+	}
+
+	/// \brief Score the alignment in the specified entry and return the scores as a line of compact JSON
+	///
+	/// This reads and scores the alignment in the same way as cath-score-align does for a single alignment
+	/// read from a FASTA file.
+	string score_batch_entry(const score_align_batch_entry &prm_entry,      ///< The manifest entry to score
+	                         const batch_structure_cache   &prm_cache,      ///< The cache of loaded structures
+	                         const aligned_pair_score_list &prm_score_list, ///< The scores to calculate
+	                         ostream                       &prm_stderr      ///< An ostream to which any warnings should be written
+	                         ) {
+		const batch_structure &structure_a = prm_cache.structures[ prm_cache.index_of_id.at( prm_entry.id_a ) ];
+		const batch_structure &structure_b = prm_cache.structures[ prm_cache.index_of_id.at( prm_entry.id_b ) ];
+
+		ifstream aln_istream = open_ifstream( prm_entry.alignment_file );
+		const alignment the_alignment = convert_to_backbone_complete_indices_copy(
+			read_alignment_from_fasta(
+				aln_istream,
+				{ structure_a.amino_acids, structure_b.amino_acids },
+				{ prm_entry.id_a,          prm_entry.id_b          },
+				prm_stderr
+			),
+			{ structure_a.bb_complete_indices, structure_b.bb_complete_indices }
+		);
+		aln_istream.close();
+
+		protein_list proteins;
+		proteins.reserve( 2 );
+		proteins.push_back( structure_a.the_protein );
+		proteins.push_back( structure_b.the_protein );
+		const alignment scored_alignment = score_alignment_copy( residue_scorer(), the_alignment, proteins );
+
+		ostringstream json_ss;
+		json_ss << score_value_list_json_outputter(
+			make_aligned_pair_score_value_list( prm_score_list, scored_alignment, proteins[ 0 ], proteins[ 1 ] ),
+			json_style::COMPACT
+		);
+		return json_ss.str();
+	}
+
+} // namespace
+
+/// \brief Read a manifest of alignments to score from the specified istream
+///
+/// Each line should contain a FASTA alignment file followed by the IDs of its two structures,
+/// separated by whitespace. Blank lines and lines starting with '#' are ignored.
+score_align_batch_entry_vec cath::read_score_align_batch_manifest(istream &prm_istream ///< The istream from which to read the manifest
+                                                                  ) {
+	score_align_batch_entry_vec entries;
+	string line_string;
+	while ( getline( prm_istream, line_string ) ) {
+		const string trimmed_line = trim_copy( line_string );
+		if ( trimmed_line.empty() || starts_with( trimmed_line, "#" ) ) {
+			continue;
+		}
+		const auto line_parts = split_build<str_vec>( trimmed_line, is_space(), token_compress_on );
+		if ( line_parts.size() != 3 ) {
+			BOOST_THROW_EXCEPTION(runtime_error_exception(
+				"Whilst reading the score-align batch manifest, unable to find exactly three parts (alignment file and two IDs) in line:\n"
+				+ line_string
+			));
+		}
+		entries.push_back( { path{ line_parts[ 0 ] }, line_parts[ 1 ], line_parts[ 2 ] } );
+	}
+	return entries;
+}
+
+/// \brief Read a manifest of alignments to score from the specified file
+///
+/// \copydetails read_score_align_batch_manifest(istream &)
+score_align_batch_entry_vec cath::read_score_align_batch_manifest_file(const path &prm_manifest_file ///< The file from which to read the manifest
+                                                                       ) {
+	ifstream manifest_istream = open_ifstream( prm_manifest_file );
+	auto entries = read_score_align_batch_manifest( manifest_istream );
+	manifest_istream.close();
+	return entries;
+}
+
+/// \brief Score each of the alignments in the specified manifest entries and write their scores to the specified ostream
+///
+/// Each structure is loaded once (in parallel) and then the alignments are scored in parallel, in chunks.
+/// The scores of each alignment are written as one line of compact JSON via score_value_list_json_outputter
+/// in the order of the entries, regardless of the number of threads. Any warnings are similarly written
+/// to prm_stderr in the order of the entries.
+///
+/// If any alignment fails to be scored, the exception is rethrown after the threads have finished
+/// (with the results for all preceding chunks already written).
+score_align_batch_stats cath::score_align_batch(const score_align_batch_entry_vec &prm_entries,     ///< The manifest entries to score
+                                                const path                        &prm_pdb_dir,     ///< The directory from which to read the structures
+                                                const size_t                      &prm_num_threads, ///< The number of threads to use (or 0 to use the hardware concurrency)
+                                                ostream                           &prm_stdout,      ///< The ostream to which the scores should be written
+                                                ostream                           &prm_stderr       ///< The ostream to which any warnings should be written
+                                                ) {
+	const auto   start_time  = std::chrono::high_resolution_clock::now();
+	const size_t num_threads = num_threads_to_use( prm_num_threads );
+
+	const batch_structure_cache   the_cache  = load_batch_structures( prm_entries, prm_pdb_dir, num_threads );
+	const aligned_pair_score_list score_list = make_default_aligned_pair_score_list();
+
+	const size_t chunk_size = CHUNK_SIZE_PER_THREAD * num_threads;
+	str_vec jsons   ( std::min( chunk_size, prm_entries.size() ) );
+	str_vec warnings( std::min( chunk_size, prm_entries.size() ) );
+	for (size_t chunk_begin = 0; chunk_begin < prm_entries.size(); chunk_begin += chunk_size) {
+		const size_t chunk_length = std::min( chunk_size, prm_entries.size() - chunk_begin );
+		parallel_for_each_index( chunk_length, num_threads, [&] (const size_t &prm_index) {
+			ostringstream warnings_ss;
+			jsons   [ prm_index ] = score_batch_entry( prm_entries[ chunk_begin + prm_index ], the_cache, score_list, warnings_ss );
+			warnings[ prm_index ] = warnings_ss.str();
+		} );
+		for (size_t index = 0; index < chunk_length; ++index) {
+			prm_stderr << warnings[ index ];
+			prm_stdout << jsons   [ index ];
+		}
+		prm_stdout.flush();
+	}
+
+	return {
+		prm_entries.size(),
+		the_cache.structures.size(),
+		num_threads,
+		std::chrono::high_resolution_clock::now() - start_time
+	};
+}
+
+/// \brief Generate a string describing the specified score_align_batch_stats
+///
+/// \relates score_align_batch_stats
+string cath::to_string(const score_align_batch_stats &prm_stats ///< The score_align_batch_stats to describe
+                       ) {
+	const double seconds = durn_to_seconds_double( prm_stats.duration );
+	return ::fmt::format(
+		"Scored {} alignments of {} structures in {:.3f} seconds ({:.1f} alignments / second) using {} thread(s)",
+		prm_stats.num_alignments,
+		prm_stats.num_structures,
+		seconds,
+		( seconds > 0.0 ) ? static_cast<double>( prm_stats.num_alignments ) / seconds : 0.0,
+		prm_stats.num_threads
+	);
+}
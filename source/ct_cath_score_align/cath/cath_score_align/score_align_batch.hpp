@@ -0,0 +1,77 @@
+/// \file
+/// \brief The score_align_batch header
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef CATH_TOOLS_SOURCE_CT_CATH_SCORE_ALIGN_CATH_CATH_SCORE_ALIGN_SCORE_ALIGN_BATCH_HPP
+#define CATH_TOOLS_SOURCE_CT_CATH_SCORE_ALIGN_CATH_CATH_SCORE_ALIGN_SCORE_ALIGN_BATCH_HPP
+
+#include "cath/common/chrono/chrono_type_aliases.hpp"
+
+#include <filesystem>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace cath {
+
+	/// \brief One entry in a manifest of alignments to score: a FASTA alignment file and the IDs of its two structures
+	struct score_align_batch_entry final {
+		/// \brief The FASTA file containing the pairwise alignment
+		::std::filesystem::path alignment_file;
+
+		/// \brief The ID of the first structure (which should be found within the first FASTA header)
+		::std::string id_a;
+
+		/// \brief The ID of the second structure (which should be found within the second FASTA header)
+		::std::string id_b;
+	};
+
+	/// \brief Type alias for a vector of score_align_batch_entry values
+	using score_align_batch_entry_vec = ::std::vector<score_align_batch_entry>;
+
+	/// \brief Summary statistics from scoring a batch of alignments
+	struct score_align_batch_stats final {
+		/// \brief The number of alignments scored
+		size_t num_alignments = 0;
+
+		/// \brief The number of distinct structures loaded
+		size_t num_structures = 0;
+
+		/// \brief The number of threads used
+		size_t num_threads = 0;
+
+		/// \brief The time taken to load the structures and score the alignments
+		hrc_duration duration{};
+	};
+
+	score_align_batch_entry_vec read_score_align_batch_manifest(std::istream &);
+
+	score_align_batch_entry_vec read_score_align_batch_manifest_file(const ::std::filesystem::path &);
+
+	score_align_batch_stats score_align_batch(const score_align_batch_entry_vec &,
+	                                          const ::std::filesystem::path &,
+	                                          const size_t &,
+	                                          std::ostream &,
+	                                          std::ostream &);
+
+	std::string to_string(const score_align_batch_stats &);
+
+} // namespace cath
+
+#endif // CATH_TOOLS_SOURCE_CT_CATH_SCORE_ALIGN_CATH_CATH_SCORE_ALIGN_SCORE_ALIGN_BATCH_HPP
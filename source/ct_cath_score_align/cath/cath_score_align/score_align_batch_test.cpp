@@ -0,0 +1,137 @@
+/// \file
+/// \brief The score_align_batch test suite
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "score_align_batch.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include "cath/alignment/alignment.hpp"
+#include "cath/alignment/io/alignment_io.hpp"
+#include "cath/alignment/residue_score/residue_scorer.hpp"
+#include "cath/common/exception/runtime_error_exception.hpp"
+#include "cath/common/json_style.hpp"
+#include "cath/file/pdb/pdb.hpp"
+#include "cath/file/pdb/pdb_list.hpp"
+#include "cath/score/aligned_pair_score_list/aligned_pair_score_list_factory.hpp"
+#include "cath/score/aligned_pair_score_list/aligned_pair_score_value_list.hpp"
+#include "cath/score/aligned_pair_score_list/score_value_list_outputter/score_value_list_json_outputter.hpp"
+#include "cath/structure/protein/protein.hpp"
+#include "cath/structure/protein/protein_list.hpp"
+#include "cath/structure/protein/residue.hpp"
+#include "cath/structure/protein/sec_struc.hpp"
+#include "cath/structure/protein/sec_struc_planar_angles.hpp"
+#include "cath/test/global_test_constants.hpp"
+
+#include <sstream>
+
+using namespace ::cath;
+using namespace ::cath::align;
+using namespace ::cath::common;
+using namespace ::cath::file;
+using namespace ::cath::score;
+
+using ::std::filesystem::path;
+using ::std::istringstream;
+using ::std::ostringstream;
+using ::std::string;
+
+namespace {
+
+	/// \brief The score_align_batch_test_suite_fixture to assist in testing score_align_batch
+	struct score_align_batch_test_suite_fixture : protected global_test_constants {
+	protected:
+		~score_align_batch_test_suite_fixture() noexcept = default;
+
+		/// \brief The directory containing the structures and alignments
+		const path ALIGN_PAIR_SCORE_TEST_DIR{ TEST_SOURCE_DATA_DIR() / "aligned_pair_score" };
+
+		/// \brief A batch of all the test alignments against 1c55A
+		const score_align_batch_entry_vec entries{
+			{ ALIGN_PAIR_SCORE_TEST_DIR / "1c55A_1c55A.aln.fa", "1c55A", "1c55A" },
+			{ ALIGN_PAIR_SCORE_TEST_DIR / "1c55A_1c56A.aln.fa", "1c55A", "1c56A" },
+			{ ALIGN_PAIR_SCORE_TEST_DIR / "1c55A_1hykA.aln.fa", "1c55A", "1hykA" },
+			{ ALIGN_PAIR_SCORE_TEST_DIR / "1c55A_1wmtA.aln.fa", "1c55A", "1wmtA" },
+			{ ALIGN_PAIR_SCORE_TEST_DIR / "1c55A_1wt7A.aln.fa", "1c55A", "1wt7A" },
+		};
+
+		/// \brief Score the specified entry by reading it through the standard, single-alignment route
+		[[nodiscard]] string score_individually(const score_align_batch_entry &prm_entry ///< The entry to score
+		                                        ) const {
+			const pdb_list pdbs{ {
+				read_pdb_file( ALIGN_PAIR_SCORE_TEST_DIR / prm_entry.id_a ),
+				read_pdb_file( ALIGN_PAIR_SCORE_TEST_DIR / prm_entry.id_b ),
+			} };
+			const protein_list proteins  = build_protein_list_of_pdb_list( pdbs );
+			const alignment    the_alignment = score_alignment_copy(
+				residue_scorer(),
+				read_alignment_from_fasta_file( prm_entry.alignment_file, pdbs, { prm_entry.id_a, prm_entry.id_b } ),
+				proteins
+			);
+			ostringstream json_ss;
+			json_ss << score_value_list_json_outputter(
+				make_aligned_pair_score_value_list( make_default_aligned_pair_score_list(), the_alignment, proteins[ 0 ], proteins[ 1 ] ),
+				json_style::COMPACT
+			);
+			return json_ss.str();
+		}
+
+		/// \brief Score the batch of entries with the specified number of threads and return the output
+		[[nodiscard]] string score_batch(const size_t &prm_num_threads ///< The number of threads to use
+		                                 ) const {
+			ostringstream stdout_ss;
+			ostringstream stderr_ss;
+			const score_align_batch_stats stats = score_align_batch( entries, ALIGN_PAIR_SCORE_TEST_DIR, prm_num_threads, stdout_ss, stderr_ss );
+			BOOST_CHECK_EQUAL( stats.num_alignments, entries.size() );
+			BOOST_CHECK_EQUAL( stats.num_structures, 5                );
+			BOOST_CHECK_EQUAL( stats.num_threads,    prm_num_threads  );
+			return stdout_ss.str();
+		}
+	};
+
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE(score_align_batch_test_suite, score_align_batch_test_suite_fixture)
+
+BOOST_AUTO_TEST_CASE(reads_manifest_skipping_blank_and_comment_lines) {
+	istringstream manifest_ss{ "# aln id_a id_b\n\n  a.fa\t1c55A  1hykA \nb.fa 1c55A 1c56A\n" };
+	const score_align_batch_entry_vec got = read_score_align_batch_manifest( manifest_ss );
+	BOOST_REQUIRE_EQUAL( got.size(), 2 );
+	BOOST_CHECK_EQUAL( got[ 0 ].alignment_file, path{ "a.fa" } );
+	BOOST_CHECK_EQUAL( got[ 0 ].id_a,           "1c55A"        );
+	BOOST_CHECK_EQUAL( got[ 0 ].id_b,           "1hykA"        );
+	BOOST_CHECK_EQUAL( got[ 1 ].alignment_file, path{ "b.fa" } );
+	BOOST_CHECK_EQUAL( got[ 1 ].id_b,           "1c56A"        );
+}
+
+BOOST_AUTO_TEST_CASE(throws_on_manifest_line_without_three_parts) {
+	istringstream manifest_ss{ "a.fa 1c55A\n" };
+	BOOST_CHECK_THROW( read_score_align_batch_manifest( manifest_ss ), runtime_error_exception );
+}
+
+BOOST_AUTO_TEST_CASE(batch_matches_individual_scoring_in_manifest_order) {
+	string expected;
+	for (const score_align_batch_entry &the_entry : entries) {
+		expected += score_individually( the_entry );
+	}
+	BOOST_CHECK_EQUAL( score_batch( 1 ), expected );
+	BOOST_CHECK_EQUAL( score_batch( 3 ), expected );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,59 @@
+/// \file
+/// \brief The buffered_ostream_sink class definitions
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "buffered_ostream_sink.hpp"
+
+#include <ostream>
+
+using namespace ::cath::common;
+
+using ::std::ostream;
+using ::std::streamsize;
+
+/// \brief Ctor from the ostreams to which the text should be written and the flush threshold
+buffered_ostream_sink::buffered_ostream_sink(ref_vec<ostream> prm_ostreams,       ///< The ostreams to which the text should be written
+                                             const size_t     &prm_flush_threshold ///< The size of buffer at which it should be written to the ostreams before more text is added
+                                             ) : ostreams       { ::std::move( prm_ostreams ) },
+                                                 flush_threshold{ prm_flush_threshold         } {
+}
+
+/// \brief Ctor from the ostream to which the text should be written and the flush threshold
+buffered_ostream_sink::buffered_ostream_sink(ostream      &prm_ostream,        ///< The ostream to which the text should be written
+                                             const size_t &prm_flush_threshold ///< The size of buffer at which it should be written to the ostream before more text is added
+                                             ) : buffered_ostream_sink{ ref_vec<ostream>{ prm_ostream }, prm_flush_threshold } {
+}
+
+/// \brief Copy ctor, which copies any text that's currently buffered
+buffered_ostream_sink::buffered_ostream_sink(const buffered_ostream_sink &prm_other ///< The buffered_ostream_sink to copy
+                                             ) : ostreams       { prm_other.ostreams        },
+                                                 flush_threshold{ prm_other.flush_threshold } {
+	buffer.append( prm_other.buffer.data(), prm_other.buffer.data() + prm_other.buffer.size() );
+}
+
+/// \brief Write the buffer to each of the ostreams and then clear it
+buffered_ostream_sink & buffered_ostream_sink::flush() {
+	if ( buffer.size() > 0 ) {
+		for (const ostream_ref &the_ostream_ref : ostreams) {
+			the_ostream_ref.get().write( buffer.data(), static_cast<streamsize>( buffer.size() ) );
+		}
+		buffer.clear();
+	}
+	return *this;
+}
@@ -0,0 +1,142 @@
+/// \file
+/// \brief The buffered_ostream_sink class header
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef CATH_TOOLS_SOURCE_CT_COMMON_CATH_COMMON_FILE_BUFFERED_OSTREAM_SINK_HPP
+#define CATH_TOOLS_SOURCE_CT_COMMON_CATH_COMMON_FILE_BUFFERED_OSTREAM_SINK_HPP
+
+#include <cstddef>
+#include <iosfwd>
+#include <iterator>
+#include <string_view>
+
+#include <fmt/format.h>
+
+#include "cath/common/type_aliases.hpp"
+
+namespace cath::common {
+
+	/// \brief Buffer text that's to be written to a list of ostreams and write it out whenever
+	///        the buffer reaches a fixed size (or when flush() is called)
+	///
+	/// This lets code that generates lots of output write it piece by piece into one reused buffer
+	/// (rather than building and concatenating temporary strings) whilst keeping the memory bounded.
+	/// Text can be formatted straight into the buffer with fmt, eg:
+	///
+	///     ::fmt::format_to( the_sink.out(), "{}: {:.4g}\n", the_id, the_score );
+	///
+	/// This also provides the Put()/Flush() interface of a rapidjson output stream, so it can be
+	/// used as the OStrm of a rapidjson_writer.
+	///
+	/// Nothing is written on destruction so clients should call flush() when they've finished writing.
+	class buffered_ostream_sink final {
+	private:
+		/// \brief The ostreams to which the text should be written
+		ref_vec<::std::ostream> ostreams;
+
+		/// \brief The buffer of text that hasn't yet been written to the ostreams
+		::fmt::memory_buffer buffer;
+
+		/// \brief The size of buffer at which it should be written to the ostreams before more text is added
+		size_t flush_threshold;
+
+		void flush_if_full();
+
+	public:
+		/// \brief The default size of buffer at which it should be written to the ostreams
+		static constexpr size_t DEFAULT_FLUSH_THRESHOLD = 65'536;
+
+		/// \brief The character type, as required of a rapidjson output stream
+		using Ch = char;
+
+		explicit buffered_ostream_sink(ref_vec<::std::ostream>,
+		                               const size_t & = DEFAULT_FLUSH_THRESHOLD);
+		explicit buffered_ostream_sink(::std::ostream &,
+		                               const size_t & = DEFAULT_FLUSH_THRESHOLD);
+
+		buffered_ostream_sink(const buffered_ostream_sink &);
+		buffered_ostream_sink(buffered_ostream_sink &&) noexcept = default;
+		buffered_ostream_sink & operator=(const buffered_ostream_sink &) = delete;
+		buffered_ostream_sink & operator=(buffered_ostream_sink &&) = delete;
+		~buffered_ostream_sink() noexcept = default;
+
+		[[nodiscard]] size_t get_num_buffered_chars() const;
+
+		::std::back_insert_iterator<::fmt::memory_buffer> out();
+		buffered_ostream_sink & append(const ::std::string_view &);
+		buffered_ostream_sink & put(const char &);
+		buffered_ostream_sink & flush();
+
+		void Put(const char &);
+		void Flush();
+	};
+
+	/// \brief Write the buffer to the ostreams if it has reached the flush threshold
+	inline void buffered_ostream_sink::flush_if_full() {
+		if ( buffer.size() >= flush_threshold ) {
+			flush();
+		}
+	}
+
+	/// \brief Get the number of characters currently held in the buffer
+	inline size_t buffered_ostream_sink::get_num_buffered_chars() const {
+		return buffer.size();
+	}
+
+	/// \brief Get an output iterator that appends to the buffer (eg for use with ::fmt::format_to()),
+	///        first writing the buffer to the ostreams if it has reached the flush threshold
+	///
+	/// The iterator should be used for a single write and then discarded
+	inline ::std::back_insert_iterator<::fmt::memory_buffer> buffered_ostream_sink::out() {
+		flush_if_full();
+		return ::std::back_inserter( buffer );
+	}
+
+	/// \brief Append the specified text to the buffer, first writing the buffer to the ostreams
+	///        if it has reached the flush threshold
+	inline buffered_ostream_sink & buffered_ostream_sink::append(const ::std::string_view &prm_text ///< The text to append
+	                                                             ) {
+		flush_if_full();
+		buffer.append( prm_text.data(), prm_text.data() + prm_text.size() );
+		return *this;
+	}
+
+	/// \brief Append the specified char to the buffer, first writing the buffer to the ostreams
+	///        if it has reached the flush threshold
+	inline buffered_ostream_sink & buffered_ostream_sink::put(const char &prm_char ///< The char to append
+	                                                          ) {
+		flush_if_full();
+		buffer.push_back( prm_char );
+		return *this;
+	}
+
+	/// \brief Append the specified char to the buffer (as required of a rapidjson output stream)
+	inline void buffered_ostream_sink::Put(const char &prm_char ///< The char to append
+	                                       ) {
+		put( prm_char );
+	}
+
+	/// \brief Write the buffer to the ostreams (as required of a rapidjson output stream)
+	inline void buffered_ostream_sink::Flush() {
+		flush();
+	}
+
+} // namespace cath::common
+
+#endif // CATH_TOOLS_SOURCE_CT_COMMON_CATH_COMMON_FILE_BUFFERED_OSTREAM_SINK_HPP
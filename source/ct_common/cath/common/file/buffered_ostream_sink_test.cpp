@@ -0,0 +1,71 @@
+/// \file
+/// \brief The buffered_ostream_sink test suite
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <sstream>
+
+#include <boost/test/unit_test.hpp>
+
+#include "cath/common/file/buffered_ostream_sink.hpp"
+
+using namespace ::cath;
+using namespace ::cath::common;
+
+using ::std::ostringstream;
+
+BOOST_AUTO_TEST_SUITE(buffered_ostream_sink_test_suite)
+
+BOOST_AUTO_TEST_CASE(writes_all_text_to_all_ostreams_only_on_flush) {
+	ostringstream test_ostream_1;
+	ostringstream test_ostream_2;
+	buffered_ostream_sink the_sink{ { test_ostream_1, test_ostream_2 } };
+
+	the_sink.append( "The answer" ).put( ' ' );
+	::fmt::format_to( the_sink.out(), "is {} ({:.3g})", 42, 41.99 );
+	BOOST_CHECK_EQUAL( test_ostream_1.str(), "" );
+	BOOST_CHECK_EQUAL( the_sink.get_num_buffered_chars(), 21 );
+
+	the_sink.flush();
+	BOOST_CHECK_EQUAL( test_ostream_1.str(), "The answer is 42 (42)" );
+	BOOST_CHECK_EQUAL( test_ostream_2.str(), "The answer is 42 (42)" );
+	BOOST_CHECK_EQUAL( the_sink.get_num_buffered_chars(), 0 );
+}
+
+BOOST_AUTO_TEST_CASE(writes_buffer_before_adding_more_once_over_threshold) {
+	ostringstream test_ostream;
+	buffered_ostream_sink the_sink{ test_ostream, 4 };
+
+	the_sink.append( "abc" );
+	BOOST_CHECK_EQUAL( test_ostream.str(), "" );
+	the_sink.append( "def" );
+	BOOST_CHECK_EQUAL( test_ostream.str(), "" );
+	the_sink.put( 'g' );
+	BOOST_CHECK_EQUAL( test_ostream.str(), "abcdef" );
+	::fmt::format_to( the_sink.out(), "{}", 'h' );
+	BOOST_CHECK_EQUAL( test_ostream.str(), "abcdef" );
+	the_sink.Put( 'i' );
+	the_sink.Put( 'j' );
+	BOOST_CHECK_EQUAL( test_ostream.str(), "abcdef" );
+	the_sink.Put( 'k' );
+	BOOST_CHECK_EQUAL( test_ostream.str(), "abcdefghij" );
+	the_sink.Flush();
+	BOOST_CHECK_EQUAL( test_ostream.str(), "abcdefghijk" );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -29,6 +29,7 @@
 #include "cath/common/json_style.hpp"
 
 #include <string>
+#include <string_view>
 
 namespace cath::common {
 
@@ -77,10 +78,9 @@ namespace cath::common {
 		}
 
 		/// \brief Write a raw string in the JSON
-		template <typename... Ts>
-		rapidjson_writer & write_raw_string(const std::string &prm_string
+		rapidjson_writer & write_raw_string(const ::std::string_view &prm_string ///< The raw JSON string to write
 		                                    ) {
-			writer.RawValue( prm_string.c_str(), prm_string.length(), rapidjson::kNullType );
+			writer.RawValue( prm_string.data(), prm_string.length(), rapidjson::kNullType );
 			return *this;
 		}
 
@@ -105,6 +105,13 @@ namespace cath::common {
 			return *this;
 		}
 
+		/// \brief Write a string_view value to the JSON
+		rapidjson_writer & write_value(const ::std::string_view &prm_value ///< The string_view value
+		                               ) {
+			writer.String( prm_value.data(), debug_numeric_cast<unsigned int>( prm_value.length() ) );
+			return *this;
+		}
+
 		/// \brief Write a string value to the JSON
 		rapidjson_writer & write_value(const char * const prm_value ///< The string value (can be std::string or char *)
 		                               ) {
@@ -196,6 +203,27 @@ namespace cath::common {
 			return { get_c_string() };
 		}
 
+		/// \brief Clear the JSON written so far and reset the writer so this can be reused to write
+		///        a fresh JSON value into the same (already allocated) buffer
+		///
+		/// This is only available for OStrm types that can be cleared (eg rapidjson::StringBuffer)
+		rapidjson_writer & clear() {
+			outstream.Clear();
+			writer.Reset( outstream );
+			return *this;
+		}
+
+		/// \brief Flush the outstream (eg to write any buffered JSON to an underlying ostream)
+		rapidjson_writer & flush() {
+			outstream.Flush();
+			return *this;
+		}
+
+		/// \brief Get a std::string_view of the JSON written so far
+		[[nodiscard]] ::std::string_view get_string_view() const {
+			return { outstream.GetString(), outstream.GetSize() };
+		}
+
 		/// \brief Get whether the JSON is complete (ie finished the initial array/object/value)
 		///        after which no more data can be written
 		[[nodiscard]] bool is_complete() const {
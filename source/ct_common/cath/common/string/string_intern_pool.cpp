@@ -0,0 +1,107 @@
+/// \file
+/// \brief The string_intern_pool class definitions
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "string_intern_pool.hpp"
+
+#include <algorithm>
+
+using namespace ::cath::common;
+
+using ::std::lock_guard;
+using ::std::make_unique;
+using ::std::mutex;
+using ::std::string_view;
+
+/// \brief Copy the specified string into the blocks (adding a new block if the current one doesn't have room)
+///        and return a string_view of the copy
+///
+/// \pre the_mutex is held
+string_view string_intern_pool::copy_to_blocks(const string_view &prm_string ///< The string to copy
+                                               ) {
+	if ( prm_string.length() > num_free ) {
+		// Strings longer than the block size get a block to themselves
+		const size_t new_block_size = std::max( block_size, prm_string.length() );
+		blocks.push_back( make_unique<char[]>( new_block_size ) );
+		num_block_chars += new_block_size;
+		next_free = blocks.back().get();
+		num_free  = new_block_size;
+	}
+	std::copy( prm_string.begin(), prm_string.end(), next_free );
+	const string_view result{ next_free, prm_string.length() };
+	next_free += prm_string.length();
+	num_free  -= prm_string.length();
+	num_chars += prm_string.length();
+	return result;
+}
+
+/// \brief Ctor from the minimum size of each block of memory in which the strings are stored
+string_intern_pool::string_intern_pool(const size_t &prm_block_size ///< The minimum size of each block of memory in which the strings are stored
+                                       ) : block_size{ std::max<size_t>( prm_block_size, 1 ) } {
+}
+
+/// \brief Return a string_view of the pool's copy of the specified string, adding it to the pool if it isn't already there
+///
+/// The returned string_view remains valid for the lifetime of the pool.
+string_view string_intern_pool::intern(const string_view &prm_string ///< The string to intern
+                                       ) {
+	if ( prm_string.empty() ) {
+		return {};
+	}
+	const lock_guard<mutex> lock{ the_mutex };
+	const auto find_itr = index.find( prm_string );
+	if ( find_itr != index.end() ) {
+		return *find_itr;
+	}
+	const string_view result = *index.insert( copy_to_blocks( prm_string ) ).first;
+
+	// Approximate the index's memory as a node per string plus a pointer per bucket
+	num_bytes.store(
+		num_block_chars
+			+ index.size()         * ( sizeof( string_view ) + 2 * sizeof( void * ) )
+			+ index.bucket_count() * sizeof( void * ),
+		std::memory_order_relaxed
+	);
+	return result;
+}
+
+/// \brief The number of distinct (non-empty) strings that have been interned
+size_t string_intern_pool::size() const {
+	const lock_guard<mutex> lock{ the_mutex };
+	return index.size();
+}
+
+/// \brief The total number of chars used by the distinct strings that have been interned
+size_t string_intern_pool::get_num_chars() const {
+	const lock_guard<mutex> lock{ the_mutex };
+	return num_chars;
+}
+
+/// \brief The number of blocks of memory that have been allocated to store the strings
+size_t string_intern_pool::get_num_blocks() const {
+	const lock_guard<mutex> lock{ the_mutex };
+	return blocks.size();
+}
+
+/// \brief The approximate number of bytes of memory used by the pool (for its blocks and its index)
+///
+/// This doesn't lock the mutex so it's cheap enough to call for every interned string.
+size_t string_intern_pool::get_num_bytes() const {
+	return num_bytes.load( std::memory_order_relaxed );
+}
@@ -0,0 +1,98 @@
+/// \file
+/// \brief The string_intern_pool class header
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef CATH_TOOLS_SOURCE_CT_COMMON_CATH_COMMON_STRING_STRING_INTERN_POOL_HPP
+#define CATH_TOOLS_SOURCE_CT_COMMON_CATH_COMMON_STRING_STRING_INTERN_POOL_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+namespace cath::common {
+
+	/// \brief An append-only pool of distinct strings, each stored once in large blocks of memory,
+	///        that hands out string_views that remain valid for the lifetime of the pool
+	///
+	/// This is useful when the same strings (eg the labels of HMMER models) are repeated many
+	/// times: each distinct string costs one copy in the pool rather than one allocation per use.
+	///
+	/// Interned strings are never removed and the blocks are never moved, so a string_view
+	/// returned by intern() stays valid (and can be read from any thread) until the pool is destroyed.
+	/// intern() is thread-safe.
+	class string_intern_pool final {
+	private:
+		/// \brief The minimum size of each block of memory in which the strings are stored
+		size_t block_size;
+
+		/// \brief The blocks of memory in which the strings are stored
+		std::vector<std::unique_ptr<char[]>> blocks;
+
+		/// \brief The next free char in the current block (or nullptr if there isn't one)
+		char * next_free = nullptr;
+
+		/// \brief The number of free chars remaining in the current block
+		size_t num_free = 0;
+
+		/// \brief The total number of chars used by the interned strings
+		size_t num_chars = 0;
+
+		/// \brief The total number of chars allocated in the blocks
+		size_t num_block_chars = 0;
+
+		/// \brief An index of the interned strings, each of which refers to its copy in the blocks
+		std::unordered_set<std::string_view> index;
+
+		/// \brief The mutex protecting all the data above
+		mutable std::mutex the_mutex;
+
+		/// \brief The approximate number of bytes of memory used by the pool
+		///
+		/// This is updated whilst the_mutex is held but may be read without it
+		std::atomic<size_t> num_bytes{ 0 };
+
+		std::string_view copy_to_blocks(const std::string_view &);
+
+	public:
+		/// \brief The default minimum size of each block of memory in which the strings are stored
+		static constexpr size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+		explicit string_intern_pool(const size_t & = DEFAULT_BLOCK_SIZE);
+
+		string_intern_pool(const string_intern_pool &) = delete;
+		string_intern_pool(string_intern_pool &&) = delete;
+		string_intern_pool & operator=(const string_intern_pool &) = delete;
+		string_intern_pool & operator=(string_intern_pool &&) = delete;
+		~string_intern_pool() noexcept = default;
+
+		std::string_view intern(const std::string_view &);
+
+		[[nodiscard]] size_t size() const;
+		[[nodiscard]] size_t get_num_chars() const;
+		[[nodiscard]] size_t get_num_blocks() const;
+		[[nodiscard]] size_t get_num_bytes() const;
+	};
+
+} // namespace cath::common
+
+#endif // CATH_TOOLS_SOURCE_CT_COMMON_CATH_COMMON_STRING_STRING_INTERN_POOL_HPP
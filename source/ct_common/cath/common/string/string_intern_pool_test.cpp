@@ -0,0 +1,82 @@
+/// \file
+/// \brief The string_intern_pool test suite
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "string_intern_pool.hpp"
+
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace ::cath::common;
+
+using ::std::string;
+using ::std::string_view;
+
+BOOST_AUTO_TEST_SUITE(string_intern_pool_test_suite)
+
+BOOST_AUTO_TEST_CASE(interns_equal_strings_to_the_same_copy) {
+	string_intern_pool the_pool;
+	string label_a{ "cath|current|1mfaH01/251-347-i5_1" };
+	const string_view interned_a = the_pool.intern( label_a );
+	const string_view interned_b = the_pool.intern( string{ "cath|current|1mfaH01/251-347-i5_1" } );
+	const string_view interned_c = the_pool.intern( "cath|current|2i24N00/2-114-i5_1" );
+
+	BOOST_CHECK_EQUAL( interned_a, "cath|current|1mfaH01/251-347-i5_1" );
+	BOOST_CHECK_EQUAL( interned_c, "cath|current|2i24N00/2-114-i5_1"   );
+	BOOST_CHECK      ( static_cast<const void *>( interned_a.data() ) == static_cast<const void *>( interned_b.data() ) );
+	BOOST_CHECK      ( static_cast<const void *>( interned_a.data() ) != static_cast<const void *>( label_a.data()    ) );
+	BOOST_CHECK_EQUAL( the_pool.size(),          2  );
+	BOOST_CHECK_EQUAL( the_pool.get_num_chars(), 64 );
+
+	// The interned copy is unaffected by changes to the original
+	label_a.assign( label_a.size(), 'x' );
+	BOOST_CHECK_EQUAL( interned_a, "cath|current|1mfaH01/251-347-i5_1" );
+}
+
+BOOST_AUTO_TEST_CASE(views_stay_valid_as_blocks_are_added) {
+	string_intern_pool the_pool{ 8 };
+	const string_view short_view = the_pool.intern( "abc" );
+	const string_view long_view  = the_pool.intern( "a string longer than a block" );
+	for (size_t ctr = 0; ctr < 100; ++ctr) {
+		the_pool.intern( std::to_string( ctr ) );
+	}
+	BOOST_CHECK_EQUAL( short_view,            "abc"                          );
+	BOOST_CHECK_EQUAL( long_view,             "a string longer than a block" );
+	BOOST_CHECK_EQUAL( the_pool.intern( "" ), ""                             );
+	BOOST_CHECK_EQUAL( the_pool.size(),       102                            );
+	BOOST_CHECK_GT   ( the_pool.get_num_blocks(), 2                          );
+}
+
+BOOST_AUTO_TEST_CASE(counts_bytes_only_for_new_strings) {
+	string_intern_pool the_pool{ 16 };
+	BOOST_CHECK_EQUAL( the_pool.get_num_bytes(), 0 );
+
+	the_pool.intern( "abc" );
+	const size_t num_bytes_after_one = the_pool.get_num_bytes();
+	BOOST_CHECK_GE( num_bytes_after_one, 16 );
+
+	the_pool.intern( "abc" );
+	BOOST_CHECK_EQUAL( the_pool.get_num_bytes(), num_bytes_after_one );
+
+	the_pool.intern( "a string longer than a block" );
+	BOOST_CHECK_GE( the_pool.get_num_bytes(), num_bytes_after_one + 28 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,265 @@
+/// \file
+/// \brief The ordered_task_pool class header
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef CATH_TOOLS_SOURCE_CT_COMMON_CATH_COMMON_THREAD_ORDERED_TASK_POOL_HPP
+#define CATH_TOOLS_SOURCE_CT_COMMON_CATH_COMMON_THREAD_ORDERED_TASK_POOL_HPP
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "cath/common/thread/parallel_for_each_index.hpp"
+
+namespace cath::common {
+
+	/// \brief Run tasks on a fixed pool of worker threads and hand their results back, in the order
+	///        in which the tasks were submitted, to the thread that submits them
+	///
+	/// At most max_in_flight tasks may be submitted-but-not-yet-consumed at once: submit() blocks
+	/// (consuming completed results as they become available) until there's room. This applies
+	/// backpressure to the producer and bounds the memory held in queued tasks and pending results
+	/// however far the workers fall behind.
+	///
+	/// Results are only ever passed to a consumer from within submit() or finish(), on the calling thread,
+	/// so the consumer needn't be thread-safe and sees the results strictly in submission order.
+	///
+	/// If a task throws, the exception is rethrown from the submit() or finish() call that reaches
+	/// that task's result (after all the preceding results have been consumed).
+	template <typename RESULT>
+	class ordered_task_pool final {
+	private:
+		/// \brief Type alias for the type of task to run
+		using task_fn = std::function<RESULT()>;
+
+		/// \brief The outcome of one submitted task, which remains unset until the task has completed
+		struct task_outcome final {
+			/// \brief The result of the task, if it has completed without throwing
+			std::optional<RESULT> result;
+
+			/// \brief The exception thrown by the task, if it has completed by throwing
+			std::exception_ptr exception;
+
+			/// \brief Whether the task has completed
+			bool done = false;
+		};
+
+		/// \brief The maximum number of tasks that may be submitted but not yet consumed
+		size_t max_in_flight;
+
+		/// \brief The mutex protecting all the data below
+		std::mutex the_mutex;
+
+		/// \brief The condition_variable on which workers wait for tasks (or a request to stop)
+		std::condition_variable task_available_cv;
+
+		/// \brief The condition_variable on which the submitting thread waits for a task to complete
+		std::condition_variable task_done_cv;
+
+		/// \brief The tasks that have been submitted but not yet started, each with its submission number
+		std::deque<std::pair<size_t, task_fn>> queued_tasks;
+
+		/// \brief The outcomes of the tasks that have been submitted but not yet consumed, in submission order
+		///
+		/// The front entry corresponds to task number num_consumed
+		std::deque<task_outcome> outcomes;
+
+		/// \brief The number of tasks that have been consumed
+		size_t num_consumed = 0;
+
+		/// \brief Whether the workers have been asked to stop
+		bool stopping = false;
+
+		/// \brief The worker threads
+		std::vector<std::thread> workers;
+
+		void run_worker();
+
+		template <typename FN>
+		void consume_done_outcomes(std::unique_lock<std::mutex> &,
+		                           FN &&);
+
+		template <typename FN>
+		void consume_next_outcome(std::unique_lock<std::mutex> &,
+		                          FN &&);
+
+	public:
+		ordered_task_pool(const size_t &,
+		                  const size_t &);
+		~ordered_task_pool() noexcept;
+
+		ordered_task_pool(const ordered_task_pool &) = delete;
+		ordered_task_pool(ordered_task_pool &&) = delete;
+		ordered_task_pool & operator=(const ordered_task_pool &) = delete;
+		ordered_task_pool & operator=(ordered_task_pool &&) = delete;
+
+		[[nodiscard]] size_t get_num_threads() const;
+
+		template <typename FN>
+		void submit(task_fn,
+		            FN &&);
+
+		template <typename FN>
+		void finish(FN &&);
+	};
+
+	/// \brief Repeatedly take the next queued task, run it and record its outcome until asked to stop
+	template <typename RESULT>
+	void ordered_task_pool<RESULT>::run_worker() {
+		std::unique_lock<std::mutex> lock{ the_mutex };
+		while ( true ) {
+			task_available_cv.wait( lock, [&] { return stopping || ! queued_tasks.empty(); } );
+			if ( stopping ) {
+				return;
+			}
+			auto [ task_num, task ] = std::move( queued_tasks.front() );
+			queued_tasks.pop_front();
+			lock.unlock();
+
+			std::optional<RESULT> result;
+			std::exception_ptr    exception;
+			try {
+				result.emplace( task() );
+			}
+			catch (...) {
+				exception = std::current_exception();
+			}
+
+			lock.lock();
+			// The outcome can't have been consumed yet (because it isn't done) so it's still in outcomes
+			task_outcome &the_outcome = outcomes[ task_num - num_consumed ];
+			the_outcome.result    = std::move( result );
+			the_outcome.exception = exception;
+			the_outcome.done      = true;
+			task_done_cv.notify_all();
+		}
+	}
+
+	/// \brief Pass the result of the next task to the specified consumer, waiting for that task to complete if necessary
+	///
+	/// \pre The lock is held and there is at least one outcome yet to be consumed
+	template <typename RESULT>
+	template <typename FN>
+	void ordered_task_pool<RESULT>::consume_next_outcome(std::unique_lock<std::mutex> &prm_lock,    ///< The (locked) lock on the_mutex
+	                                                     FN                           &&prm_consumer ///< The function to which the result should be passed
+	                                                     ) {
+		task_done_cv.wait( prm_lock, [&] { return outcomes.front().done; } );
+		task_outcome the_outcome = std::move( outcomes.front() );
+		outcomes.pop_front();
+		++num_consumed;
+		if ( the_outcome.exception ) {
+			std::rethrow_exception( the_outcome.exception );
+		}
+
+		// Call the consumer without holding the lock so the workers can continue
+		prm_lock.unlock();
+		std::forward<FN>( prm_consumer )( std::move( *the_outcome.result ) );
+		prm_lock.lock();
+	}
+
+	/// \brief Pass the results of all the next tasks that have already completed to the specified consumer
+	///
+	/// \pre The lock is held
+	template <typename RESULT>
+	template <typename FN>
+	void ordered_task_pool<RESULT>::consume_done_outcomes(std::unique_lock<std::mutex> &prm_lock,    ///< The (locked) lock on the_mutex
+	                                                      FN                           &&prm_consumer ///< The function to which the results should be passed
+	                                                      ) {
+		while ( ! outcomes.empty() && outcomes.front().done ) {
+			consume_next_outcome( prm_lock, prm_consumer );
+		}
+	}
+
+	/// \brief Ctor from the number of worker threads and the maximum number of tasks that may be in flight
+	template <typename RESULT>
+	ordered_task_pool<RESULT>::ordered_task_pool(const size_t &prm_num_threads,  ///< The number of worker threads (or 0 for the number of hardware threads)
+	                                             const size_t &prm_max_in_flight ///< The maximum number of tasks that may be submitted but not yet consumed (or 0 for twice the number of threads)
+	                                             ) : max_in_flight{ ( prm_max_in_flight > 0 ) ? prm_max_in_flight
+	                                                                                          : 2 * num_threads_to_use( prm_num_threads ) } {
+		const size_t num_threads = num_threads_to_use( prm_num_threads );
+		workers.reserve( num_threads );
+		for (size_t thread_ctr = 0; thread_ctr < num_threads; ++thread_ctr) {
+			workers.emplace_back( [&] { run_worker(); } );
+		}
+	}
+
+	/// \brief Dtor that abandons any tasks that haven't been started and joins the worker threads
+	///
+	/// Any results that haven't been consumed are discarded.
+	template <typename RESULT>
+	ordered_task_pool<RESULT>::~ordered_task_pool() noexcept {
+		{
+			const std::lock_guard<std::mutex> lock{ the_mutex };
+			stopping = true;
+			queued_tasks.clear();
+		}
+		task_available_cv.notify_all();
+		for (std::thread &worker : workers) {
+			worker.join();
+		}
+	}
+
+	/// \brief Get the number of worker threads
+	template <typename RESULT>
+	size_t ordered_task_pool<RESULT>::get_num_threads() const {
+		return workers.size();
+	}
+
+	/// \brief Submit a new task, first passing any completed results to the specified consumer and
+	///        blocking until there's room for the task if the maximum number of tasks are in flight
+	template <typename RESULT>
+	template <typename FN>
+	void ordered_task_pool<RESULT>::submit(task_fn   prm_task,    ///< The task to run
+	                                       FN      &&prm_consumer ///< The function to which any results of previous tasks should be passed
+	                                       ) {
+		std::unique_lock<std::mutex> lock{ the_mutex };
+		consume_done_outcomes( lock, prm_consumer );
+		while ( outcomes.size() >= max_in_flight ) {
+			consume_next_outcome( lock, prm_consumer );
+		}
+		queued_tasks.emplace_back( num_consumed + outcomes.size(), std::move( prm_task ) );
+		outcomes.emplace_back();
+		lock.unlock();
+		task_available_cv.notify_one();
+	}
+
+	/// \brief Wait for all the submitted tasks to complete and pass their results to the specified consumer
+	///
+	/// The pool can continue to be used afterwards.
+	template <typename RESULT>
+	template <typename FN>
+	void ordered_task_pool<RESULT>::finish(FN &&prm_consumer ///< The function to which the results should be passed
+	                                       ) {
+		std::unique_lock<std::mutex> lock{ the_mutex };
+		while ( ! outcomes.empty() ) {
+			consume_next_outcome( lock, prm_consumer );
+		}
+	}
+
+} // namespace cath::common
+
+#endif // CATH_TOOLS_SOURCE_CT_COMMON_CATH_COMMON_THREAD_ORDERED_TASK_POOL_HPP
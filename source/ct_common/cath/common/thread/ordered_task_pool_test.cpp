@@ -0,0 +1,110 @@
+/// \file
+/// \brief The ordered_task_pool test suite
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "ordered_task_pool.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+
+#include <boost/test/unit_test.hpp>
+
+#include "cath/common/size_t_literal.hpp"
+#include "cath/common/type_aliases.hpp"
+
+using namespace ::cath;
+using namespace ::cath::common;
+
+using ::cath::common::literals::operator""_z;
+
+using ::std::atomic;
+using ::std::runtime_error;
+
+BOOST_AUTO_TEST_SUITE(ordered_task_pool_test_suite)
+
+BOOST_AUTO_TEST_CASE(consumes_results_in_submission_order) {
+	for (const size_t &num_threads : { 1_z, 2_z, 5_z } ) {
+		ordered_task_pool<size_t> the_pool{ num_threads, 3 };
+		BOOST_CHECK_EQUAL( the_pool.get_num_threads(), num_threads );
+
+		size_vec got;
+		const auto consume_fn = [&] (const size_t &x) { got.push_back( x ); };
+		for (size_t index = 0; index < 200; ++index) {
+			// Make the earlier tasks in each run of five the slowest so they tend to finish out of order
+			the_pool.submit(
+				[index] {
+					std::this_thread::sleep_for( std::chrono::microseconds( 50 * ( 5 - index % 5 ) ) );
+					return index;
+				},
+				consume_fn
+			);
+		}
+		the_pool.finish( consume_fn );
+
+		size_vec expected( 200 );
+		std::iota( expected.begin(), expected.end(), 0_z );
+		BOOST_CHECK_EQUAL_COLLECTIONS( got.begin(), got.end(), expected.begin(), expected.end() );
+	}
+}
+
+BOOST_AUTO_TEST_CASE(never_exceeds_max_in_flight) {
+	constexpr size_t MAX_IN_FLIGHT = 4;
+	ordered_task_pool<size_t> the_pool{ 3, MAX_IN_FLIGHT };
+	atomic<size_t> num_started { 0 };
+	size_t         num_consumed{ 0 };
+	size_t         max_seen    { 0 };
+	const auto consume_fn = [&] (const size_t &) { ++num_consumed; };
+	for (size_t index = 0; index < 100; ++index) {
+		the_pool.submit( [&] { return ++num_started; }, consume_fn );
+		max_seen = std::max( max_seen, index + 1 - num_consumed );
+	}
+	the_pool.finish( consume_fn );
+	BOOST_CHECK_EQUAL( num_consumed, 100 );
+	BOOST_CHECK_LE   ( max_seen,     MAX_IN_FLIGHT );
+}
+
+BOOST_AUTO_TEST_CASE(can_be_reused_after_finish) {
+	ordered_task_pool<size_t> the_pool{ 2, 0 };
+	size_t total = 0;
+	const auto consume_fn = [&] (const size_t &x) { total += x; };
+	the_pool.submit( [] { return 1_z; }, consume_fn );
+	the_pool.finish( consume_fn );
+	the_pool.submit( [] { return 2_z; }, consume_fn );
+	the_pool.finish( consume_fn );
+	BOOST_CHECK_EQUAL( total, 3 );
+}
+
+BOOST_AUTO_TEST_CASE(rethrows_exceptions_after_preceding_results) {
+	ordered_task_pool<size_t> the_pool{ 4, 8 };
+	size_vec got;
+	const auto consume_fn = [&] (const size_t &x) { got.push_back( x ); };
+	const auto submit_and_finish = [&] {
+		for (size_t index = 0; index < 10; ++index) {
+			the_pool.submit( [index] { if ( index == 5 ) { throw runtime_error( "Error at 5" ); } return index; }, consume_fn );
+		}
+		the_pool.finish( consume_fn );
+	};
+	BOOST_CHECK_THROW( submit_and_finish(), runtime_error );
+	BOOST_CHECK_EQUAL( got.size(), 5 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,121 @@
+/// \file
+/// \brief The parallel_for_each_index header
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef CATH_TOOLS_SOURCE_CT_COMMON_CATH_COMMON_THREAD_PARALLEL_FOR_EACH_INDEX_HPP
+#define CATH_TOOLS_SOURCE_CT_COMMON_CATH_COMMON_THREAD_PARALLEL_FOR_EACH_INDEX_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace cath::common {
+
+	/// \brief Get the number of threads to use for the specified requested number of threads,
+	///        where 0 means "use the number of hardware threads"
+	///
+	/// This always returns at least 1
+	inline size_t num_threads_to_use(const size_t &prm_num_threads ///< The requested number of threads (or 0 for the number of hardware threads)
+	                                 ) {
+		const size_t num_threads = ( prm_num_threads == 0 ) ? std::thread::hardware_concurrency()
+		                                                    : prm_num_threads;
+		return std::max<size_t>( num_threads, 1 );
+	}
+
+	/// \brief Call the specified function once for each index in [0, prm_num_indices) using up to prm_num_threads threads
+	///
+	/// The function may accept either just the index or the index and the (0-based) index of the thread
+	/// on which it's being called (which is useful for writing into per-thread buffers).
+	///
+	/// Indices are handed out in increasing order to whichever thread is next free, so calls for different
+	/// indices may run concurrently and in any order. If prm_num_threads (after num_threads_to_use()) is 1
+	/// or there's at most one index then everything is run in order on the calling thread.
+	///
+	/// If any call throws, no further indices are started and the first exception is rethrown
+	/// on the calling thread once all the threads have finished.
+	template <typename FN>
+	void parallel_for_each_index(const size_t &prm_num_indices, ///< The number of indices to process
+	                             const size_t &prm_num_threads, ///< The maximum number of threads to use (or 0 for the number of hardware threads)
+	                             FN          &&prm_fn           ///< The function to call with each index (and optionally the thread index)
+	                             ) {
+		constexpr bool FN_TAKES_THREAD_INDEX = std::is_invocable_v<FN &, size_t, size_t>;
+		const auto call_fn = [&] (const size_t &prm_index, const size_t &prm_thread_index) {
+			if constexpr ( FN_TAKES_THREAD_INDEX ) {
+				prm_fn( prm_index, prm_thread_index );
+			} else {
+				prm_fn( prm_index );
+			}
+		};
+
+		const size_t num_threads = std::min( num_threads_to_use( prm_num_threads ), prm_num_indices );
+		if ( num_threads <= 1 ) {
+			for (size_t index = 0; index < prm_num_indices; ++index) {
+				call_fn( index, 0 );
+			}
+			return;
+		}
+
+		std::atomic<size_t> next_index{ 0 };
+		std::atomic<bool>   failed    { false };
+		std::exception_ptr  first_exception;
+		std::mutex          exception_mutex;
+
+		const auto run_worker = [&] (const size_t &prm_thread_index) {
+			while ( ! failed.load( std::memory_order_relaxed ) ) {
+				const size_t index = next_index.fetch_add( 1, std::memory_order_relaxed );
+				if ( index >= prm_num_indices ) {
+					return;
+				}
+				try {
+					call_fn( index, prm_thread_index );
+				}
+				catch (...) {
+					const std::lock_guard<std::mutex> lock{ exception_mutex };
+					if ( ! first_exception ) {
+						first_exception = std::current_exception();
+					}
+					failed.store( true, std::memory_order_relaxed );
+				}
+			}
+		};
+
+		// Run worker 0 on this thread and the rest on new threads
+		std::vector<std::thread> threads;
+		threads.reserve( num_threads - 1 );
+		for (size_t thread_ctr = 1; thread_ctr < num_threads; ++thread_ctr) {
+			threads.emplace_back( run_worker, thread_ctr );
+		}
+		run_worker( 0 );
+		for (std::thread &the_thread : threads) {
+			the_thread.join();
+		}
+
+		if ( first_exception ) {
+			std::rethrow_exception( first_exception );
+		}
+	}
+
+} // namespace cath::common
+
+#endif // CATH_TOOLS_SOURCE_CT_COMMON_CATH_COMMON_THREAD_PARALLEL_FOR_EACH_INDEX_HPP
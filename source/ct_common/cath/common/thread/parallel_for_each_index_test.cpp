@@ -0,0 +1,81 @@
+/// \file
+/// \brief The parallel_for_each_index test suite
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "parallel_for_each_index.hpp"
+
+#include <atomic>
+#include <stdexcept>
+
+#include <boost/test/unit_test.hpp>
+
+#include "cath/common/size_t_literal.hpp"
+#include "cath/common/type_aliases.hpp"
+
+using namespace ::cath;
+using namespace ::cath::common;
+
+using ::cath::common::literals::operator""_z;
+
+using ::std::atomic;
+using ::std::runtime_error;
+
+BOOST_AUTO_TEST_SUITE(parallel_for_each_index_test_suite)
+
+BOOST_AUTO_TEST_CASE(num_threads_to_use_is_always_positive) {
+	BOOST_CHECK_GE   ( num_threads_to_use( 0 ), 1 );
+	BOOST_CHECK_EQUAL( num_threads_to_use( 1 ), 1 );
+	BOOST_CHECK_EQUAL( num_threads_to_use( 7 ), 7 );
+}
+
+BOOST_AUTO_TEST_CASE(calls_each_index_exactly_once) {
+	for (const size_t &num_threads : { 0_z, 1_z, 2_z, 5_z } ) {
+		const size_t   num_indices = 1000;
+		const size_vec expected( num_indices, 1 );
+		size_vec num_calls( num_indices, 0 );
+		parallel_for_each_index( num_indices, num_threads, [&] (const size_t &x) { ++num_calls[ x ]; } );
+		BOOST_CHECK_EQUAL_COLLECTIONS( num_calls.begin(), num_calls.end(), expected.begin(), expected.end() );
+	}
+}
+
+BOOST_AUTO_TEST_CASE(passes_valid_thread_indices) {
+	const size_t num_threads = 4;
+	atomic<size_t> num_bad_thread_indices{ 0 };
+	parallel_for_each_index( 100, num_threads, [&] (const size_t &, const size_t &prm_thread_index) {
+		if ( prm_thread_index >= num_threads ) {
+			++num_bad_thread_indices;
+		}
+	} );
+	BOOST_CHECK_EQUAL( num_bad_thread_indices.load(), 0 );
+}
+
+BOOST_AUTO_TEST_CASE(handles_no_indices) {
+	size_t num_calls = 0;
+	parallel_for_each_index( 0, 4, [&] (const size_t &) { ++num_calls; } );
+	BOOST_CHECK_EQUAL( num_calls, 0 );
+}
+
+BOOST_AUTO_TEST_CASE(rethrows_exceptions) {
+	BOOST_CHECK_THROW(
+		parallel_for_each_index( 100, 4, [] (const size_t &x) { if ( x == 42 ) { throw runtime_error( "Error at 42" ); } } ),
+		runtime_error
+	);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -80,6 +80,7 @@ namespace cath {
 	using char_vec                      = ::std::vector<char>;
 
 	using doub_vec                      = ::std::vector<double>;
+	using float_vec                     = ::std::vector<float>;
 	using doub_vec_vec                  = ::std::vector<doub_vec>;
 
 	/// \brief Type alias for an optional double
@@ -114,6 +115,8 @@ namespace cath {
 
 	using str_str_pair_size_map         = ::std::map<str_str_pair, size_t>;
 
+	using str_str_pair_str_map          = ::std::map<str_str_pair, ::std::string>;
+
 	using size_size_pair                = ::std::pair<size_t, size_t>;
 	using size_size_pair_vec            = ::std::vector<size_size_pair>;
 	using size_size_pair_doub_map       = ::std::map<size_size_pair, double>;
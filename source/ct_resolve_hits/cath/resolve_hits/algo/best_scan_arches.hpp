@@ -43,6 +43,10 @@ namespace cath::rslv {
 	///
 	/// This design means that little work is required for extending an architecture's region of best-ness
 	/// and that lookup is very quick
+	///
+	/// Since each new best is usually an earlier best plus one hit, the scored_arch_proxy entries
+	/// share their earlier hits through back-pointers, so each one only adds a score, a hit index
+	/// and a pointer to its predecessor rather than a full copy of the architecture
 	class best_scan_arches final {
 	private:
 		/// \brief The best architectures seen up to each of the points
@@ -0,0 +1,106 @@
+/// \file
+/// \brief The mask_segment_index class header
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef CATH_TOOLS_SOURCE_CT_RESOLVE_HITS_CATH_RESOLVE_HITS_ALGO_MASK_SEGMENT_INDEX_HPP
+#define CATH_TOOLS_SOURCE_CT_RESOLVE_HITS_CATH_RESOLVE_HITS_ALGO_MASK_SEGMENT_INDEX_HPP
+
+#include <boost/range/algorithm/sort.hpp>
+
+#include "cath/resolve_hits/calc_hit.hpp"
+#include "cath/seq/seq_arrow.hpp"
+#include "cath/seq/seq_type_aliases.hpp"
+
+#include <algorithm>
+
+namespace cath::rslv {
+
+	/// \brief An index of the segments of a mask (a list of mutually non-overlapping hits) that
+	///        answers whether a hit overlaps the mask in O(s log m) time (for a hit with s segments and m mask segments)
+	///
+	/// Since the mask's hits don't overlap each other, their segments are disjoint, so they're stored
+	/// as one flat, sorted array of boundaries: start_0, stop_0, start_1, stop_1, ... A point falls inside
+	/// a mask segment iff an odd number of boundaries are less than or equal to it.
+	class mask_segment_index final {
+	private:
+		/// \brief The starts and stops of the mask's segments, sorted
+		seq::res_arrow_vec boundaries;
+
+	public:
+		explicit mask_segment_index(const calc_hit_vec &);
+
+		[[nodiscard]] bool empty() const;
+		[[nodiscard]] bool overlaps(const seq::seq_arrow &,
+		                            const seq::seq_arrow &) const;
+	};
+
+	/// \brief Ctor from the mask, the hits of which must not overlap each other
+	inline mask_segment_index::mask_segment_index(const calc_hit_vec &prm_mask ///< The mask of non-overlapping hits to index
+	                                              ) {
+		for (const calc_hit &the_hit : prm_mask) {
+			const seq::seq_seg_run &segments = the_hit.get_segments();
+			for (size_t seg_ctr = 0; seg_ctr < segments.get_num_segments(); ++seg_ctr) {
+				boundaries.push_back( segments.get_start_arrow_of_segment( seg_ctr ) );
+				boundaries.push_back( segments.get_stop_arrow_of_segment ( seg_ctr ) );
+			}
+		}
+		// Since the segments are disjoint and non-empty, sorting the boundaries keeps each start next to its stop
+		boost::range::sort( boundaries );
+	}
+
+	/// \brief Whether the mask is empty
+	inline bool mask_segment_index::empty() const {
+		return boundaries.empty();
+	}
+
+	/// \brief Whether the segment with the specified start and stop overlaps any of the mask's segments
+	inline bool mask_segment_index::overlaps(const seq::seq_arrow &prm_start, ///< The start of the segment to query
+	                                         const seq::seq_arrow &prm_stop   ///< The stop of the segment to query
+	                                         ) const {
+		const auto   first_after_start = std::upper_bound( ::std::cbegin( boundaries ), ::std::cend( boundaries ), prm_start );
+		const size_t num_at_or_before  = static_cast<size_t>( first_after_start - ::std::cbegin( boundaries ) );
+
+		// If the start is inside a mask segment, it overlaps; otherwise it overlaps iff the next mask segment starts before the stop
+		return ( num_at_or_before % 2 != 0 )
+		    || ( first_after_start != ::std::cend( boundaries ) && *first_after_start < prm_stop );
+	}
+
+	/// \brief Whether the specified hit overlaps any of the segments in the specified mask_segment_index
+	///
+	/// This gives the same result as hit_overlaps_with_any_of_hits() with the indexed mask
+	///
+	/// \relates mask_segment_index
+	inline bool hit_overlaps_with_mask(const calc_hit           &prm_hit,  ///< The hit to query
+	                                   const mask_segment_index &prm_index ///< The index of the mask
+	                                   ) {
+		if ( prm_index.empty() ) {
+			return false;
+		}
+		const seq::seq_seg_run &segments = prm_hit.get_segments();
+		for (size_t seg_ctr = 0; seg_ctr < segments.get_num_segments(); ++seg_ctr) {
+			if ( prm_index.overlaps( segments.get_start_arrow_of_segment( seg_ctr ), segments.get_stop_arrow_of_segment( seg_ctr ) ) ) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+} // namespace cath::rslv
+
+#endif // CATH_TOOLS_SOURCE_CT_RESOLVE_HITS_CATH_RESOLVE_HITS_ALGO_MASK_SEGMENT_INDEX_HPP
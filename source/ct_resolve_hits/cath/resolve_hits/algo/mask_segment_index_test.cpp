@@ -0,0 +1,57 @@
+/// \file
+/// \brief The mask_segment_index test suite
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <boost/test/unit_test.hpp>
+
+#include "cath/resolve_hits/algo/mask_segment_index.hpp"
+
+using namespace ::cath::rslv;
+using namespace ::cath::seq;
+
+BOOST_AUTO_TEST_SUITE(mask_segment_index_test_suite)
+
+BOOST_AUTO_TEST_CASE(agrees_with_checking_each_hit_of_the_mask) {
+	const calc_hit_vec mask{
+		calc_hit( { seq_seg{ 40, 49 }, seq_seg{ 70, 79 }, }, 1.0, 0 ),
+		calc_hit( { seq_seg{ 10, 19 },                    }, 1.0, 1 ),
+		calc_hit( { seq_seg{ 50, 59 },                    }, 1.0, 2 ),
+	};
+	const mask_segment_index the_index{ mask };
+
+	for (residx_t start = 0; start < 90; ++start) {
+		for (residx_t stop = start; stop < 90; ++stop) {
+			const calc_hit contig_hit( { seq_seg{ start, stop } }, 1.0, 3 );
+			BOOST_CHECK_EQUAL( hit_overlaps_with_mask( contig_hit, the_index ), hit_overlaps_with_any_of_hits( contig_hit, mask ) );
+
+			if ( stop + 3 < 90 ) {
+				const calc_hit discontig_hit( { seq_seg{ start, start }, seq_seg{ stop + 3, stop + 3 } }, 1.0, 4 );
+				BOOST_CHECK_EQUAL( hit_overlaps_with_mask( discontig_hit, the_index ), hit_overlaps_with_any_of_hits( discontig_hit, mask ) );
+			}
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(empty_mask_overlaps_nothing) {
+	const mask_segment_index the_index{ calc_hit_vec{} };
+	BOOST_CHECK( the_index.empty() );
+	BOOST_CHECK( ! hit_overlaps_with_mask( calc_hit( { seq_seg{ 0, 99 } }, 1.0, 0 ), the_index ) );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,171 @@
+/// \file
+/// \brief The masked_bests_cache class definitions
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "masked_bests_cache.hpp"
+
+#include "cath/common/exception/out_of_range_exception.hpp"
+
+using namespace ::cath::common;
+using namespace ::cath::rslv;
+using namespace ::cath::rslv::detail;
+using namespace ::cath::seq;
+
+/// \brief Get the tag stored in a slot for the specified fingerprint (its top 32 bits)
+uint32_t masked_bests_cache::fingerprint_tag(const uint64_t &prm_fingerprint ///< The fingerprint
+                                             ) {
+	return static_cast<uint32_t>( prm_fingerprint >> 32 );
+}
+
+/// \brief Get the index of the slot at which to start probing for the specified fingerprint
+///
+/// This uses Fibonacci hashing to spread the fingerprint's bits over the slot indices
+///
+/// \pre slots is non-empty
+size_t masked_bests_cache::slot_index_of_fingerprint(const uint64_t &prm_fingerprint ///< The fingerprint to locate
+                                                     ) const {
+	return static_cast<size_t>( ( prm_fingerprint * 0x9E3779B97F4A7C15ULL ) >> 32 ) & ( slots.size() - 1 );
+}
+
+/// \brief Whether the specified entry's signature is the signature of regions unmasked by the specified mask up to the specified point
+bool masked_bests_cache::signature_matches(const entry        &prm_entry,     ///< The entry to check
+                                           const calc_hit_vec &prm_mask_hits, ///< The mask that defines the unmasked regions
+                                           const seq_arrow    &prm_stop_arrow ///< The stop boundary at which the signature of unmasked regions should stop
+                                           ) const {
+	size_t arrow_ctr = 0;
+	bool   matches   = true;
+	for_each_unmasked_region_before_arrow(
+		prm_mask_hits,
+		prm_stop_arrow,
+		[&] (const seq_arrow &x, const seq_arrow &y) {
+			if ( matches && arrow_ctr + 2 <= prm_entry.signature_size ) {
+				matches = ( signature_arrows[ prm_entry.signature_offset + arrow_ctr     ] == x )
+				       && ( signature_arrows[ prm_entry.signature_offset + arrow_ctr + 1 ] == y );
+			}
+			arrow_ctr += 2;
+		}
+	);
+	return matches && ( arrow_ctr == prm_entry.signature_size );
+}
+
+/// \brief Find the entry for the signature of regions unmasked by the specified mask up to the specified point
+///        (or nullptr if there isn't one)
+auto masked_bests_cache::find_entry(const uint64_t     &prm_fingerprint, ///< The fingerprint of the signature
+                                    const calc_hit_vec &prm_mask_hits,   ///< The mask that defines the unmasked regions
+                                    const seq_arrow    &prm_stop_arrow   ///< The stop boundary at which the signature of unmasked regions should stop
+                                    ) const -> const entry * {
+	if ( slots.empty() ) {
+		return nullptr;
+	}
+	const uint32_t tag = fingerprint_tag( prm_fingerprint );
+	for (size_t slot_ctr = slot_index_of_fingerprint( prm_fingerprint ); slots[ slot_ctr ].entry_num != 0; slot_ctr = ( slot_ctr + 1 ) & ( slots.size() - 1 ) ) {
+		const slot &the_slot = slots[ slot_ctr ];
+		if ( the_slot.fingerprint_tag == tag ) {
+			const entry &the_entry = entries[ the_slot.entry_num - 1 ];
+			if ( signature_matches( the_entry, prm_mask_hits, prm_stop_arrow ) ) {
+				return &the_entry;
+			}
+		}
+	}
+	return nullptr;
+}
+
+/// \brief Insert a slot for the entry with the specified index and fingerprint
+///
+/// \pre slots has at least one empty slot
+void masked_bests_cache::insert_slot(const uint64_t &prm_fingerprint, ///< The fingerprint of the entry's signature
+                                     const size_t   &prm_entry_index  ///< The index of the entry in entries
+                                     ) {
+	size_t slot_ctr = slot_index_of_fingerprint( prm_fingerprint );
+	while ( slots[ slot_ctr ].entry_num != 0 ) {
+		slot_ctr = ( slot_ctr + 1 ) & ( slots.size() - 1 );
+	}
+	slots[ slot_ctr ] = slot{ fingerprint_tag( prm_fingerprint ), static_cast<uint32_t>( prm_entry_index + 1 ) };
+}
+
+/// \brief Double the number of slots (or create the initial slots) and re-insert the entries
+///
+/// The slots only hold part of each fingerprint, so the full fingerprints are recalculated from the stored signatures
+void masked_bests_cache::grow() {
+	slots.assign( slots.empty() ? MIN_NUM_SLOTS : 2 * slots.size(), slot{} );
+	for (size_t entry_ctr = 0; entry_ctr < entries.size(); ++entry_ctr) {
+		const entry &the_entry  = entries[ entry_ctr ];
+		size_t       fingerprint = 0;
+		for (size_t arrow_ctr = 0; arrow_ctr < the_entry.signature_size; arrow_ctr += 2) {
+			add_unmasked_region_to_fingerprint(
+				fingerprint,
+				signature_arrows[ the_entry.signature_offset + arrow_ctr     ],
+				signature_arrows[ the_entry.signature_offset + arrow_ctr + 1 ]
+			);
+		}
+		insert_slot( fingerprint, entry_ctr );
+	}
+}
+
+/// \brief Get the optimum architecture (scored_arch_proxy) for the signature of regions unmasked
+///        by the specified mask up to the specified point
+///
+/// \pre An architecture has been stored for that signature, else an out_of_range_exception is thrown
+const scored_arch_proxy & masked_bests_cache::get_best_for_masks_up_to_arrow(const calc_hit_vec &prm_mask_hits, ///< The mask that defines the unmasked regions for which the architecture is optimal
+                                                                             const seq_arrow    &prm_stop_arrow ///< The stop boundary at which the signature of unmasked regions should stop
+                                                                             ) const {
+	const entry * const entry_ptr = find_entry(
+		unmasked_regions_fingerprint( prm_mask_hits, prm_stop_arrow ),
+		prm_mask_hits,
+		prm_stop_arrow
+	);
+	if ( entry_ptr == nullptr ) {
+		BOOST_THROW_EXCEPTION(out_of_range_exception("No best architecture has been cached for this signature of unmasked regions"));
+	}
+	return entry_ptr->best;
+}
+
+/// \brief Store the optimum architecture for the signature of regions unmasked by the specified mask up to the specified point
+///
+/// If an architecture has already been stored for that signature, this leaves it in place
+void masked_bests_cache::store_best_for_masks_up_to_arrow(const scored_arch_proxy &prm_best_scored_arch_proxy, ///< The optimum architecture (scored_arch_proxy) to store
+                                                          const calc_hit_vec      &prm_mask_hits,              ///< The mask that defines the unmasked regions for which the architecture is optimal
+                                                          const seq_arrow         &prm_stop_arrow              ///< The stop boundary at which the signature of unmasked regions should stop
+                                                          ) {
+	const uint64_t fingerprint = unmasked_regions_fingerprint( prm_mask_hits, prm_stop_arrow );
+	if ( find_entry( fingerprint, prm_mask_hits, prm_stop_arrow ) != nullptr ) {
+		return;
+	}
+
+	// Keep the load factor at or below a half
+	if ( 2 * ( entries.size() + 1 ) > slots.size() ) {
+		grow();
+	}
+
+	const size_t signature_offset = signature_arrows.size();
+	for_each_unmasked_region_before_arrow(
+		prm_mask_hits,
+		prm_stop_arrow,
+		[&] (const seq_arrow &x, const seq_arrow &y) {
+			signature_arrows.push_back( x );
+			signature_arrows.push_back( y );
+		}
+	);
+	entries.push_back( entry{
+		signature_offset,
+		static_cast<uint32_t>( signature_arrows.size() - signature_offset ),
+		prm_best_scored_arch_proxy
+	} );
+	insert_slot( fingerprint, entries.size() - 1 );
+}
@@ -21,106 +21,189 @@
 #ifndef CATH_TOOLS_SOURCE_CT_RESOLVE_HITS_CATH_RESOLVE_HITS_ALGO_MASKED_BESTS_CACHE_HPP
 #define CATH_TOOLS_SOURCE_CT_RESOLVE_HITS_CATH_RESOLVE_HITS_ALGO_MASKED_BESTS_CACHE_HPP
 
-#include <unordered_map>
-
 #include "cath/common/hash/hash_value_combine.hpp"
-#include "cath/common/type_traits.hpp"
 #include "cath/resolve_hits/algo/scored_arch_proxy.hpp"
 #include "cath/resolve_hits/calc_hit.hpp"
 #include "cath/seq/seq_seg.hpp"
 
+#include <cstdint>
+#include <deque>
+#include <vector>
+
 namespace cath::rslv {
 
 	namespace detail {
 
-		/// \brief Provide function operator that hashes seq_seg_vec so that they can be used as
-		///        keys in an unordered map
-		struct seq_seg_vec_hasher final {
-
-			/// \brief Hash function for seq_seg_vec
-			size_t operator()(const seq::seq_seg_vec &prm_seq_seg_vec ///< The seq_seg_vec to hash
-			                  ) const {
-				size_t seed = 0;
-				for (const seq::seq_seg &the_hit : prm_seq_seg_vec) {
-					for (const auto &index : { the_hit.get_start_arrow().get_index(),
-					                           the_hit.get_stop_arrow ().get_index(), } ) {
-						using index_type = common::remove_cvref_t< decltype( index ) >;
-						common::hash_value_combine( seed, std::hash< index_type >{}( index ) );
-					}
-				}
-				return seed;
-			}
-		};
-
-		/// \brief Build a list of the regions between zero and the specified arrow
-		///        that aren't masked by the specified hits.
+		/// \brief Call the specified function with the start and stop of each of the regions
+		///        between zero and the specified arrow that aren't masked by the specified hits
 		///
-		/// \brief The specified hits must be non-overlapping.
+		/// \pre The specified hits must be non-overlapping.
+		///
+		/// This visits the mask segments in order of their starts without building a sorted copy:
+		/// a mask only has a handful of segments (a couple per level of nesting of discontiguous hits)
+		/// so repeatedly selecting the next segment is cheaper than allocating.
 		///
 		/// Note: this excludes any zero-length regions left by the mask, which means that
 		///       it can give identical results for different hit_vecs
-		inline seq::seq_seg_vec get_unmasked_regions_before_arrow(const calc_hit_vec   &prm_hits, ///< The hits defining the mask. These must be non-overlapping but may be unsorted.
-		                                                          const seq::seq_arrow &prm_arrow ///< The point at which to stop
-		                                                          ) {
-			// Get a sorted copy of prm_hits's segments
-			const auto seq_segs = get_start_sorted_seq_segs( prm_hits );
-
-			// Prepare the working data: a seq_seg_vec to populate and a seq_arrow at the end of the most-recently-handled seq_seg
-			seq::seq_seg_vec results;
-			auto prev_stop = seq::start_arrow();
-
-			// Loop over the mask segments
-			for (const seq::seq_seg &the_seq_seg : seq_segs) {
+		template <typename FN>
+		void for_each_unmasked_region_before_arrow(const calc_hit_vec   &prm_hits, ///< The hits defining the mask. These must be non-overlapping but may be unsorted.
+		                                           const seq::seq_arrow &prm_arrow, ///< The point at which to stop
+		                                           FN                  &&prm_fn     ///< The function to call with the start and stop of each unmasked region
+		                                           ) {
+			// The working data: a seq_arrow at the end of the most-recently-handled mask segment
+			// and a pointer to that segment's start (or nullptr if none has been handled yet)
+			auto                  prev_stop  = seq::start_arrow();
+			const seq::seq_arrow *prev_start = nullptr;
+
+			while ( true ) {
+				// Find the mask segment with the lowest start after the previous one's
+				const seq::seq_arrow *next_start = nullptr;
+				const seq::seq_arrow *next_stop  = nullptr;
+				for (const calc_hit &the_hit : prm_hits) {
+					const seq::seq_seg_run &segments = the_hit.get_segments();
+					for (size_t seg_ctr = 0; seg_ctr < segments.get_num_segments(); ++seg_ctr) {
+						const seq::seq_arrow &seg_start = segments.get_start_arrow_of_segment( seg_ctr );
+						if ( ( prev_start == nullptr || seg_start > *prev_start ) && ( next_start == nullptr || seg_start < *next_start ) ) {
+							next_start = &seg_start;
+							next_stop  = &segments.get_stop_arrow_of_segment( seg_ctr );
+						}
+					}
+				}
 
-				// If this mask segment starts after the stop arrow, then break out of the loop
-				if ( the_seq_seg.get_start_arrow() >= prm_arrow ) {
+				// If there are no more mask segments or the next one starts after the stop arrow, then stop
+				if ( next_start == nullptr || *next_start >= prm_arrow ) {
 					break;
 				}
-				// Else if this mask segment starts *strictly* after the previous stop, add a record for the gap
-				if ( the_seq_seg.get_start_arrow() >  prev_stop ) {
-					results.emplace_back( prev_stop, the_seq_seg.get_start_arrow() );
+				// If this mask segment starts *strictly* after the previous stop, visit the gap
+				if ( *next_start > prev_stop ) {
+					prm_fn( prev_stop, *next_start );
 				}
 				// Update the prev_stop to this segment's stop
-				prev_stop = the_seq_seg.get_stop_arrow();
+				prev_stop  = *next_stop;
+				prev_start = next_start;
 			}
 
-			// If the stop point is *strictly* after the previously handled segment's stop, add a record for the gap
+			// If the stop point is *strictly* after the previously handled segment's stop, visit the gap
 			// (this happens in all cases except those where there is a mask segment stopping-at or straddling prm_arrow)
 			if ( prm_arrow > prev_stop ) {
-				results.emplace_back( prev_stop, prm_arrow );
+				prm_fn( prev_stop, prm_arrow );
 			}
+		}
 
+		/// \brief Build a list of the regions between zero and the specified arrow
+		///        that aren't masked by the specified hits.
+		///
+		/// \pre The specified hits must be non-overlapping.
+		///
+		/// Note: this excludes any zero-length regions left by the mask, which means that
+		///       it can give identical results for different hit_vecs
+		inline seq::seq_seg_vec get_unmasked_regions_before_arrow(const calc_hit_vec   &prm_hits, ///< The hits defining the mask. These must be non-overlapping but may be unsorted.
+		                                                          const seq::seq_arrow &prm_arrow ///< The point at which to stop
+		                                                          ) {
+			seq::seq_seg_vec results;
+			for_each_unmasked_region_before_arrow(
+				prm_hits,
+				prm_arrow,
+				[&] (const seq::seq_arrow &x, const seq::seq_arrow &y) { results.emplace_back( x, y ); }
+			);
 			return results;
 		}
 
+		/// \brief Add the unmasked region with the specified start and stop into the specified fingerprint
+		inline void add_unmasked_region_to_fingerprint(size_t               &prm_seed,  ///< The fingerprint into which the region should be incorporated
+		                                               const seq::seq_arrow &prm_start, ///< The start of the unmasked region
+		                                               const seq::seq_arrow &prm_stop   ///< The stop of the unmasked region
+		                                               ) {
+			common::hash_value_combine( prm_seed, prm_start.get_index() );
+			common::hash_value_combine( prm_seed, prm_stop.get_index()  );
+		}
+
+		/// \brief Calculate a 64-bit fingerprint of the signature of the regions between zero and
+		///        the specified arrow that aren't masked by the specified hits (without allocating)
+		///
+		/// Masks with the same unmasked-region signature get the same fingerprint.
+		inline uint64_t unmasked_regions_fingerprint(const calc_hit_vec   &prm_hits, ///< The hits defining the mask. These must be non-overlapping but may be unsorted.
+		                                             const seq::seq_arrow &prm_arrow ///< The point at which to stop
+		                                             ) {
+			size_t seed = 0;
+			for_each_unmasked_region_before_arrow(
+				prm_hits,
+				prm_arrow,
+				[&] (const seq::seq_arrow &x, const seq::seq_arrow &y) { add_unmasked_region_to_fingerprint( seed, x, y ); }
+			);
+			return seed;
+		}
+
 	} // namespace detail
 
 	/// \brief Store the best scored_arch_proxy for a given unmasked pattern
+	///
+	/// This is used in the resolver's inner loop over discontiguous hits, so it avoids allocating on lookups:
+	/// entries are found in a flat, open-addressing (linear-probing) table by a 64-bit fingerprint of the
+	/// unmasked-region signature and the signature itself is only used to verify a fingerprint match.
+	/// The signatures of stored entries are kept back-to-back in one container of arrows.
 	class masked_bests_cache final {
 	private:
-		/// \brief The unordered map (ie hash-map to store the optimal architecture (scored_arch_proxy) for a given set of unmasked regions (seq_seg_vec))
-		std::unordered_map<seq::seq_seg_vec, scored_arch_proxy, detail::seq_seg_vec_hasher> store;
+		/// \brief A slot in the open-addressing table
+		struct slot final {
+			/// \brief The top 32 bits of the fingerprint of the entry's unmasked-region signature
+			uint32_t fingerprint_tag = 0;
+
+			/// \brief One more than the index of the entry in entries (or 0 if the slot is empty)
+			uint32_t entry_num = 0;
+		};
+
+		/// \brief An entry in the cache: the location of its signature in signature_arrows and its optimal architecture
+		struct entry final {
+			/// \brief The offset of the entry's signature in signature_arrows
+			size_t signature_offset;
+
+			/// \brief The number of arrows in the entry's signature (two per unmasked region)
+			uint32_t signature_size;
+
+			/// \brief The optimal architecture for the entry's unmasked regions
+			scored_arch_proxy best;
+		};
+
+		/// \brief The minimum number of slots in the table
+		static constexpr size_t MIN_NUM_SLOTS = 64;
+
+		/// \brief The open-addressing table of slots (the size of which is always a power of two)
+		std::vector<slot> slots;
+
+		/// \brief The entries, in the order in which they were stored
+		///
+		/// (a deque so that growing doesn't briefly need two copies)
+		std::deque<entry> entries;
+
+		/// \brief The start and stop arrows of the unmasked regions of all the entries, stored back-to-back
+		std::deque<seq::seq_arrow> signature_arrows;
+
+		static uint32_t fingerprint_tag(const uint64_t &);
+		[[nodiscard]] size_t slot_index_of_fingerprint(const uint64_t &) const;
+		[[nodiscard]] bool signature_matches(const entry &,
+		                                     const calc_hit_vec &,
+		                                     const seq::seq_arrow &) const;
+		[[nodiscard]] const entry * find_entry(const uint64_t &,
+		                                       const calc_hit_vec &,
+		                                       const seq::seq_arrow &) const;
+		void insert_slot(const uint64_t &,
+		                 const size_t &);
+		void grow();
 
 	public:
-		const scored_arch_proxy & get_best_for_unmasked(const seq::seq_seg_vec &) const;
-		void store_best_for_unmasked(seq::seq_seg_vec &&,
-		                             const scored_arch_proxy &);
-	};
+		[[nodiscard]] size_t size() const;
 
-	/// \brief Get the optimum architecture (scored_arch_proxy) for the specified signature of unmasked regions
-	inline const scored_arch_proxy & masked_bests_cache::get_best_for_unmasked(const seq::seq_seg_vec &prm_unmasked ///< The set of unmasked regions for which the optimum architecture is required
-	                                                                           ) const {
-		return store.at( prm_unmasked );
-	}
+		[[nodiscard]] const scored_arch_proxy & get_best_for_masks_up_to_arrow(const calc_hit_vec &,
+		                                                                       const seq::seq_arrow &) const;
+		void store_best_for_masks_up_to_arrow(const scored_arch_proxy &,
+		                                      const calc_hit_vec &,
+		                                      const seq::seq_arrow &);
+	};
 
-	/// \brief Store the optimum architecture for a signature of unmasked regions
-	inline void masked_bests_cache::store_best_for_unmasked(seq::seq_seg_vec        &&prm_unmasked,              ///< The set of unmasked regions for which the optimum architecture is to be stored
-	                                                        const scored_arch_proxy  &prm_best_scored_arch_proxy ///< The optimum architecture (scored_arch_proxy) to store
-	                                                        ) {
-		store.emplace(
-			std::move( prm_unmasked ),
-			prm_best_scored_arch_proxy
-		);
+	/// \brief Get the number of entries in the cache
+	inline size_t masked_bests_cache::size() const {
+		return entries.size();
 	}
 
 	/// \brief Get the optimum architecture (scored_arch_proxy) from the specified masked_bests_cache
@@ -131,9 +214,7 @@ namespace cath::rslv {
 	                                                                const calc_hit_vec       &prm_mask_hits,          ///< The mask that defines the unmasked regions for which the architecture is optimal
 	                                                                const seq::seq_arrow     &prm_stop_arrow          ///< The stop boundary at which the signature of unmasked regions should stop
 	                                                                ) {
-		return prm_masked_bests_cache.get_best_for_unmasked(
-			detail::get_unmasked_regions_before_arrow( prm_mask_hits, prm_stop_arrow )
-		);
+		return prm_masked_bests_cache.get_best_for_masks_up_to_arrow( prm_mask_hits, prm_stop_arrow );
 	}
 
 	/// \brief Store the optimum architecture (scored_arch_proxy) in the specified masked_bests_cache
@@ -148,10 +229,7 @@ namespace cath::rslv {
 	                                             const calc_hit_vec      &prm_mask_hits,              ///< The mask that defines the unmasked regions for which the architecture is optimal
 	                                             const seq::seq_arrow    &prm_stop_arrow              ///< The stop boundary at which the signature of unmasked regions should stop
 	                                             ) {
-		prm_masked_bests_cache.store_best_for_unmasked(
-			detail::get_unmasked_regions_before_arrow( prm_mask_hits, prm_stop_arrow ),
-			prm_best_scored_arch_proxy
-		);
+		prm_masked_bests_cache.store_best_for_masks_up_to_arrow( prm_best_scored_arch_proxy, prm_mask_hits, prm_stop_arrow );
 	}
 
 } // namespace cath::rslv
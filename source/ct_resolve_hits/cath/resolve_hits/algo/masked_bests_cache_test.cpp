@@ -21,6 +21,7 @@
 #include <boost/lexical_cast.hpp>
 #include <boost/test/unit_test.hpp>
 
+#include "cath/common/exception/out_of_range_exception.hpp"
 #include "cath/resolve_hits/algo/discont_hits_index_by_start.hpp"
 #include "cath/resolve_hits/algo/masked_bests_cache.hpp"
 #include "cath/resolve_hits/algo/masked_bests_cacher.hpp"
@@ -78,4 +79,52 @@ BOOST_AUTO_TEST_CASE(get_arrows_before_starts_of_doms_right_interspersed_with_al
 	);
 }
 
+BOOST_AUTO_TEST_CASE(masked_bests_cache_finds_architectures_by_unmasked_signature) {
+	scored_arch_proxy best_a;
+	best_a.add_hit( 5.0, 2 );
+	scored_arch_proxy best_b;
+	best_b.add_hit( 7.0, 4 );
+
+	const calc_hit_vec mask_a{ calc_hit{ arrow_before_res( 20 ), arrow_before_res( 30 ), 1.0, 0 } };
+	const calc_hit_vec mask_b{ calc_hit( { seq_seg{ 20, 29 }, seq_seg{ 60, 69 }, }, 1.0, 1 ) };
+	const calc_hit_vec mask_c{ calc_hit{ arrow_before_res( 10 ), arrow_before_res( 30 ), 1.0, 2 } };
+
+	masked_bests_cache the_cache;
+	store_best_for_masks_up_to_arrow( the_cache, best_a, mask_a, arrow_before_res( 40 ) );
+	store_best_for_masks_up_to_arrow( the_cache, best_b, mask_c, arrow_before_res( 40 ) );
+
+	// mask_b has the same unmasked-region signature as mask_a before residue 40
+	BOOST_CHECK_EQUAL( get_best_for_masks_up_to_arrow( the_cache, mask_b, arrow_before_res( 40 ) ).get_score(), 5.0 );
+	BOOST_CHECK_EQUAL( get_best_for_masks_up_to_arrow( the_cache, mask_c, arrow_before_res( 40 ) ).get_score(), 7.0 );
+	BOOST_CHECK_THROW( get_best_for_masks_up_to_arrow( the_cache, mask_a, arrow_before_res( 50 ) ), out_of_range_exception );
+
+	// Storing for an existing signature leaves the original in place
+	store_best_for_masks_up_to_arrow( the_cache, best_b, mask_b, arrow_before_res( 40 ) );
+	BOOST_CHECK_EQUAL( the_cache.size(), 2 );
+	BOOST_CHECK_EQUAL( get_best_for_masks_up_to_arrow( the_cache, mask_a, arrow_before_res( 40 ) ).get_score(), 5.0 );
+}
+
+BOOST_AUTO_TEST_CASE(masked_bests_cache_keeps_entries_as_it_grows) {
+	masked_bests_cache the_cache;
+	for (residx_t ctr = 1; ctr <= 500; ++ctr) {
+		store_best_for_masks_up_to_arrow(
+			the_cache,
+			scored_arch_proxy{}.add_hit( static_cast<resscr_t>( ctr ), 0 ),
+			calc_hit_vec{ calc_hit{ arrow_before_res( ctr ), arrow_before_res( ctr + 1 ), 1.0, 0 } },
+			arrow_before_res( 1000 )
+		);
+	}
+	BOOST_REQUIRE_EQUAL( the_cache.size(), 500 );
+	for (residx_t ctr = 1; ctr <= 500; ++ctr) {
+		BOOST_CHECK_EQUAL(
+			get_best_for_masks_up_to_arrow(
+				the_cache,
+				calc_hit_vec{ calc_hit{ arrow_before_res( ctr ), arrow_before_res( ctr + 1 ), 1.0, 0 } },
+				arrow_before_res( 1000 )
+			).get_score(),
+			static_cast<resscr_t>( ctr )
+		);
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -21,8 +21,12 @@
 #ifndef CATH_TOOLS_SOURCE_CT_RESOLVE_HITS_CATH_RESOLVE_HITS_ALGO_SCORED_ARCH_PROXY_HPP
 #define CATH_TOOLS_SOURCE_CT_RESOLVE_HITS_CATH_RESOLVE_HITS_ALGO_SCORED_ARCH_PROXY_HPP
 
+#include <boost/iterator/iterator_facade.hpp>
+
 #include "cath/resolve_hits/resolve_hits_type_aliases.hpp"
 
+#include <memory>
+
 namespace cath::rslv {
 
 	/// \brief Represent an architecture by the indices of its hits in the calc_hit_list, along with the associated score
@@ -32,19 +36,106 @@ namespace cath::rslv {
 	/// involves copying 4 bytes; adding a full hit involves copying 60 bytes
 	/// plus any memory allocated for the fragments).
 	///
+	/// The hit indices are stored as a persistent, singly-linked list from the most recently
+	/// added hit back to the first: each node holds one hit index and a back-pointer to the
+	/// node for the previous hit. Copies share the nodes and adding a hit to a copy just
+	/// prepends a new node, so the dynamic-programming, which makes many slightly-extended
+	/// copies of earlier architectures, costs one small node per new best rather than a copy
+	/// of the whole architecture.
+	///
+	/// Iterating over a scored_arch_proxy visits the hit indices from the most recently added
+	/// back to the first.
+	///
 	/// A scored_arch_proxy can be easily made back into a scored_hit_arch
 	/// using make_scored_hit_arch().
 	class scored_arch_proxy final {
 	private:
+		struct hit_node;
+
+		/// \brief Type alias for a shared_ptr to a const hit_node
+		using hit_node_cptr = std::shared_ptr<const hit_node>;
+
+		/// \brief A node in the list of hit indices: a hit index and a back-pointer to the node of the previously-added hit
+		struct hit_node final {
+			/// \brief The index of the hit in the calc_hit_list
+			hitidx_t              hit_index;
+
+			/// \brief The node of the previously-added hit (or nullptr if this is the first hit)
+			///
+			/// This is mutable only so that the dtor can unlink the chain of nodes
+			mutable hit_node_cptr prev;
+
+			/// \brief Ctor from the hit index and the node of the previously-added hit
+			hit_node(const hitidx_t &prm_hit_index, ///< The index of the hit in the calc_hit_list
+			         hit_node_cptr   prm_prev       ///< The node of the previously-added hit (or nullptr if this is the first hit)
+			         ) noexcept : hit_index{ prm_hit_index       },
+			                      prev     { std::move( prm_prev ) } {
+			}
+
+			hit_node(const hit_node &) = delete;
+			hit_node(hit_node &&) = delete;
+			hit_node & operator=(const hit_node &) = delete;
+			hit_node & operator=(hit_node &&) = delete;
+
+			/// \brief Dtor that unlinks the chain of previous nodes iteratively
+			///
+			/// Letting each node's prev be destroyed by the default dtor would recurse once per node
+			/// that's only owned by the node before it, which can overflow the stack for long chains.
+			/// Instead, repeatedly take over the prev of any previous node that only this node owns
+			/// (so that it's destroyed with an empty prev) and stop at the first node that's shared.
+			~hit_node() noexcept {
+				while ( prev && prev.use_count() == 1 ) {
+					prev = std::move( prev->prev );
+				}
+			}
+		};
+
 		/// \brief The score associated with the architecture
 		resscr_t the_score = INIT_SCORE;
 
-		/// \brief The architecture, represented by the indices of its hits in the calc_hit_list
-		hitidx_vec hit_indices;
+		/// \brief The number of hits in the architecture
+		size_t num_hits = 0;
+
+		/// \brief The node of the most recently added hit (or nullptr if the architecture is empty)
+		hit_node_cptr last_hit;
 
 	public:
-		/// \brief A const_iterator type alias as part of making this a range over hit indices
-		using const_iterator = hitidx_vec::const_iterator;
+		/// \brief A const_iterator type as part of making this a range over hit indices
+		///
+		/// This walks the back-pointers from the most recently added hit to the first
+		class const_iterator final : public boost::iterator_facade<const_iterator,
+		                                                           const hitidx_t,
+		                                                           boost::forward_traversal_tag> {
+		private:
+			friend class boost::iterator_core_access;
+
+			/// \brief The current node (or nullptr at the end)
+			const hit_node *node_ptr = nullptr;
+
+			/// \brief Get the current hit index, as required by iterator_facade
+			[[nodiscard]] const hitidx_t &dereference() const {
+				return node_ptr->hit_index;
+			}
+
+			/// \brief Whether this refers to the same node as another const_iterator, as required by iterator_facade
+			[[nodiscard]] bool equal(const const_iterator &prm_other ///< The other const_iterator to compare with
+			                         ) const {
+				return ( node_ptr == prm_other.node_ptr );
+			}
+
+			/// \brief Move to the previously-added hit, as required by iterator_facade
+			void increment() {
+				node_ptr = node_ptr->prev.get();
+			}
+
+		public:
+			const_iterator() = default;
+
+			/// \brief Ctor from the node to which this should point (or nullptr for an end iterator)
+			explicit const_iterator(const hit_node *prm_node_ptr ///< The node to which this should point
+			                        ) : node_ptr{ prm_node_ptr } {
+			}
+		};
 
 		scored_arch_proxy() = default;
 
@@ -52,7 +143,6 @@ namespace cath::rslv {
 
 		[[nodiscard]] bool   empty() const;
 		[[nodiscard]] size_t size() const;
-		const hitidx_t & operator[](const size_t &) const;
 
 		[[nodiscard]] const_iterator begin() const;
 		[[nodiscard]] const_iterator end() const;
@@ -68,36 +158,33 @@ namespace cath::rslv {
 
 	/// \brief Get whether this architecture currently contains zero entries
 	inline bool scored_arch_proxy::empty() const {
-		return hit_indices.empty();
+		return ( num_hits == 0 );
 	}
 
 	/// \brief Get the number of entries in this architecture
 	inline size_t scored_arch_proxy::size() const {
-		return hit_indices.size();
-	}
-
-	/// \brief Get the hit index stored at the specified index
-	inline const hitidx_t & scored_arch_proxy::operator[](const size_t &prm_index ///< The index of the hit index to return
-	                                                      ) const {
-		return hit_indices[ prm_index ];
+		return num_hits;
 	}
 
 	/// \brief Standard const begin() method, as part of making this a range over hit indices
 	inline auto scored_arch_proxy::begin() const -> const_iterator {
-		return ::std::cbegin( hit_indices );
+		return const_iterator{ last_hit.get() };
 	}
 
 	/// \brief Standard const end() method, as part of making this a range over hit indices
 	inline auto scored_arch_proxy::end() const -> const_iterator {
-		return ::std::cend( hit_indices );
+		return const_iterator{};
 	}
 
 	/// \brief Add the specified hit index and associated score to this scored_arch_proxy
+	///
+	/// This doesn't modify any other scored_arch_proxy that shares this one's previous hits
 	inline scored_arch_proxy & scored_arch_proxy::add_hit(const resscr_t &prm_score,    ///< The score associated with the hit to add
 	                                                      const hitidx_t &prm_hit_index ///< The index of the hit to add
 	                                                      ) {
 		the_score += prm_score;
-		hit_indices.push_back( prm_hit_index );
+		++num_hits;
+		last_hit = std::make_shared<const hit_node>( prm_hit_index, std::move( last_hit ) );
 		return *this;
 	}
 
@@ -0,0 +1,82 @@
+/// \file
+/// \brief The scored_arch_proxy test suite
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <boost/test/unit_test.hpp>
+
+#include "cath/resolve_hits/algo/scored_arch_proxy.hpp"
+#include "cath/test/boost_addenda/boost_check_equal_ranges.hpp"
+
+#include <memory>
+
+using namespace ::cath::common;
+using namespace ::cath::rslv;
+
+BOOST_AUTO_TEST_SUITE(scored_arch_proxy_test_suite)
+
+BOOST_AUTO_TEST_CASE(adding_hits_to_copies_leaves_the_original_unchanged) {
+	scored_arch_proxy base;
+	base.add_hit( 1.0, 3 ).add_hit( 2.0, 5 );
+
+	const scored_arch_proxy extended_a = add_hit_copy( base, 4.0, 7 );
+	const scored_arch_proxy extended_b = add_hit_copy( base, 8.0, 9 );
+
+	BOOST_CHECK_EQUAL       ( base.size(),            2   );
+	BOOST_CHECK_EQUAL       ( base.get_score(),       3.0 );
+	BOOST_CHECK_EQUAL_RANGES( base,       hitidx_vec{    5, 3 } );
+
+	BOOST_CHECK_EQUAL       ( extended_a.size(),      3   );
+	BOOST_CHECK_EQUAL       ( extended_a.get_score(), 7.0 );
+	BOOST_CHECK_EQUAL_RANGES( extended_a, hitidx_vec{ 7, 5, 3 } );
+
+	BOOST_CHECK_EQUAL       ( extended_b.get_score(), 11.0 );
+	BOOST_CHECK_EQUAL_RANGES( extended_b, hitidx_vec{ 9, 5, 3 } );
+}
+
+BOOST_AUTO_TEST_CASE(default_constructed_is_empty) {
+	const scored_arch_proxy empty_proxy;
+	BOOST_CHECK      ( empty_proxy.empty()                      );
+	BOOST_CHECK_EQUAL( empty_proxy.size(),      0               );
+	BOOST_CHECK_EQUAL( empty_proxy.get_score(), INIT_SCORE      );
+	BOOST_CHECK      ( empty_proxy.begin() == empty_proxy.end() );
+}
+
+BOOST_AUTO_TEST_CASE(destroying_a_very_long_architecture_does_not_recurse_per_hit) {
+	constexpr hitidx_t NUM_HITS = 2'000'000;
+	auto long_proxy_ptr = std::make_unique<scored_arch_proxy>();
+	for (hitidx_t hit_ctr = 0; hit_ctr < NUM_HITS; ++hit_ctr) {
+		long_proxy_ptr->add_hit( 1.0, hit_ctr );
+	}
+	BOOST_CHECK_EQUAL( long_proxy_ptr->size(), NUM_HITS );
+	long_proxy_ptr.reset();
+}
+
+BOOST_AUTO_TEST_CASE(destroying_an_architecture_leaves_copies_that_share_its_hits_intact) {
+	scored_arch_proxy base;
+	base.add_hit( 1.0, 3 ).add_hit( 2.0, 5 );
+	const scored_arch_proxy copy = base;
+	{
+		const scored_arch_proxy extended = add_hit_copy( base, 4.0, 7 );
+		base = scored_arch_proxy{};
+		BOOST_CHECK_EQUAL_RANGES( extended, hitidx_vec{ 7, 5, 3 } );
+	}
+	BOOST_CHECK_EQUAL_RANGES( copy, hitidx_vec{ 5, 3 } );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
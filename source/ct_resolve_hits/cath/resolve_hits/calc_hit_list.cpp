@@ -23,6 +23,7 @@
 #include <chrono>
 #include <filesystem>
 #include <fstream>
+#include <map>
 #include <string>
 
 #include <boost/algorithm/string/classification.hpp>
@@ -32,9 +33,9 @@
 #include <boost/range/adaptor/filtered.hpp>
 #include <boost/range/adaptor/transformed.hpp>
 #include <boost/range/algorithm/equal.hpp>
+#include <boost/range/algorithm/find.hpp>
 #include <boost/range/algorithm/lower_bound.hpp>
 #include <boost/range/algorithm/max_element.hpp>
-#include <boost/range/algorithm/reverse.hpp>
 #include <boost/range/algorithm/sort.hpp>
 #include <boost/range/algorithm/upper_bound.hpp>
 #include <boost/range/sub_range.hpp>
@@ -70,9 +71,9 @@ using ::boost::empty;
 using ::boost::integer_range;
 using ::boost::irange;
 using ::boost::numeric_cast;
+using ::boost::range::find;
 using ::boost::range::lower_bound;
 using ::boost::range::max_element;
-using ::boost::range::reverse;
 using ::boost::range::sort;
 using ::boost::range::upper_bound;
 using ::boost::spirit::qi::double_;
@@ -86,9 +87,12 @@ using ::std::find_if;
 using ::std::ifstream;
 using ::std::istream;
 using ::std::make_optional;
+using ::std::multimap;
+using ::std::next;
 using ::std::nullopt;
 using ::std::ostream;
 using ::std::pair;
+using ::std::prev;
 using ::std::rbegin;
 using ::std::rend;
 using ::std::string;
@@ -361,7 +365,7 @@ void cath::rslv::read_hit_list_from_istream(read_and_process_mgr &prm_read_and_p
 		prm_read_and_process_mgr.add_hit(
 			query_id_str_ref,
 			segments_from_bounds( bounds ),
-			string{ begin_of_match_id_itr, end_of_match_id_itr },
+			make_string_view( begin_of_match_id_itr, end_of_match_id_itr ),
 			score,
 			prm_score_type
 		);
@@ -476,58 +480,96 @@ integer_range<hitidx_t> cath::rslv::indices_of_hits_that_stop_in_range(const cal
 /// \brief Generate a list of iterators to the calc_hits in the specified list that are redundant
 ///        (because there's at least one other hit in the list that's strictly better than it)
 ///
+/// One hit can only be better than another if it covers it or is covered by it. This visits the
+/// hits in descending order of stop, keeping the active (ie not-yet-removed) hits seen so far
+/// indexed by their starts. That means the only active hits that can be compared with the current hit are:
+///  * those starting at or before its start (which all cover it) and
+///  * those with the same stop but a later start (which it covers)
+/// ...so it doesn't need to scan the many active hits that just overlap the current hit.
+///
+/// \pre prm_calc_hits is sorted under calc_hit_list::get_less_than_fn
+///
 /// \relates calc_hit_list
 calc_hit_vec_citr_vec cath::rslv::identify_redundant_hits(const calc_hit_vec  &prm_calc_hits, ///< The calc_hit_list to query
                                                           const full_hit_list &prm_full_hits  ///< The corresponding full_hit_list that is used for names that can be used to pick a "better" of two otherwise identical hits
                                                           ) {
-	const auto rend_itr = rend( prm_calc_hits );
-	using chl_citr      = calc_hit_list::const_iterator;
-	using chl_citr_vec  = vector<chl_citr>;
+	using chl_citr          = calc_hit_vec::const_iterator;
+	using active_map        = multimap<seq_arrow, chl_citr>;
+	using active_map_itr    = active_map::iterator;
 
-	chl_citr_vec active_hit_itrs;
-	chl_citr_vec to_be_removed_itrs;
-	to_be_removed_itrs.reserve( prm_calc_hits.size() );
+	// The active hits, indexed by their starts.
+	// All of these stop at or after the current hit's stop.
+	active_map active_hits_by_start;
 
-	for (auto the_ritr = rbegin( prm_calc_hits ); the_ritr != rend_itr; ++the_ritr) {
-		const auto &this_hit = *the_ritr;
+	// The active hits that stop at the same point as the current hit
+	vector<active_map_itr> active_hits_with_same_stop;
 
-		const auto active_hitrs_end = cend( active_hit_itrs );
-		auto active_hit_write_itr   = std::begin  ( active_hit_itrs );
+	calc_hit_vec_citr_vec to_be_removed_itrs;
+	to_be_removed_itrs.reserve( prm_calc_hits.size() );
 
-		for (const auto &active_hit_itr : active_hit_itrs ) {
-			const auto &active_hit = *active_hit_itr;
+	for (auto the_ritr = rbegin( prm_calc_hits ); the_ritr != rend( prm_calc_hits ); ++the_ritr) {
+		const calc_hit  &this_hit   = *the_ritr;
+		const chl_citr   this_itr   = next( the_ritr ).base();
+		const seq_arrow &this_start = get_start_arrow( this_hit );
+		const seq_arrow &this_stop  = get_stop_arrow ( this_hit );
 
-			if ( get_start_arrow( active_hit ) < get_stop_arrow( this_hit ) ) {
-				const auto result = first_hit_is_better( this_hit, active_hit, prm_full_hits );
-				if ( is_true ( result ) ) {
-					to_be_removed_itrs.push_back( active_hit_itr );
-				}
-				else {
-					if ( &*active_hit_write_itr != &active_hit_itr ) {
-						*active_hit_write_itr = active_hit_itr;
-					}
-					++active_hit_write_itr;
+		if ( ! active_hits_with_same_stop.empty() && get_stop_arrow( *active_hits_with_same_stop.front()->second ) != this_stop ) {
+			active_hits_with_same_stop.clear();
+		}
 
-					if ( is_false ( result ) ) {
-						to_be_removed_itrs.push_back( next( the_ritr ).base() );
-						break;
-					}
+		// Drop any active hits that start at or after this stop: they can't overlap this or any later hits
+		while ( ! active_hits_by_start.empty() && prev( active_hits_by_start.end() )->first >= this_stop ) {
+			active_hits_by_start.erase( prev( active_hits_by_start.end() ) );
+		}
+
+		// Compare this hit with the specified active hit and remove whichever is worse (if either).
+		// Return whether this hit was removed.
+		const auto this_is_removed_on_comparing_with = [&] (const active_map_itr &prm_active_itr) {
+			const auto result = first_hit_is_better( this_hit, *prm_active_itr->second, prm_full_hits );
+			if ( is_true( result ) ) {
+				to_be_removed_itrs.push_back( prm_active_itr->second );
+				if ( get_stop_arrow( *prm_active_itr->second ) == this_stop ) {
+					active_hits_with_same_stop.erase( find( active_hits_with_same_stop, prm_active_itr ) );
 				}
+				active_hits_by_start.erase( prm_active_itr );
+				return false;
 			}
+			if ( is_false( result ) ) {
+				to_be_removed_itrs.push_back( this_itr );
+				return true;
+			}
+			return false;
+		};
+
+		bool this_is_removed = false;
+
+		// Compare with the active hits that start at or before this hit
+		const auto covering_end_itr = active_hits_by_start.upper_bound( this_start );
+		for (auto active_itr = active_hits_by_start.begin(); active_itr != covering_end_itr && ! this_is_removed; ) {
+			const auto next_active_itr = next( active_itr );
+			this_is_removed = this_is_removed_on_comparing_with( active_itr );
+			active_itr = next_active_itr;
 		}
 
-		// If any actives have been removed then erase the spares at the end
-		if ( active_hit_write_itr != active_hitrs_end ) {
-			active_hit_itrs.erase( active_hit_write_itr, active_hitrs_end );
+		// Compare with the active hits that have the same stop but start after this hit
+		for (size_t same_stop_ctr = 0; same_stop_ctr < active_hits_with_same_stop.size() && ! this_is_removed; ) {
+			const active_map_itr active_itr = active_hits_with_same_stop[ same_stop_ctr ];
+			if ( active_itr->first > this_start ) {
+				const size_t prev_size = active_hits_with_same_stop.size();
+				this_is_removed = this_is_removed_on_comparing_with( active_itr );
+				if ( active_hits_with_same_stop.size() != prev_size ) {
+					continue;
+				}
+			}
+			++same_stop_ctr;
 		}
 
-		// If this element hasn't been marked for removal, then put it into the actives for future comparisons
-		if ( to_be_removed_itrs.empty() || to_be_removed_itrs.back() != next( the_ritr ).base() ) {
-			active_hit_itrs.push_back( next( the_ritr ).base() );
+		// If this hit hasn't been marked for removal, then make it active for future comparisons
+		if ( ! this_is_removed ) {
+			active_hits_with_same_stop.push_back( active_hits_by_start.emplace( this_start, this_itr ) );
 		}
 	}
 
-	reverse( to_be_removed_itrs );
 	sort( to_be_removed_itrs );
 
 	return to_be_removed_itrs;
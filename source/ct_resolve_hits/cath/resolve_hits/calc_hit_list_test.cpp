@@ -18,21 +18,40 @@
 /// You should have received a copy of the GNU General Public License
 /// along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
+#include <boost/algorithm/cxx11/any_of.hpp>
 #include <boost/lexical_cast.hpp>
+#include <boost/range/algorithm/sort.hpp>
 #include <boost/test/unit_test.hpp>
 
 #include "cath/common/boost_addenda/range/front.hpp"
+#include "cath/common/chrono/duration_to_seconds_string.hpp"
+#include "cath/common/size_t_literal.hpp"
 #include "cath/resolve_hits/calc_hit_list.hpp"
+#include "cath/resolve_hits/first_hit_is_better.hpp"
+#include "cath/resolve_hits/options/spec/crh_filter_spec.hpp"
+#include "cath/resolve_hits/options/spec/crh_score_spec.hpp"
 #include "cath/resolve_hits/options/spec/crh_segment_spec.hpp"
+#include "cath/resolve_hits/resolve/hit_resolver.hpp"
+#include "cath/resolve_hits/scored_hit_arch.hpp"
+#include "cath/test/boost_addenda/boost_check_equal_ranges.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <random>
 
 using namespace ::cath;
 using namespace ::cath::common;
 using namespace ::cath::rslv;
 using namespace ::cath::seq;
 
+using ::boost::algorithm::any_of;
 using ::boost::lexical_cast;
+using ::std::cbegin;
 using ::std::cend;
+using ::std::chrono::high_resolution_clock;
+using ::std::mt19937;
 using ::std::string;
+using ::std::uniform_int_distribution;
 
 BOOST_TEST_DONT_PRINT_LOG_VALUE( calc_hit_list::const_iterator )
 
@@ -62,6 +81,65 @@ namespace {
 			const calc_hit_list eg_hit_list = make_eg_hit_list();
 		};
 
+		/// \brief Make a random full_hit_list of the specified number of hits over the specified number of residues
+		///
+		/// About one in ten of the hits is discontiguous and longer hits tend to have better scores
+		full_hit_list make_random_full_hit_list(mt19937        &prm_rng,          ///< The random number generator to use
+		                                        const size_t   &prm_num_hits,     ///< The number of hits to make
+		                                        const residx_t &prm_num_residues, ///< The number of residues over which to spread the hits
+		                                        const residx_t &prm_min_length,   ///< The minimum length of each hit
+		                                        const residx_t &prm_max_length    ///< The maximum length of each hit
+		                                        ) {
+			uniform_int_distribution<residx_t> length_dist { prm_min_length, prm_max_length   };
+			uniform_int_distribution<residx_t> start_dist  { 1,              prm_num_residues };
+			uniform_int_distribution<int>      score_dist  { 0,              10               };
+			uniform_int_distribution<int>      discont_dist{ 0,              9                };
+			full_hit_vec full_hits;
+			full_hits.reserve( prm_num_hits );
+			for (size_t hit_ctr = 0; hit_ctr < prm_num_hits; ++hit_ctr) {
+				const residx_t length = length_dist( prm_rng );
+				const residx_t start  = start_dist ( prm_rng );
+				const double   score  = static_cast<double>( length ) + static_cast<double>( score_dist( prm_rng ) );
+				const string   label  = "hit_" + ::std::to_string( hit_ctr );
+				if ( discont_dist( prm_rng ) == 0 ) {
+					full_hits.emplace_back( seq_seg_vec{ { start, start + length / 2 }, { start + length, start + length + length / 2 } }, label, score );
+				}
+				else {
+					full_hits.emplace_back( seq_seg_vec{ { start, start + length } }, label, score );
+				}
+			}
+			return full_hit_list{ full_hits };
+		}
+
+		/// \brief Find the best total score of any set of mutually non-overlapping hits by brute force
+		///
+		/// This is exponential in the number of hits so it's only suitable for very small lists
+		resscr_t brute_force_best_score(const calc_hit_vec &prm_hits ///< The (unpruned) hits from which to choose
+		                                ) {
+			const size_t num_hits = prm_hits.size();
+			resscr_t best_score = 0.0;
+			for (size_t subset = 0; subset < ( 1_z << num_hits ); ++subset) {
+				bool     any_overlap = false;
+				resscr_t score       = 0.0;
+				for (size_t hit_ctr = 0; hit_ctr < num_hits && ! any_overlap; ++hit_ctr) {
+					if ( ( subset & ( 1_z << hit_ctr ) ) == 0 ) {
+						continue;
+					}
+					score += prm_hits[ hit_ctr ].get_score();
+					for (size_t other_ctr = 0; other_ctr < hit_ctr; ++other_ctr) {
+						if ( ( subset & ( 1_z << other_ctr ) ) != 0 && are_overlapping( prm_hits[ hit_ctr ], prm_hits[ other_ctr ] ) ) {
+							any_overlap = true;
+							break;
+						}
+					}
+				}
+				if ( ! any_overlap ) {
+					best_score = ::std::max( best_score, score );
+				}
+			}
+			return best_score;
+		}
+
 } // namespace
 
 BOOST_FIXTURE_TEST_SUITE(hit_list_test_suite, hit_list_test_suite_fixture)
@@ -107,4 +185,117 @@ BOOST_AUTO_TEST_CASE(find_first_hit_stopping_at_or_after_works) {
 	BOOST_CHECK_EQUAL( find_first_hit_stopping_after      ( eg_hit_list, arrow_after_res( 1439 ) ), cend( eg_hit_list ) );
 }
 
+BOOST_AUTO_TEST_CASE(identify_redundant_hits_finds_exactly_the_hits_that_have_a_better_hit) {
+	// Build a dense pile of overlapping hits, including repeats, nested hits and discontiguous hits
+	full_hit_vec full_hits;
+	for (residx_t ctr = 0; ctr < 400; ++ctr) {
+		const residx_t start = ( ctr * 37 ) % 200 + 1;
+		const residx_t len   = 5 + ( ctr * 11 ) % 40;
+		const double   score = static_cast<double>( 1 + ( ctr * 7 ) % 13 );
+		const string   label = "label_" + ::std::to_string( ctr % 17 );
+		if ( ctr % 5 == 0 ) {
+			full_hits.emplace_back( seq_seg_vec{ { start, start + len / 2 }, { start + len + 3, start + len + 3 + len / 2 } }, label, score );
+		}
+		else {
+			full_hits.emplace_back( seq_seg_vec{ { start, start + len } }, label, score );
+		}
+	}
+	const full_hit_list full_hit_list_to_test{ full_hits };
+	calc_hit_vec calc_hits = make_hit_list_from_full_hit_list(
+		full_hit_list_to_test,
+		make_neutral_score_spec(),
+		make_no_action_crh_segment_spec(),
+		make_accept_all_filter_spec()
+	);
+	boost::range::sort( calc_hits, calc_hit_list::get_less_than_fn( full_hit_list_to_test ) );
+
+	const calc_hit_vec_citr_vec got = identify_redundant_hits( calc_hits, full_hit_list_to_test );
+
+	// A hit should be removed iff there's another hit that's better than it
+	calc_hit_vec_citr_vec expected;
+	for (auto hit_itr = cbegin( calc_hits ); hit_itr != cend( calc_hits ); ++hit_itr) {
+		if ( any_of( calc_hits, [&] (const calc_hit &x) { return static_cast<bool>( first_hit_is_better( x, *hit_itr, full_hit_list_to_test ) ); } ) ) {
+			expected.push_back( hit_itr );
+		}
+	}
+	BOOST_CHECK_GT( expected.size(), 0 );
+	BOOST_CHECK( got == expected );
+}
+
+BOOST_AUTO_TEST_CASE(identify_redundant_hits_keeps_comparing_hits_after_one_loses_a_tie) {
+	// Visiting in descending order of stop, "a" loses a tie (equal score) to the shorter "b", which is
+	// within it. That mustn't stop "c" from later being compared with "d", to which it also loses a tie.
+	// "d" and "e" are identical so the tie is broken by the labels.
+	const full_hit_list full_hit_list_to_test{ full_hit_vec{
+		full_hit{ seq_seg_vec{ {  1, 40 } }, "a", 1.0 },
+		full_hit{ seq_seg_vec{ { 11, 40 } }, "b", 1.0 },
+		full_hit{ seq_seg_vec{ {  1, 40 } }, "c", 2.0 },
+		full_hit{ seq_seg_vec{ {  1, 10 } }, "d", 2.0 },
+		full_hit{ seq_seg_vec{ {  1, 10 } }, "e", 2.0 },
+	} };
+	calc_hit_vec calc_hits = make_hit_list_from_full_hit_list(
+		full_hit_list_to_test,
+		make_neutral_score_spec(),
+		make_no_action_crh_segment_spec(),
+		make_accept_all_filter_spec()
+	);
+	boost::range::sort( calc_hits, calc_hit_list::get_less_than_fn( full_hit_list_to_test ) );
+
+	str_vec removed_labels;
+	for (const auto &removed_itr : identify_redundant_hits( calc_hits, full_hit_list_to_test ) ) {
+		removed_labels.emplace_back( full_hit_list_to_test[ removed_itr->get_label_idx() ].get_label() );
+	}
+	boost::range::sort( removed_labels );
+	BOOST_CHECK_EQUAL_RANGES( removed_labels, str_vec{ "a", "c", "e" } );
+}
+
+BOOST_AUTO_TEST_CASE(pruning_redundant_hits_does_not_change_the_resolved_architecture) {
+	// The calc_hit_list ctor prunes redundant hits before resolving, so check the resolved
+	// score against the best found by brute force over all of the unpruned hits
+	mt19937 rng{ 47 };
+	for (size_t list_ctr = 0; list_ctr < 200; ++list_ctr) {
+		const full_hit_list full_hits = make_random_full_hit_list( rng, 1 + ( list_ctr % 12 ), 80, 3, 25 );
+		const calc_hit_vec unpruned_hits = make_hit_list_from_full_hit_list(
+			full_hits,
+			make_neutral_score_spec(),
+			make_no_action_crh_segment_spec(),
+			make_accept_all_filter_spec()
+		);
+		const calc_hit_list pruned_hits{ full_hits, make_neutral_score_spec(), make_no_action_crh_segment_spec() };
+		const scored_hit_arch resolved = resolve_hits( pruned_hits, false );
+		BOOST_CHECK_CLOSE( resolved.get_score(), brute_force_best_score( unpruned_hits ), 1e-5 );
+	}
+}
+
+/// \brief Time identifying the redundant hits and resolving the remaining hits on large, dense queries
+///
+/// This is disabled by default; run it with `--run_test=hit_list_test_suite/benchmark_pruning_and_resolving_large_queries`
+BOOST_AUTO_TEST_CASE(benchmark_pruning_and_resolving_large_queries, * boost::unit_test::disabled()) {
+	mt19937 rng{ 47 };
+	for (const size_t &num_hits : { 10'000_z, 20'000_z, 50'000_z } ) {
+		const full_hit_list full_hits = make_random_full_hit_list( rng, num_hits, 35'000, 60, 180 );
+		calc_hit_vec calc_hits = make_hit_list_from_full_hit_list(
+			full_hits,
+			make_neutral_score_spec(),
+			make_no_action_crh_segment_spec(),
+			make_accept_all_filter_spec()
+		);
+		boost::range::sort( calc_hits, calc_hit_list::get_less_than_fn( full_hits ) );
+
+		const auto prune_start_time = high_resolution_clock::now();
+		const calc_hit_vec_citr_vec redundant_hits = identify_redundant_hits( calc_hits, full_hits );
+		const auto prune_durn = high_resolution_clock::now() - prune_start_time;
+
+		const calc_hit_list pruned_hits{ full_hits, make_neutral_score_spec(), make_no_action_crh_segment_spec() };
+		const auto resolve_start_time = high_resolution_clock::now();
+		const scored_hit_arch resolved = resolve_hits( pruned_hits, false );
+		BOOST_TEST_MESSAGE(
+			num_hits << " hits"
+			<< " : " << redundant_hits.size() << " redundant, identified in " << durn_to_seconds_string( prune_durn )
+			<< "; resolved in " << durn_to_seconds_string( high_resolution_clock::now() - resolve_start_time )
+		);
+		BOOST_CHECK_GT( resolved.get_score(), 0.0 );
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -26,6 +26,7 @@
 #include "cath/common/file/open_fstream.hpp"
 #include "cath/common/logger.hpp"
 #include "cath/resolve_hits/calc_hit_list.hpp"
+#include "cath/resolve_hits/file/parse_binary_hits.hpp"
 #include "cath/resolve_hits/file/parse_domain_hits_table.hpp"
 #include "cath/resolve_hits/file/parse_hmmer_out.hpp"
 #include "cath/resolve_hits/html_output/resolve_hits_html_outputter.hpp"
@@ -132,7 +133,8 @@ void cath::rslv::perform_resolve_hits(const crh_spec &prm_crh_spec, ///< The crh
 				parse_domain_hits_table(
 					the_read_and_process_mgr,
 					the_istream_ref,
-					score_spec.get_apply_cath_rules()
+					score_spec.get_apply_cath_rules(),
+					get_num_parse_threads( in_spec )
 				);
 				break;
 			}
@@ -174,6 +176,22 @@ void cath::rslv::perform_resolve_hits(const crh_spec &prm_crh_spec, ///< The crh
 				);
 				break;
 			}
+			case ( hits_input_format_tag::BINARY ) : {
+				// Memory-map the input file if there is one, rather than reading it through the stream
+				if ( input_file_opt && ! read_from_stdin ) {
+					parse_binary_hits_file(
+						the_read_and_process_mgr,
+						*input_file_opt
+					);
+				}
+				else {
+					parse_binary_hits(
+						the_read_and_process_mgr,
+						the_istream_ref
+					);
+				}
+				break;
+			}
 			default : {
 				BOOST_THROW_EXCEPTION(out_of_range_exception("Value of hits_input_format_tag not recognised"));
 			}
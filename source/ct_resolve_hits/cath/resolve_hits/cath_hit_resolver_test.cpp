@@ -138,6 +138,18 @@ BOOST_AUTO_TEST_CASE(processes_from_file_to_stdout) {
 	BOOST_CHECK_EQUAL( blank_vrsn( output_ss ), EXAMPLE_OUTPUT );
 }
 
+BOOST_AUTO_TEST_CASE(processes_from_stdin_to_stdout_with_threads) {
+	// Given an input stream containing the input
+	input_ss.str( string( EXAMPLE_INPUT_RAW ) );
+
+	// When calling perform_resolve_hits with options: - (a dash to read from the input stream) and several threads
+	execute_perform_resolve_hits( { "-", ::fmt::format( "--{}", crh_input_options_block::PO_THREADS ), "4" } );
+
+	// Then expect the same results in the output stream as with one thread
+	BOOST_CHECK_EQUAL( blank_vrsn( output_ss ), EXAMPLE_OUTPUT );
+}
+
+
 BOOST_AUTO_TEST_CASE(processes_from_stdin_to_output_file) {
 	// Given an input stream containing the input
 	input_ss.str( string( EXAMPLE_INPUT_RAW ) );
@@ -212,6 +224,14 @@ BOOST_AUTO_TEST_CASE(file_domtbl) {
 	BOOST_CHECK_STRING_MATCHES_FILE( blank_vrsn( output_ss ), CRH_EG_DOMTBL_OUT_FILENAME() );
 }
 
+BOOST_AUTO_TEST_CASE(file_domtbl_with_threads) {
+	execute_perform_resolve_hits( {
+		CRH_EG_DOMTBL_IN_FILENAME().string(), ::fmt::format( "--{}", crh_input_options_block::PO_INPUT_FORMAT ), to_string( hits_input_format_tag::HMMER_DOMTBLOUT ),
+		::fmt::format( "--{}", crh_input_options_block::PO_THREADS ), "3"
+	} );
+	BOOST_CHECK_STRING_MATCHES_FILE( blank_vrsn( output_ss ), CRH_EG_DOMTBL_OUT_FILENAME() );
+}
+
 BOOST_AUTO_TEST_CASE(file_hmmsearch) {
 	execute_perform_resolve_hits( {
 		CRH_EG_HMMSEARCH_IN_FILENAME().string(), ::fmt::format( "--{}", crh_input_options_block::PO_INPUT_FORMAT ), to_string( hits_input_format_tag::HMMSEARCH_OUT ),
@@ -524,6 +544,24 @@ BOOST_AUTO_TEST_CASE(json_from_domtblout__deprecated_opts) {
 
 BOOST_AUTO_TEST_SUITE_END()
 
+BOOST_AUTO_TEST_SUITE(binary_format)
+
+BOOST_AUTO_TEST_CASE(converts_hmmsearch_to_binary_and_resolves_it) {
+	execute_perform_resolve_hits( {
+		CRH_EG_HMMSEARCH_IN_FILENAME().string(), ::fmt::format( "--{}", crh_input_options_block::PO_INPUT_FORMAT ), to_string( hits_input_format_tag::HMMSEARCH_OUT ),
+		::fmt::format( "--{}", crh_output_options_block::PO_QUIET ),
+		::fmt::format( "--{}", crh_output_options_block::PO_BINARY_HITS_TO_FILE ), TEMP_TEST_FILE_FILENAME.string(),
+	} );
+	BOOST_REQUIRE_EQUAL( output_ss.str(), "" );
+
+	execute_perform_resolve_hits( {
+		TEMP_TEST_FILE_FILENAME.string(), ::fmt::format( "--{}", crh_input_options_block::PO_INPUT_FORMAT ), to_string( hits_input_format_tag::BINARY ),
+	} );
+	BOOST_CHECK_STRING_MATCHES_FILE( blank_vrsn( output_ss ), CRH_EG_HMMSEARCH_OUT_FILENAME() );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
 BOOST_AUTO_TEST_SUITE(hmm_coverage)
 
 BOOST_AUTO_TEST_CASE(hmm_coverage__neither) {
@@ -0,0 +1,158 @@
+/// \file
+/// \brief The binary_hits_format header
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef CATH_TOOLS_SOURCE_CT_RESOLVE_HITS_CATH_RESOLVE_HITS_FILE_BINARY_HITS_FORMAT_HPP
+#define CATH_TOOLS_SOURCE_CT_RESOLVE_HITS_CATH_RESOLVE_HITS_FILE_BINARY_HITS_FORMAT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include <boost/endian/conversion.hpp>
+
+/// The binary hits format
+/// ======================
+///
+/// A compact stream of hit records that cath-resolve-hits can read without any text parsing
+/// (see parse_binary_hits()) and that it can write from any of its other input formats
+/// (see write_binary_hits_processor). All values are little-endian and are packed without padding.
+///
+/// Header (16 bytes):
+///
+/// | Bytes | Type     | Value                                            |
+/// |-------|----------|--------------------------------------------------|
+/// | 0-7   | char[8]  | BINARY_HITS_HEADER_MAGIC ("CRHHITS" then a NUL)  |
+/// | 8-11  | uint32   | BINARY_HITS_VERSION (currently 1)                |
+/// | 12-15 | uint32   | Reserved (0)                                     |
+///
+/// Then one record per hit:
+///
+/// | Type                | Value                                                                      |
+/// |---------------------|----------------------------------------------------------------------------|
+/// | uint32              | The index of the hit's query ID in the query ID table                      |
+/// | uint32              | The index of the hit's match ID in the match ID table                      |
+/// | uint8               | The score type (0: evalue, 1: bitscore, 2: crh-score; see hit_score_type)  |
+/// | uint8               | The number of extras                                                       |
+/// | uint16              | The number of segments (at least 1)                                        |
+/// | float64             | The score                                                                  |
+/// | uint32, uint32      | For each segment: the start and stop residues (in order, as in raw format) |
+/// | (see below)         | For each extra: the extra                                                  |
+///
+/// Each extra is a uint8 category (see hit_extra_cat), followed by:
+///  * for 0 (aligned regions): a uint32 length and then that many chars
+///  * for 1 (conditional evalue) or 2 (independent evalue): a float64
+///
+/// Then the query ID table followed by the match ID table, each of which is a sequence of IDs,
+/// each as a uint32 length followed by that many chars.
+///
+/// Trailer (32 bytes):
+///
+/// | Type     | Value                                                       |
+/// |----------|-------------------------------------------------------------|
+/// | uint64   | The offset from the start of the data to the query ID table |
+/// | uint64   | The number of records                                       |
+/// | uint32   | The number of query IDs                                     |
+/// | uint32   | The number of match IDs                                     |
+/// | char[8]  | BINARY_HITS_TRAILER_MAGIC ("CRHHEND" then a NUL)            |
+///
+/// The ID tables and their sizes are in the trailer so that a writer can emit the records as
+/// it goes, without knowing all the IDs up front (or needing a seekable output).
+///
+/// Empty data (with no header or trailer) holds no hits.
+
+namespace cath::rslv {
+
+	/// \brief The magic string at the start of data in the binary hits format
+	inline constexpr ::std::string_view BINARY_HITS_HEADER_MAGIC { "CRHHITS\0", 8 };
+
+	/// \brief The magic string at the end of data in the binary hits format
+	inline constexpr ::std::string_view BINARY_HITS_TRAILER_MAGIC{ "CRHHEND\0", 8 };
+
+	/// \brief The version of the binary hits format
+	inline constexpr uint32_t BINARY_HITS_VERSION = 1;
+
+	/// \brief The number of bytes in the header of the binary hits format
+	inline constexpr size_t BINARY_HITS_HEADER_SIZE = 16;
+
+	/// \brief The number of bytes in the trailer of the binary hits format
+	inline constexpr size_t BINARY_HITS_TRAILER_SIZE = 32;
+
+	/// \brief The number of bytes in the fixed-size part of each record in the binary hits format
+	inline constexpr size_t BINARY_HITS_RECORD_FIXED_SIZE = 20;
+
+	namespace detail {
+
+		/// \brief Append the specified arithmetic value to the specified string in the
+		///        little-endian representation used by the binary hits format
+		template <typename T>
+		void append_binary_hits_value(::std::string &prm_buffer, ///< The string to which the value should be appended
+		                              const T       &prm_value   ///< The value to append
+		                              ) {
+			static_assert( ::std::is_arithmetic_v<T>, "append_binary_hits_value() can only append arithmetic values" );
+			if constexpr ( ::std::is_floating_point_v<T> ) {
+				static_assert( sizeof( T ) == sizeof( uint64_t ), "append_binary_hits_value() can only append 64-bit floating-point values" );
+				uint64_t bits = 0;
+				::std::memcpy( &bits, &prm_value, sizeof( bits ) );
+				append_binary_hits_value( prm_buffer, bits );
+			}
+			else {
+				const T little_value = ::boost::endian::native_to_little( prm_value );
+				prm_buffer.append( reinterpret_cast<const char *>( &little_value ), sizeof( T ) );
+			}
+		}
+
+		/// \brief Append the specified string to the specified string as a uint32 length followed by the chars
+		inline void append_binary_hits_string(::std::string           &prm_buffer, ///< The string to which the string should be appended
+		                                      const ::std::string_view &prm_string  ///< The string to append
+		                                      ) {
+			append_binary_hits_value( prm_buffer, static_cast<uint32_t>( prm_string.length() ) );
+			prm_buffer.append( prm_string );
+		}
+
+		/// \brief Load an arithmetic value of the specified type from the specified (possibly unaligned)
+		///        location holding the little-endian representation used by the binary hits format
+		///
+		/// \pre There must be at least sizeof( T ) bytes readable at prm_data
+		template <typename T>
+		T load_binary_hits_value(const char * const prm_data ///< The location from which to load the value
+		                         ) {
+			static_assert( ::std::is_arithmetic_v<T>, "load_binary_hits_value() can only load arithmetic values" );
+			if constexpr ( ::std::is_floating_point_v<T> ) {
+				static_assert( sizeof( T ) == sizeof( uint64_t ), "load_binary_hits_value() can only load 64-bit floating-point values" );
+				const auto bits = load_binary_hits_value<uint64_t>( prm_data );
+				T value{};
+				::std::memcpy( &value, &bits, sizeof( value ) );
+				return value;
+			}
+			else {
+				T value{};
+				::std::memcpy( &value, prm_data, sizeof( T ) );
+				return ::boost::endian::little_to_native( value );
+			}
+		}
+
+	} // namespace detail
+
+} // namespace cath::rslv
+
+#endif // CATH_TOOLS_SOURCE_CT_RESOLVE_HITS_CATH_RESOLVE_HITS_FILE_BINARY_HITS_FORMAT_HPP
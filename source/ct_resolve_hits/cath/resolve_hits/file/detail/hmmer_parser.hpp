@@ -526,7 +526,7 @@ namespace cath::rslv::detail {
 			prm_read_and_process_mgr.add_hit(
 				*query_id,
 				std::move( segs ),
-				std::move( id_a ),
+				id_a,
 				summ.bitscore / bitscore_divisor( prm_apply_cath_policies, summ.evalues_are_susp ),
 				hit_score_type::BITSCORE,
 				std::move( extras )
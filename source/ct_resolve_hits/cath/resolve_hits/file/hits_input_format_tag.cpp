@@ -71,6 +71,7 @@ string cath::rslv::to_string(const hits_input_format_tag &prm_format_tag ///< Th
 		case ( hits_input_format_tag::HMMSEARCH_OUT    ) : { return "hmmsearch_out"    ; }
 		case ( hits_input_format_tag::RAW_WITH_SCORES  ) : { return "raw_with_scores"  ; }
 		case ( hits_input_format_tag::RAW_WITH_EVALUES ) : { return "raw_with_evalues" ; }
+		case ( hits_input_format_tag::BINARY           ) : { return "binary"           ; }
 	}
 	BOOST_THROW_EXCEPTION(out_of_range_exception("hits_input_format_tag value not recognised"));
 }
@@ -111,6 +112,7 @@ string cath::rslv::description_of_input_format(const hits_input_format_tag &prm_
 		case ( hits_input_format_tag::HMMSEARCH_OUT    ) : { return "HMMER hmmsearch output format (can be used to deduce discontinuous hits)" ; }
 		case ( hits_input_format_tag::RAW_WITH_SCORES  ) : { return "\"raw\" format with scores"                                               ; }
 		case ( hits_input_format_tag::RAW_WITH_EVALUES ) : { return "\"raw\" format with evalues"                                              ; }
+		case ( hits_input_format_tag::BINARY           ) : { return "Compact binary hits format (see --binary-format-help)"                    ; }
 	}
 	BOOST_THROW_EXCEPTION(out_of_range_exception("hits_input_format_tag value not recognised"));
 }
@@ -33,23 +33,25 @@ namespace cath::rslv {
 
 	/// \brief Represent the different formats in which resolve-hits input data can be read
 	enum class hits_input_format_tag : char {
-		HMMER_DOMTBLOUT, ///< HMMER domtblout format (must assume all hits are continuous)
-		HMMSCAN_OUT,     ///< HMMER hmmscan output format (can be used to deduce discontinuous hits)
-		HMMSEARCH_OUT,   ///< HMMER hmmsearch output format (can be used to deduce discontinuous hits)
-		RAW_WITH_SCORES, ///< "raw" format with scores
-		RAW_WITH_EVALUES ///< "raw" format with evalues
+		HMMER_DOMTBLOUT,  ///< HMMER domtblout format (must assume all hits are continuous)
+		HMMSCAN_OUT,      ///< HMMER hmmscan output format (can be used to deduce discontinuous hits)
+		HMMSEARCH_OUT,    ///< HMMER hmmsearch output format (can be used to deduce discontinuous hits)
+		RAW_WITH_SCORES,  ///< "raw" format with scores
+		RAW_WITH_EVALUES, ///< "raw" format with evalues
+		BINARY            ///< Compact binary hits format (see binary_hits_format.hpp)
 	};
 
 	/// \brief Type alias for vector of hits_input_format_tags
 	using hits_input_format_tag_vec = std::vector<hits_input_format_tag>;
 
 	/// \brief A constexpr list of all hits_input_format_tags
-	static constexpr std::array<hits_input_format_tag, 5> all_hits_input_format_tags { {
+	static constexpr std::array<hits_input_format_tag, 6> all_hits_input_format_tags { {
 		hits_input_format_tag::HMMER_DOMTBLOUT,
 		hits_input_format_tag::HMMSCAN_OUT,
 		hits_input_format_tag::HMMSEARCH_OUT,
 		hits_input_format_tag::RAW_WITH_SCORES,
-		hits_input_format_tag::RAW_WITH_EVALUES
+		hits_input_format_tag::RAW_WITH_EVALUES,
+		hits_input_format_tag::BINARY
 	} };
 
 	// Compile-time check that there aren't any duplicates in all_hits_input_format_tags
@@ -0,0 +1,305 @@
+/// \file
+/// \brief The parse_binary_hits definitions
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "parse_binary_hits.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <istream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include "cath/common/exception/runtime_error_exception.hpp"
+#include "cath/resolve_hits/file/binary_hits_format.hpp"
+#include "cath/resolve_hits/hit_extras.hpp"
+#include "cath/resolve_hits/hit_score_type.hpp"
+#include "cath/resolve_hits/options/spec/query_id_recorder.hpp"
+#include "cath/resolve_hits/read_and_process_hits/read_and_process_mgr.hpp"
+#include "cath/seq/seq_arrow.hpp"
+#include "cath/seq/seq_seg.hpp"
+
+using namespace ::cath;
+using namespace ::cath::common;
+using namespace ::cath::rslv;
+using namespace ::cath::rslv::detail;
+using namespace ::cath::seq;
+
+using ::boost::iostreams::mapped_file_source;
+using ::std::filesystem::path;
+using ::std::istream;
+using ::std::istreambuf_iterator;
+using ::std::string;
+using ::std::string_view;
+using ::std::vector;
+
+namespace {
+
+	/// \brief Throw a runtime_error_exception describing the specified problem with some binary hits data
+	[[noreturn]] void throw_malformed_binary_hits(const string &prm_problem ///< A description of the problem
+	                                              ) {
+		BOOST_THROW_EXCEPTION(runtime_error_exception("Malformed binary hits data: " + prm_problem));
+	}
+
+	/// \brief A position in binary hits data from which values can be read, which throws
+	///        rather than reading beyond the end of the data
+	class binary_hits_cursor final {
+	private:
+		/// \brief The data being read
+		string_view data;
+
+		/// \brief The offset of the next unread byte in data
+		size_t offset;
+
+		/// \brief Return a pointer to the next prm_num_bytes bytes and step over them
+		///        or throw if there aren't that many bytes left
+		const char * step(const size_t &prm_num_bytes ///< The number of bytes to step over
+		                  ) {
+			if ( prm_num_bytes > data.length() - offset ) {
+				throw_malformed_binary_hits( "the data ends part way through a record or an ID" );
+			}
+			const char * const result = data.data() + offset;
+			offset += prm_num_bytes;
+			return result;
+		}
+
+	public:
+		/// \brief Ctor from the data and the offset from which to start reading
+		binary_hits_cursor(const string_view &prm_data,  ///< The data to read
+		                   const size_t      &prm_offset ///< The offset from which to start reading
+		                   ) : data  { prm_data   },
+		                       offset{ prm_offset } {
+		}
+
+		/// \brief Read an arithmetic value of the specified type
+		template <typename T>
+		T read() {
+			return load_binary_hits_value<T>( step( sizeof( T ) ) );
+		}
+
+		/// \brief Read a string (as a uint32 length followed by the chars), returning a view into the data
+		string_view read_string() {
+			const auto length = static_cast<size_t>( read<uint32_t>() );
+			return { step( length ), length };
+		}
+
+		/// \brief Return whether all the data has been read
+		[[nodiscard]] bool at_end() const {
+			return offset == data.length();
+		}
+	};
+
+	/// \brief Read a table of the specified number of IDs, returning views into the data
+	vector<string_view> read_binary_hits_id_table(binary_hits_cursor &prm_cursor, ///< The cursor from which to read the table
+	                                              const size_t       &prm_num_ids ///< The number of IDs in the table
+	                                              ) {
+		vector<string_view> ids;
+		ids.reserve( prm_num_ids );
+		for (size_t id_ctr = 0; id_ctr < prm_num_ids; ++id_ctr) {
+			ids.push_back( prm_cursor.read_string() );
+		}
+		return ids;
+	}
+
+	/// \brief Get the hit_score_type corresponding to the specified value in binary hits data
+	hit_score_type binary_hits_score_type(const uint8_t &prm_value ///< The value from the binary hits data
+	                                      ) {
+		switch ( prm_value ) {
+			case ( static_cast<uint8_t>( hit_score_type::FULL_EVALUE ) ) : { return hit_score_type::FULL_EVALUE; }
+			case ( static_cast<uint8_t>( hit_score_type::BITSCORE    ) ) : { return hit_score_type::BITSCORE;    }
+			case ( static_cast<uint8_t>( hit_score_type::CRH_SCORE   ) ) : { return hit_score_type::CRH_SCORE;   }
+		}
+		throw_malformed_binary_hits( "unrecognised score type " + ::std::to_string( prm_value ) );
+	}
+
+	/// \brief Read one hit extra from the specified cursor and add it to the specified hit_extras_store
+	void read_binary_hits_extra(binary_hits_cursor &prm_cursor, ///< The cursor from which to read the extra
+	                            hit_extras_store   &prm_extras  ///< The hit_extras_store to which the extra should be added
+	                            ) {
+		const auto category = prm_cursor.read<uint8_t>();
+		switch ( category ) {
+			case ( static_cast<uint8_t>( hit_extra_cat::ALND_RGNS ) ) : {
+				prm_extras.push_back<hit_extra_cat::ALND_RGNS>( string( prm_cursor.read_string() ) );
+				return;
+			}
+			case ( static_cast<uint8_t>( hit_extra_cat::COND_EVAL ) ) : {
+				prm_extras.push_back<hit_extra_cat::COND_EVAL>( prm_cursor.read<double>() );
+				return;
+			}
+			case ( static_cast<uint8_t>( hit_extra_cat::INDP_EVAL ) ) : {
+				prm_extras.push_back<hit_extra_cat::INDP_EVAL>( prm_cursor.read<double>() );
+				return;
+			}
+		}
+		throw_malformed_binary_hits( "unrecognised hit extra category " + ::std::to_string( category ) );
+	}
+
+} // namespace
+
+/// \brief Parse hits in the binary hits format (see binary_hits_format.hpp) from the specified data
+///        and pass them to the specified read_and_process_mgr
+///
+/// The IDs are passed to the read_and_process_mgr as views into the data, so no text is parsed or copied
+/// on the way in (the read_and_process_mgr interns the labels and copies the query IDs it needs).
+///
+/// \throws runtime_error_exception if the data is malformed
+void cath::rslv::parse_binary_hits_data(read_and_process_mgr &prm_read_and_process_mgr, ///< The read_and_process_mgr to which the hits should be passed for processing
+                                        const string_view    &prm_data                  ///< The binary hits data
+                                        ) {
+	prm_read_and_process_mgr.process_all_outstanding();
+
+	// Treat empty data as holding no hits (which is what write_binary_hits_processor writes for no hits)
+	if ( prm_data.empty() ) {
+		return;
+	}
+
+	// Check the header and trailer
+	if ( prm_data.length() < BINARY_HITS_HEADER_SIZE + BINARY_HITS_TRAILER_SIZE ) {
+		throw_malformed_binary_hits( "the data is too short to contain the header and trailer" );
+	}
+	if ( prm_data.substr( 0, BINARY_HITS_HEADER_MAGIC.length() ) != BINARY_HITS_HEADER_MAGIC ) {
+		throw_malformed_binary_hits( "the data doesn't start with the binary hits header" );
+	}
+	const auto version = load_binary_hits_value<uint32_t>( prm_data.data() + BINARY_HITS_HEADER_MAGIC.length() );
+	if ( version != BINARY_HITS_VERSION ) {
+		throw_malformed_binary_hits(
+			"the data has version " + ::std::to_string( version ) + " but only version " + ::std::to_string( BINARY_HITS_VERSION ) + " is supported"
+		);
+	}
+	const size_t       trailer_offset = prm_data.length() - BINARY_HITS_TRAILER_SIZE;
+	const char * const trailer        = prm_data.data() + trailer_offset;
+	if ( string_view{ trailer + BINARY_HITS_TRAILER_SIZE - BINARY_HITS_TRAILER_MAGIC.length(), BINARY_HITS_TRAILER_MAGIC.length() } != BINARY_HITS_TRAILER_MAGIC ) {
+		throw_malformed_binary_hits( "the data doesn't end with the binary hits trailer (it may be truncated)" );
+	}
+	const auto table_offset  = load_binary_hits_value<uint64_t>( trailer      );
+	const auto num_records   = load_binary_hits_value<uint64_t>( trailer +  8 );
+	const auto num_query_ids = load_binary_hits_value<uint32_t>( trailer + 16 );
+	const auto num_match_ids = load_binary_hits_value<uint32_t>( trailer + 20 );
+	if ( table_offset < BINARY_HITS_HEADER_SIZE || table_offset > trailer_offset ) {
+		throw_malformed_binary_hits( "the trailer's offset of the ID tables is out of range" );
+	}
+	// Each ID takes at least its uint32 length, so reject impossible counts before reserving space for them
+	const uint64_t max_num_ids = ( trailer_offset - table_offset ) / sizeof( uint32_t );
+	if ( static_cast<uint64_t>( num_query_ids ) + static_cast<uint64_t>( num_match_ids ) > max_num_ids ) {
+		throw_malformed_binary_hits(
+			"the trailer's numbers of IDs (" + ::std::to_string( num_query_ids ) + " query and " + ::std::to_string( num_match_ids )
+			+ " match) can't fit in the " + ::std::to_string( trailer_offset - table_offset ) + " bytes of the ID tables"
+		);
+	}
+
+	// Read the ID tables
+	binary_hits_cursor table_cursor{ prm_data.substr( 0, trailer_offset ), static_cast<size_t>( table_offset ) };
+	const vector<string_view> query_ids = read_binary_hits_id_table( table_cursor, num_query_ids );
+	const vector<string_view> match_ids = read_binary_hits_id_table( table_cursor, num_match_ids );
+	if ( ! table_cursor.at_end() ) {
+		throw_malformed_binary_hits( "there's unexpected data after the ID tables" );
+	}
+
+	// Store the query IDs seen so far if the crh_filter_spec specifies a limit on the number of queries
+	query_id_recorder seen_query_ids;
+
+	// Read the records and pass each hit to the read_and_process_mgr
+	binary_hits_cursor record_cursor{ prm_data.substr( 0, static_cast<size_t>( table_offset ) ), BINARY_HITS_HEADER_SIZE };
+	for (uint64_t record_ctr = 0; record_ctr < num_records; ++record_ctr) {
+		const auto query_id_index = record_cursor.read<uint32_t>();
+		const auto match_id_index = record_cursor.read<uint32_t>();
+		const auto score_type     = binary_hits_score_type( record_cursor.read<uint8_t>() );
+		const auto num_extras     = record_cursor.read<uint8_t >();
+		const auto num_segments   = record_cursor.read<uint16_t>();
+		const auto score          = record_cursor.read<double  >();
+		if ( query_id_index >= query_ids.size() || match_id_index >= match_ids.size() ) {
+			throw_malformed_binary_hits( "record " + ::std::to_string( record_ctr ) + " has an ID index that's out of range" );
+		}
+		if ( num_segments == 0 ) {
+			throw_malformed_binary_hits( "record " + ::std::to_string( record_ctr ) + " has no segments" );
+		}
+
+		seq_seg_vec segments;
+		segments.reserve( num_segments );
+		for (size_t seg_ctr = 0; seg_ctr < num_segments; ++seg_ctr) {
+			const auto start = record_cursor.read<uint32_t>();
+			const auto stop  = record_cursor.read<uint32_t>();
+			if ( stop < start || ( ! segments.empty() && segments.back().get_stop_arrow() > arrow_before_res( start ) ) ) {
+				throw_malformed_binary_hits( "record " + ::std::to_string( record_ctr ) + " has invalid or misordered segments" );
+			}
+			segments.emplace_back( arrow_before_res( start ), arrow_after_res( stop ) );
+		}
+
+		hit_extras_store extras;
+		for (size_t extra_ctr = 0; extra_ctr < num_extras; ++extra_ctr) {
+			read_binary_hits_extra( record_cursor, extras );
+		}
+
+		// If this query ID should be skipped, then skip this hit.
+		// The function also updates seen_query_ids if not skipping this query ID
+		const string_view &query_id = query_ids[ query_id_index ];
+		if ( should_skip_query_and_update( prm_read_and_process_mgr, query_id, seen_query_ids ) ) {
+			continue;
+		}
+
+		prm_read_and_process_mgr.add_hit(
+			query_id,
+			std::move( segments ),
+			match_ids[ match_id_index ],
+			score,
+			score_type,
+			std::move( extras )
+		);
+	}
+	if ( ! record_cursor.at_end() ) {
+		throw_malformed_binary_hits( "there's unexpected data between the records and the ID tables" );
+	}
+
+	prm_read_and_process_mgr.process_all_outstanding();
+}
+
+/// \brief Parse hits in the binary hits format from the specified file (which is memory-mapped rather than read)
+///        and pass them to the specified read_and_process_mgr
+///
+/// \throws runtime_error_exception if the data is malformed
+void cath::rslv::parse_binary_hits_file(read_and_process_mgr &prm_read_and_process_mgr, ///< The read_and_process_mgr to which the hits should be passed for processing
+                                        const path           &prm_file                  ///< The file from which the binary hits data should be parsed
+                                        ) {
+	// mapped_file_source can't map an empty file, so pass empty data straight through
+	if ( ::std::filesystem::file_size( prm_file ) == 0 ) {
+		parse_binary_hits_data( prm_read_and_process_mgr, string_view{} );
+		return;
+	}
+	const mapped_file_source the_mapped_file{ prm_file.string() };
+	parse_binary_hits_data(
+		prm_read_and_process_mgr,
+		string_view{ the_mapped_file.data(), the_mapped_file.size() }
+	);
+}
+
+/// \brief Parse hits in the binary hits format from the specified istream and pass them to the specified read_and_process_mgr
+///
+/// The istream can't be memory-mapped so this reads all the data into memory first;
+/// prefer parse_binary_hits_file() where possible.
+///
+/// \throws runtime_error_exception if the data is malformed
+void cath::rslv::parse_binary_hits(read_and_process_mgr &prm_read_and_process_mgr, ///< The read_and_process_mgr to which the hits should be passed for processing
+                                   istream              &prm_istream               ///< The istream from which the binary hits data should be parsed
+                                   ) {
+	const string the_data{ istreambuf_iterator<char>{ prm_istream }, istreambuf_iterator<char>{} };
+	parse_binary_hits_data( prm_read_and_process_mgr, the_data );
+}
@@ -0,0 +1,189 @@
+/// \file
+/// \brief The parse_binary_hits test suite
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "parse_binary_hits.hpp"
+
+#include <sstream>
+
+#include <boost/test/unit_test.hpp>
+
+#include "cath/common/exception/runtime_error_exception.hpp"
+#include "cath/common/file/ofstream_list.hpp"
+#include "cath/common/file/open_fstream.hpp"
+#include "cath/common/size_t_literal.hpp"
+#include "cath/resolve_hits/calc_hit_list.hpp"
+#include "cath/resolve_hits/file/binary_hits_format.hpp"
+#include "cath/resolve_hits/file/hmmer_format.hpp"
+#include "cath/resolve_hits/file/parse_hmmer_out.hpp"
+#include "cath/resolve_hits/options/spec/crh_input_spec.hpp"
+#include "cath/resolve_hits/options/spec/crh_spec.hpp"
+#include "cath/resolve_hits/read_and_process_hits/hits_processor/write_binary_hits_processor.hpp"
+#include "cath/resolve_hits/read_and_process_hits/read_and_process_mgr.hpp"
+#include "cath/resolve_hits/test/resolve_hits_fixture.hpp"
+#include "cath/test/global_test_constants.hpp"
+
+using namespace ::cath;
+using namespace ::cath::common;
+using namespace ::cath::rslv;
+using namespace ::cath::rslv::detail;
+
+using ::cath::common::literals::operator""_z;
+using ::std::ifstream;
+using ::std::istringstream;
+using ::std::ostringstream;
+using ::std::string;
+
+namespace {
+
+	/// \brief The parse_binary_hits_test_suite_fixture to assist in testing parse_binary_hits
+	struct parse_binary_hits_test_suite_fixture : protected resolve_hits_fixture, protected global_test_constants {
+	protected:
+		~parse_binary_hits_test_suite_fixture() noexcept = default;
+
+		/// \brief Make a read_and_process_mgr that writes the hits it's given to the specified ostringstream in the binary hits format
+		static read_and_process_mgr make_binary_writing_mgr(ostringstream &prm_binary_oss ///< The ostringstream to which the binary hits data should be written
+		                                                    ) {
+			return make_read_and_process_mgr( write_binary_hits_processor{ { prm_binary_oss } }, crh_spec{} );
+		}
+
+		/// \brief Convert the example raw-format input to the binary hits format
+		static string example_binary_data() {
+			istringstream test_iss{ string( EXAMPLE_INPUT_RAW ) };
+			ostringstream binary_oss;
+			read_and_process_mgr the_read_and_process_mgr = make_binary_writing_mgr( binary_oss );
+			read_hit_list_from_istream( the_read_and_process_mgr, test_iss, hit_score_type::CRH_SCORE );
+			return binary_oss.str();
+		}
+
+		/// \brief Parse the specified binary hits data and return the standard resolved output
+		static string resolve_binary_data(const string &prm_binary_data ///< The binary hits data to parse
+		                                  ) {
+			ostringstream test_oss;
+			ofstream_list ofstreams{ test_oss };
+			read_and_process_mgr the_read_and_process_mgr = make_read_and_process_mgr(
+				ofstreams,
+				crh_spec{}
+					.set_score_spec( make_neutral_score_spec() )
+			);
+			parse_binary_hits_data( the_read_and_process_mgr, prm_binary_data );
+			return blank_vrsn( test_oss );
+		}
+	};
+
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE(parse_binary_hits_test_suite, parse_binary_hits_test_suite_fixture)
+
+BOOST_AUTO_TEST_CASE(round_trips_text_hits_through_binary_format) {
+	const string binary_data = example_binary_data();
+	BOOST_REQUIRE_GT( binary_data.length(), BINARY_HITS_HEADER_SIZE + BINARY_HITS_TRAILER_SIZE );
+	BOOST_CHECK_EQUAL( resolve_binary_data( binary_data ), EXAMPLE_OUTPUT );
+
+	istringstream binary_iss{ binary_data };
+	ostringstream test_oss;
+	ofstream_list ofstreams{ test_oss };
+	read_and_process_mgr the_read_and_process_mgr = make_read_and_process_mgr(
+		ofstreams,
+		crh_spec{}
+			.set_score_spec( make_neutral_score_spec() )
+	);
+	parse_binary_hits( the_read_and_process_mgr, binary_iss );
+	BOOST_CHECK_EQUAL( blank_vrsn( test_oss ), EXAMPLE_OUTPUT );
+}
+
+BOOST_AUTO_TEST_CASE(rewrites_hits_with_extras_identically) {
+	ostringstream first_binary_oss;
+	{
+		ifstream the_ifstream = open_ifstream( CRH_EG_HMMSEARCH_IN_FILENAME() );
+		read_and_process_mgr the_read_and_process_mgr = make_binary_writing_mgr( first_binary_oss );
+		parse_hmmer_out( the_read_and_process_mgr, the_ifstream, hmmer_format::HMMSEARCH, false, crh_input_spec::DEFAULT_MIN_GAP_LENGTH, true );
+		the_ifstream.close();
+	}
+
+	ostringstream second_binary_oss;
+	read_and_process_mgr the_read_and_process_mgr = make_binary_writing_mgr( second_binary_oss );
+	parse_binary_hits_data( the_read_and_process_mgr, first_binary_oss.str() );
+
+	BOOST_REQUIRE_GT( first_binary_oss.str().length(), BINARY_HITS_HEADER_SIZE + BINARY_HITS_TRAILER_SIZE );
+	BOOST_CHECK( second_binary_oss.str() == first_binary_oss.str() );
+}
+
+BOOST_AUTO_TEST_CASE(writes_and_reads_no_hits_as_empty_data) {
+	istringstream test_iss{ string{} };
+	ostringstream binary_oss;
+	read_and_process_mgr the_read_and_process_mgr = make_binary_writing_mgr( binary_oss );
+	read_hit_list_from_istream( the_read_and_process_mgr, test_iss, hit_score_type::CRH_SCORE );
+	BOOST_CHECK_EQUAL( binary_oss.str(), "" );
+
+	istringstream empty_iss{ string{} };
+	ostringstream test_oss;
+	ofstream_list ofstreams{ test_oss };
+	read_and_process_mgr text_read_and_process_mgr = make_read_and_process_mgr(
+		ofstreams,
+		crh_spec{}
+			.set_score_spec( make_neutral_score_spec() )
+	);
+	read_hit_list_from_istream( text_read_and_process_mgr, empty_iss, hit_score_type::CRH_SCORE );
+	BOOST_CHECK_EQUAL( resolve_binary_data( "" ), blank_vrsn( test_oss ) );
+}
+
+BOOST_AUTO_TEST_CASE(throws_on_malformed_data) {
+	const string binary_data = example_binary_data();
+
+	// Truncated data
+	for (const size_t &num_bytes_removed : { 1_z, BINARY_HITS_TRAILER_SIZE, binary_data.length() - 1 } ) {
+		BOOST_CHECK_THROW( resolve_binary_data( binary_data.substr( 0, binary_data.length() - num_bytes_removed ) ), runtime_error_exception );
+	}
+
+	// Text data
+	BOOST_CHECK_THROW( resolve_binary_data( string( EXAMPLE_INPUT_RAW ) ), runtime_error_exception );
+
+	// A bad version
+	string bad_version_data = binary_data;
+	bad_version_data[ BINARY_HITS_HEADER_MAGIC.length() ] = 2;
+	BOOST_CHECK_THROW( resolve_binary_data( bad_version_data ), runtime_error_exception );
+
+	// A first record with no segments
+	string no_segments_data = binary_data;
+	no_segments_data[ BINARY_HITS_HEADER_SIZE + 10 ] = 0;
+	no_segments_data[ BINARY_HITS_HEADER_SIZE + 11 ] = 0;
+	BOOST_CHECK_THROW( resolve_binary_data( no_segments_data ), runtime_error_exception );
+
+	// A first record with an unrecognised score type
+	string bad_score_type_data = binary_data;
+	bad_score_type_data[ BINARY_HITS_HEADER_SIZE + 8 ] = 100;
+	BOOST_CHECK_THROW( resolve_binary_data( bad_score_type_data ), runtime_error_exception );
+}
+
+BOOST_AUTO_TEST_CASE(throws_on_trailer_with_more_ids_than_can_fit_in_the_id_tables) {
+	// Set the trailer's numbers of query and match IDs to 0xFFFFFFFF, which should be rejected
+	// before any attempt to reserve space for that many IDs
+	const string binary_data    = example_binary_data();
+	const size_t trailer_offset = binary_data.length() - BINARY_HITS_TRAILER_SIZE;
+	for (const size_t &count_offset : { 16_z, 20_z } ) {
+		string bad_num_ids_data = binary_data;
+		for (size_t byte_ctr = 0; byte_ctr < sizeof( uint32_t ); ++byte_ctr) {
+			bad_num_ids_data[ trailer_offset + count_offset + byte_ctr ] = static_cast<char>( 0xFF );
+		}
+		BOOST_CHECK_THROW( resolve_binary_data( bad_num_ids_data ), runtime_error_exception );
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -20,42 +20,260 @@
 
 #include "parse_domain_hits_table.hpp"
 
+#include <algorithm>
+#include <array>
+#include <exception>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 #include <spdlog/fmt/ostr.h>
 #include <spdlog/spdlog.h>
 
 #include "cath/common/algorithm/contains.hpp"
 #include "cath/common/boost_addenda/make_string_view.hpp"
+#include "cath/common/exception/runtime_error_exception.hpp"
 #include "cath/common/file/open_fstream.hpp"
 #include "cath/common/string/string_parse_tools.hpp"
+#include "cath/common/thread/ordered_task_pool.hpp"
+#include "cath/common/thread/parallel_for_each_index.hpp"
+#include "cath/resolve_hits/read_and_process_hits/hits_processor/gather_hits_processor.hpp"
+#include "cath/resolve_hits/read_and_process_hits/hits_processor/hits_processor_list.hpp"
 #include "cath/resolve_hits/read_and_process_hits/read_and_process_mgr.hpp"
 #include "cath/resolve_hits/resolve_hits_type_aliases.hpp"
 
 using namespace ::cath;
 using namespace ::cath::common;
 using namespace ::cath::rslv;
+using namespace ::cath::rslv::detail;
 using namespace ::cath::seq;
 
 using ::std::filesystem::path;
 using ::std::ifstream;
 using ::std::istream;
 using ::std::string;
+using ::std::string_view;
+
+namespace {
+
+	constexpr size_t TARGET_FIELD_IDX        =  0;
+	constexpr size_t QUERY_FIELD_IDX         =  3;
+	constexpr size_t COND_EVALUE_FIELD_IDX   = 11;
+	constexpr size_t INDP_EVALUE_FIELD_IDX   = 12;
+	constexpr size_t BITSCORE_FIELD_IDX      = 13;
+	constexpr size_t ALI_START_RES_FIELD_IDX = 17;
+	constexpr size_t ALI_STOP_RES_FIELD_IDX  = 18;
+	constexpr size_t ENV_START_RES_FIELD_IDX = 19;
+	constexpr size_t ENV_STOP_RES_FIELD_IDX  = 20;
+
+	/// \brief The number of fields at the start of each line that are needed (the rest are left unsplit)
+	constexpr size_t NUM_FIELDS_TO_SPLIT = ENV_STOP_RES_FIELD_IDX + 1;
+
+	/// \brief Type alias for an array of the iterators wrapping each of the fields that are needed from a line
+	using field_itrs_arr = ::std::array<str_citr_str_citr_pair, NUM_FIELDS_TO_SPLIT>;
+
+	/// \brief A hit parsed from one line of HMMER domain hits table data
+	///
+	/// The IDs are stored as offsets into the text of the chunk because the chunk may be moved
+	struct domain_hits_table_record final {
+		/// \brief The offset of the start of the target ID within the chunk's text
+		size_t target_begin = 0;
+
+		/// \brief The offset of the end of the target ID within the chunk's text
+		size_t target_end = 0;
+
+		/// \brief The offset of the start of the query ID within the chunk's text
+		size_t query_begin = 0;
+
+		/// \brief The offset of the end of the query ID within the chunk's text
+		size_t query_end = 0;
+
+		/// \brief The HMMER bit-score
+		double bitscore = 0.0;
+
+		/// \brief The HMMER conditional evalue
+		double cond_evalue = 0.0;
+
+		/// \brief The HMMER independent evalue
+		double indp_evalue = 0.0;
+
+		/// \brief The start residue of the hit
+		residx_t start = 0;
+
+		/// \brief The stop residue of the hit
+		residx_t stop = 0;
+
+		/// \brief Any error from parsing the fields after the target ID
+		///
+		/// This is only rethrown if the hit's target isn't skipped, as when parsing a line at a time
+		::std::exception_ptr parse_error;
+	};
+
+	/// \brief A chunk of whole lines of HMMER domain hits table data and the hits parsed from it
+	struct domain_hits_table_chunk final {
+		/// \brief The text of the chunk
+		string text;
+
+		/// \brief The hits parsed from the text, in order
+		::std::vector<domain_hits_table_record> records;
+	};
+
+	/// \brief Split (up to) the first NUM_FIELDS_TO_SPLIT fields of the specified line in a single pass
+	///        and return the number of fields found
+	///
+	/// This is dumb about whitespace (explicitly compares to ' ' and '\t'; ignores locale) for the sake of speed
+	size_t split_domain_hits_table_fields(const str_citr &prm_line_begin, ///< The begin              iterator of the line
+	                                      const str_citr &prm_line_end,   ///< The end (one-past-end) iterator of the line
+	                                      field_itrs_arr &prm_fields      ///< The array to populate with the iterators wrapping each field
+	                                      ) {
+		size_t num_fields = 0;
+		str_citr itr = prm_line_begin;
+		while ( num_fields < NUM_FIELDS_TO_SPLIT ) {
+			itr = find_itr_before_first_non_space( itr, prm_line_end );
+			if ( itr == prm_line_end ) {
+				break;
+			}
+			const str_citr field_end = find_itr_before_first_space( itr, prm_line_end );
+			prm_fields[ num_fields++ ] = { itr, field_end };
+			itr = field_end;
+		}
+		return num_fields;
+	}
+
+	/// \brief Parse a hit from the specified line of HMMER domain hits table data
+	domain_hits_table_record parse_domain_hits_table_line(const string   &prm_text,               ///< The text of the chunk containing the line
+	                                                      const str_citr &prm_line_begin,         ///< The begin              iterator of the line
+	                                                      const str_citr &prm_line_end,           ///< The end (one-past-end) iterator of the line
+	                                                      const bool     &prm_apply_cath_policies ///< Whether to apply CATH-specific policies
+	                                                      ) {
+		field_itrs_arr fields;
+		const size_t num_fields = split_domain_hits_table_fields( prm_line_begin, prm_line_end, fields );
+
+		const auto offset_of = [&] (const str_citr &x) {
+			return static_cast<size_t>( ::std::distance( ::std::cbegin( prm_text ), x ) );
+		};
+		const auto field_itrs = [&] (const size_t &prm_field_index) -> const str_citr_str_citr_pair & {
+			if ( prm_field_index >= num_fields ) {
+				const string line_string{ prm_line_begin, prm_line_end };
+				BOOST_THROW_EXCEPTION(runtime_error_exception(
+					"Unable to find field "
+					+ std::to_string( prm_field_index )
+					+ " in line \""
+					+ ( line_string.size() > 103 ? ( line_string.substr( 0, 100 ) + "[...]" ) : line_string )
+					+ "\""
+				));
+			}
+			return fields[ prm_field_index ];
+		};
+
+		domain_hits_table_record the_record;
+		const str_citr_str_citr_pair target_field_itrs = ( num_fields > TARGET_FIELD_IDX ) ? fields[ TARGET_FIELD_IDX ]
+		                                                                                   : str_citr_str_citr_pair{ prm_line_end, prm_line_end };
+		the_record.target_begin = offset_of( target_field_itrs.first  );
+		the_record.target_end   = offset_of( target_field_itrs.second );
+
+		try {
+			const auto &query_field_itrs = field_itrs( QUERY_FIELD_IDX );
+			the_record.query_begin = offset_of( query_field_itrs.first  );
+			the_record.query_end   = offset_of( query_field_itrs.second );
+
+			const auto   id_score_cat    = cath_score_category_of_id( make_string_view( query_field_itrs.first, query_field_itrs.second ), prm_apply_cath_policies );
+			const bool   apply_dc_cat    = ( id_score_cat == cath_id_score_category::DC_TYPE );
+			const size_t start_field_idx = apply_dc_cat ? ALI_START_RES_FIELD_IDX : ENV_START_RES_FIELD_IDX;
+			const size_t stop_field_idx  = apply_dc_cat ? ALI_STOP_RES_FIELD_IDX  : ENV_STOP_RES_FIELD_IDX;
+
+			const auto &cond_evalue_field_itrs = field_itrs( COND_EVALUE_FIELD_IDX );
+			const auto &indp_evalue_field_itrs = field_itrs( INDP_EVALUE_FIELD_IDX );
+			const auto &bitscore_field_itrs    = field_itrs( BITSCORE_FIELD_IDX    );
+			const auto &start_res_field_itrs   = field_itrs( start_field_idx       );
+			const auto &stop_res_field_itrs    = field_itrs( stop_field_idx        );
+
+			the_record.bitscore    = parse_double_from_field( bitscore_field_itrs.first,    bitscore_field_itrs.second    );
+			the_record.start       = parse_uint_from_field  ( start_res_field_itrs.first,   start_res_field_itrs.second   );
+			the_record.stop        = parse_uint_from_field  ( stop_res_field_itrs.first,    stop_res_field_itrs.second    );
+			the_record.cond_evalue = parse_double_from_field( cond_evalue_field_itrs.first, cond_evalue_field_itrs.second );
+			the_record.indp_evalue = parse_double_from_field( indp_evalue_field_itrs.first, indp_evalue_field_itrs.second );
+		}
+		catch (...) {
+			the_record.parse_error = ::std::current_exception();
+		}
+		return the_record;
+	}
+
+	/// \brief Parse the hits from the specified chunk of whole lines of HMMER domain hits table data
+	///
+	/// This doesn't touch any shared state so chunks can be parsed in parallel
+	domain_hits_table_chunk parse_domain_hits_table_chunk(string      prm_text,               ///< The text of the chunk
+	                                                      const bool &prm_apply_cath_policies ///< Whether to apply CATH-specific policies
+	                                                      ) {
+		domain_hits_table_chunk the_chunk{ std::move( prm_text ), {} };
+		const string &text = the_chunk.text;
+
+		str_citr line_begin = ::std::cbegin( text );
+		while ( line_begin != ::std::cend( text ) ) {
+			const str_citr line_end = ::std::find( line_begin, ::std::cend( text ), '\n' );
+
+			// Skip blank lines and comment lines
+			if ( line_begin != line_end && *line_begin != '#' ) {
+				the_chunk.records.push_back( parse_domain_hits_table_line( text, line_begin, line_end, prm_apply_cath_policies ) );
+			}
+
+			line_begin = ( line_end == ::std::cend( text ) ) ? line_end : ::std::next( line_end );
+		}
+		return the_chunk;
+	}
+
+	/// \brief Read the next chunk of (roughly) the specified number of bytes of whole lines from the specified istream
+	///        (or return an empty string at the end of the data)
+	///
+	/// The chunk is extended to the end of its last line. Any partial line read beyond that is moved into
+	/// prm_carry, to be placed at the start of the next chunk.
+	string read_domain_hits_table_chunk(istream      &prm_input_stream, ///< The istream from which to read the data
+	                                    string       &prm_carry,        ///< The partial line read beyond the end of the previous chunk (updated by this function)
+	                                    const size_t &prm_chunk_size    ///< The number of bytes to read in each block
+	                                    ) {
+		const size_t block_size = std::max( prm_chunk_size, static_cast<size_t>( 1 ) );
+
+		string chunk = std::move( prm_carry );
+		prm_carry.clear();
+		while ( prm_input_stream ) {
+			const size_t prev_size = chunk.size();
+			chunk.resize( prev_size + block_size );
+			prm_input_stream.read( &chunk[ prev_size ], static_cast<std::streamsize>( block_size ) );
+			chunk.resize( prev_size + static_cast<size_t>( prm_input_stream.gcount() ) );
+
+			// The carried partial line contains no newline, so only search the newly read block
+			const size_t newline_index = string_view{ chunk }.substr( prev_size ).rfind( '\n' );
+			if ( newline_index != string_view::npos ) {
+				const size_t chunk_end = prev_size + newline_index + 1;
+				prm_carry.assign( chunk, chunk_end );
+				chunk.resize( chunk_end );
+				return chunk;
+			}
+		}
+		return chunk;
+	}
+
+} // namespace
 
 /// \brief Parse a HMMER domain hits table file (as produced by the --domtblout option to a HMMER program)
 ///        from the specified file and pass them to the specified read_and_process_mgr
 void cath::rslv::parse_domain_hits_table_file(read_and_process_mgr &prm_read_and_process_mgr,   ///< The read_and_process_mgr to which the hits should be passed for processing
                                               const path           &prm_domain_hits_table_file, ///< The file from which the HMMER domain hits table data should be parsed
-                                              const bool           &prm_apply_cath_policies     ///< Whether to apply CATH-specific policies
+                                              const bool           &prm_apply_cath_policies,    ///< Whether to apply CATH-specific policies
+                                              const size_t         &prm_num_threads             ///< The number of threads with which to parse the data (or 0 to use the hardware concurrency)
                                               ) {
 	ifstream the_ifstream = open_ifstream( prm_domain_hits_table_file );
 
 	parse_domain_hits_table(
 		prm_read_and_process_mgr,
 		the_ifstream,
-		prm_apply_cath_policies
+		prm_apply_cath_policies,
+		prm_num_threads
 	);
 
 	the_ifstream.close();
@@ -69,11 +287,17 @@ void cath::rslv::parse_domain_hits_table_file(read_and_process_mgr &prm_read_and
 
 /// \brief Parse HMMER domain hits table data (as produced by the --domtblout option to a HMMER program)
 ///        from the specified istream and pass them to the specified read_and_process_mgr
+///
+/// The data is read in large chunks of whole lines. If more than one thread is requested, the chunks are split
+/// into fields and parsed in parallel on a pool of worker threads. Either way, the hits are passed to the
+/// read_and_process_mgr on the calling thread, in the order in which they appear in the data. The number of
+/// chunks in flight is bounded so the memory use is bounded, however large the data.
 void cath::rslv::parse_domain_hits_table(read_and_process_mgr &prm_read_and_process_mgr, ///< The read_and_process_mgr to which the hits should be passed for processing
                                          istream              &prm_input_stream,         ///< The istream from which the HMMER domain hits table data should be parsed
-                                         const bool           &prm_apply_cath_policies   ///< Whether to apply CATH-specific policies
+                                         const bool           &prm_apply_cath_policies,  ///< Whether to apply CATH-specific policies
+                                         const size_t         &prm_num_threads,          ///< The number of threads with which to parse the data (or 0 to use the hardware concurrency)
+                                         const size_t         &prm_chunk_size            ///< The (approximate) number of bytes of data to parse in each chunk
                                          ) {
-	string line_string;
 	bool skipped_for_negtv_bitscore = false;
 
 	prm_read_and_process_mgr.process_all_outstanding();
@@ -81,81 +305,107 @@ void cath::rslv::parse_domain_hits_table(read_and_process_mgr &prm_read_and_proc
 	// Store the query IDs seen so far if the crh_filter_spec specifies a limit on the number of queries
 	query_id_recorder seen_query_ids;
 
-	while ( getline( prm_input_stream, line_string ) ) {
-		// Skip comment lines
-		if ( line_string.front() == '#' ) {
-			continue;
-		}
+	const auto process_chunk_fn = [&] (const domain_hits_table_chunk &prm_chunk) {
+		const string_view text{ prm_chunk.text };
+		for (const domain_hits_table_record &the_record : prm_chunk.records) {
+			const string_view target_id_str_ref = text.substr( the_record.target_begin, the_record.target_end - the_record.target_begin );
 
-		constexpr size_t TARGET_FIELD_IDX        =  0;
-		constexpr size_t QUERY_FIELD_IDX         =  3;
-		constexpr size_t COND_EVALUE_FIELD_IDX   = 11;
-		constexpr size_t INDP_EVALUE_FIELD_IDX   = 12;
-		constexpr size_t BITSCORE_FIELD_IDX      = 13;
-		constexpr size_t ALI_START_RES_FIELD_IDX = 17;
-		constexpr size_t ALI_STOP_RES_FIELD_IDX  = 18;
-		constexpr size_t ENV_START_RES_FIELD_IDX = 19;
-		constexpr size_t ENV_STOP_RES_FIELD_IDX  = 20;
-
-		const auto     target_field_itrs      = find_field_itrs( line_string, TARGET_FIELD_IDX                                                                );
-		const auto     target_id_str_ref      = make_string_view( target_field_itrs.first, target_field_itrs.second );
-
-		// If this query ID should be skipped, then skip this entry.
-		// The function also updates seen_query_ids if not skipping this query ID
-		if ( should_skip_query_and_update( prm_read_and_process_mgr, target_id_str_ref, seen_query_ids) ) {
-			continue;
-		}
+			// If this query ID should be skipped, then skip this entry.
+			// The function also updates seen_query_ids if not skipping this query ID
+			if ( should_skip_query_and_update( prm_read_and_process_mgr, target_id_str_ref, seen_query_ids ) ) {
+				continue;
+			}
 
-		const auto     query_field_itrs       = find_field_itrs( line_string, QUERY_FIELD_IDX,       1 + TARGET_FIELD_IDX,      target_field_itrs.second      );
-		const auto     query_id_str_ref       = make_string_view( query_field_itrs.first,  query_field_itrs.second  );
-
-		const auto     id_score_cat           = cath_score_category_of_id( query_id_str_ref, prm_apply_cath_policies );
-		const bool     apply_dc_cat           = ( id_score_cat == cath_id_score_category::DC_TYPE );
-
-		const size_t   start_field_idx        = apply_dc_cat ? ALI_START_RES_FIELD_IDX : ENV_START_RES_FIELD_IDX;
-		const size_t   stop_field_idx         = apply_dc_cat ? ALI_STOP_RES_FIELD_IDX  : ENV_STOP_RES_FIELD_IDX;
-
-		const auto     cond_evalue_field_itrs = find_field_itrs( line_string, COND_EVALUE_FIELD_IDX, 1 + QUERY_FIELD_IDX,       query_field_itrs.second       );
-		const auto     indp_evalue_field_itrs = find_field_itrs( line_string, INDP_EVALUE_FIELD_IDX, 1 + COND_EVALUE_FIELD_IDX, cond_evalue_field_itrs.second );
-		const auto     bitscore_field_itrs    = find_field_itrs( line_string, BITSCORE_FIELD_IDX,    1 + INDP_EVALUE_FIELD_IDX, indp_evalue_field_itrs.second );
-		const auto     start_res_field_itrs   = find_field_itrs( line_string, start_field_idx,       1 + BITSCORE_FIELD_IDX,    bitscore_field_itrs.second    );
-		const auto     stop_res_field_itrs    = find_field_itrs( line_string, stop_field_idx,        1 + start_field_idx,       start_res_field_itrs.second   );
-
-		const double   bitscore               = parse_double_from_field( bitscore_field_itrs.first,    bitscore_field_itrs.second    );
-		const residx_t start                  = parse_uint_from_field  ( start_res_field_itrs.first,   start_res_field_itrs.second   );
-		const residx_t stop                   = parse_uint_from_field  ( stop_res_field_itrs.first,    stop_res_field_itrs.second    );
-		const double   cond_evalue            = parse_double_from_field( cond_evalue_field_itrs.first, cond_evalue_field_itrs.second );
-		const double   indp_evalue            = parse_double_from_field( indp_evalue_field_itrs.first, indp_evalue_field_itrs.second );
-		const bool     evalues_are_susp       = hmmer_evalues_are_suspicious(
-			cond_evalue,
-			indp_evalue
-		);
-
-		if ( bitscore <= 0 ) {
-			if ( ! skipped_for_negtv_bitscore ) {
-				::spdlog::warn( R"(Skipping at least one hit (eg between "{}" and "{}" with bitscore {}) for having a negative bitscore, which )"
-				                "cannot currently be handled. It's typically not a problem to exclude such weak hits.",
-				                target_id_str_ref,
-				                query_id_str_ref,
-				                bitscore );
-				skipped_for_negtv_bitscore = true;
+			if ( the_record.parse_error ) {
+				::std::rethrow_exception( the_record.parse_error );
 			}
-			continue;
+
+			const string_view query_id_str_ref = text.substr( the_record.query_begin, the_record.query_end - the_record.query_begin );
+
+			if ( the_record.bitscore <= 0 ) {
+				if ( ! skipped_for_negtv_bitscore ) {
+					::spdlog::warn( R"(Skipping at least one hit (eg between "{}" and "{}" with bitscore {}) for having a negative bitscore, which )"
+					                "cannot currently be handled. It's typically not a problem to exclude such weak hits.",
+					                target_id_str_ref,
+					                query_id_str_ref,
+					                the_record.bitscore );
+					skipped_for_negtv_bitscore = true;
+				}
+				continue;
+			}
+
+			const bool evalues_are_susp = hmmer_evalues_are_suspicious(
+				the_record.cond_evalue,
+				the_record.indp_evalue
+			);
+
+			hit_extras_store extras_store;
+			extras_store.push_back< hit_extra_cat::COND_EVAL >( the_record.cond_evalue );
+			extras_store.push_back< hit_extra_cat::INDP_EVAL >( the_record.indp_evalue );
+
+			prm_read_and_process_mgr.add_hit(
+				target_id_str_ref,
+				{ { seq_seg{ arrow_before_res( the_record.start ), arrow_after_res ( the_record.stop  ) } } },
+				query_id_str_ref,
+				the_record.bitscore / bitscore_divisor( prm_apply_cath_policies, evalues_are_susp ),
+				hit_score_type::BITSCORE,
+				std::move( extras_store )
+			);
 		}
+	};
+
+	// Only start worker threads if more than one thread has been requested
+	::std::optional<ordered_task_pool<domain_hits_table_chunk>> parse_pool;
+	if ( num_threads_to_use( prm_num_threads ) > 1 ) {
+		parse_pool.emplace( prm_num_threads, 0 );
+	}
 
-		hit_extras_store extras_store;
-		extras_store.push_back< hit_extra_cat::COND_EVAL >( cond_evalue );
-		extras_store.push_back< hit_extra_cat::INDP_EVAL >( indp_evalue );
-
-		prm_read_and_process_mgr.add_hit(
-			target_id_str_ref,
-			{ { seq_seg{ arrow_before_res( start ), arrow_after_res ( stop  ) } } },
-			string{ query_field_itrs.first, query_field_itrs.second },
-			bitscore / bitscore_divisor( prm_apply_cath_policies, evalues_are_susp ),
-			hit_score_type::BITSCORE,
-			std::move( extras_store )
-		);
+	string carry;
+	while ( true ) {
+		string chunk_text = read_domain_hits_table_chunk( prm_input_stream, carry, prm_chunk_size );
+		if ( chunk_text.empty() ) {
+			break;
+		}
+		if ( parse_pool ) {
+			parse_pool->submit(
+				[ text = std::move( chunk_text ), prm_apply_cath_policies ] () mutable {
+					return parse_domain_hits_table_chunk( std::move( text ), prm_apply_cath_policies );
+				},
+				process_chunk_fn
+			);
+		}
+		else {
+			process_chunk_fn( parse_domain_hits_table_chunk( std::move( chunk_text ), prm_apply_cath_policies ) );
+		}
+	}
+	if ( parse_pool ) {
+		parse_pool->finish( process_chunk_fn );
 	}
 
 	prm_read_and_process_mgr.process_all_outstanding();
 }
+
+/// \brief Parse HMMER domain hits table data from the specified istream and return the hits for each query
+///
+/// \copydetails parse_domain_hits_table(read_and_process_mgr &, istream &, const bool &, const size_t &, const size_t &)
+str_calc_hit_list_pair_vec cath::rslv::parse_domain_hits_table(istream      &prm_input_stream,        ///< The istream from which the HMMER domain hits table data should be parsed
+                                                               const bool   &prm_apply_cath_policies, ///< Whether to apply CATH-specific policies
+                                                               const size_t &prm_num_threads,         ///< The number of threads with which to parse the data (or 0 to use the hardware concurrency)
+                                                               const size_t &prm_chunk_size           ///< The (approximate) number of bytes of data to parse in each chunk
+                                                               ) {
+	str_calc_hit_list_pair_vec results;
+	hits_processor_list hits_processors;
+	hits_processors.add_processor( gather_hits_processor{ results } );
+	read_and_process_mgr the_read_and_process_mgr{
+		hits_processors,
+		crh_filter_spec{}
+	};
+	parse_domain_hits_table(
+		the_read_and_process_mgr,
+		prm_input_stream,
+		prm_apply_cath_policies,
+		prm_num_threads,
+		prm_chunk_size
+	);
+	return results;
+}
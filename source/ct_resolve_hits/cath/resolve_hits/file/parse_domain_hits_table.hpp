@@ -21,7 +21,9 @@
 #ifndef CATH_TOOLS_SOURCE_CT_RESOLVE_HITS_CATH_RESOLVE_HITS_FILE_PARSE_DOMAIN_HITS_TABLE_HPP
 #define CATH_TOOLS_SOURCE_CT_RESOLVE_HITS_CATH_RESOLVE_HITS_FILE_PARSE_DOMAIN_HITS_TABLE_HPP
 
+#include <cstddef>
 #include <filesystem>
+#include <iosfwd>
 
 #include "cath/common/type_aliases.hpp"
 #include "cath/resolve_hits/file/cath_id_score_category.hpp"
@@ -59,13 +61,26 @@ namespace cath::rslv {
 	// 	return ratio * ratio * ratio;
 	// }
 
+	/// \brief The default number of bytes of HMMER domain hits table data to read in each chunk
+	///
+	/// Each chunk is extended to the end of its last line, so this is approximate
+	inline constexpr size_t DEFAULT_DOMAIN_HITS_TABLE_CHUNK_SIZE = 4 * 1024 * 1024;
+
 	void parse_domain_hits_table_file(read_and_process_mgr &,
 	                                  const ::std::filesystem::path &,
-	                                  const bool &);
+	                                  const bool &,
+	                                  const size_t &);
 
 	void parse_domain_hits_table(read_and_process_mgr &,
 	                             std::istream &,
-	                             const bool &);
+	                             const bool &,
+	                             const size_t &,
+	                             const size_t & = DEFAULT_DOMAIN_HITS_TABLE_CHUNK_SIZE);
+
+	str_calc_hit_list_pair_vec parse_domain_hits_table(std::istream &,
+	                                                   const bool &,
+	                                                   const size_t &,
+	                                                   const size_t & = DEFAULT_DOMAIN_HITS_TABLE_CHUNK_SIZE);
 
 } // namespace cath::rslv
 
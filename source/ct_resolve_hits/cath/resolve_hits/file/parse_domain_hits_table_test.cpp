@@ -0,0 +1,96 @@
+/// \file
+/// \brief The parse_domain_hits_table test suite
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "parse_domain_hits_table.hpp"
+
+#include <sstream>
+
+#include <boost/test/unit_test.hpp>
+
+#include "cath/common/exception/runtime_error_exception.hpp"
+#include "cath/common/file/read_string_from_file.hpp"
+#include "cath/common/size_t_literal.hpp"
+#include "cath/resolve_hits/calc_hit_list.hpp"
+#include "cath/test/global_test_constants.hpp"
+
+using namespace ::cath;
+using namespace ::cath::common;
+using namespace ::cath::rslv;
+
+using ::cath::common::literals::operator""_z;
+using ::std::istringstream;
+using ::std::string;
+
+namespace {
+
+	/// \brief The parse_domain_hits_table_test_suite_fixture to assist in testing parse_domain_hits_table
+	struct parse_domain_hits_table_test_suite_fixture : protected global_test_constants {
+	protected:
+		~parse_domain_hits_table_test_suite_fixture() noexcept = default;
+
+		/// \brief Whether to apply CATH-specific policies
+		static constexpr bool APPLY_CATH_POLICIES = false;
+
+		/// \brief Parse the specified domain hits table data with the specified number of threads and chunk size
+		///        and return a string describing the resulting hits
+		static string parse_to_string(const string &prm_data,        ///< The HMMER domain hits table data to parse
+		                              const size_t &prm_num_threads, ///< The number of threads with which to parse
+		                              const size_t &prm_chunk_size   ///< The number of bytes to parse in each chunk
+		                              ) {
+			istringstream input_ss{ prm_data };
+			string result;
+			for (const str_calc_hit_list_pair &query_hits : parse_domain_hits_table( input_ss, APPLY_CATH_POLICIES, prm_num_threads, prm_chunk_size ) ) {
+				result += query_hits.first + " : " + to_string( query_hits.second ) + "\n";
+			}
+			return result;
+		}
+	};
+
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE(parse_domain_hits_table_test_suite, parse_domain_hits_table_test_suite_fixture)
+
+BOOST_AUTO_TEST_CASE(parses_same_hits_whatever_the_chunk_size_and_number_of_threads) {
+	const string data     = read_string_from_file( CRH_EG_DOMTBL_IN_FILENAME() );
+	const string expected = parse_to_string( data, 1, DEFAULT_DOMAIN_HITS_TABLE_CHUNK_SIZE );
+	BOOST_REQUIRE( ! expected.empty() );
+	for (const size_t &num_threads : { 1_z, 3_z } ) {
+		for (const size_t &chunk_size : { 1_z, 97_z, 1000_z } ) {
+			BOOST_TEST_CONTEXT( "with " << num_threads << " thread(s) and chunks of " << chunk_size << " byte(s)" ) {
+				BOOST_CHECK_EQUAL( parse_to_string( data, num_threads, chunk_size ), expected );
+			}
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(skips_comment_and_blank_lines_and_handles_missing_final_newline) {
+	const string line_a = "443cb81e8e280e529de69ef113974208 -            895 4ev8A00_round_3      -            202   2.7e-13   59.1   0.2   1   2   1.1e-08   0.00051   28.8   0.1    35   159   137   283    35   325 0.77 -";
+	const string line_b = "5e1ccef4ef9782ffd2979ae49ca232c8 -            992 1ru4A00_round_3      -            223    0.0049   25.6   5.4   1   2   1.8e-06       8.9   15.0   2.4    76   219   577   843   572   844 0.51 -";
+	const string expected = parse_to_string( line_a + "\n" + line_b + "\n", 1, DEFAULT_DOMAIN_HITS_TABLE_CHUNK_SIZE );
+	BOOST_CHECK_EQUAL( parse_to_string( "# comment\n" + line_a + "\n\n# comment\n" + line_b, 1, DEFAULT_DOMAIN_HITS_TABLE_CHUNK_SIZE ), expected );
+	BOOST_CHECK_EQUAL( parse_to_string( "# comment\n" + line_a + "\n\n# comment\n" + line_b, 2, 5                                    ), expected );
+}
+
+BOOST_AUTO_TEST_CASE(throws_on_line_with_too_few_fields) {
+	BOOST_CHECK_THROW( parse_to_string( "target - 100 query -\n", 1, DEFAULT_DOMAIN_HITS_TABLE_CHUNK_SIZE ), runtime_error_exception );
+	BOOST_CHECK_THROW( parse_to_string( "target - 100 query -\n", 2, 4                                    ), runtime_error_exception );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
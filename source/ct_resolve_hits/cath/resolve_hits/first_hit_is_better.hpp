@@ -99,8 +99,8 @@ namespace cath::rslv {
 		/// Compare labels and then label indices
 		const hitidx_t    &idx_lhs   = prm_lhs.get_label_idx();
 		const hitidx_t    &idx_rhs   = prm_rhs.get_label_idx();
-		const std::string &label_lhs = prm_full_hits[ idx_lhs ].get_label();
-		const std::string &label_rhs = prm_full_hits[ idx_rhs ].get_label();
+		const ::std::string_view &label_lhs = prm_full_hits[ idx_lhs ].get_label();
+		const ::std::string_view &label_rhs = prm_full_hits[ idx_rhs ].get_label();
 		return ( std::tie( label_lhs, idx_lhs ) < std::tie( label_rhs, idx_rhs ) ) ? boost::logic::tribool{ true  } :
 		       ( std::tie( label_lhs, idx_lhs ) > std::tie( label_rhs, idx_rhs ) ) ? boost::logic::tribool{ false } :
 		                                                                             boost::logic::indeterminate;
@@ -172,8 +172,8 @@ namespace cath::rslv {
 		// Otherwise, both score and segments are equal so...
 
 		/// Compare labels and then label indices
-		const std::string &label_lhs = prm_lhs.get_label();
-		const std::string &label_rhs = prm_rhs.get_label();
+		const ::std::string_view &label_lhs = prm_lhs.get_label();
+		const ::std::string_view &label_rhs = prm_rhs.get_label();
 		return ( label_lhs < label_rhs ) ? boost::logic::tribool{ true  } :
 		       ( label_lhs > label_rhs ) ? boost::logic::tribool{ false } :
 		                                   boost::logic::indeterminate;
@@ -24,13 +24,16 @@
 #include <boost/operators.hpp>
 
 #include "cath/common/size_t_literal.hpp"
+#include "cath/common/string/string_intern_pool.hpp"
 #include "cath/resolve_hits/file/alnd_rgn.hpp"
 #include "cath/resolve_hits/hit_extras.hpp"
 #include "cath/resolve_hits/hit_score_type.hpp"
 #include "cath/resolve_hits/resolve_hits_type_aliases.hpp"
 #include "cath/seq/seq_seg.hpp"
 
+#include <memory>
 #include <string>
+#include <string_view>
 
 namespace cath::rslv {
 
@@ -48,8 +51,19 @@ namespace cath::rslv {
 		/// \brief The list of segments
 		seq::seq_seg_vec segments;
 
+		/// \brief The owner of the storage to which label refers
+		///
+		/// This is either the string_intern_pool in which the label was interned or the full_hit's own
+		/// copy of the label. It's shared by copies of the full_hit so that the label stays valid
+		/// wherever the full_hit is copied or moved.
+		::std::shared_ptr<const void> label_owner;
+
 		/// \brief The label for this full_hit
-		std::string label;
+		///
+		/// If the full_hit was constructed with a string_intern_pool, this refers to the label's copy
+		/// in that pool, so the many hits that share a label (eg the hits from the same HMMER model)
+		/// share a single copy of it
+		::std::string_view label;
 
 		/// \brief The score associated with this full_hit
 		///
@@ -66,13 +80,20 @@ namespace cath::rslv {
 
 	public:
 		full_hit(seq::seq_seg_vec,
-		         std::string,
+		         const ::std::string_view &,
+		         const double &,
+		         const hit_score_type & = hit_score_type::CRH_SCORE,
+		         hit_extras_store = {});
+
+		full_hit(const ::std::shared_ptr<common::string_intern_pool> &,
+		         seq::seq_seg_vec,
+		         const ::std::string_view &,
 		         const double &,
 		         const hit_score_type & = hit_score_type::CRH_SCORE,
 		         hit_extras_store = {});
 
 		[[nodiscard]] const seq::seq_seg_vec &get_segments() const;
-		[[nodiscard]] const std::string &     get_label() const;
+		[[nodiscard]] const ::std::string_view &get_label() const;
 		[[nodiscard]] const double &          get_score() const;
 		[[nodiscard]] const hit_score_type &  get_score_type() const;
 		[[nodiscard]] const hit_extras_store &get_extras_store() const;
@@ -102,7 +123,7 @@ namespace cath::rslv {
 			if ( score_type != hit_score_type::FULL_EVALUE || the_score < 0 ) {
 				BOOST_THROW_EXCEPTION(common::invalid_argument_exception(
 					"Hit with label "
-					+ get_label()
+					+ ::std::string( get_label() )
 					+ " cannot be processed because its "
 					+ to_string( get_score_type() )
 					+ " score of "
@@ -113,17 +134,36 @@ namespace cath::rslv {
 		}
 	}
 
-	/// \brief Ctor
-	inline full_hit::full_hit(seq::seq_seg_vec      prm_segments,     ///< The segments of the full_hit
-	                          std::string           prm_label,        ///< The label of the hits' match protein
-	                          const double         &prm_score,        ///< The score associated with the full_hit
-	                          const hit_score_type &prm_score_type,   ///< The type of score stored in this hit (eg evalue / bitscore / crh-score)
-	                          hit_extras_store      prm_extras_store  ///< The store of any extra pieces of information associated with the hit
-	                          ) : segments     { std::move( prm_segments     ) },
-	                              label        { std::move( prm_label        ) },
-	                              the_score    { prm_score                     },
-	                              score_type   { prm_score_type                },
-	                              extras_store { std::move( prm_extras_store ) } {
+	/// \brief Ctor that makes the full_hit's own copy of the label
+	inline full_hit::full_hit(seq::seq_seg_vec          prm_segments,     ///< The segments of the full_hit
+	                          const ::std::string_view &prm_label,        ///< The label of the hits' match protein
+	                          const double             &prm_score,        ///< The score associated with the full_hit
+	                          const hit_score_type     &prm_score_type,   ///< The type of score stored in this hit (eg evalue / bitscore / crh-score)
+	                          hit_extras_store          prm_extras_store  ///< The store of any extra pieces of information associated with the hit
+	                          ) : segments     { std::move( prm_segments     )                                       },
+	                              label_owner  { std::make_shared<const ::std::string>( prm_label )                },
+	                              label        { *std::static_pointer_cast<const ::std::string>( label_owner ) },
+	                              the_score    { prm_score                                                       },
+	                              score_type   { prm_score_type                                                  },
+	                              extras_store { std::move( prm_extras_store )                                   } {
+		sanity_check();
+	}
+
+	/// \brief Ctor that interns the label in the specified string_intern_pool
+	///
+	/// The full_hit shares ownership of the pool, so the label stays valid for as long as the full_hit
+	inline full_hit::full_hit(const ::std::shared_ptr<common::string_intern_pool> &prm_label_pool,   ///< The pool in which to intern the label
+	                          seq::seq_seg_vec                                     prm_segments,     ///< The segments of the full_hit
+	                          const ::std::string_view                            &prm_label,        ///< The label of the hits' match protein
+	                          const double                                        &prm_score,        ///< The score associated with the full_hit
+	                          const hit_score_type                                &prm_score_type,   ///< The type of score stored in this hit (eg evalue / bitscore / crh-score)
+	                          hit_extras_store                                     prm_extras_store  ///< The store of any extra pieces of information associated with the hit
+	                          ) : segments     { std::move( prm_segments     )       },
+	                              label_owner  { prm_label_pool                      },
+	                              label        { prm_label_pool->intern( prm_label ) },
+	                              the_score    { prm_score                           },
+	                              score_type   { prm_score_type                      },
+	                              extras_store { std::move( prm_extras_store )       } {
 		sanity_check();
 	}
 
@@ -133,7 +173,7 @@ namespace cath::rslv {
 	}
 	
 	/// \brief Getter for the label of the hits' match protein
-	inline const std::string & full_hit::get_label() const {
+	inline const ::std::string_view & full_hit::get_label() const {
 		return label;
 	}
 
@@ -125,7 +125,7 @@ string cath::rslv::to_string(const full_hit             &prm_full_hit,         /
 			const doub_opt indp_eval_val_opt = get_first< hit_extra_cat::INDP_EVAL >( prm_full_hit.get_extras_store() );
 			return prm_prefix
 				+ ( prm_prefix.empty() ? ""s : " "s )
-				+ prm_full_hit.get_label()
+				+ string( prm_full_hit.get_label() )
 				+ " "
 				+ get_score_string( prm_full_hit, 6 )
 				+ " "
@@ -145,7 +145,7 @@ string cath::rslv::to_string(const full_hit             &prm_full_hit,         /
 				+ "; score: "
 				+ get_score_string( prm_full_hit, 6 )
 				+ "; label: \""
-				+ prm_full_hit.get_label()
+				+ string( prm_full_hit.get_label() )
 				+ "\"]";
 		}
 	}
@@ -18,9 +18,13 @@
 /// You should have received a copy of the GNU General Public License
 /// along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
+#include <memory>
+#include <string>
+
 #include <boost/test/unit_test.hpp>
 
 #include "cath/common/rapidjson_addenda/to_rapidjson_string.hpp"
+#include "cath/common/string/string_intern_pool.hpp"
 #include "cath/resolve_hits/full_hit.hpp"
 #include "cath/resolve_hits/full_hit_rapidjson.hpp"
 
@@ -60,6 +64,32 @@ BOOST_AUTO_TEST_CASE(basic_2) {
 	BOOST_CHECK_EQUAL( to_string( eg_full_hit_b ), R"(full_hit[1272-1320,1398-1437; score: 1; label: "pangolin"])" );
 }
 
+BOOST_AUTO_TEST_CASE(hits_with_the_same_label_share_one_interned_copy) {
+	const auto label_pool = std::make_shared<string_intern_pool>();
+	std::string label{ "pangolin" };
+	const full_hit pooled_full_hit_a{ label_pool, { seq_seg{ 1, 2 } }, label, 2.0 };
+	const full_hit pooled_full_hit_b{ label_pool, { seq_seg{ 3, 4 } }, label, 3.0 };
+	label.assign( label.size(), 'x' );
+	BOOST_CHECK_EQUAL( pooled_full_hit_a.get_label(), "pangolin" );
+	BOOST_CHECK_EQUAL( label_pool->size(), 1 );
+	BOOST_CHECK( static_cast<const void *>( pooled_full_hit_a.get_label().data() ) == static_cast<const void *>( pooled_full_hit_b.get_label().data() ) );
+}
+
+BOOST_AUTO_TEST_CASE(labels_outlive_everything_but_the_hits) {
+	std::string label{ "lemur" };
+	auto label_pool = std::make_shared<string_intern_pool>();
+	const full_hit pooled_full_hit{ label_pool, { seq_seg{ 1, 2 } }, label, 2.0 };
+	const full_hit owning_full_hit{             { seq_seg{ 1, 2 } }, label, 2.0 };
+	label_pool.reset();
+	label.assign( label.size(), 'x' );
+
+	const full_hit copied_pooled_full_hit = pooled_full_hit;
+	BOOST_CHECK_EQUAL( pooled_full_hit.get_label(),        "lemur" );
+	BOOST_CHECK_EQUAL( owning_full_hit.get_label(),        "lemur" );
+	BOOST_CHECK_EQUAL( copied_pooled_full_hit.get_label(), "lemur" );
+	BOOST_CHECK( pooled_full_hit == owning_full_hit );
+}
+
 BOOST_AUTO_TEST_SUITE(json)
 
 BOOST_AUTO_TEST_CASE(get_max_stop_works) {
@@ -20,123 +20,122 @@
 
 #include "html_segment.hpp"
 
-#include <boost/algorithm/string/join.hpp>
-#include <boost/algorithm/string/predicate.hpp>
-#include <boost/range/adaptor/transformed.hpp>
+#include <boost/numeric/conversion/cast.hpp>
+
+#include <fmt/format.h>
 
 #include "cath/common/debug_numeric_cast.hpp"
 #include "cath/common/exception/invalid_argument_exception.hpp"
-
-#include <string>
+#include "cath/common/file/buffered_ostream_sink.hpp"
 
 using namespace ::cath;
 using namespace ::cath::common;
 using namespace ::cath::rslv;
 using namespace ::cath::seq;
 
-using ::boost::adaptors::transformed;
-using ::boost::algorithm::join;
-using ::boost::algorithm::starts_with;
-using ::std::literals::string_literals::operator""s;
+using ::boost::numeric_cast;
 using ::std::nullopt;
-using ::std::string;
+using ::std::string_view;
+
+/// \brief Write the hex string of the specified colour (eg "ff8000") to the specified buffered_ostream_sink
+///
+/// This matches hex_string_of_colour() without building a temporary string
+static void write_hex_of_colour(buffered_ostream_sink &prm_sink,  ///< The buffered_ostream_sink to which the hex string should be written
+                                const display_colour  &prm_colour ///< The colour to write
+                                ) {
+	::fmt::format_to(
+		prm_sink.out(),
+		"{:02x}{:02x}{:02x}",
+		numeric_cast<size_t>( 255 * prm_colour.get_r() ),
+		numeric_cast<size_t>( 255 * prm_colour.get_g() ),
+		numeric_cast<size_t>( 255 * prm_colour.get_b() )
+	);
+}
 
-/// \brief Get an HTML span string to represent some aspect of a segment
-string html_segment::get_html_string(const seq_arrow          &prm_start,           ///< The start of the segment to render
-                                     const res_arrow_opt      &prm_stop,            ///< The stop of the segment to render (or nullopt for a boundary)
-                                     const string             &prm_css_class,       ///< The CSS classes with which the HTML span should be marked
-                                     const str_str_pair_vec   &prm_data_key_values, ///< A set of key/value pairs to be inserted as data attributes in the span (keys are prefixed with "data-" if not already)
-                                     const display_colour_opt &prm_border_colour,   ///< The colour with which the border should be rendered
-                                     const display_colour     &prm_fill_colour,     ///< The colour with which to fill the pill
-                                     const size_t             &prm_full_seq_length, ///< The length of the full sequence on which this hit appears
-                                     const pill_rounding      &prm_pill_rounding    ///< Which side of the pill (or neither/both) should be rounded
-                                     ) {
+/// \brief Write an HTML span to represent some aspect of a segment to the specified buffered_ostream_sink
+void html_segment::write_html(buffered_ostream_sink    &prm_sink,            ///< The buffered_ostream_sink to which the HTML should be written
+                              const seq_arrow          &prm_start,           ///< The start of the segment to render
+                              const res_arrow_opt      &prm_stop,            ///< The stop of the segment to render (or nullopt for a boundary)
+                              const string_view        &prm_css_class,       ///< The CSS classes with which the HTML span should be marked
+                              const string_view        &prm_data_attributes, ///< The pre-rendered data attributes to be inserted in the span
+                              const display_colour_opt &prm_border_colour,   ///< The colour with which the border should be rendered
+                              const display_colour     &prm_fill_colour,     ///< The colour with which to fill the pill
+                              const size_t             &prm_full_seq_length, ///< The length of the full sequence on which this hit appears
+                              const pill_rounding      &prm_pill_rounding    ///< Which side of the pill (or neither/both) should be rounded
+                              ) {
 	const double length_mult = 100.0 / debug_numeric_cast<double>( prm_full_seq_length );
-	return R"(<span class=")"
-		+ prm_css_class
-		+ R"(" )"
-		+ join(
-			prm_data_key_values
-				| transformed( [] (const str_str_pair &x) {
-					return
-						( starts_with( x.first, "data-" ) ? ""s : "data-" )
-						+ x.first  + R"(=")"
-						+ x.second + R"(")";
-				} ),
-			" "
-		)
-		+ R"( style="background-color: #)"
-		+ hex_string_of_colour( prm_fill_colour )
-		+ ";" 
-		+ (
-			prm_border_colour
-			? ( " border-color: #" + hex_string_of_colour( *prm_border_colour ) + ";" )
-			: ""s
-		)
-		+ " left: "
-		+ ::std::to_string( length_mult * debug_numeric_cast<double>( prm_start.res_after() - 1 ) )
-		+ R"(%;)"
-		+ (
-			prm_stop
-				? " width: "
-					+ ::std::to_string( length_mult * debug_numeric_cast<double>( *prm_stop - prm_start ) )
-					+ R"(%;)"
-				: ""s
-		)
-		+ (
-			( prm_pill_rounding == pill_rounding::NEITHER || prm_pill_rounding == pill_rounding::RIGHT_ONLY )
-			? " border-top-left-radius: 0; border-bottom-left-radius: 0;"s
-			: ""s
-		)
-		+ (
-			( prm_pill_rounding == pill_rounding::NEITHER || prm_pill_rounding == pill_rounding::LEFT_ONLY )
-			? " border-top-right-radius: 0; border-bottom-right-radius: 0;"s
-			: ""s
-		)
-		+ R"("></span>)";
+	prm_sink.append( R"(<span class=")" )
+		.append( prm_css_class )
+		.append( R"(" )" )
+		.append( prm_data_attributes )
+		.append( R"( style="background-color: #)" );
+	write_hex_of_colour( prm_sink, prm_fill_colour );
+	prm_sink.put( ';' );
+	if ( prm_border_colour ) {
+		prm_sink.append( " border-color: #" );
+		write_hex_of_colour( prm_sink, *prm_border_colour );
+		prm_sink.put( ';' );
+	}
+	::fmt::format_to( prm_sink.out(), " left: {:f}%;", length_mult * debug_numeric_cast<double>( prm_start.res_after() - 1 ) );
+	if ( prm_stop ) {
+		::fmt::format_to( prm_sink.out(), " width: {:f}%;", length_mult * debug_numeric_cast<double>( *prm_stop - prm_start ) );
+	}
+	if ( prm_pill_rounding == pill_rounding::NEITHER || prm_pill_rounding == pill_rounding::RIGHT_ONLY ) {
+		prm_sink.append( " border-top-left-radius: 0; border-bottom-left-radius: 0;" );
+	}
+	if ( prm_pill_rounding == pill_rounding::NEITHER || prm_pill_rounding == pill_rounding::LEFT_ONLY ) {
+		prm_sink.append( " border-top-right-radius: 0; border-bottom-right-radius: 0;" );
+	}
+	prm_sink.append( R"("></span>)" );
 }
 
-/// \brief Get a resolved boundary HTML string
-string html_segment::get_resolve_boundary_html_string(const seq_arrow      &prm_point,          ///< The location of the arrow
-                                                      const display_colour &prm_colour,         ///< The colour in which this boundary should be rendered
-                                                      const size_t         &prm_full_seq_length ///< The length of the full sequence on which this hit appears
-                                                      ) {
-	return get_html_string(
+/// \brief Write a resolved boundary HTML span to the specified buffered_ostream_sink
+void html_segment::write_resolve_boundary_html(buffered_ostream_sink &prm_sink,           ///< The buffered_ostream_sink to which the HTML should be written
+                                               const seq_arrow       &prm_point,          ///< The location of the arrow
+                                               const display_colour  &prm_colour,         ///< The colour in which this boundary should be rendered
+                                               const size_t          &prm_full_seq_length ///< The length of the full sequence on which this hit appears
+                                               ) {
+	write_html(
+		prm_sink,
 		prm_point,
 		nullopt,
 		"crh-hit-boundary",
-		{},
+		"",
 		BLACK,
 		darken_by_fraction( prm_colour, 0.60 ),
 		prm_full_seq_length
 	);
 }
 
-/// \brief Get a grey back pill HTML string
+/// \brief Write a grey back pill HTML span to the specified buffered_ostream_sink
 ///
 /// This appears underneath the hit and shows the full extent of the hit
 /// in cases of parts missing from results with overlapping hits
-string html_segment::get_grey_back_html_string() const {
-	return get_html_string(
+void html_segment::write_grey_back_html(buffered_ostream_sink &prm_sink ///< The buffered_ostream_sink to which the HTML should be written
+                                        ) const {
+	write_html(
+		prm_sink,
 		start,
 		stop,
 		"crh-hit-pill-tail",
-		data_key_values,
+		data_attributes,
 		nullopt,
 		WHITE,
 		full_seq_length
 	);
 }
 
-/// \brief Get a lightened back pill HTML string
+/// \brief Write a lightened back pill HTML span to the specified buffered_ostream_sink
 ///
 /// This is used to show the region of the full segment, before trimming
-string html_segment::get_lightened_back_html_string() const {
-	return get_html_string(
+void html_segment::write_lightened_back_html(buffered_ostream_sink &prm_sink ///< The buffered_ostream_sink to which the HTML should be written
+                                             ) const {
+	write_html(
+		prm_sink,
 		resolved_start.value_or( start ),
 		resolved_stop .value_or( stop  ),
 		"crh-hit-pill-ends",
-		data_key_values,
+		data_attributes,
 		darken_by_fraction ( colour, 0.60 ),
 		lighten_by_fraction( colour, 0.75 ),
 		full_seq_length,
@@ -146,13 +145,15 @@ string html_segment::get_lightened_back_html_string() const {
 	);
 }
 
-/// \brief Get a strong front pill HTML string for use in a full result
-string html_segment::get_full_result_html_string() const {
-	return get_html_string(
+/// \brief Write a strong front pill HTML span for use in a full result to the specified buffered_ostream_sink
+void html_segment::write_full_result_html(buffered_ostream_sink &prm_sink ///< The buffered_ostream_sink to which the HTML should be written
+                                          ) const {
+	write_html(
+		prm_sink,
 		resolved_start.value_or( start ),
 		resolved_stop .value_or( stop  ),
 		"crh-hit-pill-core",
-		data_key_values,
+		data_attributes,
 		darken_by_fraction ( colour, 0.60 ),
 		colour,
 		full_seq_length,
@@ -162,45 +163,63 @@ string html_segment::get_full_result_html_string() const {
 	);
 }
 
-/// \brief Get a strong front pill HTML string
+/// \brief Write a strong front pill HTML span to the specified buffered_ostream_sink
 ///
 /// This is used to show the region of the trimmed segment
-string html_segment::get_strong_front_html_string() const {
+void html_segment::write_strong_front_html(buffered_ostream_sink &prm_sink ///< The buffered_ostream_sink to which the HTML should be written
+                                           ) const {
 	if ( ! trimmed_start || ! trimmed_stop ) {
 		BOOST_THROW_EXCEPTION(invalid_argument_exception("Cannot render strong front of segment in HTML if there is no trimmed start/stop"));
 	}
-	return get_html_string(
+	write_html(
+		prm_sink,
 		*trimmed_start,
 		*trimmed_stop,
 		"crh-hit-pill-core",
-		data_key_values,
+		data_attributes,
 		darken_by_fraction ( colour, 0.60 ),
 		colour,
 		full_seq_length
 	);
 }
 
-/// \brief Get the list of HTML span strings to represent this segment
-str_vec html_segment::get_all_span_html_strs(const bool &prm_do_layers ///< Whether render multiple layers or a single layer as in a full result
-                                             ) const {
+/// \brief Write the HTML spans to represent this segment to the specified buffered_ostream_sink,
+///        each on its own line, indented by two tabs
+void html_segment::write_all_span_html(buffered_ostream_sink &prm_sink,     ///< The buffered_ostream_sink to which the HTML should be written
+                                       const bool            &prm_do_layers ///< Whether render multiple layers or a single layer as in a full result
+                                       ) const {
 	if ( ! prm_do_layers ) {
-		return { get_full_result_html_string() };
+		prm_sink.append( "\t\t" );
+		write_full_result_html( prm_sink );
+		prm_sink.put( '\n' );
+		return;
 	}
 	if ( ! trimmed_start || ! trimmed_stop ) {
 		if ( resolved_start || resolved_stop ) {
 			BOOST_THROW_EXCEPTION(invalid_argument_exception("A segment for HTML rendering shouldn't have result-resolved-boundaries if it hasn't got a trimmed core"));
 		}
-		return { get_lightened_back_html_string() };
+		prm_sink.append( "\t\t" );
+		write_lightened_back_html( prm_sink );
+		prm_sink.put( '\n' );
+		return;
 	}
-	str_vec span_strs;
-	span_strs.push_back( get_grey_back_html_string     () );
+	prm_sink.append( "\t\t" );
+	write_grey_back_html( prm_sink );
+	prm_sink.put( '\n' );
 	if ( resolved_start ) {
-		span_strs.push_back( get_resolve_boundary_html_string( *resolved_start, colour, full_seq_length ) );
+		prm_sink.append( "\t\t" );
+		write_resolve_boundary_html( prm_sink, *resolved_start, colour, full_seq_length );
+		prm_sink.put( '\n' );
 	}
 	if ( resolved_stop ) {
-		span_strs.push_back( get_resolve_boundary_html_string( *resolved_stop,  colour, full_seq_length ) );
+		prm_sink.append( "\t\t" );
+		write_resolve_boundary_html( prm_sink, *resolved_stop,  colour, full_seq_length );
+		prm_sink.put( '\n' );
 	}
-	span_strs.push_back( get_lightened_back_html_string() );
-	span_strs.push_back( get_strong_front_html_string  () );
-	return span_strs;
+	prm_sink.append( "\t\t" );
+	write_lightened_back_html( prm_sink );
+	prm_sink.put( '\n' );
+	prm_sink.append( "\t\t" );
+	write_strong_front_html( prm_sink );
+	prm_sink.put( '\n' );
 }
@@ -21,10 +21,16 @@
 #ifndef CATH_TOOLS_SOURCE_CT_RESOLVE_HITS_CATH_RESOLVE_HITS_HTML_OUTPUT_HTML_SEGMENT_HPP
 #define CATH_TOOLS_SOURCE_CT_RESOLVE_HITS_CATH_RESOLVE_HITS_HTML_OUTPUT_HTML_SEGMENT_HPP
 
+#include <string_view>
+
 #include "cath/display_colour/display_colour.hpp"
 #include "cath/display_colour/display_colour_type_aliases.hpp"
 #include "cath/seq/seq_arrow.hpp"
 
+// clang-format off
+namespace cath::common { class buffered_ostream_sink; }
+// clang-format on
+
 namespace cath::rslv {
 
 	/// \brief Represent a segment to be rendered in HTML
@@ -39,18 +45,20 @@ namespace cath::rslv {
 			BOTH        ///< Round the pill on both sides
 		};
 
-		static std::string get_html_string(const seq::seq_arrow &,
-		                                   const seq::res_arrow_opt &,
-		                                   const std::string &,
-		                                   const str_str_pair_vec &,
-		                                   const display_colour_opt &,
-		                                   const display_colour &,
-		                                   const size_t &,
-		                                   const pill_rounding & = pill_rounding::BOTH);
-
-		static std::string get_resolve_boundary_html_string(const seq::seq_arrow &,
-		                                                    const display_colour &,
-		                                                    const size_t &);
+		static void write_html(common::buffered_ostream_sink &,
+		                       const seq::seq_arrow &,
+		                       const seq::res_arrow_opt &,
+		                       const std::string_view &,
+		                       const std::string_view &,
+		                       const display_colour_opt &,
+		                       const display_colour &,
+		                       const size_t &,
+		                       const pill_rounding & = pill_rounding::BOTH);
+
+		static void write_resolve_boundary_html(common::buffered_ostream_sink &,
+		                                        const seq::seq_arrow &,
+		                                        const display_colour &,
+		                                        const size_t &);
 
 	public:
 		/// \brief The position of the segment's start
@@ -80,18 +88,21 @@ namespace cath::rslv {
 		/// \brief The colour in which the hit should be rendered
 		display_colour colour;
 
-		/// \brief A set of key/value pairs to be inserted as data attributes in the span (keys are prefixed with "data-" if not already)
-		str_str_pair_vec data_key_values;
+		/// \brief The pre-rendered data attributes to be inserted in the span (eg `data-crh-seg-num="1" data-crh-seg-boundaries="4-92"`)
+		///
+		/// This refers to text owned by the caller, which must outlive any use of this html_segment
+		std::string_view data_attributes;
 
 		/// \brief The full length of the sequence on which this hit appears
 		size_t full_seq_length;
 
-		[[nodiscard]] std::string get_grey_back_html_string() const;
-		[[nodiscard]] std::string get_lightened_back_html_string() const;
-		[[nodiscard]] std::string get_full_result_html_string() const;
-		[[nodiscard]] std::string get_strong_front_html_string() const;
+		void write_grey_back_html(common::buffered_ostream_sink &) const;
+		void write_lightened_back_html(common::buffered_ostream_sink &) const;
+		void write_full_result_html(common::buffered_ostream_sink &) const;
+		void write_strong_front_html(common::buffered_ostream_sink &) const;
 
-		[[nodiscard]] str_vec get_all_span_html_strs( const bool & = true ) const;
+		void write_all_span_html(common::buffered_ostream_sink &,
+		                         const bool & = true) const;
 	};
 
 } // namespace cath::rslv
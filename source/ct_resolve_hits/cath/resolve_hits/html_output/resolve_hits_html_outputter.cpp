@@ -21,21 +21,21 @@
 #include "resolve_hits_html_outputter.hpp"
 
 #include <optional>
+#include <sstream>
 #include <string>
+#include <string_view>
 
 #include <boost/algorithm/cxx11/any_of.hpp>
 #include <boost/algorithm/string/case_conv.hpp>
-#include <boost/algorithm/string/join.hpp>
-#include <boost/algorithm/string/replace.hpp>
-#include <boost/format.hpp>
-#include <boost/range/adaptor/filtered.hpp>
-#include <boost/range/adaptor/transformed.hpp>
 #include <boost/range/irange.hpp>
 
+#include <fmt/format.h>
+
 #include "cath/common/algorithm/sort_uniq_build.hpp"
 #include "cath/common/boost_addenda/range/front.hpp"
 #include "cath/common/boost_addenda/range/indices.hpp"
 #include "cath/common/debug_numeric_cast.hpp"
+#include "cath/common/file/buffered_ostream_sink.hpp"
 #include "cath/display_colour/display_colour_gradient.hpp"
 #include "cath/resolve_hits/calc_hit_list.hpp"
 #include "cath/resolve_hits/full_hit_fns.hpp"
@@ -44,6 +44,7 @@
 #include "cath/resolve_hits/html_output/html_hit.hpp"
 #include "cath/resolve_hits/html_output/html_segment.hpp"
 #include "cath/resolve_hits/options/options_block/crh_html_options_block.hpp"
+#include "cath/resolve_hits/options/options_block/crh_score_options_block.hpp"
 #include "cath/resolve_hits/options/spec/crh_segment_spec.hpp"
 #include "cath/resolve_hits/resolve/hit_resolver.hpp"
 #include "cath/resolve_hits/scored_hit_arch.hpp"
@@ -54,20 +55,16 @@ using namespace ::cath::common;
 using namespace ::cath::rslv;
 using namespace ::cath::seq;
 
-using ::boost::adaptors::filtered;
-using ::boost::adaptors::transformed;
 using ::boost::algorithm::any_of;
-using ::boost::algorithm::join;
-using ::boost::algorithm::replace_all;
 using ::boost::algorithm::to_lower_copy;
 using ::boost::algorithm::to_upper_copy;
-using ::boost::format;
 using ::boost::irange;
 using ::std::literals::string_literals::operator""s;
 using ::std::make_optional;
-using ::std::make_pair;
 using ::std::nullopt;
+using ::std::ostringstream;
 using ::std::string;
+using ::std::string_view;
 using ::std::tie;
 
 static string upper_first_lower_rest(const string &prm_string
@@ -83,21 +80,20 @@ static string upper_first_lower_rest(const string &prm_string
 		);
 }
 
-/// \brief Perform a dumb HTML escaping on the specified string
-static void dumb_html_escape(string &prm_string ///< The string to escape
-                             ) {
-	replace_all( prm_string, R"(&)", "&amp;"  );
-	replace_all( prm_string, R"(")", "&quot;" );
-	replace_all( prm_string, R"(')", "&apos;" );
-	replace_all( prm_string, R"(<)", "&lt;"   );
-	replace_all( prm_string, R"(>)", "&gt;"   );
-}
-
-/// \brief Perform a dumb HTML escaping on a copy of the specified string
-static string dumb_html_escape_copy(string prm_string ///< The source string to copy
+/// \brief Write a dumb HTML escaping of the specified string to the specified buffered_ostream_sink
+static void write_dumb_html_escaped(buffered_ostream_sink &prm_sink,  ///< The buffered_ostream_sink to which the escaped string should be written
+                                    const string_view     &prm_string ///< The string to escape
                                     ) {
-	dumb_html_escape( prm_string );
-	return prm_string;
+	for (const char &the_char : prm_string) {
+		switch ( the_char ) {
+			case ( '&' )  : { prm_sink.append( "&amp;"  ); break; }
+			case ( '"' )  : { prm_sink.append( "&quot;" ); break; }
+			case ( '\'' ) : { prm_sink.append( "&apos;" ); break; }
+			case ( '<' )  : { prm_sink.append( "&lt;"   ); break; }
+			case ( '>' )  : { prm_sink.append( "&gt;"   ); break; }
+			default       : { prm_sink.put   ( the_char ); break; }
+		}
+	}
 }
 
 /// \brief Get the row CSS class of the specified hit_row_context
@@ -124,64 +120,83 @@ string cath::rslv::first_cell_css_class_of_hit_row_context(const hit_row_context
 		: "crh-cell-first-norm"s;
 }
 
-/// \brief Generate the HTML string for the total-score row of the table
-string resolve_hits_html_outputter::total_score_row(const resscr_t &prm_total_score ///< The total score
-                                                    ) {
-	return R"(<tr class="crh-row-result">
+/// \brief Write the simple string describing the specified seq_seg_opt (as to_simple_string() generates)
+///        to the specified output iterator
+template <typename OutputIt>
+static OutputIt format_simple_string_to(OutputIt           prm_out,         ///< The output iterator to which the string should be written
+                                        const seq_seg_opt &prm_seq_seg_opt  ///< The seq_seg_opt to describe
+                                        ) {
+	return prm_seq_seg_opt
+		? ::fmt::format_to( prm_out, "{}-{}", get_start_res_index( *prm_seq_seg_opt ), get_stop_res_index( *prm_seq_seg_opt ) )
+		: ::fmt::format_to( prm_out, "absent" );
+}
+
+/// \brief Write the HTML for the total-score row of the table to the specified buffered_ostream_sink
+void resolve_hits_html_outputter::write_total_score_row(buffered_ostream_sink &prm_sink,       ///< The buffered_ostream_sink to which the HTML should be written
+                                                        const resscr_t        &prm_total_score ///< The total score
+                                                        ) {
+	::fmt::format_to(
+		prm_sink.out(),
+		R"(<tr class="crh-row-result">
 	<td class="crh-cell crh-cell-data crh-cell-first-norm"></td>
 	<td class="crh-cell crh-cell-data"></td>
-	<td class="crh-cell crh-cell-data"><strong>= )"
-	+ ( format("%.4g") % prm_total_score ).str()
-	+ R"(</strong></td>
+	<td class="crh-cell crh-cell-data"><strong>= {:.4g}</strong></td>
 	<td class="crh-cell crh-cell-data"></td>
 	<td class="crh-cell crh-cell-data"></td>
 	<td class="crh-cell crh-cell-data"></td>
-</tr>)";
+</tr>)",
+		prm_total_score
+	);
 }
 
-/// \brief Generate the HTML string for the markers row (ie the residue numbers)
-string resolve_hits_html_outputter::markers_row(const size_t          &prm_sequence_length,  ///< The length of the full sequence on which this full_hit appears
-                                                const str_opt         &prm_score_header_lbl, ///< The string for the score header or nullopt if headers shouldn't be used
-                                                const table_section   &prm_table_section     ///< TODOCUMENT
-                                                ) {
+/// \brief Write the HTML for the markers row (ie the residue numbers) to the specified buffered_ostream_sink
+void resolve_hits_html_outputter::write_markers_row(buffered_ostream_sink &prm_sink,             ///< The buffered_ostream_sink to which the HTML should be written
+                                                    const size_t          &prm_sequence_length,  ///< The length of the full sequence on which this full_hit appears
+                                                    const str_opt         &prm_score_header_lbl, ///< The string for the score header or nullopt if headers shouldn't be used
+                                                    const table_section   &prm_table_section     ///< TODOCUMENT
+                                                    ) {
 	const double length_mult  = 100.0 / debug_numeric_cast<double>( prm_sequence_length );
-	return R"(<tr class="crh-row-colhead" data-crh-row-colhead-type=")"
-	+ ( prm_table_section == table_section::INPUTS ? "inputs"s : "results"s )
-	+ R"(">
-	<td class="crh-cell crh-cell-first-norm">)" + ( prm_score_header_lbl ? "ID"s : ""s ) + R"(</td>
+	::fmt::format_to(
+		prm_sink.out(),
+		R"(<tr class="crh-row-colhead" data-crh-row-colhead-type="{}">
+	<td class="crh-cell crh-cell-first-norm">{}</td>
 	<td class="crh-cell crh-cell-colhead-figure">
 		<div class="crh-figure-div-empty">
-)"
-	+ join(
-		irange( 0_z, prm_sequence_length + 1, step_for_length( prm_sequence_length ) )
-			| transformed( [&] (const size_t &x) {
-				const auto left_str = ::std::to_string( length_mult * debug_numeric_cast<double>( x ) );
-				// 10000000 8 digits -> -20px;
-				//        0 1 digit  ->  -2px;
-				// ( 4 - 18 x  ) / 7
-				const int num_digits            = debug_numeric_cast<int>( ::std::to_string( x ).length() );
-				const string margin_left_px_str = ::std::to_string( ( 4 - ( 18 * num_digits ) ) / 7 );
-
-				return R"(		<span class="crh-figure-marker-num" style="left: )"
-					+ left_str
-					+ R"(%; margin-left: )"
-					+ margin_left_px_str
-					+ R"(px;">)"
-					+ ::std::to_string( x )
-					+ R"(</span>
-		<span class="crh-figure-marker-tick" style="left: )"
-					+ left_str
-					+ R"(%;"></span>)" + "\n";
-			} ),
-		""
-	)
-	+ R"(		</div>
+)",
+		( prm_table_section == table_section::INPUTS ? "inputs" : "results" ),
+		( prm_score_header_lbl ? "ID" : "" )
+	);
+	for (const size_t &x : irange( 0_z, prm_sequence_length + 1, step_for_length( prm_sequence_length ) ) ) {
+		const double left_pc = length_mult * debug_numeric_cast<double>( x );
+		// 10000000 8 digits -> -20px;
+		//        0 1 digit  ->  -2px;
+		// ( 4 - 18 x  ) / 7
+		const int num_digits     = debug_numeric_cast<int>( ::fmt::formatted_size( "{}", x ) );
+		const int margin_left_px = ( 4 - ( 18 * num_digits ) ) / 7;
+		::fmt::format_to(
+			prm_sink.out(),
+			R"(		<span class="crh-figure-marker-num" style="left: {0:f}%; margin-left: {1}px;">{2}</span>
+		<span class="crh-figure-marker-tick" style="left: {0:f}%;"></span>
+)",
+			left_pc,
+			margin_left_px,
+			x
+		);
+	}
+	::fmt::format_to(
+		prm_sink.out(),
+		R"(		</div>
 	</td>
-	<td class="crh-cell">)" + ( prm_score_header_lbl ? "Calc Score"s : ""s )   + R"(</td>
-	<td class="crh-cell">)" + ( prm_score_header_lbl.value_or(         ""s ) ) + R"(</td>
-	<td class="crh-cell">)" + ( prm_score_header_lbl ? "Regions"s    : ""s )   + R"(</td>
-	<td class="crh-cell">)" + ( prm_score_header_lbl ? "Length"s     : ""s )   + R"(</td>
-</tr>)";
+	<td class="crh-cell">{}</td>
+	<td class="crh-cell">{}</td>
+	<td class="crh-cell">{}</td>
+	<td class="crh-cell">{}</td>
+</tr>)",
+		( prm_score_header_lbl ? "Calc Score" : "" ),
+		( prm_score_header_lbl ? string_view{ *prm_score_header_lbl } : string_view{} ),
+		( prm_score_header_lbl ? "Regions" : "" ),
+		( prm_score_header_lbl ? "Length" : "" )
+	);
 }
 
 /// \brief Merge the original segment boundaries with an optional set of resolved
@@ -198,169 +213,190 @@ static seq_seg_opt_vec merge_opt_resolved_boundaries(const seq_seg_vec
 		);
 }
 
-/// \brief Generate a HTML to describe the specified full_hit
-string resolve_hits_html_outputter::hit_html(const html_hit         &prm_html_hit,        ///< The hit to render in HTML
-                                             const crh_segment_spec &prm_segment_spec,    ///< The crh_segment_spec defining how the segments will be handled (eg trimmed) by the algorithm
-                                             const size_t           &prm_sequence_length, ///< The length of the full sequence on which this full_hit appears
-                                             const hit_row_context  &prm_row_context      ///< The context of the hits
-                                             ) {
+/// \brief Write the HTML to describe the specified full_hit to the specified buffered_ostream_sink
+///
+/// The data attributes common to all the hit's segments are rendered once into a buffer
+/// and then each segment's attributes are appended to a copy of them in turn
+void resolve_hits_html_outputter::write_hit_html(buffered_ostream_sink  &prm_sink,            ///< The buffered_ostream_sink to which the HTML should be written
+                                                 const html_hit         &prm_html_hit,        ///< The hit to render in HTML
+                                                 const crh_segment_spec &prm_segment_spec,    ///< The crh_segment_spec defining how the segments will be handled (eg trimmed) by the algorithm
+                                                 const size_t           &prm_sequence_length, ///< The length of the full sequence on which this full_hit appears
+                                                 const hit_row_context  &prm_row_context      ///< The context of the hits
+                                                 ) {
 	const full_hit                  &the_full_hit          = prm_html_hit.hit_ref.get();
+	const seq_seg_vec               &the_segments          = the_full_hit.get_segments();
 	const seg_boundary_pair_vec_opt &the_result_boundaries = prm_html_hit.result_boundaries;
 
-	const auto resolved_boundaries = merge_opt_resolved_boundaries( the_full_hit.get_segments(), the_result_boundaries, prm_segment_spec );
-	const auto boundaries_strs     = transform_build<str_vec>(
-		resolved_boundaries
-			| filtered( [] (const seq_seg_opt &x) { return static_cast<bool>( x ); } ),
-		[] (const seq_seg_opt &x) { return to_simple_string( x ); }
+	const auto resolved_boundaries = merge_opt_resolved_boundaries( the_segments, the_result_boundaries, prm_segment_spec );
+
+	// Render the data attributes common to all of the hit's segments, should allow something like:
+	//
+	//     $(".crh-hit-ill-core").each(function(n) {
+	//         let d = $(n).data();
+	//         d.crh-hit-id;  # batch3-hit11
+	//         d.crh-hit-match-id; # 1cukA01
+	//     })
+	::fmt::memory_buffer data_attributes;
+	auto data_attributes_out = ::fmt::format_to(
+		::std::back_inserter( data_attributes ),
+		R"(data-crh-hit-id="batch{}-hit{}" data-crh-hit-{}="{}" data-crh-hit-{}=")",
+		prm_html_hit.batch_idx + 1,
+		prm_html_hit.hit_idx   + 1,
+		full_hit::get_label_name(),
+		the_full_hit.get_label(),
+		full_hit::get_segments_name()
 	);
-
-	return join(
-		indices( the_full_hit.get_segments().size() )
-			| transformed( [&] (const size_t &x_idx) {
-				const seq_seg &x = the_full_hit.get_segments()[ x_idx ];
-
-				// Grab the result of applying the crh_segment_spec to the segment
-				// (which may be ::std::nullopt if the segment is shorter than min-seg-length)
-				const seq_seg_opt trimmed_seg_opt = apply_spec_to_seg_copy( x, prm_segment_spec );
-
-				// Prepare batch index and hit index strings
-				const string      batch_idx_str   = ::std::to_string( prm_html_hit.batch_idx + 1 );
-				const string      hit_idx_str     = ::std::to_string( prm_html_hit.hit_idx   + 1 );
-
-				return "\t\t"
-					+ join(
-						html_segment{
-							x.get_start_arrow(),
-							( trimmed_seg_opt ? make_optional( trimmed_seg_opt->get_start_arrow() ) : nullopt ),
-							( trimmed_seg_opt ? make_optional( trimmed_seg_opt->get_stop_arrow () ) : nullopt ),
-							x.get_stop_arrow (),
-							( the_result_boundaries ? ( *the_result_boundaries )[ x_idx ].first  : nullopt ),
-							( the_result_boundaries ? ( *the_result_boundaries )[ x_idx ].second : nullopt ),
-							prm_html_hit.colour,
-							// data fields, should allow something like:
-							//
-							//     $(".crh-hit-ill-core").each(function(n) {
-							//         let d = $(n).data();
-							//         d.crh-hit-id;  # batch3-hit11
-							//         d.crh-hit-match-id; # 1cukA01
-							//     })
-							{
-								make_pair( "crh-hit-id"s,                                 "batch" + batch_idx_str + "-hit" + hit_idx_str ),
-								make_pair( "crh-hit-"  + full_hit::get_label_name(),      the_full_hit.get_label() ),
-								make_pair( "crh-hit-"s + full_hit::get_segments_name(),   join( boundaries_strs, ", " ) ),
-								make_pair( "crh-hit-"  + full_hit::get_score_name(),      ::std::to_string( the_full_hit.get_score() ) ),
-								make_pair( "crh-hit-"  + full_hit::get_score_type_name(), to_string( the_full_hit.get_score_type() ) ),
-								make_pair( "crh-seg-num"s,                                ::std::to_string( x_idx + 1 ) ),
-								make_pair( "crh-seg-boundaries"s,                         to_simple_string( resolved_boundaries[ x_idx ] ) ),
-							},
-							prm_sequence_length
-						}.get_all_span_html_strs( prm_row_context != hit_row_context::RESULT_FULL ),
-						"\n\t\t"
-					)
-					+ "\n";
-			} ),
-		""
+	bool is_first_boundary = true;
+	for (const seq_seg_opt &resolved_boundary : resolved_boundaries) {
+		if ( resolved_boundary ) {
+			if ( ! is_first_boundary ) {
+				data_attributes_out = ::fmt::format_to( data_attributes_out, ", " );
+			}
+			data_attributes_out = format_simple_string_to( data_attributes_out, resolved_boundary );
+			is_first_boundary = false;
+		}
+	}
+	::fmt::format_to(
+		data_attributes_out,
+		R"(" data-crh-hit-{}="{:f}" data-crh-hit-{}="{}")",
+		full_hit::get_score_name(),
+		the_full_hit.get_score(),
+		full_hit::get_score_type_name(),
+		to_string( the_full_hit.get_score_type() )
 	);
+	const size_t num_hit_data_attributes_chars = data_attributes.size();
+
+	for (const size_t &x_idx : indices( the_segments.size() ) ) {
+		const seq_seg &x = the_segments[ x_idx ];
+
+		// Grab the result of applying the crh_segment_spec to the segment
+		// (which may be ::std::nullopt if the segment is shorter than min-seg-length)
+		const seq_seg_opt trimmed_seg_opt = apply_spec_to_seg_copy( x, prm_segment_spec );
+
+		data_attributes.resize( num_hit_data_attributes_chars );
+		format_simple_string_to(
+			::fmt::format_to( ::std::back_inserter( data_attributes ), R"( data-crh-seg-num="{}" data-crh-seg-boundaries=")", x_idx + 1 ),
+			resolved_boundaries[ x_idx ]
+		);
+		data_attributes.push_back( '"' );
+
+		html_segment{
+			x.get_start_arrow(),
+			( trimmed_seg_opt ? make_optional( trimmed_seg_opt->get_start_arrow() ) : nullopt ),
+			( trimmed_seg_opt ? make_optional( trimmed_seg_opt->get_stop_arrow () ) : nullopt ),
+			x.get_stop_arrow (),
+			( the_result_boundaries ? ( *the_result_boundaries )[ x_idx ].first  : nullopt ),
+			( the_result_boundaries ? ( *the_result_boundaries )[ x_idx ].second : nullopt ),
+			prm_html_hit.colour,
+			string_view{ data_attributes.data(), data_attributes.size() },
+			prm_sequence_length
+		}.write_all_span_html( prm_sink, prm_row_context != hit_row_context::RESULT_FULL );
+	}
 }
 
-/// \brief Generate an HTML fragment to describe the specified full_hit with the specified crh_segment_spec applied
-string resolve_hits_html_outputter::hits_row_html(const html_hit_vec     &prm_full_hits_data,    ///< The detail of the hit(s) to render in the row (maybe more than one if the row is combining all result hits)
-                                                  const crh_segment_spec &prm_segment_spec,      ///< The crh_segment_spec defining how the segments will be handled (eg trimmed) by the algorithm
-                                                  const crh_score_spec   &prm_score_spec,        ///< The crh_score_spec to use to calculate the crh-score
-                                                  const size_t           &prm_sequence_length,   ///< The length of the full sequence on which this full_hit appears
-                                                  const hit_row_context  &prm_row_context        ///< The context of the hits
-                                                  ) {
+/// \brief Write an HTML fragment to describe the specified full_hit with the specified crh_segment_spec applied
+///        to the specified buffered_ostream_sink
+void resolve_hits_html_outputter::write_hits_row_html(buffered_ostream_sink  &prm_sink,              ///< The buffered_ostream_sink to which the HTML should be written
+                                                      const html_hit_vec     &prm_full_hits_data,    ///< The detail of the hit(s) to render in the row (maybe more than one if the row is combining all result hits)
+                                                      const crh_segment_spec &prm_segment_spec,      ///< The crh_segment_spec defining how the segments will be handled (eg trimmed) by the algorithm
+                                                      const crh_score_spec   &prm_score_spec,        ///< The crh_score_spec to use to calculate the crh-score
+                                                      const size_t           &prm_sequence_length,   ///< The length of the full sequence on which this full_hit appears
+                                                      const hit_row_context  &prm_row_context        ///< The context of the hits
+                                                      ) {
 	if ( prm_full_hits_data.empty() ) {
-		return "";
+		return;
 	}
 
 	const double    length_mult             = 100.0 / debug_numeric_cast<double>( prm_sequence_length );
 	const bool      isnt_full_result        = prm_row_context != hit_row_context::RESULT_FULL;
 	const full_hit &first_hit               = prm_full_hits_data.front().hit_ref.get();
 	const auto     &first_result_boundaries = prm_full_hits_data.front().result_boundaries;
-	const str_vec   boundaries_strs         = (
-		isnt_full_result
-			? transform_build<str_vec>(
-				merge_opt_resolved_boundaries(
-					first_hit.get_segments(),
-					first_result_boundaries,
-					prm_segment_spec
-				) | filtered( [] (const seq_seg_opt &x) { return static_cast<bool>( x ); } ),
-				[] (const seq_seg_opt &x) { return to_simple_string( x ); }
-			)
-			: str_vec{}
-	);
 
 	if ( isnt_full_result && prm_full_hits_data.size() != 1 ) {
 		BOOST_THROW_EXCEPTION(invalid_argument_exception("Cannot generate an HTML row of hits data for multiple hits when not generating a full result"));
 	}
 
 	// For strictly-worse rows, can set: background-color: #ddd; color: #999;
-	return R"(<tr )" + row_css_class_and_data_of_hit_row_context( prm_row_context ) + R"(>
-	<td class="crh-cell crh-cell-data )" + first_cell_css_class_of_hit_row_context( prm_row_context ) + R"(">
-		)" + ( isnt_full_result ? dumb_html_escape_copy( first_hit.get_label() ) : "&nbsp;"s ) + R"(
+	::fmt::format_to(
+		prm_sink.out(),
+		R"(<tr {}>
+	<td class="crh-cell crh-cell-data {}">
+		)",
+		row_css_class_and_data_of_hit_row_context( prm_row_context ),
+		first_cell_css_class_of_hit_row_context( prm_row_context )
+	);
+	if ( isnt_full_result ) {
+		write_dumb_html_escaped( prm_sink, first_hit.get_label() );
+	}
+	else {
+		prm_sink.append( "&nbsp;" );
+	}
+	prm_sink.append( R"(
 	</td>
 	<td class="crh-cell crh-cell-data">
 		<div class="crh-figure-div-line">
-)"
-		+ join(
-			irange( 0_z, prm_sequence_length + 1, step_for_length( prm_sequence_length ) )
-				| transformed( [&] (const size_t &x) {
-					return R"(		<span class="crh-figure-tick" style="left: )"
-						+ ::std::to_string( length_mult * debug_numeric_cast<double>( x ) )
-						+ R"(%;"></span>)" + "\n";
-				} ),
-			""
-		)
-		+ join(
-			prm_full_hits_data
-				| transformed( [&] (const html_hit &x) {
-					return hit_html(
-						x,
-						prm_segment_spec,
-						prm_sequence_length,
-						prm_row_context
-					);
-				} ),
-			""
-		)
-		+ R"(		</div>
+)" );
+	for (const size_t &x : irange( 0_z, prm_sequence_length + 1, step_for_length( prm_sequence_length ) ) ) {
+		::fmt::format_to(
+			prm_sink.out(),
+			R"(		<span class="crh-figure-tick" style="left: {:f}%;"></span>
+)",
+			length_mult * debug_numeric_cast<double>( x )
+		);
+	}
+	for (const html_hit &x : prm_full_hits_data) {
+		write_hit_html(
+			prm_sink,
+			x,
+			prm_segment_spec,
+			prm_sequence_length,
+			prm_row_context
+		);
+	}
+	prm_sink.append( R"(		</div>
 	</td>
-	<td class="crh-cell crh-cell-data">)"
-		+ ( isnt_full_result && first_result_boundaries ? "+ "s : ""s )
-		+ ( isnt_full_result ? ( format("%.3g") % get_crh_score( first_hit, prm_score_spec ) ).str() : ""s )
-		+ R"(</td>
-	<td class="crh-cell crh-cell-data">)"
-		+ ( isnt_full_result ? get_score_string( first_hit, 4 ) : ""s )
-		+ R"(</td>
-	<td class="crh-cell crh-cell-data">)"
-		+ (
-			R"(
+	<td class="crh-cell crh-cell-data">)" );
+	if ( isnt_full_result ) {
+		::fmt::format_to(
+			prm_sink.out(),
+			"{}{:.3g}</td>\n\t<td class=\"crh-cell crh-cell-data\">{}",
+			( first_result_boundaries ? "+ " : "" ),
+			get_crh_score( first_hit, prm_score_spec ),
+			get_score_string( first_hit, 4 )
+		);
+	}
+	else {
+		prm_sink.append( "</td>\n\t<td class=\"crh-cell crh-cell-data\">" );
+	}
+	prm_sink.append( R"(</td>
+	<td class="crh-cell crh-cell-data">
 		<div class="scan-result-regions">
-			)"
-			+ join(
-				boundaries_strs
-					| transformed( [] (const string &x) {
-						return R"(<span class="crh-chopping-region-text">)" + x + "</span>";
-					} ),
-				R"(,
-			)"
-			)
-			+ R"(
+			)" );
+	if ( isnt_full_result ) {
+		bool is_first_boundary = true;
+		for (const seq_seg_opt &resolved_boundary : merge_opt_resolved_boundaries( first_hit.get_segments(), first_result_boundaries, prm_segment_spec ) ) {
+			if ( resolved_boundary ) {
+				if ( ! is_first_boundary ) {
+					prm_sink.append( ",\n\t\t\t" );
+				}
+				prm_sink.append( R"(<span class="crh-chopping-region-text">)" );
+				format_simple_string_to( prm_sink.out(), resolved_boundary );
+				prm_sink.append( "</span>" );
+				is_first_boundary = false;
+			}
+		}
+	}
+	prm_sink.append( R"(
 		</div>
-	)"
-		)
-		+ R"(</td>
-	<td class="crh-cell crh-cell-data">)"
-	+ (
-		R"(
-		)"
-			+ ( isnt_full_result ? ::std::to_string( get_total_length( first_hit ) ) : ""s )
-			+ R"(
-	)"
-	)
-	+ R"(</td>
-</tr>)";
+	</td>
+	<td class="crh-cell crh-cell-data">
+		)" );
+	if ( isnt_full_result ) {
+		::fmt::format_to( prm_sink.out(), "{}", get_total_length( first_hit ) );
+	}
+	prm_sink.append( R"(
+	</td>
+</tr>)" );
 }
 
 /// \brief Generate the HTML prefix string
@@ -745,6 +781,12 @@ body.crh-body table {
 	top               : -6px;
 }
 
+.crh-budget-note {
+	color             : #a40;
+	font-size         : 80%;
+	padding           : 5px 0 5px 0;
+}
+
 .crh-exclusion-note {
 	color             : #777;
 	font-size         : 80%;
@@ -840,11 +882,70 @@ string resolve_hits_html_outputter::output_html(const string           &prm_quer
                                                 const crh_filter_spec  &prm_filter_spec,      ///< The crh_filter_spec defining which input hits will be skipped by the algorithm
                                                 const size_t           &prm_batch_index       ///< The index of the batch of hits being output (used to allow hits' HTML to have unique data attributes)
                                                 ) {
+	return output_html(
+		prm_query_id,
+		prm_calc_hit_list,
+		resolve_hits_within_budget( prm_calc_hit_list, prm_score_spec ).first,
+		prm_score_spec,
+		prm_segment_spec,
+		prm_html_spec,
+		prm_output_head_tail,
+		prm_filter_spec,
+		prm_batch_index
+	);
+}
+
+/// \brief Generate HTML to describe the specified full_hit_list, which has already been resolved to the specified scored_hit_arch,
+///        with the specified trim_spec applied
+string resolve_hits_html_outputter::output_html(const string           &prm_query_id,         ///< The query ID
+                                                const calc_hit_list    &prm_calc_hit_list,    ///< The calc_hit_list to describe
+                                                const scored_hit_arch  &prm_best_result,      ///< The result of resolving prm_calc_hit_list
+                                                const crh_score_spec   &prm_score_spec,       ///< The crh_score_spec to use to calculate the crh-score
+                                                const crh_segment_spec &prm_segment_spec,     ///< The crh_segment_spec defining how the segments will be handled (eg trimmed) by the algorithm
+                                                const crh_html_spec    &prm_html_spec,        ///< The specification for how to render the HTML
+                                                const bool             &prm_output_head_tail, ///< Whether to include the head and tail (ie prefix and suffix) in the output
+                                                const crh_filter_spec  &prm_filter_spec,      ///< The crh_filter_spec defining which input hits will be skipped by the algorithm
+                                                const size_t           &prm_batch_index       ///< The index of the batch of hits being output (used to allow hits' HTML to have unique data attributes)
+                                                ) {
+	ostringstream         html_ss;
+	buffered_ostream_sink html_sink{ html_ss };
+	write_html(
+		html_sink,
+		prm_query_id,
+		prm_calc_hit_list,
+		prm_best_result,
+		prm_score_spec,
+		prm_segment_spec,
+		prm_html_spec,
+		prm_output_head_tail,
+		prm_filter_spec,
+		prm_batch_index
+	);
+	html_sink.flush();
+	return html_ss.str();
+}
+
+/// \brief Write HTML to describe the specified full_hit_list, which has already been resolved to the specified scored_hit_arch,
+///        with the specified trim_spec applied, to the specified buffered_ostream_sink
+///
+/// This writes the HTML piece by piece so the memory used is bounded by the sink's flush threshold,
+/// rather than by the size of the HTML for the query. It doesn't flush the sink at the end.
+void resolve_hits_html_outputter::write_html(buffered_ostream_sink       &prm_sink,             ///< The buffered_ostream_sink to which the HTML should be written
+                                             const string                &prm_query_id,         ///< The query ID
+                                             const calc_hit_list         &prm_calc_hit_list,    ///< The calc_hit_list to describe
+                                             const scored_hit_arch       &prm_best_result,      ///< The result of resolving prm_calc_hit_list
+                                             const crh_score_spec        &prm_score_spec,       ///< The crh_score_spec to use to calculate the crh-score
+                                             const crh_segment_spec      &prm_segment_spec,     ///< The crh_segment_spec defining how the segments will be handled (eg trimmed) by the algorithm
+                                             const crh_html_spec         &prm_html_spec,        ///< The specification for how to render the HTML
+                                             const bool                  &prm_output_head_tail, ///< Whether to include the head and tail (ie prefix and suffix) in the output
+                                             const crh_filter_spec       &prm_filter_spec,      ///< The crh_filter_spec defining which input hits will be skipped by the algorithm
+                                             const size_t                &prm_batch_index,      ///< The index of the batch of hits being output (used to allow hits' HTML to have unique data attributes)
+                                             const resolve_budget_breach &prm_budget_breach     ///< Whether (and how) resolving exceeded the budget, so that the naive, greedy approach was used instead
+                                             ) {
 	const auto  filtered_grey     = display_colour{ 0.666, 0.666, 0.666 };
 	const auto &the_full_hit_list = prm_calc_hit_list.get_full_hits();
-	const auto  best_result       = resolve_hits( prm_calc_hit_list, prm_score_spec.get_naive_greedy() );
 	const auto  chosen_full_hits  = full_hit_list{ transform_build<full_hit_vec>(
-		best_result.get_arch(),
+		prm_best_result.get_arch(),
 		[&] (const calc_hit &x) {
 			return the_full_hit_list[ x.get_label_idx() ];
 		}
@@ -875,11 +976,32 @@ string resolve_hits_html_outputter::output_html(const string           &prm_quer
 	const auto   orig_score_str = the_full_hit_list.empty() ? "Score"s
 	                                                        : upper_first_lower_rest( to_string( front( the_full_hit_list ).get_score_type() ) );
 
-	// Variable to keep track of exclusions
-	size_set non_soln_hit_indices;
-	size_set excluded_non_soln_hit_indices;
+	// Make the html_hit for the result hit with the specified calc_hit
+	const auto make_result_html_hit = [&] (const calc_hit &x) {
+		const auto &the_index    = x.get_label_idx();
+		const auto &the_full_hit = the_full_hit_list[ the_index ];
+		return html_hit{
+			the_full_hit,
+			prm_batch_index,
+			the_index,
+			score_passes_filter( prm_filter_spec, the_full_hit.get_score(), the_full_hit.get_score_type() )
+				? get_colour_of_fraction(
+					gradient,
+					get_crh_score( the_full_hit, prm_score_spec ) / *best_crh_score
+				)
+				: filtered_grey,
+			::std::make_optional( resolved_boundaries(
+				the_full_hit,
+				chosen_full_hits,
+				prm_segment_spec
+			) )
+		};
+	};
 
-	const string main_return_string = ( prm_output_head_tail ? html_prefix() : string{} ) + R"(
+	if ( prm_output_head_tail ) {
+		prm_sink.append( html_prefix() );
+	}
+	prm_sink.append( R"(
 <br /> <!-- This is required before the wrapper for providing a break after the expand/collapse link -->
 <div class="crh-results-wrapper">
 
@@ -890,8 +1012,20 @@ string resolve_hits_html_outputter::output_html(const string           &prm_quer
 	</span>
 </div>
 
-<h3 class="crh-query-header">)" + dumb_html_escape_copy( prm_query_id ) + R"(</h3>
-<table class="crh-table">
+<h3 class="crh-query-header">)" );
+	write_dumb_html_escaped( prm_sink, prm_query_id );
+	prm_sink.append( "</h3>\n" );
+	if ( prm_budget_breach != resolve_budget_breach::NONE ) {
+		::fmt::format_to(
+			prm_sink.out(),
+			R"(<div class="crh-budget-note">Resolved with the naive, greedy approach ({}; see <code>--{}</code> and <code>--{}</code>)</div>
+)",
+			description_of_breach( prm_budget_breach ),
+			crh_score_options_block::PO_MAX_DP_HITS,
+			crh_score_options_block::PO_MAX_DP_WORK
+		);
+	}
+	prm_sink.append( R"(<table class="crh-table">
 
 <tr class="crh-row-subheading">
 	<td colspan="6" class="crh-table-subheading-first">
@@ -902,38 +1036,17 @@ string resolve_hits_html_outputter::output_html(const string           &prm_quer
 	</td>
 </tr>
 
-)"
-	+ markers_row( seq_length, nullopt, table_section::RESULTS )
-	+ hits_row_html(
-		transform_build<html_hit_vec>(
-			best_result.get_arch(),
-			[&] (const calc_hit &x) {
-				const auto &the_index    = x.get_label_idx();
-				const auto &the_full_hit = the_full_hit_list[ the_index ];
-				return html_hit{
-					the_full_hit,
-					prm_batch_index,
-					the_index,
-					score_passes_filter( prm_filter_spec, the_full_hit.get_score(), the_full_hit.get_score_type() )
-						? get_colour_of_fraction(
-							gradient,
-							get_crh_score( the_full_hit, prm_score_spec ) / *best_crh_score
-						)
-						: filtered_grey,
-					::std::make_optional( resolved_boundaries(
-						the_full_hit,
-						chosen_full_hits,
-						prm_segment_spec
-					) )
-				};
-			}
-		),
+)" );
+	write_markers_row( prm_sink, seq_length, nullopt, table_section::RESULTS );
+	write_hits_row_html(
+		prm_sink,
+		transform_build<html_hit_vec>( prm_best_result.get_arch(), make_result_html_hit ),
 		prm_segment_spec,
 		prm_score_spec,
 		seq_length,
 		hit_row_context::RESULT_FULL
-	)
-	+ R"(<tr class="crh-row-soln-break">
+	);
+	prm_sink.append( R"(<tr class="crh-row-soln-break">
 	<td />
 	<td class="crh-cell-soln-break">
 		<span class="crh-row-soln-break-uparrow">&#11014;</span>
@@ -945,39 +1058,26 @@ string resolve_hits_html_outputter::output_html(const string           &prm_quer
 		<span class="crh-row-soln-break-uparrow">&#11014;</span>
 	</td>
 </tr>
-)"
-	+ join(
-		best_result.get_arch()
-			| transformed( [&] (const calc_hit &x) {
-				const auto &the_index    = x.get_label_idx();
-				const auto &the_full_hit = the_full_hit_list[ the_index ];
-				return hits_row_html(
-					{ html_hit{
-						the_full_hit,
-						prm_batch_index,
-						the_index,
-						score_passes_filter( prm_filter_spec, the_full_hit.get_score(), the_full_hit.get_score_type() )
-							? get_colour_of_fraction(
-								gradient,
-								get_crh_score( the_full_hit, prm_score_spec ) / *best_crh_score
-							)
-							: filtered_grey,
-						::std::make_optional( resolved_boundaries(
-							the_full_hit,
-							chosen_full_hits,
-							prm_segment_spec
-						) )
-					} },
-					prm_segment_spec,
-					prm_score_spec,
-					seq_length,
-					hit_row_context::RESULT
-				);
-			} ),
-		"\n"
-	)
-	+ total_score_row( best_result.get_score() )
-	+ R"(
+)" );
+
+	bool is_first_result_row = true;
+	for (const calc_hit &x : prm_best_result.get_arch() ) {
+		if ( ! is_first_result_row ) {
+			prm_sink.put( '\n' );
+		}
+		write_hits_row_html(
+			prm_sink,
+			{ make_result_html_hit( x ) },
+			prm_segment_spec,
+			prm_score_spec,
+			seq_length,
+			hit_row_context::RESULT
+		);
+		is_first_result_row = false;
+	}
+
+	write_total_score_row( prm_sink, prm_best_result.get_score() );
+	prm_sink.append( R"(
 <tr class="crh-row-subheading">
 	<td colspan="6" class="crh-table-subheading-later">
 		<span class="crh-table-subheading-uparrow">&#11014;</span>
@@ -995,76 +1095,75 @@ string resolve_hits_html_outputter::output_html(const string           &prm_quer
 	</td>
 </tr>
 
-)"
-	+ markers_row( seq_length, ::std::make_optional( orig_score_str ), table_section::INPUTS )
-	+ "\n\n"
-	+ join(
-		sorted_indices
-			| transformed( [&] (const size_t &x) {
-				const auto            &hit_x     = the_full_hit_list[ x ];
-				const bool             in_result = any_of( best_result.get_arch(), [&] (const calc_hit &y) { return y.get_label_idx() == x; } );
-				const hit_row_context  context   = in_result ? hit_row_context::HIGHLIGHT
-				                                             : hit_row_context::NORMAL;
-				const bool             rejected  = ! score_passes_filter( prm_filter_spec, hit_x.get_score(), hit_x.get_score_type() );
-
-				if ( rejected && prm_html_spec.get_exclude_rejected_hits() ) {
-					return ""s;
-				}
-				if ( ! in_result ) {
-					if ( ! contains( non_soln_hit_indices, x ) ) {
-						if ( non_soln_hit_indices.size() >= prm_html_spec.get_max_num_non_soln_hits() ) {
-							excluded_non_soln_hit_indices.insert( x );
-							return ""s;
-						}
-						non_soln_hit_indices.insert( x );
-					}
+)" );
+	write_markers_row( prm_sink, seq_length, ::std::make_optional( orig_score_str ), table_section::INPUTS );
+	prm_sink.append( "\n\n" );
+
+	// Variable to keep track of exclusions
+	size_set non_soln_hit_indices;
+	size_t   num_excluded_non_soln_hits = 0;
+
+	bool is_first_input_row = true;
+	for (const size_t &x : sorted_indices) {
+		const auto            &hit_x     = the_full_hit_list[ x ];
+		const bool             in_result = any_of( prm_best_result.get_arch(), [&] (const calc_hit &y) { return y.get_label_idx() == x; } );
+		const hit_row_context  context   = in_result ? hit_row_context::HIGHLIGHT
+		                                             : hit_row_context::NORMAL;
+		const bool             rejected  = ! score_passes_filter( prm_filter_spec, hit_x.get_score(), hit_x.get_score_type() );
+
+		if ( rejected && prm_html_spec.get_exclude_rejected_hits() ) {
+			continue;
+		}
+		if ( ! in_result ) {
+			if ( ! contains( non_soln_hit_indices, x ) ) {
+				if ( non_soln_hit_indices.size() >= prm_html_spec.get_max_num_non_soln_hits() ) {
+					++num_excluded_non_soln_hits;
+					continue;
 				}
-				return hits_row_html(
-					{ html_hit{
-						hit_x,
-						prm_batch_index,
-						x,
-						rejected
-							? filtered_grey
-							: get_colour_of_fraction(
-								gradient,
-								get_crh_score( hit_x, prm_score_spec ) / *best_crh_score
-							),
-						nullopt
-					} },
-					prm_segment_spec,
-					prm_score_spec,
-					seq_length,
-					context
-				);
-			} )
-			| filtered( [] (const string &x) { return ! x.empty() ; } ),
-		"\n"
-	)
-	+ R"(
+				non_soln_hit_indices.insert( x );
+			}
+		}
+		if ( ! is_first_input_row ) {
+			prm_sink.put( '\n' );
+		}
+		write_hits_row_html(
+			prm_sink,
+			{ html_hit{
+				hit_x,
+				prm_batch_index,
+				x,
+				rejected
+					? filtered_grey
+					: get_colour_of_fraction(
+						gradient,
+						get_crh_score( hit_x, prm_score_spec ) / *best_crh_score
+					),
+				nullopt
+			} },
+			prm_segment_spec,
+			prm_score_spec,
+			seq_length,
+			context
+		);
+		is_first_input_row = false;
+	}
+	prm_sink.append( R"(
 </table>
-)";
-	// Have to fully calculate main_return_string and then concatenate extra stuff here
-	// because otherwise C++'s order of evaluation rules don't guarantee that the code above
-	// has run and potentially populated excluded_non_soln_hit_indices before it's used below.
-	// I have seen this issue exhibited in code compiled by GCC (but not by Clang).
-	return
-		main_return_string
-		+ (
-			excluded_non_soln_hit_indices.empty()
-				? ""s
-				: (
-					R"(<div class="crh-exclusion-note">...hiding another )"
-					+ std::to_string( excluded_non_soln_hit_indices.size() )
-					+ R"( non-solution results (current limit is )"
-					+ std::to_string( prm_html_spec.get_max_num_non_soln_hits() )
-					+ R"(; use <code>--)"
-					+ string( crh_html_options_block::PO_MAX_NUM_NON_SOLN_HITS )
-					+ R"(</code> to change)</div>)"
-				)
-		)
-		+ R"(
+)" );
+
+	if ( num_excluded_non_soln_hits > 0 ) {
+		::fmt::format_to(
+			prm_sink.out(),
+			R"(<div class="crh-exclusion-note">...hiding another {} non-solution results (current limit is {}; use <code>--{}</code> to change)</div>)",
+			num_excluded_non_soln_hits,
+			prm_html_spec.get_max_num_non_soln_hits(),
+			crh_html_options_block::PO_MAX_NUM_NON_SOLN_HITS
+		);
+	}
+	prm_sink.append( R"(
 </div>
-)"
-		+ ( prm_output_head_tail ? html_suffix() : string{} );
+)" );
+	if ( prm_output_head_tail ) {
+		prm_sink.append( html_suffix() );
+	}
 }
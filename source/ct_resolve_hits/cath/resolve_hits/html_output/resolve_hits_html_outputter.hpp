@@ -24,17 +24,20 @@
 #include "cath/common/type_aliases.hpp"
 #include "cath/resolve_hits/options/spec/crh_filter_spec.hpp"
 #include "cath/resolve_hits/options/spec/crh_html_spec.hpp"
+#include "cath/resolve_hits/resolve/hit_resolve_stats.hpp"
 #include "cath/resolve_hits/resolve_hits_type_aliases.hpp"
 
 #include <iosfwd>
 
 // clang-format off
 namespace cath { class display_colour; }
+namespace cath::common { class buffered_ostream_sink; }
 namespace cath::rslv { class calc_hit_list; }
 namespace cath::rslv { class crh_score_spec; }
 namespace cath::rslv { class crh_segment_spec; }
 namespace cath::rslv { class full_hit; }
 namespace cath::rslv { class full_hit_list; }
+namespace cath::rslv { class scored_hit_arch; }
 namespace cath::rslv { class trim_spec; }
 // clang-format on
 
@@ -67,20 +70,24 @@ namespace cath::rslv {
 	///  * think about (how/whether) to handle data for multiple query_ids
 	class resolve_hits_html_outputter final {
 	private:
-		static std::string total_score_row(const resscr_t &);
-		static std::string markers_row(const size_t &,
-		                               const str_opt &,
-		                               const table_section &);
-
-		static std::string hit_html(const html_hit &,
-		                            const crh_segment_spec &,
-		                            const size_t &,
-		                            const hit_row_context &);
-		static std::string hits_row_html(const html_hit_vec &,
-		                                 const crh_segment_spec &,
-		                                 const crh_score_spec &,
-		                                 const size_t &,
-		                                 const hit_row_context &);
+		static void write_total_score_row(common::buffered_ostream_sink &,
+		                                  const resscr_t &);
+		static void write_markers_row(common::buffered_ostream_sink &,
+		                              const size_t &,
+		                              const str_opt &,
+		                              const table_section &);
+
+		static void write_hit_html(common::buffered_ostream_sink &,
+		                           const html_hit &,
+		                           const crh_segment_spec &,
+		                           const size_t &,
+		                           const hit_row_context &);
+		static void write_hits_row_html(common::buffered_ostream_sink &,
+		                                const html_hit_vec &,
+		                                const crh_segment_spec &,
+		                                const crh_score_spec &,
+		                                const size_t &,
+		                                const hit_row_context &);
 
 	public:
 		static std::string html_prefix();
@@ -118,7 +125,27 @@ namespace cath::rslv {
 		                               const crh_filter_spec & = make_accept_all_filter_spec(),
 		                               const size_t & = 0);
 
-		
+		static std::string output_html(const std::string &,
+		                               const calc_hit_list &,
+		                               const scored_hit_arch &,
+		                               const crh_score_spec &,
+		                               const crh_segment_spec &,
+		                               const crh_html_spec & = crh_html_spec{},
+		                               const bool & = true,
+		                               const crh_filter_spec & = make_accept_all_filter_spec(),
+		                               const size_t & = 0);
+
+		static void write_html(common::buffered_ostream_sink &,
+		                       const std::string &,
+		                       const calc_hit_list &,
+		                       const scored_hit_arch &,
+		                       const crh_score_spec &,
+		                       const crh_segment_spec &,
+		                       const crh_html_spec & = crh_html_spec{},
+		                       const bool & = true,
+		                       const crh_filter_spec & = make_accept_all_filter_spec(),
+		                       const size_t & = 0,
+		                       const resolve_budget_breach & = resolve_budget_breach::NONE);
 	};
 
 } // namespace cath::rslv
@@ -106,10 +106,11 @@ str_opt crh_options::do_get_error_or_help_string() const {
 	};
 
 	// Store a map from the score type to the valid formats for which that "--worst-permissible-[...]" option may be specified
+	// (binary data may hold hits with any type of score)
 	const auto formats_for_worst_perm_opt_of_score = map< hit_score_type, hits_input_format_tag_vec >{
-		{ hit_score_type::FULL_EVALUE, { hits_input_format_tag::RAW_WITH_EVALUES,                                                                          }, },
-		{ hit_score_type::BITSCORE,    { hits_input_format_tag::HMMER_DOMTBLOUT, hits_input_format_tag::HMMSCAN_OUT, hits_input_format_tag::HMMSEARCH_OUT, }, },
-		{ hit_score_type::CRH_SCORE,   { hits_input_format_tag::RAW_WITH_SCORES                                                                            }, },
+		{ hit_score_type::FULL_EVALUE, { hits_input_format_tag::RAW_WITH_EVALUES,                                                                          hits_input_format_tag::BINARY, }, },
+		{ hit_score_type::BITSCORE,    { hits_input_format_tag::HMMER_DOMTBLOUT, hits_input_format_tag::HMMSCAN_OUT, hits_input_format_tag::HMMSEARCH_OUT, hits_input_format_tag::BINARY, }, },
+		{ hit_score_type::CRH_SCORE,   { hits_input_format_tag::RAW_WITH_SCORES,                                                                           hits_input_format_tag::BINARY, }, },
 	};
 	//
 
@@ -205,6 +206,15 @@ str_str_str_pair_map crh_options::detail_help_spec() {
 				get_crh_raw_format_help_string()
 			}
 		},
+		{
+			"binary-format-help",
+			{
+				"Show help about the binary input format ("
+					+ to_string( hits_input_format_tag::BINARY )
+					+ ")",
+				get_crh_binary_format_help_string()
+			}
+		},
 		{
 			"cath-rules-help",
 			{
@@ -293,6 +303,49 @@ qyikaz 1mkfA01/12-210-i5_4,3.5e-15 2470.04912752062 953-1053
 )";
 }
 
+/// \brief Get the text for the binary format help
+string cath::rslv::get_crh_binary_format_help_string() {
+	return R"(Format for "binary" input data
+------------------------------
+
+A compact stream of hit records that can be read without any text parsing.
+Write it from any of the other input formats with --)"
+	+ string( crh_output_options_block::PO_BINARY_HITS_TO_FILE )
+	+ R"( <file>.
+
+All values are little-endian and packed without padding.
+
+Header (16 bytes):
+ * char[8] : "CRHHITS" followed by a NUL
+ * uint32  : the format version (currently 1)
+ * uint32  : reserved (0)
+
+Then one record per hit:
+ * uint32         : the index of the hit's query ID in the query ID table
+ * uint32         : the index of the hit's match ID in the match ID table
+ * uint8          : the score type (0: evalue, 1: bitscore, 2: crh-score)
+ * uint8          : the number of extras
+ * uint16         : the number of segments (at least 1)
+ * float64        : the score
+ * uint32, uint32 : for each segment, the start and stop residues (as in the raw format)
+ * for each extra : a uint8 category, then either:
+                     * for 0 (aligned regions)                            : a uint32 length and then that many chars, or
+                     * for 1 (conditional evalue), 2 (independent evalue) : a float64
+
+Then the query ID table and then the match ID table, each of which is a sequence of IDs,
+each as a uint32 length followed by that many chars.
+
+Trailer (32 bytes):
+ * uint64  : the offset from the start of the data to the query ID table
+ * uint64  : the number of records
+ * uint32  : the number of query IDs
+ * uint32  : the number of match IDs
+ * char[8] : "CRHHEND" followed by a NUL
+
+Empty data (with no header or trailer) holds no hits.
+)";
+}
+
 /// \brief Get the text for the apply CATH-Gene3d rules help
 string cath::rslv::get_crh_cath_rules_help_string() {
 	return R"(CATH Rules Help [--)"
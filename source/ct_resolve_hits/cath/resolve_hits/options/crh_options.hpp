@@ -92,6 +92,7 @@ namespace cath::rslv {
 	};
 
 	std::string get_crh_raw_format_help_string();
+	std::string get_crh_binary_format_help_string();
 	std::string get_crh_cath_rules_help_string();
 
 } // namespace cath::rslv
@@ -65,10 +65,14 @@ void crh_input_options_block::do_add_visible_options_to_description(options_desc
 
 	const string format_varname { "<format>" };
 	const string length_varname { "<length>" };
+	const string threads_varname{ "<threads>" };
+	const string memory_varname { "<megabytes>" };
 
 	const auto input_format_notifier           = [&] (const hits_input_format_tag &x) { the_spec.set_input_format          ( x ); };
 	const auto min_gap_length_notifier         = [&] (const residx_t              &x) { the_spec.set_min_gap_length        ( x ); };
 	const auto input_hits_are_grouped_notifier = [&] (const bool                  &x) { the_spec.set_input_hits_are_grouped( x ); };
+	const auto num_threads_notifier            = [&] (const size_t                &x) { the_spec.set_num_threads           ( x ); };
+	const auto max_memory_notifier             = [&] (const size_t                &x) { the_spec.set_max_memory            ( x ); };
 
 	const str_vec input_format_descs = layout_values_with_descs(
 		all_hits_input_format_tags,
@@ -105,6 +109,25 @@ void crh_input_options_block::do_add_visible_options_to_description(options_desc
 				->default_value( crh_input_spec::DEFAULT_INPUT_HITS_ARE_GROUPED ),
 			"Rely on the input hits being grouped by query protein"
 			"\n(so the run is faster and uses less memory)"
+		)
+		(
+			string( PO_THREADS ).c_str(),
+			value<size_t>()
+				->value_name   ( threads_varname                                )
+				->notifier     ( num_threads_notifier                           )
+				->default_value( crh_input_spec::DEFAULT_NUM_THREADS            ),
+			( "Parse and resolve queries on a total of " + threads_varname + " worker threads (or 0 to use the hardware concurrency)"
+				"\n(for " + to_string( hits_input_format_tag::HMMER_DOMTBLOUT ) + " input with at least 4 threads, half parse the input;"
+				"\n the output order is unaffected)" ).c_str()
+		)
+		(
+			string( PO_MAX_MEMORY ).c_str(),
+			value<size_t>()
+				->value_name   ( memory_varname                                 )
+				->notifier     ( max_memory_notifier                            )
+				->default_value( crh_input_spec::DEFAULT_MAX_MEMORY             ),
+			( "When the input hits aren't grouped, spill them to temporary files once they take roughly " + memory_varname + " MB of memory (or 0 for no limit)"
+				"\n(the results are unaffected)" ).c_str()
 		);
 
 	static_assert( ! crh_input_spec::DEFAULT_READ_FROM_STDIN,        "If crh_input_spec::DEFAULT_READ_FROM_STDIN        isn't false, it might mess up the bool switch in here" );
@@ -161,6 +184,8 @@ str_view_vec crh_input_options_block::do_get_all_options_names() const {
 		PO_INPUT_FORMAT,
 		PO_MIN_GAP_LENGTH,
 		PO_INPUT_HITS_ARE_GROUPED,
+		PO_THREADS,
+		PO_MAX_MEMORY,
 	};
 }
 
@@ -59,6 +59,12 @@ namespace cath::rslv {
 
 		/// \brief The option name for whether the code can assume that the input data is pre-grouped by query_id
 		static constexpr ::std::string_view PO_INPUT_HITS_ARE_GROUPED{ "input-hits-are-grouped" };
+
+		/// \brief The option name for the number of worker threads with which to parse and resolve queries
+		static constexpr ::std::string_view PO_THREADS{ "threads" };
+
+		/// \brief The option name for the approximate memory above which ungrouped hits are spilled to temporary files
+		static constexpr ::std::string_view PO_MAX_MEMORY{ "max-memory" };
 	};
 
 } // namespace cath::rslv
@@ -70,6 +70,7 @@ void crh_output_options_block::do_add_visible_options_to_description(options_des
 	const auto summarise_files_notifier     = [&] (const path_vec &x) { the_spec.set_summarise_files     ( x           ); };
 	const auto html_output_files_notifier   = [&] (const path_vec &x) { the_spec.set_html_output_files   ( x           ); };
 	const auto json_output_files_notifier   = [&] (const path_vec &x) { the_spec.set_json_output_files   ( x           ); };
+	const auto binary_hits_files_notifier   = [&] (const path_vec &x) { the_spec.set_binary_hits_files   ( x           ); };
 	const auto export_css_file_notifier     = [&] (const path     &x) { the_spec.set_export_css_file     ( x           ); };
 
 	prm_desc.add_options()
@@ -118,6 +119,14 @@ void crh_output_options_block::do_add_visible_options_to_description(options_des
 				->notifier     ( json_output_files_notifier            ),
 			( "Write the results as JSON to file " + file_varname + " (or '-' for stdout)" ).c_str()
 		)
+		(
+			string( PO_BINARY_HITS_TO_FILE ).c_str(),
+			value<path_vec>()
+				->value_name   ( file_varname                          )
+				->notifier     ( binary_hits_files_notifier            ),
+			( "Write all the input hits (unfiltered and unresolved) to file " + file_varname + " in the compact binary hits format\n"
+			  "(which can then be read much faster with --input-format binary)" ).c_str()
+		)
 		(
 			string( PO_EXPORT_CSS_FILE ).c_str(),
 			value<path>()
@@ -211,6 +220,7 @@ str_view_vec crh_output_options_block::get_all_non_deprecated_option_names_that_
 		PO_SUMMARISE_TO_FILE,
 		PO_HTML_OUTPUT_TO_FILE,
 		PO_JSON_OUTPUT_TO_FILE,
+		PO_BINARY_HITS_TO_FILE,
 	};
 }
 /// \brief Return all non-deprecated options names for this block that should clash with
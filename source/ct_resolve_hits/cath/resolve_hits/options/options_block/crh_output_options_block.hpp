@@ -77,6 +77,9 @@ namespace cath::rslv {
 		/// \brief The option name for an optional file to which JSON should be output
 		static constexpr ::std::string_view PO_JSON_OUTPUT_TO_FILE{ "json-output-to-file" };
 
+		/// \brief The option name for an optional file to which all the input hits should be output in the binary hits format
+		static constexpr ::std::string_view PO_BINARY_HITS_TO_FILE{ "binary-hits-to-file" };
+
 		/// \brief The option name for an optional file to which the CSS should be output
 		static constexpr ::std::string_view PO_EXPORT_CSS_FILE{ "export-css-file" };
 
@@ -54,11 +54,14 @@ void crh_score_options_block::do_add_visible_options_to_description(options_desc
                                                                     const size_t        &/*prm_line_length*/ ///< The line length to be used when outputting the description (not very clearly documented in Boost)
                                                                     ) {
 	const string val_varname { "<val>" };
+	const string num_varname { "<num>" };
 
 	const auto long_domains_preference_notifier = [&] (const resscr_t &x) { the_spec.set_long_domains_preference ( x ); };
 	const auto high_scores_preference_notifier  = [&] (const resscr_t &x) { the_spec.set_high_scores_preference  ( x ); };
 	const auto apply_cath_rules_notifier        = [&] (const bool     &x) { the_spec.set_apply_cath_rules        ( x ); };
 	const auto naive_greedy_notifier            = [&] (const bool     &x) { the_spec.set_naive_greedy            ( x ); };
+	const auto max_dp_hits_notifier             = [&] (const size_t   &x) { the_spec.set_max_dp_hits             ( x ); };
+	const auto max_dp_work_notifier             = [&] (const size_t   &x) { the_spec.set_max_dp_work             ( x ); };
 
 	prm_desc.add_options()
 		(
@@ -95,6 +98,22 @@ void crh_score_options_block::do_add_visible_options_to_description(options_desc
 				->notifier     ( naive_greedy_notifier                           )
 				->default_value( crh_score_spec::DEFAULT_NAIVE_GREEDY            ),
 			"Use a naive, greedy approach to resolving (not recommended except for comparison)"
+		)
+		(
+			string( PO_MAX_DP_HITS ).c_str(),
+			value<size_t>()
+				->value_name   ( num_varname                                     )
+				->notifier     ( max_dp_hits_notifier                            ),
+			( "Resolve any query with more than " + num_varname + " hits using the naive, greedy approach"
+				+ "\n(such queries are flagged in the results and the summary; default: no maximum)" ).c_str()
+		)
+		(
+			string( PO_MAX_DP_WORK ).c_str(),
+			value<size_t>()
+				->value_name   ( num_varname                                     )
+				->notifier     ( max_dp_work_notifier                            ),
+			( "Abandon resolving any query that takes more than " + num_varname + " work units and use the naive, greedy approach instead"
+				+ "\n(a work unit is one hit considered by the dynamic-programming; default: no maximum)" ).c_str()
 		);
 
 	static_assert( ! crh_score_spec::DEFAULT_APPLY_CATH_RULES,
@@ -116,6 +135,8 @@ str_view_vec crh_score_options_block::do_get_all_options_names() const {
 		PO_LONG_DOMAINS_PREFERENCE,
 		PO_HIGH_SCORES_PREFERENCE,
 		PO_APPLY_CATH_RULES,
+		PO_MAX_DP_HITS,
+		PO_MAX_DP_WORK,
 	};
 }
 
@@ -57,6 +57,12 @@ namespace cath::rslv {
 
 		/// \brief The option name for whether to use a naive, greedy approach to resolving
 		static constexpr ::std::string_view PO_NAIVE_GREEDY{ "naive-greedy" };
+
+		/// \brief The option name for the maximum number of hits for which to attempt dynamic-programming
+		static constexpr ::std::string_view PO_MAX_DP_HITS{ "max-dp-hits" };
+
+		/// \brief The option name for the maximum number of work units that dynamic-programming may use for a query
+		static constexpr ::std::string_view PO_MAX_DP_WORK{ "max-dp-work" };
 	};
 
 } // namespace cath::rslv
@@ -22,7 +22,10 @@
 
 #include <filesystem>
 
+#include "cath/common/thread/parallel_for_each_index.hpp"
+
 using namespace ::cath;
+using namespace ::cath::common;
 using namespace ::cath::rslv;
 using namespace ::cath::seq;
 
@@ -55,6 +58,16 @@ const bool & crh_input_spec::get_input_hits_are_grouped() const {
 	return input_hits_are_grouped;
 }
 
+/// \brief Getter for the number of worker threads with which to parse and resolve queries (or 0 to use the hardware concurrency)
+const size_t & crh_input_spec::get_num_threads() const {
+	return num_threads;
+}
+
+/// \brief Getter for the approximate memory, in megabytes, above which ungrouped hits are spilled to temporary files (or 0 for no limit)
+const size_t & crh_input_spec::get_max_memory() const {
+	return max_memory;
+}
+
 /// \brief Setter for the input file from which data should be read
 crh_input_spec & crh_input_spec::set_input_file(const path &prm_input_file ///< The input file from which data should be read
                                                 ) {
@@ -90,6 +103,20 @@ crh_input_spec & crh_input_spec::set_input_hits_are_grouped(const bool &prm_inpu
 	return *this;
 }
 
+/// \brief Setter for the number of worker threads with which to parse and resolve queries (or 0 to use the hardware concurrency)
+crh_input_spec & crh_input_spec::set_num_threads(const size_t &prm_num_threads ///< The number of worker threads with which to parse and resolve queries (or 0 to use the hardware concurrency)
+                                                 ) {
+	num_threads = prm_num_threads;
+	return *this;
+}
+
+/// \brief Setter for the approximate memory, in megabytes, above which ungrouped hits are spilled to temporary files (or 0 for no limit)
+crh_input_spec & crh_input_spec::set_max_memory(const size_t &prm_max_memory ///< The approximate memory, in megabytes, above which ungrouped hits are spilled to temporary files (or 0 for no limit)
+                                                ) {
+	max_memory = prm_max_memory;
+	return *this;
+}
+
 /// \brief Generate a description of any problem that makes the specified crh_input_spec invalid
 ///        or nullopt otherwise
 ///
@@ -102,3 +129,33 @@ str_opt cath::rslv::get_invalid_description(const crh_input_spec &prm_spec ///<
 
 	return nullopt;
 }
+
+/// \brief Get the number of worker threads with which the input should be parsed
+///        (or 1 to parse on the calling thread)
+///
+/// The --threads budget is shared between parsing and resolving: only HMMER domtblout input
+/// is parsed on worker threads and then only if there are at least four threads to split
+/// (so that each pool gets at least two). Otherwise parsing stays on the calling thread.
+///
+/// \relates crh_input_spec
+size_t cath::rslv::get_num_parse_threads(const crh_input_spec &prm_spec ///< The crh_input_spec to query
+                                         ) {
+	const size_t total_num_threads = num_threads_to_use( prm_spec.get_num_threads() );
+	if ( prm_spec.get_input_format() != hits_input_format_tag::HMMER_DOMTBLOUT || total_num_threads < 4 ) {
+		return 1;
+	}
+	return total_num_threads / 2;
+}
+
+/// \brief Get the number of worker threads with which queries should be resolved
+///
+/// This is whatever's left of the --threads budget after get_num_parse_threads()
+///
+/// \relates crh_input_spec
+size_t cath::rslv::get_num_resolve_threads(const crh_input_spec &prm_spec ///< The crh_input_spec to query
+                                           ) {
+	const size_t total_num_threads = num_threads_to_use( prm_spec.get_num_threads() );
+	const size_t num_parse_threads = get_num_parse_threads( prm_spec );
+	return ( num_parse_threads > 1 ) ? total_num_threads - num_parse_threads
+	                                 : total_num_threads;
+}
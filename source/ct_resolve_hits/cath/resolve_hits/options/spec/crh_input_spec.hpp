@@ -47,6 +47,12 @@ namespace cath::rslv {
 		/// \brief Whether the code can assume that the input data is pre-grouped by query_id
 		bool                  input_hits_are_grouped = DEFAULT_INPUT_HITS_ARE_GROUPED;
 
+		/// \brief The number of worker threads with which to parse and resolve queries (or 0 to use the hardware concurrency)
+		size_t                num_threads            = DEFAULT_NUM_THREADS;
+
+		/// \brief The approximate memory, in megabytes, above which ungrouped hits are spilled to temporary files (or 0 for no limit)
+		size_t                max_memory             = DEFAULT_MAX_MEMORY;
+
 	public:
 		/// \brief The default value for whether to read the input data from stdin
 		static constexpr bool                  DEFAULT_READ_FROM_STDIN        = false;
@@ -60,21 +66,36 @@ namespace cath::rslv {
 		/// \brief The default value for whether the code can assume that the input data is pre-grouped by query_id
 		static constexpr bool                  DEFAULT_INPUT_HITS_ARE_GROUPED = false;
 
+		/// \brief The default value for the number of worker threads with which to parse and resolve queries
+		static constexpr size_t                DEFAULT_NUM_THREADS            = 1;
+
+		/// \brief The default value for the approximate memory, in megabytes, above which ungrouped hits are spilled to temporary files
+		///
+		/// This is 0, meaning no limit (so all hits are always held in memory)
+		static constexpr size_t                DEFAULT_MAX_MEMORY             = 0;
+
 		[[nodiscard]] const path_opt &             get_input_file() const;
 		[[nodiscard]] const bool &                 get_read_from_stdin() const;
 		[[nodiscard]] const hits_input_format_tag &get_input_format() const;
 		[[nodiscard]] const seq::residx_t &        get_min_gap_length() const;
 		[[nodiscard]] const bool &                 get_input_hits_are_grouped() const;
+		[[nodiscard]] const size_t &               get_num_threads() const;
+		[[nodiscard]] const size_t &               get_max_memory() const;
 
 		crh_input_spec & set_input_file(const ::std::filesystem::path &);
 		crh_input_spec & set_read_from_stdin(const bool &);
 		crh_input_spec & set_input_format(const hits_input_format_tag &);
 		crh_input_spec & set_min_gap_length(const seq::residx_t &);
 		crh_input_spec & set_input_hits_are_grouped(const bool &);
+		crh_input_spec & set_num_threads(const size_t &);
+		crh_input_spec & set_max_memory(const size_t &);
 	};
 
 	str_opt get_invalid_description(const crh_input_spec &);
 
+	size_t get_num_parse_threads(const crh_input_spec &);
+	size_t get_num_resolve_threads(const crh_input_spec &);
+
 } // namespace cath::rslv
 
 #endif // CATH_TOOLS_SOURCE_CT_RESOLVE_HITS_CATH_RESOLVE_HITS_OPTIONS_SPEC_CRH_INPUT_SPEC_HPP
@@ -0,0 +1,42 @@
+/// \file
+/// \brief The crh_input_spec test suite
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <boost/test/unit_test.hpp>
+
+#include "cath/resolve_hits/options/spec/crh_input_spec.hpp"
+
+using namespace ::cath::rslv;
+
+BOOST_AUTO_TEST_SUITE(crh_input_spec_test_suite)
+
+BOOST_AUTO_TEST_CASE(only_splits_threads_for_domtblout_with_enough_threads) {
+	const crh_input_spec raw_spec       = crh_input_spec{}.set_input_format( hits_input_format_tag::RAW_WITH_SCORES ).set_num_threads( 8 );
+	const crh_input_spec few_spec       = crh_input_spec{}.set_input_format( hits_input_format_tag::HMMER_DOMTBLOUT ).set_num_threads( 3 );
+	const crh_input_spec domtblout_spec = crh_input_spec{}.set_input_format( hits_input_format_tag::HMMER_DOMTBLOUT ).set_num_threads( 7 );
+
+	BOOST_CHECK_EQUAL( get_num_parse_threads  ( raw_spec       ), 1 );
+	BOOST_CHECK_EQUAL( get_num_resolve_threads( raw_spec       ), 8 );
+	BOOST_CHECK_EQUAL( get_num_parse_threads  ( few_spec       ), 1 );
+	BOOST_CHECK_EQUAL( get_num_resolve_threads( few_spec       ), 3 );
+	BOOST_CHECK_EQUAL( get_num_parse_threads  ( domtblout_spec ), 3 );
+	BOOST_CHECK_EQUAL( get_num_resolve_threads( domtblout_spec ), 4 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -74,6 +74,11 @@ const path_vec & crh_output_spec::get_json_output_files() const {
 	return json_output_files;
 }
 
+/// \brief Getter for any files to which all the input hits should be output in the binary hits format
+const path_vec & crh_output_spec::get_binary_hits_files() const {
+	return binary_hits_files;
+}
+
 /// \brief Getter for any files to which the HTML's CSS should be output
 const path_opt & crh_output_spec::get_export_css_file() const {
 	return export_css_file;
@@ -126,6 +131,13 @@ crh_output_spec & crh_output_spec::set_json_output_files(const path_vec &prm_jso
 	return *this;
 }
 
+/// \brief Setter for any files to which all the input hits should be output in the binary hits format
+crh_output_spec & crh_output_spec::set_binary_hits_files(const path_vec &prm_binary_hits_files ///< Any files to which all the input hits should be output in the binary hits format
+                                                         ) {
+	binary_hits_files = prm_binary_hits_files;
+	return *this;
+}
+
 /// \brief Setter for any files to which the HTML's CSS should be output
 crh_output_spec & crh_output_spec::set_export_css_file(const path_opt &prm_export_css_file ///< Any files to which the HTML's CSS should be output
                                                        ) {
@@ -171,6 +183,8 @@ bool cath::rslv::has_any_out_files_matching(const crh_output_spec &prm_output_sp
 		||
 		contains( prm_output_spec.get_json_output_files(), prm_query_path )
 		||
+		contains( prm_output_spec.get_binary_hits_files(), prm_query_path )
+		||
 		( prm_output_spec.get_export_css_file() == prm_query_path )
 	);
 }
@@ -185,6 +199,7 @@ path_vec cath::rslv::get_all_output_paths(const crh_output_spec &prm_output_spec
 	append( the_paths, prm_output_spec.get_summarise_files()   );
 	append( the_paths, prm_output_spec.get_html_output_files() );
 	append( the_paths, prm_output_spec.get_json_output_files() );
+	append( the_paths, prm_output_spec.get_binary_hits_files() );
 	if ( prm_output_spec.get_export_css_file() ) {
 		the_paths.push_back( *prm_output_spec.get_export_css_file() );
 	}
@@ -50,6 +50,9 @@ namespace cath::rslv {
 		/// \brief Any files to which JSON should be output
 		path_vec            json_output_files;
 
+		/// \brief Any files to which all the input hits should be output in the binary hits format
+		path_vec            binary_hits_files;
+
 		/// \brief Any files to which the HTML's CSS should be output
 		path_opt            export_css_file;
 
@@ -72,6 +75,7 @@ namespace cath::rslv {
 		[[nodiscard]] const path_vec &           get_summarise_files() const;
 		[[nodiscard]] const path_vec &           get_html_output_files() const;
 		[[nodiscard]] const path_vec &           get_json_output_files() const;
+		[[nodiscard]] const path_vec &           get_binary_hits_files() const;
 		[[nodiscard]] const path_opt &           get_export_css_file() const;
 		[[nodiscard]] const bool &               get_output_hmmer_aln() const;
 
@@ -81,6 +85,7 @@ namespace cath::rslv {
 		crh_output_spec & set_summarise_files(const path_vec &);
 		crh_output_spec & set_html_output_files(const path_vec &);
 		crh_output_spec & set_json_output_files(const path_vec &);
+		crh_output_spec & set_binary_hits_files(const path_vec &);
 		crh_output_spec & set_export_css_file(const path_opt &);
 		crh_output_spec & set_output_hmmer_aln(const bool &);
 	};
@@ -20,6 +20,7 @@
 
 #include "crh_score_spec.hpp"
 
+using namespace ::cath;
 using namespace ::cath::rslv;
 
 /// \brief Ctor
@@ -53,6 +54,16 @@ const bool & crh_score_spec::get_naive_greedy() const {
 	return naive_greedy;
 }
 
+/// \brief Getter for the optional maximum number of hits for which to attempt dynamic-programming
+const size_opt & crh_score_spec::get_max_dp_hits() const {
+	return max_dp_hits;
+}
+
+/// \brief Getter for the optional maximum number of work units that dynamic-programming may use for a query
+const size_opt & crh_score_spec::get_max_dp_work() const {
+	return max_dp_work;
+}
+
 /// \brief Setter for the degree to which long domains are preferred
 crh_score_spec & crh_score_spec::set_long_domains_preference(const resscr_t &prm_long_domains_preference ///< The degree to which long domains are preferred
                                                              ) {
@@ -81,6 +92,20 @@ crh_score_spec & crh_score_spec::set_naive_greedy(const bool &prm_naive_greedy /
 	return *this;
 }
 
+/// \brief Setter for the optional maximum number of hits for which to attempt dynamic-programming
+crh_score_spec & crh_score_spec::set_max_dp_hits(const size_opt &prm_max_dp_hits ///< The optional maximum number of hits for which to attempt dynamic-programming
+                                                 ) {
+	max_dp_hits = prm_max_dp_hits;
+	return *this;
+}
+
+/// \brief Setter for the optional maximum number of work units that dynamic-programming may use for a query
+crh_score_spec & crh_score_spec::set_max_dp_work(const size_opt &prm_max_dp_work ///< The optional maximum number of work units that dynamic-programming may use for a query
+                                                 ) {
+	max_dp_work = prm_max_dp_work;
+	return *this;
+}
+
 /// \brief Make a neutral crh_score_spec
 ///
 /// \relates crh_score_spec
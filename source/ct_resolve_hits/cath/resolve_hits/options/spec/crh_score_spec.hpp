@@ -40,6 +40,13 @@ namespace cath::rslv {
 		/// \brief Whether to use a naive, greedy approach to resolving
 		bool     naive_greedy            = DEFAULT_NAIVE_GREEDY;
 
+		/// \brief An optional maximum number of hits for which to attempt dynamic-programming
+		///        (queries with more hits fall back to the naive, greedy approach)
+		size_opt max_dp_hits;
+
+		/// \brief An optional maximum number of work units that dynamic-programming may use for a query
+		///        before it's abandoned in favour of the naive, greedy approach
+		size_opt max_dp_work;
 
 	public:
 		/// \brief The default value for the degree to which long domains are preferred
@@ -70,11 +77,15 @@ namespace cath::rslv {
 		[[nodiscard]] const resscr_t &get_high_scores_preference() const;
 		[[nodiscard]] const bool &    get_apply_cath_rules() const;
 		[[nodiscard]] const bool &    get_naive_greedy() const;
+		[[nodiscard]] const size_opt &get_max_dp_hits() const;
+		[[nodiscard]] const size_opt &get_max_dp_work() const;
 
 		crh_score_spec & set_long_domains_preference(const resscr_t &);
 		crh_score_spec & set_high_scores_preference(const resscr_t &);
 		crh_score_spec & set_apply_cath_rules(const bool &);
 		crh_score_spec & set_naive_greedy(const bool &);
+		crh_score_spec & set_max_dp_hits(const size_opt &);
+		crh_score_spec & set_max_dp_work(const size_opt &);
 	};
 
 	crh_score_spec make_neutral_score_spec();
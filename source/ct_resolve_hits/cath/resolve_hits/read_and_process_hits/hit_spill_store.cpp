@@ -0,0 +1,378 @@
+/// \file
+/// \brief The hit_spill_store class definitions
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "hit_spill_store.hpp"
+
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <queue>
+#include <type_traits>
+#include <variant>
+
+#include "cath/common/exception/invalid_argument_exception.hpp"
+#include "cath/common/exception/runtime_error_exception.hpp"
+#include "cath/common/file/open_fstream.hpp"
+#include "cath/resolve_hits/hit_extras.hpp"
+#include "cath/seq/seq_arrow.hpp"
+#include "cath/seq/seq_seg.hpp"
+
+using namespace ::cath;
+using namespace ::cath::common;
+using namespace ::cath::rslv;
+using namespace ::cath::rslv::detail;
+using namespace ::cath::seq;
+
+using ::std::greater;
+using ::std::min;
+using ::std::ifstream;
+using ::std::ios_base;
+using ::std::istream;
+using ::std::ofstream;
+using ::std::ostream;
+using ::std::pair;
+using ::std::priority_queue;
+using ::std::string;
+using ::std::string_view;
+using ::std::vector;
+
+namespace {
+
+	/// \brief The approximate number of bytes of bookkeeping used to hold each hit, beyond the full_hit itself
+	///
+	/// This roughly covers the full_hit_prune_builder's deque and its hash-map node for the hit
+	/// (the hit's label is interned in read_and_process_mgr's pool, the memory of which
+	/// read_and_process_mgr counts separately)
+	constexpr size_t HIT_OVERHEAD_BYTES = 64;
+
+	/// \brief Write the specified trivially-copyable value to the specified ostream in the native binary representation
+	template <typename T>
+	void write_spill_value(ostream &prm_ostream, ///< The ostream to which the value should be written
+	                       const T &prm_value    ///< The value to write
+	                       ) {
+		static_assert( std::is_trivially_copyable_v<T>, "write_spill_value() can only write trivially copyable values" );
+		prm_ostream.write( reinterpret_cast<const char *>( &prm_value ), sizeof( T ) );
+	}
+
+	/// \brief Read a trivially-copyable value of the specified type from the specified istream
+	///        or throw a runtime_error_exception if that fails
+	template <typename T>
+	T read_spill_value(istream &prm_istream ///< The istream from which the value should be read
+	                   ) {
+		static_assert( std::is_trivially_copyable_v<T>, "read_spill_value() can only read trivially copyable values" );
+		T value{};
+		if ( ! prm_istream.read( reinterpret_cast<char *>( &value ), sizeof( T ) ) ) {
+			BOOST_THROW_EXCEPTION(runtime_error_exception("Unable to read back hits that were spilled to a temporary file"));
+		}
+		return value;
+	}
+
+	/// \brief Write the specified string to the specified ostream as its length followed by its characters
+	void write_spill_string(ostream           &prm_ostream, ///< The ostream to which the string should be written
+	                        const string_view &prm_string   ///< The string to write
+	                        ) {
+		write_spill_value( prm_ostream, static_cast<uint64_t>( prm_string.length() ) );
+		prm_ostream.write( prm_string.data(), static_cast<std::streamsize>( prm_string.length() ) );
+	}
+
+	/// \brief Read a string (as written by write_spill_string()) from the specified istream
+	///        or throw a runtime_error_exception if that fails
+	string read_spill_string(istream &prm_istream ///< The istream from which the string should be read
+	                         ) {
+		string result( static_cast<size_t>( read_spill_value<uint64_t>( prm_istream ) ), '\0' );
+		if ( ! prm_istream.read( result.data(), static_cast<std::streamsize>( result.length() ) ) ) {
+			BOOST_THROW_EXCEPTION(runtime_error_exception("Unable to read back a string that was spilled to a temporary file"));
+		}
+		return result;
+	}
+
+	/// \brief Write the specified full_hit to the specified ostream
+	void write_spill_hit(ostream        &prm_ostream, ///< The ostream to which the hit should be written
+	                     const full_hit &prm_hit      ///< The hit to write
+	                     ) {
+		write_spill_value( prm_ostream, static_cast<uint64_t>( prm_hit.get_segments().size() ) );
+		for (const seq_seg &the_seg : prm_hit.get_segments()) {
+			write_spill_value( prm_ostream, the_seg.get_start_arrow().get_index() );
+			write_spill_value( prm_ostream, the_seg.get_stop_arrow ().get_index() );
+		}
+		write_spill_string( prm_ostream, prm_hit.get_label()      );
+		write_spill_value ( prm_ostream, prm_hit.get_score()      );
+		write_spill_value ( prm_ostream, prm_hit.get_score_type() );
+
+		write_spill_value( prm_ostream, static_cast<uint64_t>( prm_hit.get_extras_store().size() ) );
+		for (const hit_extra_cat_var_pair &the_extra : prm_hit.get_extras_store()) {
+			write_spill_value( prm_ostream, the_extra.first                                   );
+			write_spill_value( prm_ostream, static_cast<uint8_t>( the_extra.second.index() ) );
+			if ( const auto *string_ptr = std::get_if<string>( &the_extra.second ) ) {
+				write_spill_string( prm_ostream, *string_ptr );
+			}
+			else {
+				write_spill_value( prm_ostream, std::get<double>( the_extra.second ) );
+			}
+		}
+	}
+
+	/// \brief Read a full_hit (as written by write_spill_hit()) from the specified istream
+	///        or throw a runtime_error_exception if that fails
+	full_hit read_spill_hit(istream                                     &prm_istream,   ///< The istream from which the hit should be read
+	                        const std::shared_ptr<string_intern_pool> &prm_label_pool ///< The pool in which to intern the hit's label
+	                        ) {
+		const auto num_segments = static_cast<size_t>( read_spill_value<uint64_t>( prm_istream ) );
+		seq_seg_vec segments;
+		segments.reserve( num_segments );
+		for (size_t seg_ctr = 0; seg_ctr < num_segments; ++seg_ctr) {
+			const auto start_index = read_spill_value<resarw_t>( prm_istream );
+			const auto stop_index  = read_spill_value<resarw_t>( prm_istream );
+			segments.emplace_back( arrow_before_res( start_index ), arrow_before_res( stop_index ) );
+		}
+		const string label    = read_spill_string( prm_istream );
+		const auto score      = read_spill_value<double        >( prm_istream );
+		const auto score_type = read_spill_value<hit_score_type>( prm_istream );
+
+		hit_extras_store extras;
+		const auto num_extras = static_cast<size_t>( read_spill_value<uint64_t>( prm_istream ) );
+		for (size_t extra_ctr = 0; extra_ctr < num_extras; ++extra_ctr) {
+			const auto cat         = read_spill_value<hit_extra_cat>( prm_istream );
+			const auto value_index = read_spill_value<uint8_t      >( prm_istream );
+			switch ( cat ) {
+				case ( hit_extra_cat::ALND_RGNS ) : {
+					if ( value_index == 0 ) {
+						extras.push_back<hit_extra_cat::ALND_RGNS>( read_spill_string( prm_istream ) );
+						continue;
+					}
+					break;
+				}
+				case ( hit_extra_cat::COND_EVAL ) : {
+					if ( value_index == 1 ) {
+						extras.push_back<hit_extra_cat::COND_EVAL>( read_spill_value<double>( prm_istream ) );
+						continue;
+					}
+					break;
+				}
+				case ( hit_extra_cat::INDP_EVAL ) : {
+					if ( value_index == 1 ) {
+						extras.push_back<hit_extra_cat::INDP_EVAL>( read_spill_value<double>( prm_istream ) );
+						continue;
+					}
+					break;
+				}
+			}
+			BOOST_THROW_EXCEPTION(runtime_error_exception("Unrecognised hit extra information in hits that were spilled to a temporary file"));
+		}
+
+		return {
+			prm_label_pool,
+			std::move( segments ),
+			label,
+			score,
+			score_type,
+			std::move( extras   )
+		};
+	}
+
+	/// \brief Write the specified query's ID and hits to the specified ostream as an entry in a run
+	template <typename HITS>
+	void write_spill_query(ostream           &prm_ostream,  ///< The ostream to which the query should be written
+	                       const string_view &prm_query_id, ///< The ID of the query
+	                       const HITS        &prm_hits      ///< The query's hits (a full_hit_list or full_hit_vec)
+	                       ) {
+		write_spill_string( prm_ostream, prm_query_id );
+		write_spill_value ( prm_ostream, static_cast<uint64_t>( prm_hits.size() ) );
+		for (const full_hit &the_hit : prm_hits) {
+			write_spill_hit( prm_ostream, the_hit );
+		}
+	}
+
+	/// \brief Close the specified ofstream to which a run has been written
+	///        or throw a runtime_error_exception if writing failed
+	void close_run_ofstream(ofstream        &prm_ofstream, ///< The ofstream to close
+	                        const temp_file &prm_file      ///< The temporary file to which the ofstream was writing
+	                        ) {
+		prm_ofstream.close();
+		if ( ! prm_ofstream ) {
+			BOOST_THROW_EXCEPTION(runtime_error_exception(
+				"Unable to write hits to temporary file " + get_filename( prm_file ).string()
+			));
+		}
+	}
+
+	/// \brief A reader for one run, which keeps track of the next query in the run (if any)
+	struct spill_run_reader final {
+		/// \brief The ifstream from which the run is being read
+		ifstream run_ifstream;
+
+		/// \brief The ID of the next query in the run
+		string next_query_id;
+
+		/// \brief The number of hits for the next query in the run
+		size_t next_num_hits = 0;
+
+		/// \brief Ctor from the ifstream from which the run should be read
+		explicit spill_run_reader(ifstream prm_run_ifstream ///< The ifstream from which the run should be read
+		                          ) : run_ifstream{ std::move( prm_run_ifstream ) } {
+		}
+
+		/// \brief Read the ID and number of hits of the next query in the run and return
+		///        whether there was one (or false if the end of the run has been reached)
+		bool read_next_query() {
+			if ( run_ifstream.peek() == ifstream::traits_type::eof() ) {
+				return false;
+			}
+			next_query_id = read_spill_string( run_ifstream );
+			next_num_hits = static_cast<size_t>( read_spill_value<uint64_t>( run_ifstream ) );
+			return true;
+		}
+
+		/// \brief Append the hits for the next query in the run to the specified full_hit_vec
+		void append_next_hits(full_hit_vec                              &prm_hits,      ///< The full_hit_vec to which the hits should be appended
+		                      const std::shared_ptr<string_intern_pool> &prm_label_pool ///< The pool in which to intern the hits' labels
+		                      ) {
+			prm_hits.reserve( prm_hits.size() + next_num_hits );
+			for (size_t hit_ctr = 0; hit_ctr < next_num_hits; ++hit_ctr) {
+				prm_hits.push_back( read_spill_hit( run_ifstream, prm_label_pool ) );
+			}
+		}
+	};
+
+} // namespace
+
+/// \brief Ctor from the maximum number of runs to read at once whilst merging
+hit_spill_store::hit_spill_store(const size_t &prm_max_fan_in ///< The maximum number of runs to read at once whilst merging (must be at least 2)
+                                 ) : max_fan_in{ prm_max_fan_in } {
+	if ( max_fan_in < 2 ) {
+		BOOST_THROW_EXCEPTION(invalid_argument_exception("Cannot merge hits spilled to temporary files with a maximum fan-in of less than 2"));
+	}
+}
+
+/// \brief Merge the runs in run_files with indices in [ prm_begin, prm_end ), passing each query's ID
+///        and hits to the specified function in sorted order of query ID
+///
+/// The hits for each query are passed in the order of the runs and then in their order within each run.
+void hit_spill_store::merge_run_group(const size_t                              &prm_begin,      ///< The index of the first run to merge
+                                      const size_t                              &prm_end,        ///< One past the index of the last run to merge
+                                      const std::shared_ptr<string_intern_pool> &prm_label_pool, ///< The pool in which to intern the hits' labels
+                                      const spilled_query_hits_fn               &prm_fn          ///< The function to which each query's ID and hits should be passed
+                                      ) {
+	vector<spill_run_reader> readers;
+	readers.reserve( prm_end - prm_begin );
+	for (size_t run_ctr = prm_begin; run_ctr < prm_end; ++run_ctr) {
+		readers.emplace_back( open_ifstream( get_filename( run_files[ run_ctr ] ), ios_base::in | ios_base::binary ) );
+	}
+
+	// A min-heap of the next query ID in each run, tie-broken by the run index to preserve the run order
+	using str_size_pair = pair<string, size_t>;
+	priority_queue<str_size_pair, vector<str_size_pair>, greater<>> next_queries;
+	for (size_t reader_ctr = 0; reader_ctr < readers.size(); ++reader_ctr) {
+		if ( readers[ reader_ctr ].read_next_query() ) {
+			next_queries.emplace( readers[ reader_ctr ].next_query_id, reader_ctr );
+		}
+	}
+
+	while ( ! next_queries.empty() ) {
+		string       query_id = next_queries.top().first;
+		full_hit_vec hits;
+		while ( ! next_queries.empty() && next_queries.top().first == query_id ) {
+			const size_t reader_index = next_queries.top().second;
+			next_queries.pop();
+			spill_run_reader &the_reader = readers[ reader_index ];
+			the_reader.append_next_hits( hits, prm_label_pool );
+			if ( the_reader.read_next_query() ) {
+				next_queries.emplace( the_reader.next_query_id, reader_index );
+			}
+		}
+		prm_fn( std::move( query_id ), std::move( hits ) );
+	}
+}
+
+/// \brief Whether no runs have been added since the store was created or last merged
+bool hit_spill_store::empty() const {
+	return run_files.empty();
+}
+
+/// \brief The number of runs that have been added since the store was created or last merged
+size_t hit_spill_store::num_runs() const {
+	return run_files.size();
+}
+
+/// \brief Write the specified hits to a new run in a new temporary file
+///
+/// \pre The entries must be sorted by query ID, with no query ID repeated
+void hit_spill_store::add_run(const str_full_hit_list_pair_vec &prm_run ///< The queries' hits to write, sorted by query ID
+                              ) {
+	const temp_file &the_file = run_files.emplace_back( TEMP_FILE_PATTERN );
+	ofstream run_ofstream = open_ofstream( get_filename( the_file ), ios_base::out | ios_base::binary );
+	for (const str_full_hit_list_pair &query_hits : prm_run) {
+		write_spill_query( run_ofstream, query_hits.first, query_hits.second );
+	}
+	close_run_ofstream( run_ofstream, the_file );
+}
+
+/// \brief Merge all the runs, passing each query's ID and hits to the specified function
+///        in sorted order of query ID, and then remove the runs
+///
+/// The hits for each query are passed in the order of the runs and then in their order within each run.
+///
+/// At most max_fan_in runs are open at once: if there are more runs, consecutive groups are first merged
+/// into new runs (which may take several passes).
+void hit_spill_store::merge_runs(const std::shared_ptr<string_intern_pool> &prm_label_pool, ///< The pool in which to intern the hits' labels
+                                 const spilled_query_hits_fn               &prm_fn          ///< The function to which each query's ID and hits should be passed
+                                 ) {
+	// Whilst there are too many runs to read at once, merge consecutive groups of runs into new runs
+	// (appended in order, so that the run order is preserved) and then remove the old runs
+	while ( run_files.size() > max_fan_in ) {
+		const size_t num_old_runs = run_files.size();
+		for (size_t group_begin = 0; group_begin < num_old_runs; group_begin += max_fan_in) {
+			const temp_file &merged_file = run_files.emplace_back( TEMP_FILE_PATTERN );
+			ofstream merged_ofstream = open_ofstream( get_filename( merged_file ), ios_base::out | ios_base::binary );
+			merge_run_group(
+				group_begin,
+				min( group_begin + max_fan_in, num_old_runs ),
+				prm_label_pool,
+				[&] (const string &prm_query_id, const full_hit_vec &prm_hits) {
+					write_spill_query( merged_ofstream, prm_query_id, prm_hits );
+				}
+			);
+			close_run_ofstream( merged_ofstream, merged_file );
+		}
+		for (size_t run_ctr = 0; run_ctr < num_old_runs; ++run_ctr) {
+			run_files.pop_front();
+		}
+	}
+
+	merge_run_group( 0, run_files.size(), prm_label_pool, prm_fn );
+	run_files.clear();
+}
+
+/// \brief Get an approximate number of bytes of memory used to hold the specified full_hit
+///        (and the bookkeeping for it) whilst the hits are being read
+///
+/// This needn't be accurate: it's only used to decide when to spill hits to disk.
+size_t cath::rslv::detail::approx_held_bytes(const full_hit &prm_hit ///< The full_hit to assess
+                                             ) {
+	size_t num_bytes = sizeof( full_hit ) + HIT_OVERHEAD_BYTES
+		+ ( prm_hit.get_segments().capacity() * sizeof( seq_seg ) )
+		+ ( prm_hit.get_extras_store().size() * sizeof( hit_extra_cat_var_pair ) );
+	for (const hit_extra_cat_var_pair &the_extra : prm_hit.get_extras_store()) {
+		if ( const auto *string_ptr = std::get_if<string>( &the_extra.second ) ) {
+			num_bytes += string_ptr->capacity();
+		}
+	}
+	return num_bytes;
+}
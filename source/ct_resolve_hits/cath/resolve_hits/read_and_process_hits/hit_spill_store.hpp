@@ -0,0 +1,101 @@
+/// \file
+/// \brief The hit_spill_store class header
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef CATH_TOOLS_SOURCE_CT_RESOLVE_HITS_CATH_RESOLVE_HITS_READ_AND_PROCESS_HITS_HIT_SPILL_STORE_HPP
+#define CATH_TOOLS_SOURCE_CT_RESOLVE_HITS_CATH_RESOLVE_HITS_READ_AND_PROCESS_HITS_HIT_SPILL_STORE_HPP
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "cath/common/file/temp_file.hpp"
+#include "cath/common/string/string_intern_pool.hpp"
+#include "cath/resolve_hits/full_hit.hpp"
+#include "cath/resolve_hits/full_hit_list.hpp"
+#include "cath/resolve_hits/resolve_hits_type_aliases.hpp"
+
+namespace cath::rslv::detail {
+
+	/// \brief Type alias for a pair of query ID and the hits for that query
+	using str_full_hit_list_pair     = std::pair<std::string, full_hit_list>;
+
+	/// \brief Type alias for a vector of str_full_hit_list_pair values
+	using str_full_hit_list_pair_vec = std::vector<str_full_hit_list_pair>;
+
+	/// \brief Type alias for the function to which hit_spill_store::merge_runs() passes each query's hits
+	using spilled_query_hits_fn      = std::function<void(std::string, full_hit_vec)>;
+
+	/// \brief Store runs of hits in temporary files and then merge them back together by query ID
+	///
+	/// This allows read_and_process_mgr to bound the memory used to hold hits that aren't grouped by query:
+	/// when it's holding too much, it writes all of its queries' hits to a new run (sorted by query ID) and
+	/// starts again. At the end, merge_runs() reads through all the runs together, one query at a time
+	/// (in sorted order of query ID), so at most one query's hits are held in memory at once.
+	///
+	/// To bound the number of files open at once, if there are more than max_fan_in runs, merge_runs()
+	/// first merges consecutive groups of at most max_fan_in runs into new runs (repeatedly, if need be).
+	///
+	/// Within each query, the hits are returned in run order and in their original order within each run.
+	///
+	/// The runs are written in a simple binary encoding that's only intended to be read back
+	/// by the same process and the files are removed when the store is destroyed.
+	class hit_spill_store final {
+	private:
+		/// \brief The temporary files containing the runs, in the order in which they were written
+		///
+		/// This is a deque because temp_file can't be moved
+		std::deque<common::temp_file> run_files;
+
+		/// \brief The maximum number of runs to read at once whilst merging
+		size_t max_fan_in = DEFAULT_MAX_FAN_IN;
+
+		void merge_run_group(const size_t &,
+		                     const size_t &,
+		                     const std::shared_ptr<common::string_intern_pool> &,
+		                     const spilled_query_hits_fn &);
+
+	public:
+		/// \brief The pattern with which to name the temporary files
+		static constexpr const char * TEMP_FILE_PATTERN = "cath-resolve-hits.spill.%%%%-%%%%-%%%%-%%%%";
+
+		/// \brief The default maximum number of runs to read at once whilst merging
+		///
+		/// This keeps the number of open files well below typical per-process limits
+		static constexpr size_t DEFAULT_MAX_FAN_IN = 64;
+
+		explicit hit_spill_store(const size_t & = DEFAULT_MAX_FAN_IN);
+
+		[[nodiscard]] bool empty() const;
+		[[nodiscard]] size_t num_runs() const;
+
+		void add_run(const str_full_hit_list_pair_vec &);
+
+		void merge_runs(const std::shared_ptr<common::string_intern_pool> &,
+		                const spilled_query_hits_fn &);
+	};
+
+	size_t approx_held_bytes(const full_hit &);
+
+} // namespace cath::rslv::detail
+
+#endif // CATH_TOOLS_SOURCE_CT_RESOLVE_HITS_CATH_RESOLVE_HITS_READ_AND_PROCESS_HITS_HIT_SPILL_STORE_HPP
@@ -0,0 +1,155 @@
+/// \file
+/// \brief The hit_spill_store test suite
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "hit_spill_store.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include "cath/common/exception/invalid_argument_exception.hpp"
+#include "cath/common/string/string_intern_pool.hpp"
+#include "cath/common/type_aliases.hpp"
+#include "cath/resolve_hits/hit_extras.hpp"
+#include "cath/seq/seq_seg.hpp"
+
+#include <memory>
+
+using namespace ::cath;
+using namespace ::cath::common;
+using namespace ::cath::rslv;
+using namespace ::cath::rslv::detail;
+using namespace ::cath::seq;
+
+using ::std::string;
+using ::std::vector;
+
+namespace {
+
+	/// \brief The hit_spill_store_test_suite_fixture to assist in testing hit_spill_store
+	struct hit_spill_store_test_suite_fixture {
+	protected:
+		~hit_spill_store_test_suite_fixture() noexcept = default;
+
+		/// \brief A discontinuous hit with a label containing spaces and both sorts of extra information
+		const full_hit hit_a{
+			{ seq_seg{ 9, 57 }, seq_seg{ 135, 174 } },
+			"cath|current|1mfaH01/251-347 i5_1",
+			1494.83332154362,
+			hit_score_type::BITSCORE,
+			hit_extras_store{}
+				.push_back<hit_extra_cat::ALND_RGNS>( "9-57,135-174" )
+				.push_back<hit_extra_cat::COND_EVAL>( 1.6e-07        )
+				.push_back<hit_extra_cat::INDP_EVAL>( 2.2e-05        )
+		};
+
+		/// \brief A continuous hit with no extra information
+		const full_hit hit_b{ { seq_seg{ 8, 108 } }, "2i24N00", 2744.56644492722, hit_score_type::BITSCORE };
+
+		/// \brief A continuous hit with a different type of score
+		const full_hit hit_c{ { seq_seg{ 1, 2   } }, "1yjdC00", 0.5,              hit_score_type::CRH_SCORE };
+
+		/// \brief The pool in which to intern the labels of the merged hits
+		const std::shared_ptr<string_intern_pool> label_pool = std::make_shared<string_intern_pool>();
+	};
+
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE(hit_spill_store_test_suite, hit_spill_store_test_suite_fixture)
+
+BOOST_AUTO_TEST_CASE(merges_runs_by_query_id_in_run_order) {
+	hit_spill_store the_store;
+	BOOST_CHECK( the_store.empty() );
+
+	the_store.add_run( {
+		{ "query_b", full_hit_list{ { hit_a, hit_b } } },
+		{ "query_c", full_hit_list{ { hit_c        } } },
+	} );
+	the_store.add_run( {
+		{ "query_a", full_hit_list{ { hit_b        } } },
+		{ "query_b", full_hit_list{ { hit_c        } } },
+	} );
+	BOOST_CHECK_EQUAL( the_store.num_runs(), 2 );
+
+	str_vec              got_query_ids;
+	vector<full_hit_vec> got_hits;
+	the_store.merge_runs( label_pool, [&] (string prm_query_id, full_hit_vec prm_hits) {
+		got_query_ids.push_back( std::move( prm_query_id ) );
+		got_hits.push_back     ( std::move( prm_hits     ) );
+	} );
+
+	const str_vec expected_query_ids{ "query_a", "query_b", "query_c" };
+	BOOST_CHECK_EQUAL_COLLECTIONS( got_query_ids.begin(), got_query_ids.end(), expected_query_ids.begin(), expected_query_ids.end() );
+	BOOST_REQUIRE_EQUAL( got_hits.size(), 3 );
+	BOOST_CHECK( ( got_hits[ 0 ] == full_hit_vec{ hit_b               } ) );
+	BOOST_CHECK( ( got_hits[ 1 ] == full_hit_vec{ hit_a, hit_b, hit_c } ) );
+	BOOST_CHECK( ( got_hits[ 2 ] == full_hit_vec{ hit_c               } ) );
+	BOOST_CHECK( the_store.empty() );
+}
+
+BOOST_AUTO_TEST_CASE(merges_in_several_passes_when_there_are_more_runs_than_the_max_fan_in) {
+	hit_spill_store the_store{ 2 };
+	for (const full_hit &the_hit : { hit_a, hit_b, hit_c, hit_b, hit_a } ) {
+		the_store.add_run( {
+			{ "query_a", full_hit_list{ { the_hit } } },
+			{ "query_b", full_hit_list{ { the_hit } } },
+		} );
+	}
+	BOOST_CHECK_EQUAL( the_store.num_runs(), 5 );
+
+	str_vec              got_query_ids;
+	vector<full_hit_vec> got_hits;
+	the_store.merge_runs( label_pool, [&] (string prm_query_id, full_hit_vec prm_hits) {
+		got_query_ids.push_back( std::move( prm_query_id ) );
+		got_hits.push_back     ( std::move( prm_hits     ) );
+	} );
+
+	const str_vec expected_query_ids{ "query_a", "query_b" };
+	BOOST_CHECK_EQUAL_COLLECTIONS( got_query_ids.begin(), got_query_ids.end(), expected_query_ids.begin(), expected_query_ids.end() );
+	BOOST_REQUIRE_EQUAL( got_hits.size(), 2 );
+	BOOST_CHECK( ( got_hits[ 0 ] == full_hit_vec{ hit_a, hit_b, hit_c, hit_b, hit_a } ) );
+	BOOST_CHECK( ( got_hits[ 1 ] == full_hit_vec{ hit_a, hit_b, hit_c, hit_b, hit_a } ) );
+	BOOST_CHECK( the_store.empty() );
+}
+
+BOOST_AUTO_TEST_CASE(throws_on_max_fan_in_of_less_than_two) {
+	BOOST_CHECK_THROW( hit_spill_store{ 1 }, invalid_argument_exception );
+}
+
+BOOST_AUTO_TEST_CASE(round_trips_extra_information) {
+	hit_spill_store the_store;
+	the_store.add_run( { { "query", full_hit_list{ { hit_a } } } } );
+
+	full_hit_vec got_hits;
+	the_store.merge_runs( label_pool, [&] (const string &, full_hit_vec prm_hits) { got_hits = std::move( prm_hits ); } );
+	BOOST_REQUIRE_EQUAL( got_hits.size(), 1 );
+	BOOST_CHECK_EQUAL( to_string( got_hits.front().get_extras_store() ), to_string( hit_a.get_extras_store() ) );
+}
+
+BOOST_AUTO_TEST_CASE(interns_the_merged_hits_labels_in_the_specified_pool) {
+	hit_spill_store the_store;
+	the_store.add_run( { { "query", full_hit_list{ { hit_b, hit_c, hit_b } } } } );
+
+	full_hit_vec got_hits;
+	the_store.merge_runs( label_pool, [&] (const string &, full_hit_vec prm_hits) { got_hits = std::move( prm_hits ); } );
+	BOOST_REQUIRE_EQUAL( got_hits.size(), 3 );
+	BOOST_CHECK_EQUAL( label_pool->size(), 2 );
+	BOOST_CHECK      ( got_hits[ 0 ].get_label().data() == got_hits[ 2 ].get_label().data() );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
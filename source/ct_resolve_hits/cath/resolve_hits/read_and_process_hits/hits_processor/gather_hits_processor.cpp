@@ -36,12 +36,14 @@ unique_ptr<hits_processor> gather_hits_processor::do_clone() const {
 
 /// \brief Process the specified data
 ///
-/// This is called directly in process_all_outstanding() and through async in trigger_async_process_query_id()
-void gather_hits_processor::do_process_hits_for_query(const string           &prm_query_id,         ///< The query_protein_id string
-                                                      const crh_filter_spec  &/*prm_filter_spec*/,  ///< The filter_spec to apply to the hits
-                                                      const crh_score_spec   &/*prm_score_spec*/,   ///< The score spec to apply to the hits
-                                                      const crh_segment_spec &/*prm_segment_spec*/, ///< The segment spec to apply to the hits
-                                                      const calc_hit_list    &prm_calc_hits         ///< The hits to process
+/// This is called by read_and_process_mgr on the thread that reads the hits, one query at a time, in the order of the output
+void gather_hits_processor::do_process_hits_for_query(const string              &prm_query_id,          ///< The query_protein_id string
+                                                      const crh_filter_spec     &/*prm_filter_spec*/,   ///< The filter_spec to apply to the hits
+                                                      const crh_score_spec      &/*prm_score_spec*/,    ///< The score spec to apply to the hits
+                                                      const crh_segment_spec    &/*prm_segment_spec*/,  ///< The segment spec to apply to the hits
+                                                      const calc_hit_list       &prm_calc_hits,         ///< The hits to process
+                                                      const scored_hit_arch_opt &/*prm_resolved_arch*/, ///< The result of resolving the hits
+                                                      const hit_resolve_stats   &/*prm_resolve_stats*/  ///< Unused
                                                       ) {
 	hit_lists.get().emplace_back(
 		prm_query_id,
@@ -63,6 +65,11 @@ bool gather_hits_processor::do_requires_strictly_worse_hits() const {
 	return true;
 }
 
+/// \brief Return false: read_and_resolve_mgr needn't resolve the hits before passing them to this processor
+bool gather_hits_processor::do_requires_resolved_hits() const {
+	return false;
+}
+
 /// \brief Ctor from the data structure into which the data should be placed
 gather_hits_processor::gather_hits_processor(str_calc_hit_list_pair_vec &prm_hit_lists ///< The data structure into which the data should be placed
                                              ) noexcept : hit_lists { prm_hit_lists } {
@@ -42,7 +42,9 @@ namespace cath::rslv::detail {
 		                               const crh_filter_spec &,
 		                               const crh_score_spec &,
 		                               const crh_segment_spec &,
-		                               const calc_hit_list &) final;
+		                               const calc_hit_list &,
+		                               const scored_hit_arch_opt &,
+		                               const hit_resolve_stats &) final;
 
 		void do_finish_work() final;
 
@@ -50,6 +52,8 @@ namespace cath::rslv::detail {
 
 		[[nodiscard]] bool do_requires_strictly_worse_hits() const final;
 
+		[[nodiscard]] bool do_requires_resolved_hits() const final;
+
 	  public:
 		explicit gather_hits_processor(str_calc_hit_list_pair_vec &) noexcept;
 	};
@@ -25,6 +25,9 @@
 #include "cath/resolve_hits/calc_hit_list.hpp"
 #include "cath/resolve_hits/options/spec/crh_score_spec.hpp"
 #include "cath/resolve_hits/options/spec/crh_segment_spec.hpp"
+#include "cath/resolve_hits/resolve/hit_resolve_stats.hpp"
+#include "cath/resolve_hits/resolve/hit_resolver.hpp"
+#include "cath/resolve_hits/scored_hit_arch.hpp"
 
 #include <functional>
 #include <iosfwd>
@@ -51,11 +54,16 @@ namespace cath::rslv::detail {
 		[[nodiscard]] virtual std::unique_ptr<hits_processor> do_clone() const = 0;
 
 		/// \brief Pure virtual method with which each concrete hits_processor must define how it processes a new hit for a query
+		///
+		/// The scored_hit_arch_opt contains the result of resolving the hits if do_requires_resolved_hits() returns true
+		/// (and may or may not otherwise). If it's set, the hit_resolve_stats describe how it was resolved.
 		virtual void do_process_hits_for_query(const std::string &,
 		                                       const crh_filter_spec &,
 		                                       const crh_score_spec &,
 		                                       const crh_segment_spec &,
-		                                       const calc_hit_list &) = 0;
+		                                       const calc_hit_list &,
+		                                       const scored_hit_arch_opt &,
+		                                       const hit_resolve_stats &) = 0;
 
 		/// \brief Pure virtual method with which each concrete hits_processor must define how it finishes work
 		virtual void do_finish_work() = 0;
@@ -68,6 +76,13 @@ namespace cath::rslv::detail {
 		///        to see results even if they're strictly worse than other hits in the results
 		[[nodiscard]] virtual bool do_requires_strictly_worse_hits() const = 0;
 
+		/// \brief Pure virtual method with which each concrete hits_processor must define whether it requires
+		///        the hits to have been resolved before they're passed to do_process_hits_for_query()
+		///
+		/// This allows the (expensive) resolving to be done once per query, potentially on a different thread
+		/// from the one that calls do_process_hits_for_query()
+		[[nodiscard]] virtual bool do_requires_resolved_hits() const = 0;
+
 	  protected:
 		const ref_vec<std::ostream> & get_ostreams();
 
@@ -94,9 +109,17 @@ namespace cath::rslv::detail {
 		                            const crh_score_spec &,
 		                            const crh_segment_spec &,
 		                            const calc_hit_list &);
+		void process_hits_for_query(const std::string &,
+		                            const crh_filter_spec &,
+		                            const crh_score_spec &,
+		                            const crh_segment_spec &,
+		                            const calc_hit_list &,
+		                            const scored_hit_arch_opt &,
+		                            const hit_resolve_stats & = hit_resolve_stats{});
 		void finish_work();
 		[[nodiscard]] bool wants_hits_that_fail_score_filter() const;
 		[[nodiscard]] bool requires_strictly_worse_hits() const;
+		[[nodiscard]] bool requires_resolved_hits() const;
 	};
 
 	/// \brief Getter for the ostreams to which results should be written
@@ -134,7 +157,7 @@ namespace cath::rslv::detail {
 			prm_filter_spec
 		};
 		prm_full_hits = full_hit_list{};
-		return do_process_hits_for_query(
+		return process_hits_for_query(
 			prm_query_id,
 			prm_filter_spec,
 			prm_crh_score_spec,
@@ -143,19 +166,56 @@ namespace cath::rslv::detail {
 		);
 	}
 
-	/// \brief NVI pass-through to the virtual do_process_hits_for_query() method
+	/// \brief NVI pass-through to the virtual do_process_hits_for_query() method, first resolving the hits
+	///        if this hits_processor requires that
 	inline void hits_processor::process_hits_for_query(const std::string      &prm_query_id,         ///< The query_protein_id string
 	                                                   const crh_filter_spec  &prm_filter_spec,      ///< The filter spec to apply to hits
 	                                                   const crh_score_spec   &prm_crh_score_spec,   ///< The score spec to apply to incoming hits
 	                                                   const crh_segment_spec &prm_crh_segment_spec, ///< The segment spec to apply to incoming hits
 	                                                   const calc_hit_list    &prm_calc_hits         ///< The calc hits to be processed
 	                                                   ) {
+		if ( ! requires_resolved_hits() ) {
+			return do_process_hits_for_query(
+				prm_query_id,
+				prm_filter_spec,
+				prm_crh_score_spec,
+				prm_crh_segment_spec,
+				prm_calc_hits,
+				scored_hit_arch_opt{},
+				hit_resolve_stats{}
+			);
+		}
+		const auto resolved = resolve_hits_within_budget( prm_calc_hits, prm_crh_score_spec );
+		return do_process_hits_for_query(
+			prm_query_id,
+			prm_filter_spec,
+			prm_crh_score_spec,
+			prm_crh_segment_spec,
+			prm_calc_hits,
+			scored_hit_arch_opt{ resolved.first },
+			resolved.second
+		);
+	}
+
+	/// \brief NVI pass-through to the virtual do_process_hits_for_query() method with hits that have already been resolved
+	///
+	/// \pre `prm_resolved_arch` must be set if `requires_resolved_hits()`
+	inline void hits_processor::process_hits_for_query(const std::string         &prm_query_id,         ///< The query_protein_id string
+	                                                   const crh_filter_spec     &prm_filter_spec,      ///< The filter spec to apply to hits
+	                                                   const crh_score_spec      &prm_crh_score_spec,   ///< The score spec to apply to incoming hits
+	                                                   const crh_segment_spec    &prm_crh_segment_spec, ///< The segment spec to apply to incoming hits
+	                                                   const calc_hit_list       &prm_calc_hits,        ///< The calc hits to be processed
+	                                                   const scored_hit_arch_opt &prm_resolved_arch,    ///< The result of resolving prm_calc_hits (if requires_resolved_hits())
+	                                                   const hit_resolve_stats   &prm_resolve_stats     ///< Statistics on how prm_calc_hits were resolved (if prm_resolved_arch is set)
+	                                                   ) {
 		return do_process_hits_for_query(
 			prm_query_id,
 			prm_filter_spec,
 			prm_crh_score_spec,
 			prm_crh_segment_spec,
-			prm_calc_hits
+			prm_calc_hits,
+			prm_resolved_arch,
+			prm_resolve_stats
 		);
 	}
 
@@ -174,6 +234,11 @@ namespace cath::rslv::detail {
 		return do_requires_strictly_worse_hits();
 	}
 
+	/// \brief NVI pass-through to the virtual do_requires_resolved_hits() method
+	inline bool hits_processor::requires_resolved_hits() const {
+		return do_requires_resolved_hits();
+	}
+
 } // namespace cath::rslv::detail
 
 #endif // CATH_TOOLS_SOURCE_CT_RESOLVE_HITS_CATH_RESOLVE_HITS_READ_AND_PROCESS_HITS_HITS_PROCESSOR_HITS_PROCESSOR_HPP
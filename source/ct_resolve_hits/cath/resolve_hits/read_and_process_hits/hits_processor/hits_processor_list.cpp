@@ -26,6 +26,7 @@
 #include "cath/resolve_hits/options/spec/crh_output_spec.hpp"
 #include "cath/resolve_hits/options/spec/crh_single_output_spec.hpp"
 #include "cath/resolve_hits/read_and_process_hits/hits_processor/summarise_hits_processor.hpp"
+#include "cath/resolve_hits/read_and_process_hits/hits_processor/write_binary_hits_processor.hpp"
 #include "cath/resolve_hits/read_and_process_hits/hits_processor/write_html_hits_processor.hpp"
 #include "cath/resolve_hits/read_and_process_hits/hits_processor/write_json_hits_processor.hpp"
 #include "cath/resolve_hits/read_and_process_hits/hits_processor/write_results_hits_processor.hpp"
@@ -110,6 +111,10 @@ bool hits_processor_list::requires_strictly_worse_hits() const {
 	return any_of( *this, [] (const hits_processor &x) { return x.requires_strictly_worse_hits(); } );
 }
 
+bool hits_processor_list::requires_resolved_hits() const {
+	return any_of( *this, [] (const hits_processor &x) { return x.requires_resolved_hits(); } );
+}
+
 /// \brief Standard const begin() method, as part of making this a range over hits_processors
 ///
 /// Note that this pipes through boost::indirected_range so the range is
@@ -155,6 +160,7 @@ hits_processor_list cath::rslv::detail::make_hits_processors(ofstream_list
 		const path_vec &summarise_files   = prm_output_spec.get_summarise_files();
 		const path_vec &html_output_files = prm_output_spec.get_html_output_files();
 		const path_vec &json_output_files = prm_output_spec.get_json_output_files();
+		const path_vec &binary_hits_files = prm_output_spec.get_binary_hits_files();
 		const path_vec  hits_text_files   = [&] {
 			path_vec temp_hits_text_files = prm_output_spec.get_hits_text_files();
 			if ( ! prm_output_spec.get_quiet() && ! has_any_out_files_matching( prm_output_spec, prm_ofstreams.get_flag() ) ) {
@@ -175,6 +181,9 @@ hits_processor_list cath::rslv::detail::make_hits_processors(ofstream_list
 		if ( ! json_output_files.empty() ) {
 			the_list.add_processor( make_unique< write_json_hits_processor    >( prm_ofstreams.open_ofstreams( json_output_files )                ) );
 		}
+		if ( ! binary_hits_files.empty() ) {
+			the_list.add_processor( make_unique< write_binary_hits_processor  >( prm_ofstreams.open_ofstreams( binary_hits_files )                ) );
+		}
 	}
 	return the_list;
 }
@@ -38,6 +38,26 @@ namespace cath::rslv { class crh_output_spec; }
 
 namespace cath::rslv::detail {
 
+	/// \brief The hits for one query, built into a calc_hit_list and, if required, resolved,
+	///        ready to be passed to the hits_processors in a hits_processor_list
+	///
+	/// This separates the expensive work that can be done for different queries concurrently
+	/// (see hits_processor_list::prepare_hits_for_query()) from the output that must be done
+	/// in order on one thread (see hits_processor_list::process_prepared_hits_for_query())
+	struct prepared_query_hits final {
+		/// \brief The query ID
+		std::string query_id;
+
+		/// \brief The hits for the query
+		calc_hit_list calc_hits;
+
+		/// \brief The result of resolving the hits, if any of the hits_processors requires it
+		scored_hit_arch_opt resolved_arch;
+
+		/// \brief Statistics on how the hits were resolved (if they were)
+		hit_resolve_stats resolve_stats;
+	};
+
 	/// \brief A list of hits_processors to process hits
 	///
 	/// Be careful: this has an initializer_list ctor
@@ -86,6 +106,15 @@ namespace cath::rslv::detail {
 
 		[[nodiscard]] bool requires_strictly_worse_hits() const;
 
+		[[nodiscard]] bool requires_resolved_hits() const;
+
+		[[nodiscard]] prepared_query_hits prepare_hits_for_query(std::string,
+		                                                         const crh_filter_spec &,
+		                                                         full_hit_list) const;
+
+		void process_prepared_hits_for_query(const crh_filter_spec &,
+		                                     const prepared_query_hits &);
+
 		void process_hits_for_query(const std::string &,
 		                            const crh_filter_spec &,
 		                            full_hit_list);
@@ -103,14 +132,17 @@ namespace cath::rslv::detail {
 	                                         const crh_html_spec &);
 
 
-	/// \brief Process the specified full_hit_list for the specified query using the specified crh_filter_spec
+	/// \brief Prepare the specified full_hit_list for the specified query using the specified crh_filter_spec
+	///        so it can be passed to process_prepared_hits_for_query()
 	///
-	/// This builds a calc_hit_list from the specified full_hit_list once and then passes it to each of the hits_processors
-	inline void hits_processor_list::process_hits_for_query(const std::string     &prm_query_id,    ///< The query_protein_id string
-	                                                        const crh_filter_spec &prm_filter_spec, ///< The filter spec to apply to hits
-	                                                        full_hit_list          prm_full_hits    ///< The full hits to be processed
-	                                                        ) {
-		const calc_hit_list the_calc_hit_list{
+	/// This builds a calc_hit_list from the specified full_hit_list and resolves it if any of the hits_processors
+	/// requires that. It doesn't modify any of the hits_processors, so it may be called for different queries
+	/// on different threads concurrently (including concurrently with process_prepared_hits_for_query()).
+	inline prepared_query_hits hits_processor_list::prepare_hits_for_query(std::string            prm_query_id,    ///< The query_protein_id string
+	                                                                       const crh_filter_spec &prm_filter_spec, ///< The filter spec to apply to hits
+	                                                                       full_hit_list          prm_full_hits    ///< The full hits to be processed
+	                                                                       ) const {
+		calc_hit_list the_calc_hit_list{
 			std::move( prm_full_hits ),
 			get_score_spec(),
 			get_segment_spec(),
@@ -124,20 +156,51 @@ namespace cath::rslv::detail {
 			)
 		};
 		prm_full_hits = full_hit_list{};
+		if ( ! requires_resolved_hits() ) {
+			return { std::move( prm_query_id ), std::move( the_calc_hit_list ), scored_hit_arch_opt{}, hit_resolve_stats{} };
+		}
+		auto resolved = resolve_hits_within_budget( the_calc_hit_list, get_score_spec() );
+		return {
+			std::move( prm_query_id ),
+			std::move( the_calc_hit_list ),
+			scored_hit_arch_opt{ std::move( resolved.first ) },
+			resolved.second
+		};
+	}
+
+	/// \brief Pass the specified prepared hits for a query to each of the hits_processors
+	inline void hits_processor_list::process_prepared_hits_for_query(const crh_filter_spec     &prm_filter_spec,  ///< The filter spec to apply to hits
+	                                                                 const prepared_query_hits &prm_prepared_hits ///< The prepared hits to be processed
+	                                                                 ) {
 		boost::for_each(
 			processors,
 			[&] (common::clone_ptr<hits_processor> &x) {
 				x->process_hits_for_query(
-					prm_query_id,
+					prm_prepared_hits.query_id,
 					prm_filter_spec,
 					get_score_spec(),
 					get_segment_spec(),
-					the_calc_hit_list
+					prm_prepared_hits.calc_hits,
+					prm_prepared_hits.resolved_arch,
+					prm_prepared_hits.resolve_stats
 				);
 			}
 		);
 	}
 
+	/// \brief Process the specified full_hit_list for the specified query using the specified crh_filter_spec
+	///
+	/// This builds a calc_hit_list from the specified full_hit_list (and resolves it) once and then passes it to each of the hits_processors
+	inline void hits_processor_list::process_hits_for_query(const std::string     &prm_query_id,    ///< The query_protein_id string
+	                                                        const crh_filter_spec &prm_filter_spec, ///< The filter spec to apply to hits
+	                                                        full_hit_list          prm_full_hits    ///< The full hits to be processed
+	                                                        ) {
+		process_prepared_hits_for_query(
+			prm_filter_spec,
+			prepare_hits_for_query( prm_query_id, prm_filter_spec, std::move( prm_full_hits ) )
+		);
+	}
+
 	/// \brief Get each of the hits_processors in the list to finish any work they've started
 	inline void hits_processor_list::finish_work() {
 		boost::for_each(
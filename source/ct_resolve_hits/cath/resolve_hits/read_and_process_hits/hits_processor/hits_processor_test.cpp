@@ -80,4 +80,26 @@ BOOST_AUTO_TEST_SUITE_END()
 
 
 
+BOOST_AUTO_TEST_SUITE(requires_resolved_hits_works)
+
+BOOST_AUTO_TEST_CASE(summarise_hits_processor_does_not_require_resolved_hits) {
+	BOOST_CHECK( ! summarise_hits_processor    ( ostreams ).requires_resolved_hits() );
+}
+
+BOOST_AUTO_TEST_CASE(write_html_hits_processor_requires_resolved_hits) {
+	BOOST_CHECK(   write_html_hits_processor   ( ostreams ).requires_resolved_hits() );
+}
+
+BOOST_AUTO_TEST_CASE(write_json_hits_processor_requires_resolved_hits) {
+	BOOST_CHECK(   write_json_hits_processor   ( ostreams ).requires_resolved_hits() );
+}
+
+BOOST_AUTO_TEST_CASE(write_results_hits_processor_requires_resolved_hits) {
+	BOOST_CHECK(   write_results_hits_processor( ostreams ).requires_resolved_hits() );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+
+
 BOOST_AUTO_TEST_SUITE_END()
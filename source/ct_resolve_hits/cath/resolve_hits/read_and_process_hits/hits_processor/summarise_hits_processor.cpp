@@ -23,10 +23,13 @@
 #include <boost/lexical_cast.hpp>
 #include <boost/range/algorithm/max_element.hpp>
 #include <boost/range/algorithm/min_element.hpp>
+#include <boost/range/algorithm/upper_bound.hpp>
 
 #include <fmt/core.h>
+#include <fmt/ostream.h>
 
 #include "cath/common/boost_addenda/range/front.hpp"
+#include "cath/common/chrono/duration_to_seconds_string.hpp"
 #include "cath/common/clone/make_uptr_clone.hpp"
 #include "cath/resolve_hits/full_hit_fns.hpp"
 #include "cath/resolve_hits/full_hit_list.hpp"
@@ -38,6 +41,7 @@ using namespace ::cath::rslv::detail;
 using ::boost::numeric_cast;
 using ::boost::range::max_element;
 using ::boost::range::min_element;
+using ::boost::range::upper_bound;
 using ::std::move;
 using ::std::ostream;
 using ::std::right;
@@ -52,12 +56,14 @@ unique_ptr<hits_processor> summarise_hits_processor::do_clone() const {
 
 /// \brief Process the specified data
 ///
-/// This is called directly in process_all_outstanding() and through async in trigger_async_process_query_id()
-void summarise_hits_processor::do_process_hits_for_query(const string           &prm_query_id,         ///< The query_protein_id string
-                                                         const crh_filter_spec  &/*prm_filter_spec*/,  ///< The filter_spec to apply to the hits
-                                                         const crh_score_spec   &/*prm_score_spec*/,   ///< The score spec to apply to the hits
-                                                         const crh_segment_spec &/*prm_segment_spec*/, ///< The segment spec to apply to the hits
-                                                         const calc_hit_list    &prm_calc_hits         ///< The hits to process
+/// This is called by read_and_process_mgr on the thread that reads the hits, one query at a time, in the order of the output
+void summarise_hits_processor::do_process_hits_for_query(const string              &prm_query_id,         ///< The query_protein_id string
+                                                         const crh_filter_spec     &/*prm_filter_spec*/,  ///< The filter_spec to apply to the hits
+                                                         const crh_score_spec      &/*prm_score_spec*/,   ///< The score spec to apply to the hits
+                                                         const crh_segment_spec    &/*prm_segment_spec*/, ///< The segment spec to apply to the hits
+                                                         const calc_hit_list       &prm_calc_hits,        ///< The hits to process
+                                                         const scored_hit_arch_opt &prm_resolved_arch,    ///< The result of resolving the hits
+                                                         const hit_resolve_stats   &prm_resolve_stats     ///< Statistics on how the hits were resolved
                                                          ) {
 	const full_hit_list &full_hits = prm_calc_hits.get_full_hits();
 	if ( ! example_query_id_and_hit && ! full_hits.empty() ) {
@@ -73,6 +79,85 @@ void summarise_hits_processor::do_process_hits_for_query(const string
 	}
 
 	num_hits += full_hits.size();
+
+	if ( prm_resolved_arch ) {
+		record_resolve_stats( prm_query_id, full_hits.size(), prm_resolve_stats );
+	}
+}
+
+/// \brief Record the specified statistics on resolving the hits for the specified query
+void summarise_hits_processor::record_resolve_stats(const string            &prm_query_id,     ///< The query_protein_id string
+                                                    const size_t            &prm_num_hits,     ///< The number of hits for the query
+                                                    const hit_resolve_stats &prm_resolve_stats ///< Statistics on how the hits were resolved
+                                                    ) {
+	++num_resolved_queries;
+	total_resolve_durn += prm_resolve_stats.get_resolve_durn();
+
+	// Insert this query into the slowest_queries if it's slow enough, keeping them in descending order of duration
+	const hrc_duration &durn = prm_resolve_stats.get_resolve_durn();
+	if ( slowest_queries.size() < MAX_LISTED_QUERIES || durn > slowest_queries.back().resolve_stats.get_resolve_durn() ) {
+		slowest_queries.insert(
+			upper_bound(
+				slowest_queries,
+				durn,
+				[] (const hrc_duration &x, const resolved_query_record &y) { return x > y.resolve_stats.get_resolve_durn(); }
+			),
+			resolved_query_record{ prm_query_id, prm_num_hits, prm_resolve_stats }
+		);
+		if ( slowest_queries.size() > MAX_LISTED_QUERIES ) {
+			slowest_queries.pop_back();
+		}
+	}
+
+	if ( exceeded_budget( prm_resolve_stats ) ) {
+		++num_over_budget_queries;
+		if ( over_budget_queries.size() < MAX_LISTED_QUERIES ) {
+			over_budget_queries.push_back( resolved_query_record{ prm_query_id, prm_num_hits, prm_resolve_stats } );
+		}
+	}
+}
+
+/// \brief Write a summary of the resolving of the queries' hits to the specified ostream
+void summarise_hits_processor::write_resolve_summary(ostream &prm_os ///< The ostream to which the summary should be written
+                                                     ) const {
+	const auto write_record = [&] (const resolved_query_record &x, const string &y) {
+		::fmt::print(
+			prm_os,
+			"    * {} : {:.6f} seconds ({} hits, {} work units){}\n",
+			x.query_id,
+			durn_to_seconds_double( x.resolve_stats.get_resolve_durn() ),
+			x.num_hits,
+			x.resolve_stats.get_num_work_units(),
+			y
+		);
+	};
+
+	::fmt::print(
+		prm_os,
+		"\n"
+		"Summary of resolving\n"
+		"--------------------\n"
+		" * Number of queries : {:6} (excludes any queries with no hits)\n"
+		" * Total time        : {:.6f} seconds\n"
+		" * Over budget       : {:6} (resolved with the naive, greedy approach instead)\n"
+		" * Slowest queries   :\n",
+		num_resolved_queries,
+		durn_to_seconds_double( total_resolve_durn ),
+		num_over_budget_queries
+	);
+	for (const resolved_query_record &slow_query : slowest_queries) {
+		write_record( slow_query, "" );
+	}
+	if ( ! over_budget_queries.empty() ) {
+		::fmt::print(
+			prm_os,
+			" * Over-budget queries{} :\n",
+			( num_over_budget_queries > over_budget_queries.size() ) ? ::fmt::format( " (first {})", over_budget_queries.size() ) : ""
+		);
+		for (const resolved_query_record &over_budget_query : over_budget_queries) {
+			write_record( over_budget_query, ::fmt::format( " : {}", description_of_breach( over_budget_query.resolve_stats.get_budget_breach() ) ) );
+		}
+	}
 }
 
 /// \brief Calculate the median of an unsorted bunch of size_t values
@@ -124,12 +209,15 @@ void summarise_hits_processor::do_finish_work() {
 					example_query_id_and_hit
 					?
 						  "    * Query ID : " + example_query_id_and_hit->first                         + "\n"
-						+ "    * Match ID : " + example_query_id_and_hit->second.get_label()            + "\n"
+						+ "    * Match ID : " + string( example_query_id_and_hit->second.get_label() )  + "\n"
 						+ "    * Score    : " + get_score_string   ( example_query_id_and_hit->second ) + "\n"
 						+ "    * Segments : " + get_segments_string( example_query_id_and_hit->second ) + "\n"
 					:
 						""
 				);
+			if ( num_resolved_queries > 0 ) {
+				write_resolve_summary( ostream_ref.get() );
+			}
 		}
 	}
 }
@@ -144,6 +232,11 @@ bool summarise_hits_processor::do_requires_strictly_worse_hits() const {
 	return true;
 }
 
+/// \brief Return false: read_and_resolve_mgr needn't resolve the hits before passing them to this processor
+bool summarise_hits_processor::do_requires_resolved_hits() const {
+	return false;
+}
+
 /// \brief Ctor for the summarise_hits_processor
 summarise_hits_processor::summarise_hits_processor(ref_vec<ostream> prm_ostreams ///< The ostream to which the results should be written
                                                    ) noexcept : super{ ::std::move( prm_ostreams ) } {
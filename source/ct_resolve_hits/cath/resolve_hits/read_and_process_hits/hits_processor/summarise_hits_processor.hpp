@@ -21,17 +21,43 @@
 #ifndef CATH_TOOLS_SOURCE_CT_RESOLVE_HITS_CATH_RESOLVE_HITS_READ_AND_PROCESS_HITS_HITS_PROCESSOR_SUMMARISE_HITS_PROCESSOR_HPP
 #define CATH_TOOLS_SOURCE_CT_RESOLVE_HITS_CATH_RESOLVE_HITS_READ_AND_PROCESS_HITS_HITS_PROCESSOR_SUMMARISE_HITS_PROCESSOR_HPP
 
+#include "cath/common/chrono/chrono_type_aliases.hpp"
 #include "cath/resolve_hits/full_hit.hpp"
 #include "cath/resolve_hits/read_and_process_hits/hits_processor/hits_processor.hpp"
+#include "cath/resolve_hits/resolve/hit_resolve_stats.hpp"
+
+#include <string>
+#include <vector>
 
 namespace cath::rslv::detail {
 
 	/// \brief A hits_processor to summarise the input data
+	///
+	/// If the hits are resolved (because another hits_processor requires it), this also summarises
+	/// the resolving, including the slowest queries and any that exceeded the budget
 	class summarise_hits_processor final : public hits_processor {
 	private:
 		/// \brief Convenience type alias for the parent class
 		using super = hits_processor;
 
+		/// \brief A record of the resolving of one query
+		struct resolved_query_record final {
+			/// \brief The query ID
+			std::string       query_id;
+
+			/// \brief The number of hits for the query
+			size_t            num_hits;
+
+			/// \brief Statistics on how the query's hits were resolved
+			hit_resolve_stats resolve_stats;
+		};
+
+		/// \brief Type alias for a vector of resolved_query_record
+		using resolved_query_record_vec = std::vector<resolved_query_record>;
+
+		/// \brief The maximum number of queries to list in each of the lists of slowest and over-budget queries
+		static constexpr size_t MAX_LISTED_QUERIES = 10;
+
 		/// \brief For each query, record the maximum stop of the hits
 		size_vec max_stops;
 
@@ -41,13 +67,36 @@ namespace cath::rslv::detail {
 		/// \brief Record an example query_id/full_hit pair
 		str_full_hit_pair_opt example_query_id_and_hit;
 
+		/// \brief The number of queries whose hits have been resolved
+		size_t num_resolved_queries = 0;
+
+		/// \brief The total time spent resolving hits
+		hrc_duration total_resolve_durn = hrc_duration::zero();
+
+		/// \brief Records of the slowest queries to resolve so far, slowest first (up to MAX_LISTED_QUERIES)
+		resolved_query_record_vec slowest_queries;
+
+		/// \brief The number of queries for which resolving exceeded the budget
+		size_t num_over_budget_queries = 0;
+
+		/// \brief Records of the first queries for which resolving exceeded the budget (up to MAX_LISTED_QUERIES)
+		resolved_query_record_vec over_budget_queries;
+
+		void record_resolve_stats(const std::string &,
+		                          const size_t &,
+		                          const hit_resolve_stats &);
+
+		void write_resolve_summary(std::ostream &) const;
+
 		[[nodiscard]] std::unique_ptr<hits_processor> do_clone() const final;
 
 		void do_process_hits_for_query(const std::string &,
 		                               const crh_filter_spec &,
 		                               const crh_score_spec &,
 		                               const crh_segment_spec &,
-		                               const calc_hit_list &) final;
+		                               const calc_hit_list &,
+		                               const scored_hit_arch_opt &,
+		                               const hit_resolve_stats &) final;
 
 		void do_finish_work() final;
 
@@ -55,6 +104,8 @@ namespace cath::rslv::detail {
 
 		[[nodiscard]] bool do_requires_strictly_worse_hits() const final;
 
+		[[nodiscard]] bool do_requires_resolved_hits() const final;
+
 	  public:
 		explicit summarise_hits_processor(ref_vec<std::ostream>) noexcept;
 	};
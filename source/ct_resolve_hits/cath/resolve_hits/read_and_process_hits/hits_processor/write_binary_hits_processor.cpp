@@ -0,0 +1,167 @@
+/// \file
+/// \brief The write_binary_hits_processor class definitions
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "write_binary_hits_processor.hpp"
+
+#include <boost/numeric/conversion/cast.hpp>
+
+#include "cath/common/clone/make_uptr_clone.hpp"
+#include "cath/resolve_hits/calc_hit_list.hpp"
+#include "cath/resolve_hits/file/binary_hits_format.hpp"
+#include "cath/resolve_hits/full_hit.hpp"
+#include "cath/resolve_hits/full_hit_list.hpp"
+#include "cath/resolve_hits/hit_extras.hpp"
+#include "cath/seq/seq_seg.hpp"
+
+using namespace ::cath::common;
+using namespace ::cath::rslv;
+using namespace ::cath::rslv::detail;
+using namespace ::cath::seq;
+
+using ::boost::numeric_cast;
+using ::std::ostream;
+using ::std::streamsize;
+using ::std::string;
+using ::std::unique_ptr;
+
+/// \brief A standard do_clone method
+unique_ptr<hits_processor> write_binary_hits_processor::do_clone() const {
+	return { make_uptr_clone( *this ) };
+}
+
+/// \brief Write the contents of the buffer to each of the ostreams and then clear it
+void write_binary_hits_processor::write_buffer() {
+	for (const ostream_ref &ostream_ref : get_ostreams() ) {
+		ostream_ref.get().write( buffer.data(), static_cast<streamsize>( buffer.length() ) );
+	}
+	num_bytes_written += buffer.length();
+	buffer.clear();
+}
+
+/// \brief Append the header to the buffer if it hasn't already been written
+void write_binary_hits_processor::append_header_if_not_started() {
+	if ( ! has_started ) {
+		buffer.append( BINARY_HITS_HEADER_MAGIC );
+		append_binary_hits_value( buffer, BINARY_HITS_VERSION );
+		append_binary_hits_value( buffer, uint32_t{ 0 }       );
+		has_started = true;
+	}
+}
+
+/// \brief Process the specified data
+///
+/// This is called by read_and_process_mgr on the thread that reads the hits, one query at a time, in the order of the output
+void write_binary_hits_processor::do_process_hits_for_query(const string              &prm_query_id,          ///< The query_protein_id string
+                                                            const crh_filter_spec     &/*prm_filter_spec*/,   ///< The filter_spec to apply to the hits
+                                                            const crh_score_spec      &/*prm_score_spec*/,    ///< The score spec to apply to the hits
+                                                            const crh_segment_spec    &/*prm_segment_spec*/,  ///< The segment spec to apply to the hits
+                                                            const calc_hit_list       &prm_calc_hits,         ///< The hits to process
+                                                            const scored_hit_arch_opt &/*prm_resolved_arch*/, ///< Unused
+                                                            const hit_resolve_stats   &/*prm_resolve_stats*/  ///< Unused
+                                                            ) {
+	const full_hit_list &the_full_hits = prm_calc_hits.get_full_hits();
+	if ( the_full_hits.empty() || has_finished ) {
+		return;
+	}
+
+	append_header_if_not_started();
+
+	const auto query_id_index = index_of_query_id.try_emplace( prm_query_id, numeric_cast<uint32_t>( query_ids.size() ) ).first->second;
+	if ( query_id_index == query_ids.size() ) {
+		query_ids.push_back( prm_query_id );
+	}
+
+	for (const full_hit &the_hit : the_full_hits) {
+		temp_hashable_match_id.assign( the_hit.get_label() );
+		const auto match_id_index = index_of_match_id.try_emplace( temp_hashable_match_id, numeric_cast<uint32_t>( match_ids.size() ) ).first->second;
+		if ( match_id_index == match_ids.size() ) {
+			match_ids.push_back( temp_hashable_match_id );
+		}
+
+		const seq_seg_vec      &segments = the_hit.get_segments();
+		const hit_extras_store &extras   = the_hit.get_extras_store();
+		append_binary_hits_value( buffer, query_id_index                                   );
+		append_binary_hits_value( buffer, match_id_index                                   );
+		append_binary_hits_value( buffer, static_cast<uint8_t>( the_hit.get_score_type() ) );
+		append_binary_hits_value( buffer, numeric_cast<uint8_t >( extras.size()   )        );
+		append_binary_hits_value( buffer, numeric_cast<uint16_t>( segments.size() )        );
+		append_binary_hits_value( buffer, the_hit.get_score()                              );
+		for (const seq_seg &the_seg : segments) {
+			append_binary_hits_value( buffer, static_cast<uint32_t>( get_start_res_index( the_seg ) ) );
+			append_binary_hits_value( buffer, static_cast<uint32_t>( get_stop_res_index ( the_seg ) ) );
+		}
+		for (const hit_extra_cat_var_pair &the_extra : extras) {
+			append_binary_hits_value( buffer, static_cast<uint8_t>( the_extra.first ) );
+			if ( const auto *string_ptr = ::std::get_if<string>( &the_extra.second ) ) {
+				append_binary_hits_string( buffer, *string_ptr );
+			}
+			else {
+				append_binary_hits_value( buffer, ::std::get<double>( the_extra.second ) );
+			}
+		}
+		++num_records;
+	}
+
+	write_buffer();
+}
+
+/// \brief Write the ID tables and the trailer to finish the work
+///
+/// If no hits have been written, this writes nothing (and empty data is read as holding no hits)
+void write_binary_hits_processor::do_finish_work() {
+	if ( ! has_started || has_finished ) {
+		return;
+	}
+	const uint64_t table_offset = num_bytes_written + buffer.length();
+	for (const string &query_id : query_ids) {
+		append_binary_hits_string( buffer, query_id );
+	}
+	for (const string &match_id : match_ids) {
+		append_binary_hits_string( buffer, match_id );
+	}
+
+	append_binary_hits_value( buffer, table_offset                                );
+	append_binary_hits_value( buffer, num_records                                 );
+	append_binary_hits_value( buffer, numeric_cast<uint32_t>( query_ids.size() ) );
+	append_binary_hits_value( buffer, numeric_cast<uint32_t>( match_ids.size() ) );
+	buffer.append( BINARY_HITS_TRAILER_MAGIC );
+	write_buffer();
+	has_finished = true;
+}
+
+/// \brief Return true: read_and_resolve_mgr should still parse hits that fail the score filter and pass them to this processor
+bool write_binary_hits_processor::do_wants_hits_that_fail_score_filter() const {
+	return true;
+}
+
+/// \brief Return true: read_and_resolve_mgr may not strip out strictly worse hits from the data; they are required
+bool write_binary_hits_processor::do_requires_strictly_worse_hits() const {
+	return true;
+}
+
+/// \brief Return false: read_and_resolve_mgr needn't resolve the hits before passing them to this processor
+bool write_binary_hits_processor::do_requires_resolved_hits() const {
+	return false;
+}
+
+/// \brief Ctor for the write_binary_hits_processor
+write_binary_hits_processor::write_binary_hits_processor(ref_vec<ostream> prm_ostreams ///< The ostreams to which the binary hits data should be written
+                                                         ) noexcept : super{ ::std::move( prm_ostreams ) } {
+}
@@ -0,0 +1,101 @@
+/// \file
+/// \brief The write_binary_hits_processor class header
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef CATH_TOOLS_SOURCE_CT_RESOLVE_HITS_CATH_RESOLVE_HITS_READ_AND_PROCESS_HITS_HITS_PROCESSOR_WRITE_BINARY_HITS_PROCESSOR_HPP
+#define CATH_TOOLS_SOURCE_CT_RESOLVE_HITS_CATH_RESOLVE_HITS_READ_AND_PROCESS_HITS_HITS_PROCESSOR_WRITE_BINARY_HITS_PROCESSOR_HPP
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+#include "cath/resolve_hits/read_and_process_hits/hits_processor/hits_processor.hpp"
+
+namespace cath::rslv::detail {
+
+	/// \brief Hits processor that writes all the input hits (unfiltered, unresolved) to the hits_processor's
+	///        ostreams in the binary hits format (see binary_hits_format.hpp)
+	///
+	/// This allows hits from any of the other input formats to be converted to the binary hits format
+	/// so that later runs can read them with parse_binary_hits_file().
+	///
+	/// The records are written as each query is processed and the ID tables and trailer
+	/// are written by do_finish_work().
+	class write_binary_hits_processor final : public hits_processor {
+	private:
+		/// \brief Convenience type alias for the parent class
+		using super = hits_processor;
+
+		/// \brief Whether the header has been written yet
+		bool has_started = false;
+
+		/// \brief Whether the ID tables and trailer have been written yet
+		bool has_finished = false;
+
+		/// \brief The number of bytes written to each ostream so far
+		uint64_t num_bytes_written = 0;
+
+		/// \brief The number of records written so far
+		uint64_t num_records = 0;
+
+		/// \brief The query IDs in the order of their indices in the query ID table
+		str_vec query_ids;
+
+		/// \brief The index of each query ID in query_ids
+		std::unordered_map<std::string, uint32_t> index_of_query_id;
+
+		/// \brief The match IDs in the order of their indices in the match ID table
+		str_vec match_ids;
+
+		/// \brief The index of each match ID in match_ids
+		std::unordered_map<std::string, uint32_t> index_of_match_id;
+
+		/// \brief A string that can be reused for holding a local copy of each hit's label
+		///        for hashing to avoid having to reallocate for every hit
+		std::string temp_hashable_match_id;
+
+		/// \brief A buffer in which to build the data before writing it to the ostreams
+		std::string buffer;
+
+		void append_header_if_not_started();
+		void write_buffer();
+
+		[[nodiscard]] std::unique_ptr<hits_processor> do_clone() const final;
+
+		void do_process_hits_for_query(const std::string &,
+		                               const crh_filter_spec &,
+		                               const crh_score_spec &,
+		                               const crh_segment_spec &,
+		                               const calc_hit_list &,
+		                               const scored_hit_arch_opt &,
+		                               const hit_resolve_stats &) final;
+
+		void do_finish_work() final;
+
+		[[nodiscard]] bool do_wants_hits_that_fail_score_filter() const final;
+		[[nodiscard]] bool do_requires_strictly_worse_hits() const final;
+		[[nodiscard]] bool do_requires_resolved_hits() const final;
+
+	  public:
+		explicit write_binary_hits_processor(ref_vec<std::ostream>) noexcept;
+	};
+
+} // namespace cath::rslv::detail
+
+#endif // CATH_TOOLS_SOURCE_CT_RESOLVE_HITS_CATH_RESOLVE_HITS_READ_AND_PROCESS_HITS_HITS_PROCESSOR_WRITE_BINARY_HITS_PROCESSOR_HPP
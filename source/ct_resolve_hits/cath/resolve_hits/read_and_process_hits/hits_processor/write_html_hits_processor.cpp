@@ -42,48 +42,51 @@ unique_ptr<hits_processor> write_html_hits_processor::do_clone() const {
 
 /// \brief Process the specified data
 ///
-/// This is called directly in process_all_outstanding() and through async in trigger_async_process_query_id()
-void write_html_hits_processor::do_process_hits_for_query(const string           &prm_query_id,     ///< The query_protein_id string
-                                                          const crh_filter_spec  &prm_filter_spec,  ///< The filter_spec to apply to the hits
-                                                          const crh_score_spec   &prm_score_spec,   ///< The score spec to apply to the hits
-                                                          const crh_segment_spec &prm_segment_spec, ///< The segment spec to apply to the hits
-                                                          const calc_hit_list    &prm_calc_hits     ///< The hits to process
+/// This is called by read_and_process_mgr on the thread that reads the hits, one query at a time, in the order of the output
+void write_html_hits_processor::do_process_hits_for_query(const string              &prm_query_id,         ///< The query_protein_id string
+                                                          const crh_filter_spec     &prm_filter_spec,      ///< The filter_spec to apply to the hits
+                                                          const crh_score_spec      &prm_score_spec,       ///< The score spec to apply to the hits
+                                                          const crh_segment_spec    &prm_segment_spec,     ///< The segment spec to apply to the hits
+                                                          const calc_hit_list       &prm_calc_hits,        ///< The hits to process
+                                                          const scored_hit_arch_opt &prm_resolved_arch,    ///< The result of resolving the hits
+                                                          const hit_resolve_stats   &prm_resolve_stats     ///< Statistics on how the hits were resolved
                                                           ) {
 	// If the prefix hasn't already been printed, then do so and record
 	if ( ! printed_prefix ) {
 		if ( ! html_spec.get_restrict_html_within_body() ) {
-			for (const ostream_ref &ostream_ref : get_ostreams() ) {
-				ostream_ref.get() << resolve_hits_html_outputter::html_prefix();
-			}
+			html_sink.append( resolve_hits_html_outputter::html_prefix() );
 		}
 		printed_prefix = true;
 	}
 
 	// Output the HTML for this query and its hits
-	for (const ostream_ref &ostream_ref : get_ostreams() ) {
-		ostream_ref.get() << resolve_hits_html_outputter::output_html(
-			prm_query_id,
-			prm_calc_hits,
-			prm_score_spec,
-			prm_segment_spec,
-			html_spec,
-			false,
-			prm_filter_spec,
-			batch_counter
-		);
-	}
+	resolve_hits_html_outputter::write_html(
+		html_sink,
+		prm_query_id,
+		prm_calc_hits,
+		prm_resolved_arch.value(),
+		prm_score_spec,
+		prm_segment_spec,
+		html_spec,
+		false,
+		prm_filter_spec,
+		batch_counter,
+		prm_resolve_stats.get_budget_breach()
+	);
 	++batch_counter;
+
+	// Flush at the end of each query so the output isn't held back behind that of other processors
+	html_sink.flush();
 }
 
 /// \brief Write the HTML suffix to finish the work (if it has been started)
 void write_html_hits_processor::do_finish_work() {
 	if ( printed_prefix ) {
-		for (const ostream_ref &ostream_ref : get_ostreams() ) {
-			ostream_ref.get() << resolve_hits_html_outputter::html_key();
-			if ( ! html_spec.get_restrict_html_within_body() ) {
-				ostream_ref.get() << resolve_hits_html_outputter::html_suffix();
-			}
+		html_sink.append( resolve_hits_html_outputter::html_key() );
+		if ( ! html_spec.get_restrict_html_within_body() ) {
+			html_sink.append( resolve_hits_html_outputter::html_suffix() );
 		}
+		html_sink.flush();
 	}
 }
 
@@ -97,9 +100,15 @@ bool write_html_hits_processor::do_requires_strictly_worse_hits() const {
 	return true;
 }
 
+/// \brief Return true: read_and_resolve_mgr must resolve the hits before passing them to this processor
+bool write_html_hits_processor::do_requires_resolved_hits() const {
+	return true;
+}
+
 /// \brief Ctor for the write_html_hits_processor
 write_html_hits_processor::write_html_hits_processor(ref_vec<ostream> prm_ostreams,  ///< The ostream to which the results should be written
                                                      crh_html_spec    prm_html_spec ///< The specification for how to render the HTML
                                                      ) noexcept : super    { ::std::move( prm_ostreams  ) },
-                                                                  html_spec{ ::std::move( prm_html_spec ) } {
+                                                                  html_spec{ ::std::move( prm_html_spec ) },
+                                                                  html_sink{ get_ostreams()               } {
 }
@@ -21,6 +21,7 @@
 #ifndef CATH_TOOLS_SOURCE_CT_RESOLVE_HITS_CATH_RESOLVE_HITS_READ_AND_PROCESS_HITS_HITS_PROCESSOR_WRITE_HTML_HITS_PROCESSOR_HPP
 #define CATH_TOOLS_SOURCE_CT_RESOLVE_HITS_CATH_RESOLVE_HITS_READ_AND_PROCESS_HITS_HITS_PROCESSOR_WRITE_HTML_HITS_PROCESSOR_HPP
 
+#include "cath/common/file/buffered_ostream_sink.hpp"
 #include "cath/resolve_hits/options/spec/crh_html_spec.hpp"
 #include "cath/resolve_hits/read_and_process_hits/hits_processor/hits_processor.hpp"
 
@@ -43,13 +44,18 @@ namespace cath::rslv::detail {
 		/// \brief The specification for how to render the HTML
 		crh_html_spec html_spec;
 
+		/// \brief The sink through which the HTML is written to the hits_processor's ostreams
+		common::buffered_ostream_sink html_sink;
+
 		[[nodiscard]] std::unique_ptr<hits_processor> do_clone() const final;
 
 		void do_process_hits_for_query(const std::string &,
 		                               const crh_filter_spec &,
 		                               const crh_score_spec &,
 		                               const crh_segment_spec &,
-		                               const calc_hit_list &) final;
+		                               const calc_hit_list &,
+		                               const scored_hit_arch_opt &,
+		                               const hit_resolve_stats &) final;
 
 		void do_finish_work() final;
 
@@ -57,6 +63,8 @@ namespace cath::rslv::detail {
 
 		[[nodiscard]] bool do_requires_strictly_worse_hits() const final;
 
+		[[nodiscard]] bool do_requires_resolved_hits() const final;
+
 	  public:
 		explicit write_html_hits_processor(ref_vec<std::ostream>,
 		                                   crh_html_spec = crh_html_spec{}) noexcept;
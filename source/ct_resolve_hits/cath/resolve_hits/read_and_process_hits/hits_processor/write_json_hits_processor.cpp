@@ -24,6 +24,7 @@
 #include "cath/common/exception/out_of_range_exception.hpp"
 #include "cath/resolve_hits/calc_hit_list.hpp"
 #include "cath/resolve_hits/full_hit_list_fns.hpp"
+#include "cath/resolve_hits/full_hit_rapidjson.hpp"
 #include "cath/resolve_hits/resolve/hit_resolver.hpp"
 #include "cath/resolve_hits/scored_hit_arch.hpp"
 
@@ -42,34 +43,60 @@ unique_ptr<hits_processor> write_json_hits_processor::do_clone() const {
 
 /// \brief Process the specified data
 ///
-/// This is called directly in process_all_outstanding() and through async in trigger_async_process_query_id()
-void write_json_hits_processor::do_process_hits_for_query(const string           &prm_query_id,        ///< The query_protein_id string
-                                                          const crh_filter_spec  &/*prm_filter_spec*/, ///< The filter_spec to apply to the hits
-                                                          const crh_score_spec   &prm_score_spec,      ///< The score spec to apply to the hits
-                                                          const crh_segment_spec &prm_segment_spec,    ///< The segment spec to apply to the hits
-                                                          const calc_hit_list    &prm_calc_hits        ///< The hits to process
+/// This is called by read_and_process_mgr on the thread that reads the hits, one query at a time, in the order of the output
+void write_json_hits_processor::do_process_hits_for_query(const string              &prm_query_id,         ///< The query_protein_id string
+                                                          const crh_filter_spec     &/*prm_filter_spec*/,  ///< The filter_spec to apply to the hits
+                                                          const crh_score_spec      &/*prm_score_spec*/,   ///< The score spec to apply to the hits
+                                                          const crh_segment_spec    &prm_segment_spec,     ///< The segment spec to apply to the hits
+                                                          const calc_hit_list       &prm_calc_hits,        ///< The hits to process
+                                                          const scored_hit_arch_opt &prm_resolved_arch,    ///< The result of resolving the hits
+                                                          const hit_resolve_stats   &prm_resolve_stats     ///< Statistics on how the hits were resolved
                                                           ) {
 	if ( ! has_started ) {
-		json_writers.start_object();
+		json_writer.start_object();
 		has_started = true;
 	}
 
-	// Resolve the hits
-	const auto result_hit_arch  = resolve_hits( prm_calc_hits, prm_score_spec.get_naive_greedy() );
-	const auto result_full_hits = get_full_hits_of_hit_arch(
-		result_hit_arch,
+	const full_hit_list_opt    result_full_hits = get_full_hits_of_hit_arch(
+		prm_resolved_arch.value(),
 		prm_calc_hits.get_full_hits()
 	);
+	const crh_segment_spec_opt segment_spec     = prm_segment_spec;
+
+	// Output the results to the ostreams, writing each hit compactly as a raw value in the array
+	json_writer.write_key( prm_query_id );
+	json_writer.start_array();
+	for (const full_hit &the_full_hit : *result_full_hits) {
+		hit_json_writer.clear();
+		write_to_rapidjson( hit_json_writer, the_full_hit, segment_spec, result_full_hits );
+		json_writer.write_raw_string( hit_json_writer.get_string_view() );
+	}
+	json_writer.end_array();
+
+	if ( exceeded_budget( prm_resolve_stats ) ) {
+		naive_greedy_query_ids.push_back( prm_query_id );
+	}
 
-	// Output the results to prm_ostream
-	json_writers.write_key( prm_query_id );
-	json_writers.write_raw_string( to_json_string_with_compact_fullhits( result_full_hits, prm_segment_spec, 1 ) );
+	// Flush at the end of each query so the output isn't held back behind that of other processors
+	json_writer.flush();
 }
 
-/// \brief Do nothing to finish the batch of work
+/// \brief Finish the JSON object (if it has been started) and flush it to the ostreams
+///
+/// If any queries were resolved with the naive, greedy approach, their IDs are listed under
+/// NAIVE_GREEDY_QUERIES_KEY before the object is finished
 void write_json_hits_processor::do_finish_work() {
-	if ( has_started && ! json_writers.is_complete() ) {
-		json_writers.end_object();
+	if ( has_started && ! json_writer.is_complete() ) {
+		if ( ! naive_greedy_query_ids.empty() ) {
+			json_writer.write_key( string( NAIVE_GREEDY_QUERIES_KEY ) );
+			json_writer.start_array();
+			for (const string &query_id : naive_greedy_query_ids) {
+				json_writer.write_value( query_id );
+			}
+			json_writer.end_array();
+		}
+		json_writer.end_object();
+		json_writer.flush();
 	}
 }
 
@@ -83,32 +110,36 @@ bool write_json_hits_processor::do_requires_strictly_worse_hits() const {
 	return false;
 }
 
+/// \brief Return true: read_and_resolve_mgr must resolve the hits before passing them to this processor
+bool write_json_hits_processor::do_requires_resolved_hits() const {
+	return true;
+}
+
 /// \brief Ctor for write_json_hits_processor
 write_json_hits_processor::write_json_hits_processor(ref_vec<ostream> prm_ostreams ///< The ostream to which the results should be written
-                                                     ) noexcept : super { ::std::move( prm_ostreams ) } {
-	for (const ostream_ref &ostream_ref : get_ostreams() ) {
-		json_writers.emplace_back( ostream_ref.get() );
-	}
+                                                     ) noexcept : super      { ::std::move( prm_ostreams ) },
+                                                                  json_writer{ get_ostreams()              } {
 }
 
 
 /// \brief Copy ctor for write_json_hits_processor
 write_json_hits_processor::write_json_hits_processor(const write_json_hits_processor &prm_rhs ///< The other write_json_hits_processor from which to copy construct
-                                                     ) : super       { prm_rhs             },
-                                                         json_writers{ get_ostreams()      },
-                                                         has_started { prm_rhs.has_started } {
-	if ( has_started && ! json_writers.is_complete() ) {
+                                                     ) : super                 { prm_rhs                        },
+                                                         json_writer           { get_ostreams()                 },
+                                                         has_started           { prm_rhs.has_started            },
+                                                         naive_greedy_query_ids{ prm_rhs.naive_greedy_query_ids } {
+	if ( has_started && ! json_writer.is_complete() ) {
 		BOOST_THROW_EXCEPTION(out_of_range_exception("Unable to copy construct from write_json_hits_processor that's in-process of writing"));
 	}
 }
 
 /// \brief Move ctor for write_json_hits_processor
 write_json_hits_processor::write_json_hits_processor(write_json_hits_processor &&prm_rhs ///< The other write_json_hits_processor from which to move construct
-                                                     ) : super       { ::std::move( prm_rhs ) },
-                                                         json_writers{ get_ostreams()         },
-                                                         has_started { prm_rhs.has_started    } {
-	if ( has_started && ! json_writers.is_complete() ) {
+                                                     ) : super                 { ::std::move( prm_rhs )                      },
+                                                         json_writer           { get_ostreams()                              },
+                                                         has_started           { prm_rhs.has_started                         },
+                                                         naive_greedy_query_ids{ ::std::move( prm_rhs.naive_greedy_query_ids ) } {
+	if ( has_started && ! json_writer.is_complete() ) {
 		BOOST_THROW_EXCEPTION(out_of_range_exception("Unable to copy construct from write_json_hits_processor that's in-process of writing"));
 	}
 }
-
@@ -21,9 +21,11 @@
 #ifndef CATH_TOOLS_SOURCE_CT_RESOLVE_HITS_CATH_RESOLVE_HITS_READ_AND_PROCESS_HITS_HITS_PROCESSOR_WRITE_JSON_HITS_PROCESSOR_HPP
 #define CATH_TOOLS_SOURCE_CT_RESOLVE_HITS_CATH_RESOLVE_HITS_READ_AND_PROCESS_HITS_HITS_PROCESSOR_WRITE_JSON_HITS_PROCESSOR_HPP
 
-#include <rapidjson/ostreamwrapper.h>
+#include <string_view>
 
-#include "cath/common/rapidjson_addenda/rapidjson_writer_list.hpp"
+#include "cath/common/file/buffered_ostream_sink.hpp"
+#include "cath/common/rapidjson_addenda/rapidjson_writer.hpp"
+#include "cath/common/type_aliases.hpp"
 #include "cath/resolve_hits/read_and_process_hits/hits_processor/hits_processor.hpp"
 
 namespace cath::rslv::detail {
@@ -34,19 +36,29 @@ namespace cath::rslv::detail {
 		/// \brief Convenience type alias for the parent class
 		using super = hits_processor;
 
-		/// \brief The JSON writer, which writes to an OStreamWrapper of the hits_processor's ostream
-		common::rapidjson_writer_list<common::json_style::PRETTY, rapidjson::OStreamWrapper> json_writers;
+		/// \brief The JSON writer, which writes to a buffered_ostream_sink of the hits_processor's ostreams
+		common::rapidjson_writer<common::json_style::PRETTY, common::buffered_ostream_sink> json_writer;
+
+		/// \brief A compact JSON writer that's reused to write each hit before it's written to json_writer as a raw value
+		common::rapidjson_writer<common::json_style::COMPACT> hit_json_writer;
 
 		/// \brief Whether anything has been written to this yet
 		bool has_started = false;
 
+		/// \brief The IDs of the queries that were resolved with the naive, greedy approach because they exceeded the budget
+		///
+		/// These are written under NAIVE_GREEDY_QUERIES_KEY at the end (if there are any)
+		str_vec naive_greedy_query_ids;
+
 		[[nodiscard]] std::unique_ptr<hits_processor> do_clone() const final;
 
 		void do_process_hits_for_query(const std::string &,
 		                               const crh_filter_spec &,
 		                               const crh_score_spec &,
 		                               const crh_segment_spec &,
-		                               const calc_hit_list &) final;
+		                               const calc_hit_list &,
+		                               const scored_hit_arch_opt &,
+		                               const hit_resolve_stats &) final;
 
 		void do_finish_work() final;
 
@@ -54,7 +66,13 @@ namespace cath::rslv::detail {
 
 		[[nodiscard]] bool do_requires_strictly_worse_hits() const final;
 
+		[[nodiscard]] bool do_requires_resolved_hits() const final;
+
 	  public:
+		/// \brief The key under which the IDs of any queries resolved with the naive, greedy approach
+		///        (because they exceeded the budget) are listed
+		static constexpr ::std::string_view NAIVE_GREEDY_QUERIES_KEY{ "resolved_with_naive_greedy" };
+
 		explicit write_json_hits_processor(ref_vec<std::ostream>) noexcept;
 
 		write_json_hits_processor(const write_json_hits_processor &);
@@ -50,20 +50,29 @@ unique_ptr<hits_processor> write_results_hits_processor::do_clone() const {
 
 /// \brief Process the specified data
 ///
-/// This is called directly in process_all_outstanding() and through async in trigger_async_process_query_id()
-void write_results_hits_processor::do_process_hits_for_query(const string           &prm_query_id,        ///< The query_protein_id string
-                                                             const crh_filter_spec  &/*prm_filter_spec*/, ///< The filter_spec to apply to the hits
-                                                             const crh_score_spec   &prm_score_spec,      ///< The score spec to apply to the hits
-                                                             const crh_segment_spec &prm_segment_spec,    ///< The segment spec to apply to the hits
-                                                             const calc_hit_list    &prm_calc_hits        ///< The hits to process
+/// This is called by read_and_process_mgr on the thread that reads the hits, one query at a time, in the order of the output
+void write_results_hits_processor::do_process_hits_for_query(const string              &prm_query_id,        ///< The query_protein_id string
+                                                             const crh_filter_spec     &/*prm_filter_spec*/, ///< The filter_spec to apply to the hits
+                                                             const crh_score_spec      &/*prm_score_spec*/,  ///< The score spec to apply to the hits
+                                                             const crh_segment_spec    &prm_segment_spec,    ///< The segment spec to apply to the hits
+                                                             const calc_hit_list       &prm_calc_hits,       ///< The hits to process
+                                                             const scored_hit_arch_opt &prm_resolved_arch,   ///< The result of resolving the hits
+                                                             const hit_resolve_stats   &prm_resolve_stats    ///< Statistics on how the hits were resolved
                                                              ) {
-	// Resolve the hits
-	const auto result_hit_arch  = resolve_hits( prm_calc_hits, prm_score_spec.get_naive_greedy() );
 	const auto result_full_hits = get_full_hits_of_hit_arch(
-		result_hit_arch,
+		prm_resolved_arch.value(),
 		prm_calc_hits.get_full_hits()
 	);
 
+	// If resolving this query exceeded the budget, flag that these results come from the naive, greedy approach
+	const string budget_flag = exceeded_budget( prm_resolve_stats )
+		? ::fmt::format(
+			"# WARNING: Query {} was resolved with the naive, greedy approach ({})\n",
+			prm_query_id,
+			description_of_breach( prm_resolve_stats.get_budget_breach() )
+		)
+		: string{};
+
 	for (const ostream_ref &ostream_ref : get_ostreams() ) {
 		if ( ! written_header && ! result_full_hits.empty() ) {
 			ostream_ref.get()
@@ -81,7 +90,7 @@ void write_results_hits_processor::do_process_hits_for_query(const string
 		}
 
 		// Output the results to prm_ostream
-		ostream_ref.get() << to_output_string(
+		ostream_ref.get() << budget_flag << to_output_string(
 			result_full_hits,
 			prm_segment_spec,
 			hit_output_format::JON,
@@ -105,6 +114,11 @@ bool write_results_hits_processor::do_requires_strictly_worse_hits() const {
 	return false;
 }
 
+/// \brief Return true: read_and_resolve_mgr must resolve the hits before passing them to this processor
+bool write_results_hits_processor::do_requires_resolved_hits() const {
+	return true;
+}
+
 /// \brief Ctor for write_results_hits_processor
 write_results_hits_processor::write_results_hits_processor(ref_vec<ostream>           prm_ostreams,       ///< The ostream to which the results should be written
                                                            const hit_boundary_output &prm_boundary_output ///< Whether to trim the boundaries before outputting them
@@ -44,7 +44,9 @@ namespace cath::rslv::detail {
 		                               const crh_filter_spec &,
 		                               const crh_score_spec &,
 		                               const crh_segment_spec &,
-		                               const calc_hit_list &) final;
+		                               const calc_hit_list &,
+		                               const scored_hit_arch_opt &,
+		                               const hit_resolve_stats &) final;
 
 		void do_finish_work() final;
 
@@ -52,6 +54,8 @@ namespace cath::rslv::detail {
 
 		[[nodiscard]] bool do_requires_strictly_worse_hits() const final;
 
+		[[nodiscard]] bool do_requires_resolved_hits() const final;
+
 	  public:
 		explicit write_results_hits_processor(ref_vec<std::ostream>,
 		                                      const hit_boundary_output & = hit_boundary_output{}) noexcept;
@@ -44,6 +44,13 @@ using namespace ::cath::rslv::detail;
 using ::std::ostream;
 using ::std::string;
 
+namespace {
+
+	/// \brief The number of bytes in a megabyte, as used to interpret crh_input_spec's max_memory
+	constexpr size_t BYTES_PER_MEGABYTE = 1024 * 1024;
+
+} // namespace
+
 // /// \brief
 // template <typename Rng, typename Comp, typename Proj>
 // size_vec get_ranks(Rng  &&prm_range, ///<
@@ -110,7 +117,9 @@ read_and_process_mgr cath::rslv::make_read_and_process_mgr(const hits_processor
 	return read_and_process_mgr{
 		hits_processor_list{ prm_crh_score_spec, prm_crh_segment_spec, { hits_processor_clptr{ prm_hits_processor.clone() } } },
 		prm_filter_spec,
-		prm_input_spec.get_input_hits_are_grouped()
+		prm_input_spec.get_input_hits_are_grouped(),
+		get_num_resolve_threads( prm_input_spec ),
+		prm_input_spec.get_max_memory() * BYTES_PER_MEGABYTE
 	};
 }
 
@@ -138,7 +147,9 @@ read_and_process_mgr cath::rslv::make_read_and_process_mgr(const hits_processor_
 	return read_and_process_mgr{
 		prm_hits_processors,
 		prm_spec.get_filter_spec(),
-		prm_spec.get_input_spec().get_input_hits_are_grouped()
+		prm_spec.get_input_spec().get_input_hits_are_grouped(),
+		get_num_resolve_threads( prm_spec.get_input_spec() ),
+		prm_spec.get_input_spec().get_max_memory() * BYTES_PER_MEGABYTE
 	};
 }
 
@@ -21,7 +21,8 @@
 #ifndef CATH_TOOLS_SOURCE_CT_RESOLVE_HITS_CATH_RESOLVE_HITS_READ_AND_PROCESS_HITS_READ_AND_PROCESS_MGR_HPP
 #define CATH_TOOLS_SOURCE_CT_RESOLVE_HITS_CATH_RESOLVE_HITS_READ_AND_PROCESS_HITS_READ_AND_PROCESS_MGR_HPP
 
-#include <future>
+#include <algorithm>
+#include <memory>
 #include <optional>
 #include <unordered_map>
 #include <utility>
@@ -30,12 +31,16 @@
 
 #include "cath/common/algorithm/sort_uniq_build.hpp"
 #include "cath/common/exception/runtime_error_exception.hpp"
+#include "cath/common/string/string_intern_pool.hpp"
+#include "cath/common/thread/ordered_task_pool.hpp"
 #include "cath/common/type_aliases.hpp"
 #include "cath/resolve_hits/calc_hit.hpp"
 #include "cath/resolve_hits/calc_hit_list.hpp"
 #include "cath/resolve_hits/detail/full_hit_prune_builder.hpp"
+#include "cath/resolve_hits/full_hit.hpp"
 #include "cath/resolve_hits/options/spec/crh_filter_spec.hpp"
 #include "cath/resolve_hits/options/spec/should_skip_query.hpp"
+#include "cath/resolve_hits/read_and_process_hits/hit_spill_store.hpp"
 #include "cath/resolve_hits/read_and_process_hits/hits_processor/hits_processor_list.hpp"
 
 // clang-format off
@@ -60,31 +65,47 @@ namespace cath::rslv {
 	/// Client code should call add_hit() for each new hit and then process_all_outstanding()
 	/// at the end of the input
 	///
-	/// If `input_hits_are_grouped` then this can trigger asynchronous processing
-	/// of a block of hits for a given query_id when it reaches the end. To allow
-	/// this, it stores the previous hit's query ID and when a hit with a different
-	/// query ID is encountered, it triggers processing of the hits associated with
-	/// the previous query ID.
+	/// If `input_hits_are_grouped` then this can trigger processing of a block of hits
+	/// for a given query_id when it reaches the end. To allow this, it stores the previous
+	/// hit's query ID and when a hit with a different query ID is encountered, it triggers
+	/// processing of the hits associated with the previous query ID.
 	///
-	/// If `! input_hits_are_grouped`, then the results must all be processed synchronously
-	/// at the end.
+	/// If `! input_hits_are_grouped`, then the results must all be processed at the end
+	/// (in order of query ID).
+	///
+	/// In that case, if a (non-zero) max_memory_bytes is specified, then whenever the hits being held
+	/// take roughly more than that much memory, they're all written (as a run sorted by query ID) to a
+	/// temporary file in a detail::hit_spill_store and the memory is freed. At the end, the remaining
+	/// hits are spilled too and then the runs are merged back together, one query at a time, so the
+	/// results are the same as if all the hits had been held in memory. The memory of the hits' interned
+	/// labels counts towards max_memory_bytes too (see held_bytes_limit()).
 	///
 	///
 	/// This class separates out the reading code from the code that processes
 	/// the results as they come in.
 	///
-	/// Any asynchronous processing is done using in the static member function process_query_id(),
-	/// which has access to:
-	///  * (non-const) the relevant hits data
-	///  * (non-const) the (reference-wrapped) ostream
+	/// The processing of each query is split into two parts:
+	///  * preparing (building the calc_hit_list and resolving it), which is done on a pool of worker threads
+	///    (see detail::hits_processor_list::prepare_hits_for_query()) and
+	///  * passing the prepared hits to the hits_processors (which write the output), which is done on
+	///    the thread that calls add_hit() / process_all_outstanding(), in the order in which the
+	///    queries were submitted.
 	///
-	/// (This is OK because std::unordered_map guarantees to not invalidate references/pointers to an element's key/data
-	///  (unless the element is erased), even on operations that do invalidate iterators to the element)
+	/// So the output is the same whatever the number of threads. The number of queries that may be
+	/// submitted but not yet output is bounded (at RESOLVE_QUEUE_LENGTH_PER_THREAD per thread); once
+	/// that's reached, add_hit() blocks until the oldest query has been output, which stops the reading
+	/// from racing ahead of the resolving and keeps the memory bounded.
 	///
-	/// The call to async takes its own copy of the query_id string. The worker thread should have access to
-	/// no other data members.
+	/// Each task passed to a worker thread owns its query's hits (which are removed from hit_builder_by_query_id)
+	/// and only has const access to processors and the_filter_spec.
 	class read_and_process_mgr final {
 	private:
+		/// \brief The pool in which the labels of the hits are interned
+		///
+		/// Each hit shares ownership of this so that its label stays valid for as long as the hit,
+		/// even after this read_and_process_mgr has been destroyed (eg for hits gathered by a gather_hits_processor)
+		std::shared_ptr<common::string_intern_pool> label_pool;
+
 		/// \brief A list of the processors that will process the hits
 		detail::hits_processor_list processors;
 
@@ -116,28 +137,49 @@ namespace cath::rslv {
 		/// The hit data reference avoids many of the repeated calls to the hashing function when input_hits_are_grouped
 		str_hits_builder_ref_pair_opt prev_query_id_and_hits_builder_ref;
 
-		/// \brief A record of the query_id associated with the latest asynchronous processing job
+		/// \brief A record of the query_id associated with the latest processing job
 		///        so that the thread can detect if it finds itself trying to add another hit to
-		///        data that it assumed was finished and which it has passed off to an async worker
-		///        thread.
+		///        data that it assumed was finished and which it has passed off to the worker threads.
 		///
-		/// This is only used by the main thread, never by the async worker thread.
+		/// This is only used by the main thread, never by the worker threads.
 		str_opt to_be_erased_query_id;
 
-		/// \brief The std::future for the std::async() processing.
+		/// \brief The number of worker threads with which to resolve queries (or 0 to use the hardware concurrency)
+		size_t num_threads = DEFAULT_NUM_THREADS;
+
+		/// \brief The approximate number of bytes of hits (including their interned labels) that may be held
+		///        before they're spilled to disk (or 0 for no limit)
+		///
+		/// This is only used if `! input_hits_are_grouped`
+		size_t max_memory_bytes = DEFAULT_MAX_MEMORY_BYTES;
+
+		/// \brief The approximate number of bytes of hits currently held in hit_builder_by_query_id
+		size_t held_bytes = 0;
+
+		/// \brief The runs of hits that have been spilled to disk
+		detail::hit_spill_store spill_store;
+
+		/// \brief A type alias for the pool of worker threads that prepare each query's hits
+		using resolve_pool_type = common::ordered_task_pool<detail::prepared_query_hits>;
+
+		/// \brief The pool of worker threads that prepare each query's hits, which is created on first use
 		///
-		/// At present, this isn't used to pass back results, just to allow the main thread to wait
-		/// until an async processing job is complete.
-		std::future<void> resolve_future;
+		/// This is declared last so that it's destroyed (and its workers joined) before the data they use
+		std::unique_ptr<resolve_pool_type> resolve_pool;
+
+		resolve_pool_type & get_resolve_pool();
+
+		void output_prepared_hits(const detail::prepared_query_hits &);
+
+		[[nodiscard]] detail::full_hit_prune_builder make_builder() const;
 
-		static void process_query_id(detail::hits_processor_list &,
-		                             const std::string &,
-		                             const crh_filter_spec &,
-		                             detail::full_hit_prune_builder &);
+		void submit_query_hits(std::string,
+		                       full_hit_list);
 
-		void trigger_async_process_query_id(const std::string &);
+		void submit_query_id(const std::string &);
 
-		void wait_for_any_active_work() const;
+		[[nodiscard]] size_t held_bytes_limit() const;
+		void spill_held_hits();
 
 	public:
 		/// \brief The default value for whether input hits can be assumed to be pre-sorted
@@ -145,11 +187,30 @@ namespace cath::rslv {
 		/// This is false - better not to assume this guarantee
 		static constexpr bool DEFAULT_INPUT_HITS_ARE_GROUPED = false;
 
-		explicit read_and_process_mgr( detail::hits_processor_list, crh_filter_spec, const bool & = DEFAULT_INPUT_HITS_ARE_GROUPED );
+		/// \brief The default number of worker threads with which to resolve queries
+		static constexpr size_t DEFAULT_NUM_THREADS = 1;
+
+		/// \brief The default approximate number of bytes of hits that may be held before they're spilled to disk
+		///
+		/// This is 0, meaning no limit
+		static constexpr size_t DEFAULT_MAX_MEMORY_BYTES = 0;
+
+		/// \brief The fraction (as a divisor) of the max_memory_bytes that's always left for held hits,
+		///        however much of it is taken by the interned labels (see held_bytes_limit())
+		static constexpr size_t MIN_HELD_BYTES_DIVISOR = 4;
+
+		/// \brief The maximum number of queries per worker thread that may be submitted for processing but not yet output
+		static constexpr size_t RESOLVE_QUEUE_LENGTH_PER_THREAD = 4;
+
+		explicit read_and_process_mgr( detail::hits_processor_list,
+		                               crh_filter_spec,
+		                               const bool & = DEFAULT_INPUT_HITS_ARE_GROUPED,
+		                               const size_t & = DEFAULT_NUM_THREADS,
+		                               const size_t & = DEFAULT_MAX_MEMORY_BYTES );
 
 		void add_hit(const ::std::string_view &,
 		             seq::seq_seg_vec,
-		             std::string,
+		             const ::std::string_view &,
 		             const double &,
 		             const hit_score_type &,
 		             hit_extras_store = {});
@@ -184,56 +245,109 @@ namespace cath::rslv {
 	read_and_process_mgr make_read_and_process_mgr(common::ofstream_list &,
 	                                               const crh_spec &);
 
-	/// \brief Process the specified data
+	/// \brief Get the pool of worker threads that prepare each query's hits, creating it if necessary
+	inline auto read_and_process_mgr::get_resolve_pool() -> resolve_pool_type & {
+		if ( ! resolve_pool ) {
+			const size_t pool_num_threads = common::num_threads_to_use( num_threads );
+			resolve_pool = std::make_unique<resolve_pool_type>(
+				pool_num_threads,
+				RESOLVE_QUEUE_LENGTH_PER_THREAD * pool_num_threads
+			);
+		}
+		return *resolve_pool;
+	}
+
+	/// \brief Pass the specified prepared hits for a query to the hits_processors
 	///
-	/// This is called directly in process_all_outstanding() and through async in trigger_async_process_query_id()
-	inline void read_and_process_mgr::process_query_id(detail::hits_processor_list    &prm_processors,  ///< The hits_processors to use to process the hits
-	                                                   const std::string              &prm_query_id,    ///< The query ID
-	                                                   const crh_filter_spec          &prm_filter_spec, ///< The filter spec to define how to filter the hits
-	                                                   detail::full_hit_prune_builder &prm_hit_builder  ///< The hits to process
-	                                                   ) {
-		prm_processors.process_hits_for_query(
-			prm_query_id,
-			prm_filter_spec,
-			prm_hit_builder.get_built_hits()
-		);
+	/// This is only called on the main thread, in the order in which the queries were submitted
+	inline void read_and_process_mgr::output_prepared_hits(const detail::prepared_query_hits &prm_prepared_hits ///< The prepared hits for a query
+	                                                       ) {
+		processors.process_prepared_hits_for_query( the_filter_spec, prm_prepared_hits );
 	}
 
-	/// \brief Trigger asynchronous processing of the data corresponding to the specified protein_query_id
-	inline void read_and_process_mgr::trigger_async_process_query_id(const std::string &prm_query_id ///< The protein_query_id
-	                                                                 ) {
-		// Wait until any previously triggered asynchronous processing is complete
-		wait_for_any_active_work();
-
-		// Mark to_be_erased_query_id with this query ID so it's possible to detect if there's any
-		// attempt to modify the data for this query ID while it's being processed
-		to_be_erased_query_id = prm_query_id;
-
-		// Start asynchronous processing of the work to process these hits and output the results
-		resolve_future = async(
-			std::launch::async,
-			process_query_id,
-			std::ref( processors ),
-			prm_query_id,
-			the_filter_spec,
-			std::ref( hit_builder_by_query_id.find( prm_query_id )->second )
+	/// \brief Make a new, empty full_hit_prune_builder with the policy required by the hits_processors
+	inline detail::full_hit_prune_builder read_and_process_mgr::make_builder() const {
+		return detail::full_hit_prune_builder{
+			processors.requires_strictly_worse_hits()
+				? seg_dupl_hit_policy::PRESERVE
+				: seg_dupl_hit_policy::PRUNE
+		};
+	}
+
+	/// \brief Submit the specified hits for the specified query ID to the worker threads for processing
+	///
+	/// This may block until there's room in the queue and may output the results for previously submitted queries.
+	inline void read_and_process_mgr::submit_query_hits(std::string   prm_query_id, ///< The query ID
+	                                                    full_hit_list prm_full_hits ///< The hits for the query
+	                                                    ) {
+		// The task only has const access to processors and the_filter_spec and takes its own copies of the query's data
+		get_resolve_pool().submit(
+			[ &const_processors  = std::as_const( processors      ),
+			  &const_filter_spec = std::as_const( the_filter_spec ),
+			  query_id           = std::move( prm_query_id  ),
+			  full_hits          = std::move( prm_full_hits )       ] () mutable {
+				return const_processors.prepare_hits_for_query( std::move( query_id ), const_filter_spec, std::move( full_hits ) );
+			},
+			[&] (const detail::prepared_query_hits &x) { output_prepared_hits( x ); }
 		);
 	}
 
-	/// \brief Check that any previously triggered async computation is complete
-	inline void read_and_process_mgr::wait_for_any_active_work() const {
-		if ( resolve_future.valid() ) {
-			resolve_future.wait();
+	/// \brief Remove the hits for the specified query ID and submit them to the worker threads for processing
+	///
+	/// \copydetails submit_query_hits()
+	inline void read_and_process_mgr::submit_query_id(const std::string &prm_query_id ///< The query ID
+	                                                  ) {
+		const auto find_itr = hit_builder_by_query_id.find( prm_query_id );
+		full_hit_list full_hits = find_itr->second.get_built_hits();
+		hit_builder_by_query_id.erase( find_itr );
+		submit_query_hits( prm_query_id, std::move( full_hits ) );
+	}
+
+	/// \brief The approximate number of bytes of hits that may currently be held before they're spilled to disk
+	///
+	/// The hits' labels are interned in label_pool, which can't be spilled, so the pool's
+	/// memory is taken out of max_memory_bytes. At least 1 / MIN_HELD_BYTES_DIVISOR of max_memory_bytes
+	/// is always left for the held hits, though, so that labels taking (nearly) all of max_memory_bytes
+	/// don't cause a spill for (nearly) every hit.
+	inline size_t read_and_process_mgr::held_bytes_limit() const {
+		const size_t label_pool_bytes = label_pool->get_num_bytes();
+		const size_t min_limit        = max_memory_bytes / MIN_HELD_BYTES_DIVISOR;
+		return ( label_pool_bytes + min_limit < max_memory_bytes ) ? ( max_memory_bytes - label_pool_bytes )
+		                                                           : min_limit;
+	}
+
+	/// \brief Write all the held hits to a new run in the spill_store (sorted by query ID) and then free them
+	inline void read_and_process_mgr::spill_held_hits() {
+		detail::str_full_hit_list_pair_vec the_run;
+		the_run.reserve( hit_builder_by_query_id.size() );
+		for (auto &[ query_id, builder ] : hit_builder_by_query_id) {
+			if ( ! builder.empty() ) {
+				the_run.emplace_back( query_id, builder.get_built_hits() );
+			}
 		}
+		hit_builder_by_query_id.clear();
+		held_bytes = 0;
+
+		std::sort(
+			::std::begin( the_run ),
+			::std::end  ( the_run ),
+			[] (const detail::str_full_hit_list_pair &x, const detail::str_full_hit_list_pair &y) { return x.first < y.first; }
+		);
+		spill_store.add_run( the_run );
 	}
 
 	/// \brief Ctor from the ostream to which the results should be written
-	inline read_and_process_mgr::read_and_process_mgr(detail::hits_processor_list prm_hits_processors,       ///< The hits_processor to use to process the hits
-	                                                  crh_filter_spec             prm_filter_spec,           ///< The filter spec to define how to filter the hits
-	                                                  const bool                 &prm_input_hits_are_grouped ///< Whether the input hits are guaranteed to be presorted
-	                                                  ) : processors             { std::move( prm_hits_processors ) },
-	                                                      the_filter_spec        { std::move( prm_filter_spec     ) },
-	                                                      input_hits_are_grouped { prm_input_hits_are_grouped       } {
+	inline read_and_process_mgr::read_and_process_mgr(detail::hits_processor_list prm_hits_processors,        ///< The hits_processor to use to process the hits
+	                                                  crh_filter_spec             prm_filter_spec,            ///< The filter spec to define how to filter the hits
+	                                                  const bool                 &prm_input_hits_are_grouped, ///< Whether the input hits are guaranteed to be presorted
+	                                                  const size_t               &prm_num_threads,            ///< The number of worker threads with which to resolve queries (or 0 to use the hardware concurrency)
+	                                                  const size_t               &prm_max_memory_bytes        ///< The approximate number of bytes of ungrouped hits that may be held before they're spilled to disk (or 0 for no limit)
+	                                                  ) : label_pool             { std::make_shared<common::string_intern_pool>() },
+	                                                      processors             { std::move( prm_hits_processors )             },
+	                                                      the_filter_spec        { std::move( prm_filter_spec     )             },
+	                                                      input_hits_are_grouped { prm_input_hits_are_grouped                   },
+	                                                      num_threads            { prm_num_threads                              },
+	                                                      max_memory_bytes       { prm_max_memory_bytes                         } {
 	}
 
 	/// \brief Add a new hit for the current query_id
@@ -241,7 +355,7 @@ namespace cath::rslv {
 	/// \pre `is_active()` else an invalid_argument_exception will be thrown
 	inline void read_and_process_mgr::add_hit(const ::std::string_view &prm_query_id,   ///< A string_view of the query_id
 	                                          seq::seq_seg_vec          prm_segments,   ///< Any fragments of the new hit
-	                                          std::string               prm_label,      ///< The label associated with the new hit
+	                                          const ::std::string_view &prm_label,      ///< The label associated with the new hit (which is interned in label_pool)
 	                                          const double             &prm_score,      ///< The score associated with the new hit
 	                                          const hit_score_type     &prm_score_type, ///< The type of the score
 	                                          hit_extras_store          prm_hit_extras  ///< Any HMMER aligned regions or else none
@@ -257,11 +371,14 @@ namespace cath::rslv {
 		// used for hashing
 		temp_hashable_query_id.assign( prm_query_id.data(), prm_query_id.length() );
 
-		// If input_hits_are_grouped and previous hits had a different query_id, trigger an async worker thread to
-		// process the hits associated with that previous query_id
+		// If input_hits_are_grouped and previous hits had a different query_id, submit the hits associated with
+		// that previous query_id to the worker threads
 		if ( input_hits_are_grouped && prev_query_id_and_hits_builder_ref && prev_query_id_and_hits_builder_ref->first != temp_hashable_query_id ) {
-			trigger_async_process_query_id( prev_query_id_and_hits_builder_ref->first );
+			// Mark to_be_erased_query_id with this query ID so it's possible to detect if there's any
+			// later attempt to add more data for this query ID
+			to_be_erased_query_id = prev_query_id_and_hits_builder_ref->first;
 			prev_query_id_and_hits_builder_ref = ::std::nullopt;
+			submit_query_id( *to_be_erased_query_id );
 		}
 
 		// If this query_id matches to_be_erased_query_id then something's wrong
@@ -281,14 +398,7 @@ namespace cath::rslv {
 			if ( find_itr != ::std::cend( hit_builder_by_query_id ) ) {
 				return find_itr->second;
 			}
-			return hit_builder_by_query_id.emplace(
-				x,
-				detail::full_hit_prune_builder{
-					processors.requires_strictly_worse_hits()
-						? seg_dupl_hit_policy::PRESERVE
-						: seg_dupl_hit_policy::PRUNE
-				}
-			).first->second;
+			return hit_builder_by_query_id.emplace( x, make_builder() ).first->second;
 		};
 
 		// If this is the same query_id as the previous query, then just re-use the cached reference to that query's hits data
@@ -299,13 +409,25 @@ namespace cath::rslv {
 		// std::cerr << "prm_segments size is : " << prm_segments.size() << "\n";
 
 		// Add the new hit to the query's hits data
-		the_builder.add_hit( full_hit{
+		full_hit the_hit{
+			label_pool,
 			std::move( prm_segments ),
-			std::move( prm_label ),
+			prm_label,
 			prm_score,
 			prm_score_type,
 			std::move( prm_hit_extras )
-		} );
+		};
+		const bool limits_memory = ( ! input_hits_are_grouped && max_memory_bytes > 0 );
+		if ( limits_memory ) {
+			held_bytes += detail::approx_held_bytes( the_hit );
+		}
+		the_builder.add_hit( std::move( the_hit ) );
+
+		// If the held hits are now taking too much memory, spill them to disk
+		if ( limits_memory && held_bytes > held_bytes_limit() ) {
+			spill_held_hits();
+			return;
+		}
 
 		// If the input hits are presorted then ensure prev_query_id_and_hits_builder_ref is up-to-date
 		// with this hit
@@ -316,10 +438,20 @@ namespace cath::rslv {
 
 	/// \brief Process all outstanding data
 	inline void read_and_process_mgr::process_all_outstanding() {
-		// If input_hits_are_grouped, there may be asynchronous processing going on, so wait until that's
-		// finished before processing this data (else the results may get interleaved)
-		if ( input_hits_are_grouped ) {
-			wait_for_any_active_work();
+		// If any hits have been spilled to disk, then spill the rest and then merge the runs back together,
+		// rebuilding each query's hits in the same way as if they'd all been held in memory
+		if ( ! spill_store.empty() ) {
+			spill_held_hits();
+			spill_store.merge_runs( label_pool, [&] (std::string prm_query_id, full_hit_vec prm_hits) {
+				detail::full_hit_prune_builder the_builder = make_builder();
+				the_builder.reserve( prm_hits.size() );
+				for (full_hit &the_hit : prm_hits) {
+					the_builder.add_hit( std::move( the_hit ) );
+				}
+				if ( ! the_builder.empty() ) {
+					submit_query_hits( std::move( prm_query_id ), the_builder.get_built_hits() );
+				}
+			} );
 		}
 
 		// Get a sorted list of all the query IDs
@@ -327,23 +459,23 @@ namespace cath::rslv {
 			hit_builder_by_query_id | boost::adaptors::map_keys
 		);
 
-		// Loop over the sorted query IDs
+		// Loop over the sorted query IDs, submitting the data for each to the worker threads
+		// (after any queries that have already been submitted, so the results don't get interleaved)
 		for (const auto &query_id : sorted_query_ids) {
-			// Grab the data for this query_id and process it
-			auto &query_id_full_hits_builder = hit_builder_by_query_id.find( query_id )->second;
-			if ( ! query_id_full_hits_builder.empty() ) {
-				process_query_id(
-					processors,
-					query_id,
-					the_filter_spec,
-					query_id_full_hits_builder
-				);
+			if ( ! hit_builder_by_query_id.find( query_id )->second.empty() ) {
+				submit_query_id( query_id );
 			}
 		}
 
+		// Wait for the worker threads and output the remaining results
+		if ( resolve_pool ) {
+			resolve_pool->finish( [&] (const detail::prepared_query_hits &x) { output_prepared_hits( x ); } );
+		}
+
 		// Clear all data in hit_builder_by_query_id
 		// and wipe prev_query_id_and_hits_builder_ref and to_be_erased_query_id
 		hit_builder_by_query_id.clear();
+		held_bytes = 0;
 		prev_query_id_and_hits_builder_ref = ::std::nullopt;
 		to_be_erased_query_id      = ::std::nullopt;
 
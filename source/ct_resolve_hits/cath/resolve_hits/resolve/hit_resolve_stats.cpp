@@ -0,0 +1,68 @@
+/// \file
+/// \brief The hit_resolve_stats class definitions
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "hit_resolve_stats.hpp"
+
+#include "cath/common/exception/out_of_range_exception.hpp"
+
+#include <ostream>
+
+using namespace ::cath::common;
+using namespace ::cath::rslv;
+
+using ::std::ostream;
+using ::std::string;
+using ::std::string_view;
+
+/// \brief Generate a string describing the specified resolve_budget_breach
+///
+/// \relates resolve_budget_breach
+string cath::rslv::to_string(const resolve_budget_breach &prm_budget_breach ///< The resolve_budget_breach to describe
+                             ) {
+	switch ( prm_budget_breach ) {
+		case ( resolve_budget_breach::NONE          ) : { return "resolve_budget_breach::NONE"          ; }
+		case ( resolve_budget_breach::TOO_MANY_HITS ) : { return "resolve_budget_breach::TOO_MANY_HITS" ; }
+		case ( resolve_budget_breach::TOO_MUCH_WORK ) : { return "resolve_budget_breach::TOO_MUCH_WORK" ; }
+	}
+	BOOST_THROW_EXCEPTION(out_of_range_exception("Value of resolve_budget_breach not recognised whilst converting to_string()"));
+}
+
+/// \brief Insert a description of the specified resolve_budget_breach into the specified ostream
+///
+/// \relates resolve_budget_breach
+ostream & cath::rslv::operator<<(ostream                     &prm_os,           ///< The ostream into which the description should be inserted
+                                 const resolve_budget_breach &prm_budget_breach ///< The resolve_budget_breach to describe
+                                 ) {
+	prm_os << to_string( prm_budget_breach );
+	return prm_os;
+}
+
+/// \brief Get a user-facing description of the specified resolve_budget_breach
+///
+/// \relates resolve_budget_breach
+string_view cath::rslv::description_of_breach(const resolve_budget_breach &prm_budget_breach ///< The resolve_budget_breach to describe
+                                              ) {
+	switch ( prm_budget_breach ) {
+		case ( resolve_budget_breach::NONE          ) : { return "within budget"                                        ; }
+		case ( resolve_budget_breach::TOO_MANY_HITS ) : { return "more hits than the maximum for dynamic-programming"   ; }
+		case ( resolve_budget_breach::TOO_MUCH_WORK ) : { return "dynamic-programming exceeded the maximum work units"  ; }
+	}
+	BOOST_THROW_EXCEPTION(out_of_range_exception("Value of resolve_budget_breach not recognised whilst converting to a description"));
+}
@@ -0,0 +1,118 @@
+/// \file
+/// \brief The hit_resolve_stats class header
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef CATH_TOOLS_SOURCE_CT_RESOLVE_HITS_CATH_RESOLVE_HITS_RESOLVE_HIT_RESOLVE_STATS_HPP
+#define CATH_TOOLS_SOURCE_CT_RESOLVE_HITS_CATH_RESOLVE_HITS_RESOLVE_HIT_RESOLVE_STATS_HPP
+
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+
+#include "cath/common/chrono/chrono_type_aliases.hpp"
+
+namespace cath::rslv {
+
+	/// \brief The ways in which resolving the hits for a query may exceed the budget in a crh_score_spec
+	enum class resolve_budget_breach : char {
+		NONE,          ///< The budget wasn't exceeded
+		TOO_MANY_HITS, ///< The query had more hits than the maximum for which dynamic-programming may be attempted
+		TOO_MUCH_WORK  ///< The dynamic-programming exceeded the maximum number of work units
+	};
+
+	std::string to_string(const resolve_budget_breach &);
+
+	std::ostream & operator<<(std::ostream &,
+	                          const resolve_budget_breach &);
+
+	std::string_view description_of_breach(const resolve_budget_breach &);
+
+	/// \brief Statistics on how the hits for a query were resolved
+	///
+	/// These are recorded as the hits are resolved (which may be on a worker thread) and are then
+	/// passed to the hits_processors so that slow or over-budget queries can be reported
+	class hit_resolve_stats final {
+	private:
+		/// \brief The time taken to resolve the hits
+		hrc_duration resolve_durn = hrc_duration::zero();
+
+		/// \brief The number of work units used by the dynamic-programming
+		///        (ie the number of times it considered adding a hit; 0 if dynamic-programming wasn't used)
+		size_t num_work_units = 0;
+
+		/// \brief Whether (and how) resolving exceeded the budget, so that the naive, greedy approach was used instead
+		resolve_budget_breach budget_breach = resolve_budget_breach::NONE;
+
+	public:
+		hit_resolve_stats() = default;
+		hit_resolve_stats(const hrc_duration &,
+		                  const size_t &,
+		                  const resolve_budget_breach &);
+
+		[[nodiscard]] const hrc_duration &         get_resolve_durn() const;
+		[[nodiscard]] const size_t &               get_num_work_units() const;
+		[[nodiscard]] const resolve_budget_breach &get_budget_breach() const;
+
+		hit_resolve_stats & set_resolve_durn(const hrc_duration &);
+	};
+
+	/// \brief Ctor from all the statistics
+	inline hit_resolve_stats::hit_resolve_stats(const hrc_duration          &prm_resolve_durn,   ///< The time taken to resolve the hits
+	                                            const size_t                &prm_num_work_units, ///< The number of work units used by the dynamic-programming
+	                                            const resolve_budget_breach &prm_budget_breach   ///< Whether (and how) resolving exceeded the budget
+	                                            ) : resolve_durn  { prm_resolve_durn   },
+	                                                num_work_units{ prm_num_work_units },
+	                                                budget_breach { prm_budget_breach  } {
+	}
+
+	/// \brief Getter for the time taken to resolve the hits
+	inline const hrc_duration & hit_resolve_stats::get_resolve_durn() const {
+		return resolve_durn;
+	}
+
+	/// \brief Getter for the number of work units used by the dynamic-programming
+	inline const size_t & hit_resolve_stats::get_num_work_units() const {
+		return num_work_units;
+	}
+
+	/// \brief Getter for whether (and how) resolving exceeded the budget
+	inline const resolve_budget_breach & hit_resolve_stats::get_budget_breach() const {
+		return budget_breach;
+	}
+
+	/// \brief Setter for the time taken to resolve the hits
+	inline hit_resolve_stats & hit_resolve_stats::set_resolve_durn(const hrc_duration &prm_resolve_durn ///< The time taken to resolve the hits
+	                                                               ) {
+		resolve_durn = prm_resolve_durn;
+		return *this;
+	}
+
+	/// \brief Whether the specified hit_resolve_stats indicate that resolving exceeded the budget
+	///        (so that the naive, greedy approach was used instead)
+	///
+	/// \relates hit_resolve_stats
+	inline bool exceeded_budget(const hit_resolve_stats &prm_stats ///< The hit_resolve_stats to query
+	                            ) {
+		return ( prm_stats.get_budget_breach() != resolve_budget_breach::NONE );
+	}
+
+} // namespace cath::rslv
+
+#endif // CATH_TOOLS_SOURCE_CT_RESOLVE_HITS_CATH_RESOLVE_HITS_RESOLVE_HIT_RESOLVE_STATS_HPP
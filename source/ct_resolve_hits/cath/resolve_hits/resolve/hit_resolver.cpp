@@ -31,9 +31,11 @@
 #include "cath/common/config.hpp"
 #include "cath/resolve_hits/algo/masked_bests_cacher.hpp"
 #include "cath/resolve_hits/calc_hit_list.hpp"
+#include "cath/resolve_hits/options/spec/crh_score_spec.hpp"
 #include "cath/resolve_hits/resolve/naive_greedy_hit_resolver.hpp"
 #include "cath/resolve_hits/scored_hit_arch.hpp"
 
+#include <chrono>
 #include <map>
 
 using namespace ::cath::common;
@@ -41,7 +43,10 @@ using namespace ::cath::rslv;
 using namespace ::cath::rslv::detail;
 using namespace ::cath::seq;
 
+using ::std::chrono::high_resolution_clock;
+using ::std::make_pair;
 using ::std::numeric_limits;
+using ::std::pair;
 
 // POSSIBLY TODO:
 //  * Replace sort with in-place insertion during parsing?
@@ -104,6 +109,9 @@ scored_arch_proxy hit_resolver::get_best_score_and_arch_of_specified_regions(con
 		bests.add_best_up_to_arrow( prm_start_arrow, prm_best_upto_start );
 	}
 
+	// Index the mask's segments so each hit can be checked against it without scanning all of the mask's hits
+	const mask_segment_index the_mask_index{ prm_mask };
+
 	// Create a the_masked_bests_cache that's configured to store results in the_masked_bests_cache
 	// whenever it passes a point that may be needed later on
 	masked_bests_cacher the_masked_bests_cacher = make_masked_bests_cacher(
@@ -118,6 +126,11 @@ scored_arch_proxy hit_resolver::get_best_score_and_arch_of_specified_regions(con
 
 	// Loop over the groups of hits' indices that correspond to hits with the same stop point
 	for (const auto &indices_of_hits_with_same_stop : indices_of_hits | equal_grouped( get_hit_stops_differ_fn( hits.get() ) ) ) {
+		// If the budget of work units has been exceeded, just get out (the result will be discarded)
+		if ( out_of_work_units() ) {
+			break;
+		}
+
 		// Grab the stop point of the hits in this group
 		const auto current_arrow = get_stop_arrow( hits.get()[ front( indices_of_hits_with_same_stop ) ] );
 
@@ -142,6 +155,7 @@ scored_arch_proxy hit_resolver::get_best_score_and_arch_of_specified_regions(con
 		const auto best_new_score_and_arch = get_best_scored_arch_with_one_of_hits(
 			indices_of_hits_with_same_stop,
 			prm_mask,
+			the_mask_index,
 			prm_start_arrow,
 			bests,
 			best_prev_score
@@ -169,10 +183,12 @@ scored_arch_proxy hit_resolver::get_best_score_and_arch_of_specified_regions(con
 }
 
 /// \brief Ctor for hit_resolver
-hit_resolver::hit_resolver(const calc_hit_list &prm_hits ///< The hits to resolve
-                           ) : hits     ( prm_hits                               ),
-                               max_stop ( get_max_stop( prm_hits ).value_or( 0 ) ),
-                               the_dhibs( prm_hits                               ) {
+hit_resolver::hit_resolver(const calc_hit_list &prm_hits,          ///< The hits to resolve
+                           const size_opt      &prm_max_work_units ///< An optional maximum number of work units that may be used before the resolving is abandoned
+                           ) : hits          ( prm_hits                               ),
+                               max_stop      ( get_max_stop( prm_hits ).value_or( 0 ) ),
+                               the_dhibs     ( prm_hits                               ),
+                               max_work_units( prm_max_work_units                     ) {
 	constexpr hitidx_t max = numeric_limits<hitidx_t>::max();
 	if ( prm_hits.size() + 2 > max ) {
 		BOOST_THROW_EXCEPTION(invalid_argument_exception(
@@ -187,6 +203,9 @@ hit_resolver::hit_resolver(const calc_hit_list &prm_hits ///< The hits to resolv
 
 /// \brief Method for resolving hits
 ///
+/// If this has a maximum number of work units and that's exceeded, the result is meaningless;
+/// check get_num_work_units() afterwards if that's a possibility
+///
 /// \pre resolve() has never been called before
 scored_hit_arch hit_resolver::resolve() {
 	return make_scored_hit_arch(
@@ -208,4 +227,40 @@ scored_hit_arch cath::rslv::resolve_hits(const calc_hit_list &prm_hits,        /
 	                        : detail::hit_resolver{ prm_hits }.resolve();
 }
 
+/// \brief The front-end for resolving hits within the budget specified in the crh_score_spec
+///
+/// If the query has more hits than the maximum for which dynamic-programming may be attempted or if the
+/// dynamic-programming uses more than the maximum number of work units, this falls back to the naive, greedy
+/// approach, which is quick but may give a worse result. The returned hit_resolve_stats record whether that
+/// happened, along with the time taken and the number of work units used.
+///
+/// Work units (the number of times the dynamic-programming considers a hit) are used rather than wall-clock time
+/// so that whether a query falls back doesn't depend on the machine or its load, which keeps the results reproducible.
+pair<scored_hit_arch, hit_resolve_stats> cath::rslv::resolve_hits_within_budget(const calc_hit_list  &prm_hits,      ///< The hits to resolve
+                                                                               const crh_score_spec &prm_score_spec ///< The score spec specifying the approach and the budget
+                                                                               ) {
+	const auto start_time = high_resolution_clock::now();
+	const auto make_result = [&] (scored_hit_arch prm_arch, const size_t &prm_num_work_units, const resolve_budget_breach &prm_breach) {
+		return make_pair(
+			std::move( prm_arch ),
+			hit_resolve_stats{ high_resolution_clock::now() - start_time, prm_num_work_units, prm_breach }
+		);
+	};
+
+	if ( prm_score_spec.get_naive_greedy() ) {
+		return make_result( naive_greedy_resolve_hits( prm_hits ), 0, resolve_budget_breach::NONE );
+	}
 
+	const size_opt &max_dp_hits = prm_score_spec.get_max_dp_hits();
+	if ( max_dp_hits && prm_hits.size() > *max_dp_hits ) {
+		return make_result( naive_greedy_resolve_hits( prm_hits ), 0, resolve_budget_breach::TOO_MANY_HITS );
+	}
+
+	detail::hit_resolver the_resolver{ prm_hits, prm_score_spec.get_max_dp_work() };
+	scored_hit_arch resolved_arch = the_resolver.resolve();
+	const size_opt &max_dp_work = prm_score_spec.get_max_dp_work();
+	if ( max_dp_work && the_resolver.get_num_work_units() > *max_dp_work ) {
+		return make_result( naive_greedy_resolve_hits( prm_hits ), the_resolver.get_num_work_units(), resolve_budget_breach::TOO_MUCH_WORK );
+	}
+	return make_result( std::move( resolved_arch ), the_resolver.get_num_work_units(), resolve_budget_breach::NONE );
+}
@@ -25,13 +25,18 @@
 
 #include "cath/resolve_hits/algo/best_scan_arches.hpp"
 #include "cath/resolve_hits/algo/discont_hits_index_by_start.hpp"
+#include "cath/resolve_hits/algo/mask_segment_index.hpp"
 #include "cath/resolve_hits/algo/masked_bests_cache.hpp"
 #include "cath/resolve_hits/calc_hit_list.hpp"
+#include "cath/resolve_hits/resolve/hit_resolve_stats.hpp"
 #include "cath/resolve_hits/resolve_hits_type_aliases.hpp"
 
 #include <functional>
+#include <optional>
+#include <utility>
 
 // clang-format off
+namespace cath::rslv { class crh_score_spec; }
 namespace cath::rslv { class scored_hit_arch; }
 // clang-format on
 
@@ -59,6 +64,7 @@ namespace cath::rslv {
 
 			scored_arch_proxy_opt get_best_scored_arch_with_one_of_hits(const boost::sub_range<boost::integer_range<hitidx_t>> &,
 			                                                            const calc_hit_vec &,
+			                                                            const mask_segment_index &,
 			                                                            const seq::seq_arrow &,
 			                                                            const best_scan_arches &,
 			                                                            const resscr_t &);
@@ -78,17 +84,40 @@ namespace cath::rslv {
 			/// This is initialised on construction and isn't modified after that
 			discont_hits_index_by_start the_dhibs;
 
+			/// \brief An optional maximum number of work units that may be used before the resolving is abandoned
+			size_opt max_work_units;
+
+			/// \brief The number of work units used so far (ie the number of times a hit has been considered)
+			size_t num_work_units = 0;
+
+			[[nodiscard]] bool out_of_work_units() const;
+
 			scored_arch_proxy get_best_score_and_arch_of_specified_regions(const calc_hit_vec &,
 			                                                               const seq::seq_arrow &,
 			                                                               const seq::seq_arrow &,
 			                                                               const scored_arch_proxy &);
 
 		public:
-			explicit hit_resolver(const calc_hit_list &);
+			explicit hit_resolver(const calc_hit_list &,
+			                      const size_opt & = ::std::nullopt);
 
 			scored_hit_arch resolve();
+
+			[[nodiscard]] const size_t &get_num_work_units() const;
 		};
 
+		/// \brief Whether the number of work units used has exceeded the maximum (if any)
+		///
+		/// Once this is true, the dynamic-programming returns as quickly as it can and its result is meaningless
+		inline bool hit_resolver::out_of_work_units() const {
+			return ( max_work_units && num_work_units > *max_work_units );
+		}
+
+		/// \brief Getter for the number of work units used so far
+		inline const size_t & hit_resolver::get_num_work_units() const {
+			return num_work_units;
+		}
+
 		/// \brief Update the scored_arch_proxy_opt if the specified hit improves
 		///        on the best result seen so far
 		///
@@ -117,6 +146,7 @@ namespace cath::rslv {
 		/// Note: Not using max_element because that'd probably call get_complex_hit_score() twice for many elements
 		inline scored_arch_proxy_opt hit_resolver::get_best_scored_arch_with_one_of_hits(const boost::sub_range<boost::integer_range<hitidx_t>> &prm_hit_indices,  ///< The indices of the hits to consider
 		                                                                                 const calc_hit_vec                                     &prm_mask,         ///< The active mask defining no-go regions
+		                                                                                 const mask_segment_index                               &prm_mask_index,   ///< An index of prm_mask's segments for quick overlap checks
 		                                                                                 const seq::seq_arrow                                   &prm_start_arrow,  ///< The start point of the current scan (from which prm_bests should have results (up to the one place before the stop of these hits))
 		                                                                                                                                                           ///< Guaranteed to be at the boundary of a segment in prm_masks, or at the very start if prm_masks is empty
 		                                                                                 const best_scan_arches                                 &prm_bests,        ///< The history of best-seen architectures so far in this layer of dynamic programming. This is setup to handle the current forbidden prm_masks.
@@ -125,11 +155,17 @@ namespace cath::rslv {
 			// Loop over each of the hits that stop at prm_current_arrow
 			scored_arch_proxy_opt best_so_far;
 			for (const auto &hit_index : prm_hit_indices) {
+				// Count this as a work unit and give up if that exceeds the budget
+				++num_work_units;
+				if ( out_of_work_units() ) {
+					break;
+				}
+
 				const auto &the_hit = hits.get()[ hit_index ];
 
 				// If this hit clashes with the forbidden regions marked out by prm_mask,
 				// then it can't be used so skip to the next one
-				if ( hit_overlaps_with_any_of_hits( the_hit, prm_mask ) ) {
+				if ( hit_overlaps_with_mask( the_hit, prm_mask_index ) ) {
 					continue;
 				}
 
@@ -208,6 +244,9 @@ namespace cath::rslv {
 	scored_hit_arch resolve_hits(const calc_hit_list &,
 	                             const bool &);
 
+	std::pair<scored_hit_arch, hit_resolve_stats> resolve_hits_within_budget(const calc_hit_list &,
+	                                                                         const crh_score_spec &);
+
 } // namespace cath::rslv
 
 #endif // CATH_TOOLS_SOURCE_CT_RESOLVE_HITS_CATH_RESOLVE_HITS_RESOLVE_HIT_RESOLVER_HPP
@@ -18,11 +18,18 @@
 /// You should have received a copy of the GNU General Public License
 /// along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
+#include <boost/algorithm/string/erase.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/test/unit_test.hpp>
 
 #include "cath/common/file/ofstream_list.hpp"
+#include "cath/common/size_t_literal.hpp"
 #include "cath/resolve_hits/options/spec/crh_spec.hpp"
+#include "cath/resolve_hits/read_and_process_hits/hits_processor/hits_processor_list.hpp"
+#include "cath/resolve_hits/read_and_process_hits/hits_processor/summarise_hits_processor.hpp"
+#include "cath/resolve_hits/read_and_process_hits/hits_processor/write_html_hits_processor.hpp"
+#include "cath/resolve_hits/read_and_process_hits/hits_processor/write_json_hits_processor.hpp"
+#include "cath/resolve_hits/read_and_process_hits/hits_processor/write_results_hits_processor.hpp"
 #include "cath/resolve_hits/read_and_process_hits/read_and_process_mgr.hpp"
 #include "cath/resolve_hits/resolve/hit_resolver.hpp"
 #include "cath/resolve_hits/test/resolve_hits_fixture.hpp"
@@ -33,8 +40,13 @@ using namespace ::cath::common;
 using namespace ::cath::rslv;
 using namespace ::cath::rslv::detail;
 
+using ::boost::algorithm::erase_all;
+using ::cath::common::literals::operator""_z;
+
 using ::std::istringstream;
+using ::std::literals::string_literals::operator""s;
 using ::std::ostringstream;
+using ::std::pair;
 using ::std::string;
 
 namespace {
@@ -43,6 +55,62 @@ namespace {
 		struct hit_resolver_test_suite_fixture : protected resolve_hits_fixture {
 		protected:
 			~hit_resolver_test_suite_fixture() noexcept = default;
+
+			/// \brief The line that flags that the specified query was resolved with the naive, greedy approach
+			///        because it exceeded the budget in the specified way
+			static string budget_flag(const string                &prm_query_id,     ///< The ID of the query
+			                          const resolve_budget_breach &prm_budget_breach ///< How the query exceeded the budget
+			                          ) {
+				return "# WARNING: Query " + prm_query_id + " was resolved with the naive, greedy approach ("
+					+ string( description_of_breach( prm_budget_breach ) )
+					+ ")\n";
+			}
+
+			/// \brief Check that the specified output flags each of the example queries as having exceeded the budget
+			///        in the specified way and that it otherwise matches the specified expected output
+			static void check_flagged_output(const string                &prm_output,          ///< The output to check
+			                                 const resolve_budget_breach &prm_budget_breach,   ///< How each of the queries should have exceeded the budget
+			                                 const string                &prm_expected_output  ///< The expected output, once the flags have been removed
+			                                 ) {
+				string unflagged_output = prm_output;
+				for (const string &query_id : { "qyikaz"s, "iexvva"s } ) {
+					const string flag = budget_flag( query_id, prm_budget_breach );
+					BOOST_CHECK_NE( unflagged_output.find( flag ), string::npos );
+					erase_all( unflagged_output, flag );
+				}
+				BOOST_CHECK_EQUAL( unflagged_output, prm_expected_output );
+			}
+
+			/// \brief Resolve the example hits with the specified crh_score_spec and return the standard output
+			static string resolve_example(const crh_score_spec &prm_score_spec ///< The crh_score_spec with which to resolve the hits
+			                              ) {
+				istringstream test_iss{ string( EXAMPLE_INPUT_RAW ) };
+				ostringstream test_oss;
+				ofstream_list ofstreams{ test_oss };
+				read_and_process_mgr the_read_and_process_mgr = make_read_and_process_mgr(
+					ofstreams,
+					crh_spec{}
+						.set_score_spec( prm_score_spec )
+				);
+				read_hit_list_from_istream( the_read_and_process_mgr, test_iss, hit_score_type::CRH_SCORE );
+				return blank_vrsn( test_oss );
+			}
+
+			/// \brief Resolve the example hits with the specified crh_score_spec and return the JSON and HTML outputs
+			static pair<string, string> resolve_example_to_json_and_html(const crh_score_spec &prm_score_spec ///< The crh_score_spec with which to resolve the hits
+			                                                             ) {
+				istringstream test_iss{ string( EXAMPLE_INPUT_RAW ) };
+				ostringstream json_oss;
+				ostringstream html_oss;
+				read_and_process_mgr the_read_and_process_mgr = make_read_and_process_mgr(
+					hits_processor_list{ prm_score_spec }
+						.add_processor( write_json_hits_processor{ { json_oss }                  } )
+						.add_processor( write_html_hits_processor{ { html_oss }, crh_html_spec{} } ),
+					crh_spec{}
+				);
+				read_hit_list_from_istream( the_read_and_process_mgr, test_iss, hit_score_type::CRH_SCORE );
+				return { json_oss.str(), html_oss.str() };
+			}
 		};
 
 } // namespace
@@ -63,4 +131,92 @@ BOOST_AUTO_TEST_CASE(basic) {
 	BOOST_CHECK_EQUAL( blank_vrsn( test_oss ), EXAMPLE_OUTPUT );
 }
 
+BOOST_AUTO_TEST_CASE(spilling_hits_to_disk_does_not_change_results) {
+	const crh_spec the_spec = crh_spec{}.set_score_spec( make_neutral_score_spec() );
+	for (const size_t &max_memory_bytes : { 1_z, 2000_z } ) {
+		istringstream test_iss{ string( EXAMPLE_INPUT_RAW ) };
+		ostringstream test_oss;
+		ofstream_list ofstreams{ test_oss };
+		read_and_process_mgr the_read_and_process_mgr{
+			make_hits_processors(
+				ofstreams,
+				the_spec.get_single_output_spec(),
+				the_spec.get_output_spec(),
+				the_spec.get_score_spec(),
+				the_spec.get_segment_spec(),
+				the_spec.get_html_spec()
+			),
+			the_spec.get_filter_spec(),
+			false,
+			1,
+			max_memory_bytes
+		};
+		read_hit_list_from_istream( the_read_and_process_mgr, test_iss, hit_score_type::CRH_SCORE );
+
+		BOOST_CHECK_EQUAL( blank_vrsn( test_oss ), EXAMPLE_OUTPUT );
+	}
+}
+
+BOOST_AUTO_TEST_CASE(generous_budget_does_not_change_results) {
+	BOOST_CHECK_EQUAL(
+		resolve_example( make_neutral_score_spec().set_max_dp_hits( 1'000_z ).set_max_dp_work( 1'000'000_z ) ),
+		EXAMPLE_OUTPUT
+	);
+}
+
+BOOST_AUTO_TEST_CASE(exceeding_budget_falls_back_to_naive_greedy_and_flags_query) {
+	const string naive_greedy_output = resolve_example( make_neutral_score_spec().set_naive_greedy( true ) );
+
+	check_flagged_output(
+		resolve_example( make_neutral_score_spec().set_max_dp_hits( 5_z ) ),
+		resolve_budget_breach::TOO_MANY_HITS,
+		naive_greedy_output
+	);
+	check_flagged_output(
+		resolve_example( make_neutral_score_spec().set_max_dp_work( 5_z ) ),
+		resolve_budget_breach::TOO_MUCH_WORK,
+		naive_greedy_output
+	);
+}
+
+BOOST_AUTO_TEST_CASE(summary_reports_resolving_and_over_budget_queries) {
+	istringstream test_iss{ string( EXAMPLE_INPUT_RAW ) };
+	ostringstream results_oss;
+	ostringstream summary_oss;
+	const crh_score_spec score_spec = make_neutral_score_spec().set_max_dp_work( 5_z );
+	read_and_process_mgr the_read_and_process_mgr = make_read_and_process_mgr(
+		hits_processor_list{ score_spec }
+			.add_processor( write_results_hits_processor{ { results_oss } } )
+			.add_processor( summarise_hits_processor    { { summary_oss } } ),
+		crh_spec{}
+	);
+	read_hit_list_from_istream( the_read_and_process_mgr, test_iss, hit_score_type::CRH_SCORE );
+
+	const string summary = summary_oss.str();
+	BOOST_CHECK_NE( summary.find( "Summary of resolving\n--------------------\n * Number of queries :      2" ), string::npos );
+	BOOST_CHECK_NE( summary.find( " * Over budget       :      2"                                           ), string::npos );
+	BOOST_CHECK_NE( summary.find( " * Over-budget queries :\n"                                              ), string::npos );
+	BOOST_CHECK_NE( summary.find( string( description_of_breach( resolve_budget_breach::TOO_MUCH_WORK ) ) ), string::npos );
+}
+
+BOOST_AUTO_TEST_CASE(json_and_html_flag_over_budget_queries) {
+	const string json_key  = "\"" + string( write_json_hits_processor::NAIVE_GREEDY_QUERIES_KEY ) + "\"";
+	const string html_note = R"(<div class="crh-budget-note">Resolved with the naive, greedy approach ()"
+		+ string( description_of_breach( resolve_budget_breach::TOO_MUCH_WORK ) );
+
+	const auto [ within_json, within_html ] = resolve_example_to_json_and_html( make_neutral_score_spec() );
+	BOOST_CHECK_EQUAL( within_json.find( json_key  ), string::npos );
+	BOOST_CHECK_EQUAL( within_html.find( html_note ), string::npos );
+
+	const auto [ over_json, over_html ] = resolve_example_to_json_and_html( make_neutral_score_spec().set_max_dp_work( 5_z ) );
+	const size_t key_posn = over_json.find( json_key );
+	BOOST_REQUIRE_NE( key_posn, string::npos );
+	for (const string &query_id : { "qyikaz"s, "iexvva"s } ) {
+		BOOST_CHECK_NE( over_json.find( "\"" + query_id + "\"", key_posn ), string::npos );
+	}
+	const size_t first_note_posn = over_html.find( html_note );
+	BOOST_REQUIRE_NE( first_note_posn, string::npos );
+	BOOST_CHECK_NE  ( over_html.find( html_note, first_note_posn + 1 ), string::npos );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
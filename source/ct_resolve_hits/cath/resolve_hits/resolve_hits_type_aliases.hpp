@@ -35,6 +35,7 @@ namespace cath::rslv { class crh_segment_spec; }
 namespace cath::rslv { class full_hit; }
 namespace cath::rslv { class full_hit_list; }
 namespace cath::rslv { class scored_arch_proxy; }
+namespace cath::rslv { class scored_hit_arch; }
 namespace cath::rslv { class trim_spec; }
 namespace cath::rslv { struct alnd_rgn; }
 namespace cath::rslv { struct html_hit; }
@@ -104,6 +105,9 @@ namespace cath::rslv {
 	/// \brief Type alias for a vector of scored_arch_proxy objects
 	using scored_arch_proxy_vec         = std::vector<scored_arch_proxy>;
 
+	/// \brief Type alias for an optional scored_hit_arch object
+	using scored_hit_arch_opt           = ::std::optional<scored_hit_arch>;
+
 	/// \brief Type alias for a pair of res_arrow_opt values
 	using seg_boundary_pair             = std::pair<seq::res_arrow_opt, seq::res_arrow_opt>;
 
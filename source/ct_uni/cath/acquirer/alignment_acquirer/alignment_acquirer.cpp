@@ -46,6 +46,7 @@ using namespace ::cath::file;
 using namespace ::cath::opts;
 
 using ::std::make_unique;
+using ::std::nullopt;
 using ::std::pair;
 using ::std::unique_ptr;
 
@@ -137,7 +138,11 @@ uptr_vec<alignment_acquirer> cath::align::get_alignment_acquirers(const alignmen
 		alignment_acquirers.push_back( make_unique< ssap_scores_file_alignment_acquirer >( prm_alignment_input_spec.get_ssap_scores_file()     ) );
 	}
 	if ( prm_alignment_input_spec.get_do_the_ssaps_dir() ) {
-		alignment_acquirers.push_back( make_unique< do_the_ssaps_alignment_acquirer     >( *prm_alignment_input_spec.get_do_the_ssaps_dir()    ) );
+		alignment_acquirers.push_back( make_unique< do_the_ssaps_alignment_acquirer     >(
+			*prm_alignment_input_spec.get_do_the_ssaps_dir(),
+			prm_alignment_input_spec.get_progressive_ssaps(),
+			prm_alignment_input_spec.get_num_ssap_threads()
+		) );
 	}
 
 	if ( alignment_acquirers.size() != get_num_acquirers( prm_alignment_input_spec ) ) {
@@ -168,7 +173,11 @@ unique_ptr<alignment_acquirer> cath::align::get_alignment_acquirer(const alignme
 
 	// If no alignment_acquirer has been specified then use a do_the_ssaps_alignment_acquirer
 	if ( alignment_acquirers.empty() ) {
-		return make_unique< do_the_ssaps_alignment_acquirer >();
+		return make_unique< do_the_ssaps_alignment_acquirer >(
+			nullopt,
+			prm_alignment_input_spec.get_progressive_ssaps(),
+			prm_alignment_input_spec.get_num_ssap_threads()
+		);
 	}
 
 	if ( alignment_acquirers.size() != 1 ) {
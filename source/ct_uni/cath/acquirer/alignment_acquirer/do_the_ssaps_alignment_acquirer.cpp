@@ -20,61 +20,181 @@
 
 #include "do_the_ssaps_alignment_acquirer.hpp"
 
-#include <array>
+#include <atomic>
 #include <filesystem>
 #include <sstream>
+#include <tuple>
 #include <utility>
 
 #include <boost/algorithm/string/join.hpp>
 #include <boost/algorithm/string/trim.hpp>
-#include <boost/format.hpp>
 #include <boost/range/adaptor/transformed.hpp>
+#include <boost/range/algorithm/sort.hpp>
 #include <boost/range/irange.hpp>
 
-#include <fmt/core.h>
-
 #include <spdlog/fmt/ostr.h>
 #include <spdlog/spdlog.h>
 
 #include "cath/acquirer/alignment_acquirer/ssap_scores_file_alignment_acquirer.hpp"
 #include "cath/alignment/alignment.hpp"
-#include "cath/chopping/chopping_format/sillitoe_chopping_format.hpp"
 #include "cath/chopping/domain/domain.hpp"
+#include "cath/common/algorithm/transform_build.hpp"
+#include "cath/common/boost_addenda/graph/spanning_tree.hpp"
+#include "cath/common/boost_addenda/range/indices.hpp"
 #include "cath/common/clone/make_uptr_clone.hpp"
-#include "cath/common/exception/not_implemented_exception.hpp"
 #include "cath/common/exception/runtime_error_exception.hpp"
-#include "cath/common/file/open_fstream.hpp"
 #include "cath/common/file/slurp.hpp"
 #include "cath/common/file/spew.hpp"
-#include "cath/common/matrix/matrix_index.hpp"
+#include "cath/common/size_t_literal.hpp"
 #include "cath/common/test_or_exe_run_mode.hpp"
+#include "cath/common/thread/parallel_for_each_index.hpp"
+#include "cath/file/name_set/name_set.hpp"
+#include "cath/file/name_set/name_set_list.hpp"
+#include "cath/file/options/data_dirs_spec.hpp"
+#include "cath/file/pdb/pdb.hpp"
+#include "cath/file/pdb/pdb_list.hpp"
+#include "cath/file/ssap_scores_file/ssap_scores_entry.hpp"
+#include "cath/file/ssap_scores_file/ssap_scores_file.hpp"
 #include "cath/file/strucs_context.hpp"
 #include "cath/ssap/options/cath_ssap_options.hpp"
 #include "cath/ssap/ssap.hpp"
-#include "cath/superposition/options/align_regions_options_block.hpp"
+#include "cath/structure/protein/protein.hpp"
+#include "cath/structure/protein/protein_io.hpp"
+#include "cath/structure/protein/residue.hpp"
+#include "cath/structure/protein/sec_struc.hpp"
+#include "cath/structure/protein/sec_struc_planar_angles.hpp"
+#include "cath/structure/structure_type_aliases.hpp"
 
 using namespace ::cath;
 using namespace ::cath::align;
-using namespace ::cath::chop;
 using namespace ::cath::common;
 using namespace ::cath::file;
 using namespace ::cath::opts;
 
 using ::boost::adaptors::transformed;
 using ::boost::algorithm::join;
+using ::boost::algorithm::trim_copy;
 using ::boost::algorithm::trim_right_copy;
-using ::boost::format;
 using ::boost::irange;
-using ::std::array;
+using ::boost::range::sort;
+using ::std::atomic;
 using ::std::filesystem::path;
-using ::std::filesystem::temp_directory_path;
+using ::std::istringstream;
+using ::std::make_pair;
+using ::std::make_tuple;
 using ::std::max;
-using ::std::ofstream;
+using ::std::min;
 using ::std::ostringstream;
 using ::std::pair;
 using ::std::string;
 using ::std::unique_ptr;
 
+namespace {
+
+	/// \brief Get the cath_ssap_options that cath-ssap would parse from the environment and config file
+	///        (or just the defaults when running the tests)
+	///
+	/// These are parsed on first use and then reused
+	const cath_ssap_options & get_env_and_file_cath_ssap_options() {
+		static const cath_ssap_options the_options = make_and_parse_options<cath_ssap_options>(
+			str_vec{ string( cath_ssap_options::PROGRAM_NAME ) },
+			( run_mode_flag::value == run_mode::TEST )
+				? parse_sources::CMND_LINE_ONLY
+				: parse_sources::CMND_ENV_AND_FILE
+		);
+		return the_options;
+	}
+
+	/// \brief Write any non-empty output that was captured whilst doing the SSAPs
+	void report_ssap_output(const str_vec         &prm_outputs, ///< The captured outputs
+	                        const ostream_ref_opt &prm_ostream  ///< An (optional reference_wrapper of an) ostream to which they should be written (or nullopt to log them)
+	                        ) {
+		for (const string &output : prm_outputs) {
+			if ( ! output.empty() ) {
+				if ( prm_ostream ) {
+					prm_ostream->get() << output;
+				}
+				else {
+					::spdlog::info( "SSAP output : {}", output );
+				}
+			}
+		}
+	}
+
+	/// \brief Build SSAP-ready proteins for the structures in the specified strucs_context using up to the specified number of threads
+	///
+	/// This restricts each PDB to its regions and then calculates the DSSP and sec data, as cath-ssap does when
+	/// reading a PDB file. Each protein is named with the strucs_context's name_set for the structure.
+	protein_vec make_ssap_proteins(const strucs_context  &prm_strucs_context, ///< The strucs_context containing the structures
+	                               const size_t          &prm_num_threads,    ///< The number of threads to use
+	                               const ostream_ref_opt &prm_ostream         ///< An (optional reference_wrapper of an) ostream to which warnings/errors should be written
+	                               ) {
+		const size_t num_strucs = size( prm_strucs_context );
+		protein_vec proteins( num_strucs );
+		str_vec     outputs ( num_strucs );
+		parallel_for_each_index( num_strucs, prm_num_threads, [&] (const size_t &struc_index) {
+			const name_set &the_names = prm_strucs_context.get_name_sets()[ struc_index ];
+			ostringstream   output_ss;
+			proteins[ struc_index ] = make_protein_from_pdb_and_calc_dssp_and_sec(
+				get_regions_limited_pdb(
+					prm_strucs_context.get_regions()[ struc_index ],
+					prm_strucs_context.get_pdbs()[ struc_index ]
+				),
+				the_names.get_name_from_acq(),
+				ostream_ref( output_ss )
+			);
+			proteins[ struc_index ].set_name_set( the_names );
+			outputs [ struc_index ] = output_ss.str();
+		} );
+		report_ssap_output( outputs, prm_ostream );
+		return proteins;
+	}
+
+	/// \brief Make a list of every pair of the specified number of structures (in the order in which they're SSAPed)
+	size_size_pair_vec make_all_ssap_pairs(const size_t &prm_num_strucs ///< The number of structures
+	                                       ) {
+		size_size_pair_vec ssap_pairs;
+		ssap_pairs.reserve( ( prm_num_strucs * ( max( 1_z, prm_num_strucs ) - 1_z ) ) / 2_z );
+		for (const size_t &struc_1_index : indices( prm_num_strucs ) ) {
+			for (const size_t &struc_2_index : irange( struc_1_index + 1, prm_num_strucs ) ) {
+				ssap_pairs.emplace_back( struc_1_index, struc_2_index );
+			}
+		}
+		return ssap_pairs;
+	}
+
+	/// \brief Make the list of pairs of the specified proteins that form a maximum spanning tree
+	///        over their cheap, secondary-structure-only SSAP scores (see ssap_sec_struc_score())
+	///
+	/// The cheap scores are calculated for all pairs using up to the specified number of threads.
+	/// Each returned pair has its lower index first and the pairs are sorted.
+	size_size_pair_vec make_cheap_spanning_tree_ssap_pairs(const protein_vec            &prm_proteins,     ///< The SSAP-ready proteins
+	                                                       const old_ssap_options_block &prm_ssap_options, ///< The old_ssap_options_block to specify how things should be done
+	                                                       const data_dirs_spec         &prm_data_dirs,    ///< The data directories from which any data should be read
+	                                                       const size_t                 &prm_num_threads   ///< The number of threads to use
+	                                                       ) {
+		const size_t             num_strucs = prm_proteins.size();
+		const size_size_pair_vec all_pairs  = make_all_ssap_pairs( num_strucs );
+		size_size_doub_tpl_vec   cheap_scores( all_pairs.size() );
+		parallel_for_each_index( all_pairs.size(), prm_num_threads, [&] (const size_t &prm_index) {
+			const auto &[ struc_1_index, struc_2_index ] = all_pairs[ prm_index ];
+			cheap_scores[ prm_index ] = make_tuple(
+				struc_1_index,
+				struc_2_index,
+				ssap_sec_struc_score( prm_proteins[ struc_1_index ], prm_proteins[ struc_2_index ], prm_ssap_options, prm_data_dirs )
+			);
+		} );
+
+		size_size_pair_vec tree_pairs = transform_build<size_size_pair_vec>(
+			get_edges_of_spanning_tree( calc_max_spanning_tree( cheap_scores, num_strucs ) ),
+			[] (const size_size_pair &x) { return make_pair( min( x.first, x.second ), max( x.first, x.second ) ); }
+		);
+		sort( tree_pairs );
+		return tree_pairs;
+	}
+
+} // namespace
+
 /// \brief A standard do_clone method.
 unique_ptr<alignment_acquirer> do_the_ssaps_alignment_acquirer::do_clone() const {
 	return { make_uptr_clone( *this ) };
@@ -86,145 +206,218 @@ bool do_the_ssaps_alignment_acquirer::do_requires_backbone_complete_input() cons
 }
 
 /// \brief Run the necessary cath-ssaps and then use them to get the alignment and spanning tree
+///
+/// The SSAPs are run directly on the structures in the strucs_context, using the specified number of threads
+/// (or all the hardware threads), and their results are kept in memory.
+///
+/// In the progressive approach, rather than SSAPing all N(N-1)/2 pairs, every pair is first compared cheaply
+/// by only aligning their secondary structures. Full SSAPs are then only run on the N-1 pairs in the
+/// maximum spanning tree of those cheap scores, which then become the spanning tree for glueing the alignments.
+///
+/// If a directory was specified, it's used as a cache: any pair with non-empty .scores and .list files there
+/// is read rather than SSAPed and the results of any new SSAPs are written there (as is the concatenated ssap_scores file)
 pair<alignment, size_size_pair_vec> do_the_ssaps_alignment_acquirer::do_get_alignment_and_spanning_tree(const strucs_context  &prm_strucs_context, ///< The details of the structures for which the alignment and spanning tree is required
                                                                                                         const align_refining  &prm_align_refining, ///< How much refining should be done to the alignment
                                                                                                         const ostream_ref_opt &prm_ostream         ///< An (optional reference_wrapper of an) ostream to which warnings/errors should be written
                                                                                                         ) const {
-	using ::std::to_string;
-
-	// Get the directory in which the cath-ssaps should be done
-	const path ssaps_dir = get_directory_of_joy().value_or(
-		make_temp_dir_for_doing_ssaps( prm_strucs_context )
-	);
-
-	// Ensure the directory exists
-	if ( ! exists( ssaps_dir ) ) {
-		::spdlog::info( "About to create directory {}", ssaps_dir );
-		if ( ! create_directories( ssaps_dir ) ) {
+	// Ensure any cache directory exists
+	if ( directory_of_joy && ! exists( *directory_of_joy ) ) {
+		::spdlog::info( "About to create directory {}", *directory_of_joy );
+		if ( ! create_directories( *directory_of_joy ) ) {
 			BOOST_THROW_EXCEPTION(runtime_error_exception(
 				"Unable to create directory "
-				+ ssaps_dir.string()
-				+ " for temporary cath-ssaps"
+				+ directory_of_joy->string()
+				+ " for caching cath-ssaps"
 			));
 		}
 	}
 
-	// Perform any necessary cath-ssaps
-	path_vec scores_files;
-	const size_t num_strucs        = size( prm_strucs_context );
-	const size_t num_ssaps         = ( num_strucs * ( max( 1_z, num_strucs ) - 1_z ) ) / 2_z;
-	const string num_str           = to_string( num_ssaps );
-	const size_t num_str_width     = num_str.length();
-	const string num_str_width_str = "%" + to_string( num_str_width ) + "d";
-	::spdlog::info( "About to check for and possibly run {} cath-ssaps in directory {}", num_ssaps, ssaps_dir );
-	for (const size_t &struc_1_index : indices( num_strucs ) ) {
-		for (const size_t &struc_2_index : irange( struc_1_index + 1, num_strucs ) ) {
-
-			const size_t comp_ctr_offset_1 = get_zero_index_of_strict_upper_half_matrix(
-				struc_1_index,
-				struc_2_index,
-				num_strucs
-			) + 1;
-			const string progress_str = ( format( num_str_width_str ) % comp_ctr_offset_1 ).str()
-				+ "/"
-				+ num_str;
-
-			// \TODO: Abstract out functions for making these standard file names
-			const string id_1   = get_domain_or_specified_or_name_from_acq( prm_strucs_context.get_name_sets()[ struc_1_index ] );
-			const string id_2   = get_domain_or_specified_or_name_from_acq( prm_strucs_context.get_name_sets()[ struc_2_index ] );
-			const path   scores_file = ssaps_dir / ( id_1 + id_2 + ".scores" );
-			const path   alnmnt_file = ssaps_dir / ( id_1 + id_2 + ".list"   );
-
-			scores_files.push_back( scores_file );
-
-			if (   ! exists( scores_file ) || ! exists( alnmnt_file )
-				|| is_empty( scores_file ) || is_empty( alnmnt_file ) ) {
-
-				// \TODO Tighten up the interface with the ssap/ssap.cpp code here
-				//
-				// In particular, the name_set will know the location of the file that each
-				// PDB was loaded from (if it was loaded from a PDB) so cath-ssap should have
-				// a --pdb-infile option and it should be explicitly used here.
-				str_vec cath_ssap_args{ string( cath_ssap_options::PROGRAM_NAME ),
-					                    ::fmt::format( "--{}", old_ssap_options_block::PO_ALIGN_DIR ),
-					                    ssaps_dir.string() };
-				for (const size_t &index : { struc_1_index, struc_2_index } ) {
-					const auto       &name_set   = prm_strucs_context.get_name_sets()[ index ];
-					const domain_opt  opt_domain = get_domain_opt_of_index( prm_strucs_context, index );
-					cath_ssap_args.push_back( name_set.get_name_from_acq() );
-					if ( opt_domain ) {
-						cath_ssap_args.push_back( ::fmt::format( "--{}", align_regions_options_block::PO_ALN_REGIONS ) );
-						cath_ssap_args.push_back( sillitoe_chopping_format{}.write_domain( *opt_domain ) );
-					}
-				}
-				::spdlog::info( "[{}] Running : {} and writing scores to {}",
-				                progress_str,
-				                join( cath_ssap_args, " " ),
-				                scores_file.string() );
-				ofstream out_scores_ofstream = open_ofstream( scores_file );
-				array<ostringstream, 2> ssap_stdout_and_stderr;
-				run_ssap(
-					make_and_parse_options<cath_ssap_options>(
-						cath_ssap_args,
-						( run_mode_flag::value == run_mode::TEST )
-							? parse_sources::CMND_LINE_ONLY
-							: parse_sources::CMND_ENV_AND_FILE
-					),
-					prm_ostream ? prm_ostream->get() : ssap_stdout_and_stderr.front(),
-					prm_ostream ? prm_ostream->get() : ssap_stdout_and_stderr.back(),
-					ostream_ref( out_scores_ofstream )
-				);
-				out_scores_ofstream.close();
-				for ( const ostringstream &ssap_output_stream : ssap_stdout_and_stderr ) {
-					if ( !ssap_output_stream.str().empty() ) {
-						::spdlog::info( "SSAP output : {}", ssap_output_stream.str() );
-					}
-				}
-			}
-			else {
-				::spdlog::info( "[{}] Skipping {} versus {} - non-empty data files already exist", progress_str, id_1, id_2 );
+	const size_t num_threads_used = num_threads_to_use( num_threads );
+
+	// Build the SSAP-ready proteins on first use, since they're not needed if all the SSAPs are cached
+	protein_vec proteins;
+	const auto get_proteins = [&] () -> const protein_vec & {
+		if ( proteins.empty() ) {
+			proteins = make_ssap_proteins( prm_strucs_context, num_threads_used, prm_ostream );
+		}
+		return proteins;
+	};
+
+	// Get the IDs of the structures and the pairs of them to be SSAPed
+	// (with more than two structures in the progressive approach, that's just the edges of the cheap spanning tree)
+	//
+	// \TODO: Abstract out functions for making these standard file names
+	const size_t  num_strucs = size( prm_strucs_context );
+	const str_vec ids        = transform_build<str_vec>(
+		prm_strucs_context.get_name_sets(),
+		[] (const name_set &x) { return get_domain_or_specified_or_name_from_acq( x ); }
+	);
+	const bool               only_ssap_tree = ( progressive_ssaps && num_strucs > 2 );
+	const size_size_pair_vec ssap_pairs     = only_ssap_tree
+		? make_cheap_spanning_tree_ssap_pairs( get_proteins(), ssap_options, data_dirs, num_threads_used )
+		: make_all_ssap_pairs( num_strucs );
+	const size_t num_ssaps = ssap_pairs.size();
+	if ( only_ssap_tree ) {
+		::spdlog::info( "Chose {} spanning-tree pairs to cath-ssap from cheap secondary-structure comparisons of {} structures",
+		                num_ssaps,
+		                num_strucs );
+	}
+	const auto   cache_file_of_ssap = [&] (const size_t &prm_ssap_index, const string &prm_suffix) {
+		const auto &[ struc_1_index, struc_2_index ] = ssap_pairs[ prm_ssap_index ];
+		return *directory_of_joy / ( ids[ struc_1_index ] + ids[ struc_2_index ] + prm_suffix );
+	};
+
+	// Read any SSAPs that are already cached and record which others need doing
+	str_vec     scores_strs( num_ssaps );
+	str_opt_vec aln_strs   ( num_ssaps );
+	size_vec    ssaps_to_do;
+	for (const size_t &ssap_index : indices( num_ssaps ) ) {
+		if ( directory_of_joy ) {
+			const path scores_file = cache_file_of_ssap( ssap_index, ".scores" );
+			const path alnmnt_file = cache_file_of_ssap( ssap_index, ".list"   );
+			if (   exists( scores_file ) && exists( alnmnt_file )
+			    && ! is_empty( scores_file ) && ! is_empty( alnmnt_file ) ) {
+				scores_strs[ ssap_index ] = slurp( scores_file );
+				aln_strs   [ ssap_index ] = slurp( alnmnt_file );
+				continue;
 			}
 		}
+		ssaps_to_do.push_back( ssap_index );
 	}
+	::spdlog::info( "Using {} cached cath-ssaps and running {} more (of {} in total) using {} thread(s)",
+	                num_ssaps - ssaps_to_do.size(),
+	                ssaps_to_do.size(),
+	                num_ssaps,
+	                num_threads_used );
 
-	// Concatenate the scores files into one big file
-	const path scores_file = ssaps_dir / "ssap_scores";
-	spew(
-		scores_file,
-		join(
-			scores_files
-				| transformed( [] (const path &x) { return trim_right_copy( slurp( x ) ); } ),
-			"\n"
+	// Perform any necessary cath-ssaps, each on whichever thread is next free
+	if ( ! ssaps_to_do.empty() ) {
+		const protein_vec &the_proteins = get_proteins();
+		atomic<size_t>     num_done{ 0 };
+		parallel_for_each_index( ssaps_to_do.size(), num_threads_used, [&] (const size_t &prm_index) {
+			const size_t &ssap_index = ssaps_to_do[ prm_index ];
+			const auto   &[ struc_1_index, struc_2_index ] = ssap_pairs[ ssap_index ];
+			std::tie( scores_strs[ ssap_index ], aln_strs[ ssap_index ] ) = run_ssap_in_memory(
+				the_proteins[ struc_1_index ],
+				the_proteins[ struc_2_index ],
+				ssap_options,
+				data_dirs
+			);
+			if ( directory_of_joy ) {
+				spew( cache_file_of_ssap( ssap_index, ".scores" ), scores_strs[ ssap_index ] );
+				if ( aln_strs[ ssap_index ] ) {
+					spew( cache_file_of_ssap( ssap_index, ".list" ), *aln_strs[ ssap_index ] );
+				}
+			}
+			::spdlog::info( "[{}/{}] Did cath-ssap of {} versus {}",
+			                ++num_done,
+			                ssaps_to_do.size(),
+			                ids[ struc_1_index ],
+			                ids[ struc_2_index ] );
+		} );
+	}
+
+	// Concatenate the scores, as in an SSAP scores file, and parse them back
+	//
+	// The progressive approach's scores are taken pair by pair because parse_ssap_scores_file() orders
+	// the names by their first appearance, which needn't match the structures' order for a spanning tree's pairs
+	const string all_scores_str = join(
+		scores_strs
+			| transformed( [] (const string &x) { return trim_right_copy( x ); } ),
+		"\n"
+	);
+	if ( directory_of_joy ) {
+		spew( *directory_of_joy / "ssap_scores", all_scores_str );
+	}
+	istringstream all_scores_iss{ all_scores_str };
+	const auto ssap_scores_data = only_ssap_tree
+		? make_pair(
+			ids,
+			transform_build<size_size_doub_tpl_vec>(
+				indices( num_ssaps ),
+				[&] (const size_t &x) {
+					return make_tuple(
+						ssap_pairs[ x ].first,
+						ssap_pairs[ x ].second,
+						ssap_scores_entry_from_line( trim_copy( scores_strs[ x ] ) ).get_ssap_score()
+					);
+				}
+			)
 		)
+		: ssap_scores_file::parse_ssap_scores_file( all_scores_iss );
+	const str_vec &names  = ssap_scores_data.first;
+	const auto    &scores = ssap_scores_data.second;
+
+	// Gather the alignments by the pair of IDs
+	str_str_pair_str_map aln_str_of_ids;
+	for (const size_t &ssap_index : indices( num_ssaps ) ) {
+		if ( aln_strs[ ssap_index ] ) {
+			const auto &[ struc_1_index, struc_2_index ] = ssap_pairs[ ssap_index ];
+			aln_str_of_ids.emplace( make_pair( ids[ struc_1_index ], ids[ struc_2_index ] ), *aln_strs[ ssap_index ] );
+		}
+	}
+
+	// Glue the alignments together and score the result
+	return score_multi_alignment(
+		build_multi_alignment(
+			prm_strucs_context.get_pdbs(),
+			names,
+			scores,
+			aln_str_of_ids,
+			aln_glue_style_of_align_refining( prm_align_refining ),
+			prm_ostream
+		),
+		prm_strucs_context.get_pdbs(),
+		names
 	);
+}
 
-	// Use the ssap_scores_file_alignment_acquirer on the directory of data
-	return ssap_scores_file_alignment_acquirer{ scores_file }
-		.get_alignment_and_spanning_tree( prm_strucs_context, prm_align_refining, prm_ostream );
+/// \brief Ctor for do_the_ssaps_alignment_acquirer that uses the SSAP options and data directories
+///        that cath-ssap would parse from the environment and config file
+do_the_ssaps_alignment_acquirer::do_the_ssaps_alignment_acquirer(path_opt      prm_directory_of_joy,  ///< An optional directory in which the cath-ssaps' results should be cached
+                                                                 const bool   &prm_progressive_ssaps, ///< Whether to only cath-ssap the pairs in a spanning tree chosen from cheap secondary-structure comparisons
+                                                                 const size_t &prm_num_threads        ///< The number of threads on which to do the cath-ssaps (or 0 to use the hardware concurrency)
+                                                                 ) : do_the_ssaps_alignment_acquirer{ std::move( prm_directory_of_joy ),
+                                                                                                      prm_progressive_ssaps,
+                                                                                                      prm_num_threads,
+                                                                                                      get_env_and_file_cath_ssap_options().get_old_ssap_options(),
+                                                                                                      get_env_and_file_cath_ssap_options().get_data_dirs_spec() } {
 }
 
 /// \brief Ctor for do_the_ssaps_alignment_acquirer
-do_the_ssaps_alignment_acquirer::do_the_ssaps_alignment_acquirer(path_opt prm_directory_of_joy ///< The directory in which the cath-ssaps should be performed
-                                                                 ) : directory_of_joy { std::move( prm_directory_of_joy ) } {
+do_the_ssaps_alignment_acquirer::do_the_ssaps_alignment_acquirer(path_opt               prm_directory_of_joy,  ///< An optional directory in which the cath-ssaps' results should be cached
+                                                                 const bool            &prm_progressive_ssaps, ///< Whether to only cath-ssap the pairs in a spanning tree chosen from cheap secondary-structure comparisons
+                                                                 const size_t          &prm_num_threads,       ///< The number of threads on which to do the cath-ssaps (or 0 to use the hardware concurrency)
+                                                                 old_ssap_options_block prm_ssap_options,      ///< The options with which the cath-ssaps should be run
+                                                                 data_dirs_spec         prm_data_dirs          ///< The data directories from which the cath-ssaps should read any data
+                                                                 ) : directory_of_joy  { std::move( prm_directory_of_joy ) },
+                                                                     progressive_ssaps { prm_progressive_ssaps             },
+                                                                     num_threads       { prm_num_threads                   },
+                                                                     ssap_options      { std::move( prm_ssap_options     ) },
+                                                                     data_dirs         { std::move( prm_data_dirs        ) } {
 }
 
-/// \brief Getter for the directory in which the cath-ssaps should be performed
+/// \brief Getter for the optional directory in which the cath-ssaps' results should be cached
 const path_opt & do_the_ssaps_alignment_acquirer::get_directory_of_joy() const {
 	return directory_of_joy;
 }
 
-/// \brief Make a path with a temporary directory in which cath-ssaps for the specified strucs_context should be done
-///
-/// This aims to create a temporary directory that is likely to persist across multiple identical runs
-/// but very unlikely to clash amongst different inputs
-///
-/// This doesn't actually create the directory
-path do_the_ssaps_alignment_acquirer::make_temp_dir_for_doing_ssaps(const strucs_context &prm_strucs_context ///< The strucs_context for which the directory should make a cath-ssaps temporary directory
-                                                                    ) {
-	return temp_directory_path() / (
-		  "cath-tools.tmp."
-		+ ( format( R"(%|08X|)" ) % non_crypto_hash_copy( 0, prm_strucs_context ) ).str()
-		+ "_"
-		+ ( format( R"(%|08X|)" ) % non_crypto_hash_copy( 1, prm_strucs_context ) ).str()
-	);
+/// \brief Getter for whether to only cath-ssap the pairs in a spanning tree chosen from cheap secondary-structure comparisons
+const bool & do_the_ssaps_alignment_acquirer::get_progressive_ssaps() const {
+	return progressive_ssaps;
+}
+
+/// \brief Getter for the number of threads on which to do the cath-ssaps (or 0 to use the hardware concurrency)
+const size_t & do_the_ssaps_alignment_acquirer::get_num_threads() const {
+	return num_threads;
+}
+
+/// \brief Getter for the options with which the cath-ssaps should be run
+const old_ssap_options_block & do_the_ssaps_alignment_acquirer::get_ssap_options() const {
+	return ssap_options;
+}
+
+/// \brief Getter for the data directories from which the cath-ssaps should read any data
+const data_dirs_spec & do_the_ssaps_alignment_acquirer::get_data_dirs() const {
+	return data_dirs;
 }
@@ -21,11 +21,12 @@
 #ifndef CATH_TOOLS_SOURCE_CT_UNI_CATH_ACQUIRER_ALIGNMENT_ACQUIRER_DO_THE_SSAPS_ALIGNMENT_ACQUIRER_HPP
 #define CATH_TOOLS_SOURCE_CT_UNI_CATH_ACQUIRER_ALIGNMENT_ACQUIRER_DO_THE_SSAPS_ALIGNMENT_ACQUIRER_HPP
 
-#include <filesystem>
 #include <optional>
 
 #include "cath/acquirer/alignment_acquirer/alignment_acquirer.hpp"
 #include "cath/common/path_type_aliases.hpp"
+#include "cath/file/options/data_dirs_spec.hpp"
+#include "cath/ssap/options/old_ssap_options_block.hpp"
 
 // clang-format off
 namespace cath::align { class alignment; }
@@ -33,15 +34,37 @@ namespace cath::align { class alignment; }
 
 namespace cath::align {
 
-	/// \brief Acquire the alignment by performing any necessary cath-ssaps in
-	///        a temp directory and then using ssap_scores_file_alignment_acquirer
+	/// \brief Acquire the alignment by performing the necessary cath-ssaps in parallel and in memory
+	///        and then glueing their alignments together as ssap_scores_file_alignment_acquirer does
+	///
+	/// If a directory is specified, it's used to cache the cath-ssaps' results for reuse
+	///
+	/// In the progressive approach, only the N-1 pairs in a spanning tree chosen from cheap
+	/// secondary-structure comparisons are cath-ssaped, rather than all N(N-1)/2 pairs
+	///
+	/// The cath-ssaps use the specified SSAP options and data directories or, if none are specified,
+	/// those that cath-ssap would parse from the environment and config file (as the cath-ssaps
+	/// were run before they were done in memory)
 	class do_the_ssaps_alignment_acquirer final : public alignment_acquirer {
 	private:
 		using super = alignment_acquirer;
 
-		/// \brief Where the magic shall happen
+		/// \brief An optional directory in which the magic shall be cached
 		path_opt directory_of_joy;
 
+		/// \brief Whether to only cath-ssap the pairs in a spanning tree chosen from cheap secondary-structure comparisons
+		///        (rather than all pairs)
+		bool progressive_ssaps = DEFAULT_PROGRESSIVE_SSAPS;
+
+		/// \brief The number of threads on which to do the cath-ssaps (or 0 to use the hardware concurrency)
+		size_t num_threads = DEFAULT_NUM_THREADS;
+
+		/// \brief The options with which the cath-ssaps should be run
+		opts::old_ssap_options_block ssap_options;
+
+		/// \brief The data directories from which the cath-ssaps should read any data
+		opts::data_dirs_spec data_dirs;
+
 		[[nodiscard]] std::unique_ptr<alignment_acquirer>      do_clone() const final;
 		[[nodiscard]] bool                                     do_requires_backbone_complete_input() const final;
 		[[nodiscard]] std::pair<alignment, size_size_pair_vec> do_get_alignment_and_spanning_tree(
@@ -50,11 +73,22 @@ namespace cath::align {
 		  const ostream_ref_opt & = ::std::nullopt ) const final;
 
 	  public:
-		explicit do_the_ssaps_alignment_acquirer( path_opt = ::std::nullopt );
+		explicit do_the_ssaps_alignment_acquirer( path_opt       = ::std::nullopt,
+		                                          const bool &   = DEFAULT_PROGRESSIVE_SSAPS,
+		                                          const size_t & = DEFAULT_NUM_THREADS );
+		do_the_ssaps_alignment_acquirer( path_opt, const bool &, const size_t &, opts::old_ssap_options_block, opts::data_dirs_spec );
+
+		[[nodiscard]] const path_opt &                    get_directory_of_joy() const;
+		[[nodiscard]] const bool &                        get_progressive_ssaps() const;
+		[[nodiscard]] const size_t &                      get_num_threads() const;
+		[[nodiscard]] const opts::old_ssap_options_block &get_ssap_options() const;
+		[[nodiscard]] const opts::data_dirs_spec &        get_data_dirs() const;
 
-		[[nodiscard]] const path_opt &get_directory_of_joy() const;
+		/// \brief The default value for whether to only cath-ssap the pairs in a spanning tree chosen from cheap comparisons
+		static constexpr bool DEFAULT_PROGRESSIVE_SSAPS = false;
 
-		static ::std::filesystem::path make_temp_dir_for_doing_ssaps(const file::strucs_context &);
+		/// \brief The default number of threads on which to do the cath-ssaps (0 to use the hardware concurrency)
+		static constexpr size_t DEFAULT_NUM_THREADS = 0;
 	};
 
 } // namespace cath::align
@@ -18,15 +18,196 @@
 /// You should have received a copy of the GNU General Public License
 /// along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
+#include <boost/test/unit_test.hpp>
+
+#include <boost/range/irange.hpp>
+
+#include <algorithm>
+#include <filesystem>
+#include <sstream>
+
+#include "cath/acquirer/alignment_acquirer/alignment_acquirer.hpp"
 #include "cath/acquirer/alignment_acquirer/do_the_ssaps_alignment_acquirer.hpp"
+#include "cath/alignment/alignment.hpp"
+#include "cath/alignment/io/alignment_io.hpp"
+#include "cath/alignment/options_block/alignment_input_spec.hpp"
+#include "cath/chopping/domain/domain.hpp"
+#include "cath/common/boost_addenda/log/stringstream_log_sink.hpp"
+#include "cath/common/boost_addenda/range/indices.hpp"
+#include "cath/common/file/slurp.hpp"
+#include "cath/common/file/temp_file.hpp"
+#include "cath/file/name_set/name_set_list.hpp"
+#include "cath/file/pdb/pdb.hpp"
+#include "cath/file/pdb/pdb_list.hpp"
+#include "cath/file/strucs_context.hpp"
+#include "cath/ssap/options/cath_ssap_options.hpp"
+#include "cath/ssap/ssap.hpp"
+#include "cath/test/global_test_constants.hpp"
 
-#include <boost/test/unit_test.hpp>
+using namespace ::cath;
+using namespace ::cath::align;
+using namespace ::cath::common;
+using namespace ::cath::file;
+using namespace ::cath::opts;
+
+using ::boost::irange;
+using ::std::filesystem::path;
+using ::std::ostringstream;
+using ::std::pair;
+using ::std::string;
+
+namespace {
+
+	/// \brief The do_the_ssaps_alignment_acquirer_test_suite_fixture to assist in testing do_the_ssaps_alignment_acquirer
+	struct do_the_ssaps_alignment_acquirer_test_suite_fixture : protected global_test_constants {
+	protected:
+		~do_the_ssaps_alignment_acquirer_test_suite_fixture() noexcept = default;
+
+		/// \brief The IDs of the structures to SSAP
+		const str_vec ids{ "1o7iB00", "3uljB00", "4gs3A00" };
+
+		/// \brief The PDBs of the structures to SSAP
+		const pdb_list the_pdbs = read_pdb_files( {
+			TEST_SSAP_ALIGNMENT_GLUING_DATA_DIR() / ids[ 0 ],
+			TEST_SSAP_ALIGNMENT_GLUING_DATA_DIR() / ids[ 1 ],
+			TEST_SSAP_ALIGNMENT_GLUING_DATA_DIR() / ids[ 2 ],
+		} );
+
+		/// \brief The context of the structures to SSAP
+		const strucs_context the_strucs_context{ the_pdbs, build_name_set_list( ids ) };
+
+		/// \brief Get the alignment (as a FASTA string) and spanning tree using a do_the_ssaps_alignment_acquirer
+		///        with the specified optional cache directory and number of threads
+		[[nodiscard]] pair<string, size_size_pair_vec> get_aln_and_spantree(const path_opt &prm_dir,                                                            ///< The optional directory in which the SSAPs should be cached
+		                                                                    const size_t   &prm_num_threads = do_the_ssaps_alignment_acquirer::DEFAULT_NUM_THREADS ///< The number of threads on which to do the SSAPs
+		                                                                    ) const {
+			const stringstream_log_sink log_sink;
+			const auto aln_and_spantree = do_the_ssaps_alignment_acquirer{ prm_dir, false, prm_num_threads }.get_alignment_and_spanning_tree( the_strucs_context );
+			return { alignment_as_fasta_string( aln_and_spantree.first, the_pdbs, ids ), aln_and_spantree.second };
+		}
+
+		/// \brief Make the cath_ssap_options with which the legacy run_ssap() would SSAP the specified pair of structures
+		///        from the test data directory, writing any alignment to the specified directory
+		[[nodiscard]] static cath_ssap_options make_legacy_cath_ssap_options(const string &prm_id_1, ///< The ID of the first  structure
+		                                                                     const string &prm_id_2, ///< The ID of the second structure
+		                                                                     const path   &prm_dir   ///< The directory to which any alignment should be written
+		                                                                     ) {
+			return make_and_parse_options<cath_ssap_options>(
+				str_vec{ string( cath_ssap_options::PROGRAM_NAME ),
+				         "--" + string( old_ssap_options_block::PO_ALIGN_DIR ),
+				         prm_dir.string(),
+				         "--pdb-path",
+				         TEST_SSAP_ALIGNMENT_GLUING_DATA_DIR().string(),
+				         prm_id_1,
+				         prm_id_2 },
+				parse_sources::CMND_LINE_ONLY
+			);
+		}
+	};
+
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE(do_the_ssaps_alignment_acquirer_test_suite, do_the_ssaps_alignment_acquirer_test_suite_fixture)
+
+BOOST_AUTO_TEST_CASE(in_memory_results_match_those_written_to_and_reread_from_cache) {
+	const temp_file cache_dir_temp{ ".cath_tools_test_temp_file.do_the_ssaps.%%%%-%%%%-%%%%-%%%%" };
+	const path      cache_dir = get_filename( cache_dir_temp );
 
-BOOST_AUTO_TEST_SUITE(do_the_ssaps_alignment_acquirer_test_suite)
+	const auto in_memory   = get_aln_and_spantree( ::std::nullopt );
+	const auto first_dir   = get_aln_and_spantree( cache_dir      );
+	const bool wrote_cache = exists( cache_dir / "1o7iB003uljB00.scores" )
+	                      && exists( cache_dir / "1o7iB003uljB00.list"   )
+	                      && exists( cache_dir / "ssap_scores"           );
+	const auto from_cache  = get_aln_and_spantree( cache_dir      );
+	remove_all( cache_dir );
 
-BOOST_AUTO_TEST_CASE(basic) {
-	BOOST_TEST( true );
+	BOOST_TEST( wrote_cache );
+	BOOST_CHECK_EQUAL( in_memory.second.size(), 2 );
+	BOOST_CHECK_EQUAL( first_dir.first,  in_memory.first  );
+	BOOST_CHECK_EQUAL( from_cache.first, in_memory.first  );
+	BOOST_TEST( first_dir.second  == in_memory.second );
+	BOOST_TEST( from_cache.second == in_memory.second );
 }
 
-BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_CASE(in_memory_results_match_legacy_run_ssap_files) {
+	const temp_file legacy_dir_temp{ ".cath_tools_test_temp_file.do_the_ssaps.%%%%-%%%%-%%%%-%%%%" };
+	const temp_file cache_dir_temp { ".cath_tools_test_temp_file.do_the_ssaps.%%%%-%%%%-%%%%-%%%%" };
+	const path      legacy_dir = get_filename( legacy_dir_temp );
+	const path      cache_dir  = get_filename( cache_dir_temp  );
+	create_directories( legacy_dir );
+
+	// Use the same options for the in-memory SSAPs as for the legacy ones
+	const stringstream_log_sink log_sink;
+	const cath_ssap_options     the_options = make_legacy_cath_ssap_options( ids[ 0 ], ids[ 1 ], legacy_dir );
+	const auto aln_and_spantree = do_the_ssaps_alignment_acquirer{
+		cache_dir,
+		false,
+		do_the_ssaps_alignment_acquirer::DEFAULT_NUM_THREADS,
+		the_options.get_old_ssap_options(),
+		the_options.get_data_dirs_spec()
+	}.get_alignment_and_spanning_tree( the_strucs_context );
+	BOOST_CHECK_EQUAL( aln_and_spantree.second.size(), 2 );
+
+	for (const size_t &index_1 : indices( ids.size() ) ) {
+		for (const size_t &index_2 : irange( index_1 + 1, ids.size() ) ) {
+			const string &id_1 = ids[ index_1 ];
+			const string &id_2 = ids[ index_2 ];
+			ostringstream legacy_stdout_ss;
+			ostringstream legacy_stderr_ss;
+			ostringstream legacy_scores_ss;
+			run_ssap(
+				make_legacy_cath_ssap_options( id_1, id_2, legacy_dir ),
+				legacy_stdout_ss,
+				legacy_stderr_ss,
+				ostream_ref( legacy_scores_ss )
+			);
+			BOOST_CHECK_EQUAL( slurp( cache_dir  / ( id_1 + id_2 + ".scores" ) ), legacy_scores_ss.str() );
+			BOOST_CHECK_EQUAL( slurp( cache_dir  / ( id_1 + id_2 + ".list"   ) ),
+			                   slurp( legacy_dir / ( id_1 + id_2 + ".list"   ) ) );
+		}
+	}
+	remove_all( legacy_dir );
+	remove_all( cache_dir  );
+}
+
+BOOST_AUTO_TEST_CASE(progressive_ssaps_only_caches_the_spanning_tree_pairs) {
+	const temp_file cache_dir_temp{ ".cath_tools_test_temp_file.do_the_ssaps.%%%%-%%%%-%%%%-%%%%" };
+	const path      cache_dir = get_filename( cache_dir_temp );
+
+	const stringstream_log_sink log_sink;
+	const auto aln_and_spantree = do_the_ssaps_alignment_acquirer{ cache_dir, true }.get_alignment_and_spanning_tree( the_strucs_context );
+	const size_t num_cached_scores = static_cast<size_t>( ::std::count_if(
+		::std::filesystem::directory_iterator{ cache_dir },
+		::std::filesystem::directory_iterator{},
+		[] (const ::std::filesystem::directory_entry &x) { return x.path().extension() == ".scores"; }
+	) );
+	remove_all( cache_dir );
+
+	BOOST_CHECK_EQUAL( aln_and_spantree.first.num_entries(), 3 );
+	BOOST_CHECK_EQUAL( aln_and_spantree.second.size(),       2 );
+	BOOST_CHECK_EQUAL( num_cached_scores,                    2 );
+}
 
+BOOST_AUTO_TEST_CASE(single_threaded_results_match_those_on_all_hardware_threads) {
+	const auto all_threads = get_aln_and_spantree( ::std::nullopt    );
+	const auto one_thread  = get_aln_and_spantree( ::std::nullopt, 1 );
+	BOOST_CHECK_EQUAL( one_thread.first, all_threads.first );
+	BOOST_TEST( one_thread.second == all_threads.second );
+}
+
+BOOST_AUTO_TEST_CASE(default_acquirer_uses_the_specified_number_of_ssap_threads) {
+	const auto the_acquirer     = get_alignment_acquirer( alignment_input_spec{}.set_num_ssap_threads( 3 ) );
+	const auto do_the_ssaps_ptr = dynamic_cast<const do_the_ssaps_alignment_acquirer *>( the_acquirer.get() );
+	BOOST_REQUIRE( do_the_ssaps_ptr != nullptr );
+	BOOST_CHECK_EQUAL( do_the_ssaps_ptr->get_num_threads(), 3 );
+}
+
+BOOST_AUTO_TEST_CASE(accepts_single_structure) {
+	const strucs_context single_context{ pdb_list{ { the_pdbs[ 0 ] } }, build_name_set_list( { ids[ 0 ] } ) };
+	const stringstream_log_sink log_sink;
+	const auto aln_and_spantree = do_the_ssaps_alignment_acquirer{}.get_alignment_and_spanning_tree( single_context );
+	BOOST_CHECK_EQUAL( aln_and_spantree.first.num_entries(), 1 );
+	BOOST_TEST( aln_and_spantree.second.empty() );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
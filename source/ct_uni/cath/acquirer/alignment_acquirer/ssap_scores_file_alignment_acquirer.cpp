@@ -22,6 +22,7 @@
 
 #include <filesystem>
 #include <fstream>
+#include <sstream>
 #include <utility>
 
 #include <boost/range/adaptor/transformed.hpp>
@@ -39,6 +40,7 @@
 #include "cath/common/boost_addenda/graph/spanning_tree.hpp"
 #include "cath/common/boost_addenda/range/front.hpp"
 #include "cath/common/clone/make_uptr_clone.hpp"
+#include "cath/common/exception/runtime_error_exception.hpp"
 #include "cath/common/file/open_fstream.hpp"
 #include "cath/file/name_set/name_set_list.hpp"
 #include "cath/file/pdb/protein_info.hpp"
@@ -58,6 +60,7 @@ using namespace ::cath::file;
 using namespace ::cath::opts;
 
 using ::std::filesystem::path;
+using ::std::istringstream;
 using ::std::make_pair;
 using ::std::pair;
 using ::std::string;
@@ -73,15 +76,6 @@ bool ssap_scores_file_alignment_acquirer::do_requires_backbone_complete_input()
 	return true;
 }
 
-/// \brief Get the aln_glue_style that should be used to implement the specified align_refining
-static inline constexpr aln_glue_style aln_glue_style_of_align_refining(const align_refining &prm_align_refining ///< How much refining should be done to the alignment
-                                                                        ) {
-	return
-		( prm_align_refining == align_refining::NO    ) ? aln_glue_style::SIMPLY                           :
-		( prm_align_refining == align_refining::LIGHT ) ? aln_glue_style::INCREMENTALLY_WITH_PAIR_REFINING :
-		                                                  aln_glue_style::WITH_HEAVY_REFINING;
-}
-
 static_assert( aln_glue_style_of_align_refining( align_refining::NO    ) == aln_glue_style::SIMPLY                           );
 static_assert( aln_glue_style_of_align_refining( align_refining::LIGHT ) == aln_glue_style::INCREMENTALLY_WITH_PAIR_REFINING );
 static_assert( aln_glue_style_of_align_refining( align_refining::HEAVY ) == aln_glue_style::WITH_HEAVY_REFINING              );
@@ -113,41 +107,19 @@ pair<alignment, size_size_pair_vec> ssap_scores_file_alignment_acquirer::do_get_
 		}
 	}
 
-	// Construct the new alignment
-	const auto aln_and_spantree = build_multi_alignment(
+	// Construct the new alignment and score it
+	return score_multi_alignment(
+		build_multi_alignment(
+			the_pdbs,
+			names,
+			scores,
+			ssaps_filename.parent_path(),
+			aln_glue_style_of_align_refining( prm_align_refining ),
+			prm_ostream
+		),
 		the_pdbs,
-		names,
-		scores,
-		ssaps_filename.parent_path(),
-		aln_glue_style_of_align_refining( prm_align_refining ),
-		prm_ostream
-	);
-	const alignment          &new_alignment = aln_and_spantree.first;
-	const size_size_pair_vec &spanning_tree = aln_and_spantree.second;
-
-	// TODOCUMENT
-	if ( names.empty() ) {
-		// Return the results
-		return make_pair( new_alignment, spanning_tree );
-	}
-
-	// ::spdlog::warn( "About to attempt to build protein list using data that's been read from ssaps_filename (with {} pdbs and {} names)",
-	//                 num_pdbs,
-	//                 names.size() );
-
-	const protein_list proteins_of_pdbs     = build_protein_list_of_pdb_list_and_names(
-		prm_strucs_context.get_pdbs(),
-		build_name_set_list( names )
+		names
 	);
-	const alignment    scored_new_alignment = score_alignment_copy( residue_scorer(), new_alignment, proteins_of_pdbs );
-
-//	cerr << "Did generate alignment : \n";
-//	cerr << horiz_align_outputter( scored_new_alignment ) << endl;
-//	write_alignment_as_fasta_alignment( cerr, scored_new_alignment, build_protein_list_of_pdb_list( prm_strucs_context ) );
-//	cerr << endl;
-
-	// Return the results
-	return make_pair( scored_new_alignment, spanning_tree );
 }
 
 /// \brief Ctor for ssap_scores_file_alignment_acquirer
@@ -193,3 +165,70 @@ pair<alignment, size_size_pair_vec> cath::align::build_multi_alignment(const pdb
 		get_edges_of_spanning_tree( aln_and_spantree.second )
 	};
 }
+
+/// \brief Build an alignment between the specified PDBs & names using the specified scores and in-memory SSAP alignments
+///
+/// Each alignment should be in the legacy CATH SSAP format, keyed by the pair of names (in the order in which
+/// they were SSAPed, as with the names of the .list files used by the directory version of this function)
+pair<alignment, size_size_pair_vec> cath::align::build_multi_alignment(const pdb_list               &prm_pdbs,           ///< The PDBs to be aligned
+                                                                       const str_vec                &prm_names,          ///< The names of the structures to be aligned
+                                                                       const size_size_doub_tpl_vec &prm_scores,         ///< The SSAP scores between the structures
+                                                                       const str_str_pair_str_map   &prm_alignments,     ///< The legacy-format SSAP alignments, keyed by the pair of names
+                                                                       const aln_glue_style         &prm_aln_glue_style, ///< The approach that should be used for glueing alignments together
+                                                                       const ostream_ref_opt        &prm_ostream         ///< An (optional reference_wrapper of an) ostream to which warnings/errors should be written
+                                                                       ) {
+	const protein_list prots = build_protein_list_of_pdb_list( prm_pdbs, prm_ostream );
+	auto aln_and_spantree = build_alignment(
+		prots,
+		prm_scores,
+		prm_aln_glue_style,
+
+		// Lambda to define how to get the alignment corresponding to the pair of proteins
+		// corresponding to the specified indices
+		[&] (const size_t  &prm_index_a, //< The index of the first  protein for which the alignment is required
+		     const size_t  &prm_index_b  //< The index of the second protein for which the alignment is required
+		     ) {
+			const auto aln_itr = prm_alignments.find( make_pair( prm_names[ prm_index_a ], prm_names[ prm_index_b ] ) );
+			if ( aln_itr == ::std::cend( prm_alignments ) ) {
+				BOOST_THROW_EXCEPTION(runtime_error_exception(
+					"Unable to find an SSAP alignment between "
+					+ prm_names[ prm_index_a ]
+					+ " and "
+					+ prm_names[ prm_index_b ]
+				));
+			}
+			istringstream aln_istream{ aln_itr->second };
+			return read_alignment_from_cath_ssap_legacy_format(
+				aln_istream,
+				prots[ prm_index_a ],
+				prots[ prm_index_b ],
+				prm_ostream
+			);
+		}
+	);
+
+	return {
+		std::move( aln_and_spantree.first ),
+		get_edges_of_spanning_tree( aln_and_spantree.second )
+	};
+}
+
+/// \brief Score the specified multiple alignment (and spanning tree), built from SSAPs between the structures
+///        with the specified names, using the specified PDBs
+///
+/// If there are no names (because there were no SSAPs), this returns the alignment unscored
+pair<alignment, size_size_pair_vec> cath::align::score_multi_alignment(pair<alignment, size_size_pair_vec>  prm_aln_and_spantree, ///< The multiple alignment and spanning tree to score
+                                                                       const pdb_list                      &prm_pdbs,             ///< The PDBs that have been aligned
+                                                                       const str_vec                       &prm_names             ///< The names of the structures that have been aligned
+                                                                       ) {
+	if ( prm_names.empty() ) {
+		return prm_aln_and_spantree;
+	}
+
+	const protein_list proteins_of_pdbs = build_protein_list_of_pdb_list_and_names(
+		prm_pdbs,
+		build_name_set_list( prm_names )
+	);
+	score_alignment( residue_scorer(), prm_aln_and_spantree.first, proteins_of_pdbs );
+	return prm_aln_and_spantree;
+}
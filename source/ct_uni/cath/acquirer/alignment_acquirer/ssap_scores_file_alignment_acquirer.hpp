@@ -54,6 +54,15 @@ namespace cath::align {
 		[[nodiscard]] ::std::filesystem::path get_ssap_scores_file() const;
 	};
 
+	/// \brief Get the aln_glue_style that should be used to implement the specified align_refining
+	inline constexpr aln_glue_style aln_glue_style_of_align_refining(const align_refining &prm_align_refining ///< How much refining should be done to the alignment
+	                                                                 ) {
+		return
+			( prm_align_refining == align_refining::NO    ) ? aln_glue_style::SIMPLY                           :
+			( prm_align_refining == align_refining::LIGHT ) ? aln_glue_style::INCREMENTALLY_WITH_PAIR_REFINING :
+			                                                  aln_glue_style::WITH_HEAVY_REFINING;
+	}
+
 	std::pair<alignment, size_size_pair_vec> build_multi_alignment(const file::pdb_list &,
 	                                                               const str_vec &,
 	                                                               const size_size_doub_tpl_vec &,
@@ -61,6 +70,17 @@ namespace cath::align {
 	                                                               const aln_glue_style &,
 	                                                               const ostream_ref_opt & = ::std::nullopt);
 
+	std::pair<alignment, size_size_pair_vec> build_multi_alignment(const file::pdb_list &,
+	                                                               const str_vec &,
+	                                                               const size_size_doub_tpl_vec &,
+	                                                               const str_str_pair_str_map &,
+	                                                               const aln_glue_style &,
+	                                                               const ostream_ref_opt & = ::std::nullopt);
+
+	std::pair<alignment, size_size_pair_vec> score_multi_alignment(std::pair<alignment, size_size_pair_vec>,
+	                                                               const file::pdb_list &,
+	                                                               const str_vec &);
+
 } // namespace cath::align
 
 #endif // CATH_TOOLS_SOURCE_CT_UNI_CATH_ACQUIRER_ALIGNMENT_ACQUIRER_SSAP_SCORES_FILE_ALIGNMENT_ACQUIRER_HPP
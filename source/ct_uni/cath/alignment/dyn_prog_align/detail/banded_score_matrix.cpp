@@ -0,0 +1,209 @@
+/// \file
+/// \brief The banded_score_matrix class definitions
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "banded_score_matrix.hpp"
+
+#include <algorithm>
+
+#include "cath/common/boost_addenda/range/indices.hpp"
+#include "cath/common/config.hpp"
+#include "cath/common/exception/invalid_argument_exception.hpp"
+#include "cath/common/size_t_literal.hpp"
+
+using namespace ::cath;
+using namespace ::cath::align::detail;
+using namespace ::cath::common;
+
+using ::std::max;
+using ::std::min;
+
+/// \brief Set the row offsets from the bands and (re)allocate the data, with every score zeroed
+void banded_score_matrix::allocate() {
+	row_offsets.resize( band_begins.size() );
+	size_t num_cells = 0;
+	for (const size_t &row_ctr : indices( band_begins.size() ) ) {
+		row_offsets[ row_ctr ] = num_cells;
+		num_cells += band_ends[ row_ctr ] - band_begins[ row_ctr ];
+	}
+	data.assign( num_cells, 0.0 );
+}
+
+/// \brief Reset to a full matrix of the specified dimensions, with every score zeroed
+void banded_score_matrix::reset_to_full(const size_t &prm_length_a, ///< The number of rows
+                                        const size_t &prm_length_b  ///< The number of columns
+                                        ) {
+	length_b = prm_length_b;
+	band_begins.assign( prm_length_a, 0            );
+	band_ends.assign  ( prm_length_a, prm_length_b );
+	allocate();
+}
+
+/// \brief Reset to a matrix of the specified dimensions that's banded around the specified path, with every score zeroed
+///
+/// The band in each row extends the specified number of cells either side of the path's cells
+/// in that row. For a row the path doesn't visit, the band extends either side of the columns of
+/// the path's last cell before the row and its first cell after it.
+///
+/// The band is then extended so that a dynamic-programming path can stay within it from the top-left:
+/// the first row's band starts at the first column and each row's band overlaps the previous row's.
+///
+/// If the path is empty, this resets to a full matrix.
+void banded_score_matrix::reset_to_band(const size_t             &prm_length_a,   ///< The number of rows
+                                        const size_t             &prm_length_b,   ///< The number of columns
+                                        const size_size_pair_vec &prm_path,       ///< The (row, column) cells of the path, in increasing order of both row and column
+                                        const size_t             &prm_band_width  ///< The number of cells either side of the path to include in the band
+                                        ) {
+	if ( prm_path.empty() ) {
+		reset_to_full( prm_length_a, prm_length_b );
+		return;
+	}
+	for (const auto &[ path_a, path_b ] : prm_path) {
+		if ( path_a >= prm_length_a || path_b >= prm_length_b ) {
+			BOOST_THROW_EXCEPTION(invalid_argument_exception("Cannot band a score matrix around a path that leaves the matrix"));
+		}
+	}
+
+	length_b = prm_length_b;
+	band_begins.resize( prm_length_a );
+	band_ends.resize  ( prm_length_a );
+	size_t path_ctr = 0;
+	for (const size_t &row_ctr : indices( prm_length_a ) ) {
+		// Move past the path's cells in earlier rows, keeping the last of them
+		while ( path_ctr < prm_path.size() && prm_path[ path_ctr ].first < row_ctr ) {
+			++path_ctr;
+		}
+		const size_t lowest_b  = ( path_ctr > 0 ) ? prm_path[ path_ctr - 1 ].second : 0_z;
+		size_t       highest_b = ( path_ctr < prm_path.size() ) ? prm_path[ path_ctr ].second : prm_length_b - 1;
+
+		// Include all the path's cells in this row
+		for (size_t row_path_ctr = path_ctr; row_path_ctr < prm_path.size() && prm_path[ row_path_ctr ].first == row_ctr; ++row_path_ctr) {
+			highest_b = prm_path[ row_path_ctr ].second;
+		}
+		const size_t lowest_in_row_b = ( path_ctr < prm_path.size() && prm_path[ path_ctr ].first == row_ctr ) ? prm_path[ path_ctr ].second
+		                                                                                                      : lowest_b;
+
+		band_begins[ row_ctr ] = ( lowest_in_row_b > prm_band_width ) ? lowest_in_row_b - prm_band_width : 0_z;
+		band_ends  [ row_ctr ] = min( prm_length_b, highest_b + prm_band_width + 1 );
+
+		// Keep the band contiguous where the path jumps across columns between rows
+		if ( row_ctr == 0 ) {
+			band_begins[ row_ctr ] = 0;
+		}
+		else {
+			band_begins[ row_ctr ] = min( band_begins[ row_ctr ], band_ends[ row_ctr - 1 ] - 1 );
+			band_ends  [ row_ctr ] = max( band_ends  [ row_ctr ], band_ends[ row_ctr - 1 ]     );
+		}
+	}
+	allocate();
+}
+
+/// \brief Get the number of rows in the matrix
+size_t banded_score_matrix::get_length_a() const {
+	return band_begins.size();
+}
+
+/// \brief Get the number of columns in the matrix
+size_t banded_score_matrix::get_length_b() const {
+	return length_b;
+}
+
+/// \brief Get the first column in the band for the specified row
+size_t banded_score_matrix::get_band_begin(const size_t &prm_index_a ///< The row
+                                           ) const {
+	return band_begins[ prm_index_a ];
+}
+
+/// \brief Get one past the last column in the band for the specified row
+size_t banded_score_matrix::get_band_end(const size_t &prm_index_a ///< The row
+                                         ) const {
+	return band_ends[ prm_index_a ];
+}
+
+/// \brief Get the number of cells that are stored (ie that are in the band)
+size_t banded_score_matrix::get_num_cells() const {
+	return data.size();
+}
+
+/// \brief Get the score of the specified cell (which is zero if it's outside the band)
+float_score_type banded_score_matrix::get_score(const size_t &prm_index_a, ///< The row of the cell
+                                               const size_t &prm_index_b  ///< The column of the cell
+                                               ) const {
+	return is_in_band( *this, prm_index_a, prm_index_b )
+		? data[ row_offsets[ prm_index_a ] + prm_index_b - band_begins[ prm_index_a ] ]
+		: 0.0;
+}
+
+/// \brief Get a reference to the score of the specified cell, which must be in the band
+float_score_type & banded_score_matrix::get_score_ref(const size_t &prm_index_a, ///< The row of the cell
+                                                     const size_t &prm_index_b  ///< The column of the cell
+                                                     ) {
+	if constexpr ( IS_IN_DEBUG_MODE ) {
+		if ( ! is_in_band( *this, prm_index_a, prm_index_b ) ) {
+			BOOST_THROW_EXCEPTION(invalid_argument_exception("Cannot get a reference to the score of a cell outside the band"));
+		}
+	}
+	return data[ row_offsets[ prm_index_a ] + prm_index_b - band_begins[ prm_index_a ] ];
+}
+
+/// \brief Whether the specified cell is in the band of the specified banded_score_matrix
+///
+/// \relates banded_score_matrix
+bool cath::align::detail::is_in_band(const banded_score_matrix &prm_matrix,  ///< The banded_score_matrix to query
+                                     const size_t              &prm_index_a, ///< The row of the cell
+                                     const size_t              &prm_index_b  ///< The column of the cell
+                                     ) {
+	return (
+		prm_index_a < prm_matrix.get_length_a()
+		&&
+		prm_index_b >= prm_matrix.get_band_begin( prm_index_a )
+		&&
+		prm_index_b <  prm_matrix.get_band_end  ( prm_index_a )
+	);
+}
+
+/// \brief Whether the specified cell is outside the band or at one of its edges
+///        (other than where the band meets the edge of the matrix)
+///
+/// If an optimum path passes through such a cell, a wider band might have allowed a better path
+///
+/// \relates banded_score_matrix
+bool cath::align::detail::is_at_band_edge(const banded_score_matrix &prm_matrix,  ///< The banded_score_matrix to query
+                                          const size_t              &prm_index_a, ///< The row of the cell
+                                          const size_t              &prm_index_b  ///< The column of the cell
+                                          ) {
+	if ( ! is_in_band( prm_matrix, prm_index_a, prm_index_b ) ) {
+		return true;
+	}
+	const size_t band_begin = prm_matrix.get_band_begin( prm_index_a );
+	const size_t band_end   = prm_matrix.get_band_end  ( prm_index_a );
+	return (
+		( prm_index_b     == band_begin && band_begin > 0                        )
+		||
+		( prm_index_b + 1 == band_end   && band_end   < prm_matrix.get_length_b() )
+	);
+}
+
+/// \brief Whether the band of the specified banded_score_matrix covers the whole matrix
+///
+/// \relates banded_score_matrix
+bool cath::align::detail::is_full(const banded_score_matrix &prm_matrix ///< The banded_score_matrix to query
+                                  ) {
+	return prm_matrix.get_num_cells() == prm_matrix.get_length_a() * prm_matrix.get_length_b();
+}
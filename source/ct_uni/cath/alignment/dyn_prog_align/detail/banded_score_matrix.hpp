@@ -0,0 +1,88 @@
+/// \file
+/// \brief The banded_score_matrix class header
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef CATH_TOOLS_SOURCE_CT_UNI_CATH_ALIGNMENT_DYN_PROG_ALIGN_DETAIL_BANDED_SCORE_MATRIX_HPP
+#define CATH_TOOLS_SOURCE_CT_UNI_CATH_ALIGNMENT_DYN_PROG_ALIGN_DETAIL_BANDED_SCORE_MATRIX_HPP
+
+#include "cath/common/type_aliases.hpp"
+
+namespace cath::align::detail {
+
+	/// \brief A matrix of scores that only stores the cells within a band of columns in each row
+	///
+	/// As in windowed_matrix, the stored cells are kept in a single vector. Unlike windowed_matrix,
+	/// the band needn't follow the leading diagonal: it's made to follow a path through the matrix
+	/// (such as an existing alignment), extending a specified number of cells either side of it.
+	/// Every cell outside the band has a score of zero.
+	///
+	/// Resetting reuses the existing storage where possible.
+	class banded_score_matrix final {
+	private:
+		/// \brief The number of columns in the matrix
+		size_t length_b = 0;
+
+		/// \brief The first column in the band for each row
+		size_vec band_begins;
+
+		/// \brief One past the last column in the band for each row
+		size_vec band_ends;
+
+		/// \brief The index in data of the first cell in the band for each row
+		size_vec row_offsets;
+
+		/// \brief The scores of the cells in the band, row by row
+		float_score_vec data;
+
+		void allocate();
+
+	public:
+		void reset_to_full(const size_t &,
+		                   const size_t &);
+
+		void reset_to_band(const size_t &,
+		                   const size_t &,
+		                   const size_size_pair_vec &,
+		                   const size_t &);
+
+		[[nodiscard]] size_t get_length_a() const;
+		[[nodiscard]] size_t get_length_b() const;
+		[[nodiscard]] size_t get_band_begin(const size_t &) const;
+		[[nodiscard]] size_t get_band_end(const size_t &) const;
+		[[nodiscard]] size_t get_num_cells() const;
+
+		[[nodiscard]] float_score_type get_score(const size_t &,
+		                                         const size_t &) const;
+		float_score_type & get_score_ref(const size_t &,
+		                                 const size_t &);
+	};
+
+	bool is_in_band(const banded_score_matrix &,
+	                const size_t &,
+	                const size_t &);
+
+	bool is_at_band_edge(const banded_score_matrix &,
+	                     const size_t &,
+	                     const size_t &);
+
+	bool is_full(const banded_score_matrix &);
+
+} // namespace cath::align::detail
+
+#endif // CATH_TOOLS_SOURCE_CT_UNI_CATH_ALIGNMENT_DYN_PROG_ALIGN_DETAIL_BANDED_SCORE_MATRIX_HPP
@@ -0,0 +1,110 @@
+/// \file
+/// \brief The banded_score_matrix test suite
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <boost/test/unit_test.hpp>
+
+#include "cath/alignment/dyn_prog_align/detail/banded_score_matrix.hpp"
+#include "cath/common/exception/invalid_argument_exception.hpp"
+
+using namespace ::cath;
+using namespace ::cath::align::detail;
+using namespace ::cath::common;
+
+namespace {
+
+	/// \brief Make a banded_score_matrix of 5 rows and 6 columns, banded by 1 cell around a path that skips row 2
+	banded_score_matrix make_example_banded_matrix() {
+		banded_score_matrix the_matrix;
+		the_matrix.reset_to_band( 5, 6, { { 0, 0 }, { 1, 1 }, { 3, 3 }, { 3, 4 }, { 4, 5 } }, 1 );
+		return the_matrix;
+	}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(banded_score_matrix_test_suite)
+
+BOOST_AUTO_TEST_CASE(reset_to_full_stores_every_cell) {
+	banded_score_matrix the_matrix;
+	the_matrix.reset_to_full( 4, 7 );
+	BOOST_CHECK_EQUAL( the_matrix.get_length_a(),  4 );
+	BOOST_CHECK_EQUAL( the_matrix.get_length_b(),  7 );
+	BOOST_CHECK_EQUAL( the_matrix.get_num_cells(), 28 );
+	BOOST_CHECK( is_full( the_matrix ) );
+	BOOST_CHECK( ! is_at_band_edge( the_matrix, 2, 0 ) );
+	BOOST_CHECK( ! is_at_band_edge( the_matrix, 2, 6 ) );
+}
+
+BOOST_AUTO_TEST_CASE(band_follows_path) {
+	const banded_score_matrix the_matrix = make_example_banded_matrix();
+	const size_vec expected_begins = { 0, 0, 0, 2, 4 };
+	const size_vec expected_ends   = { 2, 3, 5, 6, 6 };
+	for (size_t row_ctr = 0; row_ctr < 5; ++row_ctr) {
+		BOOST_CHECK_EQUAL( the_matrix.get_band_begin( row_ctr ), expected_begins[ row_ctr ] );
+		BOOST_CHECK_EQUAL( the_matrix.get_band_end  ( row_ctr ), expected_ends  [ row_ctr ] );
+	}
+	BOOST_CHECK_EQUAL( the_matrix.get_num_cells(), 16 );
+	BOOST_CHECK( ! is_full( the_matrix ) );
+}
+
+BOOST_AUTO_TEST_CASE(band_stays_contiguous_across_jumps_in_path) {
+	banded_score_matrix the_matrix;
+	the_matrix.reset_to_band( 3, 9, { { 0, 4 }, { 1, 8 } }, 1 );
+	const size_vec expected_begins = { 0, 5, 7 };
+	const size_vec expected_ends   = { 6, 9, 9 };
+	for (size_t row_ctr = 0; row_ctr < 3; ++row_ctr) {
+		BOOST_CHECK_EQUAL( the_matrix.get_band_begin( row_ctr ), expected_begins[ row_ctr ] );
+		BOOST_CHECK_EQUAL( the_matrix.get_band_end  ( row_ctr ), expected_ends  [ row_ctr ] );
+	}
+}
+
+BOOST_AUTO_TEST_CASE(scores_outside_band_are_zero) {
+	banded_score_matrix the_matrix = make_example_banded_matrix();
+	the_matrix.get_score_ref( 3, 2 ) = 1.5;
+	the_matrix.get_score_ref( 3, 5 ) = 2.5;
+	BOOST_CHECK_EQUAL( the_matrix.get_score( 3, 2 ), 1.5 );
+	BOOST_CHECK_EQUAL( the_matrix.get_score( 3, 5 ), 2.5 );
+	BOOST_CHECK_EQUAL( the_matrix.get_score( 3, 4 ), 0.0 );
+	BOOST_CHECK_EQUAL( the_matrix.get_score( 3, 1 ), 0.0 );
+	BOOST_CHECK_EQUAL( the_matrix.get_score( 0, 5 ), 0.0 );
+}
+
+BOOST_AUTO_TEST_CASE(band_edges_exclude_matrix_edges) {
+	const banded_score_matrix the_matrix = make_example_banded_matrix();
+	BOOST_CHECK(   is_at_band_edge( the_matrix, 3, 1 ) );
+	BOOST_CHECK(   is_at_band_edge( the_matrix, 3, 2 ) );
+	BOOST_CHECK( ! is_at_band_edge( the_matrix, 3, 3 ) );
+	BOOST_CHECK( ! is_at_band_edge( the_matrix, 3, 5 ) );
+	BOOST_CHECK( ! is_at_band_edge( the_matrix, 1, 0 ) );
+	BOOST_CHECK(   is_at_band_edge( the_matrix, 1, 2 ) );
+}
+
+BOOST_AUTO_TEST_CASE(empty_path_gives_full_matrix) {
+	banded_score_matrix the_matrix = make_example_banded_matrix();
+	the_matrix.reset_to_band( 3, 3, {}, 1 );
+	BOOST_CHECK( is_full( the_matrix ) );
+	BOOST_CHECK_EQUAL( the_matrix.get_num_cells(), 9 );
+}
+
+BOOST_AUTO_TEST_CASE(throws_on_path_outside_matrix) {
+	banded_score_matrix the_matrix;
+	BOOST_CHECK_THROW( the_matrix.reset_to_band( 3, 3, { { 1, 3 } }, 1 ), invalid_argument_exception );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,73 @@
+/// \file
+/// \brief The striped_string_aligner class definitions
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "striped_string_aligner.hpp"
+
+#include <string>
+
+#include <fmt/core.h>
+
+#include "cath/alignment/align_type_aliases.hpp"
+#include "cath/alignment/alignment.hpp"
+#include "cath/alignment/dyn_prog_align/striped_sequence_aligner.hpp"
+#include "cath/common/config.hpp"
+#include "cath/common/exception/out_of_range_exception.hpp"
+
+using namespace ::cath;
+using namespace ::cath::align;
+using namespace ::cath::align::detail;
+using namespace ::cath::align::gap;
+using namespace ::cath::common;
+
+using ::std::string;
+
+/// \brief Concrete definition of do_align() that uses a semi-global, identity-scored striped_sequence_aligner to align the two sequences
+str_str_pair striped_string_aligner::do_align(const string      &prm_string_a,   ///< The first  string to be aligned
+                                              const string      &prm_string_b,   ///< The second string to be aligned
+                                              const gap_penalty &prm_gap_penalty ///< The gap penalty to be applied
+                                              ) const {
+	const score_alignment_pair score_and_alignment = make_identity_striped_sequence_aligner(
+		prm_gap_penalty,
+		sequence_alignment_mode::SEMI_GLOBAL
+	).align( prm_string_a, prm_string_b );
+
+	const str_str_pair aligned_strings = format_alignment_strings(
+		score_and_alignment.second,
+		prm_string_a,
+		prm_string_b
+	);
+
+	if constexpr ( IS_IN_DEBUG_MODE ) {
+		// If running in debug mode, check that the score is the same as a freshly calculated one
+		const score_type &score = score_and_alignment.first;
+		const score_type  recalculated_score =
+		  get_score_of_aligned_sequence_strings( aligned_strings.first, aligned_strings.second, prm_gap_penalty );
+
+		if ( score != recalculated_score ) {
+			BOOST_THROW_EXCEPTION( out_of_range_exception( ::fmt::format(
+			  "Score retrieved from striped alignment \"{}\" <-> \"{}\" was {} but, based on a recalculation, it should be {}",
+			  aligned_strings.first,
+			  aligned_strings.second,
+			  score,
+			  recalculated_score ) ) );
+		}
+	}
+	return aligned_strings;
+}
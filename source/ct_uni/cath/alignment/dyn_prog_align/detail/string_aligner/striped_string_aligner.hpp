@@ -0,0 +1,39 @@
+/// \file
+/// \brief The striped_string_aligner class header
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef CATH_TOOLS_SOURCE_CT_UNI_CATH_ALIGNMENT_DYN_PROG_ALIGN_DETAIL_STRING_ALIGNER_STRIPED_STRING_ALIGNER_HPP
+#define CATH_TOOLS_SOURCE_CT_UNI_CATH_ALIGNMENT_DYN_PROG_ALIGN_DETAIL_STRING_ALIGNER_STRIPED_STRING_ALIGNER_HPP
+
+#include "cath/alignment/dyn_prog_align/detail/string_aligner/string_aligner.hpp"
+
+namespace cath::align::detail {
+
+	/// \brief A string_aligner that uses a semi-global, identity-scored striped_sequence_aligner
+	///
+	/// This allows the striped_sequence_aligner to be checked against the other string_aligners
+	/// (which also score identical letters 1 and leave the end gaps unpenalised)
+	class striped_string_aligner final : public string_aligner {
+	private:
+		[[nodiscard]] str_str_pair do_align( const std::string &, const std::string &, const gap::gap_penalty & ) const final;
+	};
+
+} // namespace cath::align::detail
+
+#endif // CATH_TOOLS_SOURCE_CT_UNI_CATH_ALIGNMENT_DYN_PROG_ALIGN_DETAIL_STRING_ALIGNER_STRIPED_STRING_ALIGNER_HPP
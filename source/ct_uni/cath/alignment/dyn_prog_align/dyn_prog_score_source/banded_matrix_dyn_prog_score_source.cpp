@@ -0,0 +1,53 @@
+/// \file
+/// \brief The banded_matrix_dyn_prog_score_source class definitions
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "banded_matrix_dyn_prog_score_source.hpp"
+
+#include <boost/numeric/conversion/cast.hpp>
+
+#include "cath/alignment/dyn_prog_align/detail/banded_score_matrix.hpp"
+
+using namespace ::cath;
+using namespace ::cath::align;
+using namespace ::cath::align::detail;
+
+using ::boost::numeric_cast;
+
+/// \brief Return the number of elements in the first entry to by aligned with dynamic-programming
+size_t banded_matrix_dyn_prog_score_source::do_get_length_a() const {
+	return matrix.get_length_a();
+}
+
+/// \brief Return the number of elements in the second entry to by aligned with dynamic-programming
+size_t banded_matrix_dyn_prog_score_source::do_get_length_b() const {
+	return matrix.get_length_b();
+}
+
+/// \brief Return the score for the specified pair of elements (which is zero if they're outside the matrix's band)
+score_type banded_matrix_dyn_prog_score_source::do_get_score(const size_t &prm_index_a, ///< The index of the element of interest in the first  sequence
+                                                             const size_t &prm_index_b  ///< The index of the element of interest in the second sequence
+                                                             ) const {
+	return numeric_cast<score_type>( matrix.get_score( prm_index_a, prm_index_b ) );
+}
+
+/// \brief Ctor for banded_matrix_dyn_prog_score_source
+banded_matrix_dyn_prog_score_source::banded_matrix_dyn_prog_score_source(const banded_score_matrix &prm_matrix ///< The banded_score_matrix from which the scores should be retrieved
+                                                                         ) : matrix ( prm_matrix ) {
+}
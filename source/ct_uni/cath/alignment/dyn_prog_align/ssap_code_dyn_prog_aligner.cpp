@@ -25,13 +25,13 @@
 #include <boost/range/adaptor/reversed.hpp>
 
 #include "cath/alignment/dyn_prog_align/dyn_prog_score_source/dyn_prog_score_source.hpp"
+#include "cath/alignment/dyn_prog_align/ssap_code_dyn_prog_workspace.hpp"
 #include "cath/alignment/gap/gap_penalty.hpp"
 #include "cath/alignment/pair_alignment.hpp"
 #include "cath/common/boost_addenda/range/indices.hpp"
 #include "cath/common/clone/make_uptr_clone.hpp"
 #include "cath/common/config.hpp"
 #include "cath/common/debug_numeric_cast.hpp"
-#include "cath/common/exception/not_implemented_exception.hpp"
 #include "cath/common/exception/out_of_range_exception.hpp"
 #include "cath/common/type_aliases.hpp"
 #include "cath/ssap/windowed_matrix.hpp"
@@ -47,11 +47,25 @@ using ::boost::numeric_cast;
 using ::std::get;
 using ::std::make_pair;
 using ::std::make_tuple;
+using ::std::max;
 using ::std::numeric_limits;
 using ::std::swap;
 using ::std::to_string;
 using ::std::unique_ptr;
 
+namespace {
+
+	/// \brief A score so poor that it acts as minus infinity without risking overflow
+	constexpr score_type VERY_POOR_SCORE = numeric_limits<score_type>::min() / 10;
+
+	/// \brief Get the workspace used by ssap_code_dyn_prog_aligners without a caller-owned workspace on this thread
+	ssap_code_dyn_prog_workspace & thread_local_workspace() {
+		static thread_local ssap_code_dyn_prog_workspace workspace;
+		return workspace;
+	}
+
+} // namespace
+
 /// \brief A standard do_clone method.
 unique_ptr<dyn_prog_aligner> ssap_code_dyn_prog_aligner::do_clone() const {
 	return { make_uptr_clone( *this ) };
@@ -107,17 +121,27 @@ unique_ptr<dyn_prog_aligner> ssap_code_dyn_prog_aligner::do_clone() const {
 ///  - enter
 ///  - rat
 ///
+/// Gaps
+/// ----
 ///
+/// Each step of the path goes from one aligned pair to the next, either diagonally or by jumping along a row
+/// or column (ie skipping entries of one structure). Rather than searching the row/column for the best cell
+/// to jump to, the best such cell so far is carried in best_row_score (for the row) and best_scores_in_column
+/// (for each column, indexed by rat). A jump costs the open gap penalty plus the extend gap penalty for
+/// each skipped entry after the first, so each carried score drops by the extend penalty at each step
+/// away from its cell. This is Gotoh's affine-gap recurrence expressed in terms of the carried scores and,
+/// with a zero extend penalty, it reduces to the original SSAP behaviour of a constant penalty per gap.
 ///
 ssap_code_dyn_prog_aligner::size_size_int_int_score_tuple ssap_code_dyn_prog_aligner::score_matrix(const dyn_prog_score_source &prm_scorer,       ///< TODOCUMENT
-                                                                                                   const score_type            &prm_gap_penalty,  ///< The gap penalty to be applied for each gap step (ie for opening OR extending a gap)
+                                                                                                   const gap_penalty           &prm_gap_penalty,  ///< The gap penalty to be applied (open for each gap, plus extend for each gap step after the first)
                                                                                                    const size_type             &prm_window_width, ///< TODOCUMENT
-                                                                                                   int_vec_vec                 &prm_path_matrix   ///< TODOCUMENT
+                                                                                                   ssap_code_dyn_prog_workspace &prm_workspace    ///< The (reset) workspace in which to record the best path back from each cell
                                                                                                    ) {
 	const size_t     &length_a           = prm_scorer.get_length_a();
 	const size_t     &length_b           = prm_scorer.get_length_b();
+	const score_type  open_gap_penalty   = prm_gap_penalty.get_open_gap_penalty();
+	const score_type  extend_gap_penalty = prm_gap_penalty.get_extend_gap_penalty();
 
-	const score_type  VERY_POOR_SCORE    = numeric_limits<score_type>::min() / 10;
 	score_type        best_score         = VERY_POOR_SCORE;
 	size_t            flip_flop_current  = 0;
 	size_t            flip_flop_previous = 1;
@@ -128,29 +152,6 @@ ssap_code_dyn_prog_aligner::size_size_int_int_score_tuple ssap_code_dyn_prog_ali
 	int               enter              = 0;
 	bool              edge_set           = false;
 
-	// The best scores...???
-	/// \todo Are the +2s necessary?
-	static score_vec best_scores_in_column;
-	best_scores_in_column.assign( prm_window_width + 2, 0 );
-
-	// The indices corresponding to the best scores...???
-	/// \todo Are the +2s necessary?
-	static size_vec indices_of_best_scores_in_column;
-	indices_of_best_scores_in_column.assign( prm_window_width + 2, 0 );
-
-	// Matrix to store row scores in a flip-flop fashion (ie two sets of values: one active; one inactive)
-	/// \todo Are the +2s necessary?
-	static score_vec_vec row_scores_flipflop_matrix;
-	row_scores_flipflop_matrix.assign( 2, score_vec( prm_window_width + 2, VERY_POOR_SCORE ) );
-
-	// Initialise various variable for the right-most column
-	for (const size_t &a_dest_to_index : indices( prm_window_width + 2 ) ) {
-		row_scores_flipflop_matrix[ 0 ][ a_dest_to_index ] = VERY_POOR_SCORE;
-		row_scores_flipflop_matrix[ 1 ][ a_dest_to_index ] = VERY_POOR_SCORE;
-		prm_path_matrix[ a_dest_to_index ][ length_b ]     = 0;
-		best_scores_in_column[ a_dest_to_index ]           = VERY_POOR_SCORE;
-	}
-
 	// Compare each element in protein B with each element in protein A within window
 	for (const size_t &ctr_b : indices( length_b ) | reversed ) {
 		const size_t ctr_b__offset_1  = ctr_b + 1;
@@ -167,7 +168,7 @@ ssap_code_dyn_prog_aligner::size_size_int_int_score_tuple ssap_code_dyn_prog_ali
 		}
 
 		if ( window_stop__offset_1 == length_a ) {
-			prm_path_matrix[length_a - window_start__offset_1][ctr_b__offset_1] = 0;
+			prm_workspace.get_path_entry_ref( length_a - window_start__offset_1, ctr_b__offset_1 ) = 0;
 		}
 
 		for (const size_t &ctr_a : irange( window_start__offset_1 - 1, window_stop__offset_1 ) | reversed ) {
@@ -175,8 +176,10 @@ ssap_code_dyn_prog_aligner::size_size_int_int_score_tuple ssap_code_dyn_prog_ali
 			const int a_matrix_idx = get_window_matrix_a_index__offset_1(length_a, length_b, prm_window_width, ctr_a__offset_1, ctr_b__offset_1);
 			int       rat          = enter + a_matrix_idx;
 
+			score_type &current_score = prm_workspace.get_flipflop_score_ref( flip_flop_current, numeric_cast<size_t>( a_matrix_idx ) );
+
 //			cerr << "Getting score from " << ctr_a__offset_1 << " (os1) and " << ctr_b__offset_1 << " (os1) : " << get_score__offset_1(prm_scorer, ctr_a__offset_1, ctr_b__offset_1) << endl;
-			row_scores_flipflop_matrix[flip_flop_current][ numeric_cast<size_t>( a_matrix_idx ) ] = get_score__offset_1( prm_scorer, ctr_a__offset_1, ctr_b__offset_1 );
+			current_score = get_score__offset_1( prm_scorer, ctr_a__offset_1, ctr_b__offset_1 );
 
 			if ( ctr_a__offset_1 == length_a || ctr_b__offset_1 == length_b ) {
 				continue;
@@ -191,52 +194,63 @@ ssap_code_dyn_prog_aligner::size_size_int_int_score_tuple ssap_code_dyn_prog_ali
 			if ( rat >= debug_numeric_cast<int>(prm_window_width) ) {
 				rat -= debug_numeric_cast<int>(prm_window_width);
 			}
+			score_type &best_col_score_ref = prm_workspace.get_best_score_in_column_ref         ( numeric_cast<size_t>( rat ) );
+			size_t     &best_col_index_ref = prm_workspace.get_index_of_best_score_in_column_ref( numeric_cast<size_t>( rat ) );
 			if (ctr_a__offset_1 == window_start__offset_1 && !edge_set) {
-				best_scores_in_column           [ numeric_cast<size_t>( rat ) ] = VERY_POOR_SCORE;
-				indices_of_best_scores_in_column[ numeric_cast<size_t>( rat ) ] = ctr_b__offset_1;
+				best_col_score_ref = VERY_POOR_SCORE;
+				best_col_index_ref = ctr_b__offset_1;
 				if ( ctr_a__offset_1 == 1 ) {
 					edge_set = true;
 				}
 			}
 
 			// Set diagonal score and maximum row and column scores
-			const score_type best_col_score = best_scores_in_column           [ numeric_cast<size_t>( rat ) ];
-			const size_t     best_col_index = indices_of_best_scores_in_column[ numeric_cast<size_t>( rat ) ];
+			const score_type best_col_score = best_col_score_ref;
+			const size_t     best_col_index = best_col_index_ref;
 
-			const score_type diag_score     = row_scores_flipflop_matrix[flip_flop_previous][ numeric_cast<size_t>( a_matrix_idx ) ];
-			const score_type col_score      = best_col_score - prm_gap_penalty;
-			const score_type row_score      = best_row_score - prm_gap_penalty;
+			const score_type diag_score     = prm_workspace.get_flipflop_score_ref( flip_flop_previous, numeric_cast<size_t>( a_matrix_idx ) );
+			const score_type col_score      = best_col_score - open_gap_penalty;
+			const score_type row_score      = best_row_score - open_gap_penalty;
+
+			int &path_entry = prm_workspace.get_path_entry_ref( numeric_cast<size_t>( a_matrix_idx ), ctr_b__offset_1 );
 
 			// If diagonal cell score greater than max score from row or column - penalty,
 			// accumulate diagonal score
 			if ( diag_score >= col_score && diag_score >= row_score ) {
-				row_scores_flipflop_matrix[flip_flop_current][ numeric_cast<size_t>( a_matrix_idx ) ] += diag_score;
-				prm_path_matrix[ numeric_cast<size_t>( a_matrix_idx ) ][ctr_b__offset_1]                         = 1;
+				current_score += diag_score;
+				path_entry     = 1;
 			}
 			// Else if row score is better than column score, accumulate maximum score from row
 			else if ( row_score > col_score ) {
-				row_scores_flipflop_matrix[flip_flop_current][ numeric_cast<size_t>( a_matrix_idx ) ] +=   row_score;
-				prm_path_matrix[ numeric_cast<size_t>( a_matrix_idx ) ][ctr_b__offset_1]                         =   numeric_cast<int>( best_row_index - ctr_a__offset_1 + 1 );
+				current_score +=   row_score;
+				path_entry     =   numeric_cast<int>( best_row_index - ctr_a__offset_1 + 1 );
 			}
 			// Else accumulate maximum score from column
 			else {
-				row_scores_flipflop_matrix[flip_flop_current][ numeric_cast<size_t>( a_matrix_idx ) ] +=   col_score;
-				prm_path_matrix[ numeric_cast<size_t>( a_matrix_idx ) ][ctr_b__offset_1]                         = - numeric_cast<int>( best_col_index - ctr_b__offset_1 + 1 );
+				current_score +=   col_score;
+				path_entry     = - numeric_cast<int>( best_col_index - ctr_b__offset_1 + 1 );
 			}
 
-			// If diagonal score greater than previous maximum for row or column, save
-			if (diag_score > best_row_score) {
+			// If diagonal score greater than previous maximum for row or column (after the extend penalty
+			// for stepping one further from it), save; else apply the extend penalty to the previous maximum
+			if (diag_score > best_row_score - extend_gap_penalty) {
 				best_row_score = diag_score;
 				best_row_index = ctr_a__offset_1;
 			}
-			if (diag_score > best_col_score) {
-				best_scores_in_column[ numeric_cast<size_t>( rat ) ]            = diag_score;
-				indices_of_best_scores_in_column[ numeric_cast<size_t>( rat ) ] = ctr_b__offset_1;
+			else {
+				best_row_score = max( VERY_POOR_SCORE, best_row_score - extend_gap_penalty );
+			}
+			if (diag_score > best_col_score - extend_gap_penalty) {
+				best_col_score_ref = diag_score;
+				best_col_index_ref = ctr_b__offset_1;
+			}
+			else {
+				best_col_score_ref = max( VERY_POOR_SCORE, best_col_score - extend_gap_penalty );
 			}
 
 			// Save highest score in matrix and cell coordinates
-			if ( row_scores_flipflop_matrix[flip_flop_current][ numeric_cast<size_t>( a_matrix_idx ) ] >= best_score ) {
-				best_score   = row_scores_flipflop_matrix[flip_flop_current][ numeric_cast<size_t>( a_matrix_idx ) ];
+			if ( current_score >= best_score ) {
+				best_score   = current_score;
 				final_path_a = a_matrix_idx;
 				final_path_b = numeric_cast<int>( ctr_b__offset_1 );
 				mat_a        = 1;
@@ -270,7 +284,7 @@ alignment ssap_code_dyn_prog_aligner::traceback(const size_t      &prm_length_a,
                                                 const int         &prm_mat_b,        ///< TODOCUMENT
                                                 const int         &prm_path_index_a, ///< The current a index in the path matrix
                                                 const int         &prm_path_index_b, ///< The current b index in the path matrix
-                                                const int_vec_vec &prm_path_matrix   ///< A matrix indicating the best step back from each point
+                                                const ssap_code_dyn_prog_workspace &prm_workspace ///< The workspace holding a matrix indicating the best step back from each point
                                                 ) {
 	// Construct an empty alignment
 	alignment new_alignment(alignment::NUM_ENTRIES_IN_PAIR_ALIGNMENT);
@@ -287,7 +301,7 @@ alignment ssap_code_dyn_prog_aligner::traceback(const size_t      &prm_length_a,
 		prm_path_index_b,
 		0,
 		0,
-		prm_path_matrix
+		prm_workspace
 	);
 
 	if constexpr ( IS_IN_DEBUG_MODE ) {
@@ -355,11 +369,13 @@ void ssap_code_dyn_prog_aligner::traceback_recursive(alignment         &prm_alig
                                                      const int         &prm_path_index_b,   ///< The current k index in the path matrix
                                                      const int         &prm_previous_mat_a, ///< The mat_i value in the previous trace() call in the recursive stack
                                                      const int         &prm_previous_mat_b, ///< The mat_j value in the previous trace() call in the recursive stack
-                                                     const int_vec_vec &prm_path_matrix     ///< A matrix indicating the best step back from each point
+                                                     const ssap_code_dyn_prog_workspace &prm_workspace ///< The workspace holding a matrix indicating the best step back from each point
                                                      ) {
 	//
-	const int path_entry = prm_path_matrix[ numeric_cast<size_t>( prm_path_index_a ) ]
-	                                      [ numeric_cast<size_t>( prm_path_index_b ) ];
+	const int path_entry = prm_workspace.get_path_entry(
+		numeric_cast<size_t>( prm_path_index_a ),
+		numeric_cast<size_t>( prm_path_index_b )
+	);
 
 	// Insertions in sequence A from prm_previous_mat_i + 1 to prm_mat_i - 1 (inclusive)
 	for (const int &ctr_a : irange( prm_previous_mat_a + 1, prm_mat_a ) ) {
@@ -399,7 +415,7 @@ void ssap_code_dyn_prog_aligner::traceback_recursive(alignment         &prm_alig
 		next_path_index_b,
 		prm_mat_a,
 		prm_mat_b,
-		prm_path_matrix
+		prm_workspace
 	);
 }
 
@@ -457,24 +473,18 @@ void ssap_code_dyn_prog_aligner::traceback_recursive(alignment         &prm_alig
 ///
 ///
 score_alignment_pair ssap_code_dyn_prog_aligner::do_align(const dyn_prog_score_source &prm_scorer,      ///< TODOCUMENT
-                                                          const gap_penalty           &prm_gap_penalty, ///< The gap penalty to be applied for each gap step (ie for opening OR extending a gap)
+                                                          const gap_penalty           &prm_gap_penalty, ///< The gap penalty to be applied (open for each gap, plus extend for each gap step after the first)
                                                           const size_type             &prm_window_width ///< TODOCUMENT
                                                           ) const {
-	if (prm_gap_penalty.get_extend_gap_penalty() != 0) {
-		BOOST_THROW_EXCEPTION(not_implemented_exception("ssap_code_dyn_prog_aligner unable to handle non-zero extend_gap_penalty"));
-	}
-
 	const size_t length_a = prm_scorer.get_length_a();
 	const size_t length_b = prm_scorer.get_length_b();
 
-	// Matrix to store the first step in the best path from each cell to the bottom right of the matrix
-	/// \todo Are the +2s necessary?
-	/// \todo Is the +1 necessary?
-	static int_vec_vec path_matrix;
-	path_matrix.assign( prm_window_width + 2, int_vec( length_b + 1, 0 ) );
+	// Reset the workspace, whose path matrix stores the first step in the best path from each cell to the bottom right of the matrix
+	ssap_code_dyn_prog_workspace &workspace = ( workspace_ptr != nullptr ) ? *workspace_ptr : thread_local_workspace();
+	workspace.reset( prm_window_width, length_b, VERY_POOR_SCORE );
 
 	// Score the matrix and hence build up a matrix of the best path back
-	const size_size_int_int_score_tuple score_nums = score_matrix(prm_scorer, prm_gap_penalty.get_open_gap_penalty(), prm_window_width, path_matrix);
+	const size_size_int_int_score_tuple score_nums = score_matrix(prm_scorer, prm_gap_penalty, prm_window_width, workspace);
 	const size_t     &mat_a        = get<0>( score_nums );
 	const size_t     &mat_b        = get<1>( score_nums );
 	const int        &final_path_a = get<2>( score_nums );
@@ -489,9 +499,20 @@ score_alignment_pair ssap_code_dyn_prog_aligner::do_align(const dyn_prog_score_s
 		static_cast<int>( mat_b ),
 		final_path_a,
 		final_path_b,
-		path_matrix
+		workspace
 	);
 
 	return make_pair(best_score, new_alignment);
 }
 
+/// \brief Ctor for an ssap_code_dyn_prog_aligner that uses a thread-local workspace
+ssap_code_dyn_prog_aligner::ssap_code_dyn_prog_aligner() = default;
+
+/// \brief Ctor for an ssap_code_dyn_prog_aligner that uses the specified caller-owned workspace
+///
+/// The workspace must outlive this aligner (and any clones of it) and mustn't be used
+/// by more than one alignment at a time.
+ssap_code_dyn_prog_aligner::ssap_code_dyn_prog_aligner(ssap_code_dyn_prog_workspace &prm_workspace ///< The workspace to reuse across alignments
+                                                       ) : workspace_ptr{ &prm_workspace } {
+}
+
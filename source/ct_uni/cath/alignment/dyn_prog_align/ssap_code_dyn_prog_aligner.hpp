@@ -29,26 +29,30 @@
 // clang-format off
 namespace cath::align { class alignment; }
 namespace cath::align { class dyn_prog_score_source; }
+namespace cath::align { class ssap_code_dyn_prog_workspace; }
 // clang-format on
 
 namespace cath::align {
 
 	/// \brief TODOCUMENT
 	///
-	/// WARNING: This uses static data so using separate instances is not enough
-	///          to make this thread-safe.
+	/// The scratch buffers are kept in an ssap_code_dyn_prog_workspace that's reused across alignments:
+	/// either one owned by the caller or, by default, one per thread.
 	class ssap_code_dyn_prog_aligner final : public dyn_prog_aligner {
 	  private:
+		/// \brief The caller-owned workspace to use, or nullptr to use this thread's workspace
+		ssap_code_dyn_prog_workspace *workspace_ptr = nullptr;
+
 		[[nodiscard]] std::unique_ptr<dyn_prog_aligner> do_clone() const final;
 
 		using size_size_int_int_score_tuple = std::tuple<size_t, size_t, int, int, score_type>;
 
 		static size_size_int_int_score_tuple score_matrix( const dyn_prog_score_source &,
-		                                                   const score_type &,
+		                                                   const gap::gap_penalty &,
 		                                                   const size_type &,
-		                                                   int_vec_vec & );
+		                                                   ssap_code_dyn_prog_workspace & );
 
-		static alignment traceback( const size_t &, const size_t &, const int &, const int &, const int &, const int &, const int_vec_vec & );
+		static alignment traceback( const size_t &, const size_t &, const int &, const int &, const int &, const int &, const ssap_code_dyn_prog_workspace & );
 
 		static void traceback_recursive( alignment &,
 		                                 const int &,
@@ -57,11 +61,15 @@ namespace cath::align {
 		                                 const int &,
 		                                 const int &,
 		                                 const int &,
-		                                 const int_vec_vec & );
+		                                 const ssap_code_dyn_prog_workspace & );
 
 		[[nodiscard]] score_alignment_pair do_align( const dyn_prog_score_source &,
 		                                             const gap::gap_penalty &,
 		                                             const size_type & ) const final;
+
+	  public:
+		ssap_code_dyn_prog_aligner();
+		explicit ssap_code_dyn_prog_aligner(ssap_code_dyn_prog_workspace &);
 	};
 
 } // namespace cath::align
@@ -0,0 +1,180 @@
+/// \file
+/// \brief The ssap_code_dyn_prog_aligner test suite
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "ssap_code_dyn_prog_aligner.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include "cath/alignment/alignment.hpp"
+#include "cath/alignment/dyn_prog_align/dyn_prog_score_source/new_matrix_dyn_prog_score_source.hpp"
+#include "cath/alignment/dyn_prog_align/ssap_code_dyn_prog_workspace.hpp"
+#include "cath/alignment/gap/gap_penalty.hpp"
+#include "cath/alignment/pair_alignment.hpp"
+#include "cath/common/boost_addenda/range/indices.hpp"
+#include "cath/common/size_t_literal.hpp"
+#include "cath/common/type_aliases.hpp"
+#include "cath/ssap/windowed_matrix.hpp"
+
+#include <algorithm>
+#include <random>
+
+using namespace ::cath;
+using namespace ::cath::align;
+using namespace ::cath::align::gap;
+using namespace ::cath::common;
+
+using ::std::mt19937;
+using ::std::uniform_int_distribution;
+
+namespace {
+
+	/// \brief The ssap_code_dyn_prog_aligner_test_suite_fixture to assist in testing ssap_code_dyn_prog_aligner
+	struct ssap_code_dyn_prog_aligner_test_suite_fixture {
+	protected:
+		~ssap_code_dyn_prog_aligner_test_suite_fixture() noexcept = default;
+
+		/// \brief Make a matrix of random non-negative whole-number scores (like SSAP's)
+		static float_score_vec_vec make_random_scores(mt19937      &prm_rng,      ///< The random number generator
+		                                              const size_t &prm_length_a, ///< The number of rows
+		                                              const size_t &prm_length_b  ///< The number of columns
+		                                              ) {
+			uniform_int_distribution<int> score_dist{ 0, 5 };
+			float_score_vec_vec scores( prm_length_a, float_score_vec( prm_length_b ) );
+			for (float_score_vec &row : scores) {
+				for (float_score_type &score : row) {
+					score = static_cast<float_score_type>( score_dist( prm_rng ) );
+				}
+			}
+			return scores;
+		}
+
+		/// \brief Independently recalculate the score of the specified alignment: the sum of the scores of the aligned pairs
+		///        less open + ( n - 1 ) * extend for each internal gap of length n (gaps at the ends are free)
+		static score_type rescore_alignment(const dyn_prog_score_source &prm_scorer,      ///< The source of the scores
+		                                    const alignment             &prm_alignment,   ///< The alignment to score
+		                                    const gap_penalty           &prm_gap_penalty  ///< The gap penalty
+		                                    ) {
+			const size_t length = prm_alignment.length();
+			score_type   score  = 0;
+			for (const size_t &entry : { 0_z, 1_z } ) {
+				size_opt first_index;
+				size_opt last_index;
+				for (const size_t &index : indices( length ) ) {
+					if ( prm_alignment.position_of_entry_of_index( entry, index ) ) {
+						first_index = first_index.value_or( index );
+						last_index  = index;
+					}
+				}
+				bool in_gap = false;
+				for (const size_t &index : indices( length ) ) {
+					if ( prm_alignment.position_of_entry_of_index( entry, index ) ) {
+						in_gap = false;
+					}
+					else if ( first_index && index > *first_index && index < *last_index ) {
+						score -= in_gap ? prm_gap_penalty.get_extend_gap_penalty() : prm_gap_penalty.get_open_gap_penalty();
+						in_gap = true;
+					}
+				}
+			}
+			for (const size_t &index : indices( length ) ) {
+				if ( has_both_positions_of_index( prm_alignment, index ) ) {
+					score += prm_scorer.get_score(
+						get_a_position_of_index( prm_alignment, index ),
+						get_b_position_of_index( prm_alignment, index )
+					);
+				}
+			}
+			return score;
+		}
+	};
+
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE(ssap_code_dyn_prog_aligner_test_suite, ssap_code_dyn_prog_aligner_test_suite_fixture)
+
+BOOST_AUTO_TEST_CASE(affine_scores_match_rescored_alignments) {
+	mt19937 rng{ 17 };
+	uniform_int_distribution<size_t> length_dist{ 3, 30 };
+	for ([[maybe_unused]] const size_t &rep_ctr : indices( 100_z ) ) {
+		const size_t length_a = length_dist( rng );
+		const size_t length_b = length_dist( rng );
+		const float_score_vec_vec              scores = make_random_scores( rng, length_a, length_b );
+		const new_matrix_dyn_prog_score_source scorer{ scores, length_a, length_b };
+		const size_t narrow_window_width = ( std::max( length_a, length_b ) - std::min( length_a, length_b ) ) + 4;
+		for (const size_t &window_width : { get_window_width_for_full_matrix( length_a, length_b ), narrow_window_width } ) {
+			for (const gap_penalty &the_gap_penalty : { gap_penalty( 8, 0 ), gap_penalty( 5, 1 ), gap_penalty( 3, 3 ), gap_penalty( 10, 2 ) } ) {
+				const score_alignment_pair result = ssap_code_dyn_prog_aligner().align( scorer, the_gap_penalty, window_width );
+				BOOST_CHECK_EQUAL( result.first, rescore_alignment( scorer, result.second, the_gap_penalty ) );
+			}
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(larger_extend_penalty_never_increases_score) {
+	mt19937 rng{ 19 };
+	uniform_int_distribution<size_t> length_dist{ 3, 30 };
+	for ([[maybe_unused]] const size_t &rep_ctr : indices( 50_z ) ) {
+		const size_t length_a = length_dist( rng );
+		const size_t length_b = length_dist( rng );
+		const float_score_vec_vec              scores = make_random_scores( rng, length_a, length_b );
+		const new_matrix_dyn_prog_score_source scorer{ scores, length_a, length_b };
+		const size_t window_width = get_window_width_for_full_matrix( length_a, length_b );
+		score_type prev_score = ssap_code_dyn_prog_aligner().align( scorer, gap_penalty( 6, 0 ), window_width ).first;
+		for (const score_type &extend : { 1, 2, 4 } ) {
+			const score_type score = ssap_code_dyn_prog_aligner().align( scorer, gap_penalty( 6, extend ), window_width ).first;
+			BOOST_CHECK_LE( score, prev_score );
+			prev_score = score;
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(caller_owned_workspace_gives_same_results_and_is_reused) {
+	mt19937 rng{ 23 };
+	ssap_code_dyn_prog_workspace workspace;
+	const ssap_code_dyn_prog_aligner workspace_aligner{ workspace };
+
+	// Align the largest pair first so that the later, smaller alignments can reuse the workspace's storage
+	const float_score_vec_vec              large_scores = make_random_scores( rng, 40, 40 );
+	const new_matrix_dyn_prog_score_source large_scorer{ large_scores, 40, 40 };
+	BOOST_CHECK_EQUAL(
+		workspace_aligner.align           ( large_scorer, gap_penalty( 6, 1 ), 80 ).second,
+		ssap_code_dyn_prog_aligner().align( large_scorer, gap_penalty( 6, 1 ), 80 ).second
+	);
+	const int * const path_matrix_data = workspace.get_path_matrix_data();
+
+	uniform_int_distribution<size_t> length_dist{ 3, 40 };
+	for ([[maybe_unused]] const size_t &rep_ctr : indices( 20_z ) ) {
+		const size_t length_a = length_dist( rng );
+		const size_t length_b = length_dist( rng );
+		const float_score_vec_vec              scores = make_random_scores( rng, length_a, length_b );
+		const new_matrix_dyn_prog_score_source scorer{ scores, length_a, length_b };
+		const size_t window_width = get_window_width_for_full_matrix( length_a, length_b );
+
+		const score_alignment_pair got      = workspace_aligner.align           ( scorer, gap_penalty( 6, 1 ), window_width );
+		const score_alignment_pair expected = ssap_code_dyn_prog_aligner().align( scorer, gap_penalty( 6, 1 ), window_width );
+		BOOST_CHECK_EQUAL( got.first,  expected.first  );
+		BOOST_CHECK_EQUAL( got.second, expected.second );
+		BOOST_CHECK_EQUAL( workspace.get_num_rows(),        window_width + 1 );
+		BOOST_CHECK_EQUAL( workspace.get_path_row_stride(), length_b     + 1 );
+	}
+	BOOST_CHECK( workspace.get_path_matrix_data() == path_matrix_data );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,58 @@
+/// \file
+/// \brief The ssap_code_dyn_prog_workspace class definitions
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 1989, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "ssap_code_dyn_prog_workspace.hpp"
+
+using namespace ::cath;
+using namespace ::cath::align;
+
+/// \brief Prepare the workspace for an alignment with the specified window width and length of the second entry
+///
+/// This zeroes the path matrix and sets all the scores to the specified very poor score,
+/// reusing the existing storage where possible
+void ssap_code_dyn_prog_workspace::reset(const size_t     &prm_window_width,   ///< The width of the window in which the alignment is to be performed
+                                         const size_t     &prm_length_b,       ///< The length of the second entry
+                                         const score_type &prm_very_poor_score ///< The score with which to fill the score buffers
+                                         ) {
+	// The (window) row indices run from 0 to prm_window_width inclusive and the column indices
+	// are offset_1 (so run up to prm_length_b inclusive), hence the +1s
+	num_rows        = prm_window_width + 1;
+	path_row_stride = prm_length_b     + 1;
+
+	path_matrix.assign                     ( num_rows * path_row_stride, 0                   );
+	best_scores_in_column.assign           ( num_rows,                   prm_very_poor_score );
+	indices_of_best_scores_in_column.assign( num_rows,                   0                   );
+	row_scores_flipflop.assign             ( 2 * num_rows,               prm_very_poor_score );
+}
+
+/// \brief Getter for the number of rows in the path matrix (and entries in each of the per-row buffers)
+size_t ssap_code_dyn_prog_workspace::get_num_rows() const {
+	return num_rows;
+}
+
+/// \brief Getter for the number of columns in the path matrix
+size_t ssap_code_dyn_prog_workspace::get_path_row_stride() const {
+	return path_row_stride;
+}
+
+/// \brief Get the address of the path matrix's storage (so that tests can check it's reused)
+const int * ssap_code_dyn_prog_workspace::get_path_matrix_data() const {
+	return path_matrix.data();
+}
@@ -0,0 +1,114 @@
+/// \file
+/// \brief The ssap_code_dyn_prog_workspace class header
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 1989, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef CATH_TOOLS_SOURCE_CT_UNI_CATH_ALIGNMENT_DYN_PROG_ALIGN_SSAP_CODE_DYN_PROG_WORKSPACE_HPP
+#define CATH_TOOLS_SOURCE_CT_UNI_CATH_ALIGNMENT_DYN_PROG_ALIGN_SSAP_CODE_DYN_PROG_WORKSPACE_HPP
+
+#include "cath/common/type_aliases.hpp"
+
+namespace cath::align {
+
+	/// \brief The scratch buffers used by ssap_code_dyn_prog_aligner, which can be reused across many alignments
+	///
+	/// The path matrix is stored row by row in a single vector (with a row stride of length_b + 1)
+	/// and the two flip-flop rows of scores are likewise stored one after the other.
+	///
+	/// Resetting reuses the existing storage where possible so, once a workspace has been used for
+	/// the largest alignment it'll see, further alignments don't allocate any scratch memory.
+	///
+	/// A workspace must not be used by more than one alignment at a time.
+	class ssap_code_dyn_prog_workspace final {
+	private:
+		/// \brief The number of rows in the path matrix (and entries in each of the per-row buffers)
+		size_t num_rows = 0;
+
+		/// \brief The number of columns in the path matrix
+		size_t path_row_stride = 0;
+
+		/// \brief The first step in the best path from each cell, stored row by row
+		int_vec path_matrix;
+
+		/// \brief The best score carried down each column, indexed by rat
+		score_vec best_scores_in_column;
+
+		/// \brief The indices corresponding to best_scores_in_column
+		size_vec indices_of_best_scores_in_column;
+
+		/// \brief The two flip-flop rows of scores (one active; one inactive), stored one after the other
+		score_vec row_scores_flipflop;
+
+	public:
+		void reset(const size_t &,
+		           const size_t &,
+		           const score_type &);
+
+		[[nodiscard]] size_t get_num_rows() const;
+		[[nodiscard]] size_t get_path_row_stride() const;
+
+		[[nodiscard]] const int & get_path_entry(const size_t &,
+		                                         const size_t &) const;
+		int & get_path_entry_ref(const size_t &,
+		                         const size_t &);
+
+		score_type & get_best_score_in_column_ref(const size_t &);
+		size_t & get_index_of_best_score_in_column_ref(const size_t &);
+
+		score_type & get_flipflop_score_ref(const size_t &,
+		                                    const size_t &);
+
+		[[nodiscard]] const int * get_path_matrix_data() const;
+	};
+
+	/// \brief Get the path entry for the specified cell
+	inline const int & ssap_code_dyn_prog_workspace::get_path_entry(const size_t &prm_row_index, ///< The (window) row index of the cell
+	                                                                const size_t &prm_col_index  ///< The column index of the cell
+	                                                                ) const {
+		return path_matrix[ prm_row_index * path_row_stride + prm_col_index ];
+	}
+
+	/// \brief Get a reference to the path entry for the specified cell
+	inline int & ssap_code_dyn_prog_workspace::get_path_entry_ref(const size_t &prm_row_index, ///< The (window) row index of the cell
+	                                                              const size_t &prm_col_index  ///< The column index of the cell
+	                                                              ) {
+		return path_matrix[ prm_row_index * path_row_stride + prm_col_index ];
+	}
+
+	/// \brief Get a reference to the best score carried down the column with the specified rat index
+	inline score_type & ssap_code_dyn_prog_workspace::get_best_score_in_column_ref(const size_t &prm_index ///< The rat index
+	                                                                               ) {
+		return best_scores_in_column[ prm_index ];
+	}
+
+	/// \brief Get a reference to the index of the best score carried down the column with the specified rat index
+	inline size_t & ssap_code_dyn_prog_workspace::get_index_of_best_score_in_column_ref(const size_t &prm_index ///< The rat index
+	                                                                                     ) {
+		return indices_of_best_scores_in_column[ prm_index ];
+	}
+
+	/// \brief Get a reference to the score in the specified flip-flop row at the specified (window) index
+	inline score_type & ssap_code_dyn_prog_workspace::get_flipflop_score_ref(const size_t &prm_flipflop_index, ///< Which of the two flip-flop rows (0 or 1)
+	                                                                         const size_t &prm_index           ///< The (window) index within the row
+	                                                                         ) {
+		return row_scores_flipflop[ prm_flipflop_index * num_rows + prm_index ];
+	}
+
+} // namespace cath::align
+
+#endif // CATH_TOOLS_SOURCE_CT_UNI_CATH_ALIGNMENT_DYN_PROG_ALIGN_SSAP_CODE_DYN_PROG_WORKSPACE_HPP
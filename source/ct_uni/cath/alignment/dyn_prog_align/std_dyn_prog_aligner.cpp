@@ -22,15 +22,24 @@
 
 #include <boost/numeric/conversion/cast.hpp>
 #include <boost/range/adaptor/reversed.hpp>
+#include <boost/range/irange.hpp>
 
 #include "cath/alignment/alignment.hpp"
+#include "cath/alignment/dyn_prog_align/detail/banded_score_matrix.hpp"
 #include "cath/alignment/dyn_prog_align/detail/matrix_plotter/gnuplot_matrix_plotter.hpp" // ***** TEMPORARY *****
 #include "cath/alignment/dyn_prog_align/detail/matrix_plotter/matrix_plot.hpp"
 #include "cath/alignment/dyn_prog_align/dyn_prog_score_source/dyn_prog_score_source.hpp"
+#include "cath/alignment/gap/gap_penalty.hpp"
+#include "cath/common/boost_addenda/range/indices.hpp"
 #include "cath/common/clone/make_uptr_clone.hpp"
 #include "cath/common/difference.hpp"
+#include "cath/common/exception/invalid_argument_exception.hpp"
+#include "cath/common/size_t_literal.hpp"
 #include "cath/common/type_aliases.hpp"
 
+#include <cmath>
+#include <limits>
+
 using namespace ::cath;
 using namespace ::cath::align;
 using namespace ::cath::align::detail;
@@ -39,8 +48,101 @@ using namespace ::cath::common;
 using namespace ::std;
 
 using ::boost::adaptors::reversed;
+using ::boost::irange;
 using ::boost::numeric_cast;
 
+namespace {
+
+	/// \brief The accumulated score towards the end from a point and the path_step chosen there
+	struct score_and_path_step final {
+		/// \brief The score of the best path from the point to the end
+		score_type score = 0;
+
+		/// \brief The first step of the best path from the point to the end
+		path_step  step  = path_step::ALIGN_PAIR;
+	};
+
+	/// \brief Type alias for a vector of score_and_path_step values
+	using score_and_path_step_vec     = vector<score_and_path_step>;
+
+	/// \brief Type alias for a vector of score_and_path_step_vec values
+	using score_and_path_step_vec_vec = vector<score_and_path_step_vec>;
+
+	/// \brief Calculate the scores and path_steps for (the band of) one row of the matrix from those of the row after it
+	///
+	/// This mirrors get_total_scores_of_path_steps_from_point() (and the return_path_matrix and
+	/// score_accumulation_matrix treatment of points on the bottom and right edges) so that, over full rows,
+	/// the results are identical to those of the full-matrix sweep.
+	///
+	/// Each row is stored from the first column of its band. A path_step to a point outside the band
+	/// (but inside the matrix) is never chosen.
+	template <typename FN>
+	void sweep_row(const dyn_prog_score_source   &prm_scorer,      ///< The source of the scores of aligning each pair of items
+	               const gap_penalty             &prm_gap_penalty, ///< The gap penalty to be applied for each gap step
+	               const FN                      &prm_chooser,     ///< A function to choose the path_step from a path_step_score_map and the point's indices
+	               const size_t                  &prm_index_a,     ///< The index of the row to calculate
+	               const size_size_pair          &prm_band,        ///< The begin and end columns of the band of the row to calculate
+	               const size_size_pair          &prm_band_after,  ///< The begin and end columns of the band of the row after this one
+	               const score_and_path_step_vec &prm_row_after,   ///< The band of the row after this one (ignored if this is the last row)
+	               score_and_path_step_vec       &prm_row          ///< The band of the row to populate
+	               ) {
+		const size_t length_a = prm_scorer.get_length_a();
+		const size_t length_b = prm_scorer.get_length_b();
+		prm_row.resize( prm_band.second - prm_band.first );
+
+		const auto is_in_band = [&] (const size_t &prm_point_a, const size_t &prm_point_b) {
+			const size_size_pair &the_band = ( prm_point_a == prm_index_a ) ? prm_band : prm_band_after;
+			return ( prm_point_b >= the_band.first && prm_point_b < the_band.second );
+		};
+		const auto point_value = [&] (const size_t &prm_point_a, const size_t &prm_point_b) -> const score_and_path_step & {
+			return ( prm_point_a == prm_index_a ) ? prm_row      [ prm_point_b - prm_band.first       ]
+			                                      : prm_row_after[ prm_point_b - prm_band_after.first ];
+		};
+		const auto score_at_point = [&] (const size_t &prm_point_a, const size_t &prm_point_b) {
+			return ( prm_point_a < length_a && prm_point_b < length_b ) ? point_value( prm_point_a, prm_point_b ).score
+			                                                            : numeric_cast<score_type>( 0 );
+		};
+		const auto step_at_point = [&] (const size_t &prm_point_a, const size_t &prm_point_b) {
+			if ( prm_point_a <  length_a && prm_point_b == length_b ) {
+				return path_step::INSERT_INTO_FIRST;
+			}
+			if ( prm_point_a == length_a && prm_point_b <  length_b ) {
+				return path_step::INSERT_INTO_SECOND;
+			}
+			return point_value( prm_point_a, prm_point_b ).step;
+		};
+
+		for (const size_t &index_b : irange( prm_band.first, prm_band.second ) | reversed ) {
+			path_step_score_map score_of_path_step;
+			for (const path_step &the_path_step : ALL_PATH_STEPS) {
+				const size_size_pair after_indices    = indices_of_point_after_path_step( the_path_step, prm_index_a, index_b );
+				if ( after_indices.first < length_a && after_indices.second < length_b && ! is_in_band( after_indices.first, after_indices.second ) ) {
+					score_of_path_step[ the_path_step ] = numeric_limits<score_type>::lowest();
+					continue;
+				}
+				const bool           is_free_step     = (
+					( the_path_step == path_step::ALIGN_PAIR                               )
+					||
+					( the_path_step == path_step::INSERT_INTO_FIRST  && index_b     == 0 )
+					||
+					( the_path_step == path_step::INSERT_INTO_SECOND && prm_index_a == 0 )
+				);
+				const score_type     step_gap_penalty = is_free_step
+					? numeric_cast<score_type>( 0.0 )
+					: ( step_at_point( after_indices.first, after_indices.second ) == the_path_step ) ? prm_gap_penalty.get_extend_gap_penalty()
+					                                                                                   : prm_gap_penalty.get_open_gap_penalty();
+				const score_type beyond_step_score = score_at_point( after_indices.first, after_indices.second );
+				const score_type step_score        = ( the_path_step == path_step::ALIGN_PAIR ) ? prm_scorer.get_score( prm_index_a, index_b )
+				                                                                                : numeric_cast<score_type>( 0.0 );
+				score_of_path_step[ the_path_step ] = beyond_step_score + step_score - step_gap_penalty;
+			}
+			const path_step the_chosen_path = prm_chooser( score_of_path_step, prm_index_a, index_b );
+			prm_row[ index_b - prm_band.first ] = { score_of_path_step.at( the_chosen_path ), the_chosen_path };
+		}
+	}
+
+} // namespace
+
 /// \brief A standard do_clone method.
 unique_ptr<dyn_prog_aligner> std_dyn_prog_aligner::do_clone() const {
 	return { make_uptr_clone( *this ) };
@@ -150,11 +252,27 @@ unique_ptr<dyn_prog_aligner> std_dyn_prog_aligner::do_clone() const {
 ///  * prefer a move toward the diagonal passing through the top-left corner
 ///  * prefer a move toward the diagonal passing through the bottom-right corner
 ///  * fall back on a parameter that instructs which way to go
-
+///
+/// Memory
+/// ------
+///
+/// If the matrix has more than full_matrix_max_cells cells, this uses align_checkpointed(),
+/// which gives the same result without storing the full return_path and score matrices.
 score_alignment_pair std_dyn_prog_aligner::do_align(const dyn_prog_score_source &prm_scorer,          ///< TODOCUMENT
                                                     const gap_penalty           &prm_gap_penalty,     ///< The gap penalty to be applied for each gap step (ie for opening OR extending a gap)
                                                     const size_type             &/*prm_window_width*/ ///< TODOCUMENT
                                                     ) const {
+	const size_t num_cells = prm_scorer.get_length_a() * prm_scorer.get_length_b();
+	return ( num_cells > full_matrix_max_cells ) ? align_checkpointed( prm_scorer, prm_gap_penalty )
+	                                             : align_full_matrix ( prm_scorer, prm_gap_penalty );
+}
+
+/// \brief Align using the full return_path and score matrices
+///
+/// \copydetails do_align()
+score_alignment_pair std_dyn_prog_aligner::align_full_matrix(const dyn_prog_score_source &prm_scorer,     ///< TODOCUMENT
+                                                             const gap_penalty           &prm_gap_penalty ///< The gap penalty to be applied for each gap step (ie for opening OR extending a gap)
+                                                             ) const {
 	const size_t length_a     = prm_scorer.get_length_a();
 	const size_t length_b     = prm_scorer.get_length_b();
 	const size_t window_width = get_window_width_for_full_matrix(length_a, length_b);
@@ -200,6 +318,141 @@ score_alignment_pair std_dyn_prog_aligner::do_align(const dyn_prog_score_source
 	return make_pair( final_score, final_alignment );
 }
 
+/// \brief Align by sweeping the matrix row by row, only keeping checkpoint rows, and then
+///        recomputing the rows a block at a time whilst tracing the path
+///
+/// This gives exactly the same score and alignment as align_full_matrix(): each point's
+/// score and path_step only depend on the point's neighbours in its own row and the row after it,
+/// so recomputing a block of rows from the checkpoint row after it reproduces them exactly,
+/// including all the tie-breaking.
+///
+/// With checkpoints every ceil(sqrt(length_a)) rows, this stores O(length_b * sqrt(length_a))
+/// values rather than O(length_a * length_b) at the cost of computing each row twice.
+score_alignment_pair std_dyn_prog_aligner::align_checkpointed(const dyn_prog_score_source &prm_scorer,     ///< The source of the scores of aligning each pair of items
+                                                              const gap_penalty           &prm_gap_penalty ///< The gap penalty to be applied for each gap step (ie for opening OR extending a gap)
+                                                              ) const {
+	const size_t length_a     = prm_scorer.get_length_a();
+	const size_t length_b     = prm_scorer.get_length_b();
+	const size_t block_height = max( 1_z, numeric_cast<size_t>( ceil( sqrt( numeric_cast<double>( length_a ) ) ) ) );
+	const size_t num_blocks   = ( length_a + block_height - 1 ) / block_height;
+
+	const auto chooser = [&] (const path_step_score_map &prm_score_of_path_step, const size_t &prm_index_a, const size_t &prm_index_b) {
+		return choose_path_step( prm_score_of_path_step, prm_index_a, prm_index_b, length_a, length_b );
+	};
+
+	// Sweep up the rows, keeping the first row of each block
+	const size_size_pair full_row{ 0, length_b };
+	score_and_path_step_vec_vec checkpoints( num_blocks );
+	score_and_path_step_vec     row;
+	score_and_path_step_vec     row_after;
+	for (const size_t &index_a : indices( length_a ) | reversed ) {
+		sweep_row( prm_scorer, prm_gap_penalty, chooser, index_a, full_row, full_row, row_after, row );
+		if ( index_a % block_height == 0 ) {
+			checkpoints[ index_a / block_height ] = row;
+		}
+		swap( row, row_after );
+	}
+	const score_type final_score = checkpoints.front().front().score;
+
+	// Trace the path from the top-left, recomputing each block's rows from the checkpoint after it
+	alignment new_alignment( alignment::NUM_ENTRIES_IN_PAIR_ALIGNMENT );
+	new_alignment.reserve( max( length_a, length_b ) );
+	size_size_pair position( 0, 0 );
+	score_and_path_step_vec_vec   block_rows( block_height );
+	const score_and_path_step_vec no_row_after;
+	for (const size_t &block_ctr : indices( num_blocks ) ) {
+		const size_t block_begin = block_ctr * block_height;
+		const size_t block_end   = min( block_begin + block_height, length_a );
+		for (const size_t &index_a : irange( block_begin, block_end ) | reversed ) {
+			const score_and_path_step_vec &the_row_after = ( index_a + 1 <  block_end ) ? block_rows[ index_a + 1 - block_begin ]
+			                                             : ( block_end   <  length_a  ) ? checkpoints[ block_ctr + 1 ]
+			                                                                            : no_row_after;
+			sweep_row( prm_scorer, prm_gap_penalty, chooser, index_a, full_row, full_row, the_row_after, block_rows[ index_a - block_begin ] );
+		}
+		while ( position.first < block_end ) {
+			const path_step next_step = ( position.second < length_b )
+			                            ? block_rows[ position.first - block_begin ][ position.second ].step
+			                            : path_step::INSERT_INTO_FIRST;
+			append_path_step_to_pair_alignment_from_point( new_alignment, next_step, position );
+			position = indices_of_point_after_path_step( next_step, position.first, position.second );
+		}
+	}
+	while ( position.second < length_b ) {
+		append_path_step_to_pair_alignment_from_point( new_alignment, path_step::INSERT_INTO_SECOND, position );
+		++position.second;
+	}
+
+	return make_pair( final_score, new_alignment );
+}
+
+/// \brief Align, only considering paths through the points within the band of the specified banded_score_matrix
+///
+/// This only stores the return path and scores for the points within the band, so it uses memory in
+/// proportion to the band's area rather than the full matrix's. With a band that covers the whole matrix,
+/// this gives exactly the same score and alignment as align_full_matrix().
+///
+/// The first row's band must start at the first column and each row's band must overlap the previous
+/// row's (as banded_score_matrix::reset_to_band() ensures) so that there's a path through the band.
+score_alignment_pair std_dyn_prog_aligner::align_in_band(const dyn_prog_score_source       &prm_scorer,       ///< The source of the scores of aligning each pair of items
+                                                         const gap_penalty                 &prm_gap_penalty,  ///< The gap penalty to be applied for each gap step (ie for opening OR extending a gap)
+                                                         const detail::banded_score_matrix &prm_band_matrix   ///< The banded_score_matrix whose band the path should stay within
+                                                         ) const {
+	const size_t length_a = prm_scorer.get_length_a();
+	const size_t length_b = prm_scorer.get_length_b();
+	if ( prm_band_matrix.get_length_a() != length_a || prm_band_matrix.get_length_b() != length_b ) {
+		BOOST_THROW_EXCEPTION(invalid_argument_exception("Cannot align in a band of a matrix with different dimensions from the scores"));
+	}
+	if ( length_a == 0 || length_b == 0 ) {
+		return align_full_matrix( prm_scorer, prm_gap_penalty );
+	}
+	if ( prm_band_matrix.get_band_begin( 0 ) != 0 ) {
+		BOOST_THROW_EXCEPTION(invalid_argument_exception("Cannot align in a band that doesn't start at the first column of the first row"));
+	}
+
+	const auto chooser = [&] (const path_step_score_map &prm_score_of_path_step, const size_t &prm_index_a, const size_t &prm_index_b) {
+		return choose_path_step( prm_score_of_path_step, prm_index_a, prm_index_b, length_a, length_b );
+	};
+	const auto band_of_row = [&] (const size_t &prm_index_a) {
+		return ( prm_index_a < length_a ) ? make_pair( prm_band_matrix.get_band_begin( prm_index_a ), prm_band_matrix.get_band_end( prm_index_a ) )
+		                                  : make_pair( 0_z, 0_z );
+	};
+
+	// Sweep up the rows, storing the band of each
+	score_and_path_step_vec_vec   band_rows( length_a );
+	const score_and_path_step_vec no_row_after;
+	for (const size_t &index_a : indices( length_a ) | reversed ) {
+		sweep_row(
+			prm_scorer,
+			prm_gap_penalty,
+			chooser,
+			index_a,
+			band_of_row( index_a     ),
+			band_of_row( index_a + 1 ),
+			( index_a + 1 < length_a ) ? band_rows[ index_a + 1 ] : no_row_after,
+			band_rows[ index_a ]
+		);
+	}
+	const score_type final_score = band_rows.front().front().score;
+
+	// Trace the path from the top-left
+	alignment new_alignment( alignment::NUM_ENTRIES_IN_PAIR_ALIGNMENT );
+	new_alignment.reserve( max( length_a, length_b ) );
+	size_size_pair position( 0, 0 );
+	while ( position.first < length_a ) {
+		const path_step next_step = ( position.second < length_b )
+		                            ? band_rows[ position.first ][ position.second - prm_band_matrix.get_band_begin( position.first ) ].step
+		                            : path_step::INSERT_INTO_FIRST;
+		append_path_step_to_pair_alignment_from_point( new_alignment, next_step, position );
+		position = indices_of_point_after_path_step( next_step, position.first, position.second );
+	}
+	while ( position.second < length_b ) {
+		append_path_step_to_pair_alignment_from_point( new_alignment, path_step::INSERT_INTO_SECOND, position );
+		++position.second;
+	}
+
+	return make_pair( final_score, new_alignment );
+}
+
 /// \brief TODOCUMENT
 path_step std_dyn_prog_aligner::choose_path_step(const path_step_score_map &prm_score_of_path, ///< TODOCUMENT
                                                  const size_t              &prm_index_a,       ///< TODOCUMENT
@@ -286,3 +539,13 @@ path_step std_dyn_prog_aligner::choose_path_step(const path_step_score_map &prm_
 
 	return path_step::INSERT_INTO_FIRST;
 }
+
+/// \brief Ctor from the maximum number of cells for which the full return path and score matrices are stored
+std_dyn_prog_aligner::std_dyn_prog_aligner(const size_t &prm_full_matrix_max_cells ///< The maximum number of cells for which the full return path and score matrices are stored (larger alignments use the checkpointed sweep)
+                                           ) : full_matrix_max_cells{ prm_full_matrix_max_cells } {
+}
+
+/// \brief Getter for the maximum number of cells for which the full return path and score matrices are stored
+const size_t & std_dyn_prog_aligner::get_full_matrix_max_cells() const {
+	return full_matrix_max_cells;
+}
@@ -26,11 +26,29 @@
 #include "cath/alignment/dyn_prog_align/dyn_prog_aligner.hpp"
 #include "cath/common/type_aliases.hpp"
 
+// clang-format off
+namespace cath::align::detail { class banded_score_matrix; }
+// clang-format on
+
 namespace cath::align {
 
 	/// \brief TODOCUMENT
+	///
+	/// Alignments with more than a threshold number of cells are made with a checkpointed sweep
+	/// that doesn't store the full return path and score matrices (see align_checkpointed()).
+	/// This gives exactly the same results as the full-matrix sweep.
+	///
+	/// align_in_band() restricts the path to the band of a banded_score_matrix and only stores that band.
 	class std_dyn_prog_aligner final : public dyn_prog_aligner {
+	public:
+		/// \brief The default maximum number of cells for which the full return path and score matrices are stored
+		static constexpr size_t DEFAULT_FULL_MATRIX_MAX_CELLS = 16'000'000;
+
 	private:
+		/// \brief The maximum number of cells for which the full return path and score matrices are stored
+		///        (larger alignments use the checkpointed sweep)
+		size_t full_matrix_max_cells = DEFAULT_FULL_MATRIX_MAX_CELLS;
+
 		/// \brief TODOCUMENT
 		mutable detail::return_path_matrix        the_return_path        = detail::make_uninitialised_return_path_matrix();
 
@@ -43,11 +61,26 @@ namespace cath::align {
 		                              const gap::gap_penalty &,
 		                              const size_type &) const final;
 
+		score_alignment_pair align_full_matrix(const dyn_prog_score_source &,
+		                                       const gap::gap_penalty &) const;
+
+		score_alignment_pair align_checkpointed(const dyn_prog_score_source &,
+		                                        const gap::gap_penalty &) const;
+
 		detail::path_step choose_path_step(const detail::path_step_score_map &,
 		                                   const size_t &,
 		                                   const size_t &,
 		                                   const size_t &,
 		                                   const size_t &) const;
+
+	public:
+		explicit std_dyn_prog_aligner(const size_t & = DEFAULT_FULL_MATRIX_MAX_CELLS);
+
+		[[nodiscard]] const size_t & get_full_matrix_max_cells() const;
+
+		[[nodiscard]] score_alignment_pair align_in_band(const dyn_prog_score_source &,
+		                                                 const gap::gap_penalty &,
+		                                                 const detail::banded_score_matrix &) const;
 	};
 
 } // namespace cath::align
@@ -0,0 +1,186 @@
+/// \file
+/// \brief The std_dyn_prog_aligner test suite
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <boost/test/unit_test.hpp>
+
+#include "cath/alignment/alignment.hpp"
+#include "cath/alignment/dyn_prog_align/detail/banded_score_matrix.hpp"
+#include "cath/alignment/dyn_prog_align/dyn_prog_score_source/new_matrix_dyn_prog_score_source.hpp"
+#include "cath/alignment/dyn_prog_align/std_dyn_prog_aligner.hpp"
+#include "cath/alignment/gap/gap_penalty.hpp"
+#include "cath/alignment/pair_alignment.hpp"
+#include "cath/common/boost_addenda/range/indices.hpp"
+#include "cath/common/chrono/duration_to_seconds_string.hpp"
+#include "cath/common/size_t_literal.hpp"
+#include "cath/common/type_aliases.hpp"
+
+#include <sys/resource.h>
+
+#include <chrono>
+#include <limits>
+#include <random>
+
+using namespace ::cath;
+using namespace ::cath::align;
+using namespace ::cath::align::detail;
+using namespace ::cath::align::gap;
+using namespace ::cath::common;
+
+using ::std::chrono::high_resolution_clock;
+using ::std::mt19937;
+using ::std::uniform_int_distribution;
+
+namespace {
+
+	/// \brief The std_dyn_prog_aligner_test_suite_fixture to assist in testing std_dyn_prog_aligner
+	struct std_dyn_prog_aligner_test_suite_fixture {
+	protected:
+		~std_dyn_prog_aligner_test_suite_fixture() noexcept = default;
+
+		/// \brief An aligner that always uses the full matrices
+		const std_dyn_prog_aligner full_aligner{ std::numeric_limits<size_t>::max() };
+
+		/// \brief An aligner that always uses the checkpointed sweep
+		const std_dyn_prog_aligner checkpointed_aligner{ 0 };
+
+		/// \brief Make a matrix of random small whole-number scores (so that there are plenty of ties)
+		static float_score_vec_vec make_random_scores(mt19937      &prm_rng,      ///< The random number generator
+		                                              const size_t &prm_length_a, ///< The number of rows
+		                                              const size_t &prm_length_b  ///< The number of columns
+		                                              ) {
+			uniform_int_distribution<int> score_dist{ 0, 3 };
+			float_score_vec_vec scores( prm_length_a, float_score_vec( prm_length_b ) );
+			for (float_score_vec &row : scores) {
+				for (float_score_type &score : row) {
+					score = static_cast<float_score_type>( score_dist( prm_rng ) );
+				}
+			}
+			return scores;
+		}
+
+		/// \brief Get the peak resident set size of this process so far, in kilobytes
+		static long peak_rss_kb() {
+			rusage usage{};
+			getrusage( RUSAGE_SELF, &usage );
+			return usage.ru_maxrss;
+		}
+	};
+
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE(std_dyn_prog_aligner_test_suite, std_dyn_prog_aligner_test_suite_fixture)
+
+BOOST_AUTO_TEST_CASE(checkpointed_matches_full_matrix) {
+	mt19937 rng{ 7 };
+	uniform_int_distribution<size_t> length_dist{ 1, 40 };
+	for (const size_t &rep_ctr : indices( 200_z ) ) {
+		const size_t length_a = ( rep_ctr < 3 ) ? 1 + rep_ctr : length_dist( rng );
+		const size_t length_b = ( rep_ctr < 3 ) ? 3 - rep_ctr : length_dist( rng );
+		const float_score_vec_vec              scores = make_random_scores( rng, length_a, length_b );
+		const new_matrix_dyn_prog_score_source scorer{ scores, length_a, length_b };
+		for (const gap_penalty &the_gap_penalty : { gap_penalty( 0, 0 ), gap_penalty( 1, 1 ), gap_penalty( 3, 1 ) } ) {
+			const score_alignment_pair full_result         = full_aligner.align        ( scorer, the_gap_penalty, length_a + length_b );
+			const score_alignment_pair checkpointed_result = checkpointed_aligner.align( scorer, the_gap_penalty, length_a + length_b );
+			BOOST_CHECK_EQUAL( checkpointed_result.first,  full_result.first  );
+			BOOST_CHECK_EQUAL( checkpointed_result.second, full_result.second );
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(in_full_band_matches_full_matrix) {
+	mt19937 rng{ 13 };
+	uniform_int_distribution<size_t> length_dist{ 1, 40 };
+	banded_score_matrix full_band;
+	for (const size_t &rep_ctr : indices( 100_z ) ) {
+		const size_t length_a = length_dist( rng );
+		const size_t length_b = ( rep_ctr < 3 ) ? 1 + rep_ctr : length_dist( rng );
+		const float_score_vec_vec              scores = make_random_scores( rng, length_a, length_b );
+		const new_matrix_dyn_prog_score_source scorer{ scores, length_a, length_b };
+		full_band.reset_to_full( length_a, length_b );
+		for (const gap_penalty &the_gap_penalty : { gap_penalty( 0, 0 ), gap_penalty( 1, 1 ), gap_penalty( 3, 1 ) } ) {
+			const score_alignment_pair full_result   = full_aligner.align        ( scorer, the_gap_penalty, length_a + length_b );
+			const score_alignment_pair banded_result = full_aligner.align_in_band( scorer, the_gap_penalty, full_band           );
+			BOOST_CHECK_EQUAL( banded_result.first,  full_result.first  );
+			BOOST_CHECK_EQUAL( banded_result.second, full_result.second );
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(in_band_only_aligns_pairs_within_band) {
+	mt19937 rng{ 17 };
+	const size_t length_a = 30;
+	const size_t length_b = 36;
+	const float_score_vec_vec              scores = make_random_scores( rng, length_a, length_b );
+	const new_matrix_dyn_prog_score_source scorer{ scores, length_a, length_b };
+
+	// Band around a path that jumps across columns part way down
+	size_size_pair_vec band_path;
+	for (const size_t &index_a : indices( length_a ) ) {
+		band_path.emplace_back( index_a, ( index_a < 15 ) ? index_a : index_a + 6 );
+	}
+	banded_score_matrix the_band;
+	the_band.reset_to_band( length_a, length_b, band_path, 2 );
+
+	const score_alignment_pair full_result   = full_aligner.align        ( scorer, gap_penalty( 1, 1 ), length_a + length_b );
+	const score_alignment_pair banded_result = full_aligner.align_in_band( scorer, gap_penalty( 1, 1 ), the_band            );
+	BOOST_CHECK_LE( banded_result.first, full_result.first );
+	for (const size_t &aln_ctr : indices( banded_result.second.length() ) ) {
+		if ( has_both_positions_of_index( banded_result.second, aln_ctr ) ) {
+			BOOST_TEST( is_in_band(
+				the_band,
+				get_a_position_of_index( banded_result.second, aln_ctr ),
+				get_b_position_of_index( banded_result.second, aln_ctr )
+			) );
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(default_uses_full_matrix_up_to_threshold) {
+	BOOST_CHECK_EQUAL( std_dyn_prog_aligner{}.get_full_matrix_max_cells(), std_dyn_prog_aligner::DEFAULT_FULL_MATRIX_MAX_CELLS );
+}
+
+/// \brief Report the time and the growth in peak RSS of aligning increasingly long sequences
+///
+/// The checkpointed alignments are all run before the full-matrix ones so that the full-matrix
+/// peaks don't mask those of the checkpointed alignments.
+///
+/// This is disabled by default; run it with `--run_test=std_dyn_prog_aligner_test_suite/benchmark_peak_rss_against_length`
+BOOST_AUTO_TEST_CASE(benchmark_peak_rss_against_length, * boost::unit_test::disabled()) {
+	mt19937 rng{ 11 };
+	for (const std_dyn_prog_aligner *aligner_ptr : { &checkpointed_aligner, &full_aligner } ) {
+		const bool is_checkpointed = ( aligner_ptr == &checkpointed_aligner );
+		for (const size_t &length : { 1'000_z, 2'000_z, 4'000_z } ) {
+			const float_score_vec_vec              scores = make_random_scores( rng, length, length );
+			const new_matrix_dyn_prog_score_source scorer{ scores, length, length };
+			const long rss_before = peak_rss_kb();
+			const auto start_time = high_resolution_clock::now();
+			const score_alignment_pair result = aligner_ptr->align( scorer, gap_penalty( 3, 1 ), length );
+			BOOST_TEST_MESSAGE(
+				( is_checkpointed ? "Checkpointed" : "Full matrix " )
+				<< " length " << length
+				<< " : " << durn_to_seconds_string( high_resolution_clock::now() - start_time )
+				<< ", peak RSS growth " << ( peak_rss_kb() - rss_before ) << "KB"
+			);
+			BOOST_CHECK_GT( result.second.length(), 0 );
+		}
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,723 @@
+/// \file
+/// \brief The striped_sequence_aligner class definitions
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "striped_sequence_aligner.hpp"
+
+#include <boost/numeric/conversion/cast.hpp>
+
+#include "cath/alignment/alignment.hpp"
+#include "cath/alignment/pair_alignment.hpp"
+#include "cath/common/boost_addenda/range/indices.hpp"
+#include "cath/common/exception/invalid_argument_exception.hpp"
+#include "cath/score/aligned_pair_score/substitution_matrix/substitution_matrix.hpp"
+#include "cath/structure/protein/amino_acid.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#if defined( __AVX2__ ) || defined( __SSE2__ )
+#include <immintrin.h>
+#endif
+
+using namespace ::cath;
+using namespace ::cath::align;
+using namespace ::cath::align::gap;
+using namespace ::cath::common;
+using namespace ::cath::score;
+
+using ::boost::numeric_cast;
+using ::std::array;
+using ::std::int16_t;
+using ::std::max;
+using ::std::min;
+using ::std::nullopt;
+using ::std::numeric_limits;
+using ::std::optional;
+using ::std::pair;
+using ::std::string;
+using ::std::string_view;
+using ::std::uint8_t;
+using ::std::vector;
+
+namespace {
+
+	/// \brief A score low enough to act as minus infinity in the scalar recurrence without risking overflow
+	constexpr score_type SCALAR_NEG_INF = numeric_limits<score_type>::min() / 4;
+
+	/// \brief The largest absolute letter score or gap penalty the striped algorithm will attempt with 16-bit lanes
+	constexpr score_type MAX_STRIPED_SCORE_MAGNITUDE = 1'000;
+
+	/// \brief The number of diagonals either side of the corner-to-corner diagonals to which align() first restricts its traceback pass
+	constexpr ptrdiff_t INITIAL_BAND_HALF_WIDTH = 16;
+
+	/// \brief Type alias for an inclusive range of diagonals (index_b - index_a) of the matrix
+	using diag_range = pair<ptrdiff_t, ptrdiff_t>;
+
+	/// \brief Bits of a traceback byte that record which option gave a cell's overall score
+	enum class trace_source : uint8_t {
+		DIAG = 0, ///< Aligning the two letters
+		E    = 1, ///< A gap in the first sequence (ie a letter of the second aligned against a gap)
+		F    = 2, ///< A gap in the second sequence (ie a letter of the first aligned against a gap)
+		ZERO = 3  ///< Starting afresh (only for sequence_alignment_mode::LOCAL)
+	};
+
+	/// \brief The mask for the trace_source within a traceback byte
+	constexpr uint8_t TRACE_SOURCE_MASK = 3;
+
+	/// \brief The bit of a traceback byte that's set if the cell's E value extends the E gap of the previous column
+	constexpr uint8_t TRACE_E_EXTENDS   = 4;
+
+	/// \brief The bit of a traceback byte that's set if the cell's F value extends the F gap of the previous row
+	constexpr uint8_t TRACE_F_EXTENDS   = 8;
+
+	/// \brief The score of the boundary cell at which a prefix of the specified length has been aligned entirely against gaps
+	score_type boundary_score(const size_t                  &prm_length,      ///< The length of the prefix
+	                          const gap_penalty             &prm_gap_penalty, ///< The gap penalty
+	                          const sequence_alignment_mode &prm_mode         ///< How the ends of the sequences are treated
+	                          ) {
+		if ( prm_mode != sequence_alignment_mode::GLOBAL || prm_length == 0 ) {
+			return 0;
+		}
+		return -(
+			prm_gap_penalty.get_open_gap_penalty()
+			+
+			numeric_cast<score_type>( prm_length - 1 ) * prm_gap_penalty.get_extend_gap_penalty()
+		);
+	}
+
+	/// \brief The diag_range that covers every cell of the matrix for sequences of the specified lengths
+	diag_range full_diag_range(const size_t &prm_length_a, ///< The length of the first  sequence
+	                           const size_t &prm_length_b  ///< The length of the second sequence
+	                           ) {
+		return { 1 - static_cast<ptrdiff_t>( prm_length_a ), static_cast<ptrdiff_t>( prm_length_b ) - 1 };
+	}
+
+	/// \brief Run the scalar Gotoh recurrence over the columns of the second sequence, calling a function with each cell's details
+	///
+	/// This defines the recurrence that the striped and traceback versions must match:
+	///  * E( i, j ) = max( H( i, j - 1 ) - open, E( i, j - 1 ) - extend )
+	///  * F( i, j ) = max( H( i - 1, j ) - open, F( i - 1, j ) - extend )
+	///  * H( i, j ) = max( H( i - 1, j - 1 ) + score( a_i, b_j ), E( i, j ), F( i, j ) [, 0 if local] )
+	///
+	/// ...with boundary H values from boundary_score(), boundary E and F values of minus infinity
+	/// and with the function called with ( index_a, index_b, H, trace_byte ).
+	///
+	/// Only the cells on the specified diagonals are calculated (and passed to the function): the others
+	/// are treated as minus infinity so the result is the best alignment that stays within those diagonals.
+	template <typename FN>
+	void run_scalar_recurrence(const striped_sequence_aligner &prm_aligner,  ///< The aligner defining the scores and the mode
+	                           const string                   &prm_string_a, ///< The first  sequence (which runs down the rows)
+	                           const string                   &prm_string_b, ///< The second sequence (which runs across the columns)
+	                           const diag_range               &prm_diags,    ///< The diagonals (index_b - index_a) of the cells to calculate
+	                           FN                            &&prm_fn        ///< The function to call with each cell's details
+	                           ) {
+		const gap_penalty             &the_gap_penalty = prm_aligner.get_gap_penalty();
+		const sequence_alignment_mode &mode            = prm_aligner.get_mode();
+		const score_type               open            = the_gap_penalty.get_open_gap_penalty();
+		const score_type               extend          = the_gap_penalty.get_extend_gap_penalty();
+		const size_t                   length_a        = prm_string_a.length();
+		const size_t                   length_b        = prm_string_b.length();
+
+		score_vec h_column( length_a );
+		score_vec e_column( length_a, SCALAR_NEG_INF );
+		for (const size_t &index_a : indices( length_a ) ) {
+			h_column[ index_a ] = boundary_score( index_a + 1, the_gap_penalty, mode );
+		}
+
+		for (const size_t &index_b : indices( length_b ) ) {
+			const auto      column  = static_cast<ptrdiff_t>( index_b );
+			const ptrdiff_t begin_a = max<ptrdiff_t>( 0,                                 column - prm_diags.second    );
+			const ptrdiff_t end_a   = min<ptrdiff_t>( static_cast<ptrdiff_t>( length_a ), column - prm_diags.first + 1 );
+
+			// The row that enters the band in this column has no calculated cell to its left
+			if ( column > 0 && column - prm_diags.first >= 0 && column - prm_diags.first < static_cast<ptrdiff_t>( length_a ) ) {
+				h_column[ static_cast<size_t>( column - prm_diags.first ) ] = SCALAR_NEG_INF;
+				e_column[ static_cast<size_t>( column - prm_diags.first ) ] = SCALAR_NEG_INF;
+			}
+
+			score_type diag      = ( begin_a == 0 ) ? boundary_score( index_b,     the_gap_penalty, mode )
+			                                        : h_column[ static_cast<size_t>( begin_a - 1 ) ];
+			score_type f         = ( begin_a == 0 ) ? boundary_score( index_b + 1, the_gap_penalty, mode ) - open
+			                                        : SCALAR_NEG_INF;
+			bool       f_extends = false;
+			for (auto index_a = static_cast<size_t>( begin_a ); static_cast<ptrdiff_t>( index_a ) < end_a; ++index_a) {
+				const bool       e_extends = ( e_column[ index_a ] - extend > h_column[ index_a ] - open );
+				const score_type e         = e_extends ? ( e_column[ index_a ] - extend ) : ( h_column[ index_a ] - open );
+				const score_type match     = diag + prm_aligner.get_letter_score( prm_string_a[ index_a ], prm_string_b[ index_b ] );
+
+				score_type   h      = match;
+				trace_source source = trace_source::DIAG;
+				if ( e > h ) {
+					h      = e;
+					source = trace_source::E;
+				}
+				if ( f > h ) {
+					h      = f;
+					source = trace_source::F;
+				}
+				if ( mode == sequence_alignment_mode::LOCAL && h <= 0 ) {
+					h      = 0;
+					source = trace_source::ZERO;
+				}
+
+				prm_fn(
+					index_a,
+					index_b,
+					h,
+					static_cast<uint8_t>(
+						static_cast<uint8_t>( source )
+						| ( e_extends ? TRACE_E_EXTENDS : uint8_t{ 0 } )
+						| ( f_extends ? TRACE_F_EXTENDS : uint8_t{ 0 } )
+					)
+				);
+
+				diag                = h_column[ index_a ];
+				h_column[ index_a ] = h;
+				e_column[ index_a ] = e;
+				f_extends           = ( f - extend > h - open );
+				f                   = f_extends ? ( f - extend ) : ( h - open );
+			}
+		}
+	}
+
+	/// \brief Whether the specified cell is one at which an alignment may end in the specified mode
+	bool is_candidate_end(const size_t                  &prm_index_a,  ///< The index in the first sequence
+	                      const size_t                  &prm_index_b,  ///< The index in the second sequence
+	                      const size_t                  &prm_length_a, ///< The length of the first sequence
+	                      const size_t                  &prm_length_b, ///< The length of the second sequence
+	                      const sequence_alignment_mode &prm_mode      ///< How the ends of the sequences are treated
+	                      ) {
+		switch ( prm_mode ) {
+			case ( sequence_alignment_mode::GLOBAL      ) : { return ( prm_index_a + 1 == prm_length_a && prm_index_b + 1 == prm_length_b ); }
+			case ( sequence_alignment_mode::SEMI_GLOBAL ) : { return ( prm_index_a + 1 == prm_length_a || prm_index_b + 1 == prm_length_b ); }
+			case ( sequence_alignment_mode::LOCAL       ) : { return true; }
+		}
+		return false;
+	}
+
+	/// \brief Align the two specified sequences, only using the cells on the specified diagonals,
+	///        and return the score and the alignment
+	///
+	/// For sequence_alignment_mode::LOCAL, the alignment only contains the aligned subsequences
+	/// (and is empty if no pair of letters has a positive score).
+	score_alignment_pair align_in_diags(const striped_sequence_aligner &prm_aligner,  ///< The aligner defining the scores and the mode
+	                                    const string                   &prm_string_a, ///< The first  sequence to align
+	                                    const string                   &prm_string_b, ///< The second sequence to align
+	                                    const diag_range               &prm_diags     ///< The diagonals (index_b - index_a) of the cells to use
+	                                    ) {
+		const size_t                   length_a = prm_string_a.length();
+		const size_t                   length_b = prm_string_b.length();
+		const sequence_alignment_mode &mode     = prm_aligner.get_mode();
+
+		// Populate the traceback bytes and find the best cell at which the alignment can end
+		const auto            rows_per_column = static_cast<size_t>( min<ptrdiff_t>(
+			static_cast<ptrdiff_t>( length_a ),
+			max<ptrdiff_t>( 0, prm_diags.second - prm_diags.first + 1 )
+		) );
+		const auto            trace_index     = [&] (const size_t &prm_index_a, const size_t &prm_index_b) {
+			const auto begin_a = static_cast<size_t>( max<ptrdiff_t>( 0, static_cast<ptrdiff_t>( prm_index_b ) - prm_diags.second ) );
+			return prm_index_b * rows_per_column + prm_index_a - begin_a;
+		};
+		vector<uint8_t>       trace( rows_per_column * length_b );
+		score_type            best = ( length_a == 0 || length_b == 0 ) ? boundary_score( max( length_a, length_b ), prm_aligner.get_gap_penalty(), mode )
+		                                                                : SCALAR_NEG_INF;
+		pair<size_t, size_t>  best_cell{ length_a, length_b };
+		run_scalar_recurrence( prm_aligner, prm_string_a, prm_string_b, prm_diags, [&] (const size_t &prm_index_a, const size_t &prm_index_b, const score_type &prm_h, const uint8_t &prm_trace) {
+			trace[ trace_index( prm_index_a, prm_index_b ) ] = prm_trace;
+			if ( is_candidate_end( prm_index_a, prm_index_b, length_a, length_b, mode ) && prm_h > best ) {
+				best      = prm_h;
+				best_cell = { prm_index_a, prm_index_b };
+			}
+		} );
+		const bool is_local   = ( mode == sequence_alignment_mode::LOCAL );
+		const bool has_start  = ( best_cell.first < length_a && ! ( is_local && best <= 0 ) );
+
+		// Trace back from the best cell, recording the (reversed) alignment as pairs of optional positions
+		vector<pair<aln_posn_opt, aln_posn_opt>> reversed_posns;
+		auto index_a = static_cast<ptrdiff_t>( has_start ? best_cell.first  : length_a - 1 );
+		auto index_b = static_cast<ptrdiff_t>( has_start ? best_cell.second : length_b - 1 );
+		if ( ! is_local ) {
+			for (auto trailing_b = static_cast<ptrdiff_t>( length_b ) - 1; trailing_b > index_b; --trailing_b) {
+				reversed_posns.emplace_back( nullopt, static_cast<aln_posn_type>( trailing_b ) );
+			}
+			for (auto trailing_a = static_cast<ptrdiff_t>( length_a ) - 1; trailing_a > index_a; --trailing_a) {
+				reversed_posns.emplace_back( static_cast<aln_posn_type>( trailing_a ), nullopt );
+			}
+		}
+		trace_source state = trace_source::DIAG;
+		while ( has_start && index_a >= 0 && index_b >= 0 ) {
+			const uint8_t trace_byte = trace[ trace_index( static_cast<size_t>( index_a ), static_cast<size_t>( index_b ) ) ];
+			if ( state == trace_source::E ) {
+				reversed_posns.emplace_back( nullopt, static_cast<aln_posn_type>( index_b ) );
+				state = ( ( trace_byte & TRACE_E_EXTENDS ) != 0 ) ? trace_source::E : trace_source::DIAG;
+				--index_b;
+				continue;
+			}
+			if ( state == trace_source::F ) {
+				reversed_posns.emplace_back( static_cast<aln_posn_type>( index_a ), nullopt );
+				state = ( ( trace_byte & TRACE_F_EXTENDS ) != 0 ) ? trace_source::F : trace_source::DIAG;
+				--index_a;
+				continue;
+			}
+			const auto source = static_cast<trace_source>( trace_byte & TRACE_SOURCE_MASK );
+			if ( source == trace_source::ZERO ) {
+				break;
+			}
+			if ( source == trace_source::DIAG ) {
+				reversed_posns.emplace_back( static_cast<aln_posn_type>( index_a ), static_cast<aln_posn_type>( index_b ) );
+				--index_a;
+				--index_b;
+			}
+			else {
+				state = source;
+			}
+		}
+		if ( ! is_local ) {
+			for (; index_a >= 0; --index_a) {
+				reversed_posns.emplace_back( static_cast<aln_posn_type>( index_a ), nullopt );
+			}
+			for (; index_b >= 0; --index_b) {
+				reversed_posns.emplace_back( nullopt, static_cast<aln_posn_type>( index_b ) );
+			}
+		}
+
+		// Build the alignment from the positions
+		alignment new_alignment( alignment::NUM_ENTRIES_IN_PAIR_ALIGNMENT );
+		new_alignment.reserve( reversed_posns.size() );
+		for (auto posns_itr = reversed_posns.crbegin(); posns_itr != reversed_posns.crend(); ++posns_itr) {
+			const aln_posn_opt &posn_a = posns_itr->first;
+			const aln_posn_opt &posn_b = posns_itr->second;
+			if ( posn_a && posn_b ) {
+				append_position_both( new_alignment, *posn_a, *posn_b );
+			}
+			else if ( posn_a ) {
+				append_position_a( new_alignment, *posn_a );
+			}
+			else {
+				append_position_b( new_alignment, *posn_b );
+			}
+		}
+		return { ( is_local && ! has_start ) ? 0 : best, new_alignment };
+	}
+
+#if defined( __AVX2__ ) || defined( __SSE2__ )
+
+	/// \brief The largest 16-bit lane value
+	constexpr int16_t LANE_MAX = numeric_limits<int16_t>::max();
+
+	/// \brief The smallest 16-bit lane value, which acts as minus infinity in the striped algorithm
+	constexpr int16_t LANE_MIN = numeric_limits<int16_t>::min();
+
+	/// \brief Convert a score to a 16-bit lane value, clamping to the lane's range
+	int16_t clamp_to_lane(const score_type &prm_score ///< The score to convert
+	                      ) {
+		return static_cast<int16_t>( ::std::clamp<score_type>( prm_score, LANE_MIN, LANE_MAX ) );
+	}
+
+#endif
+
+#if defined( __SSE2__ )
+
+	/// \brief The SSE2 operations on 8 lanes of signed 16-bit values used by striped_score()
+	struct sse2_int16_ops final {
+		/// \brief The vector type
+		using vec_type = __m128i;
+
+		/// \brief The number of lanes
+		static constexpr size_t NUM_LANES = 8;
+
+		static vec_type splat(const int16_t &x                  ) { return _mm_set1_epi16( x ); }
+		static vec_type load (const int16_t *x                  ) { return _mm_loadu_si128( reinterpret_cast<const __m128i *>( x ) ); }
+		static void     store(int16_t *x,     const vec_type &v ) { _mm_storeu_si128( reinterpret_cast<__m128i *>( x ), v ); }
+		static vec_type adds (const vec_type &a, const vec_type &b) { return _mm_adds_epi16( a, b ); }
+		static vec_type subs (const vec_type &a, const vec_type &b) { return _mm_subs_epi16( a, b ); }
+		static vec_type max  (const vec_type &a, const vec_type &b) { return _mm_max_epi16 ( a, b ); }
+		static vec_type min  (const vec_type &a, const vec_type &b) { return _mm_min_epi16 ( a, b ); }
+		static bool     any_gt(const vec_type &a, const vec_type &b) { return _mm_movemask_epi8( _mm_cmpgt_epi16( a, b ) ) != 0; }
+
+		/// \brief Shift each value up one lane, inserting the specified value into lane 0
+		static vec_type shift_in(const vec_type &v, const int16_t &x) {
+			return _mm_insert_epi16( _mm_slli_si128( v, 2 ), x, 0 );
+		}
+	};
+
+#endif
+
+#if defined( __AVX2__ )
+
+	/// \brief The AVX2 operations on 16 lanes of signed 16-bit values used by striped_score()
+	struct avx2_int16_ops final {
+		/// \brief The vector type
+		using vec_type = __m256i;
+
+		/// \brief The number of lanes
+		static constexpr size_t NUM_LANES = 16;
+
+		static vec_type splat(const int16_t &x                  ) { return _mm256_set1_epi16( x ); }
+		static vec_type load (const int16_t *x                  ) { return _mm256_loadu_si256( reinterpret_cast<const __m256i *>( x ) ); }
+		static void     store(int16_t *x,     const vec_type &v ) { _mm256_storeu_si256( reinterpret_cast<__m256i *>( x ), v ); }
+		static vec_type adds (const vec_type &a, const vec_type &b) { return _mm256_adds_epi16( a, b ); }
+		static vec_type subs (const vec_type &a, const vec_type &b) { return _mm256_subs_epi16( a, b ); }
+		static vec_type max  (const vec_type &a, const vec_type &b) { return _mm256_max_epi16 ( a, b ); }
+		static vec_type min  (const vec_type &a, const vec_type &b) { return _mm256_min_epi16 ( a, b ); }
+		static bool     any_gt(const vec_type &a, const vec_type &b) { return _mm256_movemask_epi8( _mm256_cmpgt_epi16( a, b ) ) != 0; }
+
+		/// \brief Shift each value up one lane (across the two 128-bit halves), inserting the specified value into lane 0
+		static vec_type shift_in(const vec_type &v, const int16_t &x) {
+			const vec_type low_half_in_high = _mm256_permute2x128_si256( v, v, 0x08 );
+			return _mm256_insert_epi16( _mm256_alignr_epi8( v, low_half_in_high, 14 ), x, 0 );
+		}
+	};
+
+	/// \brief The SIMD operations used by striped_sequence_aligner::score()
+	using simd_int16_ops = avx2_int16_ops;
+
+#elif defined( __SSE2__ )
+
+	/// \brief The SIMD operations used by striped_sequence_aligner::score()
+	using simd_int16_ops = sse2_int16_ops;
+
+#endif
+
+#if defined( __AVX2__ ) || defined( __SSE2__ )
+
+	/// \brief Score the alignment of two non-empty sequences with Farrar's striped algorithm
+	///
+	/// The first sequence is laid down the rows in NUM_LANES stripes of seg_len rows, so that each vector
+	/// holds rows { k, k + seg_len, k + 2 * seg_len, ... } of a column. The dependencies within a column that
+	/// cross from one stripe to the next are fixed up afterwards with the "lazy F" loop.
+	///
+	/// \returns The score or nullopt if the scores risk overflowing the 16-bit lanes
+	template <typename OPS>
+	optional<score_type> striped_score(const striped_sequence_aligner &prm_aligner,  ///< The aligner defining the scores and the mode
+	                                   const string                   &prm_string_a, ///< The first  sequence (which runs down the rows)
+	                                   const string                   &prm_string_b  ///< The second sequence (which runs across the columns)
+	                                   ) {
+		using vec_type = typename OPS::vec_type;
+		constexpr size_t NUM_LANES = OPS::NUM_LANES;
+
+		const gap_penalty             &the_gap_penalty = prm_aligner.get_gap_penalty();
+		const sequence_alignment_mode &mode            = prm_aligner.get_mode();
+		const score_type               open            = the_gap_penalty.get_open_gap_penalty();
+		const score_type               extend          = the_gap_penalty.get_extend_gap_penalty();
+		const size_t                   length_a        = prm_string_a.length();
+		const size_t                   length_b        = prm_string_b.length();
+		const size_t                   seg_len         = ( length_a + NUM_LANES - 1 ) / NUM_LANES;
+
+		// Give up if the scores are too large to leave sufficient headroom in the 16-bit lanes
+		const score_type headroom = 2 * ( prm_aligner.get_max_abs_letter_score() + abs( open ) + abs( extend ) );
+		if ( headroom > MAX_STRIPED_SCORE_MAGNITUDE || open < 0 || extend < 0 ) {
+			return nullopt;
+		}
+		if ( 2 * boundary_score( max( length_a, length_b ) + 1, the_gap_penalty, mode ) < LANE_MIN + 2 * headroom ) {
+			return nullopt;
+		}
+
+		// Each striped vector is stored as NUM_LANES consecutive values in a flat buffer
+		const auto load_seg  = [&] (const vector<int16_t> &prm_buffer, const size_t &prm_seg_ctr) {
+			return OPS::load( &prm_buffer[ prm_seg_ctr * NUM_LANES ] );
+		};
+		const auto store_seg = [&] (vector<int16_t> &prm_buffer, const size_t &prm_seg_ctr, const vec_type &prm_vec) {
+			OPS::store( &prm_buffer[ prm_seg_ctr * NUM_LANES ], prm_vec );
+		};
+
+		// Build the striped query profile of scores of each row's letter against each letter
+		vector<int16_t> profile( striped_sequence_aligner::NUM_LETTERS * seg_len * NUM_LANES );
+		array<int16_t, NUM_LANES> lane_values{};
+		for (const size_t &letter_ctr : indices( striped_sequence_aligner::NUM_LETTERS ) ) {
+			const char letter = static_cast<char>( 'A' + letter_ctr );
+			for (const size_t &seg_ctr : indices( seg_len ) ) {
+				for (const size_t &lane_ctr : indices( NUM_LANES ) ) {
+					const size_t index_a = lane_ctr * seg_len + seg_ctr;
+					profile[ ( letter_ctr * seg_len + seg_ctr ) * NUM_LANES + lane_ctr ] = ( index_a < length_a )
+						? static_cast<int16_t>( prm_aligner.get_letter_score( prm_string_a[ index_a ], letter ) )
+						: int16_t{ 0 };
+				}
+			}
+		}
+
+		// Initialise H and E from the boundary column
+		vector<int16_t> h_store( seg_len * NUM_LANES );
+		vector<int16_t> h_load ( seg_len * NUM_LANES );
+		vector<int16_t> e_store( seg_len * NUM_LANES );
+		for (const size_t &seg_ctr : indices( seg_len ) ) {
+			for (const size_t &lane_ctr : indices( NUM_LANES ) ) {
+				const score_type boundary = boundary_score( lane_ctr * seg_len + seg_ctr + 1, the_gap_penalty, mode );
+				h_store[ seg_ctr * NUM_LANES + lane_ctr ] = clamp_to_lane( boundary        );
+				e_store[ seg_ctr * NUM_LANES + lane_ctr ] = clamp_to_lane( boundary - open );
+			}
+		}
+
+		const vec_type v_open   = OPS::splat( clamp_to_lane( open   ) );
+		const vec_type v_extend = OPS::splat( clamp_to_lane( extend ) );
+		const vec_type v_zero   = OPS::splat( 0 );
+		const vec_type v_neg    = OPS::splat( LANE_MIN );
+		vec_type       v_max    = v_neg;
+		vec_type       v_min    = OPS::splat( LANE_MAX );
+
+		const size_t   last_seg_ctr  = ( length_a - 1 ) % seg_len;
+		const size_t   last_lane_ctr = ( length_a - 1 ) / seg_len;
+		score_type     best          = SCALAR_NEG_INF;
+
+		for (const size_t &index_b : indices( length_b ) ) {
+			const int16_t * const column_profile = &profile[ static_cast<size_t>( prm_string_b[ index_b ] - 'A' ) * seg_len * NUM_LANES ];
+
+			vec_type v_f = OPS::shift_in( v_neg,                  clamp_to_lane( boundary_score( index_b + 1, the_gap_penalty, mode ) - open ) );
+			vec_type v_h = OPS::shift_in( load_seg( h_store, seg_len - 1 ), clamp_to_lane( boundary_score( index_b,     the_gap_penalty, mode )        ) );
+			swap( h_load, h_store );
+
+			for (const size_t &seg_ctr : indices( seg_len ) ) {
+				const vec_type v_e = load_seg( e_store, seg_ctr );
+				v_h = OPS::adds( v_h, OPS::load( column_profile + seg_ctr * NUM_LANES ) );
+				v_h = OPS::max ( v_h, v_e );
+				v_h = OPS::max ( v_h, v_f );
+				if ( mode == sequence_alignment_mode::LOCAL ) {
+					v_h = OPS::max( v_h, v_zero );
+				}
+				v_max = OPS::max( v_max, v_h );
+				v_min = OPS::min( v_min, v_h );
+				store_seg( h_store, seg_ctr, v_h );
+
+				const vec_type v_h_open = OPS::subs( v_h, v_open );
+				store_seg( e_store, seg_ctr, OPS::max( OPS::subs( v_e, v_extend ), v_h_open ) );
+				v_f = OPS::max( OPS::subs( v_f, v_extend ), v_h_open );
+				v_h = load_seg( h_load, seg_ctr );
+			}
+
+			// Lazy F: propagate F values from the end of each stripe into the start of the next
+			// until they can no longer affect any H values
+			bool finished = false;
+			for (size_t pass_ctr = 0; pass_ctr < NUM_LANES && ! finished; ++pass_ctr) {
+				v_f = OPS::shift_in( v_f, LANE_MIN );
+				for (const size_t &seg_ctr : indices( seg_len ) ) {
+					const vec_type v_h_pre  = load_seg( h_store, seg_ctr );
+					const vec_type v_f_next = OPS::subs( v_f, v_extend );
+					if ( ! OPS::any_gt( v_f, v_h_pre ) && ! OPS::any_gt( v_f_next, OPS::subs( v_h_pre, v_open ) ) ) {
+						finished = true;
+						break;
+					}
+					const vec_type v_h_new = OPS::max( v_h_pre, v_f );
+					v_max = OPS::max( v_max, v_h_new );
+					v_min = OPS::min( v_min, v_h_new );
+					store_seg( h_store, seg_ctr, v_h_new );
+					store_seg( e_store, seg_ctr, OPS::max( load_seg( e_store, seg_ctr ), OPS::subs( v_h_new, v_open ) ) );
+					v_f = v_f_next;
+				}
+			}
+
+			// If the alignment can end on the last row, consider this column's cell on that row
+			if ( mode == sequence_alignment_mode::SEMI_GLOBAL || ( mode == sequence_alignment_mode::GLOBAL && index_b + 1 == length_b ) ) {
+				best = max<score_type>( best, h_store[ last_seg_ctr * NUM_LANES + last_lane_ctr ] );
+			}
+		}
+
+		// If semi-global, also consider all cells of the last column
+		if ( mode == sequence_alignment_mode::SEMI_GLOBAL ) {
+			for (const size_t &index_a : indices( length_a ) ) {
+				best = max<score_type>( best, h_store[ ( index_a % seg_len ) * NUM_LANES + index_a / seg_len ] );
+			}
+		}
+
+		// Check that no H value came close enough to the lanes' limits to risk having saturated
+		OPS::store( lane_values.data(), v_max );
+		const score_type max_h = *::std::max_element( lane_values.begin(), lane_values.end() );
+		OPS::store( lane_values.data(), v_min );
+		const score_type min_h = *::std::min_element( lane_values.begin(), lane_values.end() );
+		if ( max_h > LANE_MAX - headroom || min_h < LANE_MIN + headroom ) {
+			return nullopt;
+		}
+
+		return ( mode == sequence_alignment_mode::LOCAL ) ? max_h : best;
+	}
+
+#endif
+
+} // namespace
+
+/// \brief Get the index of the specified letter in the letter_scores, throwing if it isn't an upper-case letter
+size_t striped_sequence_aligner::index_of_letter(const char &prm_letter ///< The letter to index
+                                                 ) {
+	if ( prm_letter < 'A' || prm_letter > 'Z' ) {
+		BOOST_THROW_EXCEPTION(invalid_argument_exception(
+			"Unable to align a sequence containing the character '" + string( 1, prm_letter ) + "' (only upper-case letters are supported)"
+		));
+	}
+	return static_cast<size_t>( prm_letter - 'A' );
+}
+
+/// \brief Ctor from the scores of each pair of letters, the gap penalty and the mode
+striped_sequence_aligner::striped_sequence_aligner(score_vec                      prm_letter_scores, ///< The score for each pair of letters, indexed by ( letter_a - 'A' ) * NUM_LETTERS + ( letter_b - 'A' )
+                                                   const gap_penalty             &prm_gap_penalty,   ///< The gap penalty
+                                                   const sequence_alignment_mode &prm_mode           ///< How the ends of the sequences are treated
+                                                   ) : letter_scores   { std::move( prm_letter_scores ) },
+                                                       the_gap_penalty { prm_gap_penalty                },
+                                                       mode            { prm_mode                       } {
+	if ( letter_scores.size() != NUM_LETTERS * NUM_LETTERS ) {
+		BOOST_THROW_EXCEPTION(invalid_argument_exception("A striped_sequence_aligner requires a score for each pair of upper-case letters"));
+	}
+}
+
+/// \brief Getter for the gap penalty
+const gap_penalty & striped_sequence_aligner::get_gap_penalty() const {
+	return the_gap_penalty;
+}
+
+/// \brief Getter for how the ends of the sequences are treated
+const sequence_alignment_mode & striped_sequence_aligner::get_mode() const {
+	return mode;
+}
+
+/// \brief Get the score for aligning the specified pair of letters
+score_type striped_sequence_aligner::get_letter_score(const char &prm_letter_a, ///< The letter from the first sequence
+                                                      const char &prm_letter_b  ///< The letter from the second sequence
+                                                      ) const {
+	return letter_scores[ index_of_letter( prm_letter_a ) * NUM_LETTERS + index_of_letter( prm_letter_b ) ];
+}
+
+/// \brief Get the largest absolute score for any pair of letters
+score_type striped_sequence_aligner::get_max_abs_letter_score() const {
+	score_type max_abs_score = 0;
+	for (const score_type &letter_score : letter_scores) {
+		max_abs_score = max( max_abs_score, abs( letter_score ) );
+	}
+	return max_abs_score;
+}
+
+/// \brief Score the optimal alignment of the two specified sequences
+///
+/// This uses the striped SIMD algorithm where possible and scalar_score() otherwise
+score_type striped_sequence_aligner::score(const string &prm_string_a, ///< The first  sequence to align
+                                           const string &prm_string_b  ///< The second sequence to align
+                                           ) const {
+	for (const string * const string_ptr : { &prm_string_a, &prm_string_b } ) {
+		for (const char &letter : *string_ptr) {
+			index_of_letter( letter );
+		}
+	}
+	if ( prm_string_a.empty() || prm_string_b.empty() ) {
+		return scalar_score( prm_string_a, prm_string_b );
+	}
+#if defined( __AVX2__ ) || defined( __SSE2__ )
+	const optional<score_type> striped_result = striped_score<simd_int16_ops>( *this, prm_string_a, prm_string_b );
+	if ( striped_result ) {
+		return *striped_result;
+	}
+#endif
+	return scalar_score( prm_string_a, prm_string_b );
+}
+
+/// \brief Score the optimal alignment of the two specified sequences with the scalar recurrence
+score_type striped_sequence_aligner::scalar_score(const string &prm_string_a, ///< The first  sequence to align
+                                                  const string &prm_string_b  ///< The second sequence to align
+                                                  ) const {
+	const size_t length_a = prm_string_a.length();
+	const size_t length_b = prm_string_b.length();
+	if ( length_a == 0 || length_b == 0 ) {
+		return boundary_score( max( length_a, length_b ), the_gap_penalty, mode );
+	}
+	score_type best = SCALAR_NEG_INF;
+	run_scalar_recurrence( *this, prm_string_a, prm_string_b, full_diag_range( length_a, length_b ), [&] (const size_t &prm_index_a, const size_t &prm_index_b, const score_type &prm_h, const uint8_t &) {
+		if ( is_candidate_end( prm_index_a, prm_index_b, length_a, length_b, mode ) ) {
+			best = max( best, prm_h );
+		}
+	} );
+	return best;
+}
+
+/// \brief Align the two specified sequences and return the score and the alignment
+///
+/// This uses score() to find the optimal score and then runs the scalar traceback pass only over
+/// a band of diagonals around the corner-to-corner diagonals, doubling the band's width until
+/// the band's best alignment achieves that optimal score (or the band covers the whole matrix).
+/// So similar sequences only need a traceback over a narrow band.
+///
+/// For sequence_alignment_mode::LOCAL, the alignment only contains the aligned subsequences
+/// (and is empty if no pair of letters has a positive score).
+score_alignment_pair striped_sequence_aligner::align(const string &prm_string_a, ///< The first  sequence to align
+                                                     const string &prm_string_b  ///< The second sequence to align
+                                                     ) const {
+	const score_type optimal_score = score( prm_string_a, prm_string_b );
+	const diag_range all_diags     = full_diag_range( prm_string_a.length(), prm_string_b.length() );
+	const ptrdiff_t  length_diff   = static_cast<ptrdiff_t>( prm_string_b.length() ) - static_cast<ptrdiff_t>( prm_string_a.length() );
+	for (ptrdiff_t half_width = INITIAL_BAND_HALF_WIDTH; ; half_width *= 2) {
+		const diag_range band_diags{
+			max( all_diags.first,  min<ptrdiff_t>( 0, length_diff ) - half_width ),
+			min( all_diags.second, max<ptrdiff_t>( 0, length_diff ) + half_width )
+		};
+		score_alignment_pair score_and_alignment = align_in_diags( *this, prm_string_a, prm_string_b, band_diags );
+		if ( score_and_alignment.first == optimal_score || band_diags == all_diags ) {
+			return score_and_alignment;
+		}
+	}
+}
+
+/// \brief Make a striped_sequence_aligner that scores 1 for identical letters and 0 otherwise
+///
+/// With sequence_alignment_mode::SEMI_GLOBAL, this matches the scoring of get_score_of_aligned_sequence_strings()
+///
+/// \relates striped_sequence_aligner
+striped_sequence_aligner cath::align::make_identity_striped_sequence_aligner(const gap_penalty             &prm_gap_penalty, ///< The gap penalty
+                                                                             const sequence_alignment_mode &prm_mode         ///< How the ends of the sequences are treated
+                                                                             ) {
+	constexpr size_t NUM_LETTERS = striped_sequence_aligner::NUM_LETTERS;
+	score_vec letter_scores( NUM_LETTERS * NUM_LETTERS, 0 );
+	for (const size_t &letter_ctr : indices( NUM_LETTERS ) ) {
+		letter_scores[ letter_ctr * NUM_LETTERS + letter_ctr ] = 1;
+	}
+	return { letter_scores, prm_gap_penalty, prm_mode };
+}
+
+/// \brief Make a striped_sequence_aligner that scores pairs of amino acid letters with the specified substitution_matrix
+///
+/// \relates striped_sequence_aligner
+striped_sequence_aligner cath::align::make_striped_sequence_aligner(const substitution_matrix     &prm_substitution_matrix, ///< The substitution_matrix with which to score pairs of letters
+                                                                    const gap_penalty             &prm_gap_penalty,         ///< The gap penalty
+                                                                    const sequence_alignment_mode &prm_mode                 ///< How the ends of the sequences are treated
+                                                                    ) {
+	constexpr size_t NUM_LETTERS = striped_sequence_aligner::NUM_LETTERS;
+	score_vec letter_scores( NUM_LETTERS * NUM_LETTERS, 0 );
+	for (const size_t &letter_ctr_a : indices( NUM_LETTERS ) ) {
+		for (const size_t &letter_ctr_b : indices( NUM_LETTERS ) ) {
+			letter_scores[ letter_ctr_a * NUM_LETTERS + letter_ctr_b ] = prm_substitution_matrix.get_score(
+				amino_acid{ static_cast<char>( 'A' + letter_ctr_a ) },
+				amino_acid{ static_cast<char>( 'A' + letter_ctr_b ) }
+			);
+		}
+	}
+	return { letter_scores, prm_gap_penalty, prm_mode };
+}
+
+/// \brief Get the name of the SIMD instruction set used by striped_sequence_aligner::score() in this build
+///        ("AVX2", "SSE2" or "none")
+string_view cath::align::striped_simd_instruction_set() {
+#if defined( __AVX2__ )
+	return "AVX2";
+#elif defined( __SSE2__ )
+	return "SSE2";
+#else
+	return "none";
+#endif
+}
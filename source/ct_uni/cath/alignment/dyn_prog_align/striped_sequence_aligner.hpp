@@ -0,0 +1,102 @@
+/// \file
+/// \brief The striped_sequence_aligner class header
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef CATH_TOOLS_SOURCE_CT_UNI_CATH_ALIGNMENT_DYN_PROG_ALIGN_STRIPED_SEQUENCE_ALIGNER_HPP
+#define CATH_TOOLS_SOURCE_CT_UNI_CATH_ALIGNMENT_DYN_PROG_ALIGN_STRIPED_SEQUENCE_ALIGNER_HPP
+
+#include "cath/alignment/align_type_aliases.hpp"
+#include "cath/alignment/gap/gap_penalty.hpp"
+#include "cath/common/type_aliases.hpp"
+
+#include <string>
+#include <string_view>
+
+// clang-format off
+namespace cath::score { class substitution_matrix; }
+// clang-format on
+
+namespace cath::align {
+
+	/// \brief How a striped_sequence_aligner treats the ends of the sequences
+	enum class sequence_alignment_mode : char {
+		GLOBAL,      ///< Align the whole of both sequences, penalising gaps at the ends
+		SEMI_GLOBAL, ///< Align the whole of both sequences without penalising gaps at the ends
+		LOCAL        ///< Align the best-scoring pair of subsequences
+	};
+
+	/// \brief Align pairs of sequences of upper-case letters with affine gaps and a substitution score
+	///        for each pair of letters
+	///
+	/// score() uses Farrar's striped SIMD algorithm with 16-bit lanes (AVX2 if compiled with it, else SSE2)
+	/// and falls back on scalar_score() if neither is available or if the scores risk overflowing 16 bits.
+	///
+	/// align() uses score() for the optimal score and then performs a scalar Gotoh traceback pass
+	/// over a band of diagonals, widening the band until it contains an alignment with that score.
+	/// It uses the same recurrence as score() so the scores match.
+	///
+	/// A gap of length n costs open + ( n - 1 ) * extend.
+	class striped_sequence_aligner final {
+	public:
+		/// \brief The number of letters for which scores are stored ('A' to 'Z')
+		static constexpr size_t NUM_LETTERS = 26;
+
+	private:
+		/// \brief The score for each pair of letters, indexed by ( letter_a - 'A' ) * NUM_LETTERS + ( letter_b - 'A' )
+		score_vec letter_scores;
+
+		/// \brief The gap penalty
+		gap::gap_penalty the_gap_penalty;
+
+		/// \brief How the ends of the sequences are treated
+		sequence_alignment_mode mode;
+
+		static size_t index_of_letter(const char &);
+
+	public:
+		striped_sequence_aligner(score_vec,
+		                         const gap::gap_penalty &,
+		                         const sequence_alignment_mode &);
+
+		[[nodiscard]] const gap::gap_penalty &        get_gap_penalty() const;
+		[[nodiscard]] const sequence_alignment_mode & get_mode() const;
+		[[nodiscard]] score_type                      get_letter_score(const char &,
+		                                                               const char &) const;
+		[[nodiscard]] score_type                      get_max_abs_letter_score() const;
+
+		[[nodiscard]] score_type           score(const std::string &,
+		                                         const std::string &) const;
+		[[nodiscard]] score_type           scalar_score(const std::string &,
+		                                                const std::string &) const;
+		[[nodiscard]] score_alignment_pair align(const std::string &,
+		                                         const std::string &) const;
+	};
+
+	striped_sequence_aligner make_identity_striped_sequence_aligner(const gap::gap_penalty &,
+	                                                                const sequence_alignment_mode & = sequence_alignment_mode::SEMI_GLOBAL);
+
+	striped_sequence_aligner make_striped_sequence_aligner(const score::substitution_matrix &,
+	                                                       const gap::gap_penalty &,
+	                                                       const sequence_alignment_mode & = sequence_alignment_mode::LOCAL);
+
+	::std::string_view striped_simd_instruction_set();
+
+} // namespace cath::align
+
+#endif // CATH_TOOLS_SOURCE_CT_UNI_CATH_ALIGNMENT_DYN_PROG_ALIGN_STRIPED_SEQUENCE_ALIGNER_HPP
@@ -0,0 +1,255 @@
+/// \file
+/// \brief The striped_sequence_aligner test suite
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "striped_sequence_aligner.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include "cath/alignment/alignment.hpp"
+#include "cath/alignment/dyn_prog_align/detail/string_aligner/striped_string_aligner.hpp"
+#include "cath/alignment/gap/gap_penalty.hpp"
+#include "cath/alignment/pair_alignment.hpp"
+#include "cath/common/boost_addenda/range/indices.hpp"
+#include "cath/common/chrono/duration_to_seconds_string.hpp"
+#include "cath/common/exception/invalid_argument_exception.hpp"
+#include "cath/common/size_t_literal.hpp"
+#include "cath/score/aligned_pair_score/substitution_matrix/blosum62_substitution_matrix.hpp"
+#include "cath/score/aligned_pair_score/substitution_matrix/substitution_matrix.hpp"
+#include "cath/structure/protein/amino_acid.hpp"
+
+#include <array>
+#include <chrono>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace ::cath;
+using namespace ::cath::align;
+using namespace ::cath::align::detail;
+using namespace ::cath::align::gap;
+using namespace ::cath::common;
+using namespace ::cath::score;
+
+using ::std::chrono::high_resolution_clock;
+using ::std::get;
+using ::std::mt19937;
+using ::std::string;
+using ::std::uniform_int_distribution;
+
+namespace {
+
+	/// \brief The striped_sequence_aligner_test_suite_fixture to assist in testing striped_sequence_aligner
+	struct striped_sequence_aligner_test_suite_fixture {
+	protected:
+		~striped_sequence_aligner_test_suite_fixture() noexcept = default;
+
+		/// \brief The modes to test
+		static constexpr std::array<sequence_alignment_mode, 3> MODES{
+			sequence_alignment_mode::GLOBAL,
+			sequence_alignment_mode::SEMI_GLOBAL,
+			sequence_alignment_mode::LOCAL
+		};
+
+		/// \brief A spread of gap penalties, including ones with no extend penalty and ones with equal open/extend penalties
+		const std::vector<gap_penalty> gap_penalties{ { 0, 0 }, { 1, 1 }, { 3, 1 }, { 5, 0 }, { 11, 1 } };
+
+		/// \brief Make a random sequence of the specified length from the first prm_alphabet_size upper-case letters
+		static string make_random_sequence(mt19937      &prm_rng,          ///< The random number generator
+		                                   const size_t &prm_length,       ///< The length of the sequence
+		                                   const int    &prm_alphabet_size ///< The number of distinct letters to use
+		                                   ) {
+			uniform_int_distribution<int> letter_dist{ 0, prm_alphabet_size - 1 };
+			string sequence( prm_length, 'A' );
+			for (char &letter : sequence) {
+				letter = static_cast<char>( 'A' + letter_dist( prm_rng ) );
+			}
+			return sequence;
+		}
+
+		/// \brief Independently recalculate the score of the specified alignment under the specified aligner's scheme
+		///
+		/// Gaps before the first or after the last letter of a sequence are only penalised for sequence_alignment_mode::GLOBAL
+		static score_type rescore_alignment(const striped_sequence_aligner &prm_aligner,   ///< The aligner defining the scoring scheme
+		                                    const alignment                &prm_alignment, ///< The alignment to score
+		                                    const string                   &prm_string_a,  ///< The first  sequence
+		                                    const string                   &prm_string_b   ///< The second sequence
+		                                    ) {
+			const bool   penalise_ends = ( prm_aligner.get_mode() == sequence_alignment_mode::GLOBAL );
+			const size_t length        = prm_alignment.length();
+			score_type   score         = 0;
+			for (const size_t &entry : { 0_z, 1_z } ) {
+				size_opt first_index;
+				size_opt last_index;
+				for (const size_t &index : indices( length ) ) {
+					if ( prm_alignment.position_of_entry_of_index( entry, index ) ) {
+						first_index = first_index.value_or( index );
+						last_index  = index;
+					}
+				}
+				bool in_gap = false;
+				for (const size_t &index : indices( length ) ) {
+					if ( prm_alignment.position_of_entry_of_index( entry, index ) ) {
+						in_gap = false;
+						continue;
+					}
+					const bool is_end_gap = ( ! first_index || index < *first_index || index > *last_index );
+					if ( is_end_gap && ! penalise_ends ) {
+						continue;
+					}
+					score -= in_gap ? prm_aligner.get_gap_penalty().get_extend_gap_penalty()
+					                : prm_aligner.get_gap_penalty().get_open_gap_penalty();
+					in_gap = true;
+				}
+			}
+			for (const size_t &index : indices( length ) ) {
+				if ( has_both_positions_of_index( prm_alignment, index ) ) {
+					score += prm_aligner.get_letter_score(
+						prm_string_a[ get_a_position_of_index( prm_alignment, index ) ],
+						prm_string_b[ get_b_position_of_index( prm_alignment, index ) ]
+					);
+				}
+			}
+			return score;
+		}
+	};
+
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE(striped_sequence_aligner_test_suite, striped_sequence_aligner_test_suite_fixture)
+
+BOOST_AUTO_TEST_CASE(scores_simple_examples) {
+	BOOST_CHECK_EQUAL( make_identity_striped_sequence_aligner( { 2, 1 }, sequence_alignment_mode::SEMI_GLOBAL ).score( "ABCDE", "BCD"   ),  3 );
+	BOOST_CHECK_EQUAL( make_identity_striped_sequence_aligner( { 2, 1 }, sequence_alignment_mode::GLOBAL      ).score( "ABCDE", "BCD"   ), -1 );
+	BOOST_CHECK_EQUAL( make_identity_striped_sequence_aligner( { 2, 1 }, sequence_alignment_mode::GLOBAL      ).score( "ABCDE", ""      ), -6 );
+	BOOST_CHECK_EQUAL( make_identity_striped_sequence_aligner( { 2, 1 }, sequence_alignment_mode::SEMI_GLOBAL ).score( "",      "BCD"   ),  0 );
+	BOOST_CHECK_EQUAL( make_striped_sequence_aligner( make_subs_matrix_blosum62(), { 11, 1 } ).score( "AAWAA", "CCWCC" ), 11 );
+}
+
+BOOST_AUTO_TEST_CASE(throws_on_non_upper_case_letters) {
+	BOOST_CHECK_THROW( static_cast<void>( make_identity_striped_sequence_aligner( { 1, 1 } ).score( "ABc", "ABC" ) ), invalid_argument_exception );
+	BOOST_CHECK_THROW( static_cast<void>( make_identity_striped_sequence_aligner( { 1, 1 } ).align( "ABC", "A-C" ) ), invalid_argument_exception );
+}
+
+BOOST_AUTO_TEST_CASE(striped_scores_match_scalar_scores) {
+	mt19937 rng{ 5 };
+	uniform_int_distribution<size_t> length_dist{ 1, 70 };
+	const substitution_matrix blosum62 = make_subs_matrix_blosum62();
+	for (const size_t &rep_ctr : indices( 60_z ) ) {
+		const string string_a = make_random_sequence( rng, length_dist( rng ), ( rep_ctr % 2 == 0 ) ? 4 : 20 );
+		const string string_b = make_random_sequence( rng, length_dist( rng ), ( rep_ctr % 2 == 0 ) ? 4 : 20 );
+		for (const sequence_alignment_mode &mode : MODES) {
+			for (const gap_penalty &the_gap_penalty : gap_penalties) {
+				for (const striped_sequence_aligner &aligner : { make_identity_striped_sequence_aligner( the_gap_penalty, mode           ),
+				                                                 make_striped_sequence_aligner         ( blosum62, the_gap_penalty, mode ) } ) {
+					BOOST_CHECK_EQUAL( aligner.score( string_a, string_b ), aligner.scalar_score( string_a, string_b ) );
+				}
+			}
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(aligns_with_the_optimal_score) {
+	mt19937 rng{ 9 };
+	uniform_int_distribution<size_t> length_dist{ 0, 30 };
+	const substitution_matrix blosum62 = make_subs_matrix_blosum62();
+	for ([[maybe_unused]] const size_t &rep_ctr : indices( 40_z ) ) {
+		const string string_a = make_random_sequence( rng, length_dist( rng ), 20 );
+		const string string_b = make_random_sequence( rng, length_dist( rng ), 20 );
+		for (const sequence_alignment_mode &mode : MODES) {
+			for (const gap_penalty &the_gap_penalty : gap_penalties) {
+				const striped_sequence_aligner aligner = make_striped_sequence_aligner( blosum62, the_gap_penalty, mode );
+				const score_alignment_pair     result  = aligner.align( string_a, string_b );
+				BOOST_CHECK_EQUAL( result.first, aligner.scalar_score( string_a, string_b ) );
+				BOOST_CHECK_EQUAL( result.first, rescore_alignment( aligner, result.second, string_a, string_b ) );
+			}
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(aligns_with_the_optimal_score_when_the_path_is_far_off_the_diagonal) {
+	mt19937 rng{ 11 };
+	uniform_int_distribution<size_t> length_dist{ 40, 120 };
+	const substitution_matrix blosum62 = make_subs_matrix_blosum62();
+	for ([[maybe_unused]] const size_t &rep_ctr : indices( 10_z ) ) {
+		// Share a motif between the two equal-length sequences but put it at opposite ends
+		const string motif    = make_random_sequence( rng, length_dist( rng ), 20 );
+		const size_t shift    = length_dist( rng );
+		const string string_a = motif + make_random_sequence( rng, shift, 20 );
+		const string string_b = make_random_sequence( rng, shift, 20 ) + motif;
+		for (const sequence_alignment_mode &mode : MODES) {
+			const striped_sequence_aligner aligner = make_striped_sequence_aligner( blosum62, { 11, 1 }, mode );
+			const score_alignment_pair     result  = aligner.align( string_a, string_b );
+			BOOST_CHECK_EQUAL( result.first, aligner.scalar_score( string_a, string_b ) );
+			BOOST_CHECK_EQUAL( result.first, rescore_alignment( aligner, result.second, string_a, string_b ) );
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(striped_string_aligner_scores_match_semi_global_identity_scores) {
+	mt19937 rng{ 3 };
+	uniform_int_distribution<size_t> length_dist{ 1, 40 };
+	const striped_string_aligner the_string_aligner{};
+	for ([[maybe_unused]] const size_t &rep_ctr : indices( 40_z ) ) {
+		const string string_a = make_random_sequence( rng, length_dist( rng ), 5 );
+		const string string_b = make_random_sequence( rng, length_dist( rng ), 5 );
+		for (const gap_penalty &the_gap_penalty : gap_penalties) {
+			BOOST_CHECK_EQUAL(
+				get<2>( the_string_aligner.align( string_a, string_b, the_gap_penalty ) ),
+				make_identity_striped_sequence_aligner( the_gap_penalty ).score( string_a, string_b )
+			);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(falls_back_to_scalar_for_scores_too_large_for_the_lanes) {
+	score_vec letter_scores( striped_sequence_aligner::NUM_LETTERS * striped_sequence_aligner::NUM_LETTERS, -5'000 );
+	for (const size_t &letter_ctr : indices( striped_sequence_aligner::NUM_LETTERS ) ) {
+		letter_scores[ letter_ctr * striped_sequence_aligner::NUM_LETTERS + letter_ctr ] = 5'000;
+	}
+	const striped_sequence_aligner aligner{ letter_scores, { 7'000, 100 }, sequence_alignment_mode::GLOBAL };
+	const string string_a( 30, 'A' );
+	const string string_b = string_a + "CCCCCCCCCC";
+	BOOST_CHECK_EQUAL( aligner.score( string_a, string_b ), 30 * 5'000 - 7'000 - 9 * 100 );
+}
+
+/// \brief Report the time of the striped and scalar scoring of a pair of long sequences
+///
+/// This is disabled by default; run it with `--run_test=striped_sequence_aligner_test_suite/benchmark_striped_against_scalar`
+BOOST_AUTO_TEST_CASE(benchmark_striped_against_scalar, * boost::unit_test::disabled()) {
+	mt19937 rng{ 13 };
+	const string string_a = make_random_sequence( rng, 3'000, 20 );
+	const string string_b = make_random_sequence( rng, 3'000, 20 );
+	const striped_sequence_aligner aligner = make_striped_sequence_aligner( make_subs_matrix_blosum62(), { 11, 1 } );
+
+	const auto striped_start = high_resolution_clock::now();
+	const score_type striped_score = aligner.score( string_a, string_b );
+	const auto scalar_start  = high_resolution_clock::now();
+	const score_type scalar_score  = aligner.scalar_score( string_a, string_b );
+	const auto scalar_stop   = high_resolution_clock::now();
+
+	BOOST_TEST_MESSAGE(
+		"Striped (" << striped_simd_instruction_set() << ") : " << durn_to_seconds_string( scalar_start - striped_start )
+		<< ", scalar : " << durn_to_seconds_string( scalar_stop - scalar_start )
+	);
+	BOOST_CHECK_EQUAL( striped_score, scalar_score );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -66,6 +66,7 @@ void alignment_input_options_block::do_add_visible_options_to_description(option
 	const string dir_varname      { "<dir>"  };
 	const string file_varname     { "<file>" };
 	const string refining_varname { "<refn>" };
+	const string threads_varname  { "<threads>" };
 
 	const auto residue_name_align_notifier   = [&] (const bool           &x) { the_alignment_input_spec.set_residue_name_align  ( x ); };
 	const auto fasta_alignment_file_notifier = [&] (const path           &x) { the_alignment_input_spec.set_fasta_alignment_file( x ); };
@@ -75,6 +76,8 @@ void alignment_input_options_block::do_add_visible_options_to_description(option
 	const auto do_the_ssaps_notifier         = [&] (const path           &x) {
 		the_alignment_input_spec.set_do_the_ssaps_dir( make_optional_if( x != path{}, x ) );
 	};
+	const auto progressive_ssaps_notifier    = [&] (const bool           &x) { the_alignment_input_spec.set_progressive_ssaps   ( x ); };
+	const auto num_ssap_threads_notifier     = [&] (const size_t         &x) { the_alignment_input_spec.set_num_ssap_threads    ( x ); };
 	const auto refining_notifier             = [&] (const align_refining &x) { the_alignment_input_spec.set_refining            ( x ); };
 
 	prm_desc.add_options()
@@ -120,10 +123,33 @@ void alignment_input_options_block::do_add_visible_options_to_description(option
 				->notifier      ( do_the_ssaps_notifier         )
 				->implicit_value( path{}                        ),
 			::fmt::format(
-				"Do the required SSAPs in directory {}; use results as with --{}\nUse a suitable temp directory if none is specified",
+				"Do the required SSAPs (in parallel) and use results as with --{1}\nCache the SSAPs' results in directory {0} (or just keep them in memory if none is specified)"
+				"\n(without {0}, nothing is written to disk and no SSAP results are reused between runs)",
 				dir_varname,
 				PO_SSAP_SCORE_INFILE
 			).c_str()
+		)
+		(
+			string( PO_PROGRESSIVE_SSAPS ).c_str(),
+			bool_switch()
+				->notifier      ( progressive_ssaps_notifier                      )
+				->default_value ( alignment_input_spec::DEFAULT_PROGRESSIVE_SSAPS ),
+			::fmt::format(
+				"When doing the SSAPs, only do the N-1 in a spanning tree chosen from quick secondary-structure comparisons\n(rather than all N(N-1)/2 pairs; applies to --{} and to the default of doing the SSAPs)",
+				PO_DO_THE_SSAPS
+			).c_str()
+		)
+		(
+			string( PO_SSAP_THREADS ).c_str(),
+			value<size_t>()
+				->value_name    ( threads_varname                                )
+				->notifier      ( num_ssap_threads_notifier                      )
+				->default_value ( alignment_input_spec::DEFAULT_NUM_SSAP_THREADS ),
+			::fmt::format(
+				"When doing the SSAPs, do them on {} threads (or 0 to use the hardware concurrency)\n(applies to --{} and to the default of doing the SSAPs)",
+				threads_varname,
+				PO_DO_THE_SSAPS
+			).c_str()
 		);
 
 	// Create and add a sub-block for alignment refining
@@ -154,6 +180,8 @@ void alignment_input_options_block::do_add_visible_options_to_description(option
 
 	static_assert( ! alignment_input_spec::DEFAULT_RESIDUE_NAME_ALIGN,
 		"If alignment_input_spec::DEFAULT_RESIDUE_NAME_ALIGN isn't false, it might mess up the bool switch in here" );
+	static_assert( ! alignment_input_spec::DEFAULT_PROGRESSIVE_SSAPS,
+		"If alignment_input_spec::DEFAULT_PROGRESSIVE_SSAPS isn't false, it might mess up the bool switch in here" );
 }
 
 /// \brief TODOCUMENT
@@ -162,6 +190,12 @@ str_opt alignment_input_options_block::do_invalid_string(const variables_map &/*
 	if ( get_num_acquirers( *this ) > 1 ) {
 		return "Cannot specify more than one alignment input"s;
 	}
+	if ( the_alignment_input_spec.get_progressive_ssaps() && get_num_acquirers( *this ) > 0 && ! the_alignment_input_spec.get_do_the_ssaps_dir() ) {
+		return ::fmt::format( "Cannot specify --{} with an alignment input other than --{}", PO_PROGRESSIVE_SSAPS, PO_DO_THE_SSAPS );
+	}
+	if ( the_alignment_input_spec.get_num_ssap_threads() != alignment_input_spec::DEFAULT_NUM_SSAP_THREADS && get_num_acquirers( *this ) > 0 && ! the_alignment_input_spec.get_do_the_ssaps_dir() ) {
+		return ::fmt::format( "Cannot specify --{} with an alignment input other than --{}", PO_SSAP_THREADS, PO_DO_THE_SSAPS );
+	}
 	if ( ! the_alignment_input_spec.get_fasta_alignment_file().empty() && ! is_acceptable_input_file( the_alignment_input_spec.get_fasta_alignment_file()    ) ) {
 		return "FASTA alignment file " + the_alignment_input_spec.get_ssap_alignment_file().string() + " is not a valid input file";
 	}
@@ -186,6 +220,8 @@ str_view_vec alignment_input_options_block::do_get_all_options_names() const {
 		PO_CORA_ALIGN_INFILE,
 		PO_SSAP_SCORE_INFILE,
 		PO_DO_THE_SSAPS,
+		PO_PROGRESSIVE_SSAPS,
+		PO_SSAP_THREADS,
 		PO_REFINING
 	};
 }
@@ -67,6 +67,12 @@ namespace cath::opts {
 		/// \brief The option name for a directory in which to do the necessary SSAPs and then use the scores to glue the resulting alignments together
 		static constexpr ::std::string_view PO_DO_THE_SSAPS{ "do-the-ssaps" };
 
+		/// \brief The option name for whether to only do the SSAPs in a spanning tree chosen from cheap secondary-structure comparisons
+		static constexpr ::std::string_view PO_PROGRESSIVE_SSAPS{ "progressive-ssaps" };
+
+		/// \brief The option name for the number of threads on which to do the SSAPs
+		static constexpr ::std::string_view PO_SSAP_THREADS{ "ssap-threads" };
+
 		/// \brief The option name for how much refining should be done to the alignment
 		static constexpr ::std::string_view PO_REFINING{ "align-refining" };
 	};
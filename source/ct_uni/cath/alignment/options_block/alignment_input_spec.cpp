@@ -66,11 +66,22 @@ const path & alignment_input_spec::get_ssap_scores_file() const {
 }
 
 /// \brief Getter for a directory in which SSAPs should be performed and then their alignments glued together
-///        or (inner) nullopt for cath-tools to choose a directory to use
+///        or (inner) nullopt to just keep the results in memory
 const path_opt_opt & alignment_input_spec::get_do_the_ssaps_dir() const {
 	return do_the_ssaps_dir;
 }
 
+/// \brief Getter for whether, when doing the SSAPs, to only do those in a spanning tree chosen from cheap
+///        secondary-structure comparisons (rather than all pairs)
+const bool & alignment_input_spec::get_progressive_ssaps() const {
+	return progressive_ssaps;
+}
+
+/// \brief Getter for the number of threads on which to do the SSAPs (or 0 to use the hardware concurrency)
+const size_t & alignment_input_spec::get_num_ssap_threads() const {
+	return num_ssap_threads;
+}
+
 /// \brief Getter for how much refining should be done to the alignment
 const align_refining & alignment_input_spec::get_refining() const {
 	return refining;
@@ -112,13 +123,28 @@ alignment_input_spec & alignment_input_spec::set_ssap_scores_file(const path &pr
 }
 
 /// \brief Setter for a directory in which SSAPs should be performed and then their alignments glued together
-///        or (inner) nullopt for cath-tools to choose a directory to use
-alignment_input_spec & alignment_input_spec::set_do_the_ssaps_dir(const path_opt &prm_do_the_ssaps_dir ///< A directory in which SSAPs should be performed and then their alignments glued together or (inner) nullopt for cath-tools to choose a directory to use
+///        or (inner) nullopt to just keep the results in memory
+alignment_input_spec & alignment_input_spec::set_do_the_ssaps_dir(const path_opt &prm_do_the_ssaps_dir ///< A directory in which SSAPs should be performed and then their alignments glued together or (inner) nullopt to just keep the results in memory
                                                                   ) {
 	do_the_ssaps_dir = prm_do_the_ssaps_dir;
 	return *this;
 }
 
+/// \brief Setter for whether, when doing the SSAPs, to only do those in a spanning tree chosen from cheap
+///        secondary-structure comparisons (rather than all pairs)
+alignment_input_spec & alignment_input_spec::set_progressive_ssaps(const bool &prm_progressive_ssaps ///< Whether, when doing the SSAPs, to only do those in a spanning tree chosen from cheap secondary-structure comparisons
+                                                                   ) {
+	progressive_ssaps = prm_progressive_ssaps;
+	return *this;
+}
+
+/// \brief Setter for the number of threads on which to do the SSAPs (or 0 to use the hardware concurrency)
+alignment_input_spec & alignment_input_spec::set_num_ssap_threads(const size_t &prm_num_ssap_threads ///< The number of threads on which to do the SSAPs (or 0 to use the hardware concurrency)
+                                                                  ) {
+	num_ssap_threads = prm_num_ssap_threads;
+	return *this;
+}
+
 /// \brief Setter for how much refining should be done to the alignment
 alignment_input_spec & alignment_input_spec::set_refining(const align_refining &prm_refining
                                                           ) {
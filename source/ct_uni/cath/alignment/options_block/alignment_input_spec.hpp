@@ -49,13 +49,20 @@ namespace cath::opts {
 		::std::filesystem::path ssap_scores_file;
 
 		/// \brief A directory in which SSAPs should be performed and then their alignments glued together
-		///        or (inner) nullopt for cath-tools to choose a directory to use
+		///        or (inner) nullopt to just keep the results in memory
 		///
 		/// The outer optional<> is used to determine if the option has been specified
 		/// The inner optional<> is used to determine if a specific directory should be used
 		/// (rather than cath-tools choosing)
 		path_opt_opt do_the_ssaps_dir;
 
+		/// \brief Whether, when doing the SSAPs, to only do those in a spanning tree chosen from cheap
+		///        secondary-structure comparisons (rather than all pairs)
+		bool progressive_ssaps = DEFAULT_PROGRESSIVE_SSAPS;
+
+		/// \brief The number of threads on which to do the SSAPs (or 0 to use the hardware concurrency)
+		size_t num_ssap_threads = DEFAULT_NUM_SSAP_THREADS;
+
 		/// \brief How much refining should be done to the alignment
 		align::align_refining refining = DEFAULT_REFINING;
 
@@ -63,6 +70,12 @@ namespace cath::opts {
 		/// \brief The default value for whether to align based on matching residue names
 		static constexpr bool DEFAULT_RESIDUE_NAME_ALIGN = false;
 
+		/// \brief The default value for whether to only do the SSAPs in a spanning tree chosen from cheap comparisons
+		static constexpr bool DEFAULT_PROGRESSIVE_SSAPS = false;
+
+		/// \brief The default number of threads on which to do the SSAPs (0 to use the hardware concurrency)
+		static constexpr size_t DEFAULT_NUM_SSAP_THREADS = 0;
+
 		/// \brief The default value for how much refining should be done to the alignment
 		static constexpr align::align_refining DEFAULT_REFINING = align::align_refining::NO;
 
@@ -75,6 +88,8 @@ namespace cath::opts {
 		[[nodiscard]] const ::std::filesystem::path &get_cora_alignment_file() const;
 		[[nodiscard]] const ::std::filesystem::path &get_ssap_scores_file() const;
 		[[nodiscard]] const path_opt_opt &           get_do_the_ssaps_dir() const;
+		[[nodiscard]] const bool &                   get_progressive_ssaps() const;
+		[[nodiscard]] const size_t &                 get_num_ssap_threads() const;
 		[[nodiscard]] const align::align_refining &  get_refining() const;
 
 		alignment_input_spec & set_residue_name_align(const bool &);
@@ -83,6 +98,8 @@ namespace cath::opts {
 		alignment_input_spec & set_cora_alignment_file(const ::std::filesystem::path &);
 		alignment_input_spec & set_ssap_scores_file(const ::std::filesystem::path &);
 		alignment_input_spec & set_do_the_ssaps_dir(const path_opt &);
+		alignment_input_spec & set_progressive_ssaps(const bool &);
+		alignment_input_spec & set_num_ssap_threads(const size_t &);
 		alignment_input_spec & set_refining(const align::align_refining &);
 	};
 
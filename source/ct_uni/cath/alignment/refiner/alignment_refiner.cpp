@@ -23,13 +23,15 @@
 #include <fstream>
 
 #include <boost/numeric/conversion/cast.hpp>
+#include <boost/range/irange.hpp>
 
 #include <spdlog/spdlog.h>
 
 #include "cath/alignment/alignment.hpp"
 #include "cath/alignment/dyn_prog_align/detail/matrix_plotter/gnuplot_matrix_plotter.hpp"
 #include "cath/alignment/dyn_prog_align/detail/matrix_plotter/matrix_plot.hpp"
-#include "cath/alignment/dyn_prog_align/dyn_prog_score_source/new_matrix_dyn_prog_score_source.hpp"
+#include "cath/alignment/dyn_prog_align/detail/banded_score_matrix.hpp"
+#include "cath/alignment/dyn_prog_align/dyn_prog_score_source/banded_matrix_dyn_prog_score_source.hpp"
 #include "cath/alignment/dyn_prog_align/ssap_code_dyn_prog_aligner.hpp" // ***** TEMPORARY *****
 #include "cath/alignment/dyn_prog_align/std_dyn_prog_aligner.hpp"
 #include "cath/alignment/io/alignment_io.hpp"
@@ -41,6 +43,8 @@
 #include "cath/common/boost_addenda/range/indices.hpp"
 #include "cath/common/exception/not_implemented_exception.hpp"
 #include "cath/common/file/open_fstream.hpp"
+#include "cath/common/size_t_literal.hpp"
+#include "cath/common/thread/parallel_for_each_index.hpp"
 #include "cath/ssap/ssap.hpp"
 #include "cath/structure/entry_querier/residue_querier.hpp" // ***** TEMPORARY *****
 #include "cath/structure/protein/protein.hpp"
@@ -56,6 +60,127 @@ using namespace ::cath::common;
 using namespace ::cath::index;
 using namespace ::std;
 
+using ::boost::irange;
+
+namespace {
+
+	/// \brief The number of chunks of rows per thread into which the score matrices are divided for building in parallel
+	constexpr size_t ROW_CHUNKS_PER_THREAD = 4;
+
+	/// \brief A pair of residues, one from each half of an alignment_split, that are aligned to each other
+	struct split_aligned_pair final {
+		/// \brief The entry in the original alignment of the residue from the first half
+		size_t orig_aln_entry_a;
+
+		/// \brief The entry in the original alignment of the residue from the second half
+		size_t orig_aln_entry_b;
+
+		/// \brief The entry in the first half's alignment_split_mapping
+		size_t entry_a;
+
+		/// \brief The entry in the second half's alignment_split_mapping
+		size_t entry_b;
+
+		/// \brief The position of the residue from the first half
+		aln_posn_type posn_a;
+
+		/// \brief The position of the residue from the second half
+		aln_posn_type posn_b;
+	};
+
+	/// \brief Type alias for a vector of split_aligned_pair values
+	using split_aligned_pair_vec = vector<split_aligned_pair>;
+
+	/// \brief Get the pairs of residues that the specified alignment aligns between the two halves of a split,
+	///        in the order of the alignment's positions and then of the entries
+	split_aligned_pair_vec get_split_aligned_pairs(const alignment               &prm_alignment, ///< The alignment that has been split
+	                                               const alignment_split_mapping &prm_mapping_a, ///< The mapping for the first half of the split
+	                                               const alignment_split_mapping &prm_mapping_b  ///< The mapping for the second half of the split
+	                                               ) {
+		split_aligned_pair_vec aligned_pairs;
+		for (const size_t &aln_ctr : indices( prm_alignment.length() ) ) {
+			const size_opt mapping_index_a = prm_mapping_a.index_of_orig_aln_index( aln_ctr );
+			const size_opt mapping_index_b = prm_mapping_b.index_of_orig_aln_index( aln_ctr );
+			if ( ! mapping_index_a || ! mapping_index_b ) {
+				continue;
+			}
+			for (const size_t &present_orig_aln_entry_a : present_orig_aln_entries_of_index( prm_mapping_a, *mapping_index_a ) ) {
+				for (const size_t &present_orig_aln_entry_b : present_orig_aln_entries_of_index( prm_mapping_b, *mapping_index_b ) ) {
+					const size_t present_entry_a = * prm_mapping_a.entry_of_orig_aln_entry( present_orig_aln_entry_a );
+					const size_t present_entry_b = * prm_mapping_b.entry_of_orig_aln_entry( present_orig_aln_entry_b );
+					aligned_pairs.push_back( {
+						present_orig_aln_entry_a,
+						present_orig_aln_entry_b,
+						present_entry_a,
+						present_entry_b,
+						get_position_of_entry_of_index( prm_mapping_a, present_entry_a, *mapping_index_a ),
+						get_position_of_entry_of_index( prm_mapping_b, present_entry_b, *mapping_index_b )
+					} );
+				}
+			}
+		}
+		return aligned_pairs;
+	}
+
+	/// \brief Get the first of the specified entry's residues that the mapping puts at or after the specified index
+	///        (or the entry's length if there is none)
+	///
+	/// This relies on the mapping keeping each entry's residues in order
+	size_t first_residue_at_or_after_index(const alignment_split_mapping &prm_mapping, ///< The alignment_split_mapping
+	                                       const size_t                  &prm_entry,   ///< The entry in the mapping
+	                                       const size_t                  &prm_length,  ///< The number of residues in the entry
+	                                       const size_t                  &prm_index    ///< The index in the mapping
+	                                       ) {
+		size_t begin = 0;
+		size_t end   = prm_length;
+		while ( begin < end ) {
+			const size_t middle = begin + ( end - begin ) / 2;
+			if ( prm_mapping.index_of_protein_index( prm_entry, middle ) < prm_index ) {
+				begin = middle + 1;
+			}
+			else {
+				end = middle;
+			}
+		}
+		return begin;
+	}
+
+	/// \brief Get the path of the specified alignment through the score matrix of a split
+	///        (ie the pairs of indices in the two mappings at which the alignment has residues from both halves)
+	size_size_pair_vec get_split_path(const alignment               &prm_alignment, ///< The alignment that has been split
+	                                  const alignment_split_mapping &prm_mapping_a, ///< The mapping for the first half of the split
+	                                  const alignment_split_mapping &prm_mapping_b  ///< The mapping for the second half of the split
+	                                  ) {
+		size_size_pair_vec split_path;
+		for (const size_t &aln_ctr : indices( prm_alignment.length() ) ) {
+			const size_opt mapping_index_a = prm_mapping_a.index_of_orig_aln_index( aln_ctr );
+			const size_opt mapping_index_b = prm_mapping_b.index_of_orig_aln_index( aln_ctr );
+			if ( mapping_index_a && mapping_index_b ) {
+				split_path.emplace_back( *mapping_index_a, *mapping_index_b );
+			}
+		}
+		return split_path;
+	}
+
+	/// \brief Whether any of the pairs aligned by the specified pair alignment is at the edge of (or outside) the band
+	///        of the specified banded_score_matrix
+	bool path_reaches_band_edge(const alignment           &prm_alignment, ///< The pair alignment of the matrix's rows and columns
+	                            const banded_score_matrix &prm_matrix     ///< The banded_score_matrix
+	                            ) {
+		for (const size_t &aln_ctr : indices( prm_alignment.length() ) ) {
+			if ( has_both_positions_of_index( prm_alignment, aln_ctr ) ) {
+				const size_t index_a = get_a_position_of_index( prm_alignment, aln_ctr );
+				const size_t index_b = get_b_position_of_index( prm_alignment, aln_ctr );
+				if ( is_at_band_edge( prm_matrix, index_a, index_b ) ) {
+					return true;
+				}
+			}
+		}
+		return false;
+	}
+
+} // namespace
+
 /// \brief TODOCUMENT
 bool_aln_pair alignment_refiner::iterate_step(const alignment       &prm_alignment,       ///< TODOCUMENT
                                               const protein_list    &prm_proteins,        ///< TODOCUMENT
@@ -131,96 +256,125 @@ bool_aln_pair alignment_refiner::iterate_step_for_alignment_split(const alignmen
 	const size_t full_length_b     = mapping_b.length();
 	const size_t full_window_width = get_window_width_for_full_matrix( full_length_a, full_length_b );
 
-	from_alignment_scores.assign( full_length_a, float_score_vec( full_length_b, 0.0 ) );
-	to_alignment_scores.assign  ( full_length_a, float_score_vec( full_length_b, 0.0 ) );
-
 //	cerr << "number of entries in alignment is " << prm_alignment.num_entries() << endl;
 //	cerr << "number of entries in half a of split is " << mapping_a.num_entries() << endl;
 //	cerr << "number of entries in half b of split is " << mapping_b.num_entries() << endl;
 
-	const alignment::size_type alignment_length = prm_alignment.length();
-	for (const size_t &aln_ctr : indices( alignment_length ) ) {
-		const size_opt mapping_index_a = mapping_a.index_of_orig_aln_index( aln_ctr );
-		const size_opt mapping_index_b = mapping_b.index_of_orig_aln_index( aln_ctr );
-		if ( ! mapping_index_a || ! mapping_index_b ) {
-			continue;
+	const split_aligned_pair_vec aligned_pairs    = get_split_aligned_pairs( prm_alignment, mapping_a, mapping_b );
+	const size_t                 num_threads_used = num_threads_to_use( num_threads );
+	const size_t                 num_chunks       = min( full_length_a, num_threads_used * ROW_CHUNKS_PER_THREAD );
+
+	// If banding, only score within the band around the current alignment and then keep
+	// doubling the band's width (and rescoring) for as long as the optimum path reaches the band's edge
+	//
+	// The band is always centred on the same path so it's only calculated once
+	const size_size_pair_vec split_path = band_width ? get_split_path( prm_alignment, mapping_a, mapping_b ) : size_size_pair_vec{};
+	size_opt current_band_width = band_width;
+	while ( true ) {
+		if ( current_band_width ) {
+			from_alignment_scores.reset_to_band( full_length_a, full_length_b, split_path, *current_band_width );
+			to_alignment_scores.reset_to_band  ( full_length_a, full_length_b, split_path, *current_band_width );
+		}
+		else {
+			from_alignment_scores.reset_to_full( full_length_a, full_length_b );
+			to_alignment_scores.reset_to_full  ( full_length_a, full_length_b );
 		}
-//		cerr << "At alignment counter " << aln_ctr << endl;
-
-		const size_vec present_orig_aln_entries_a = present_orig_aln_entries_of_index( mapping_a, *mapping_index_a );
-		const size_vec present_orig_aln_entries_b = present_orig_aln_entries_of_index( mapping_b, *mapping_index_b );
-
-		for (const size_t &present_orig_aln_entry_a : present_orig_aln_entries_a) {
-			for (const size_t &present_orig_aln_entry_b : present_orig_aln_entries_b) {
-				const size_t        present_entry_a = * mapping_a.entry_of_orig_aln_entry( present_orig_aln_entry_a );
-				const size_t        present_entry_b = * mapping_b.entry_of_orig_aln_entry( present_orig_aln_entry_b );
-				const aln_posn_type a_position      = get_position_of_entry_of_index( mapping_a, present_entry_a, *mapping_index_a );
-				const aln_posn_type b_position      = get_position_of_entry_of_index( mapping_b, present_entry_b, *mapping_index_b );
-
-	//			cerr << "Rescoring based on pair " << a_position << ", " << b_position << endl;
-				const protein &protein_a = prm_proteins[ present_orig_aln_entry_a ];
-				const protein &protein_b = prm_proteins[ present_orig_aln_entry_b ];
-				const size_t   length_a  = protein_a.get_length();
-				const size_t   length_b  = protein_b.get_length();
-//				const residue &residue_a = protein_a.get_residue_ref_of_index( a_position );
-//				const residue &residue_b = protein_b.get_residue_ref_of_index( b_position );
-
-				for (const size_t &res_ctr_a : indices( length_a ) ) {
-					for (const size_t &res_ctr_b : indices( length_b ) ) {
-						if ( res_ctr_a != a_position && res_ctr_b != b_position ) {
-							const size_t   other_mapping_index_a = mapping_a.index_of_protein_index( present_entry_a, res_ctr_a );
-							const size_t   other_mapping_index_b = mapping_b.index_of_protein_index( present_entry_b, res_ctr_b );
-//							const residue &other_residue_a       = protein_a.get_residue_ref_of_index( res_ctr_a );
-//							const residue &other_residue_b       = protein_b.get_residue_ref_of_index( res_ctr_b );
-
-							from_alignment_scores[ other_mapping_index_a ][ other_mapping_index_b ] += get_residue_context(
+
+		// Build the scores in chunks of rows in parallel
+		//
+		// Each chunk only writes to its own rows and adds to each cell in the same order as a serial build would,
+		// so the results don't depend on the number of threads
+		parallel_for_each_index( num_chunks, num_threads_used, [&] (const size_t &prm_chunk_index) {
+			const size_t begin_row = (   prm_chunk_index         * full_length_a ) / num_chunks;
+			const size_t end_row   = ( ( prm_chunk_index + 1_z ) * full_length_a ) / num_chunks;
+			for (const split_aligned_pair &the_pair : aligned_pairs) {
+				const size_t length_a    = prm_proteins[ the_pair.orig_aln_entry_a ].get_length();
+				const size_t length_b    = prm_proteins[ the_pair.orig_aln_entry_b ].get_length();
+				const size_t begin_res_a = first_residue_at_or_after_index( mapping_a, the_pair.entry_a, length_a, begin_row );
+				const size_t end_res_a   = first_residue_at_or_after_index( mapping_a, the_pair.entry_a, length_a, end_row   );
+
+				for (const size_t &res_ctr_a : irange( begin_res_a, end_res_a ) ) {
+					if ( res_ctr_a == the_pair.posn_a ) {
+						continue;
+					}
+					const size_t other_mapping_index_a = mapping_a.index_of_protein_index( the_pair.entry_a, res_ctr_a );
+					const size_t begin_res_b           = first_residue_at_or_after_index( mapping_b, the_pair.entry_b, length_b, from_alignment_scores.get_band_begin( other_mapping_index_a ) );
+					const size_t end_res_b             = first_residue_at_or_after_index( mapping_b, the_pair.entry_b, length_b, from_alignment_scores.get_band_end  ( other_mapping_index_a ) );
+					for (const size_t &res_ctr_b : irange( begin_res_b, end_res_b ) ) {
+						if ( res_ctr_b != the_pair.posn_b ) {
+							const size_t other_mapping_index_b = mapping_b.index_of_protein_index( the_pair.entry_b, res_ctr_b );
+
+							from_alignment_scores.get_score_ref( other_mapping_index_a, other_mapping_index_b ) += get_residue_context(
 								prm_view_cache_list,
-								present_orig_aln_entry_a,
-								present_orig_aln_entry_b,
-								a_position,
-								b_position,
+								the_pair.orig_aln_entry_a,
+								the_pair.orig_aln_entry_b,
+								the_pair.posn_a,
+								the_pair.posn_b,
 								res_ctr_a,
 								res_ctr_b
 							);
-							to_alignment_scores[ other_mapping_index_a ][ other_mapping_index_b ] += get_residue_context(
+							to_alignment_scores.get_score_ref( other_mapping_index_a, other_mapping_index_b ) += get_residue_context(
 								prm_view_cache_list,
-								present_orig_aln_entry_a,
-								present_orig_aln_entry_b,
+								the_pair.orig_aln_entry_a,
+								the_pair.orig_aln_entry_b,
 								res_ctr_a,
 								res_ctr_b,
-								a_position,
-								b_position
+								the_pair.posn_a,
+								the_pair.posn_b
 							);
 						}
 					}
 				}
 			}
+		} );
+
+		// Average the from and to scores into from_alignment_scores (rather than into a fresh matrix)
+		for (const size_t &ctr_a : indices( full_length_a ) ) {
+			for (const size_t &ctr_b : irange( from_alignment_scores.get_band_begin( ctr_a ), from_alignment_scores.get_band_end( ctr_a ) ) ) {
+				float_score_type &score = from_alignment_scores.get_score_ref( ctr_a, ctr_b );
+				score = (score + to_alignment_scores.get_score( ctr_a, ctr_b )) / 2.0;
+			}
 		}
-	}
 
-	float_score_vec_vec avg_scores( full_length_a, float_score_vec( full_length_b, 0 ) );
-	for (const size_t &ctr_a : indices( full_length_a ) ) {
-		for (const size_t &ctr_b : indices( full_length_b ) ) {
-			avg_scores[ctr_a][ctr_b] = (from_alignment_scores[ctr_a][ctr_b] + to_alignment_scores[ctr_a][ctr_b]) / 2.0;
+		const banded_matrix_dyn_prog_score_source scorer( from_alignment_scores );
+
+		const score_alignment_pair score_and_alignment = current_band_width
+			? std_dyn_prog_aligner().align_in_band( scorer, prm_gap_penalty, from_alignment_scores )
+			: std_dyn_prog_aligner().align        ( scorer, prm_gap_penalty, full_window_width     );
+
+		if ( ! current_band_width || is_full( from_alignment_scores ) || ! path_reaches_band_edge( score_and_alignment.second, from_alignment_scores ) ) {
+			alignment new_alignment = set_empty_scores_copy(
+				build_alignment(
+					score_and_alignment.second,
+					mapping_a,
+					mapping_b
+				)
+			);
+			return make_pair( inserted_residues, new_alignment );
 		}
-	}
 
-//	matrix_plot<gnuplot_matrix_plotter>( path("matrix_plot_from"), new_matrix_dyn_prog_score_source( from_alignment_scores, length_a, length_b) );
-//	matrix_plot<gnuplot_matrix_plotter>( path("matrix_plot___to"), new_matrix_dyn_prog_score_source( to_alignment_scores,   length_a, length_b) );
-//	matrix_plot<gnuplot_matrix_plotter>( path("matrix_plot__avg"), new_matrix_dyn_prog_score_source( avg_scores,            length_a, length_b) );
+		current_band_width = max( 1_z, 2_z * *current_band_width );
+		::spdlog::debug( "Refining's optimum path reached the edge of the band so widening it to {}", *current_band_width );
+	}
+}
 
-	const new_matrix_dyn_prog_score_source scorer( avg_scores, full_length_a, full_length_b );
+/// \brief Ctor from the number of threads with which to build each step's score matrices
+///        and the optional width of the band around the alignment within which to score
+alignment_refiner::alignment_refiner(const size_t   &prm_num_threads, ///< The number of threads with which to build each step's score matrices (or 0 to use the hardware concurrency)
+                                     const size_opt &prm_band_width   ///< The optional number of cells either side of the alignment within which to score (or nullopt to score the full matrices)
+                                     ) : num_threads { prm_num_threads },
+                                         band_width  { prm_band_width  } {
+}
 
-	const score_alignment_pair score_and_alignment = std_dyn_prog_aligner().align( scorer, prm_gap_penalty, full_window_width );
+/// \brief Getter for the number of threads with which to build each step's score matrices (or 0 to use the hardware concurrency)
+const size_t & alignment_refiner::get_num_threads() const {
+	return num_threads;
+}
 
-	alignment new_alignment = set_empty_scores_copy(
-		build_alignment(
-			score_and_alignment.second,
-			mapping_a,
-			mapping_b
-		)
-	);
-	return make_pair( inserted_residues, new_alignment );
+/// \brief Getter for the optional number of cells either side of the alignment within which to score
+///        (or nullopt to score the full matrices)
+const size_opt & alignment_refiner::get_band_width() const {
+	return band_width;
 }
 
 /// \brief TODOCUMENT
@@ -21,7 +21,10 @@
 #ifndef CATH_TOOLS_SOURCE_CT_UNI_CATH_ALIGNMENT_REFINER_ALIGNMENT_REFINER_HPP
 #define CATH_TOOLS_SOURCE_CT_UNI_CATH_ALIGNMENT_REFINER_ALIGNMENT_REFINER_HPP
 
+#include <optional>
+
 #include "cath/alignment/align_type_aliases.hpp"
+#include "cath/alignment/dyn_prog_align/detail/banded_score_matrix.hpp"
 #include "cath/common/type_aliases.hpp"
 
 // clang-format off
@@ -36,13 +39,32 @@ namespace cath::index { class view_cache_list; }
 namespace cath::align {
 
 	/// \brief TODOCUMENT
+	///
+	/// The score matrices are kept as members so that their buffers are reused from one
+	/// refining step to the next. This means an alignment_refiner mustn't be used by more than
+	/// one thread at a time (though each step itself may use several threads).
+	///
+	/// If a band width is specified, each step only scores the cells within that many cells of the
+	/// existing alignment's path and the dynamic-programming only considers paths through those
+	/// cells (see std_dyn_prog_aligner::align_in_band()). Refinement moves are local to the existing alignment so this
+	/// saves much memory and time on long alignments. Whenever the optimum path reaches the
+	/// edge of the band, the step is repeated with the band's width doubled.
 	class alignment_refiner final {
 	private:
+		/// \brief The number of threads with which to build each step's score matrices (or 0 to use the hardware concurrency)
+		size_t num_threads = DEFAULT_NUM_THREADS;
+
+		/// \brief The optional number of cells either side of the alignment within which to score
+		///        (or nullopt to score the full matrices)
+		size_opt band_width;
+
 		/// \brief TODOCUMENT
-		float_score_vec_vec from_alignment_scores;
+		///
+		/// After the scores have been built, this is overwritten with the average of itself and to_alignment_scores
+		detail::banded_score_matrix from_alignment_scores;
 
 		/// \brief TODOCUMENT
-		float_score_vec_vec to_alignment_scores;
+		detail::banded_score_matrix to_alignment_scores;
 
 		detail::bool_aln_pair iterate_step(const alignment &,
 		                                   const protein_list &,
@@ -62,6 +84,15 @@ namespace cath::align {
 		                                                       const detail::alignment_split &);
 
 	public:
+		/// \brief The default number of threads (0, meaning use the hardware concurrency)
+		static constexpr size_t DEFAULT_NUM_THREADS = 0;
+
+		explicit alignment_refiner(const size_t & = DEFAULT_NUM_THREADS,
+		                           const size_opt & = ::std::nullopt);
+
+		[[nodiscard]] const size_t &   get_num_threads() const;
+		[[nodiscard]] const size_opt & get_band_width() const;
+
 		alignment iterate(const alignment &,
 		                  const protein_list &,
 		                  const gap::gap_penalty &);
@@ -0,0 +1,112 @@
+/// \file
+/// \brief The alignment_refiner test suite
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <boost/test/unit_test.hpp>
+
+#include "cath/acquirer/alignment_acquirer/ssap_scores_file_alignment_acquirer.hpp"
+#include "cath/alignment/alignment.hpp"
+#include "cath/alignment/gap/gap_penalty.hpp"
+#include "cath/alignment/io/alignment_io.hpp"
+#include "cath/alignment/refiner/alignment_refiner.hpp"
+#include "cath/common/boost_addenda/log/stringstream_log_sink.hpp"
+#include "cath/common/size_t_literal.hpp"
+#include "cath/file/pdb/pdb.hpp"
+#include "cath/file/pdb/pdb_list.hpp"
+#include "cath/file/strucs_context.hpp"
+#include "cath/structure/protein/protein.hpp"
+#include "cath/structure/protein/protein_list.hpp"
+#include "cath/structure/protein/residue.hpp"
+#include "cath/structure/protein/sec_struc.hpp"
+#include "cath/structure/protein/sec_struc_planar_angles.hpp"
+#include "cath/test/global_test_constants.hpp"
+
+using namespace ::cath;
+using namespace ::cath::align;
+using namespace ::cath::align::gap;
+using namespace ::cath::common;
+using namespace ::cath::file;
+
+using ::std::string;
+
+namespace {
+
+	/// \brief The alignment_refiner_test_suite_fixture to assist in testing alignment_refiner
+	struct alignment_refiner_test_suite_fixture : protected global_test_constants {
+	protected:
+		~alignment_refiner_test_suite_fixture() noexcept = default;
+
+		/// \brief The IDs of the structures to align
+		const str_vec ids{ "1o7iB00", "3uljB00", "4gs3A00" };
+
+		/// \brief The PDBs of the structures to align
+		const pdb_list the_pdbs = read_pdb_files( {
+			TEST_SSAP_ALIGNMENT_GLUING_DATA_DIR() / ids[ 0 ],
+			TEST_SSAP_ALIGNMENT_GLUING_DATA_DIR() / ids[ 1 ],
+			TEST_SSAP_ALIGNMENT_GLUING_DATA_DIR() / ids[ 2 ],
+		} );
+
+		/// \brief The proteins of the structures to align
+		const protein_list the_proteins = build_protein_list_of_pdb_list( the_pdbs );
+
+		/// \brief An unrefined alignment of the structures, glued together from their SSAPs
+		const alignment unrefined_alignment = [&] {
+			const stringstream_log_sink log_sink;
+			return ssap_scores_file_alignment_acquirer{ TEST_SSAP_ALIGNMENT_GLUING_DATA_DIR() / "1o7iB00_3uljB00_4gs3A00.ssap_scores" }
+				.get_alignment_and_spanning_tree( strucs_context{ the_pdbs } )
+				.first;
+		} ();
+
+		/// \brief Refine the unrefined alignment with the specified alignment_refiner and return it as a FASTA string
+		[[nodiscard]] string refine_with(alignment_refiner &prm_refiner ///< The alignment_refiner with which to refine the alignment
+		                                 ) const {
+			const stringstream_log_sink log_sink;
+			return alignment_as_fasta_string(
+				prm_refiner.iterate( unrefined_alignment, the_proteins, gap_penalty( 50, 0 ) ),
+				the_pdbs,
+				ids
+			);
+		}
+	};
+
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE(alignment_refiner_test_suite, alignment_refiner_test_suite_fixture)
+
+BOOST_AUTO_TEST_CASE(refined_alignment_does_not_depend_on_num_threads) {
+	alignment_refiner single_threaded_refiner{ 1 };
+	alignment_refiner multi_threaded_refiner { 3 };
+	BOOST_CHECK_EQUAL( multi_threaded_refiner.get_num_threads(), 3 );
+	BOOST_CHECK_EQUAL( refine_with( multi_threaded_refiner ), refine_with( single_threaded_refiner ) );
+}
+
+BOOST_AUTO_TEST_CASE(refined_alignment_does_not_depend_on_reused_buffers) {
+	alignment_refiner the_refiner{ 2 };
+	const string first_refined = refine_with( the_refiner );
+	BOOST_CHECK_EQUAL( refine_with( the_refiner ), first_refined );
+}
+
+BOOST_AUTO_TEST_CASE(refined_alignment_with_band_covering_matrices_matches_full) {
+	alignment_refiner full_refiner  { 2 };
+	alignment_refiner banded_refiner{ 2, 1'000 };
+	BOOST_CHECK( banded_refiner.get_band_width() == 1'000_z );
+	BOOST_CHECK_EQUAL( refine_with( banded_refiner ), refine_with( full_refiner ) );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -31,6 +31,7 @@
 #include "cath/common/clone/check_uptr_clone_against_this.hpp"
 #include "cath/common/exception/invalid_argument_exception.hpp"
 #include "cath/common/exception/out_of_range_exception.hpp"
+#include "cath/score/aligned_pair_score/detail/score_common_coord_cache.hpp"
 #include "cath/score/aligned_pair_score_list/aligned_pair_score_list.hpp"
 #include "cath/score/aligned_pair_score_list/aligned_pair_score_list_factory.hpp"
 #include "cath/score/detail/score_name_helper.hpp"
@@ -81,6 +82,19 @@ tribool aligned_pair_score::higher_is_better() const {
 	return do_higher_is_better();
 }
 
+/// \brief Calculate the score for a pair alignment and two associated proteins
+///
+/// This is equivalent to calling the other calculate() with a new score_common_coord_cache
+/// for the alignment and proteins. When calculating several scores for the same alignment,
+/// prefer that one with a shared score_common_coord_cache.
+score_value aligned_pair_score::calculate(const alignment &prm_alignment, ///< The pair alignment to be scored
+                                          const protein   &prm_protein_a, ///< The protein associated with the first  half of the alignment
+                                          const protein   &prm_protein_b  ///< The protein associated with the second half of the alignment
+                                          ) const {
+	score_common_coord_cache the_cache{ prm_alignment, prm_protein_a, prm_protein_b };
+	return calculate( prm_alignment, prm_protein_a, prm_protein_b, the_cache );
+}
+
 /// \brief An NVI pass-through to the concrete class's do_calculate() which defines the method of calculating a score for
 ///        a pair alignment and two associated proteins.
 ///
@@ -92,9 +106,13 @@ tribool aligned_pair_score::higher_is_better() const {
 ///
 /// \pre The alignment must not overrun the end of the two associated proteins
 ///      else an invalid_argument_exception will be thrown.
-score_value aligned_pair_score::calculate(const alignment &prm_alignment, ///< The pair alignment to be scored
-                                          const protein   &prm_protein_a, ///< The protein associated with the first  half of the alignment
-                                          const protein   &prm_protein_b  ///< The protein associated with the second half of the alignment
+///
+/// \pre The score_common_coord_cache must be for the same alignment and proteins
+///      else an invalid_argument_exception will be thrown.
+score_value aligned_pair_score::calculate(const alignment          &prm_alignment, ///< The pair alignment to be scored
+                                          const protein            &prm_protein_a, ///< The protein associated with the first  half of the alignment
+                                          const protein            &prm_protein_b, ///< The protein associated with the second half of the alignment
+                                          score_common_coord_cache &prm_cache      ///< The cache of common coords for this alignment and these proteins, to be shared with any other scores
                                           ) const {
 	// Sanity check that the input alignment has two entries
 	if ( alignment::NUM_ENTRIES_IN_PAIR_ALIGNMENT != prm_alignment.num_entries() ) {
@@ -112,8 +130,13 @@ score_value aligned_pair_score::calculate(const alignment &prm_alignment, ///< T
 		BOOST_THROW_EXCEPTION(invalid_argument_exception("Second half of alignment passed to aligned_pair_score overruns prm_protein_b"));
 	}
 
+	// Sanity check that the cache is for this alignment and these proteins
+	if ( ! prm_cache.is_for( prm_alignment, prm_protein_a, prm_protein_b ) ) {
+		BOOST_THROW_EXCEPTION(invalid_argument_exception("Common coord cache passed to aligned_pair_score is for a different alignment or proteins"));
+	}
+
 	// Return the result of the concrete score's calculation
-	return do_calculate( prm_alignment, prm_protein_a, prm_protein_b );
+	return do_calculate( prm_alignment, prm_protein_a, prm_protein_b, prm_cache );
 }
 
 /// \brief An NVI pass-through to the concrete class's do_long_name() which defines a free text description, describing the score.
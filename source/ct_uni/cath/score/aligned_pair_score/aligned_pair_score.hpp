@@ -34,6 +34,7 @@
 // clang-format off
 namespace cath { class protein; }
 namespace cath::align { class alignment; }
+namespace cath::score::detail { class score_common_coord_cache; }
 namespace cath::score::detail { str_aligned_pair_score_pmap get_aligned_pair_score_of_id_name(); }
 // clang-format on
 
@@ -60,7 +61,11 @@ namespace cath::score {
 
 		/// \brief Pure virtual method with which each concrete aligned_pair_score must define the method of calculating a score for
 		///        a pair alignment and two associated proteins.
-		[[nodiscard]] virtual score_value do_calculate( const align::alignment &, const protein &, const protein & ) const = 0;
+		///
+		/// Any common coords (or superposition of them) should be taken from the score_common_coord_cache
+		/// (which is for the same alignment and proteins) and the cache should be passed on to any scores
+		/// from which this one is composed.
+		[[nodiscard]] virtual score_value do_calculate( const align::alignment &, const protein &, const protein &, detail::score_common_coord_cache & ) const = 0;
 
 		/// \brief Pure virtual method with which each concrete aligned_pair_score must define a free text description, describing the score.
 		[[nodiscard]] virtual std::string do_description() const = 0;
@@ -99,6 +104,10 @@ namespace cath::score {
 
 		[[nodiscard]] boost::logic::tribool higher_is_better() const;
 		[[nodiscard]] score_value calculate( const align::alignment &, const protein &, const protein & ) const;
+		[[nodiscard]] score_value calculate( const align::alignment &,
+		                                     const protein &,
+		                                     const protein &,
+		                                     detail::score_common_coord_cache & ) const;
 
 		[[nodiscard]] std::string       id_name() const;
 		[[nodiscard]] str_bool_pair_vec short_name_suffixes() const;
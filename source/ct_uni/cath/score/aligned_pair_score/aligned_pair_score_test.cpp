@@ -20,6 +20,7 @@
 
 #include "aligned_pair_score.hpp"
 
+#include <cmath>
 #include <filesystem>
 #include <iostream>
 #include <iterator>
@@ -36,11 +37,14 @@
 #include "cath/alignment/io/alignment_io.hpp"
 #include "cath/alignment/residue_score/residue_scorer.hpp"
 #include "cath/common/boost_addenda/log/log_to_ostream_guard.hpp"
+#include "cath/common/exception/invalid_argument_exception.hpp"
 #include "cath/common/size_t_literal.hpp"
 #include "cath/file/pdb/pdb.hpp"
 #include "cath/file/pdb/pdb_atom.hpp"
 #include "cath/file/pdb/pdb_list.hpp"
 #include "cath/file/pdb/pdb_residue.hpp"
+#include "cath/score/aligned_pair_score/detail/score_common_coord_cache.hpp"
+#include "cath/score/aligned_pair_score/detail/score_common_coord_handler.hpp"
 #include "cath/score/aligned_pair_score/drmsd_score.hpp"
 #include "cath/score/aligned_pair_score/gsas_score.hpp"
 #include "cath/score/aligned_pair_score/lddt_score.hpp"
@@ -57,6 +61,7 @@
 #include "cath/score/aligned_pair_score/tm_score.hpp"
 #include "cath/score/aligned_pair_score_list/aligned_pair_score_list.hpp"
 #include "cath/score/aligned_pair_score_list/aligned_pair_score_list_factory.hpp"
+#include "cath/score/aligned_pair_score_list/aligned_pair_score_value_list.hpp"
 #include "cath/score/length_getter/length_of_first_getter.hpp"
 #include "cath/score/length_getter/length_of_longer_getter.hpp"
 #include "cath/score/length_getter/length_of_second_getter.hpp"
@@ -80,6 +85,7 @@ using namespace ::cath::align;
 using namespace ::cath::common;
 using namespace ::cath::common::test;
 using namespace ::cath::score;
+using namespace ::cath::score::detail;
 using namespace ::std;
 
 using ::std::filesystem::path;
@@ -99,6 +105,14 @@ namespace {
 		                       const score_value &,
 		                       const score_value &) const;
 
+		/// \brief The accuracy (as a percentage) within which tm_score should match the TM-score webserver's values for these pairs
+		///
+		/// tm_score follows the TM-score program's search but the webserver's values for 1c55A/1wmtA and 1c55A/1hykA
+		/// are about 4.5% higher than tm_score's (and 1c55A/1wt7A's is about 0.3% lower). The webserver's RMSDs differ
+		/// from rmsd_score's by much more (eg 1.99 against 4.99 for 1c55A/1wt7A), so that known offset is attributed to the
+		/// webserver using different residue correspondences rather than to the search.
+		static constexpr double TM_SCORE_WEBSERVER_ACCURACY_PERCENTAGE = 5.0;
+
 		/// \brief TODOCUMENT
 		const string NAME_1C55A               { "1c55A" };
 
@@ -345,22 +359,19 @@ BOOST_AUTO_TEST_CASE(tm_score_1c55A_1c56A) {
 	BOOST_CHECK_CLOSE( tm_score().calculate  ( aln_1c55A_1c56A, protein_1c55A, protein_1c56A ), 0.9131980677380123, ACCURACY_PERCENTAGE );
 }
 
-/// \brief Check the TM-score for 1c55A/1wt7A is correct
+/// \brief Check the TM-score for 1c55A/1wt7A is correct (TM-score webserver gave TM-score of 0.58304)
 BOOST_AUTO_TEST_CASE(tm_score_1c55A_1wt7A) {
-	BOOST_WARN_CLOSE( tm_score().calculate  ( aln_1c55A_1wt7A, protein_1c55A, protein_1wt7A ), 0.58304,            ACCURACY_PERCENTAGE );
-	BOOST_CHECK( true );
+	BOOST_CHECK_CLOSE( tm_score().calculate  ( aln_1c55A_1wt7A, protein_1c55A, protein_1wt7A ), 0.58304, TM_SCORE_WEBSERVER_ACCURACY_PERCENTAGE );
 }
 
-/// \brief Check the TM-score for 1c55A/1wmtA is correct
+/// \brief Check the TM-score for 1c55A/1wmtA is correct (TM-score webserver gave TM-score of 0.54228)
 BOOST_AUTO_TEST_CASE(tm_score_1c55A_1wmtA) {
-	BOOST_WARN_CLOSE( tm_score().calculate  ( aln_1c55A_1wmtA, protein_1c55A, protein_1wmtA ), 0.54228,            ACCURACY_PERCENTAGE );
-	BOOST_CHECK( true );
+	BOOST_CHECK_CLOSE( tm_score().calculate  ( aln_1c55A_1wmtA, protein_1c55A, protein_1wmtA ), 0.54228, TM_SCORE_WEBSERVER_ACCURACY_PERCENTAGE );
 }
 
-/// \brief Check the TM-score for 1c55A/1hykA is correct
+/// \brief Check the TM-score for 1c55A/1hykA is correct (TM-score webserver gave TM-score of 0.34689)
 BOOST_AUTO_TEST_CASE(tm_score_1c55A_1hykA) {
-	BOOST_WARN_CLOSE( tm_score().calculate  ( aln_1c55A_1hykA, protein_1c55A, protein_1hykA ), 0.34689,            ACCURACY_PERCENTAGE );
-	BOOST_CHECK( true );
+	BOOST_CHECK_CLOSE( tm_score().calculate  ( aln_1c55A_1hykA, protein_1c55A, protein_1hykA ), 0.34689, TM_SCORE_WEBSERVER_ACCURACY_PERCENTAGE );
 }
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -686,6 +697,46 @@ BOOST_AUTO_TEST_CASE(check_equality_over_lists) {
 	}
 }
 
+/// \brief Test that calculating the full list of scores with shared common coords gives exactly
+///        the same values as calculating each of the scores on its own
+BOOST_AUTO_TEST_CASE(shared_common_coords_give_identical_values) {
+	const aligned_pair_score_list       the_scores = make_full_aligned_pair_score_list();
+	const aligned_pair_score_value_list the_values = make_aligned_pair_score_value_list( the_scores, aln_1c55A_1hykA, protein_1c55A, protein_1hykA );
+	BOOST_REQUIRE_EQUAL( the_values.size(), the_scores.size() );
+	for (size_t score_ctr = 0; score_ctr < the_scores.size(); ++score_ctr) {
+		const score_value unshared_value = the_scores[ score_ctr ].calculate( aln_1c55A_1hykA, protein_1c55A, protein_1hykA );
+		const score_value shared_value   = the_values.get_value_of_index( score_ctr );
+		if ( std::isnan( unshared_value ) ) {
+			BOOST_CHECK( std::isnan( shared_value ) );
+		}
+		else {
+			BOOST_CHECK_EQUAL( shared_value, unshared_value );
+		}
+	}
+}
+
+/// \brief Test that a score_common_coord_cache performs each distinct extraction once
+BOOST_AUTO_TEST_CASE(common_coord_cache_extracts_once_per_handler) {
+	const aligned_pair_score_list the_scores = make_full_aligned_pair_score_list();
+	score_common_coord_cache the_cache{ aln_1c55A_1hykA, protein_1c55A, protein_1hykA };
+	for (const aligned_pair_score &the_score : the_scores) {
+		BOOST_CHECK_NO_THROW( [[maybe_unused]] const score_value value = the_score.calculate( aln_1c55A_1hykA, protein_1c55A, protein_1hykA, the_cache ) );
+	}
+	BOOST_CHECK_GT( the_cache.num_extractions(), 0_z                                        );
+	BOOST_CHECK_LE( the_cache.num_extractions(), get_all_score_common_coord_handlers().size() );
+}
+
+/// \brief Test that a score_common_coord_cache can't be used for a different alignment or proteins
+BOOST_AUTO_TEST_CASE(common_coord_cache_rejects_different_alignment) {
+	score_common_coord_cache the_cache{ aln_1c55A_1hykA, protein_1c55A, protein_1hykA };
+	BOOST_CHECK(   the_cache.is_for( aln_1c55A_1hykA, protein_1c55A, protein_1hykA ) );
+	BOOST_CHECK( ! the_cache.is_for( aln_1c55A_1c56A, protein_1c55A, protein_1c56A ) );
+	BOOST_CHECK_THROW(
+		[[maybe_unused]] const score_value value = rmsd_score().calculate( aln_1c55A_1c56A, protein_1c55A, protein_1c56A, the_cache ),
+		invalid_argument_exception
+	);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE_END()
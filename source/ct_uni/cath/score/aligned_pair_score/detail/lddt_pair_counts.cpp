@@ -0,0 +1,195 @@
+/// \file
+/// \brief The lddt_pair_counts class definitions
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "lddt_pair_counts.hpp"
+
+#include <boost/range/combine.hpp>
+
+#include "cath/common/difference.hpp"
+#include "cath/common/exception/invalid_argument_exception.hpp"
+#include "cath/structure/geometry/coord.hpp"
+#include "cath/structure/geometry/coord_list.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+using namespace ::cath;
+using namespace ::cath::common;
+using namespace ::cath::geom;
+using namespace ::cath::score::detail;
+
+using ::boost::range::combine;
+using ::std::array;
+using ::std::floor;
+using ::std::pair;
+using ::std::vector;
+
+namespace {
+
+	/// \brief The integer indices of a cubic cell in an atom_cell_index
+	using cell_key = array<long, 3>;
+
+	/// \brief Index atoms by the cubic cell of a fixed size in which they lie so that all the atoms
+	///        within that distance of a point can be found by checking only the 27 surrounding cells
+	class atom_cell_index final {
+	private:
+		/// \brief The length of the side of each cubic cell
+		double cell_size;
+
+		/// \brief The cell key of each atom with the atom's index, sorted by cell key
+		vector<pair<cell_key, size_t>> entries;
+
+		/// \brief Get the key of the cell containing the specified coord
+		[[nodiscard]] cell_key key_of(const coord &prm_coord ///< The coord to query
+		                              ) const {
+			return {
+				static_cast<long>( floor( prm_coord.get_x() / cell_size ) ),
+				static_cast<long>( floor( prm_coord.get_y() / cell_size ) ),
+				static_cast<long>( floor( prm_coord.get_z() / cell_size ) ),
+			};
+		}
+
+	public:
+		/// \brief Ctor from the atoms to index and the size of the cells
+		atom_cell_index(const coord_vec &prm_atoms,    ///< The atoms to index
+		                const double    &prm_cell_size ///< The length of the side of each cubic cell
+		                ) : cell_size{ prm_cell_size } {
+			entries.reserve( prm_atoms.size() );
+			for (size_t atom_ctr = 0; atom_ctr < prm_atoms.size(); ++atom_ctr) {
+				entries.emplace_back( key_of( prm_atoms[ atom_ctr ] ), atom_ctr );
+			}
+			std::sort( entries.begin(), entries.end() );
+		}
+
+		/// \brief Call the specified function with the index of each atom in the cells
+		///        around the specified coord (which includes all atoms within cell_size of it)
+		template <typename FN>
+		void for_each_candidate(const coord &prm_coord, ///< The coord about which to find atoms
+		                        FN         &&prm_fn     ///< The function to call with each candidate atom's index
+		                        ) const {
+			const cell_key centre_key = key_of( prm_coord );
+			for (long x_offset = -1; x_offset <= 1; ++x_offset) {
+				for (long y_offset = -1; y_offset <= 1; ++y_offset) {
+					const cell_key begin_key{ centre_key[ 0 ] + x_offset, centre_key[ 1 ] + y_offset, centre_key[ 2 ] - 1 };
+					const cell_key end_key  { centre_key[ 0 ] + x_offset, centre_key[ 1 ] + y_offset, centre_key[ 2 ] + 2 };
+					// The three cells that differ only in z are contiguous in the sorted entries
+					const auto begin_itr = std::lower_bound(
+						entries.begin(), entries.end(), begin_key,
+						[] (const pair<cell_key, size_t> &x, const cell_key &y) { return x.first < y; }
+					);
+					for (auto entry_itr = begin_itr; entry_itr != entries.end() && entry_itr->first < end_key; ++entry_itr) {
+						prm_fn( entry_itr->second );
+					}
+				}
+			}
+		}
+	};
+
+	/// \brief Add the specified contribution to the counts of the thresholds under which the specified difference falls
+	void add_to_counts(lddt_pair_counts &prm_counts,     ///< The counts to update
+	                   const doub_vec   &prm_thresholds, ///< The thresholds
+	                   const double     &prm_difference, ///< The difference in the atom pair's distances between the two structures
+	                   const size_t     &prm_num_within  ///< The number of structures in which the atom pair lie within R_0
+	                   ) {
+		for (size_t threshold_ctr = 0; threshold_ctr < prm_thresholds.size(); ++threshold_ctr) {
+			if ( prm_difference < prm_thresholds[ threshold_ctr ] ) {
+				prm_counts.counts_within_thresholds[ threshold_ctr ] += prm_num_within;
+			}
+		}
+		prm_counts.all_count += prm_num_within;
+	}
+
+} // namespace
+
+/// \brief Calculate the lddt_pair_counts for the specified common coords
+///
+/// Only atom pairs that lie within R_0 in at least one of the structures contribute, so this finds those pairs
+/// through a cell index of each structure (with cells of side R_0) rather than trying all pairs of atoms.
+/// Each pair's distance difference is calculated once and compared against all the thresholds.
+///
+/// This gives exactly the same counts as trying every atom pair in every pair of residues.
+///
+/// \pre prm_coords_a and prm_coords_b must have the same number of residues and the same number of atoms
+///      in each residue, else an invalid_argument_exception will be thrown
+lddt_pair_counts cath::score::detail::calc_lddt_pair_counts(const coord_list_vec &prm_coords_a,   ///< The common coords of the first  structure, by residue
+                                                            const coord_list_vec &prm_coords_b,   ///< The common coords of the second structure, by residue
+                                                            const doub_vec       &prm_thresholds, ///< The distance-difference thresholds
+                                                            const double         &prm_r_0         ///< The inclusion radius, R_0
+                                                            ) {
+	if ( prm_coords_a.size() != prm_coords_b.size() ) {
+		BOOST_THROW_EXCEPTION(invalid_argument_exception("Cannot calculate lDDT counts for different numbers of residues"));
+	}
+
+	// Flatten the atoms, recording the residue of each
+	coord_vec atoms_a;
+	coord_vec atoms_b;
+	size_vec  residue_of_atom;
+	for (size_t residue_ctr = 0; residue_ctr < prm_coords_a.size(); ++residue_ctr) {
+		if ( prm_coords_a[ residue_ctr ].size() != prm_coords_b[ residue_ctr ].size() ) {
+			BOOST_THROW_EXCEPTION(invalid_argument_exception("Cannot calculate lDDT counts for residues with different numbers of atoms"));
+		}
+		for (const auto &[ coord_a, coord_b ] : combine( prm_coords_a[ residue_ctr ], prm_coords_b[ residue_ctr ] ) ) {
+			atoms_a.push_back( coord_a );
+			atoms_b.push_back( coord_b );
+			residue_of_atom.push_back( residue_ctr );
+		}
+	}
+
+	const atom_cell_index index_a{ atoms_a, prm_r_0 };
+	const atom_cell_index index_b{ atoms_b, prm_r_0 };
+
+	lddt_pair_counts result;
+	result.counts_within_thresholds.assign( prm_thresholds.size(), 0 );
+
+	for (size_t atom_ctr_1 = 0; atom_ctr_1 < atoms_a.size(); ++atom_ctr_1) {
+		const size_t &residue_1 = residue_of_atom[ atom_ctr_1 ];
+
+		// Pairs within R_0 in the first structure (which may or may not be within R_0 in the second)
+		index_a.for_each_candidate( atoms_a[ atom_ctr_1 ], [&] (const size_t &atom_ctr_2) {
+			if ( residue_of_atom[ atom_ctr_2 ] <= residue_1 ) {
+				return;
+			}
+			const double distance_a = distance_between_points( atoms_a[ atom_ctr_1 ], atoms_a[ atom_ctr_2 ] );
+			if ( distance_a < prm_r_0 ) {
+				const double distance_b = distance_between_points( atoms_b[ atom_ctr_1 ], atoms_b[ atom_ctr_2 ] );
+				add_to_counts( result, prm_thresholds, difference( distance_a, distance_b ), ( distance_b < prm_r_0 ) ? 2 : 1 );
+			}
+		} );
+
+		// Pairs within R_0 in the second structure only
+		index_b.for_each_candidate( atoms_b[ atom_ctr_1 ], [&] (const size_t &atom_ctr_2) {
+			if ( residue_of_atom[ atom_ctr_2 ] <= residue_1 ) {
+				return;
+			}
+			const double distance_b = distance_between_points( atoms_b[ atom_ctr_1 ], atoms_b[ atom_ctr_2 ] );
+			if ( distance_b < prm_r_0 ) {
+				const double distance_a = distance_between_points( atoms_a[ atom_ctr_1 ], atoms_a[ atom_ctr_2 ] );
+				if ( ! ( distance_a < prm_r_0 ) ) {
+					add_to_counts( result, prm_thresholds, difference( distance_a, distance_b ), 1 );
+				}
+			}
+		} );
+	}
+
+	return result;
+}
@@ -0,0 +1,49 @@
+/// \file
+/// \brief The lddt_pair_counts class header
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef CATH_TOOLS_SOURCE_CT_UNI_CATH_SCORE_ALIGNED_PAIR_SCORE_DETAIL_LDDT_PAIR_COUNTS_HPP
+#define CATH_TOOLS_SOURCE_CT_UNI_CATH_SCORE_ALIGNED_PAIR_SCORE_DETAIL_LDDT_PAIR_COUNTS_HPP
+
+#include "cath/common/type_aliases.hpp"
+#include "cath/structure/structure_type_aliases.hpp"
+
+namespace cath::score::detail {
+
+	/// \brief The counts from which an lDDT score is calculated
+	///
+	/// Each atom pair (from different aligned residues) contributes one for each structure
+	/// in which the two atoms lie within R_0 of each other. It contributes that to all_count
+	/// and to the count of each threshold that its distance difference is under.
+	struct lddt_pair_counts final {
+		/// \brief The count for each threshold, in the same order as the thresholds
+		size_vec counts_within_thresholds;
+
+		/// \brief The total count over all the atom pairs
+		size_t all_count = 0;
+	};
+
+	lddt_pair_counts calc_lddt_pair_counts(const geom::coord_list_vec &,
+	                                       const geom::coord_list_vec &,
+	                                       const doub_vec &,
+	                                       const double &);
+
+} // namespace cath::score::detail
+
+#endif // CATH_TOOLS_SOURCE_CT_UNI_CATH_SCORE_ALIGNED_PAIR_SCORE_DETAIL_LDDT_PAIR_COUNTS_HPP
@@ -0,0 +1,154 @@
+/// \file
+/// \brief The lddt_pair_counts test suite
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "lddt_pair_counts.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include "cath/common/difference.hpp"
+#include "cath/common/exception/invalid_argument_exception.hpp"
+#include "cath/structure/geometry/coord.hpp"
+#include "cath/structure/geometry/coord_list.hpp"
+
+#include <random>
+
+using namespace ::cath;
+using namespace ::cath::common;
+using namespace ::cath::geom;
+using namespace ::cath::score::detail;
+
+using ::std::mt19937;
+using ::std::normal_distribution;
+using ::std::uniform_int_distribution;
+
+namespace {
+
+	/// \brief The lddt_pair_counts_test_suite_fixture to assist in testing lddt_pair_counts
+	struct lddt_pair_counts_test_suite_fixture {
+	protected:
+		~lddt_pair_counts_test_suite_fixture() noexcept = default;
+
+		/// \brief lDDT's standard R_0
+		static constexpr double R_0 = 15.0;
+
+		/// \brief lDDT's standard thresholds
+		const doub_vec thresholds{ 0.5, 1.0, 2.0, 4.0 };
+
+		/// \brief Make a compact random walk of residues, each with the specified number of atoms,
+		///        and a perturbed copy of it
+		static std::pair<coord_list_vec, coord_list_vec> make_perturbed_pair(mt19937      &prm_rng,          ///< The random number generator
+		                                                                     const size_t &prm_num_residues, ///< The number of residues
+		                                                                     const size_t &prm_max_atoms     ///< The maximum number of atoms per residue
+		                                                                     ) {
+			normal_distribution<double>      step_dist { 0.0, 2.2 };
+			normal_distribution<double>      noise_dist{ 0.0, 1.2 };
+			uniform_int_distribution<size_t> atoms_dist{ 1, prm_max_atoms };
+			coord_list_vec coords_a;
+			coord_list_vec coords_b;
+			coord          position = ORIGIN_COORD;
+			for (size_t residue_ctr = 0; residue_ctr < prm_num_residues; ++residue_ctr) {
+				// Pull the walk back towards the origin to keep it protein-like in its compactness
+				position = 0.97 * position + coord{ step_dist( prm_rng ), step_dist( prm_rng ), step_dist( prm_rng ) };
+				coord_vec atoms_a;
+				coord_vec atoms_b;
+				const size_t num_atoms = atoms_dist( prm_rng );
+				for (size_t atom_ctr = 0; atom_ctr < num_atoms; ++atom_ctr) {
+					atoms_a.push_back( position + coord{ noise_dist( prm_rng ), noise_dist( prm_rng ), noise_dist( prm_rng ) } );
+					atoms_b.push_back( atoms_a.back() + coord{ noise_dist( prm_rng ), noise_dist( prm_rng ), noise_dist( prm_rng ) } );
+				}
+				coords_a.emplace_back( atoms_a );
+				coords_b.emplace_back( atoms_b );
+			}
+			return { coords_a, coords_b };
+		}
+
+		/// \brief Calculate the lddt_pair_counts by trying every atom pair in every pair of residues
+		static lddt_pair_counts brute_force_counts(const coord_list_vec &prm_coords_a,  ///< The common coords of the first  structure, by residue
+		                                           const coord_list_vec &prm_coords_b,  ///< The common coords of the second structure, by residue
+		                                           const doub_vec       &prm_thresholds ///< The distance-difference thresholds
+		                                           ) {
+			lddt_pair_counts result;
+			result.counts_within_thresholds.assign( prm_thresholds.size(), 0 );
+			for (size_t res_ctr_1 = 0; res_ctr_1 < prm_coords_a.size(); ++res_ctr_1) {
+				for (size_t res_ctr_2 = res_ctr_1 + 1; res_ctr_2 < prm_coords_a.size(); ++res_ctr_2) {
+					for (size_t atom_ctr_1 = 0; atom_ctr_1 < prm_coords_a[ res_ctr_1 ].size(); ++atom_ctr_1) {
+						for (size_t atom_ctr_2 = 0; atom_ctr_2 < prm_coords_a[ res_ctr_2 ].size(); ++atom_ctr_2) {
+							const double distance_a = distance_between_points( prm_coords_a[ res_ctr_1 ][ atom_ctr_1 ], prm_coords_a[ res_ctr_2 ][ atom_ctr_2 ] );
+							const double distance_b = distance_between_points( prm_coords_b[ res_ctr_1 ][ atom_ctr_1 ], prm_coords_b[ res_ctr_2 ][ atom_ctr_2 ] );
+							const size_t num_within = ( distance_a < R_0 ? 1 : 0 ) + ( distance_b < R_0 ? 1 : 0 );
+							for (size_t threshold_ctr = 0; threshold_ctr < prm_thresholds.size(); ++threshold_ctr) {
+								if ( difference( distance_a, distance_b ) < prm_thresholds[ threshold_ctr ] ) {
+									result.counts_within_thresholds[ threshold_ctr ] += num_within;
+								}
+							}
+							result.all_count += num_within;
+						}
+					}
+				}
+			}
+			return result;
+		}
+
+		/// \brief Check that calc_lddt_pair_counts() matches brute_force_counts() for the specified coords
+		void check_matches_brute_force(const coord_list_vec &prm_coords_a, ///< The common coords of the first  structure, by residue
+		                               const coord_list_vec &prm_coords_b  ///< The common coords of the second structure, by residue
+		                               ) const {
+			const lddt_pair_counts got      = calc_lddt_pair_counts( prm_coords_a, prm_coords_b, thresholds, R_0 );
+			const lddt_pair_counts expected = brute_force_counts   ( prm_coords_a, prm_coords_b, thresholds      );
+			BOOST_CHECK_EQUAL( got.all_count, expected.all_count );
+			BOOST_CHECK_EQUAL_COLLECTIONS(
+				got.counts_within_thresholds.begin(),      got.counts_within_thresholds.end(),
+				expected.counts_within_thresholds.begin(), expected.counts_within_thresholds.end()
+			);
+		}
+	};
+
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE(lddt_pair_counts_test_suite, lddt_pair_counts_test_suite_fixture)
+
+BOOST_AUTO_TEST_CASE(matches_brute_force_for_single_atom_residues) {
+	mt19937 rng{ 1 };
+	const auto [ coords_a, coords_b ] = make_perturbed_pair( rng, 300, 1 );
+	check_matches_brute_force( coords_a, coords_b );
+}
+
+BOOST_AUTO_TEST_CASE(matches_brute_force_for_multi_atom_residues) {
+	mt19937 rng{ 2 };
+	const auto [ coords_a, coords_b ] = make_perturbed_pair( rng, 120, 4 );
+	check_matches_brute_force( coords_a, coords_b );
+}
+
+BOOST_AUTO_TEST_CASE(counts_pairs_within_r_0_in_only_one_structure) {
+	const coord_list_vec coords_a{ coord_list{ coord_vec{ coord{ 0.0, 0.0, 0.0 } } }, coord_list{ coord_vec{ coord{ 14.0, 0.0, 0.0 } } } };
+	const coord_list_vec coords_b{ coord_list{ coord_vec{ coord{ 0.0, 0.0, 0.0 } } }, coord_list{ coord_vec{ coord{ 16.0, 0.0, 0.0 } } } };
+	const lddt_pair_counts got = calc_lddt_pair_counts( coords_a, coords_b, thresholds, R_0 );
+	BOOST_CHECK_EQUAL( got.all_count, 1 );
+	BOOST_CHECK_EQUAL( got.counts_within_thresholds.back(), 1 );
+	BOOST_CHECK_EQUAL( got.counts_within_thresholds.front(), 0 );
+	check_matches_brute_force( coords_a, coords_b );
+}
+
+BOOST_AUTO_TEST_CASE(throws_on_mismatched_residues) {
+	const coord_list_vec one_residue{ coord_list{ coord_vec{ ORIGIN_COORD } } };
+	BOOST_CHECK_THROW( calc_lddt_pair_counts( one_residue, {}, thresholds, R_0 ), invalid_argument_exception );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
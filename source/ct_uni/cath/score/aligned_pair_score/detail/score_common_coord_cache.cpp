@@ -0,0 +1,98 @@
+/// \file
+/// \brief The score_common_coord_cache class definitions
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "score_common_coord_cache.hpp"
+
+using namespace ::cath;
+using namespace ::cath::align;
+using namespace ::cath::geom;
+using namespace ::cath::score::detail;
+using namespace ::cath::sup;
+
+using ::std::pair;
+
+/// \brief Get the entry for the specified score_common_coord_handler, extracting its common coords if they aren't already cached
+score_common_coord_cache::entry & score_common_coord_cache::get_entry(const score_common_coord_handler &prm_coord_handler ///< The score_common_coord_handler whose extraction is required
+                                                                      ) {
+	const auto find_itr = entry_of_handler.find( prm_coord_handler );
+	if ( find_itr != entry_of_handler.end() ) {
+		return find_itr->second;
+	}
+	return entry_of_handler.emplace(
+		prm_coord_handler,
+		entry{ prm_coord_handler.get_common_coords_by_residue( the_alignment, protein_a, protein_b ), {}, {} }
+	).first->second;
+}
+
+/// \brief Ctor from the alignment and associated proteins whose common coords are to be cached
+score_common_coord_cache::score_common_coord_cache(const alignment &prm_alignment, ///< The pair alignment whose common coords are to be cached
+                                                   const protein   &prm_protein_a, ///< The protein associated with the first  half of the alignment
+                                                   const protein   &prm_protein_b  ///< The protein associated with the second half of the alignment
+                                                   ) : the_alignment { prm_alignment },
+                                                       protein_a     { prm_protein_a },
+                                                       protein_b     { prm_protein_b } {
+}
+
+/// \brief Whether this cache is for the specified alignment and proteins (as identified by their addresses)
+bool score_common_coord_cache::is_for(const alignment &prm_alignment, ///< The pair alignment
+                                      const protein   &prm_protein_a, ///< The protein associated with the first  half of the alignment
+                                      const protein   &prm_protein_b  ///< The protein associated with the second half of the alignment
+                                      ) const {
+	return ( &the_alignment == &prm_alignment )
+		&& ( &protein_a     == &prm_protein_a )
+		&& ( &protein_b     == &prm_protein_b );
+}
+
+/// \brief The number of distinct extractions that have been performed
+size_t score_common_coord_cache::num_extractions() const {
+	return entry_of_handler.size();
+}
+
+/// \brief Get the (flattened) common coords for the specified score_common_coord_handler
+///
+/// These are the same as the flattened common coords by residue so, like them, they are only extracted once
+const coord_list_coord_list_pair & score_common_coord_cache::get_common_coords(const score_common_coord_handler &prm_coord_handler ///< The score_common_coord_handler whose extraction is required
+                                                                               ) {
+	entry &the_entry = get_entry( prm_coord_handler );
+	if ( ! the_entry.common_coords ) {
+		the_entry.common_coords.emplace(
+			flatten_coord_lists( the_entry.common_coords_by_residue.first  ),
+			flatten_coord_lists( the_entry.common_coords_by_residue.second )
+		);
+	}
+	return *the_entry.common_coords;
+}
+
+/// \brief Get the common coords by residue for the specified score_common_coord_handler
+const pair<coord_list_vec, coord_list_vec> & score_common_coord_cache::get_common_coords_by_residue(const score_common_coord_handler &prm_coord_handler ///< The score_common_coord_handler whose extraction is required
+                                                                                                   ) {
+	return get_entry( prm_coord_handler ).common_coords_by_residue;
+}
+
+/// \brief Get the pairwise superposition of the common coords for the specified score_common_coord_handler
+const superposition & score_common_coord_cache::get_superposition(const score_common_coord_handler &prm_coord_handler ///< The score_common_coord_handler whose extraction is required
+                                                                  ) {
+	const coord_list_coord_list_pair &common_coords = get_common_coords( prm_coord_handler );
+	entry &the_entry = get_entry( prm_coord_handler );
+	if ( ! the_entry.the_superposition ) {
+		the_entry.the_superposition.emplace( create_pairwise_superposition( common_coords.first, common_coords.second ) );
+	}
+	return *the_entry.the_superposition;
+}
@@ -0,0 +1,98 @@
+/// \file
+/// \brief The score_common_coord_cache class header
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef CATH_TOOLS_SOURCE_CT_UNI_CATH_SCORE_ALIGNED_PAIR_SCORE_DETAIL_SCORE_COMMON_COORD_CACHE_HPP
+#define CATH_TOOLS_SOURCE_CT_UNI_CATH_SCORE_ALIGNED_PAIR_SCORE_DETAIL_SCORE_COMMON_COORD_CACHE_HPP
+
+#include "cath/score/aligned_pair_score/detail/score_common_coord_handler.hpp"
+#include "cath/structure/geometry/coord_list.hpp"
+#include "cath/structure/structure_type_aliases.hpp"
+#include "cath/superposition/superposition.hpp"
+
+#include <map>
+#include <optional>
+#include <utility>
+
+// clang-format off
+namespace cath { class protein; }
+namespace cath::align { class alignment; }
+// clang-format on
+
+namespace cath::score::detail {
+
+	/// \brief Cache the common coords (and their superpositions) extracted by score_common_coord_handlers
+	///        for one alignment and its pair of proteins so that each distinct extraction is only done once
+	///        when evaluating many aligned_pair_scores on that alignment
+	///
+	/// Many varieties of aligned_pair_score share the same pair of common_residue_selection_policy and
+	/// common_atom_selection_policy and so would otherwise repeat the same extraction (and superposition)
+	/// for the same alignment.
+	///
+	/// A score_common_coord_cache is passed explicitly through aligned_pair_score::calculate() (and on to
+	/// any scores or length_getters from which a score is composed) so that they can all share it.
+	///
+	/// The alignment and proteins must outlive the cache and must not be modified while it is alive.
+	class score_common_coord_cache final {
+	private:
+		/// \brief The extractions (and superposition) for one score_common_coord_handler
+		struct entry final {
+			/// \brief The common coords, by residue
+			std::pair<geom::coord_list_vec, geom::coord_list_vec> common_coords_by_residue;
+
+			/// \brief The common coords, flattened (populated on first request)
+			std::optional<geom::coord_list_coord_list_pair> common_coords;
+
+			/// \brief The superposition of the common coords (populated on first request)
+			std::optional<sup::superposition> the_superposition;
+		};
+
+		/// \brief The alignment whose common coords are cached
+		const align::alignment &the_alignment;
+
+		/// \brief The protein associated with the first half of the alignment
+		const protein &protein_a;
+
+		/// \brief The protein associated with the second half of the alignment
+		const protein &protein_b;
+
+		/// \brief The entries, by the score_common_coord_handler that extracts them
+		std::map<score_common_coord_handler, entry> entry_of_handler;
+
+		entry & get_entry(const score_common_coord_handler &);
+
+	public:
+		score_common_coord_cache(const align::alignment &,
+		                         const protein &,
+		                         const protein &);
+
+		[[nodiscard]] bool is_for(const align::alignment &,
+		                          const protein &,
+		                          const protein &) const;
+
+		[[nodiscard]] size_t num_extractions() const;
+
+		const geom::coord_list_coord_list_pair & get_common_coords(const score_common_coord_handler &);
+		const std::pair<geom::coord_list_vec, geom::coord_list_vec> & get_common_coords_by_residue(const score_common_coord_handler &);
+		const sup::superposition & get_superposition(const score_common_coord_handler &);
+	};
+
+} // namespace cath::score::detail
+
+#endif // CATH_TOOLS_SOURCE_CT_UNI_CATH_SCORE_ALIGNED_PAIR_SCORE_DETAIL_SCORE_COMMON_COORD_CACHE_HPP
@@ -0,0 +1,212 @@
+/// \file
+/// \brief The tm_score_search class definitions
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "tm_score_search.hpp"
+
+#include <boost/range/combine.hpp>
+
+#include "cath/common/exception/invalid_argument_exception.hpp"
+#include "cath/structure/geometry/coord.hpp"
+#include "cath/structure/geometry/coord_list.hpp"
+#include "cath/structure/geometry/qcp_superpose.hpp"
+#include "cath/structure/geometry/rotation.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace ::cath::common;
+using namespace ::cath::geom;
+using namespace ::cath::score;
+using namespace ::cath::score::detail;
+
+using ::boost::range::combine;
+using ::std::clamp;
+using ::std::isfinite;
+using ::std::max;
+using ::std::min;
+using ::std::numeric_limits;
+using ::std::sqrt;
+
+/// \brief Ctor from the step by which each seed window should be slid along the alignment
+///
+/// A step of 1 reproduces the TM-score program's search; larger steps trade accuracy for speed
+tm_score_search::tm_score_search(const size_t &prm_seed_step ///< The step by which each seed window should be slid along the alignment
+                                 ) : seed_step{ prm_seed_step } {
+	if ( seed_step == 0 ) {
+		BOOST_THROW_EXCEPTION(invalid_argument_exception("The step by which TM-score seed windows are slid must be positive"));
+	}
+}
+
+/// \brief The number of aligned pairs in the current coords
+size_t tm_score_search::num_pairs() const {
+	return atom_offsets.empty() ? 0 : atom_offsets.size() - 1;
+}
+
+/// \brief Superpose the first structure's atoms of the aligned pairs in subset onto the second's and
+///        then store in distances the resulting distance for every aligned pair
+void tm_score_search::superpose_on_subset_and_calc_distances() {
+	subset_coords_a.clear();
+	subset_coords_b.clear();
+	for (const size_t &pair_index : subset) {
+		const size_t begin_value = 3 * atom_offsets[ pair_index     ];
+		const size_t end_value   = 3 * atom_offsets[ pair_index + 1 ];
+		subset_coords_a.insert( subset_coords_a.end(), coords_a.begin() + begin_value, coords_a.begin() + end_value );
+		subset_coords_b.insert( subset_coords_b.end(), coords_b.begin() + begin_value, coords_b.begin() + end_value );
+	}
+
+	const qcp_inner_products inner_products = make_qcp_inner_products(
+		subset_coords_a.data(),
+		subset_coords_b.data(),
+		subset_coords_a.size() / 3
+	);
+	const rotation the_rotation = qcp_rotation_1st_to_2nd( inner_products );
+	const coord   &centre_a     = inner_products.get_centre_a();
+	const coord   &centre_b     = inner_products.get_centre_b();
+
+	distances.resize( num_pairs() );
+	for (size_t pair_ctr = 0; pair_ctr < num_pairs(); ++pair_ctr) {
+		double total_distance = 0.0;
+		for (size_t atom_ctr = atom_offsets[ pair_ctr ]; atom_ctr < atom_offsets[ pair_ctr + 1 ]; ++atom_ctr) {
+			const coord coord_a{ coords_a[ 3 * atom_ctr ], coords_a[ 3 * atom_ctr + 1 ], coords_a[ 3 * atom_ctr + 2 ] };
+			const coord coord_b{ coords_b[ 3 * atom_ctr ], coords_b[ 3 * atom_ctr + 1 ], coords_b[ 3 * atom_ctr + 2 ] };
+			total_distance += length( rotate_copy( the_rotation, coord_a - centre_a ) - ( coord_b - centre_b ) );
+		}
+		distances[ pair_ctr ] = total_distance / static_cast<double>( atom_offsets[ pair_ctr + 1 ] - atom_offsets[ pair_ctr ] );
+	}
+}
+
+/// \brief Calculate the (un-normalised) TM-score sum for the current distances and store in next_subset
+///        the aligned pairs with distances under the specified cutoff
+///
+/// As in the TM-score program, the cutoff is relaxed in steps of 0.5 until at least three pairs
+/// are selected (unless there are three or fewer pairs in total). The relaxing stops once the
+/// cutoff exceeds the largest finite distance.
+///
+/// A non-finite distance (eg from degenerate coords) is treated as infinitely far: it contributes
+/// nothing to the score and is never selected.
+score_value tm_score_search::score_and_select_within(const double &prm_d0,    ///< The d0 for the target length
+                                                     double        prm_cutoff ///< The initial distance cutoff for selecting pairs
+                                                     ) {
+	score_value score               = 0.0;
+	double      max_finite_distance = -numeric_limits<double>::infinity();
+	for (const double &distance : distances) {
+		if ( isfinite( distance ) ) {
+			const double fraction = distance / prm_d0;
+			score += 1.0 / ( 1.0 + fraction * fraction );
+			max_finite_distance = max( max_finite_distance, distance );
+		}
+	}
+
+	const size_t min_num_selected = min( num_pairs(), size_t{ 3 } );
+	while ( true ) {
+		next_subset.clear();
+		for (size_t pair_ctr = 0; pair_ctr < num_pairs(); ++pair_ctr) {
+			if ( distances[ pair_ctr ] < prm_cutoff ) {
+				next_subset.push_back( pair_ctr );
+			}
+		}
+		if ( next_subset.size() >= min_num_selected || prm_cutoff > max_finite_distance ) {
+			return score;
+		}
+		prm_cutoff += CUTOFF_RELAXATION_STEP;
+	}
+}
+
+/// \brief Set the lists of common coords (one coord_list per aligned pair) on which to search
+///
+/// \pre `prm_coords_a.size() == prm_coords_b.size()` and each corresponding pair of coord_lists
+///      must be non-empty and of equal size, else an invalid_argument_exception will be thrown
+void tm_score_search::set_coords(const coord_list_vec &prm_coords_a, ///< The common coords of the first  structure, by aligned pair
+                                 const coord_list_vec &prm_coords_b  ///< The common coords of the second structure, by aligned pair
+                                 ) {
+	if ( prm_coords_a.size() != prm_coords_b.size() ) {
+		BOOST_THROW_EXCEPTION(invalid_argument_exception("Cannot search for the TM-score of different numbers of aligned pairs"));
+	}
+	coords_a.clear();
+	coords_b.clear();
+	atom_offsets.assign( 1, 0 );
+	for (const auto &[ coord_list_a, coord_list_b ] : combine( prm_coords_a, prm_coords_b ) ) {
+		check_non_empty_and_equal_size( coord_list_a, coord_list_b );
+		for (const auto &[ coord_a, coord_b ] : combine( coord_list_a, coord_list_b ) ) {
+			coords_a.insert( coords_a.end(), { coord_a.get_x(), coord_a.get_y(), coord_a.get_z() } );
+			coords_b.insert( coords_b.end(), { coord_b.get_x(), coord_b.get_y(), coord_b.get_z() } );
+		}
+		atom_offsets.push_back( coords_a.size() / 3 );
+	}
+}
+
+/// \brief Get the best TM-score that can be found for the current coords, normalised by the specified target length
+score_value tm_score_search::best_score_for_target_length(const score_value &prm_target_length ///< The length by which to normalise the TM-score
+                                                          ) {
+	const size_t n = num_pairs();
+	if ( n == 0 ) {
+		return 0.0;
+	}
+
+	const double d0        = d0_of_target_length( prm_target_length );
+	const double d0_search = clamp( d0, 4.5, 8.0 );
+
+	// Choose the seed window lengths: n, n/2, n/4, ... down to MIN_SEED_LENGTH
+	const size_t min_seed_length = min( n, MIN_SEED_LENGTH );
+	size_vec     seed_lengths;
+	for (size_t length_ctr = 0; length_ctr + 1 < MAX_NUM_SEED_LENGTHS; ++length_ctr) {
+		const size_t seed_length = ( n >> length_ctr );
+		if ( seed_length <= min_seed_length ) {
+			break;
+		}
+		seed_lengths.push_back( seed_length );
+	}
+	seed_lengths.push_back( min_seed_length );
+
+	score_value best_score = 0.0;
+	for (const size_t &seed_length : seed_lengths) {
+		for (size_t seed_start = 0; seed_start + seed_length <= n; seed_start += seed_step) {
+			subset.resize( seed_length );
+			for (size_t subset_ctr = 0; subset_ctr < seed_length; ++subset_ctr) {
+				subset[ subset_ctr ] = seed_start + subset_ctr;
+			}
+			superpose_on_subset_and_calc_distances();
+			best_score = max( best_score, score_and_select_within( d0, d0_search - 1.0 ) );
+
+			for (size_t iter_ctr = 0; iter_ctr < MAX_ITERATIONS && ! next_subset.empty(); ++iter_ctr) {
+				subset.swap( next_subset );
+				superpose_on_subset_and_calc_distances();
+				best_score = max( best_score, score_and_select_within( d0, d0_search + 1.0 ) );
+				if ( next_subset == subset ) {
+					break;
+				}
+			}
+		}
+	}
+	return best_score / prm_target_length;
+}
+
+/// \brief Get the TM-score's d0 distance scale for the specified target length
+///
+/// As in the TM-score program, this is `1.24 * cbrt( L - 15 ) - 1.8` for lengths over 15,
+/// with a minimum of 0.5
+double tm_score_search::d0_of_target_length(const score_value &prm_target_length ///< The target length
+                                            ) {
+	if ( prm_target_length <= 15.0 ) {
+		return 0.5;
+	}
+	return max( 0.5, 1.24 * cbrt( prm_target_length - 15.0 ) - 1.8 );
+}
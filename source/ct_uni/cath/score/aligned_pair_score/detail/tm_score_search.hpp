@@ -0,0 +1,105 @@
+/// \file
+/// \brief The tm_score_search class header
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef CATH_TOOLS_SOURCE_CT_UNI_CATH_SCORE_ALIGNED_PAIR_SCORE_DETAIL_TM_SCORE_SEARCH_HPP
+#define CATH_TOOLS_SOURCE_CT_UNI_CATH_SCORE_ALIGNED_PAIR_SCORE_DETAIL_TM_SCORE_SEARCH_HPP
+
+#include "cath/common/type_aliases.hpp"
+#include "cath/score/score_type_aliases.hpp"
+#include "cath/structure/structure_type_aliases.hpp"
+
+namespace cath::score::detail {
+
+	/// \brief Search for the superposition that maximises the TM-score of a pair of lists of
+	///        common coords (one coord_list per aligned residue pair)
+	///
+	/// This follows the search in Zhang and Skolnick's TM-score program:
+	///  - seed superpositions from windows of consecutive aligned pairs of lengths n, n/2, n/4, ... (min 4),
+	///    sliding each window along the alignment in steps of seed_step
+	///  - from each seed, repeatedly re-superpose on the pairs that lie within a distance cutoff
+	///    (derived from d0) until that subset stops changing (or for at most 20 iterations)
+	///  - return the best TM-score seen for any of those superpositions
+	///
+	/// Each superposition uses the allocation-free QCP fitter. The coords and all working
+	/// buffers are held in the object so that reusing one tm_score_search (eg a thread_local one)
+	/// for many pairs avoids repeated allocation.
+	///
+	/// Within each pair, the residue's distance is the mean distance between its corresponding atoms.
+	class tm_score_search final {
+	private:
+		/// \brief The step by which each seed window is slid along the alignment
+		size_t seed_step = 1;
+
+		/// \brief The interleaved coords (x0, y0, z0, x1, ...) of all the atoms of the first structure's aligned residues
+		doub_vec coords_a;
+
+		/// \brief The interleaved coords (x0, y0, z0, x1, ...) of all the atoms of the second structure's aligned residues
+		doub_vec coords_b;
+
+		/// \brief The offset of each aligned pair's first atom in the coords (with an extra final entry for the total)
+		size_vec atom_offsets;
+
+		/// \brief Buffer for the first structure's coords of the pairs in the current subset
+		doub_vec subset_coords_a;
+
+		/// \brief Buffer for the second structure's coords of the pairs in the current subset
+		doub_vec subset_coords_b;
+
+		/// \brief Buffer for the distance of each aligned pair under the current superposition
+		doub_vec distances;
+
+		/// \brief Buffer for the indices of the aligned pairs on which to superpose
+		size_vec subset;
+
+		/// \brief Buffer for the indices of the aligned pairs under the cutoff after the current superposition
+		size_vec next_subset;
+
+		[[nodiscard]] size_t num_pairs() const;
+		void superpose_on_subset_and_calc_distances();
+		score_value score_and_select_within(const double &,
+		                                    double);
+
+	public:
+		tm_score_search() = default;
+		explicit tm_score_search(const size_t &);
+
+		void set_coords(const geom::coord_list_vec &,
+		                const geom::coord_list_vec &);
+
+		score_value best_score_for_target_length(const score_value &);
+
+		static double d0_of_target_length(const score_value &);
+
+		/// \brief The maximum number of refinement iterations from each seed
+		static constexpr size_t MAX_ITERATIONS = 20;
+
+		/// \brief The minimum length of a seed window
+		static constexpr size_t MIN_SEED_LENGTH = 4;
+
+		/// \brief The maximum number of seed window lengths to try
+		static constexpr size_t MAX_NUM_SEED_LENGTHS = 6;
+
+		/// \brief The step by which the cutoff is relaxed when too few pairs lie within it
+		static constexpr double CUTOFF_RELAXATION_STEP = 0.5;
+	};
+
+} // namespace cath::score::detail
+
+#endif // CATH_TOOLS_SOURCE_CT_UNI_CATH_SCORE_ALIGNED_PAIR_SCORE_DETAIL_TM_SCORE_SEARCH_HPP
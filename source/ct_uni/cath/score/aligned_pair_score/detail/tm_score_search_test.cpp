@@ -0,0 +1,147 @@
+/// \file
+/// \brief The tm_score_search test suite
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "tm_score_search.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include "cath/common/exception/invalid_argument_exception.hpp"
+#include "cath/structure/geometry/angle.hpp"
+#include "cath/structure/geometry/coord.hpp"
+#include "cath/structure/geometry/coord_list.hpp"
+#include "cath/structure/geometry/rotation.hpp"
+
+#include <cmath>
+#include <limits>
+
+using namespace ::cath::common;
+using namespace ::cath::geom;
+using namespace ::cath::score::detail;
+
+using ::std::isfinite;
+using ::std::numeric_limits;
+
+namespace {
+
+	/// \brief The tm_score_search_test_suite_fixture to assist in testing tm_score_search
+	struct tm_score_search_test_suite_fixture {
+	protected:
+		~tm_score_search_test_suite_fixture() noexcept = default;
+
+		/// \brief Make a helix-like chain of single-atom residues
+		static coord_list_vec make_chain(const size_t &prm_length ///< The number of residues
+		                                 ) {
+			coord_list_vec result;
+			for (size_t residue_ctr = 0; residue_ctr < prm_length; ++residue_ctr) {
+				const double residue_dbl = static_cast<double>( residue_ctr );
+				result.emplace_back( coord_vec{ coord{ 2.3 * cos( residue_dbl * 1.75 ), 2.3 * sin( residue_dbl * 1.75 ), 1.5 * residue_dbl } } );
+			}
+			return result;
+		}
+
+		/// \brief Rotate and translate the specified residues of the specified chain
+		static coord_list_vec move_residues(coord_list_vec  prm_chain, ///< The chain to modify
+		                                    const size_t   &prm_begin, ///< The index of the first residue to move
+		                                    const size_t   &prm_end    ///< The index of one-past the last residue to move
+		                                    ) {
+			const rotation the_rotation = rotation_of_angle( make_angle_from_degrees<double>( 90.0 ) );
+			for (size_t residue_ctr = prm_begin; residue_ctr < prm_end; ++residue_ctr) {
+				prm_chain[ residue_ctr ] = rotate_copy( the_rotation, prm_chain[ residue_ctr ] ) + coord{ 25.0, -10.0, 5.0 };
+			}
+			return prm_chain;
+		}
+	};
+
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE(tm_score_search_test_suite, tm_score_search_test_suite_fixture)
+
+BOOST_AUTO_TEST_CASE(d0_matches_tm_score_program) {
+	BOOST_CHECK_EQUAL( tm_score_search::d0_of_target_length(  10.0 ), 0.5 );
+	BOOST_CHECK_EQUAL( tm_score_search::d0_of_target_length(  16.0 ), 0.5 );
+	BOOST_CHECK_CLOSE( tm_score_search::d0_of_target_length( 100.0 ), 1.24 * cbrt( 85.0 ) - 1.8, 1e-9 );
+}
+
+BOOST_AUTO_TEST_CASE(zero_seed_step_throws) {
+	BOOST_CHECK_THROW( tm_score_search{ 0 }, invalid_argument_exception );
+}
+
+BOOST_AUTO_TEST_CASE(no_pairs_scores_zero) {
+	tm_score_search the_search;
+	the_search.set_coords( {}, {} );
+	BOOST_CHECK_EQUAL( the_search.best_score_for_target_length( 50.0 ), 0.0 );
+}
+
+BOOST_AUTO_TEST_CASE(rigidly_moved_copy_scores_one) {
+	const coord_list_vec chain       = make_chain( 50 );
+	const coord_list_vec moved_chain = move_residues( chain, 0, chain.size() );
+	tm_score_search the_search;
+	the_search.set_coords( chain, moved_chain );
+	BOOST_CHECK_CLOSE( the_search.best_score_for_target_length( 50.0 ), 1.0, 1e-6 );
+}
+
+/// \brief Check that, if the last third of the chain is moved, the search still superposes the first two thirds
+///        (which a single superposition on all pairs would fail to do)
+BOOST_AUTO_TEST_CASE(finds_superposition_of_unmoved_majority) {
+	const coord_list_vec chain       = make_chain( 60 );
+	const coord_list_vec moved_chain = move_residues( chain, 40, 60 );
+	tm_score_search the_search;
+	the_search.set_coords( chain, moved_chain );
+	BOOST_CHECK_GT( the_search.best_score_for_target_length( 60.0 ), 40.0 / 60.0 );
+}
+
+BOOST_AUTO_TEST_CASE(larger_seed_step_does_not_beat_full_search) {
+	const coord_list_vec chain       = make_chain( 60 );
+	const coord_list_vec moved_chain = move_residues( chain, 25, 60 );
+	tm_score_search full_search;
+	tm_score_search coarse_search{ 7 };
+	full_search.set_coords  ( chain, moved_chain );
+	coarse_search.set_coords( chain, moved_chain );
+	BOOST_CHECK_GE(
+		full_search.best_score_for_target_length  ( 60.0 ),
+		coarse_search.best_score_for_target_length( 60.0 )
+	);
+}
+
+/// \brief Check that a non-finite coordinate can't stop the search's cutoff relaxing from terminating
+BOOST_AUTO_TEST_CASE(non_finite_coords_terminate) {
+	const coord_list_vec chain     = make_chain( 20 );
+	coord_list_vec       nan_chain = chain;
+	nan_chain[ 7 ] = coord_list{ coord_vec{ coord{ numeric_limits<double>::quiet_NaN(), 0.0, 0.0 } } };
+	tm_score_search the_search;
+	the_search.set_coords( chain, nan_chain );
+	const double score = the_search.best_score_for_target_length( 20.0 );
+	BOOST_CHECK( isfinite( score ) );
+	BOOST_CHECK_LE( score, 1.0 );
+}
+
+/// \brief Check that all-non-finite coordinates score zero rather than hanging
+BOOST_AUTO_TEST_CASE(all_non_finite_coords_score_zero) {
+	const coord_list_vec chain = make_chain( 10 );
+	const coord_list_vec nan_chain(
+		chain.size(),
+		coord_list{ coord_vec{ coord{ numeric_limits<double>::quiet_NaN(), 0.0, 0.0 } } }
+	);
+	tm_score_search the_search;
+	the_search.set_coords( chain, nan_chain );
+	BOOST_CHECK_EQUAL( the_search.best_score_for_target_length( 10.0 ), 0.0 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -40,6 +40,7 @@ using namespace ::cath::align;
 using namespace ::cath::align::gap;
 using namespace ::cath::common;
 using namespace ::cath::score;
+using namespace ::cath::score::detail;
 using namespace ::std;
 
 using ::boost::numeric_cast;
@@ -58,16 +59,17 @@ tribool gsas_score::do_higher_is_better() const {
 }
 
 /// \brief Concrete implementation for calculating the SAS of an alignment
-score_value gsas_score::do_calculate(const alignment &prm_alignment, ///< The pair alignment to be scored
-                                     const protein   &prm_protein_a, ///< The protein associated with the first  half of the alignment
-                                     const protein   &prm_protein_b  ///< The protein associated with the second half of the alignment
+score_value gsas_score::do_calculate(const alignment          &prm_alignment, ///< The pair alignment to be scored
+                                     const protein            &prm_protein_a, ///< The protein associated with the first  half of the alignment
+                                     const protein            &prm_protein_b, ///< The protein associated with the second half of the alignment
+                                     score_common_coord_cache &prm_cache      ///< The cache of common coords for this alignment and these proteins
                                      ) const {
 	const score_value bad_value   = 99.9;
 
 	// Grab the number of gaps and the number of aligned residues
 	//	const score_value num_gaps    = gap_count_of_alignment( prm_alignment );
 	const auto        num_gaps    = numeric_cast<score_value>( get_naive_num_gaps( prm_alignment ) );
-	const score_value num_aligned = num_aligned_residues.calculate( prm_alignment, prm_protein_a, prm_protein_b );
+	const score_value num_aligned = num_aligned_residues.calculate( prm_alignment, prm_protein_a, prm_protein_b, prm_cache );
 
 	// If the number of gaps meets or exceeds the number of aligned residues, return a bad value (99.9)
 	if ( num_gaps >= num_aligned ) {
@@ -75,7 +77,7 @@ score_value gsas_score::do_calculate(const alignment &prm_alignment, ///< The pa
 	}
 
 	// Otherwise, return the standard GSAS formula: 100 * rmsd / (num_aligned - num_gaps)
-	const score_value rmsd_val = rmsd.calculate( prm_alignment, prm_protein_a, prm_protein_b );
+	const score_value rmsd_val = rmsd.calculate( prm_alignment, prm_protein_a, prm_protein_b, prm_cache );
 	return 100.0 * rmsd_val / ( num_aligned - num_gaps );
 }
 
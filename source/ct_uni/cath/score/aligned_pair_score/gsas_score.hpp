@@ -54,7 +54,7 @@ namespace cath::score {
 		[[nodiscard]] std::unique_ptr<aligned_pair_score> do_clone() const final;
 
 		[[nodiscard]] boost::logic::tribool do_higher_is_better() const final;
-		[[nodiscard]] score_value do_calculate( const align::alignment &, const protein &, const protein & ) const final;
+		[[nodiscard]] score_value do_calculate( const align::alignment &, const protein &, const protein &, detail::score_common_coord_cache & ) const final;
 		[[nodiscard]] std::string       do_description() const final;
 		[[nodiscard]] std::string       do_id_name() const final;
 		[[nodiscard]] str_bool_pair_vec do_short_name_suffixes() const final;
@@ -26,6 +26,8 @@
 #include <boost/lexical_cast.hpp>
 #include <boost/logic/tribool.hpp>
 #include <boost/numeric/conversion/cast.hpp>
+#include <boost/range/algorithm/sort.hpp>
+#include <boost/range/algorithm/unique.hpp>
 #include <boost/range/join.hpp>
 #include <boost/range/numeric.hpp>
 #include <boost/serialization/export.hpp>
@@ -35,13 +37,12 @@
 #include "cath/alignment/common_atom_selection_policy/common_atom_selection_policy.hpp"
 #include "cath/alignment/common_residue_selection_policy/common_residue_selection_policy.hpp"
 #include "cath/common/algorithm/copy_build.hpp"
-#include "cath/common/boost_addenda/range/indices.hpp"
 #include "cath/common/clone/make_uptr_clone.hpp"
-#include "cath/common/difference.hpp"
 #include "cath/common/exception/not_implemented_exception.hpp"
 #include "cath/common/exception/out_of_range_exception.hpp"
 #include "cath/common/less_than_helper.hpp"
-#include "cath/common/size_t_literal.hpp"
+#include "cath/score/aligned_pair_score/detail/lddt_pair_counts.hpp"
+#include "cath/score/aligned_pair_score/detail/score_common_coord_cache.hpp"
 #include "cath/structure/geometry/coord.hpp"
 #include "cath/structure/geometry/coord_list.hpp"
 
@@ -58,10 +59,11 @@ using namespace ::std;
 
 using ::boost::accumulate;
 using ::boost::algorithm::none_of;
-using ::boost::irange;
 using ::boost::lexical_cast;
 using ::boost::numeric_cast;
 using ::boost::range::join;
+using ::boost::range::sort;
+using ::boost::range::unique;
 using ::boost::tribool;
 
 BOOST_CLASS_EXPORT(lddt_score)
@@ -77,22 +79,16 @@ tribool lddt_score::do_higher_is_better() const {
 }
 
 /// \brief Concrete implementation for calculating the SAS of an alignment
-score_value lddt_score::do_calculate(const alignment &prm_alignment, ///< The pair alignment to be scored
-                                     const protein   &prm_protein_a, ///< The protein associated with the first  half of the alignment
-                                     const protein   &prm_protein_b  ///< The protein associated with the second half of the alignment
+score_value lddt_score::do_calculate(const alignment          &/*prm_alignment*/, ///< The pair alignment to be scored
+                                     const protein            &/*prm_protein_a*/, ///< The protein associated with the first  half of the alignment
+                                     const protein            &/*prm_protein_b*/, ///< The protein associated with the second half of the alignment
+                                     score_common_coord_cache &prm_cache          ///< The cache of common coords for this alignment and these proteins
                                      ) const {
 	// As described in the paper, use a R_0 value of 15.0 angstroms
 	const score_value R_0 = 15.0;
 
-	// A threshold value that will ensure everything gets considered
-	
-
 	// Extract the common coordinates to be chosen
-	const pair<coord_list_vec, coord_list_vec> common_coords_by_residue = the_coord_handler.get_common_coords_by_residue(
-		prm_alignment,
-		prm_protein_a,
-		prm_protein_b
-	);
+	const pair<coord_list_vec, coord_list_vec> &common_coords_by_residue = prm_cache.get_common_coords_by_residue( the_coord_handler );
 
 	// Check that there are some coords
 	const size_t num_common_residues = common_coords_by_residue.first.size();
@@ -110,57 +106,23 @@ score_value lddt_score::do_calculate(const alignment &prm_alignment, ///< The pa
 		));
 	}
 
-	// Construct a map from threshold values to the counts of residues pairs that satisfy each
-	using doub_size_map = std::map< double, size_t >;
-	using doub_size_map_val = doub_size_map::value_type;
-	doub_size_map count_within_threshold = { { THRESHOLD_FOR_ALL, 0 } };
-	for (const score_value &threshold_value : threshold_values) {
-		count_within_threshold[ threshold_value ] = 0;
-	}
-
-	// Loop over the pairs of residues
-	for (const size_t &res_ctr_1 : indices( num_common_residues ) ) {
-		for (const size_t &res_ctr_2 : irange( res_ctr_1 + 1, num_common_residues ) ) {
-
-			const size_t &num_atoms_1 = common_coords_by_residue.first[res_ctr_1].size();
-			const size_t &num_atoms_2 = common_coords_by_residue.first[res_ctr_2].size();
-
-			for (const size_t &atom_ctr_1 : indices( num_atoms_1 ) ) {
-				for (const size_t &atom_ctr_2 : indices( num_atoms_2 ) ) {
-					const double distance_a  = distance_between_points(
-						common_coords_by_residue.first[  res_ctr_1 ][ atom_ctr_1 ],
-						common_coords_by_residue.first[  res_ctr_2 ][ atom_ctr_2 ]
-					);
-					const double distance_b  = distance_between_points(
-						common_coords_by_residue.second[  res_ctr_1 ][ atom_ctr_1 ],
-						common_coords_by_residue.second[  res_ctr_2 ][ atom_ctr_2 ]
-					);
-					const size_t num_suitable_pairs =   ( distance_a < R_0 ? 1_z : 0_z )
-					                                  + ( distance_b < R_0 ? 1_z : 0_z );
-
-					const double distance_difference = difference( distance_a, distance_b );
-
-					for (doub_size_map_val &threshold_count_pair : count_within_threshold) {
-						if (distance_difference < threshold_count_pair.first) {
-							threshold_count_pair.second += num_suitable_pairs;
-						}
-					}
-				}
-			}
-		}
-	}
+	// Count the atom pairs within each (distinct) threshold, in ascending order of threshold
+	doub_vec sorted_thresholds = threshold_values;
+	sort( sorted_thresholds );
+	sorted_thresholds.erase( unique( sorted_thresholds ).end(), sorted_thresholds.end() );
+	const lddt_pair_counts counts = calc_lddt_pair_counts(
+		common_coords_by_residue.first,
+		common_coords_by_residue.second,
+		sorted_thresholds,
+		R_0
+	);
 
-	const size_t all_count = count_within_threshold.at( THRESHOLD_FOR_ALL );
 	vector<score_value> fractions;
-	fractions.reserve( count_within_threshold.size() - 1 );
-	for (const doub_size_map_val &threshold_count : count_within_threshold) {
-		const double &threshold = threshold_count.first;
-		const size_t &count     = threshold_count.second;
-		if (threshold != THRESHOLD_FOR_ALL) {
-			fractions.push_back(
-				numeric_cast<score_value>( count ) / numeric_cast<score_value>( all_count  )
-			);
-		}
+	fractions.reserve( sorted_thresholds.size() );
+	for (const size_t &count : counts.counts_within_thresholds) {
+		fractions.push_back(
+			numeric_cast<score_value>( count ) / numeric_cast<score_value>( counts.all_count )
+		);
 	}
 	const score_value fraction_total = accumulate( fractions, 0.0 );
 	const score_value fraction_avg = fraction_total / numeric_cast<score_value>( fractions.size() );
@@ -38,6 +38,7 @@ using namespace ::cath;
 using namespace ::cath::align;
 using namespace ::cath::common;
 using namespace ::cath::score;
+using namespace ::cath::score::detail;
 using namespace ::std;
 
 using ::boost::tribool;
@@ -57,11 +58,12 @@ tribool length_score::do_higher_is_better() const {
 /// \brief Concrete implementation for calculating the number of common residues defined by this alignment
 ///
 /// This uses the score_common_coord_handler (and hence its policies)
-score_value length_score::do_calculate(const alignment &prm_alignment, ///< The pair alignment to be scored
-                                       const protein   &prm_protein_a, ///< The protein associated with the first  half of the alignment
-                                       const protein   &prm_protein_b  ///< The protein associated with the second half of the alignment
+score_value length_score::do_calculate(const alignment          &prm_alignment, ///< The pair alignment to be scored
+                                       const protein            &prm_protein_a, ///< The protein associated with the first  half of the alignment
+                                       const protein            &prm_protein_b, ///< The protein associated with the second half of the alignment
+                                       score_common_coord_cache &prm_cache      ///< The cache of common coords for this alignment and these proteins
                                        ) const {
-	return get_length_score( *length_getter_ptr, prm_alignment, prm_protein_a, prm_protein_b );
+	return get_length_score( *length_getter_ptr, prm_alignment, prm_protein_a, prm_protein_b, prm_cache );
 }
 
 /// \brief Concrete implementation that describes what this score means
@@ -37,6 +37,7 @@ using namespace ::cath;
 using namespace ::cath::align;
 using namespace ::cath::common;
 using namespace ::cath::score;
+using namespace ::cath::score::detail;
 using namespace ::std;
 
 using ::boost::range::join;
@@ -55,14 +56,15 @@ tribool mi_score::do_higher_is_better() const {
 }
 
 /// \brief Concrete implementation for calculating the SAS of an alignment
-score_value mi_score::do_calculate(const alignment &prm_alignment, ///< The pair alignment to be scored
-                                   const protein   &prm_protein_a, ///< The protein associated with the first  half of the alignment
-                                   const protein   &prm_protein_b  ///< The protein associated with the second half of the alignment
+score_value mi_score::do_calculate(const alignment          &prm_alignment, ///< The pair alignment to be scored
+                                   const protein            &prm_protein_a, ///< The protein associated with the first  half of the alignment
+                                   const protein            &prm_protein_b, ///< The protein associated with the second half of the alignment
+                                   score_common_coord_cache &prm_cache      ///< The cache of common coords for this alignment and these proteins
                                    ) const {
 	const score_value w0                    = 1.5;
-	const score_value one_plus_num_aligned  = 1 + get_length_score( num_aligned_getter,      prm_alignment, prm_protein_a, prm_protein_b );
+	const score_value one_plus_num_aligned  = 1 + get_length_score( num_aligned_getter,      prm_alignment, prm_protein_a, prm_protein_b, prm_cache );
 	const score_value one_plus_length       = 1 + get_length_score( *full_length_getter_ptr,                prm_protein_a, prm_protein_b );
-	const score_value one_plus_rmsd_over_w0 = 1 + rmsd.calculate( prm_alignment, prm_protein_a, prm_protein_b ) / w0;
+	const score_value one_plus_rmsd_over_w0 = 1 + rmsd.calculate( prm_alignment, prm_protein_a, prm_protein_b, prm_cache ) / w0;
 	return 1 - (one_plus_num_aligned / ( one_plus_rmsd_over_w0 * one_plus_length ) );
 }
 
@@ -45,7 +45,7 @@ namespace cath::score {
 		[[nodiscard]] std::unique_ptr<aligned_pair_score> do_clone() const final;
 
 		[[nodiscard]] boost::logic::tribool do_higher_is_better() const final;
-		[[nodiscard]] score_value do_calculate( const align::alignment &, const protein &, const protein & ) const final;
+		[[nodiscard]] score_value do_calculate( const align::alignment &, const protein &, const protein &, detail::score_common_coord_cache & ) const final;
 		[[nodiscard]] std::string       do_description() const final;
 		[[nodiscard]] std::string       do_id_name() const final;
 		[[nodiscard]] str_bool_pair_vec do_short_name_suffixes() const final;
@@ -80,12 +80,13 @@ namespace cath::score {
 	///
 	/// This uses the score_common_coord_handler (and hence its policies)
 	template <overlap_type OL>
-	score_value overlap_score<OL>::do_calculate(const align::alignment &prm_alignment, ///< The pair alignment to be scored
-	                                            const protein          &prm_protein_a, ///< The protein associated with the first  half of the alignment
-	                                            const protein          &prm_protein_b  ///< The protein associated with the second half of the alignment
+	score_value overlap_score<OL>::do_calculate(const align::alignment           &prm_alignment, ///< The pair alignment to be scored
+	                                            const protein                    &prm_protein_a, ///< The protein associated with the first  half of the alignment
+	                                            const protein                    &prm_protein_b, ///< The protein associated with the second half of the alignment
+	                                            detail::score_common_coord_cache &prm_cache      ///< The cache of common coords for this alignment and these proteins
 	                                            ) const {
-		const size_t numerator_value   = numerator_type  ().get_length( prm_alignment, prm_protein_a, prm_protein_b );
-		const size_t denominator_value = denominator_type().get_length( prm_alignment, prm_protein_a, prm_protein_b );
+		const size_t numerator_value   = numerator_type  ().get_length( prm_alignment, prm_protein_a, prm_protein_b, prm_cache );
+		const size_t denominator_value = denominator_type().get_length( prm_alignment, prm_protein_a, prm_protein_b, prm_cache );
 		return 100.0 * boost::numeric_cast<score_value>( numerator_value ) / boost::numeric_cast<score_value>( denominator_value );
 	}
 
@@ -29,6 +29,7 @@ using namespace ::cath;
 using namespace ::cath::align;
 using namespace ::cath::common;
 using namespace ::cath::score;
+using namespace ::cath::score::detail;
 using namespace ::std;
 
 using ::boost::tribool;
@@ -44,9 +45,10 @@ tribool pseudo_string_score::do_higher_is_better() const {
 }
 
 /// \brief Concrete implementation for calculating the SAS of an alignment
-score_value pseudo_string_score::do_calculate(const alignment &,
-                                              const protein   &,
-                                              const protein   &
+score_value pseudo_string_score::do_calculate(const alignment          &,
+                                              const protein            &,
+                                              const protein            &,
+                                              score_common_coord_cache &
                                               ) const {
 	BOOST_THROW_EXCEPTION(invalid_argument_exception("Unable to calculate for pseudo_string_scores"));
 }
@@ -31,6 +31,7 @@
 #include "cath/common/clone/make_uptr_clone.hpp"
 #include "cath/common/exception/out_of_range_exception.hpp"
 #include "cath/common/less_than_helper.hpp"
+#include "cath/score/aligned_pair_score/detail/score_common_coord_cache.hpp"
 #include "cath/structure/geometry/coord_list.hpp"
 #include "cath/superposition/superposition.hpp"
 
@@ -58,16 +59,13 @@ tribool rmsd_score::do_higher_is_better() const {
 }
 
 /// \brief Concrete implementation for calculating the RMSD of an alignment
-score_value rmsd_score::do_calculate(const alignment &prm_alignment, ///< The pair alignment to be scored
-                                     const protein   &prm_protein_a, ///< The protein associated with the first  half of the alignment
-                                     const protein   &prm_protein_b  ///< The protein associated with the second half of the alignment
+score_value rmsd_score::do_calculate(const alignment          &/*prm_alignment*/, ///< The pair alignment to be scored
+                                     const protein            &/*prm_protein_a*/, ///< The protein associated with the first  half of the alignment
+                                     const protein            &/*prm_protein_b*/, ///< The protein associated with the second half of the alignment
+                                     score_common_coord_cache &prm_cache          ///< The cache of common coords for this alignment and these proteins
                                      ) const {
 	// Extract the common coordinates to be chosen
-	const pair<coord_list, coord_list> common_coords = the_coord_handler.get_common_coords(
-		prm_alignment,
-		prm_protein_a,
-		prm_protein_b
-	);
+	const coord_list_coord_list_pair &common_coords = prm_cache.get_common_coords( the_coord_handler );
 
 	// Check that there are some coords
 	const size_t num_common_coords = common_coords.first.size();
@@ -79,9 +77,12 @@ score_value rmsd_score::do_calculate(const alignment &prm_alignment, ///< The pa
 		));
 	}
 
-	// Calculate and return the RMSD
-	return calc_pairwise_superposition_rmsd(
+	// Calculate and return the RMSD under the (possibly cached) superposition of the common coords
+	return calc_rmsd_between_superposed_entries(
+		prm_cache.get_superposition( the_coord_handler ),
+		superposition::INDEX_OF_FIRST_IN_PAIRWISE_SUPERPOSITION,
 		common_coords.first,
+		superposition::INDEX_OF_SECOND_IN_PAIRWISE_SUPERPOSITION,
 		common_coords.second
 	);
 }
@@ -37,6 +37,7 @@ using namespace ::cath;
 using namespace ::cath::align;
 using namespace ::cath::common;
 using namespace ::cath::score;
+using namespace ::cath::score::detail;
 using namespace ::std;
 
 using ::boost::tribool;
@@ -54,12 +55,13 @@ tribool sas_score::do_higher_is_better() const {
 }
 
 /// \brief Concrete implementation for calculating the SAS of an alignment
-score_value sas_score::do_calculate(const alignment &prm_alignment, ///< The pair alignment to be scored
-                                    const protein   &prm_protein_a, ///< The protein associated with the first  half of the alignment
-                                    const protein   &prm_protein_b  ///< The protein associated with the second half of the alignment
+score_value sas_score::do_calculate(const alignment          &prm_alignment, ///< The pair alignment to be scored
+                                    const protein            &prm_protein_a, ///< The protein associated with the first  half of the alignment
+                                    const protein            &prm_protein_b, ///< The protein associated with the second half of the alignment
+                                    score_common_coord_cache &prm_cache      ///< The cache of common coords for this alignment and these proteins
                                     ) const {
-	return 100.0 * rmsd.calculate( prm_alignment, prm_protein_a, prm_protein_b )
-	             / num_aligned_residues.calculate( prm_alignment, prm_protein_a, prm_protein_b );
+	return 100.0 * rmsd.calculate( prm_alignment, prm_protein_a, prm_protein_b, prm_cache )
+	             / num_aligned_residues.calculate( prm_alignment, prm_protein_a, prm_protein_b, prm_cache );
 }
 
 /// \brief Concrete implementation that describes what this score means
@@ -46,6 +46,7 @@ using namespace ::cath::align;
 using namespace ::cath::common;
 using namespace ::cath::geom;
 using namespace ::cath::score;
+using namespace ::cath::score::detail;
 using namespace ::cath::sup;
 using namespace ::std;
 
@@ -66,9 +67,10 @@ tribool sequence_similarity_score::do_higher_is_better() const {
 }
 
 /// \brief Concrete implementation for calculating the RMSD of an alignment
-score_value sequence_similarity_score::do_calculate(const alignment &prm_alignment, ///< The pair alignment to be scored
-                                                    const protein   &prm_protein_a, ///< The protein associated with the first  half of the alignment
-                                                    const protein   &prm_protein_b  ///< The protein associated with the second half of the alignment
+score_value sequence_similarity_score::do_calculate(const alignment          &prm_alignment, ///< The pair alignment to be scored
+                                                    const protein            &prm_protein_a, ///< The protein associated with the first  half of the alignment
+                                                    const protein            &prm_protein_b, ///< The protein associated with the second half of the alignment
+                                                    score_common_coord_cache &prm_cache      ///< The cache of common coords for this alignment and these proteins
                                                     ) const {
 	const size_t length = prm_alignment.length();
 
@@ -83,7 +85,7 @@ score_value sequence_similarity_score::do_calculate(const alignment &prm_alignme
 		}
 	}
 
-	const size_t      normalisation_length = length_getter_ptr->get_length( prm_alignment, prm_protein_a, prm_protein_b );
+	const size_t      normalisation_length = length_getter_ptr->get_length( prm_alignment, prm_protein_a, prm_protein_b, prm_cache );
 	const auto normalisation_score  = numeric_cast<score_value>( normalisation_length * numeric_cast<size_t>( scores.get_highest_score() ) );
 	return 100.0 * numeric_cast<score_value>( score ) / normalisation_score;
 }
@@ -173,9 +173,10 @@ tribool ssap_score::do_higher_is_better() const {
 }
 
 /// \brief Concrete implementation for calculating the SSAP score of an alignment
-score_value ssap_score::do_calculate(const alignment &prm_alignment, ///< The pair alignment to be scored
-                                     const protein   &prm_protein_a, ///< The protein associated with the first  half of the alignment
-                                     const protein   &prm_protein_b  ///< The protein associated with the second half of the alignment
+score_value ssap_score::do_calculate(const alignment          &prm_alignment, ///< The pair alignment to be scored
+                                     const protein            &prm_protein_a, ///< The protein associated with the first  half of the alignment
+                                     const protein            &prm_protein_b, ///< The protein associated with the second half of the alignment
+                                     score_common_coord_cache &prm_cache      ///< The cache of common coords for this alignment and these proteins
                                      ) const {
 
 	const score_size_pair total_score_and_num_quads = calculate_total_score_and_num_quads(
@@ -198,8 +199,8 @@ score_value ssap_score::do_calculate(const alignment &prm_alignment, ///< The pa
 	                                         : mean_score;
 
 	const bool         simple_normls        = normalisation_is_simple( post_processing );
-	const size_t       num_aligned_length   = num_aligned_length_getter().get_length( prm_alignment, prm_protein_a, prm_protein_b );
-	const size_t       normalisation_length = length_getter_ptr->get_length         ( prm_alignment, prm_protein_a, prm_protein_b );
+	const size_t       num_aligned_length   = num_aligned_length_getter().get_length( prm_alignment, prm_protein_a, prm_protein_b, prm_cache );
+	const size_t       normalisation_length = length_getter_ptr->get_length         ( prm_alignment, prm_protein_a, prm_protein_b, prm_cache );
 	const score_value  post_score           = simple_normls ? simple_normalise ( pre_score, num_aligned_length, normalisation_length )
 	                                                        : complex_normalise( pre_score, num_quads, normalisation_length, num_excluded_on_sides );
 
@@ -31,6 +31,7 @@
 #include "cath/common/algorithm/copy_build.hpp"
 #include "cath/common/clone/make_uptr_clone.hpp"
 #include "cath/common/less_than_helper.hpp"
+#include "cath/score/aligned_pair_score/detail/score_common_coord_cache.hpp"
 #include "cath/score/length_getter/length_of_shorter_getter.hpp"
 #include "cath/structure/protein/protein.hpp"
 #include "cath/structure/protein/residue.hpp"
@@ -64,25 +65,23 @@ tribool structal_score::do_higher_is_better() const {
 }
 
 /// \brief Concrete implementation for calculating the SAS of an alignment
-score_value structal_score::do_calculate(const alignment &prm_alignment, ///< The pair alignment to be scored
-                                         const protein   &prm_protein_a, ///< The protein associated with the first  half of the alignment
-                                         const protein   &prm_protein_b  ///< The protein associated with the second half of the alignment
+score_value structal_score::do_calculate(const alignment          &prm_alignment,     ///< The pair alignment to be scored
+                                         const protein            &/*prm_protein_a*/, ///< The protein associated with the first  half of the alignment
+                                         const protein            &/*prm_protein_b*/, ///< The protein associated with the second half of the alignment
+                                         score_common_coord_cache &prm_cache          ///< The cache of common coords for this alignment and these proteins
                                          ) const {
 	constexpr double numerator        = 20.00;
 	constexpr double dest_denominator =  2.24;
 	constexpr double gap_weight       = 10.00;
 
 	// Extract the common coordinates to be chosen
-	const pair<coord_list_vec, coord_list_vec> common_coords = the_coord_handler.get_common_coords_by_residue(
-		prm_alignment,
-		prm_protein_a,
-		prm_protein_b
-	);
+	const pair<coord_list_vec, coord_list_vec> &common_coords = prm_cache.get_common_coords_by_residue( the_coord_handler );
 
 	const auto num_gaps = numeric_cast<score_value>( get_naive_num_gaps( prm_alignment ) );
 
-	const auto superposed_second_coords = superpose_copy_second_coords_to_first(
-		common_coords.first,
+	const auto superposed_second_coords = transform_copy(
+		prm_cache.get_superposition( the_coord_handler ),
+		superposition::INDEX_OF_SECOND_IN_PAIRWISE_SUPERPOSITION,
 		common_coords.second
 	);
 
@@ -23,7 +23,6 @@
 #include <boost/logic/tribool.hpp>
 #include <boost/numeric/conversion/cast.hpp>
 #include <boost/range/join.hpp>
-#include <boost/range/numeric.hpp>
 
 #include "cath/alignment/alignment.hpp"
 #include "cath/alignment/common_atom_selection_policy/common_atom_selection_policy.hpp"
@@ -31,11 +30,12 @@
 #include "cath/common/algorithm/copy_build.hpp"
 #include "cath/common/clone/make_uptr_clone.hpp"
 #include "cath/common/less_than_helper.hpp"
+#include "cath/score/aligned_pair_score/detail/score_common_coord_cache.hpp"
+#include "cath/score/aligned_pair_score/detail/tm_score_search.hpp"
 #include "cath/score/length_getter/length_of_shorter_getter.hpp"
 #include "cath/structure/protein/protein.hpp"
 #include "cath/structure/protein/residue.hpp"
 #include "cath/structure/structure_type_aliases.hpp"
-#include "cath/superposition/superposition.hpp"
 
 using namespace ::cath;
 using namespace ::cath::align;
@@ -43,10 +43,8 @@ using namespace ::cath::common;
 using namespace ::cath::geom;
 using namespace ::cath::score;
 using namespace ::cath::score::detail;
-using namespace ::cath::sup;
 using namespace ::std;
 
-using ::boost::inner_product;
 using ::boost::numeric_cast;
 using ::boost::tribool;
 
@@ -62,21 +60,26 @@ tribool tm_score::do_higher_is_better() const {
 	return true;
 }
 
-/// \brief Concrete implementation for calculating the SAS of an alignment
-score_value tm_score::do_calculate(const alignment &prm_alignment, ///< The pair alignment to be scored
-                                   const protein   &prm_protein_a, ///< The protein associated with the first  half of the alignment
-                                   const protein   &prm_protein_b  ///< The protein associated with the second half of the alignment
+/// \brief Concrete implementation for calculating the TM-score of an alignment
+///
+/// This searches for the superposition that maximises the TM-score (see tm_score_search),
+/// normalising by each protein's length and returning the larger of the two scores.
+///
+/// A thread_local tm_score_search is used so its buffers are reused across calls
+score_value tm_score::do_calculate(const alignment          &/*prm_alignment*/, ///< The pair alignment to be scored
+                                   const protein            &prm_protein_a,     ///< The protein associated with the first  half of the alignment
+                                   const protein            &prm_protein_b,     ///< The protein associated with the second half of the alignment
+                                   score_common_coord_cache &prm_cache          ///< The cache of common coords for this alignment and these proteins
                                    ) const {
 	// Extract the common coordinates to be chosen
-	const pair<coord_list_vec, coord_list_vec> common_coords = the_coord_handler.get_common_coords_by_residue(
-		prm_alignment,
-		prm_protein_a,
-		prm_protein_b
-	);
+	const pair<coord_list_vec, coord_list_vec> &common_coords = prm_cache.get_common_coords_by_residue( the_coord_handler );
+
+	thread_local tm_score_search the_search;
+	the_search.set_coords( common_coords.first, common_coords.second );
 
 	return max(
-		score_for_target_length( common_coords, numeric_cast<score_value>( prm_protein_a.get_length() ) ),
-		score_for_target_length( common_coords, numeric_cast<score_value>( prm_protein_b.get_length() ) )
+		the_search.best_score_for_target_length( numeric_cast<score_value>( prm_protein_a.get_length() ) ),
+		the_search.best_score_for_target_length( numeric_cast<score_value>( prm_protein_b.get_length() ) )
 	);
 }
 
@@ -112,36 +115,6 @@ bool tm_score::do_less_than_with_same_dynamic_type(const aligned_pair_score &prm
 	return ( *this < casted_aligned_pair_score );
 }
 
-/// \brief TODOCUMENT
-score_value tm_score::score_for_target_length(const pair<coord_list_vec, coord_list_vec> &prm_common_coords_by_residue,  ///< TODOCUMENT
-                                              const score_value                          &prm_target_length              ///< TODOCUMENT
-                                              ) {
-	const score_value denominator = ( 1.24 * cbrt( prm_target_length - 15 ) ) - 1.8;
-//	cerr << "For length " << prm_target_length << ", denominator is : " << denominator << endl;
-
-	const auto superposed_second_coords = superpose_copy_second_coords_to_first(
-		prm_common_coords_by_residue.first,
-		prm_common_coords_by_residue.second
-	);
-
-	return inner_product(
-		prm_common_coords_by_residue.first,
-		superposed_second_coords,
-		numeric_cast<score_value>( 0.0 ),
-		plus<>(),
-		[&] (const coord_list &x, const coord_list &y) {
-
-			const score_value mean_distance = calc_mean_deviation( x, y );
-			const score_value fraction      = mean_distance / denominator;
-			const score_value final         = 1.0 / ( 1.0 + fraction * fraction );
-//			cerr << "mean_distance is : " << mean_distance << endl;
-//			cerr << "fraction      is : " << fraction      << endl;
-//			cerr << "final         is : " << final         << endl;
-			return final;
-		}
-	) / prm_target_length;
-}
-
 /// \brief Ctor for tm_score that allows the caller to specify the protein_only_length_getter, common_residue_selection_policy and common_atom_selection_policy
 tm_score::tm_score(const common_residue_selection_policy &prm_comm_res_seln_pol, ///< The policy to use for selecting common residues
                    const common_atom_selection_policy    &prm_comm_atom_seln_pol ///< The policy to use for selecting common atoms
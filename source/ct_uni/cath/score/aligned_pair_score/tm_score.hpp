@@ -42,7 +42,7 @@ namespace cath::score {
 		[[nodiscard]] std::unique_ptr<aligned_pair_score> do_clone() const final;
 
 		[[nodiscard]] boost::logic::tribool do_higher_is_better() const final;
-		[[nodiscard]] score_value do_calculate( const align::alignment &, const protein &, const protein & ) const final;
+		[[nodiscard]] score_value do_calculate( const align::alignment &, const protein &, const protein &, detail::score_common_coord_cache & ) const final;
 		[[nodiscard]] std::string       do_description() const final;
 		[[nodiscard]] std::string       do_id_name() const final;
 		[[nodiscard]] str_bool_pair_vec do_short_name_suffixes() const final;
@@ -53,9 +53,6 @@ namespace cath::score {
 
 		[[nodiscard]] bool do_less_than_with_same_dynamic_type( const aligned_pair_score & ) const final;
 
-		static score_value score_for_target_length(const std::pair<geom::coord_list_vec, geom::coord_list_vec> &,
-		                                           const score_value &);
-
 	public:
 		tm_score() = default;
 		tm_score(const align::common_residue_selection_policy &,
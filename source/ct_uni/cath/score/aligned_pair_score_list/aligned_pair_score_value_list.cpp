@@ -37,11 +37,13 @@
 #include "cath/common/boost_addenda/tribool/tribool.hpp"
 #include "cath/common/exception/invalid_argument_exception.hpp"
 #include "cath/score/aligned_pair_score/aligned_pair_score.hpp"
+#include "cath/score/aligned_pair_score/detail/score_common_coord_cache.hpp"
 
 using namespace ::cath;
 using namespace ::cath::align;
 using namespace ::cath::common;
 using namespace ::cath::score;
+using namespace ::cath::score::detail;
 using namespace ::std;
 
 using ::boost::lexical_cast;
@@ -144,7 +146,10 @@ void cath::score::save_to_ptree(ptree                               &prm_ptree,
 //	}
 }
 
-/// \brief TODOCUMENT
+/// \brief Calculate the value of each of the specified scores for the specified alignment and proteins
+///
+/// Each distinct extraction of common coords (and superposition of them) is performed only once
+/// and then shared between all the scores that use it (see score_common_coord_cache)
 ///
 /// \relates aligned_pair_score_value_list
 aligned_pair_score_value_list cath::score::make_aligned_pair_score_value_list(const aligned_pair_score_list &prm_scores,    ///< TODOCUMENT
@@ -164,13 +169,16 @@ aligned_pair_score_value_list cath::score::make_aligned_pair_score_value_list(co
 	// Create a new aligned_pair_score_value_list
 	aligned_pair_score_value_list new_aligned_pair_score_value_list;
 
+	// Create a cache through which the scores can share the common coords (and superpositions)
+	score_common_coord_cache the_cache{ prm_alignment, prm_protein_a, prm_protein_b };
+
 	// Loop over the scores
 	const size_t num_scores = prm_scores.size();
 	for (const size_t &score_ctr : indices( num_scores ) ) {
 		const aligned_pair_score &score = prm_scores[score_ctr];
 
 		// Calculate the value for the score and append it to the new aligned_pair_score_value_list
-		const score_value value = score.calculate(prm_alignment, prm_protein_a, prm_protein_b);
+		const score_value value = score.calculate( prm_alignment, prm_protein_a, prm_protein_b, the_cache );
 		new_aligned_pair_score_value_list.add_score_and_value( score, value );
 	}
 
@@ -52,6 +52,17 @@ using ::boost::ptr_vector;
 using ::boost::range::join;
 using ::boost::tribool;
 
+/// \brief A default implementation for getting the length with a score_common_coord_cache, which ignores the cache
+///
+/// length_getters that extract common coords should override this to take them from the cache
+size_t length_getter::do_get_length_with_cache(const alignment          &prm_alignment, ///< The pair alignment
+                                               const protein            &prm_protein_a, ///< The protein associated with the first  half of the alignment
+                                               const protein            &prm_protein_b, ///< The protein associated with the second half of the alignment
+                                               score_common_coord_cache &/*prm_cache*/  ///< The cache of common coords for this alignment and these proteins
+                                               ) const {
+	return do_get_length( prm_alignment, prm_protein_a, prm_protein_b );
+}
+
 /// \brief Standard approach to achieving a virtual copy-ctor
 unique_ptr<length_getter> length_getter::clone() const {
 	return check_uptr_clone_against_this( do_clone(), *this );
@@ -70,6 +81,16 @@ size_t length_getter::get_length(const alignment &prm_alignment, ///< TODOCUMENT
 	return do_get_length( prm_alignment, prm_protein_a, prm_protein_b );
 }
 
+/// \brief Get the length, taking any common coords that are required from the specified score_common_coord_cache
+///        (which must be for the same alignment and proteins)
+size_t length_getter::get_length(const alignment          &prm_alignment, ///< The pair alignment
+                                 const protein            &prm_protein_a, ///< The protein associated with the first  half of the alignment
+                                 const protein            &prm_protein_b, ///< The protein associated with the second half of the alignment
+                                 score_common_coord_cache &prm_cache      ///< The cache of common coords for this alignment and these proteins
+                                 ) const {
+	return do_get_length_with_cache( prm_alignment, prm_protein_a, prm_protein_b, prm_cache );
+}
+
 /// \brief TODOCUMENT
 length_getter_category length_getter::get_length_getter_category() const {
 	return do_get_length_getter_category();
@@ -175,3 +196,23 @@ score_value cath::score::get_length_score(const length_getter &prm_length_getter
 		)
 	);
 }
+
+/// \brief Get the length from the specified length_getter as a score_value, taking any common coords
+///        that are required from the specified score_common_coord_cache
+///
+/// \relates length_getter
+score_value cath::score::get_length_score(const length_getter      &prm_length_getter, ///< The length_getter with which to get the length
+                                          const alignment          &prm_alignment,     ///< The pair alignment
+                                          const protein            &prm_protein_a,     ///< The protein associated with the first  half of the alignment
+                                          const protein            &prm_protein_b,     ///< The protein associated with the second half of the alignment
+                                          score_common_coord_cache &prm_cache          ///< The cache of common coords for this alignment and these proteins
+                                          ) {
+	return numeric_cast<score_value>(
+		prm_length_getter.get_length(
+			prm_alignment,
+			prm_protein_a,
+			prm_protein_b,
+			prm_cache
+		)
+	);
+}
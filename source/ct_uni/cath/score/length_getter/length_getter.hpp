@@ -29,6 +29,7 @@
 // clang-format off
 namespace cath { class protein; }
 namespace cath::align { class alignment; }
+namespace cath::score::detail { class score_common_coord_cache; }
 // clang-format on
 
 namespace cath::score {
@@ -58,6 +59,8 @@ namespace cath::score {
 	  /// \brief TODOCUMENT
 	  [[nodiscard]] virtual size_t do_get_length( const align::alignment &, const protein &, const protein & ) const = 0;
 
+	  [[nodiscard]] virtual size_t do_get_length_with_cache( const align::alignment &, const protein &, const protein &, detail::score_common_coord_cache & ) const;
+
 	  /// \brief TODOCUMENT
 	  [[nodiscard]] virtual length_getter_category do_get_length_getter_category() const = 0;
 
@@ -93,6 +96,7 @@ namespace cath::score {
 		[[nodiscard]] boost::logic::tribool higher_is_better() const;
 
 		[[nodiscard]] size_t get_length( const align::alignment &, const protein &, const protein & ) const;
+		[[nodiscard]] size_t get_length( const align::alignment &, const protein &, const protein &, detail::score_common_coord_cache & ) const;
 
 		[[nodiscard]] length_getter_category get_length_getter_category() const;
 
@@ -119,6 +123,11 @@ namespace cath::score {
 	                             const align::alignment &,
 	                             const protein &,
 	                             const protein &);
+	score_value get_length_score(const length_getter &,
+	                             const align::alignment &,
+	                             const protein &,
+	                             const protein &,
+	                             detail::score_common_coord_cache &);
 
 	/// \brief Function to make length_getter meet the Clonable concept (used in ptr_container)
 	///
@@ -25,6 +25,7 @@
 #include "cath/alignment/common_atom_selection_policy/common_atom_selection_policy.hpp"
 #include "cath/alignment/common_residue_selection_policy/common_residue_selection_policy.hpp"
 #include "cath/common/clone/make_uptr_clone.hpp"
+#include "cath/score/aligned_pair_score/detail/score_common_coord_cache.hpp"
 #include "cath/structure/geometry/coord.hpp"
 
 using namespace ::cath;
@@ -60,6 +61,15 @@ size_t num_aligned_length_getter::do_get_length(const alignment &prm_alignment,
 	return common_coords.first.size();
 }
 
+/// \brief Get the number of aligned residues from the common coords in the specified score_common_coord_cache
+size_t num_aligned_length_getter::do_get_length_with_cache(const alignment          &/*prm_alignment*/, ///< The pair alignment
+                                                           const protein            &/*prm_protein_a*/, ///< The protein associated with the first  half of the alignment
+                                                           const protein            &/*prm_protein_b*/, ///< The protein associated with the second half of the alignment
+                                                           score_common_coord_cache &prm_cache          ///< The cache of common coords for this alignment and these proteins
+                                                           ) const {
+	return prm_cache.get_common_coords( common_coord_handler ).first.size();
+}
+
 /// \brief TODOCUMENT
 length_getter_category num_aligned_length_getter::do_get_length_getter_category() const {
 	return length_getter_category::OTHER;
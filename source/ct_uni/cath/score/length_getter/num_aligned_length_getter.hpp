@@ -46,6 +46,8 @@ namespace cath::score {
 
 		[[nodiscard]] size_t do_get_length( const align::alignment &, const protein &, const protein & ) const final;
 
+		[[nodiscard]] size_t do_get_length_with_cache( const align::alignment &, const protein &, const protein &, detail::score_common_coord_cache & ) const final;
+
 		[[nodiscard]] length_getter_category do_get_length_getter_category() const final;
 
 		[[nodiscard]] std::string do_id_name() const final;
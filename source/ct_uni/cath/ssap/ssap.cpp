@@ -119,6 +119,7 @@
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <sstream>
 #include <string>
 
 #include <boost/algorithm/string/case_conv.hpp>
@@ -197,6 +198,7 @@ using ::std::min;
 using ::std::nullopt;
 using ::std::ofstream;
 using ::std::ostream;
+using ::std::ostringstream;
 using ::std::pair;
 using ::std::string;
 using ::std::vector;
@@ -227,45 +229,51 @@ constexpr size_t     SEC_STRUC_PLANAR_C_ANGLE =  10;
 //        - allocating the required amount of memory rather than just using 5000x5000 ints for each!
 //       Also, I suspect that quite a bit of complication throughout the file is just indexing these matrices,
 //       which should be encapsulated.
+//
+// These are thread_local so that separate threads can each run their own SSAPs concurrently
+// (as do_the_ssaps_alignment_acquirer does) without trampling over each other's state.
 
 /// \brief Matrix of upper scores
-static score_vec_of_vec   global_upper_score_matrix;
+static thread_local score_vec_of_vec   global_upper_score_matrix;
 
 /// \brief Matrix to mask out comparisons that should be skipped whilst performing upper-matrix residue comparisons
-static bool_vec_of_vec    global_upper_res_mask_matrix;
+static thread_local bool_vec_of_vec    global_upper_res_mask_matrix;
 
 /// \brief Matrix to mask out comparisons that should be skipped whilst performing upper-matrix, secondary-structure comparisons
-static bool_vec_of_vec    global_upper_ss_mask_matrix;
+static thread_local bool_vec_of_vec    global_upper_ss_mask_matrix;
 
 /// \brief Matrix to mask out comparisons that should be skipped whilst performing lower-matrix (residue or secondary structure) comparisons
-static bool_vec_of_vec    global_lower_mask_matrix;
+static thread_local bool_vec_of_vec    global_lower_mask_matrix;
+
+static thread_local size_size_pair_vec global_selections;              ///< Selected region within matrix
 
-static size_size_pair_vec global_selections;              ///< Selected region within matrix
+static thread_local size_t             global_num_selections  =     0; ///< The number of selected top-scoring residue pairs
+static thread_local size_t             global_window          =     0; ///< The size of the window to
+static thread_local size_t             global_window_add      =    70; ///< The amount that should be added to the difference in lengths to calculate window size
+static thread_local size_t             global_res_sim_cutoff  =   150; ///<
 
-static size_t             global_num_selections  =     0; ///< The number of selected top-scoring residue pairs
-static size_t             global_window          =     0; ///< The size of the window to
-static size_t             global_window_add      =    70; ///< The amount that should be added to the difference in lengths to calculate window size
-static size_t             global_res_sim_cutoff  =   150; ///<
+static thread_local ptrdiff_t          global_run_counter     =     0; ///<
 
-static ptrdiff_t          global_run_counter     =     0; ///<
+static thread_local score_type         global_gap_penalty     =    50; ///< The gap penalty to be used in dynamic programming
 
-static score_type         global_gap_penalty     =    50; ///< The gap penalty to be used in dynamic programming
+static thread_local bool               global_debug           = false; ///< Whether to output debug messages
+static thread_local bool               global_align_pass      = false; ///< Whether the pass is a later, refining alignment pass
+static thread_local bool               global_supaln          =  true; ///<
+static thread_local bool               global_doing_fast_ssap =  true; ///< Whether currently performing a fast SSAP
+static thread_local bool               global_res_score       = false; ///<
 
-static bool               global_debug           = false; ///< Whether to output debug messages
-static bool               global_align_pass      = false; ///< Whether the pass is a later, refining alignment pass
-static bool               global_supaln          =  true; ///<
-static bool               global_doing_fast_ssap =  true; ///< Whether currently performing a fast SSAP
-static bool               global_res_score       = false; ///<
+static thread_local double             global_frac_selected   =   0.0; ///<
 
-static double             global_frac_selected   =   0.0; ///<
+static thread_local double             global_score_run1      =   0.0; ///<
+static thread_local double             global_score_run2      =   0.0; ///<
+static thread_local double             global_ssap_score1     =   0.0; ///<
+static thread_local double             global_ssap_score2     =   0.0; ///<
 
-static double             global_score_run1      =   0.0; ///<
-static double             global_score_run2      =   0.0; ///<
-static double             global_ssap_score1     =   0.0; ///<
-static double             global_ssap_score2     =   0.0; ///<
+static thread_local char               global_ssap_line1[SSAP_LINE_LENGTH]; ///<
+static thread_local char               global_ssap_line2[SSAP_LINE_LENGTH]; ///<
 
-static char               global_ssap_line1[SSAP_LINE_LENGTH]; ///<
-static char               global_ssap_line2[SSAP_LINE_LENGTH]; ///<
+static thread_local bool               global_write_aln_file  =  true; ///< Whether plot_aln should write its alignment to a file in the alignment directory
+static thread_local str_opt            global_aln_string;              ///< The legacy-format alignment most recently output by plot_aln (whether or not to a file)
 
 /// \brief Reset all the global variable that are used by SSAP
 ///
@@ -300,6 +308,8 @@ void cath::reset_ssap_global_variables() {
 	global_ssap_score2     =   0.0;
 	fill_n(global_ssap_line1, SSAP_LINE_LENGTH, 0);
 	fill_n(global_ssap_line2, SSAP_LINE_LENGTH, 0);
+	global_write_aln_file  =  true;
+	global_aln_string      = nullopt;
 }
 
 /// \brief Temporary setter for global_run_counter to allow tests to check their fixtures are
@@ -504,6 +514,79 @@ void cath::run_ssap(const cath_ssap_options &prm_cath_ssap_options, ///< The cat
 	);
 }
 
+/// \brief SSAP a pair of already-loaded, SSAP-ready proteins without reading or writing any files
+///
+/// This does the same as run_ssap() except that it takes the proteins directly and returns
+/// the alignment (in the legacy CATH SSAP format) rather than writing it to the alignment directory.
+///
+/// Since the SSAP global variables are thread_local, this may be called concurrently from different threads.
+///
+/// \returns The scores output (as run_ssap() would write it) and the alignment
+///          (or nullopt if the SSAP didn't produce one that was good enough to be written)
+pair<string, str_opt> cath::run_ssap_in_memory(const protein                &prm_protein_a,    ///< The first SSAP-ready protein
+                                               const protein                &prm_protein_b,    ///< The second SSAP-ready protein
+                                               const old_ssap_options_block &prm_ssap_options, ///< The old_ssap_options_block to specify how things should be done
+                                               const data_dirs_spec         &prm_data_dirs     ///< The data directories from which any data should be read
+                                               ) {
+	reset_ssap_global_variables();
+	global_debug          = prm_ssap_options.get_debug();
+	global_write_aln_file = false;
+
+	ostringstream scores_ss;
+	if ( prm_protein_a.get_length() == 0 || prm_protein_b.get_length() == 0 ) {
+		save_zero_scores( prm_protein_a, prm_protein_b, 2 );
+		scores_ss << global_ssap_line2 << "\n";
+		return { scores_ss.str(), nullopt };
+	}
+
+	align_proteins( prm_protein_a, prm_protein_b, prm_ssap_options, prm_data_dirs );
+
+	print_ssap_scores(
+		scores_ss,
+		global_ssap_score1,
+		global_ssap_score2,
+		global_ssap_line1,
+		global_ssap_line2,
+		global_run_counter,
+		prm_ssap_options.get_write_all_scores()
+	);
+	return { scores_ss.str(), global_aln_string };
+}
+
+/// \brief Calculate a cheap similarity score for a pair of already-loaded, SSAP-ready proteins
+///         by only aligning their secondary structures
+///
+/// This does the secondary-structure alignment with which fast_ssap() begins
+/// (without any of the subsequent residue passes) and scores the result. That's much quicker
+/// than a full SSAP so it's useful for choosing which pairs are worth a full SSAP.
+///
+/// Since the SSAP global variables are thread_local, this may be called concurrently from different threads.
+///
+/// \returns The SSAP score (over the larger) of the secondary-structure alignment
+///          (or 0.0 if either protein has fewer than two secondary structures)
+double cath::ssap_sec_struc_score(const protein                &prm_protein_a,    ///< The first SSAP-ready protein
+                                  const protein                &prm_protein_b,    ///< The second SSAP-ready protein
+                                  const old_ssap_options_block &prm_ssap_options, ///< The old_ssap_options_block to specify how things should be done
+                                  const data_dirs_spec         &prm_data_dirs     ///< The data directories from which any data should be read
+                                  ) {
+	reset_ssap_global_variables();
+	global_debug          = prm_ssap_options.get_debug();
+	global_write_aln_file = false;
+
+	if ( prm_protein_a.get_num_sec_strucs() <= 1 || prm_protein_b.get_num_sec_strucs() <= 1 ) {
+		return 0.0;
+	}
+
+	// Set the alignment options as align_proteins() does before its first fast_ssap()
+	global_res_score   = false;
+	global_align_pass  = false;
+	global_gap_penalty =     5;
+	global_window      = max( prm_protein_a.get_num_sec_strucs(), prm_protein_b.get_num_sec_strucs() );
+
+	++global_run_counter;
+	const alignment sec_struc_alignment = compare( prm_protein_a, prm_protein_b, 1, sec_struc_querier(), prm_ssap_options, prm_data_dirs, nullopt ).second;
+	return calculate_log_score( sec_struc_alignment, prm_protein_a, prm_protein_b, sec_struc_querier() ).get_ssap_score_over_larger();
+}
 
 /// \brief Align structures
 ///
@@ -2099,17 +2182,26 @@ ssap_scores cath::plot_aln(const protein                 &prm_protein_a,     ///
 				::spdlog::debug( "Function: print_aln {} {}",
 				                 to_string( prm_protein_a.get_name_set() ),
 				                 to_string( prm_protein_b.get_name_set() ) );
-				const path alignment_out_file = prm_ssap_options.get_alignment_dir() / (
-					  get_domain_or_specified_or_name_from_acq( prm_protein_a )
-					+ get_domain_or_specified_or_name_from_acq( prm_protein_b )
-					+ ".list"
-				);
-				write_alignment_as_cath_ssap_legacy_format(
-					alignment_out_file,
-					prm_alignment,
-					prm_protein_a,
-					prm_protein_b
-				);
+				if ( global_write_aln_file ) {
+					const path alignment_out_file = prm_ssap_options.get_alignment_dir() / (
+						  get_domain_or_specified_or_name_from_acq( prm_protein_a )
+						+ get_domain_or_specified_or_name_from_acq( prm_protein_b )
+						+ ".list"
+					);
+					write_alignment_as_cath_ssap_legacy_format(
+						alignment_out_file,
+						prm_alignment,
+						prm_protein_a,
+						prm_protein_b
+					);
+				}
+				else {
+					global_aln_string = to_cath_ssap_legacy_format_alignment_string(
+						prm_alignment,
+						prm_protein_a,
+						prm_protein_b
+					);
+				}
 			}
 		}
 	}
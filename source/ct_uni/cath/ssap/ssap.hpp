@@ -71,6 +71,16 @@ namespace cath {
 	              std::ostream & = std::cerr,
 	              const ostream_ref_opt & = ::std::nullopt);
 
+	std::pair<std::string, str_opt> run_ssap_in_memory(const protein &,
+	                                                   const protein &,
+	                                                   const opts::old_ssap_options_block &,
+	                                                   const opts::data_dirs_spec &);
+
+	double ssap_sec_struc_score(const protein &,
+	                            const protein &,
+	                            const opts::old_ssap_options_block &,
+	                            const opts::data_dirs_spec &);
+
 	void align_proteins(const protein &,
 	                    const protein &,
 	                    const opts::old_ssap_options_block &,
@@ -0,0 +1,284 @@
+/// \file
+/// \brief The qcp_superpose definitions
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "qcp_superpose.hpp"
+
+#include <boost/range/combine.hpp>
+
+#include "cath/common/exception/invalid_argument_exception.hpp"
+#include "cath/structure/geometry/coord_list.hpp"
+#include "cath/structure/geometry/rotation.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace ::cath::common;
+using namespace ::cath::geom;
+
+using ::boost::range::combine;
+using ::std::array;
+using ::std::fabs;
+using ::std::max;
+using ::std::sqrt;
+
+namespace {
+
+	/// \brief A symmetric 4x4 matrix, stored in full, row-major
+	using mat_4x4 = array<double, 16>;
+
+	/// \brief The maximum number of Newton-Raphson steps to take when finding the largest eigenvalue
+	constexpr size_t QCP_MAX_NEWTON_STEPS = 50;
+
+	/// \brief The relative change in the eigenvalue estimate below which the Newton-Raphson steps stop
+	constexpr double QCP_EIGENVALUE_PRECISION = 1e-11;
+
+	/// \brief The squared norm (relative to the scale of the problem) below which an adjugate
+	///        column is considered too degenerate to give the eigenvector
+	constexpr double QCP_EIGENVECTOR_PRECISION = 1e-20;
+
+	/// \brief Build the 4x4 key matrix for the specified row-major cross-covariance matrix
+	///
+	/// The eigenvector of the largest eigenvalue of this matrix is the quaternion of the
+	/// rotation that best superposes the first list of coords onto the second
+	/// (see Horn 1987, doi:10.1364/JOSAA.4.000629)
+	mat_4x4 make_key_matrix(const array<double, 9> &prm_cross_cov ///< The row-major cross-covariance matrix
+	                        ) {
+		const double &s_xx = prm_cross_cov[ 0 ];
+		const double &s_xy = prm_cross_cov[ 1 ];
+		const double &s_xz = prm_cross_cov[ 2 ];
+		const double &s_yx = prm_cross_cov[ 3 ];
+		const double &s_yy = prm_cross_cov[ 4 ];
+		const double &s_yz = prm_cross_cov[ 5 ];
+		const double &s_zx = prm_cross_cov[ 6 ];
+		const double &s_zy = prm_cross_cov[ 7 ];
+		const double &s_zz = prm_cross_cov[ 8 ];
+		return {
+			 s_xx + s_yy + s_zz,    s_yz - s_zy,           s_zx - s_xz,           s_xy - s_yx,
+			 s_yz - s_zy,           s_xx - s_yy - s_zz,    s_xy + s_yx,           s_zx + s_xz,
+			 s_zx - s_xz,           s_xy + s_yx,          -s_xx + s_yy - s_zz,    s_yz + s_zy,
+			 s_xy - s_yx,           s_zx + s_xz,           s_yz + s_zy,          -s_xx - s_yy + s_zz,
+		};
+	}
+
+	/// \brief Calculate the determinant of the 3x3 submatrix of the specified 4x4 matrix
+	///        formed by removing the specified row and column
+	double minor_of_4x4(const mat_4x4 &prm_matrix, ///< The 4x4 matrix
+	                    const size_t  &prm_row,    ///< The row to remove
+	                    const size_t  &prm_col     ///< The column to remove
+	                    ) {
+		array<size_t, 3> rows{};
+		array<size_t, 3> cols{};
+		for (size_t from_ctr = 0, row_ctr = 0, col_ctr = 0; from_ctr < 4; ++from_ctr) {
+			if ( from_ctr != prm_row ) {
+				rows[ row_ctr++ ] = from_ctr;
+			}
+			if ( from_ctr != prm_col ) {
+				cols[ col_ctr++ ] = from_ctr;
+			}
+		}
+		const auto val = [&] (const size_t &x, const size_t &y) {
+			return prm_matrix[ 4 * rows[ x ] + cols[ y ] ];
+		};
+		return val( 0, 0 ) * ( val( 1, 1 ) * val( 2, 2 ) - val( 1, 2 ) * val( 2, 1 ) )
+		     - val( 0, 1 ) * ( val( 1, 0 ) * val( 2, 2 ) - val( 1, 2 ) * val( 2, 0 ) )
+		     + val( 0, 2 ) * ( val( 1, 0 ) * val( 2, 1 ) - val( 1, 1 ) * val( 2, 0 ) );
+	}
+
+	/// \brief Calculate the specified cofactor of the specified 4x4 matrix
+	double cofactor_of_4x4(const mat_4x4 &prm_matrix, ///< The 4x4 matrix
+	                       const size_t  &prm_row,    ///< The row of the cofactor
+	                       const size_t  &prm_col     ///< The column of the cofactor
+	                       ) {
+		const double minor = minor_of_4x4( prm_matrix, prm_row, prm_col );
+		return ( ( prm_row + prm_col ) % 2 == 0 ) ? minor : -minor;
+	}
+
+	/// \brief Calculate the determinant of the specified 4x4 matrix
+	double determinant_of_4x4(const mat_4x4 &prm_matrix ///< The 4x4 matrix
+	                          ) {
+		double result = 0.0;
+		for (size_t col_ctr = 0; col_ctr < 4; ++col_ctr) {
+			result += prm_matrix[ col_ctr ] * cofactor_of_4x4( prm_matrix, 0, col_ctr );
+		}
+		return result;
+	}
+
+} // namespace
+
+/// \brief Make the qcp_inner_products for two coord_lists
+///
+/// \pre `prm_coords_a.size() == prm_coords_b.size()` else an invalid_argument_exception will be thrown
+///
+/// \relates qcp_inner_products
+qcp_inner_products cath::geom::make_qcp_inner_products(const coord_list &prm_coords_a, ///< The first  list of coords
+                                                       const coord_list &prm_coords_b  ///< The second list of coords
+                                                       ) {
+	if ( prm_coords_a.size() != prm_coords_b.size() ) {
+		BOOST_THROW_EXCEPTION(invalid_argument_exception("Cannot make QCP inner products for lists of coordinates of different length"));
+	}
+
+	const coord centre_a = prm_coords_a.empty() ? ORIGIN_COORD : centre_of_gravity( prm_coords_a );
+	const coord centre_b = prm_coords_b.empty() ? ORIGIN_COORD : centre_of_gravity( prm_coords_b );
+
+	array<double, 9> cross_covariance{};
+	double           sum_of_squares = 0.0;
+	for (const auto &[ raw_coord_a, raw_coord_b ] : combine( prm_coords_a, prm_coords_b ) ) {
+		const coord coord_a = raw_coord_a - centre_a;
+		const coord coord_b = raw_coord_b - centre_b;
+
+		sum_of_squares += squared_length( coord_a ) + squared_length( coord_b );
+
+		cross_covariance[ 0 ] += coord_a.get_x() * coord_b.get_x();
+		cross_covariance[ 1 ] += coord_a.get_x() * coord_b.get_y();
+		cross_covariance[ 2 ] += coord_a.get_x() * coord_b.get_z();
+		cross_covariance[ 3 ] += coord_a.get_y() * coord_b.get_x();
+		cross_covariance[ 4 ] += coord_a.get_y() * coord_b.get_y();
+		cross_covariance[ 5 ] += coord_a.get_y() * coord_b.get_z();
+		cross_covariance[ 6 ] += coord_a.get_z() * coord_b.get_x();
+		cross_covariance[ 7 ] += coord_a.get_z() * coord_b.get_y();
+		cross_covariance[ 8 ] += coord_a.get_z() * coord_b.get_z();
+	}
+
+	return {
+		cross_covariance,
+		sum_of_squares,
+		prm_coords_a.size(),
+		centre_a,
+		centre_b
+	};
+}
+
+/// \brief Find the largest eigenvalue of the QCP key matrix for the specified qcp_inner_products
+///
+/// This finds the largest root of the key matrix's characteristic polynomial
+/// `x^4 + c2 x^2 + c1 x + c0` by Newton-Raphson from the upper bound of half the sum of squares.
+///
+/// \relates qcp_inner_products
+double cath::geom::qcp_max_eigenvalue(const qcp_inner_products &prm_inner_products ///< The qcp_inner_products
+                                      ) {
+	const auto   &cross_cov  = prm_inner_products.get_cross_covariance();
+	const mat_4x4 key_matrix = make_key_matrix( cross_cov );
+
+	double sum_sq_cross_cov = 0.0;
+	for (const double &value : cross_cov) {
+		sum_sq_cross_cov += value * value;
+	}
+	const double det_cross_cov =
+		  cross_cov[ 0 ] * ( cross_cov[ 4 ] * cross_cov[ 8 ] - cross_cov[ 5 ] * cross_cov[ 7 ] )
+		- cross_cov[ 1 ] * ( cross_cov[ 3 ] * cross_cov[ 8 ] - cross_cov[ 5 ] * cross_cov[ 6 ] )
+		+ cross_cov[ 2 ] * ( cross_cov[ 3 ] * cross_cov[ 7 ] - cross_cov[ 4 ] * cross_cov[ 6 ] );
+
+	const double c2 = -2.0 * sum_sq_cross_cov;
+	const double c1 = -8.0 * det_cross_cov;
+	const double c0 = determinant_of_4x4( key_matrix );
+
+	double eigenvalue = 0.5 * prm_inner_products.get_sum_of_squares();
+	for (size_t step_ctr = 0; step_ctr < QCP_MAX_NEWTON_STEPS; ++step_ctr) {
+		const double prev_eigenvalue = eigenvalue;
+		const double eigenvalue_sq   = eigenvalue * eigenvalue;
+		const double b               = ( eigenvalue_sq + c2 ) * eigenvalue;
+		const double a               = b + c1;
+		const double derivative      = 2.0 * eigenvalue_sq * eigenvalue + b + a;
+		if ( derivative == 0.0 ) {
+			break;
+		}
+		eigenvalue -= ( a * eigenvalue + c0 ) / derivative;
+		if ( fabs( eigenvalue - prev_eigenvalue ) <= QCP_EIGENVALUE_PRECISION * fabs( eigenvalue ) ) {
+			break;
+		}
+	}
+	return eigenvalue;
+}
+
+/// \brief Calculate the RMSD of the optimal superposition described by the specified qcp_inner_products
+///
+/// This doesn't calculate the rotation, which makes it cheaper than qcp_rotation_1st_to_2nd()
+///
+/// \relates qcp_inner_products
+double cath::geom::qcp_superposed_rmsd(const qcp_inner_products &prm_inner_products ///< The qcp_inner_products
+                                       ) {
+	if ( prm_inner_products.get_num_coords() == 0 ) {
+		return 0.0;
+	}
+	const double sum_sq_deviations = prm_inner_products.get_sum_of_squares() - 2.0 * qcp_max_eigenvalue( prm_inner_products );
+	return sqrt( max( 0.0, sum_sq_deviations / static_cast<double>( prm_inner_products.get_num_coords() ) ) );
+}
+
+/// \brief Find the rotation that, when applied to the first list of coords (about its centre of gravity),
+///        best superposes it onto the second (about its centre of gravity)
+///
+/// The quaternion is taken from whichever column of the adjugate of (key_matrix - max_eigenvalue * I)
+/// is longest. If all columns are degenerate (eg for an empty or single-point list), this returns
+/// the identity rotation.
+///
+/// \relates qcp_inner_products
+rotation cath::geom::qcp_rotation_1st_to_2nd(const qcp_inner_products &prm_inner_products ///< The qcp_inner_products
+                                             ) {
+	const double eigenvalue = qcp_max_eigenvalue( prm_inner_products );
+	mat_4x4      shifted    = make_key_matrix( prm_inner_products.get_cross_covariance() );
+	for (size_t diag_ctr = 0; diag_ctr < 4; ++diag_ctr) {
+		shifted[ 5 * diag_ctr ] -= eigenvalue;
+	}
+
+	// The adjugate is symmetric (because the shifted key matrix is), so its columns are the cofactor rows
+	array<double, 4> best_column{ 1.0, 0.0, 0.0, 0.0 };
+	double           best_norm_sq = 0.0;
+	for (size_t col_ctr = 0; col_ctr < 4; ++col_ctr) {
+		array<double, 4> column{};
+		double           norm_sq = 0.0;
+		for (size_t row_ctr = 0; row_ctr < 4; ++row_ctr) {
+			column[ row_ctr ] = cofactor_of_4x4( shifted, col_ctr, row_ctr );
+			norm_sq += column[ row_ctr ] * column[ row_ctr ];
+		}
+		if ( norm_sq > best_norm_sq ) {
+			best_column  = column;
+			best_norm_sq = norm_sq;
+		}
+	}
+
+	const double scale           = max( 1.0, fabs( eigenvalue ) );
+	const double scale_sixth_pow = scale * scale * scale * scale * scale * scale;
+	if ( ! ( best_norm_sq > QCP_EIGENVECTOR_PRECISION * scale_sixth_pow ) ) {
+		return IDENTITY_ROTATION;
+	}
+
+	const double norm = sqrt( best_norm_sq );
+	const double q_w  = best_column[ 0 ] / norm;
+	const double q_x  = best_column[ 1 ] / norm;
+	const double q_y  = best_column[ 2 ] / norm;
+	const double q_z  = best_column[ 3 ] / norm;
+
+	const double q_ww = q_w * q_w;
+	const double q_xx = q_x * q_x;
+	const double q_yy = q_y * q_y;
+	const double q_zz = q_z * q_z;
+	const double q_wx = q_w * q_x;
+	const double q_wy = q_w * q_y;
+	const double q_wz = q_w * q_z;
+	const double q_xy = q_x * q_y;
+	const double q_xz = q_x * q_z;
+	const double q_yz = q_y * q_z;
+
+	return {
+		q_ww + q_xx - q_yy - q_zz, 2.0 * ( q_xy - q_wz ),     2.0 * ( q_xz + q_wy ),
+		2.0 * ( q_xy + q_wz ),     q_ww - q_xx + q_yy - q_zz, 2.0 * ( q_yz - q_wx ),
+		2.0 * ( q_xz - q_wy ),     2.0 * ( q_yz + q_wx ),     q_ww - q_xx - q_yy + q_zz
+	};
+}
@@ -0,0 +1,210 @@
+/// \file
+/// \brief The qcp_superpose header
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef CATH_TOOLS_SOURCE_CT_UNI_CATH_STRUCTURE_GEOMETRY_QCP_SUPERPOSE_HPP
+#define CATH_TOOLS_SOURCE_CT_UNI_CATH_STRUCTURE_GEOMETRY_QCP_SUPERPOSE_HPP
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+
+#include "cath/structure/geometry/coord.hpp"
+#include "cath/structure/geometry/rotation.hpp"
+
+// clang-format off
+namespace cath::geom { class coord_list; }
+// clang-format on
+
+namespace cath::geom {
+
+	/// \brief The sums that a QCP (quaternion characteristic polynomial) superposition needs
+	///        from two equal-length lists of coords
+	///
+	/// These are gathered about each list's centre of gravity so the inputs needn't be centred.
+	///
+	/// QCP (Theobald 2005, doi:10.1107/S0108767305015266; Liu et al. 2010, doi:10.1002/jcc.21439)
+	/// finds the optimal superposition's RMSD from the largest root of a quartic, using a few Newton steps,
+	/// and the rotation from a column of the adjugate of the 4x4 key matrix. Neither requires any allocation,
+	/// which makes this much cheaper than building GSL matrices and performing an SVD.
+	class qcp_inner_products final {
+	private:
+		/// \brief The cross-covariance matrix, in row-major order: entry `3 * i + j` is the sum of `a_i * b_j`
+		std::array<double, 9> cross_covariance;
+
+		/// \brief The sum of the squared lengths of the (centred) coords of both lists
+		double sum_of_squares;
+
+		/// \brief The number of coords in each list
+		size_t num_coords;
+
+		/// \brief The centre of gravity of the first list of coords
+		coord centre_a;
+
+		/// \brief The centre of gravity of the second list of coords
+		coord centre_b;
+
+	public:
+		qcp_inner_products(const std::array<double, 9> &,
+		                   const double &,
+		                   const size_t &,
+		                   const coord &,
+		                   const coord &);
+
+		[[nodiscard]] const std::array<double, 9> &get_cross_covariance() const;
+		[[nodiscard]] const double &get_sum_of_squares() const;
+		[[nodiscard]] const size_t &get_num_coords() const;
+		[[nodiscard]] const coord &get_centre_a() const;
+		[[nodiscard]] const coord &get_centre_b() const;
+	};
+
+	/// \brief Ctor for qcp_inner_products
+	inline qcp_inner_products::qcp_inner_products(const std::array<double, 9> &prm_cross_covariance, ///< The row-major cross-covariance matrix
+	                                              const double                &prm_sum_of_squares,   ///< The sum of the squared lengths of the centred coords of both lists
+	                                              const size_t                &prm_num_coords,       ///< The number of coords in each list
+	                                              const coord                 &prm_centre_a,         ///< The centre of gravity of the first  list of coords
+	                                              const coord                 &prm_centre_b          ///< The centre of gravity of the second list of coords
+	                                              ) : cross_covariance { prm_cross_covariance },
+	                                                  sum_of_squares   { prm_sum_of_squares   },
+	                                                  num_coords       { prm_num_coords       },
+	                                                  centre_a         { prm_centre_a         },
+	                                                  centre_b         { prm_centre_b         } {
+	}
+
+	/// \brief Getter for the row-major cross-covariance matrix
+	inline const std::array<double, 9> & qcp_inner_products::get_cross_covariance() const {
+		return cross_covariance;
+	}
+
+	/// \brief Getter for the sum of the squared lengths of the centred coords of both lists
+	inline const double & qcp_inner_products::get_sum_of_squares() const {
+		return sum_of_squares;
+	}
+
+	/// \brief Getter for the number of coords in each list
+	inline const size_t & qcp_inner_products::get_num_coords() const {
+		return num_coords;
+	}
+
+	/// \brief Getter for the centre of gravity of the first list of coords
+	inline const coord & qcp_inner_products::get_centre_a() const {
+		return centre_a;
+	}
+
+	/// \brief Getter for the centre of gravity of the second list of coords
+	inline const coord & qcp_inner_products::get_centre_b() const {
+		return centre_b;
+	}
+
+	/// \brief Make the qcp_inner_products for two contiguous arrays of interleaved coords (x0, y0, z0, x1, ...)
+	///
+	/// This makes two passes over the data (one for the centres of gravity and one for the sums) and
+	/// accumulates in double, whatever T is. It performs no allocation.
+	///
+	/// \pre Each array must contain `3 * prm_num_coords` values
+	///
+	/// \relates qcp_inner_products
+	template <typename T>
+	qcp_inner_products make_qcp_inner_products(const T      *prm_coords_a,  ///< The first  array of interleaved coords
+	                                           const T      *prm_coords_b,  ///< The second array of interleaved coords
+	                                           const size_t &prm_num_coords ///< The number of coords in each array
+	                                           ) {
+		static_assert( std::is_floating_point_v<T>, "make_qcp_inner_products() requires arrays of floating-point values" );
+
+		std::array<double, 3> sum_a{ 0.0, 0.0, 0.0 };
+		std::array<double, 3> sum_b{ 0.0, 0.0, 0.0 };
+		for (size_t value_ctr = 0; value_ctr < 3 * prm_num_coords; value_ctr += 3) {
+			for (size_t dim_ctr = 0; dim_ctr < 3; ++dim_ctr) {
+				sum_a[ dim_ctr ] += static_cast<double>( prm_coords_a[ value_ctr + dim_ctr ] );
+				sum_b[ dim_ctr ] += static_cast<double>( prm_coords_b[ value_ctr + dim_ctr ] );
+			}
+		}
+		const double num_coords_dbl = ( prm_num_coords > 0 ) ? static_cast<double>( prm_num_coords ) : 1.0;
+		const coord  centre_a{ sum_a[ 0 ] / num_coords_dbl, sum_a[ 1 ] / num_coords_dbl, sum_a[ 2 ] / num_coords_dbl };
+		const coord  centre_b{ sum_b[ 0 ] / num_coords_dbl, sum_b[ 1 ] / num_coords_dbl, sum_b[ 2 ] / num_coords_dbl };
+
+		std::array<double, 9> cross_covariance{};
+		double                sum_of_squares = 0.0;
+		for (size_t value_ctr = 0; value_ctr < 3 * prm_num_coords; value_ctr += 3) {
+			const double a_x = static_cast<double>( prm_coords_a[ value_ctr     ] ) - centre_a.get_x();
+			const double a_y = static_cast<double>( prm_coords_a[ value_ctr + 1 ] ) - centre_a.get_y();
+			const double a_z = static_cast<double>( prm_coords_a[ value_ctr + 2 ] ) - centre_a.get_z();
+			const double b_x = static_cast<double>( prm_coords_b[ value_ctr     ] ) - centre_b.get_x();
+			const double b_y = static_cast<double>( prm_coords_b[ value_ctr + 1 ] ) - centre_b.get_y();
+			const double b_z = static_cast<double>( prm_coords_b[ value_ctr + 2 ] ) - centre_b.get_z();
+
+			sum_of_squares += a_x * a_x + a_y * a_y + a_z * a_z
+			                + b_x * b_x + b_y * b_y + b_z * b_z;
+
+			cross_covariance[ 0 ] += a_x * b_x;
+			cross_covariance[ 1 ] += a_x * b_y;
+			cross_covariance[ 2 ] += a_x * b_z;
+			cross_covariance[ 3 ] += a_y * b_x;
+			cross_covariance[ 4 ] += a_y * b_y;
+			cross_covariance[ 5 ] += a_y * b_z;
+			cross_covariance[ 6 ] += a_z * b_x;
+			cross_covariance[ 7 ] += a_z * b_y;
+			cross_covariance[ 8 ] += a_z * b_z;
+		}
+
+		return {
+			cross_covariance,
+			sum_of_squares,
+			prm_num_coords,
+			centre_a,
+			centre_b
+		};
+	}
+
+	qcp_inner_products make_qcp_inner_products(const coord_list &,
+	                                           const coord_list &);
+
+	double qcp_max_eigenvalue(const qcp_inner_products &);
+
+	double qcp_superposed_rmsd(const qcp_inner_products &);
+
+	rotation qcp_rotation_1st_to_2nd(const qcp_inner_products &);
+
+	/// \brief Calculate the RMSD of the optimal superposition of two contiguous arrays of interleaved coords
+	///        without calculating the rotation itself
+	///
+	/// \pre Each array must contain `3 * prm_num_coords` values
+	template <typename T>
+	double qcp_superposed_rmsd(const T      *prm_coords_a,  ///< The first  array of interleaved coords
+	                           const T      *prm_coords_b,  ///< The second array of interleaved coords
+	                           const size_t &prm_num_coords ///< The number of coords in each array
+	                           ) {
+		return qcp_superposed_rmsd( make_qcp_inner_products( prm_coords_a, prm_coords_b, prm_num_coords ) );
+	}
+
+	/// \brief Find the rotation that, when applied to the first array of interleaved coords (about its
+	///        centre of gravity), best superposes it onto the second (about its centre of gravity)
+	///
+	/// \pre Each array must contain `3 * prm_num_coords` values
+	template <typename T>
+	rotation qcp_superpose_fit_1st_to_2nd(const T      *prm_coords_a,  ///< The first  array of interleaved coords, to superpose onto the second
+	                                      const T      *prm_coords_b,  ///< The second array of interleaved coords
+	                                      const size_t &prm_num_coords ///< The number of coords in each array
+	                                      ) {
+		return qcp_rotation_1st_to_2nd( make_qcp_inner_products( prm_coords_a, prm_coords_b, prm_num_coords ) );
+	}
+
+} // namespace cath::geom
+
+#endif // CATH_TOOLS_SOURCE_CT_UNI_CATH_STRUCTURE_GEOMETRY_QCP_SUPERPOSE_HPP
@@ -0,0 +1,210 @@
+/// \file
+/// \brief The qcp_superpose test suite
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <boost/test/unit_test.hpp>
+
+#include "cath/common/chrono/duration_to_seconds_string.hpp"
+#include "cath/common/size_t_literal.hpp"
+#include "cath/common/type_aliases.hpp"
+#include "cath/structure/geometry/coord.hpp"
+#include "cath/structure/geometry/coord_list.hpp"
+#include "cath/structure/geometry/qcp_superpose.hpp"
+#include "cath/structure/geometry/rotation.hpp"
+#include "cath/structure/geometry/superpose_fit.hpp"
+
+#include <chrono>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace ::cath;
+using namespace ::cath::common;
+using namespace ::cath::geom;
+
+using ::cath::common::literals::operator""_z;
+using ::std::chrono::high_resolution_clock;
+using ::std::mt19937;
+using ::std::normal_distribution;
+
+namespace {
+
+	/// \brief The qcp_superpose_test_suite_fixture to assist in testing qcp_superpose
+	struct qcp_superpose_test_suite_fixture {
+	protected:
+		~qcp_superpose_test_suite_fixture() noexcept = default;
+
+		/// \brief The tolerance within which QCP results should match those of the Kabsch SVD
+		static constexpr double TOLERANCE = 1e-6;
+
+		/// \brief Make a pair of centred, protein-sized coord_lists in which the second is a noisy rotation of the first
+		static std::pair<coord_list, coord_list> make_noisy_rotated_pair(mt19937      &prm_rng,       ///< The random number generator
+		                                                                 const size_t &prm_num_coords ///< The number of coords in each list
+		                                                                 ) {
+			normal_distribution<double> spread_dist{ 0.0, 10.0 };
+			normal_distribution<double> noise_dist { 0.0,  1.5 };
+			const rotation the_rotation = tidy_copy( rotation_to_x_axis_and_x_y_plane(
+				coord{ spread_dist( prm_rng ), spread_dist( prm_rng ), spread_dist( prm_rng ) },
+				coord{ spread_dist( prm_rng ), spread_dist( prm_rng ), spread_dist( prm_rng ) }
+			) );
+			coord_vec coords_a;
+			coord_vec coords_b;
+			for (size_t coord_ctr = 0; coord_ctr < prm_num_coords; ++coord_ctr) {
+				coords_a.emplace_back( spread_dist( prm_rng ), spread_dist( prm_rng ), spread_dist( prm_rng ) );
+				coords_b.push_back(
+					rotate_copy( the_rotation, coords_a.back() )
+					+ coord{ noise_dist( prm_rng ), noise_dist( prm_rng ), noise_dist( prm_rng ) }
+				);
+			}
+			const coord_list list_a{ coords_a };
+			const coord_list list_b{ coords_b };
+			return {
+				list_a - centre_of_gravity( list_a ),
+				list_b - centre_of_gravity( list_b )
+			};
+		}
+
+		/// \brief Flatten a coord_list into an array of interleaved values of the specified type
+		template <typename T>
+		static std::vector<T> interleaved_values(const coord_list &prm_coords ///< The coords to flatten
+		                                         ) {
+			std::vector<T> result;
+			result.reserve( 3 * prm_coords.size() );
+			for (const coord &the_coord : prm_coords) {
+				result.push_back( static_cast<T>( the_coord.get_x() ) );
+				result.push_back( static_cast<T>( the_coord.get_y() ) );
+				result.push_back( static_cast<T>( the_coord.get_z() ) );
+			}
+			return result;
+		}
+
+		/// \brief Check that the two specified rotations match to within the specified tolerance
+		static void check_rotations_match(const rotation &prm_rotation_a, ///< The first  rotation
+		                                  const rotation &prm_rotation_b, ///< The second rotation
+		                                  const double   &prm_tolerance   ///< The tolerance
+		                                  ) {
+			for (size_t row_ctr = 0; row_ctr < coord::NUM_DIMS; ++row_ctr) {
+				for (size_t col_ctr = 0; col_ctr < coord::NUM_DIMS; ++col_ctr) {
+					BOOST_CHECK_SMALL(
+						prm_rotation_a.get_value( row_ctr, col_ctr ) - prm_rotation_b.get_value( row_ctr, col_ctr ),
+						prm_tolerance
+					);
+				}
+			}
+		}
+	};
+
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE(qcp_superpose_test_suite, qcp_superpose_test_suite_fixture)
+
+BOOST_AUTO_TEST_CASE(rotation_matches_svd_fit) {
+	mt19937 rng{ 1 };
+	for (const size_t &num_coords : { 3_z, 4_z, 10_z, 57_z, 300_z }) {
+		const auto [ coords_a, coords_b ] = make_noisy_rotated_pair( rng, num_coords );
+		check_rotations_match(
+			qcp_rotation_1st_to_2nd( make_qcp_inner_products( coords_a, coords_b ) ),
+			svd_superpose_fit_1st_to_2nd( coords_a, coords_b ),
+			TOLERANCE
+		);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(rmsd_matches_rmsd_of_rotated_coords) {
+	mt19937 rng{ 2 };
+	for (const size_t &num_coords : { 3_z, 10_z, 150_z }) {
+		const auto [ coords_a, coords_b ] = make_noisy_rotated_pair( rng, num_coords );
+		const auto inner_products = make_qcp_inner_products( coords_a, coords_b );
+		BOOST_CHECK_SMALL(
+			qcp_superposed_rmsd( inner_products )
+				- calc_rmsd( rotate_copy( qcp_rotation_1st_to_2nd( inner_products ), coords_a ), coords_b ),
+			TOLERANCE
+		);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(does_not_require_centred_coords) {
+	mt19937 rng{ 3 };
+	const auto [ coords_a, coords_b ] = make_noisy_rotated_pair( rng, 40 );
+	const auto centred_products    = make_qcp_inner_products( coords_a,                            coords_b                            );
+	const auto translated_products = make_qcp_inner_products( coords_a + coord{ 10.0, -4.0, 7.5 }, coords_b + coord{ -31.0, 2.0, 0.5 } );
+	BOOST_CHECK_SMALL( qcp_superposed_rmsd( centred_products ) - qcp_superposed_rmsd( translated_products ), TOLERANCE );
+	check_rotations_match( qcp_rotation_1st_to_2nd( centred_products ), qcp_rotation_1st_to_2nd( translated_products ), TOLERANCE );
+	BOOST_CHECK_EQUAL( translated_products.get_centre_a(), coord( 10.0, -4.0, 7.5 ) );
+}
+
+BOOST_AUTO_TEST_CASE(float_and_double_arrays_match_coord_lists) {
+	mt19937 rng{ 4 };
+	const auto [ coords_a, coords_b ] = make_noisy_rotated_pair( rng, 120 );
+	const auto doubles_a = interleaved_values<double>( coords_a );
+	const auto doubles_b = interleaved_values<double>( coords_b );
+	const auto floats_a  = interleaved_values<float >( coords_a );
+	const auto floats_b  = interleaved_values<float >( coords_b );
+
+	const rotation expected = superpose_fit_1st_to_2nd( coords_a, coords_b );
+	check_rotations_match( qcp_superpose_fit_1st_to_2nd( doubles_a.data(), doubles_b.data(), coords_a.size() ), expected, TOLERANCE );
+	check_rotations_match( qcp_superpose_fit_1st_to_2nd( floats_a.data(),  floats_b.data(),  coords_a.size() ), expected, 1e-5      );
+
+	const double expected_rmsd = qcp_superposed_rmsd( make_qcp_inner_products( coords_a, coords_b ) );
+	BOOST_CHECK_SMALL( qcp_superposed_rmsd( doubles_a.data(), doubles_b.data(), coords_a.size() ) - expected_rmsd, TOLERANCE );
+	BOOST_CHECK_SMALL( qcp_superposed_rmsd( floats_a.data(),  floats_b.data(),  coords_a.size() ) - expected_rmsd, 1e-4      );
+}
+
+BOOST_AUTO_TEST_CASE(degenerate_inputs_give_identity) {
+	const coord_list single{ coord_vec{ coord{ 1.0, 2.0, 3.0 } } };
+	const coord_list empty { coord_vec{                        } };
+	BOOST_CHECK_EQUAL( qcp_rotation_1st_to_2nd( make_qcp_inner_products( single, single ) ), IDENTITY_ROTATION );
+	BOOST_CHECK_EQUAL( qcp_rotation_1st_to_2nd( make_qcp_inner_products( empty,  empty  ) ), IDENTITY_ROTATION );
+	BOOST_CHECK_EQUAL( qcp_superposed_rmsd    ( make_qcp_inner_products( empty,  empty  ) ), 0.0               );
+}
+
+/// \brief Report superpositions per second for QCP and the Kabsch SVD
+///
+/// This is disabled by default; run it with `--run_test=qcp_superpose_test_suite/benchmark_superpositions_per_second`
+BOOST_AUTO_TEST_CASE(benchmark_superpositions_per_second, * boost::unit_test::disabled()) {
+	constexpr size_t NUM_SUPERPOSITIONS = 100'000;
+	mt19937 rng{ 5 };
+	const auto        coords_pair = make_noisy_rotated_pair( rng, 150 );
+	const coord_list &coords_a    = coords_pair.first;
+	const coord_list &coords_b    = coords_pair.second;
+	const auto floats_a = interleaved_values<float>( coords_a );
+	const auto floats_b = interleaved_values<float>( coords_b );
+
+	double     total      = 0.0;
+	const auto time_rate  = [&] (const auto &prm_fn) {
+		const auto start_time = high_resolution_clock::now();
+		for (size_t superposition_ctr = 0; superposition_ctr < NUM_SUPERPOSITIONS; ++superposition_ctr) {
+			total += prm_fn();
+		}
+		return static_cast<double>( NUM_SUPERPOSITIONS ) * durn_to_rate_per_second( high_resolution_clock::now() - start_time );
+	};
+
+	const double svd_rate   = time_rate( [&] { return svd_superpose_fit_1st_to_2nd( coords_a, coords_b ).get_value( 0, 0 ); } );
+	const double qcp_rate   = time_rate( [&] { return superpose_fit_1st_to_2nd    ( coords_a, coords_b ).get_value( 0, 0 ); } );
+	const double float_rate = time_rate( [&] { return qcp_superpose_fit_1st_to_2nd( floats_a.data(), floats_b.data(), coords_a.size() ).get_value( 0, 0 ); } );
+	const double rmsd_rate  = time_rate( [&] { return qcp_superposed_rmsd         ( floats_a.data(), floats_b.data(), coords_a.size() ); } );
+
+	BOOST_TEST_MESSAGE( "Superpositions of 150 coords per second - Kabsch SVD : " << svd_rate   );
+	BOOST_TEST_MESSAGE( "Superpositions of 150 coords per second - QCP        : " << qcp_rate   );
+	BOOST_TEST_MESSAGE( "Superpositions of 150 coords per second - QCP float  : " << float_rate );
+	BOOST_TEST_MESSAGE( "Superpositions of 150 coords per second - QCP RMSD   : " << rmsd_rate  );
+	BOOST_CHECK( total == total );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
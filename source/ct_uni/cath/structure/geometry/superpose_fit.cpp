@@ -26,6 +26,7 @@
 #include "cath/common/gsl/gsl_vector_wrp.hpp"
 #include "cath/structure/geometry/coord_list.hpp"
 #include "cath/structure/geometry/detail/cross_covariance_matrix.hpp"
+#include "cath/structure/geometry/qcp_superpose.hpp"
 #include "cath/structure/geometry/rotation.hpp"
 
 #include <gsl/gsl_blas.h>
@@ -44,9 +45,12 @@ using namespace ::cath::geom::detail;
 ///      else bad stuff might happen (most likely: meaningless results will be returned)
 ///
 /// This uses the Kabsch algorithm, eg see https://en.wikipedia.org/wiki/Kabsch_algorithm
-rotation cath::geom::superpose_fit_1st_to_2nd(const coord_list &prm_coords_a, ///< The first  list of coords to superpose onto the second
-                                              const coord_list &prm_coords_b  ///< The second list of coords
-                                              ) {
+///
+/// This builds several GSL matrices and performs an SVD, which makes it much slower than
+/// superpose_fit_1st_to_2nd(). It's retained as a reference against which that can be checked.
+rotation cath::geom::svd_superpose_fit_1st_to_2nd(const coord_list &prm_coords_a, ///< The first  list of coords to superpose onto the second
+                                                  const coord_list &prm_coords_b  ///< The second list of coords
+                                                  ) {
 	// Check the sizes match
 	if ( prm_coords_a.size() != prm_coords_b.size() ) {
 		BOOST_THROW_EXCEPTION(invalid_argument_exception("This subroutine cannot fit lists of coordinates of different length"));
@@ -114,6 +118,27 @@ rotation cath::geom::superpose_fit_1st_to_2nd(const coord_list &prm_coords_a, //
 	};
 }
 
+/// \brief Find the rotation that, when applied to the first specified coord_list,
+///        best superposes it onto the second specified coord list
+///
+/// \pre `prm_coords_a.size() == prm_coords_b.size()` else an invalid_argument_exception will be thrown
+///
+/// \pre Both prm_coords_a and prm_coords_b must be translated to have the their centres of gravity at the origin
+///      else bad stuff might happen (most likely: meaningless results will be returned)
+///
+/// This uses the allocation-free QCP method (see qcp_inner_products), which agrees with the
+/// Kabsch SVD in svd_superpose_fit_1st_to_2nd() but is much faster.
+rotation cath::geom::superpose_fit_1st_to_2nd(const coord_list &prm_coords_a, ///< The first  list of coords to superpose onto the second
+                                              const coord_list &prm_coords_b  ///< The second list of coords
+                                              ) {
+	// Check the sizes match
+	if ( prm_coords_a.size() != prm_coords_b.size() ) {
+		BOOST_THROW_EXCEPTION(invalid_argument_exception("This subroutine cannot fit lists of coordinates of different length"));
+	}
+
+	return qcp_rotation_1st_to_2nd( make_qcp_inner_products( prm_coords_a, prm_coords_b ) );
+}
+
 /// \brief Find the rotation that, when applied to the second specified coord_list,
 ///        best superposes it onto the first specified coord list
 ///
@@ -28,6 +28,9 @@ namespace cath::geom { class rotation; }
 
 namespace cath::geom {
 
+	geom::rotation svd_superpose_fit_1st_to_2nd(const geom::coord_list &,
+	                                            const geom::coord_list &);
+
 	geom::rotation superpose_fit_1st_to_2nd(const geom::coord_list &,
 	                                        const geom::coord_list &);
 
@@ -164,6 +164,13 @@ namespace cath::index::detail::detail {
 		                               const vcie_match_criteria &,
 		                               ACTN &) const;
 
+		template <typename CELLS, typename FN>
+		inline void for_each_matching_cell_pair(const CELLS &,
+		                                        const view_cache_index_dim_linear<T> &,
+		                                        const CELLS &,
+		                                        const vcie_match_criteria &,
+		                                        FN &&) const;
+
 		template <typename CELLS, typename ACTN>
 		inline void perform_action_on_all_match_at_nodes(const CELLS &,
 		                                                 const view_cache_index_dim_linear<T> &,
@@ -337,15 +344,15 @@ namespace cath::index::detail::detail {
 		}
 	}
 
-	/// \brief TODOCUMENT
+	/// \brief Call the specified function on each pair of non-empty query/match cells that may contain matching entries
 	template <typename T>
-	template <typename CELLS, typename ACTN>
-	inline void view_cache_index_dim_linear<T>::perform_action_on_all_match_at_nodes(const CELLS                          &prm_query_cells,     ///< TODOCUMENT
-	                                                                                 const view_cache_index_dim_linear<T> &prm_match_dimension, ///< TODOCUMENT
-	                                                                                 const CELLS                          &prm_match_cells,     ///< TODOCUMENT
-	                                                                                 const vcie_match_criteria            &prm_criteria,        ///< TODOCUMENT
-	                                                                                 ACTN                                 &prm_action           ///< TODOCUMENT
-	                                                                                 ) const {
+	template <typename CELLS, typename FN>
+	inline void view_cache_index_dim_linear<T>::for_each_matching_cell_pair(const CELLS                          &prm_query_cells,     ///< The query cells
+	                                                                        const view_cache_index_dim_linear<T> &prm_match_dimension, ///< The dimension of the match cells
+	                                                                        const CELLS                          &prm_match_cells,     ///< The match cells
+	                                                                        const vcie_match_criteria            &prm_criteria,        ///< The criteria for matching
+	                                                                        FN                                  &&prm_fn              ///< The function to call with each query cell and match cell
+	                                                                        ) const {
 		const value_type &search_radius   = T().get_search_radius( prm_criteria );
 
 
@@ -383,7 +390,7 @@ namespace cath::index::detail::detail {
 							//           << "].size_"                                << match_cell.get_num_cells()
 							//           << std::endl;
 
-							query_cell.perform_action_on_all_match_at_nodes( match_cell, prm_criteria, prm_action );
+							prm_fn( query_cell, match_cell );
 						}
 					}
 				}
@@ -391,6 +398,26 @@ namespace cath::index::detail::detail {
 		}
 	}
 
+	/// \brief TODOCUMENT
+	template <typename T>
+	template <typename CELLS, typename ACTN>
+	inline void view_cache_index_dim_linear<T>::perform_action_on_all_match_at_nodes(const CELLS                          &prm_query_cells,     ///< TODOCUMENT
+	                                                                                 const view_cache_index_dim_linear<T> &prm_match_dimension, ///< TODOCUMENT
+	                                                                                 const CELLS                          &prm_match_cells,     ///< TODOCUMENT
+	                                                                                 const vcie_match_criteria            &prm_criteria,        ///< TODOCUMENT
+	                                                                                 ACTN                                 &prm_action           ///< TODOCUMENT
+	                                                                                 ) const {
+		for_each_matching_cell_pair(
+			prm_query_cells,
+			prm_match_dimension,
+			prm_match_cells,
+			prm_criteria,
+			[&] (const auto &prm_query_cell, const auto &prm_match_cell) {
+				prm_query_cell.perform_action_on_all_match_at_nodes( prm_match_cell, prm_criteria, prm_action );
+			}
+		);
+	}
+
 } // namespace cath::index::detail::detail
 
 #endif // CATH_TOOLS_SOURCE_CT_UNI_CATH_STRUCTURE_VIEW_CACHE_INDEX_DETAIL_DIMS_DETAIL_VIEW_CACHE_INDEX_DIM_LINEAR_HPP
@@ -85,6 +85,13 @@ namespace cath::index::detail {
 		                               const detail::vcie_match_criteria &,
 		                               ACTN &) const;
 
+		template <typename CELLS, typename FN>
+		inline void for_each_matching_cell_pair(const CELLS &,
+		                                        const view_cache_index_dim_dirn &,
+		                                        const CELLS &,
+		                                        const detail::vcie_match_criteria &,
+		                                        FN &&) const;
+
 		template <typename CELLS, typename ACTN>
 		inline void perform_action_on_all_match_at_nodes(const CELLS &,
 		                                                 const view_cache_index_dim_dirn &,
@@ -168,14 +175,14 @@ namespace cath::index::detail {
 		}
 	}
 
-	/// \brief TODOCUMENT
-	template <typename CELLS, typename ACTN>
-	inline void view_cache_index_dim_dirn::perform_action_on_all_match_at_nodes(const CELLS                       &prm_query_cells, ///< TODOCUMENT
-	                                                                            const view_cache_index_dim_dirn   &prm_query_dim,   ///< TODOCUMENT
-	                                                                            const CELLS                       &prm_match_cells, ///< TODOCUMENT
-	                                                                            const detail::vcie_match_criteria &prm_criteria,    ///< TODOCUMENT
-	                                                                            ACTN                              &prm_action       ///< TODOCUMENT
-	                                                                            ) const {
+	/// \brief Call the specified function on each pair of non-empty query/match cells that may contain matching entries
+	template <typename CELLS, typename FN>
+	inline void view_cache_index_dim_dirn::for_each_matching_cell_pair(const CELLS                       &prm_query_cells,  ///< The query cells
+	                                                                   const view_cache_index_dim_dirn   &prm_query_dim,    ///< The dimension of the match cells
+	                                                                   const CELLS                       &prm_match_cells,  ///< The match cells
+	                                                                   const detail::vcie_match_criteria &/*prm_criteria*/, ///< The criteria for matching
+	                                                                   FN                               &&prm_fn            ///< The function to call with each query cell and match cell
+	                                                                   ) const {
 		if ( ! prm_query_cells.empty() && ! prm_match_cells.empty() ) {
 			for (const bool &increases : { false, true } ) {
 				const typename CELLS::value_type &query_cell =               cell_at_value( prm_query_cells, increases );
@@ -186,12 +193,31 @@ namespace cath::index::detail {
 					          << ". query_cell.size_" << query_cell.get_num_cells()
 					          << ", match_cell.size_" << match_cell.get_num_cells()
 					          << "\n";
-					query_cell.perform_action_on_all_match_at_nodes( match_cell, prm_criteria, prm_action );
+					prm_fn( query_cell, match_cell );
 				}
 			}
 		}
 	}
 
+	/// \brief TODOCUMENT
+	template <typename CELLS, typename ACTN>
+	inline void view_cache_index_dim_dirn::perform_action_on_all_match_at_nodes(const CELLS                       &prm_query_cells, ///< TODOCUMENT
+	                                                                            const view_cache_index_dim_dirn   &prm_query_dim,   ///< TODOCUMENT
+	                                                                            const CELLS                       &prm_match_cells, ///< TODOCUMENT
+	                                                                            const detail::vcie_match_criteria &prm_criteria,    ///< TODOCUMENT
+	                                                                            ACTN                              &prm_action       ///< TODOCUMENT
+	                                                                            ) const {
+		for_each_matching_cell_pair(
+			prm_query_cells,
+			prm_query_dim,
+			prm_match_cells,
+			prm_criteria,
+			[&] (const auto &prm_query_cell, const auto &prm_match_cell) {
+				prm_query_cell.perform_action_on_all_match_at_nodes( prm_match_cell, prm_criteria, prm_action );
+			}
+		);
+	}
+
 } // namespace cath::index::detail
 
 #endif // CATH_TOOLS_SOURCE_CT_UNI_CATH_STRUCTURE_VIEW_CACHE_INDEX_DETAIL_DIMS_VIEW_CACHE_INDEX_DIM_DIRN_HPP
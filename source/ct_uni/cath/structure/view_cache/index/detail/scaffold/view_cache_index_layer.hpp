@@ -22,6 +22,7 @@
 #define CATH_TOOLS_SOURCE_CT_UNI_CATH_STRUCTURE_VIEW_CACHE_INDEX_DETAIL_SCAFFOLD_VIEW_CACHE_INDEX_LAYER_HPP
 
 #include <cstddef>
+#include <utility>
 #include <vector>
 
 #include <boost/core/demangle.hpp>
@@ -60,6 +61,9 @@ namespace cath::index::detail {
 		[[nodiscard]] int cell_index_of_value_in_current( const double & ) const;
 
 	  public:
+		/// \brief The type of the cells in this layer (ie the type of the next layer down)
+		using cell_type = T;
+
 		explicit view_cache_index_layer(const DIM &);
 
 		// const double & get_cell_width() const;
@@ -84,6 +88,11 @@ namespace cath::index::detail {
 		void perform_action_on_all_match_at_leaves(ACTN &) const;
 
 
+		template <typename FN>
+		void for_each_matching_cell_pair(const view_cache_index_layer<DIM, T> &,
+		                                 const vcie_match_criteria &,
+		                                 FN &&) const;
+
 		template <typename ACTN>
 		void perform_action_on_all_match_at_nodes(const view_cache_index_layer<DIM, T> &,
 		                                          const vcie_match_criteria &,
@@ -172,6 +181,26 @@ namespace cath::index::detail {
 	}
 
 
+	/// \brief Call the specified function on each pair of this layer's cells and the specified match layer's cells
+	///        that may contain matching entries
+	///
+	/// This is the step that perform_action_on_all_match_at_nodes() recurses through, exposed so that
+	/// a traversal can collect the pairs of cells at some depth and then process them independently (eg in parallel)
+	template <typename DIM, typename T>
+	template <typename FN>
+	void view_cache_index_layer<DIM, T>::for_each_matching_cell_pair(const view_cache_index_layer<DIM, T> &prm_match_layer, ///< The layer of the index being searched for matches
+	                                                                 const vcie_match_criteria            &prm_criteria,    ///< The criteria for matching
+	                                                                 FN                                  &&prm_fn           ///< The function to call with each query cell and match cell
+	                                                                 ) const {
+		the_dimension.for_each_matching_cell_pair(
+			cells,
+			prm_match_layer.the_dimension,
+			prm_match_layer.cells,
+			prm_criteria,
+			std::forward<FN>( prm_fn )
+		);
+	}
+
 	/// \brief TODOCUMENT
 	template <typename DIM, typename T>
 	template <typename ACTN>
@@ -0,0 +1,107 @@
+/// \file
+/// \brief The vcie_match_buffer class header
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef CATH_TOOLS_SOURCE_CT_UNI_CATH_STRUCTURE_VIEW_CACHE_INDEX_DETAIL_VCIE_MATCH_BUFFER_HPP
+#define CATH_TOOLS_SOURCE_CT_UNI_CATH_STRUCTURE_VIEW_CACHE_INDEX_DETAIL_VCIE_MATCH_BUFFER_HPP
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "cath/structure/view_cache/index/view_cache_index_entry.hpp"
+
+namespace cath::index::detail {
+
+	/// \brief The number of work items per thread that the parallel view_cache_index traversal searches
+	///        before replaying the recorded matches and clearing the per-thread buffers
+	///
+	/// This bounds the buffers' memory by the matches of one chunk of work items rather than of the whole search
+	constexpr size_t VCIE_MATCH_BUFFER_WORK_ITEMS_PER_THREAD = 16;
+
+	/// \brief An action that records each matching pair of view_cache_index_entry objects it's shown
+	///        so that the real action can be applied to them later, in a deterministic order
+	///
+	/// This is used as the per-thread buffer in the parallel view_cache_index traversal,
+	/// which replays and clears it after each chunk of work items. It holds pointers to the entries, so the indices being traversed must outlive it and stay unmodified.
+	class vcie_match_buffer final {
+	private:
+		/// \brief Type alias for a pair of pointers to the query and match entries
+		using vcie_cptr_pair = std::pair<const view_cache_index_entry *, const view_cache_index_entry *>;
+
+		/// \brief The matches recorded so far
+		std::vector<vcie_cptr_pair> matches;
+
+	public:
+		[[nodiscard]] size_t size() const;
+
+		void clear();
+
+		void operator()(const view_cache_index_entry &,
+		                const view_cache_index_entry &);
+
+		template <typename ACTN>
+		void perform_action_on_range(const size_t &,
+		                             const size_t &,
+		                             ACTN &) const;
+	};
+
+	/// \brief The number of matches recorded so far
+	inline size_t vcie_match_buffer::size() const {
+		return matches.size();
+	}
+
+	/// \brief Forget the matches recorded so far (whilst keeping the memory for reuse)
+	inline void vcie_match_buffer::clear() {
+		matches.clear();
+	}
+
+	/// \brief Record the specified matching pair of entries
+	inline void vcie_match_buffer::operator()(const view_cache_index_entry &prm_entry_a, ///< The query entry
+	                                          const view_cache_index_entry &prm_entry_b  ///< The match entry
+	                                          ) {
+		matches.emplace_back( &prm_entry_a, &prm_entry_b );
+	}
+
+	/// \brief Perform the specified action on each of the matches recorded in the specified [begin, end) range, in order
+	template <typename ACTN>
+	void vcie_match_buffer::perform_action_on_range(const size_t &prm_begin, ///< The index of the first match on which to perform the action
+	                                                const size_t &prm_end,   ///< The index of one-past-the-last match on which to perform the action
+	                                                ACTN         &prm_action ///< The action to perform
+	                                                ) const {
+		for (size_t match_ctr = prm_begin; match_ctr < prm_end; ++match_ctr) {
+			prm_action( *matches[ match_ctr ].first, *matches[ match_ctr ].second );
+		}
+	}
+
+	/// \brief The location in a list of per-thread vcie_match_buffer objects of the matches found for one work item
+	struct vcie_match_buffer_span final {
+		/// \brief The index of the thread (and hence vcie_match_buffer) that processed the work item
+		size_t thread_index = 0;
+
+		/// \brief The index of the first match for the work item in its vcie_match_buffer
+		size_t begin        = 0;
+
+		/// \brief The index of one-past-the-last match for the work item in its vcie_match_buffer
+		size_t end          = 0;
+	};
+
+} // namespace cath::index::detail
+
+#endif // CATH_TOOLS_SOURCE_CT_UNI_CATH_STRUCTURE_VIEW_CACHE_INDEX_DETAIL_VCIE_MATCH_BUFFER_HPP
@@ -38,6 +38,7 @@
 #include "cath/common/boost_addenda/range/indices.hpp"
 #include "cath/common/difference.hpp"
 #include "cath/common/file/simple_file_read_write.hpp"
+#include "cath/common/thread/parallel_for_each_index.hpp"
 #include "cath/ssap/context_res.hpp"
 #include "cath/structure/geometry/coord.hpp"
 #include "cath/structure/protein/protein.hpp"
@@ -93,13 +94,17 @@ void view_cache_index::store(const view_cache_index_entry &prm_entry ///< TODOCU
 //}
 
 /// \brief TODOCUMENT
-///	
+///
+/// The entries are calculated in parallel (one from-residue per work item) if prm_num_threads
+/// isn't 1 but they're always stored in the same order so the resulting index is the same.
+///
 /// \relates view_cache_index
 view_cache_index cath::index::build_view_cache_index(const double              &prm_xyz_cell_width,       ///< TODOCUMENT
                                                      const angle_type          &prm_phi_angle_cell_width, ///< TODOCUMENT
                                                      const angle_type          &/*prm_psi_angle_cell_width*/, ///< TODOCUMENT
                                                      const protein             &prm_protein,              ///< TODOCUMENT
-                                                     const vcie_match_criteria &prm_criteria              ///< TODOCUMENT
+                                                     const vcie_match_criteria &prm_criteria,             ///< TODOCUMENT
+                                                     const size_t              &prm_num_threads           ///< The maximum number of threads to use in calculating the entries (or 0 for the number of hardware threads)
                                                      ) {
 	view_cache_index new_view_cache_index( boost::make_tuple(
 		view_cache_index_dim_dirn           (                          ),
@@ -113,13 +118,35 @@ view_cache_index cath::index::build_view_cache_index(const double              &
 		view_cache_index_tail               (                          )
 	) );
 	const size_t num_residues = prm_protein.get_length();
-	for (const size_t &from_ctr : indices( num_residues ) ) {
-		for (const size_t &to_ctr : indices( num_residues ) ) {
-			const view_cache_index_entry the_entry = make_view_cache_index_entry( prm_protein, from_ctr, to_ctr );
-			if ( prm_criteria( the_entry ) ) {
-				new_view_cache_index.store( the_entry );
+	if ( num_threads_to_use( prm_num_threads ) <= 1 ) {
+		for (const size_t &from_ctr : indices( num_residues ) ) {
+			for (const size_t &to_ctr : indices( num_residues ) ) {
+				const view_cache_index_entry the_entry = make_view_cache_index_entry( prm_protein, from_ctr, to_ctr );
+				if ( prm_criteria( the_entry ) ) {
+					new_view_cache_index.store( the_entry );
+				}
+			}
+		}
+		return new_view_cache_index;
+	}
+
+	vector<view_cache_index_entry_vec> entries_of_from( num_residues );
+	parallel_for_each_index(
+		num_residues,
+		prm_num_threads,
+		[&] (const size_t &from_ctr) {
+			for (const size_t &to_ctr : indices( num_residues ) ) {
+				view_cache_index_entry the_entry = make_view_cache_index_entry( prm_protein, from_ctr, to_ctr );
+				if ( prm_criteria( the_entry ) ) {
+					entries_of_from[ from_ctr ].push_back( std::move( the_entry ) );
+				}
 			}
 		}
+	);
+	for (const view_cache_index_entry_vec &entries : entries_of_from) {
+		for (const view_cache_index_entry &the_entry : entries) {
+			new_view_cache_index.store( the_entry );
+		}
 	}
 //	cerr << "At finish, contains_it? is : " << boolalpha << index_contains_value( new_view_cache_index, coord_of_interest );
 	return new_view_cache_index;
@@ -134,7 +161,8 @@ high_resolution_clock::duration cath::index::process_quads_indexed(const protein
                                                                    const angle_type          &prm_phi_angle_cell_size, ///< TODOCUMENT
                                                                    const angle_type          &prm_psi_angle_cell_size, ///< TODOCUMENT
                                                                    const vcie_match_criteria &prm_criteria,            ///< TODOCUMENT
-                                                                   quad_find_action_check    &prm_action               ///< TODOCUMENT
+                                                                   quad_find_action_check    &prm_action,              ///< TODOCUMENT
+                                                                   const size_t              &prm_num_threads          ///< The maximum number of threads to use in building and searching the indices (or 0 for the number of hardware threads)
                                                                    ) {
 	const protein_list proteins = make_protein_list( { prm_protein_a, prm_protein_b } );
 
@@ -145,14 +173,16 @@ high_resolution_clock::duration cath::index::process_quads_indexed(const protein
 		prm_phi_angle_cell_size,
 		prm_psi_angle_cell_size,
 		prm_protein_a,
-		prm_criteria
+		prm_criteria,
+		prm_num_threads
 	);
 	const view_cache_index view_cache_index_b = build_view_cache_index(
 		prm_xyz_cell_size,
 		prm_phi_angle_cell_size,
 		prm_psi_angle_cell_size,
 		prm_protein_b,
-		prm_criteria
+		prm_criteria,
+		prm_num_threads
 	);
 
 	const auto scan_start_time   = high_resolution_clock::now();
@@ -162,7 +192,7 @@ high_resolution_clock::duration cath::index::process_quads_indexed(const protein
 	// cerr << "After leaves" << endl;
 
 	cerr << "Before nodes" << endl;
-	view_cache_index_a.perform_action_on_all_match_at_nodes ( view_cache_index_b, prm_criteria, prm_action );
+	view_cache_index_a.perform_action_on_all_match_at_nodes ( view_cache_index_b, prm_criteria, prm_action, prm_num_threads );
 	cerr << "After nodes" << endl;
 	
 	// cerr << "Error: currently doing both of perform_action_on_all_match_at_leaves and perform_action_on_all_match_at_nodes" << endl;
@@ -21,7 +21,12 @@
 #ifndef CATH_TOOLS_SOURCE_CT_UNI_CATH_STRUCTURE_VIEW_CACHE_INDEX_VIEW_CACHE_INDEX_HPP
 #define CATH_TOOLS_SOURCE_CT_UNI_CATH_STRUCTURE_VIEW_CACHE_INDEX_VIEW_CACHE_INDEX_HPP
 
+#include <algorithm>
 #include <chrono>
+#include <utility>
+#include <vector>
+
+#include "cath/common/thread/parallel_for_each_index.hpp"
 
 #include "cath/structure/view_cache/index/detail/dims/view_cache_index_dim_dirn.hpp"
 #include "cath/structure/view_cache/index/detail/dims/view_cache_index_dim_linear_from_phi.hpp"
@@ -34,6 +39,7 @@
 #include "cath/structure/view_cache/index/detail/pair_scan_action.hpp"
 #include "cath/structure/view_cache/index/detail/scaffold/view_cache_index_layer.hpp"
 #include "cath/structure/view_cache/index/detail/scaffold/view_cache_index_tail.hpp"
+#include "cath/structure/view_cache/index/detail/vcie_match_buffer.hpp"
 #include "cath/structure/view_cache/index/view_cache_index_entry.hpp"
 
 // clang-format off
@@ -103,6 +109,12 @@ namespace cath::index {
 		void perform_action_on_all_match_at_nodes(const view_cache_index &,
 		                                          const detail::vcie_match_criteria &,
 		                                          ACTN &) const;
+
+		template <typename ACTN>
+		void perform_action_on_all_match_at_nodes(const view_cache_index &,
+		                                          const detail::vcie_match_criteria &,
+		                                          ACTN &,
+		                                          const size_t &) const;
 	};
 
 	/// \brief TODOCUMENT
@@ -133,11 +145,79 @@ namespace cath::index {
 		the_index.perform_action_on_all_match_at_nodes( prm_search_index.the_index, prm_criteria, prm_action );
 	}
 
+	/// \brief Perform the specified action on all matches, using up to the specified number of threads for the search
+	///
+	/// This forks at the top two layers: it collects the pairs of (query, match) cells two layers down
+	/// and then searches chunks of those pairs in parallel, recording the matches in per-thread buffers.
+	/// After each chunk, the action is performed on the calling thread, in the same order as the single-threaded traversal,
+	/// so ACTN needn't be thread-safe and the results are identical to those of the single-threaded version.
+	template <typename ACTN>
+	void view_cache_index::perform_action_on_all_match_at_nodes(const view_cache_index            &prm_search_index, ///< The index to search for matches
+	                                                            const detail::vcie_match_criteria &prm_criteria,     ///< The criteria for matching
+	                                                            ACTN                              &prm_action,       ///< The action to perform on each match
+	                                                            const size_t                      &prm_num_threads   ///< The maximum number of threads to use (or 0 for the number of hardware threads)
+	                                                            ) const {
+		const size_t num_threads = common::num_threads_to_use( prm_num_threads );
+		if ( num_threads <= 1 ) {
+			perform_action_on_all_match_at_nodes( prm_search_index, prm_criteria, prm_action );
+			return;
+		}
+
+		// Collect the pairs of (query, match) cells two layers down
+		using fork_cell_type     = detail::standard_vci_nested_layers::cell_type::cell_type;
+		using fork_cell_ptr_pair = std::pair<const fork_cell_type *, const fork_cell_type *>;
+		std::vector<fork_cell_ptr_pair> work_items;
+		the_index.for_each_matching_cell_pair(
+			prm_search_index.the_index,
+			prm_criteria,
+			[&] (const auto &prm_query_cell, const auto &prm_match_cell) {
+				prm_query_cell.for_each_matching_cell_pair(
+					prm_match_cell,
+					prm_criteria,
+					[&] (const fork_cell_type &prm_query_fork_cell, const fork_cell_type &prm_match_fork_cell) {
+						work_items.emplace_back( &prm_query_fork_cell, &prm_match_fork_cell );
+					}
+				);
+			}
+		);
+
+		// Search the work items in parallel a chunk at a time, recording the matches in per-thread buffers
+		// and recording where each work item's matches are. After each chunk, perform the action on the chunk's
+		// matches in the order of the work items and then clear the buffers, so they only hold one chunk's matches.
+		const size_t                                num_work_items = work_items.size();
+		const size_t                                chunk_size     = num_threads * detail::VCIE_MATCH_BUFFER_WORK_ITEMS_PER_THREAD;
+		std::vector<detail::vcie_match_buffer>      buffers( num_threads );
+		std::vector<detail::vcie_match_buffer_span> spans;
+		for (size_t chunk_begin = 0; chunk_begin < num_work_items; chunk_begin += chunk_size) {
+			const size_t chunk_end = std::min( chunk_begin + chunk_size, num_work_items );
+			spans.assign( chunk_end - chunk_begin, detail::vcie_match_buffer_span{} );
+			common::parallel_for_each_index(
+				chunk_end - chunk_begin,
+				num_threads,
+				[&] (const size_t &prm_chunk_index, const size_t &prm_thread_index) {
+					const fork_cell_ptr_pair  &work_item = work_items[ chunk_begin + prm_chunk_index ];
+					detail::vcie_match_buffer &buffer    = buffers[ prm_thread_index ];
+					const size_t               begin     = buffer.size();
+					work_item.first->perform_action_on_all_match_at_nodes( *work_item.second, prm_criteria, buffer );
+					spans[ prm_chunk_index ] = { prm_thread_index, begin, buffer.size() };
+				}
+			);
+
+			for (const detail::vcie_match_buffer_span &span : spans) {
+				buffers[ span.thread_index ].perform_action_on_range( span.begin, span.end, prm_action );
+			}
+			for (detail::vcie_match_buffer &buffer : buffers) {
+				buffer.clear();
+			}
+		}
+	}
+
 	view_cache_index build_view_cache_index(const double &,
 	                                        const detail::angle_type &,
 	                                        const detail::angle_type &,
 	                                        const protein &,
-	                                        const detail::vcie_match_criteria &);
+	                                        const detail::vcie_match_criteria &,
+	                                        const size_t & = 1);
 
 	std::chrono::high_resolution_clock::duration process_quads_indexed(const protein &,
 	                                                                   const protein &,
@@ -145,7 +225,8 @@ namespace cath::index {
 	                                                                   const detail::angle_type &,
 	                                                                   const detail::angle_type &,
 	                                                                   const detail::vcie_match_criteria &,
-	                                                                   quad_find_action_check &);
+	                                                                   quad_find_action_check &,
+	                                                                   const size_t & = 1);
 
 	std::chrono::high_resolution_clock::duration process_quads_complete(const protein &,
 	                                                                    const protein &,
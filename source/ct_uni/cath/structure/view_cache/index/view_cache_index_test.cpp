@@ -20,6 +20,16 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include "cath/structure/geometry/angle.hpp"
+#include "cath/structure/protein/protein.hpp"
+#include "cath/structure/protein/protein_source_file_set/protein_from_pdb.hpp"
+#include "cath/structure/protein/sec_struc.hpp"
+#include "cath/structure/protein/sec_struc_planar_angles.hpp"
+#include "cath/structure/view_cache/index/detail/vcie_match_criteria.hpp"
+#include "cath/structure/view_cache/index/quad_find_action_check.hpp"
+#include "cath/structure/view_cache/index/view_cache_index.hpp"
+#include "cath/test/global_test_constants.hpp"
+
 // #include "cath/alignment/alignment.hpp"
 // #include "cath/alignment/io/alignment_io.hpp"
 // #include "cath/file/pdb/pdb.hpp"
@@ -46,9 +56,44 @@
 // using namespace ::cath::geom;
 // using namespace ::std;
 
+namespace {
+
+	/// \brief Build view_cache_indices for two example proteins with the specified number of threads,
+	///        then scan for matches with the same number of threads and return the total score
+	double total_quad_score_with_num_threads(const size_t &prm_num_threads ///< The number of threads to use
+	                                         ) {
+		using ::cath::geom::make_angle_from_degrees;
+		using ::cath::index::detail::angle_type;
+		using ::cath::index::detail::angle_base_type;
+
+		const auto      protein_a    = read_protein_from_files( ::cath::protein_from_pdb(), ::cath::global_test_constants::TEST_SOURCE_DATA_DIR(), "1c0pA01" );
+		const auto      protein_b    = read_protein_from_files( ::cath::protein_from_pdb(), ::cath::global_test_constants::TEST_SOURCE_DATA_DIR(), "1hdoA00" );
+		const auto      the_criteria = ::cath::index::detail::make_default_vcie_match_criteria();
+		const double    cell_width   = sqrt( 40.0 );
+		const angle_type angle_width = make_angle_from_degrees<angle_base_type>( 67.5 );
+
+		const auto index_a = ::cath::index::build_view_cache_index( cell_width, angle_width, angle_width, protein_a, the_criteria, prm_num_threads );
+		const auto index_b = ::cath::index::build_view_cache_index( cell_width, angle_width, angle_width, protein_b, the_criteria, prm_num_threads );
+
+		::cath::index::quad_find_action_check the_action( protein_a, protein_b, the_criteria );
+		index_a.perform_action_on_all_match_at_nodes( index_b, the_criteria, the_action, prm_num_threads );
+		return the_action.get_total_score();
+	}
+
+} // namespace
+
 /// \brief TODOCUMENT
 BOOST_AUTO_TEST_SUITE(view_cache_index_test_suite)
 
+/// \brief Check that the multi-threaded build and scan give exactly the same result as the single-threaded ones
+///
+/// The check action also throws if any quad is reported twice or if any reported quad doesn't really match
+BOOST_AUTO_TEST_CASE(multi_threaded_scan_matches_single_threaded) {
+	const double single_threaded_score = total_quad_score_with_num_threads( 1 );
+	BOOST_CHECK_GT   ( single_threaded_score, 0.0 );
+	BOOST_CHECK_EQUAL( total_quad_score_with_num_threads( 4 ), single_threaded_score );
+}
+
 ///// \brief TODOCUMENT
 //BOOST_AUTO_TEST_CASE(basic) {
 //	// const double cell_width = 0.5 * sqrt( 40.0 );
@@ -20,6 +20,9 @@
 
 #include "view_cache.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
 #include "cath/common/boost_addenda/range/indices.hpp"
 #include "cath/ssap/context_res.hpp"
@@ -30,32 +33,58 @@ using namespace ::cath::common;
 using namespace ::cath::geom;
 using namespace ::cath::index;
 
+using ::std::clamp;
+using ::std::fabs;
+using ::std::lround;
+using ::std::max;
+using ::std::numeric_limits;
 
-/// \brief Private static method that implements the process of building the views from proteins
-coord_vec_vec view_cache::build_views(const protein &prm_protein ///< The protein which the view_cache should be built to represent
-                                      ) {
-	// Grab the number of residues and prepare the views accordingly
-	const size_t num_residues = prm_protein.get_length();
-	coord_vec_vec new_views( num_residues );
-	for (coord_vec &view_of : new_views) {
-		view_of.reserve( num_residues );
+/// \brief Calculate the views from the specified from-residue to all residues, quantise them
+///        and write them to the specified row
+///
+/// The buffer is resized to 3 * the number of residues and the row must have space for that many values:
+/// the x values, then the y values, then the z values
+///
+/// \returns The scale by which the row's stored values should be multiplied to get the views
+float view_cache::build_row(const protein          &prm_protein,    ///< The protein from which the views should be calculated
+                            const size_t           &prm_from_index, ///< The index of the from-residue whose row of views should be built
+                            doub_vec               &prm_buffer,     ///< A buffer in which to calculate the unquantised views
+                            view_component_t * const prm_row        ///< The row to which the quantised views should be written
+                            ) {
+	constexpr auto MAX_COMPONENT = numeric_limits<view_component_t>::max();
+
+	const size_t   num_residues = prm_protein.get_length();
+	const residue &from_res     = prm_protein.get_residue_ref_of_index( prm_from_index );
+	prm_buffer.resize( 3 * num_residues );
+	double max_abs_component = 0.0;
+	for (const size_t &to_res_ctr : indices( num_residues ) ) {
+		const coord view = view_vector_of_residue_pair( from_res, prm_protein.get_residue_ref_of_index( to_res_ctr ) );
+		prm_buffer[                    to_res_ctr ] = view.get_x();
+		prm_buffer[     num_residues + to_res_ctr ] = view.get_y();
+		prm_buffer[ 2 * num_residues + to_res_ctr ] = view.get_z();
+		max_abs_component = max( { max_abs_component, fabs( view.get_x() ), fabs( view.get_y() ), fabs( view.get_z() ) } );
 	}
 
-	// Loop over the all from-versus-to residue pairs and add the resulting views
-	for (const size_t &from_res_ctr : indices( num_residues ) ) {
-		for (const size_t &to_res_ctr : indices( num_residues ) ) {
-			coord_vec &view_of_from = new_views[ from_res_ctr ];
-			view_of_from.push_back( view_vector_of_residue_pair(
-				prm_protein.get_residue_ref_of_index( from_res_ctr ),
-				prm_protein.get_residue_ref_of_index( to_res_ctr   )
-			) );
-		}
+	// Quantise with the float scale that's stored so that the values decode exactly as they were encoded
+	const float  scale        = ( max_abs_component > 0.0 ) ? static_cast<float>( max_abs_component / MAX_COMPONENT ) : 1.0F;
+	const double scale_double = static_cast<double>( scale );
+	for (const size_t &value_ctr : indices( 3 * num_residues ) ) {
+		prm_row[ value_ctr ] = static_cast<view_component_t>( clamp(
+			lround( prm_buffer[ value_ctr ] / scale_double ),
+			-static_cast<long>( MAX_COMPONENT ),
+			 static_cast<long>( MAX_COMPONENT )
+		) );
 	}
-	return new_views;
+	return scale;
 }
 
 /// \brief Ctor for view_cache from a protein that the view_cache should represent
 view_cache::view_cache(const protein &prm_protein ///< The protein which the view_cache should be built to represent
-                       ) : views( build_views( prm_protein ) ) {
+                       ) : num_residues { prm_protein.get_length()          },
+                           row_scales   ( num_residues                      ),
+                           views        ( 3 * num_residues * num_residues ) {
+	doub_vec buffer;
+	for (const size_t &from_res_ctr : indices( num_residues ) ) {
+		row_scales[ from_res_ctr ] = build_row( prm_protein, from_res_ctr, buffer, views.data() + ( 3 * num_residues * from_res_ctr ) );
+	}
 }
-
@@ -39,7 +39,7 @@ view_cache_vec view_cache_list::build_caches(const protein_list &prm_protein_lis
 	new_caches.reserve( num_proteins );
 
 	for (const protein &the_protein : prm_protein_list) {
-		new_caches.push_back( view_cache( the_protein ) );
+		new_caches.emplace_back( the_protein );
 	}
 
 	return new_caches;
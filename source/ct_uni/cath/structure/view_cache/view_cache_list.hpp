@@ -62,11 +62,11 @@ namespace cath::index {
 	///        residue list (eg protein) index, from_residue index and to_residue index
 	///
 	/// \relates view_cache_list
-	inline const geom::coord & get_view(const view_cache_list &prm_cache_list, ///< The view_cache_list to query
-	                                    const size_t          &prm_index,      ///< The index of the residue list (eg protein) of interest
-	                                    const size_t          &prm_from_index, ///< The index of the from_residue in the residue list (eg protein)
-	                                    const size_t          &prm_to_index    ///< The index of the to_residue   in the residue list (eg protein)
-	                                    ) {
+	inline geom::coord get_view(const view_cache_list &prm_cache_list, ///< The view_cache_list to query
+	                            const size_t          &prm_index,      ///< The index of the residue list (eg protein) of interest
+	                            const size_t          &prm_from_index, ///< The index of the from_residue in the residue list (eg protein)
+	                            const size_t          &prm_to_index    ///< The index of the to_residue   in the residue list (eg protein)
+	                            ) {
 		return prm_cache_list.get_view_cache( prm_index ).get_view( prm_from_index, prm_to_index );
 	}
 
@@ -0,0 +1,92 @@
+/// \file
+/// \brief The view_cache test suite
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <boost/test/unit_test.hpp>
+
+#include "cath/common/boost_addenda/range/indices.hpp"
+#include "cath/ssap/context_res.hpp"
+#include "cath/structure/protein/protein.hpp"
+#include "cath/structure/protein/protein_source_file_set/protein_from_pdb.hpp"
+#include "cath/structure/protein/sec_struc.hpp"
+#include "cath/structure/protein/sec_struc_planar_angles.hpp"
+#include "cath/structure/view_cache/view_cache.hpp"
+#include "cath/test/global_test_constants.hpp"
+
+using namespace ::cath;
+using namespace ::cath::common;
+using namespace ::cath::geom;
+using namespace ::cath::index;
+
+namespace {
+
+	/// \brief The view_cache_test_suite_fixture to assist in testing view_cache
+	struct view_cache_test_suite_fixture : protected global_test_constants {
+	protected:
+		~view_cache_test_suite_fixture() noexcept = default;
+
+	public:
+		/// \brief The maximum absolute difference permitted between an int16-stored view and the double original
+		///
+		/// Each row is quantised in steps of its largest absolute component / 32767, so the error is at most
+		/// half of that (well under 0.001Å for the views within a domain)
+		static constexpr double VIEW_TOLERANCE = 0.002;
+
+		/// \brief An example protein on which to build view_caches
+		const protein the_protein = read_protein_from_files( protein_from_pdb(), TEST_SOURCE_DATA_DIR(), "1c0pA01" );
+
+		/// \brief Check that the views in the specified view_cache match those calculated directly from the protein
+		void check_views_match_protein(const view_cache &prm_view_cache ///< The view_cache to check
+		                               ) const {
+			const size_t num_residues = the_protein.get_length();
+			BOOST_REQUIRE_EQUAL( prm_view_cache.get_num_residues(), num_residues );
+			for (const size_t &from_ctr : indices( num_residues ) ) {
+				for (const size_t &to_ctr : indices( num_residues ) ) {
+					const coord expected = view_vector_of_residue_pair(
+						the_protein.get_residue_ref_of_index( from_ctr ),
+						the_protein.get_residue_ref_of_index( to_ctr   )
+					);
+					const coord got = prm_view_cache.get_view( from_ctr, to_ctr );
+					BOOST_REQUIRE_SMALL( got.get_x() - expected.get_x(), VIEW_TOLERANCE );
+					BOOST_REQUIRE_SMALL( got.get_y() - expected.get_y(), VIEW_TOLERANCE );
+					BOOST_REQUIRE_SMALL( got.get_z() - expected.get_z(), VIEW_TOLERANCE );
+				}
+			}
+		}
+	};
+
+} // namespace
+
+/// \brief A test suite to unit test view_cache
+BOOST_FIXTURE_TEST_SUITE(view_cache_test_suite, view_cache_test_suite_fixture)
+
+/// \brief Check that a view_cache contains the correct views
+BOOST_AUTO_TEST_CASE(views_match_protein) {
+	check_views_match_protein( view_cache( the_protein ) );
+}
+
+/// \brief Check that the views from a residue to itself are stored as exactly zero
+BOOST_AUTO_TEST_CASE(self_views_are_zero) {
+	const view_cache the_view_cache( the_protein );
+	for (const size_t &index : indices( the_protein.get_length() ) ) {
+		BOOST_CHECK_EQUAL( the_view_cache.get_view( index, index ), ORIGIN_COORD );
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -18,25 +18,40 @@
 /// You should have received a copy of the GNU General Public License
 /// along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
+#include <cmath>
 #include <filesystem>
 
+#include <boost/lexical_cast.hpp>
 #include <boost/units/quantity.hpp>
 
+#include "cath/common/chrono/duration_to_seconds_string.hpp"
 #include "cath/common/program_exception_wrapper.hpp"
+#include "cath/common/size_t_literal.hpp"
+#include "cath/common/thread/parallel_for_each_index.hpp"
 #include "cath/scan/scan_tools/all_vs_all.hpp"
 #include "cath/scan/scan_tools/load_and_scan.hpp"
 #include "cath/scan/scan_tools/load_and_scan_metrics.hpp"
 #include "cath/scan/scan_tools/single_pair.hpp"
 #include "cath/structure/protein/protein.hpp"
+#include "cath/structure/geometry/angle.hpp"
 #include "cath/structure/protein/protein_source_file_set/protein_from_pdb.hpp"
 #include "cath/structure/protein/residue.hpp"
 #include "cath/structure/protein/sec_struc.hpp"
 #include "cath/structure/protein/sec_struc_planar_angles.hpp"
+#include "cath/structure/view_cache/index/detail/vcie_match_criteria.hpp"
+#include "cath/structure/view_cache/index/quad_find_action_check.hpp"
+#include "cath/structure/view_cache/index/view_cache_index.hpp"
 
 using namespace ::cath::common;
+using namespace ::cath::index;
 using namespace ::cath::scan;
 using namespace ::std;
 
+using ::boost::lexical_cast;
+using ::cath::geom::make_angle_from_degrees;
+using ::cath::index::detail::angle_base_type;
+using ::cath::index::detail::angle_type;
+using ::cath::index::detail::make_default_vcie_match_criteria;
 using ::std::filesystem::path;
 
 namespace cath {
@@ -50,9 +65,14 @@ namespace cath {
 		}
 
 		/// \brief Parse the options and then pass them to snap_judgementr::superpose()
-		void do_run_program(int /*argc*/, char * /*argv*/[]) final {
+		///
+		/// The only (optional) argument is the number of threads on which to build and scan the
+		/// view_cache_index objects in the quad scan (default: 0, which uses the hardware concurrency)
+		void do_run_program(int argc, char * argv[]) final {
 			cerr << "Running snap-judgement\n";
 
+			const size_t num_quad_scan_threads = num_threads_to_use( ( argc > 1 ) ? lexical_cast<size_t>( argv[ 1 ] ) : 0_z );
+
 			// The details of the pair to use
 			//
 			/// \todo Consider whether there are better ways to get the dir/ids here
@@ -71,6 +91,27 @@ namespace cath {
 				single_pair{}
 			}.get_load_and_scan_metrics();
 
+			// Time the view_cache_index quad scan of the pair on one thread and on the specified number of threads
+			const protein    protein_a    = read_protein_from_files( protein_from_pdb(), the_dir, name_a );
+			const protein    protein_b    = read_protein_from_files( protein_from_pdb(), the_dir, name_b );
+			const auto       the_criteria = make_default_vcie_match_criteria();
+			const angle_type angle_width  = make_angle_from_degrees<angle_base_type>( 67.5 );
+			const auto time_quad_scan = [&] (const size_t &prm_num_threads) {
+				quad_find_action_check the_action( protein_a, protein_b, the_criteria );
+				const auto durn = process_quads_indexed(
+					protein_a,
+					protein_b,
+					sqrt( 40.0 ),
+					angle_width,
+					angle_width,
+					the_criteria,
+					the_action,
+					prm_num_threads
+				);
+				return "| " + ::std::to_string( prm_num_threads ) + " | " + durn_to_seconds_string( durn ) + " | " + ::std::to_string( the_action.get_total_score() ) + " |\n";
+			};
+			const string quad_scan_rows = time_quad_scan( 1 ) + ( ( num_quad_scan_threads > 1 ) ? time_quad_scan( num_quad_scan_threads ) : string{} );
+
 			const auto all_vs_all_ids = str_vec{ "1my7A00", "1my5A00", "2qjyB02", "2qjpB02", "2pw9A02", "2pw9C02", "2c4jA01", "1b4pA01", "2fmpA04", "2vanA03", "1okiA01", "1ytqA01", "1b06A01", "1ma1B01", "1a7sA02", "2xw9A02", "1avyB00", "1avyA00", "1m2tA02", "1hwmA02", "1d0cA01", "1m7vA01", "1a1hA01", "2j7jA03", "1a04A02", "1fseB00", "1fcyA00", "1pzlA00", "1avcA07", "1dk5B01", "1bd8A00", "1s70B01", "1atgA01", "1pc3A01", "1a2oA01", "2ayzA00", "1au7A02", "1rr7A02", "1arbA01", "1si5H01", "1ufmA00", "1a9xB02", "2nv0A00", "1aepA00", "1h6gA02", "1a4iB01", "1sc6A01", "2y1eA01", "1cf7B00", "1a32A00", "1go3F02", "3broD00", "1tnsA00", "2xblD00", "1a3qA01", "1g4mA01", "1a04A01", "2wjwA01", "1a02F00", "1mslA02" };
 			const auto all_vs_all_lasm = load_and_scan{
 				protein_list_loader{ protein_from_pdb(), the_dir, all_vs_all_ids },
@@ -90,6 +131,16 @@ SSAP takes about 2.7 seconds and gets a score of 69.28.
 
 )" << to_markdown_string( single_pair_lasm ) << R"(
 
+View cache index quad scan
+--------------------------
+
+Scan of the same pair for matching residue quads by building and searching view_cache_indices
+(the number of threads may be specified as the only argument).
+
+| Threads | Scan time | Total score |
+|---------|-----------|-------------|
+)" << quad_scan_rows << R"(
+
 All versus all within a set of 60 domains
 -----------------------------------------
 